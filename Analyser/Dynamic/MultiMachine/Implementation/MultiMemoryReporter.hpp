@@ -0,0 +1,46 @@
+//
+//  MultiMemoryReporter.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 14/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#ifndef MultiMemoryReporter_hpp
+#define MultiMemoryReporter_hpp
+
+#include "../../../../Machines/DynamicMachine.hpp"
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace Analyser {
+namespace Dynamic {
+
+/*!
+	Provides a class that reports the memory held by every one of multiple machines, since all
+	are held until one has been picked.
+*/
+class MultiMemoryReporter: public MachineTypes::MemoryReporter {
+	public:
+		MultiMemoryReporter(std::vector<std::unique_ptr<::Machine::DynamicMachine>> &machines, std::recursive_mutex &machines_mutex) :
+			machines_(machines), machines_mutex_(machines_mutex) {}
+
+		void report_memory(MachineTypes::MemoryFootprint &footprint) final {
+			std::lock_guard machines_lock(machines_mutex_);
+			for(const auto &machine: machines_) {
+				const auto reporter = machine->memory_reporter();
+				if(reporter) reporter->report_memory(footprint);
+			}
+		}
+
+	private:
+		const std::vector<std::unique_ptr<::Machine::DynamicMachine>> &machines_;
+		std::recursive_mutex &machines_mutex_;
+};
+
+}
+}
+
+#endif /* MultiMemoryReporter_hpp */
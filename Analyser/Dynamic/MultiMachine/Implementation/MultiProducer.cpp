@@ -8,7 +8,10 @@
 
 #include "MultiProducer.hpp"
 
-#include <condition_variable>
+#include "../../../../Concurrency/Latch.hpp"
+#include "../../../../Concurrency/ThreadPool.hpp"
+
+#include <algorithm>
 #include <mutex>
 
 using namespace Analyser::Dynamic;
@@ -17,30 +20,28 @@ using namespace Analyser::Dynamic;
 
 template <typename MachineType>
 void MultiInterface<MachineType>::perform_parallel(const std::function<void(MachineType *)> &function) {
-	// Apply a blunt force parallelisation of the machines; each run_for is dispatched
-	// to a separate queue and this queue will block until all are done.
-	volatile std::size_t outstanding_machines;
-	std::condition_variable condition;
-	std::mutex mutex;
+	// Collect the machines, then release the lock while they run.
+	std::vector<MachineType *> machines;
 	{
 		std::lock_guard machines_lock(machines_mutex_);
-		std::lock_guard lock(mutex);
-		outstanding_machines = machines_.size();
-
-		for(std::size_t index = 0; index < machines_.size(); ++index) {
-			const auto machine = ::Machine::get<MachineType>(*machines_[index].get());
-			queues_[index].enqueue([&mutex, &condition, machine, function, &outstanding_machines]() {
-				if(machine) function(machine);
-
-				std::lock_guard lock(mutex);
-				outstanding_machines--;
-				condition.notify_all();
-			});
+		machines.reserve(machines_.size());
+		for(const auto &machine: machines_) {
+			machines.push_back(::Machine::get<MachineType>(*machine.get()));
 		}
 	}
+	if(machines.empty()) return;
+
+	// Dispatch all but the first to the shared pool, and run the first on this thread.
+	Concurrency::Latch latch(machines.size() - 1);
+	for(std::size_t index = 1; index < machines.size(); ++index) {
+		Concurrency::ThreadPool::shared().submit([&latch, &function, machine = machines[index]] {
+			if(machine) function(machine);
+			latch.count_down();
+		});
+	}
+	if(machines.front()) function(machines.front());
 
-	std::unique_lock lock(mutex);
-	condition.wait(lock, [&outstanding_machines] { return !outstanding_machines; });
+	latch.wait();
 }
 
 template <typename MachineType>
@@ -55,10 +56,7 @@ void MultiInterface<MachineType>::perform_serial(const std::function<void(Machin
 // MARK: - MultiScanProducer
 void MultiScanProducer::set_scan_target(Outputs::Display::ScanTarget *scan_target) {
 	scan_target_ = scan_target;
-
-	std::lock_guard machines_lock(machines_mutex_);
-	const auto machine = machines_.front()->scan_producer();
-	if(machine) machine->set_scan_target(scan_target);
+	connect_front_machine();
 }
 
 Outputs::Display::ScanStatus MultiScanProducer::get_scan_status() const {
@@ -70,13 +68,17 @@ Outputs::Display::ScanStatus MultiScanProducer::get_scan_status() const {
 
 void MultiScanProducer::did_change_machine_order() {
 	if(scan_target_) scan_target_->will_change_owner();
+	connect_front_machine();
+}
 
-	perform_serial([](MachineTypes::ScanProducer *machine) {
-		machine->set_scan_target(nullptr);
-	});
+void MultiScanProducer::connect_front_machine() {
+	// Only the front machine's video is seen, so all others are given the null scan target,
+	// which refuses all scans and allocations so that they produce no pixels.
 	std::lock_guard machines_lock(machines_mutex_);
-	const auto machine = machines_.front()->scan_producer();
-	if(machine) machine->set_scan_target(scan_target_);
+	for(const auto &machine: machines_) {
+		const auto producer = machine->scan_producer();
+		if(producer) producer->set_scan_target(machine == machines_.front() ? scan_target_ : nullptr);
+	}
 }
 
 // MARK: - MultiAudioProducer
@@ -97,8 +99,36 @@ void MultiAudioProducer::did_change_machine_order() {
 // MARK: - MultiTimedMachine
 
 void MultiTimedMachine::run_for(Time::Seconds duration) {
-	perform_parallel([duration](::MachineTypes::TimedMachine *machine) {
-		if(machine->get_confidence() >= 0.01f) machine->run_for(duration);
+	// Determine which machines to run: anything out of contention since its confidence
+	// fell too far below the leader's is suspended, other than on a periodic retest.
+	// Machines with negligible confidence are never run.
+	{
+		std::lock_guard machines_lock(machines_mutex_);
+		float leading_confidence = 0.0f;
+		for(const auto &machine: machines_) {
+			const auto timed_machine = machine->timed_machine();
+			if(timed_machine) leading_confidence = std::max(leading_confidence, timed_machine->get_confidence());
+		}
+
+		const bool is_retest = !retest_counter_;
+		retest_counter_ = (retest_counter_ + 1) % retest_interval_;
+
+		active_machines_.clear();
+		for(const auto &machine: machines_) {
+			const auto timed_machine = machine->timed_machine();
+			if(!timed_machine) continue;
+
+			const float confidence = timed_machine->get_confidence();
+			if(confidence < 0.01f) continue;
+			if(confidence < leading_confidence * suspension_ratio_ && !is_retest) continue;
+			active_machines_.push_back(timed_machine);
+		}
+	}
+
+	perform_parallel([duration, this](::MachineTypes::TimedMachine *machine) {
+		if(std::find(active_machines_.begin(), active_machines_.end(), machine) != active_machines_.end()) {
+			machine->run_for(duration);
+		}
 	});
 
 	if(delegate_) delegate_->did_run_machines(this);
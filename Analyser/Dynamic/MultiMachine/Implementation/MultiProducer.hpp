@@ -9,12 +9,12 @@
 #ifndef MultiProducer_hpp
 #define MultiProducer_hpp
 
-#include "../../../../Concurrency/AsyncTaskQueue.hpp"
 #include "../../../../Machines/MachineTypes.hpp"
 #include "../../../../Machines/DynamicMachine.hpp"
 
 #include "MultiSpeaker.hpp"
 
+#include <algorithm>
 #include <memory>
 #include <mutex>
 #include <vector>
@@ -25,14 +25,15 @@ namespace Dynamic {
 template <typename MachineType> class MultiInterface {
 	public:
 		MultiInterface(const std::vector<std::unique_ptr<::Machine::DynamicMachine>> &machines, std::recursive_mutex &machines_mutex) :
-			machines_(machines), machines_mutex_(machines_mutex), queues_(machines.size()) {}
+			machines_(machines), machines_mutex_(machines_mutex) {}
 
 	protected:
 		/*!
 			Performs a parallel for operation across all machines, performing the supplied
 			function on each and returning only once all applications have completed.
 
-			No guarantees are extended as to which thread operations will occur on.
+			No guarantees are extended as to which thread operations will occur on; the calling
+			thread will participate.
 		*/
 		void perform_parallel(const std::function<void(MachineType *)> &);
 
@@ -45,9 +46,6 @@ template <typename MachineType> class MultiInterface {
 	protected:
 		const std::vector<std::unique_ptr<::Machine::DynamicMachine>> &machines_;
 		std::recursive_mutex &machines_mutex_;
-
-	private:
-		std::vector<Concurrency::AsyncTaskQueue> queues_;
 };
 
 class MultiTimedMachine: public MultiInterface<MachineTypes::TimedMachine>, public MachineTypes::TimedMachine {
@@ -66,11 +64,26 @@ class MultiTimedMachine: public MultiInterface<MachineTypes::TimedMachine>, publ
 			delegate_ = delegate;
 		}
 
+		/*!
+			Sets the proportion of the most confident machine's confidence below which other machines
+			are suspended. Suspended machines are run only once in every @c retest_interval calls
+			to run_for, to give them an opportunity to regain confidence.
+		*/
+		void set_suspension_threshold(float ratio, int retest_interval) {
+			suspension_ratio_ = ratio;
+			retest_interval_ = std::max(retest_interval, 1);
+		}
+
 		void run_for(Time::Seconds duration) final;
 
 	private:
 		void run_for(const Cycles) final {}
 		Delegate *delegate_ = nullptr;
+
+		float suspension_ratio_ = 0.25f;
+		int retest_interval_ = 32;
+		int retest_counter_ = 0;
+		std::vector<MachineTypes::TimedMachine *> active_machines_;
 };
 
 class MultiScanProducer: public MultiInterface<MachineTypes::ScanProducer>, public MachineTypes::ScanProducer {
@@ -89,6 +102,7 @@ class MultiScanProducer: public MultiInterface<MachineTypes::ScanProducer>, publ
 
 	private:
 		Outputs::Display::ScanTarget *scan_target_ = nullptr;
+		void connect_front_machine();
 };
 
 class MultiAudioProducer: public MultiInterface<MachineTypes::AudioProducer>, public MachineTypes::AudioProducer {
@@ -25,6 +25,7 @@ MultiSpeaker::MultiSpeaker(const std::vector<Outputs::Speaker::Speaker *> &speak
 	speakers_(speakers), front_speaker_(speakers.front()) {
 	for(const auto &speaker: speakers_) {
 		speaker->set_delegate(this);
+		speaker->set_is_muted(speaker != front_speaker_);
 	}
 }
 
@@ -60,6 +61,12 @@ void MultiSpeaker::set_output_volume(float volume) {
 	}
 }
 
+void MultiSpeaker::set_is_muted(bool is_muted) {
+	std::lock_guard lock_guard(front_speaker_mutex_);
+	is_muted_ = is_muted;
+	if(front_speaker_) front_speaker_->set_is_muted(is_muted);
+}
+
 void MultiSpeaker::speaker_did_complete_samples(Speaker *speaker, const std::vector<int16_t> &buffer) {
 	auto delegate = delegate_.load(std::memory_order::memory_order_relaxed);
 	if(!delegate) return;
@@ -82,8 +89,11 @@ void MultiSpeaker::speaker_did_change_input_clock(Speaker *speaker) {
 
 void MultiSpeaker::set_new_front_machine(::Machine::DynamicMachine *machine) {
 	{
+		// Swap which speaker is muted.
 		std::lock_guard lock_guard(front_speaker_mutex_);
+		if(front_speaker_) front_speaker_->set_is_muted(true);
 		front_speaker_ = machine->audio_producer()->get_speaker();
+		if(front_speaker_) front_speaker_->set_is_muted(is_muted_);
 	}
 	auto delegate = delegate_.load(std::memory_order::memory_order_relaxed);
 	if(delegate) {
@@ -24,7 +24,8 @@ namespace Dynamic {
 	transparently to connect a single caller to multiple destinations.
 
 	Makes a static internal copy of the list of machines; expects the owner to keep it
-	abreast of the current frontmost machine.
+	abreast of the current frontmost machine. Only the frontmost machine's audio is heard, so
+	all other speakers are muted, advancing their sources without generating audio.
 */
 class MultiSpeaker: public Outputs::Speaker::Speaker, Outputs::Speaker::Speaker::Delegate {
 	public:
@@ -42,6 +43,7 @@ class MultiSpeaker: public Outputs::Speaker::Speaker, Outputs::Speaker::Speaker:
 		void set_computed_output_rate(float cycles_per_second, int buffer_size, bool stereo) override;
 		bool get_is_stereo() override;
 		void set_output_volume(float) override;
+		void set_is_muted(bool) override;
 
 	private:
 		void speaker_did_complete_samples(Speaker *speaker, const std::vector<int16_t> &buffer) final;
@@ -53,6 +55,7 @@ class MultiSpeaker: public Outputs::Speaker::Speaker, Outputs::Speaker::Speaker:
 		std::mutex front_speaker_mutex_;
 
 		bool stereo_output_ = false;
+		bool is_muted_ = false;
 };
 
 }
@@ -21,10 +21,15 @@ MultiMachine::MultiMachine(std::vector<std::unique_ptr<DynamicMachine>> &&machin
 	audio_producer_(machines_, machines_mutex_),
 	joystick_machine_(machines_),
 	keyboard_machine_(machines_),
-	media_target_(machines_) {
+	media_target_(machines_),
+	memory_reporter_(machines_, machines_mutex_) {
 	timed_machine_.set_delegate(this);
 }
 
+void MultiMachine::set_suspension_threshold(float ratio, int retest_interval) {
+	timed_machine_.set_suspension_threshold(ratio, retest_interval);
+}
+
 Activity::Source *MultiMachine::activity_source() {
 	return nullptr; // TODO
 }
@@ -45,12 +50,18 @@ Provider(MachineTypes::AudioProducer, audio_producer, audio_producer_)
 Provider(MachineTypes::JoystickMachine, joystick_machine, joystick_machine_)
 Provider(MachineTypes::KeyboardMachine, keyboard_machine, keyboard_machine_)
 Provider(MachineTypes::MediaTarget, media_target, media_target_)
+Provider(MachineTypes::MemoryReporter, memory_reporter, memory_reporter_)
 
 MachineTypes::MouseMachine *MultiMachine::mouse_machine() {
 	// TODO.
 	return nullptr;
 }
 
+MachineTypes::StateProducer *MultiMachine::state_producer() {
+	// States can't usefully be captured across several machines at once.
+	return has_picked_ ? machines_.front()->state_producer() : nullptr;
+}
+
 #undef Provider
 
 bool MultiMachine::would_collapse(const std::vector<std::unique_ptr<DynamicMachine>> &machines) {
@@ -17,6 +17,7 @@
 #include "Implementation/MultiJoystickMachine.hpp"
 #include "Implementation/MultiKeyboardMachine.hpp"
 #include "Implementation/MultiMediaTarget.hpp"
+#include "Implementation/MultiMemoryReporter.hpp"
 
 #include <memory>
 #include <mutex>
@@ -37,7 +38,8 @@ namespace Dynamic {
 	confidence.
 
 	If confidence for any machine becomes disproportionately low compared to
-	the others in the set, that machine stops running.
+	the others in the set, that machine is suspended; suspended machines are
+	run only periodically, to test whether they should be revived.
 */
 class MultiMachine: public ::Machine::DynamicMachine, public MultiTimedMachine::Delegate {
 	public:
@@ -51,6 +53,13 @@ class MultiMachine: public ::Machine::DynamicMachine, public MultiTimedMachine::
 		static bool would_collapse(const std::vector<std::unique_ptr<DynamicMachine>> &machines);
 		MultiMachine(std::vector<std::unique_ptr<DynamicMachine>> &&machines);
 
+		/*!
+			Suspends any machine with a confidence less than @c ratio times that of the most
+			confident machine; suspended machines are retested by being run once in every
+			@c retest_interval calls to run_for.
+		*/
+		void set_suspension_threshold(float ratio, int retest_interval);
+
 		Activity::Source *activity_source() final;
 		Configurable::Device *configurable_device() final;
 		MachineTypes::TimedMachine *timed_machine() final;
@@ -60,6 +69,8 @@ class MultiMachine: public ::Machine::DynamicMachine, public MultiTimedMachine::
 		MachineTypes::KeyboardMachine *keyboard_machine() final;
 		MachineTypes::MouseMachine *mouse_machine() final;
 		MachineTypes::MediaTarget *media_target() final;
+		MachineTypes::StateProducer *state_producer() final;
+		MachineTypes::MemoryReporter *memory_reporter() final;
 		void *raw_pointer() final;
 
 	private:
@@ -75,6 +86,7 @@ class MultiMachine: public ::Machine::DynamicMachine, public MultiTimedMachine::
 		MultiJoystickMachine joystick_machine_;
 		MultiKeyboardMachine keyboard_machine_;
 		MultiMediaTarget media_target_;
+		MultiMemoryReporter memory_reporter_;
 
 		void pick_first();
 		bool has_picked_ = false;
@@ -12,6 +12,8 @@
 #include "Tape.hpp"
 #include "Target.hpp"
 
+#include "../../../Storage/Tape/BoundedTape.hpp"
+
 #include <algorithm>
 
 using namespace Analyser::Static::Acorn;
@@ -68,7 +70,7 @@ Analyser::Static::TargetList Analyser::Static::Acorn::GetTargets(const Media &me
 	// if there are any tapes, attempt to get data from the first
 	if(!media.tapes.empty()) {
 		std::shared_ptr<Storage::Tape::Tape> tape = media.tapes.front();
-		std::vector<File> files = GetFiles(tape);
+		std::vector<File> files = Storage::Tape::AnalyseWithBudget(tape, [](const auto &tape) { return GetFiles(tape); });
 		tape->reset();
 
 		// continue if there are any files
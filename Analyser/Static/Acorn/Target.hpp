@@ -35,6 +35,10 @@ struct Target: public ::Analyser::Static::Target, public Reflection::StructImpl<
 			DeclareField(has_sideways_ram);
 		}
 	}
+
+	void cache_fields(CacheFields &fields) final {
+		fields(loading_command, should_shift_restart);
+	}
 };
 
 }
@@ -13,6 +13,7 @@
 
 #include "../../../Storage/Disk/Parsers/CPM.hpp"
 #include "../../../Storage/Disk/Encodings/MFM/Parser.hpp"
+#include "../../../Storage/Tape/BoundedTape.hpp"
 #include "../../../Storage/Tape/Parsers/Spectrum.hpp"
 
 #include "Target.hpp"
@@ -190,9 +191,18 @@ bool IsAmstradTape(const std::shared_ptr<Storage::Tape::Tape> &tape) {
 	using Parser = Storage::Tape::ZXSpectrum::Parser;
 	Parser parser(Parser::MachineType::AmstradCPC);
 
+	// Look only at the start of the tape unless that contains no blocks at all.
+	const auto bounded = std::make_shared<Storage::Tape::BoundedTape>(tape);
+	const std::shared_ptr<Storage::Tape::Tape> source = bounded;
+	bool found_block = false;
 	while(true) {
-		const auto block = parser.find_block(tape);
-		if(!block) break;
+		const auto block = parser.find_block(source);
+		if(!block) {
+			if(found_block || !bounded->budget_is_exhausted()) break;
+			bounded->remove_budget();
+			continue;
+		}
+		found_block = true;
 
 		if(block->type == 0x2c) {
 			return true;
@@ -29,6 +29,10 @@ struct Target: public Analyser::Static::Target, public Reflection::StructImpl<Ta
 			AnnounceEnum(Model);
 		}
 	}
+
+	void cache_fields(CacheFields &fields) final {
+		fields(loading_command);
+	}
 };
 
 }
@@ -36,6 +36,10 @@ struct Target: public ::Analyser::Static::Target {
 	bool uses_superchip = false;
 
 	Target() : Analyser::Static::Target(Machine::Atari2600) {}
+
+	void cache_fields(CacheFields &fields) final {
+		fields(paging_model, uses_superchip);
+	}
 };
 
 }
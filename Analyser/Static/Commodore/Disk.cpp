@@ -100,6 +100,17 @@ class CommodoreGCRParser: public Storage::Disk::Controller {
 			return Storage::Encodings::CommodoreGCR::decoding_from_dectet(shift_register_);
 		}
 
+		/// Reads the next @c count bytes, collecting all of their GCR before decoding.
+		void get_next_bytes(uint8_t *destination, size_t count) {
+			std::vector<uint8_t> gcr((count * 10 + 7) >> 3);
+			for(size_t bit = 0; bit < count * 10; bit++) {
+				bit_count_ = 0;
+				while(!bit_count_) run_for(Cycles(1));
+				if(shift_register_ & 1) gcr[bit >> 3] |= 0x80 >> (bit & 7);
+			}
+			Storage::Encodings::CommodoreGCR::decode_bytes(destination, gcr.data(), count);
+		}
+
 		void proceed_to_shift_value(unsigned int shift_value) {
 			const int max_index_count = index_count_ + 2;
 			while(shift_register_ != shift_value && index_count_ < max_index_count) {
@@ -152,9 +163,9 @@ class CommodoreGCRParser: public Storage::Disk::Controller {
 					if(index_count_ >= max_index_count) return nullptr;
 				}
 
+				get_next_bytes(sector->data.data(), sector->data.size());
 				checksum = 0;
 				for(std::size_t c = 0; c < 256; c++) {
-					sector->data[c] = uint8_t(get_next_byte());
 					checksum ^= sector->data[c];
 				}
 
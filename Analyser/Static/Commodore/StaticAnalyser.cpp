@@ -14,6 +14,7 @@
 #include "Target.hpp"
 #include "../../../Storage/Cartridge/Encodings/CommodoreROM.hpp"
 #include "../../../Outputs/Log.hpp"
+#include "../../../Storage/Tape/BoundedTape.hpp"
 
 #include <algorithm>
 #include <cstring>
@@ -69,7 +70,7 @@ Analyser::Static::TargetList Analyser::Static::Commodore::GetTargets(const Media
 
 	// check tapes
 	for(auto &tape : media.tapes) {
-		std::vector<File> tape_files = GetFiles(tape);
+		std::vector<File> tape_files = Storage::Tape::AnalyseWithBudget(tape, [](const auto &tape) { return GetFiles(tape); });
 		tape->reset();
 		if(!tape_files.empty()) {
 			files.insert(files.end(), tape_files.begin(), tape_files.end());
@@ -69,6 +69,10 @@ struct Target: public Analyser::Static::Target, public Reflection::StructImpl<Ta
 			AnnounceEnum(Region);
 		}
 	}
+
+	void cache_fields(CacheFields &fields) final {
+		fields(loading_command);
+	}
 };
 
 }
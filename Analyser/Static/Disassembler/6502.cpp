@@ -21,6 +21,9 @@ static void AddToDisassembly(PartialDisassembly &disassembly, const std::vector<
 	disassembly.disassembly.internal_calls.insert(entry_point);
 	uint16_t address = entry_point;
 	while(true) {
+		// Stop if this is somewhere that has already been disassembled.
+		if(disassembly.visited[address]) return;
+
 		std::size_t local_address = address_mapper(address);
 		if(local_address >= memory.size()) return;
 
@@ -257,6 +260,7 @@ static void AddToDisassembly(PartialDisassembly &disassembly, const std::vector<
 
 		// Store the instruction.
 		disassembly.disassembly.instructions_by_address[instruction.address] = instruction;
+		disassembly.visited[instruction.address] = true;
 
 		// TODO: something wider-ranging than this
 		if(instruction.addressing_mode == Instruction::Absolute || instruction.addressing_mode == Instruction::ZeroPage) {
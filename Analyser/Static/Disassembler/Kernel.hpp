@@ -9,6 +9,11 @@
 #ifndef Kernel_hpp
 #define Kernel_hpp
 
+#include <bitset>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
 namespace Analyser {
 namespace Static {
 namespace Disassembly {
@@ -16,6 +21,10 @@ namespace Disassembly {
 template <typename D, typename S> struct PartialDisassembly {
 	D disassembly;
 	std::vector<S> remaining_entry_points;
+
+	/// Marks every address from which an instruction has been disassembled. Disassembly from any
+	/// given address always proceeds identically, so it can stop upon reaching a visited address.
+	std::bitset<size_t(1) << (8 * sizeof(S))> visited;
 };
 
 template <typename D, typename S, typename Disassembler> D Disassemble(
@@ -31,8 +40,7 @@ template <typename D, typename S, typename Disassembler> D Disassemble(
 		partial_disassembly.remaining_entry_points.pop_back();
 
 		// if that address has already been visited, forget about it
-		if(	partial_disassembly.disassembly.instructions_by_address.find(next_entry_point)
-			!= partial_disassembly.disassembly.instructions_by_address.end()) continue;
+		if(partial_disassembly.visited[next_entry_point]) continue;
 
 		// if it's outgoing, log it as such and forget about it; otherwise disassemble
 		std::size_t mapped_entry_point = address_mapper(next_entry_point);
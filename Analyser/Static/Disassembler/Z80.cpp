@@ -547,6 +547,9 @@ struct Z80Disassembler {
 		Accessor accessor(memory, address_mapper, entry_point);
 
 		while(!accessor.at_end()) {
+			// Stop if this is somewhere that has already been disassembled.
+			if(disassembly.visited[accessor.address()]) return;
+
 			Instruction instruction;
 			instruction.address = accessor.address();
 
@@ -557,6 +560,7 @@ struct Z80Disassembler {
 
 			// Store the instruction away.
 			disassembly.disassembly.instructions_by_address[instruction.address] = instruction;
+			disassembly.visited[instruction.address] = true;
 
 			// Update access tables.
 			int access_type =
@@ -48,6 +48,10 @@ struct Target: public Analyser::Static::Target, public Reflection::StructImpl<Ta
 			DeclareField(speed);
 		}
 	}
+
+	void cache_fields(CacheFields &fields) final {
+		fields(loading_command);
+	}
 };
 
 }
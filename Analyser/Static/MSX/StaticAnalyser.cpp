@@ -15,6 +15,8 @@
 #include "../Disassembler/Z80.hpp"
 #include "../Disassembler/AddressMapper.hpp"
 
+#include "../../../Storage/Tape/BoundedTape.hpp"
+
 #include <algorithm>
 
 static std::unique_ptr<Analyser::Static::Target> CartridgeTarget(
@@ -272,7 +274,7 @@ Analyser::Static::TargetList Analyser::Static::MSX::GetTargets(const Media &medi
 
 	// Check tapes for loadable files.
 	for(auto &tape : media.tapes) {
-		std::vector<File> files_on_tape = GetFiles(tape);
+		std::vector<File> files_on_tape = Storage::Tape::AnalyseWithBudget(tape, [](const auto &tape) { return GetFiles(tape); });
 		if(!files_on_tape.empty()) {
 			switch(files_on_tape.front().type) {
 				case File::Type::ASCII:				target->loading_command = "RUN\"CAS:\r";		break;
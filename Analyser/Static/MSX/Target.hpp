@@ -36,6 +36,10 @@ struct Target: public ::Analyser::Static::Target, public Reflection::StructImpl<
 			AnnounceEnum(Region);
 		}
 	}
+
+	void cache_fields(CacheFields &fields) final {
+		fields(loading_command);
+	}
 };
 
 }
@@ -15,6 +15,7 @@
 #include "../Disassembler/AddressMapper.hpp"
 
 #include "../../../Storage/Disk/Encodings/MFM/Parser.hpp"
+#include "../../../Storage/Tape/BoundedTape.hpp"
 
 #include <cstring>
 
@@ -153,7 +154,7 @@ Analyser::Static::TargetList Analyser::Static::Oric::GetTargets(const Media &med
 	int basic11_votes = 0;
 
 	for(auto &tape : media.tapes) {
-		std::vector<File> tape_files = GetFiles(tape);
+		std::vector<File> tape_files = Storage::Tape::AnalyseWithBudget(tape, [](const auto &tape) { return GetFiles(tape); });
 		tape->reset();
 		if(!tape_files.empty()) {
 			for(const auto &file : tape_files) {
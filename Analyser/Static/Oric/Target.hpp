@@ -54,6 +54,10 @@ struct Target: public Analyser::Static::Target, public Reflection::StructImpl<Ta
 			AnnounceEnum(Processor);
 		}
 	}
+
+	void cache_fields(CacheFields &fields) final {
+		fields(loading_command, should_start_jasmin);
+	}
 };
 
 }
@@ -46,6 +46,10 @@ struct Target: public Analyser::Static::Target, public Reflection::StructImpl<Ta
 			AnnounceEnum(Region);
 		}
 	}
+
+	void cache_fields(CacheFields &fields) final {
+		fields(model, paging_scheme);
+	}
 };
 
 #define is_master_system(v) v >= Analyser::Static::Sega::Target::Model::MasterSystem
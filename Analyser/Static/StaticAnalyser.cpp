@@ -7,11 +7,14 @@
 //
 
 #include "StaticAnalyser.hpp"
+#include "TargetCache.hpp"
 
 #include <algorithm>
 #include <cstdlib>
 #include <cstring>
+#include <future>
 #include <iterator>
+#include <vector>
 
 // Analysers
 #include "Acorn/StaticAnalyser.hpp"
@@ -58,6 +61,7 @@
 #include "../../Storage/MassStorage/Formats/DAT.hpp"
 #include "../../Storage/MassStorage/Formats/DSK.hpp"
 #include "../../Storage/MassStorage/Formats/HFV.hpp"
+#include "../../Storage/MassStorage/Formats/Overlay.hpp"
 
 // State Snapshots
 #include "../../Storage/State/SNA.hpp"
@@ -162,6 +166,7 @@ static Media GetMediaAndPlatforms(const std::string &file_name, TargetPlatform::
 	Format("msa", result.disks, Disk::DiskImageHolder<Storage::Disk::MSA>, TargetPlatform::AtariST)				// MSA
 	Format("nib", result.disks, Disk::DiskImageHolder<Storage::Disk::NIB>, TargetPlatform::DiskII)				// NIB
 	Format("o", result.tapes, Tape::ZX80O81P, TargetPlatform::ZX8081)											// O
+	Format("ovl", result.mass_storage_devices, MassStorage::Overlay, TargetPlatform::Macintosh)					// OVL (mass-storage overlay)
 	Format("p", result.tapes, Tape::ZX80O81P, TargetPlatform::ZX8081)											// P
 	Format("po", result.disks, Disk::DiskImageHolder<Storage::Disk::AppleDSK>, TargetPlatform::DiskII)			// PO (original Apple II kind)
 
@@ -236,7 +241,14 @@ TargetList Analyser::Static::GetTargets(const std::string &file_name) {
 
 #undef TryInsert
 
-	// Otherwise:
+	// Otherwise, use the result of any previous analysis.
+	const auto cache = TargetCache::cache_for(file_name);
+	if(cache) {
+		targets = cache->get();
+		if(!targets.empty()) return targets;
+	}
+
+	// Failing that:
 	//
 	// Collect all disks, tapes ROMs, etc as can be extrapolated from this file, forming the
 	// union of all platforms this file might be a target for.
@@ -245,10 +257,9 @@ TargetList Analyser::Static::GetTargets(const std::string &file_name) {
 
 	// Hand off to platform-specific determination of whether these
 	// things are actually compatible and, if so, how to load them.
-#define Append(x) if(potential_platforms & TargetPlatform::x) {\
-	auto new_targets = x::GetTargets(media, file_name, potential_platforms);\
-	std::move(new_targets.begin(), new_targets.end(), std::back_inserter(targets));\
-}
+	using PlatformAnalyser = TargetList (*)(const Media &, const std::string &, TargetPlatform::IntType);
+	std::vector<PlatformAnalyser> analysers;
+#define Append(x) if(potential_platforms & TargetPlatform::x) analysers.push_back(x::GetTargets);
 	Append(Acorn);
 	Append(AmstradCPC);
 	Append(AppleII);
@@ -267,6 +278,31 @@ TargetList Analyser::Static::GetTargets(const std::string &file_name) {
 	Append(ZXSpectrum);
 #undef Append
 
+	// If there are several candidates, analyse concurrently. Analysers are free to reposition
+	// tapes and otherwise inspect media statefully, so all but the first get their own copy of
+	// the media. Results are then collected in the original order. Each analyser's media is
+	// retained so that the cache can record which of it each target uses.
+	std::vector<Media> analysed_media(analysers.size());
+	std::vector<std::future<TargetList>> concurrent_results;
+	for(size_t c = 1; c < analysers.size(); c++) {
+		concurrent_results.push_back(std::async(std::launch::async, [analyser = analysers[c], &file_name, &media = analysed_media[c]] {
+			TargetPlatform::IntType platforms = 0;
+			media = GetMediaAndPlatforms(file_name, platforms);
+			return analyser(media, file_name, platforms);
+		}));
+	}
+
+	const auto append = [&targets] (TargetList &&new_targets) {
+		std::move(new_targets.begin(), new_targets.end(), std::back_inserter(targets));
+	};
+	if(!analysers.empty()) {
+		analysed_media.front() = std::move(media);
+		append(analysers.front()(analysed_media.front(), file_name, potential_platforms));
+	}
+	for(auto &result: concurrent_results) {
+		append(result.get());
+	}
+
 	// Reset any tapes to their initial position.
 	for(const auto &target : targets) {
 		for(auto &tape : target->media.tapes) {
@@ -281,5 +317,9 @@ TargetList Analyser::Static::GetTargets(const std::string &file_name) {
 			return a->confidence > b->confidence;
 		});
 
+	if(cache) {
+		cache->store(targets, analysed_media);
+	}
+
 	return targets;
 }
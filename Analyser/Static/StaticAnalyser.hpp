@@ -17,8 +17,11 @@
 #include "../../Storage/Tape/Tape.hpp"
 #include "../../Reflection/Struct.hpp"
 
+#include <cstdint>
+#include <cstring>
 #include <memory>
 #include <string>
+#include <type_traits>
 #include <vector>
 
 namespace Analyser {
@@ -50,6 +53,95 @@ struct Media {
 	}
 };
 
+/*!
+	Writes a sequence of fields to a record, or reads them back from one, for storage in a TargetCache.
+
+	Supported are integers, bools, enums, floats and strings or vectors of any of those; values are
+	stored little endian so that records are portable. A read beyond the end of the record is noted
+	as an error and leaves the field at zero.
+*/
+class CacheFields {
+	public:
+		/// Constructs an instance that appends fields to @c record.
+		CacheFields(std::vector<uint8_t> &record) : record_(&record) {}
+
+		/// Constructs an instance that reads fields from the @c size bytes at @c data.
+		CacheFields(const uint8_t *data, size_t size) : data_(data), size_(size) {}
+
+		/// Writes or reads each of @c fields in turn, depending on how this instance was constructed.
+		template <typename... FieldTs> void operator()(FieldTs &...fields) {
+			(apply(fields), ...);
+		}
+
+		/// @returns @c true if all reads so far have been satisfied.
+		bool is_valid() const {
+			return is_valid_;
+		}
+
+		bool is_at_end() const {
+			return offset_ == size_;
+		}
+
+	private:
+		std::vector<uint8_t> *record_ = nullptr;
+		const uint8_t *data_ = nullptr;
+		size_t size_ = 0;
+		size_t offset_ = 0;
+		bool is_valid_ = true;
+
+		template <typename FieldT> void apply(FieldT &field) {
+			if constexpr (std::is_same_v<FieldT, bool>) {
+				uint8_t value = field;
+				apply(value);
+				field = value;
+			} else if constexpr (std::is_enum_v<FieldT>) {
+				auto value = std::underlying_type_t<FieldT>(field);
+				apply(value);
+				field = FieldT(value);
+			} else if constexpr (std::is_same_v<FieldT, float>) {
+				uint32_t value;
+				memcpy(&value, &field, sizeof(value));
+				apply(value);
+				memcpy(&field, &value, sizeof(value));
+			} else if constexpr (std::is_integral_v<FieldT>) {
+				if(record_) {
+					for(size_t c = 0; c < sizeof(FieldT); c++) {
+						record_->push_back(uint8_t(uint64_t(field) >> (c * 8)));
+					}
+					return;
+				}
+
+				uint64_t value = 0;
+				if(has(sizeof(FieldT))) {
+					for(size_t c = 0; c < sizeof(FieldT); c++) {
+						value |= uint64_t(data_[offset_ + c]) << (c * 8);
+					}
+					offset_ += sizeof(FieldT);
+				}
+				field = FieldT(value);
+			} else {
+				// Anything else is a sequence, stored as its length and then its elements;
+				// every element occupies at least a byte, which bounds any length read.
+				uint64_t size = field.size();
+				apply(size);
+				if(!record_) {
+					field.clear();
+					if(!has(size)) return;
+					field.resize(size_t(size));
+				}
+				for(auto &element: field) {
+					apply(element);
+				}
+			}
+		}
+
+		bool has(uint64_t size) {
+			// Compared this way around so that a corrupt size can't overflow.
+			is_valid_ &= size <= size_ - offset_;
+			return is_valid_;
+		}
+};
+
 /*!
 	Describes a machine and possibly its state; conventionally subclassed to add other machine-specific configuration fields and any
 	necessary instructions on how to launch any software provided, plus a measure of confidence in this target's correctness.
@@ -58,6 +150,12 @@ struct Target {
 	Target(Machine machine) : machine(machine) {}
 	virtual ~Target() {}
 
+	/*!
+		Passes to @c fields any fields that are set by analysis but aren't declared for reflection —
+		loading commands and the like — so that this target can be cached and later restored in full.
+	*/
+	virtual void cache_fields(CacheFields &) {}
+
 	// This field is entirely optional.
 	std::unique_ptr<Reflection::Struct> state;
 
@@ -69,6 +167,7 @@ typedef std::vector<std::unique_ptr<Target>> TargetList;
 
 /*!
 	Attempts, through any available means, to return a list of potential targets for the file with the given name.
+	The result of a previous analysis is used instead if a directory has been supplied to TargetCache.
 
 	@returns The list of potential targets, sorted from most to least probable.
 */
@@ -0,0 +1,273 @@
+//
+//  TargetCache.cpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 14/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#include "TargetCache.hpp"
+
+#include "Acorn/Target.hpp"
+#include "AmstradCPC/Target.hpp"
+#include "AppleII/Target.hpp"
+#include "AppleIIgs/Target.hpp"
+#include "Atari2600/Target.hpp"
+#include "AtariST/Target.hpp"
+#include "Commodore/Target.hpp"
+#include "Enterprise/Target.hpp"
+#include "Macintosh/Target.hpp"
+#include "MSX/Target.hpp"
+#include "Oric/Target.hpp"
+#include "Sega/Target.hpp"
+#include "ZX8081/Target.hpp"
+#include "ZXSpectrum/Target.hpp"
+
+#include "../../Storage/FileHolder.hpp"
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <optional>
+#include <typeinfo>
+
+using namespace Analyser::Static;
+
+namespace {
+
+/// Incremented whenever the file format or the output of any analyser changes, invalidating everything stored earlier.
+constexpr uint32_t AnalyserVersion = 1;
+
+/*
+	Each file consists of, as per CacheFields:
+
+		"CLKA", the analyser version, the file hash and size, and the number of targets;
+
+		then, per target: its machine, confidence and the index of the analyser that produced it;
+		the indices of its disks, tapes, cartridges and mass-storage devices amongst that analyser's
+		media; its BSON serialisation, if it is reflective; and the fields it supplies via cache_fields.
+*/
+constexpr uint32_t Magic = 0x414b4c43;	// i.e. "CLKA".
+
+std::string &cache_directory() {
+	static std::string directory;
+	return directory;
+}
+
+/// @returns A default target for @c machine, of the type that analysers produce for it.
+std::unique_ptr<Target> new_target(Analyser::Machine machine) {
+	using Machine = Analyser::Machine;
+	switch(machine) {
+		default: return nullptr;
+
+		case Machine::AmstradCPC:	return std::make_unique<AmstradCPC::Target>();
+		case Machine::AppleII:		return std::make_unique<AppleII::Target>();
+		case Machine::AppleIIgs:	return std::make_unique<AppleIIgs::Target>();
+		case Machine::Atari2600:	return std::make_unique<Atari2600::Target>();
+		case Machine::AtariST:		return std::make_unique<AtariST::Target>();
+		case Machine::ColecoVision:	return std::make_unique<Target>(Machine::ColecoVision);
+		case Machine::Electron:		return std::make_unique<Acorn::Target>();
+		case Machine::Enterprise:	return std::make_unique<Enterprise::Target>();
+		case Machine::Macintosh:	return std::make_unique<Macintosh::Target>();
+		case Machine::MasterSystem:	return std::make_unique<Sega::Target>();
+		case Machine::MSX:			return std::make_unique<MSX::Target>();
+		case Machine::Oric:			return std::make_unique<Oric::Target>();
+		case Machine::Vic20:		return std::make_unique<Commodore::Target>();
+		case Machine::ZX8081:		return std::make_unique<ZX8081::Target>();
+		case Machine::ZXSpectrum:	return std::make_unique<ZXSpectrum::Target>();
+	}
+}
+
+/// Sets @c indices to the positions of each of @c items within @c all, returning @c false if any is absent.
+template <typename ItemT> bool index(const std::vector<ItemT> &items, const std::vector<ItemT> &all, std::vector<uint32_t> &indices) {
+	indices.clear();
+	for(const auto &item: items) {
+		const auto position = std::find(all.begin(), all.end(), item);
+		if(position == all.end()) return false;
+		indices.push_back(uint32_t(position - all.begin()));
+	}
+	return true;
+}
+
+/// Sets @c items to the members of @c all at @c indices, returning @c false if any is out of range.
+template <typename ItemT> bool select(std::vector<ItemT> &items, const std::vector<ItemT> &all, const std::vector<uint32_t> &indices) {
+	items.clear();
+	for(const auto index: indices) {
+		if(index >= all.size()) return false;
+		items.push_back(all[index]);
+	}
+	return true;
+}
+
+}
+
+void TargetCache::set_directory(const std::string &directory) {
+	cache_directory() = directory;
+}
+
+std::unique_ptr<TargetCache> TargetCache::cache_for(const std::string &file_name) {
+	if(cache_directory().empty()) return nullptr;
+
+	// Take a 64-bit FNV-1a hash of the whole file, mapping it if possible.
+	uint64_t hash = 0xcbf29ce484222325, size = 0;
+	const auto fold = [&hash](const uint8_t *data, size_t size) {
+		for(size_t c = 0; c < size; c++) {
+			hash = (hash ^ data[c]) * 0x100000001b3;
+		}
+	};
+
+	try {
+		Storage::FileHolder file(file_name, Storage::FileHolder::FileMode::Read);
+		const uint8_t *const mapping = file.map();
+		if(mapping) {
+			fold(mapping, file.mapped_size());
+			size = file.mapped_size();
+		} else {
+			uint8_t chunk[16384];
+			size_t read;
+			while((read = file.read(chunk, sizeof(chunk))) > 0) {
+				fold(chunk, read);
+				size += read;
+			}
+		}
+	} catch(...) {
+		return nullptr;
+	}
+
+	// An empty file has no targets worth caching.
+	if(!size) return nullptr;
+	return std::make_unique<TargetCache>(cache_directory(), file_name, hash, size);
+}
+
+TargetCache::TargetCache(const std::string &directory, const std::string &file_name, uint64_t hash, uint64_t size) :
+	directory_(directory), file_name_(file_name), hash_(hash), size_(size) {}
+
+std::string TargetCache::path() const {
+	char name[64];
+	snprintf(name, sizeof(name), "clksignal-targets-%016" PRIx64 ".bin", hash_);
+
+	std::string result = directory_;
+	if(result.back() != '/') result += '/';
+	return result + name;
+}
+
+TargetList TargetCache::get() {
+	std::vector<uint8_t> contents;
+	try {
+		Storage::FileHolder file(path(), Storage::FileHolder::FileMode::Read);
+		contents = file.read(size_t(file.stats().st_size));
+	} catch(...) {
+		return {};
+	}
+
+	CacheFields record(contents.data(), contents.size());
+	uint32_t magic = 0, version = 0, count = 0;
+	uint64_t hash = 0, size = 0;
+	record(magic, version, hash, size, count);
+	if(
+		!record.is_valid() ||
+		magic != Magic ||
+		version != AnalyserVersion ||
+		hash != hash_ ||
+		size != size_
+	) return {};
+
+	// Media is obtained afresh for each analyser that contributed a target, exactly as if
+	// analysis were being repeated.
+	std::vector<std::optional<Media>> media;
+
+	TargetList targets;
+	for(uint32_t c = 0; c < count; c++) {
+		Analyser::Machine machine{};
+		float confidence = 0.0f;
+		uint32_t analyser = 0;
+		std::vector<uint32_t> disks, tapes, cartridges, mass_storage_devices;
+		std::vector<uint8_t> bson;
+		record(machine, confidence, analyser, disks, tapes, cartridges, mass_storage_devices, bson);
+		if(!record.is_valid()) return {};
+
+		auto target = new_target(machine);
+		if(!target) return {};
+		target->confidence = confidence;
+
+		if(!disks.empty() || !tapes.empty() || !cartridges.empty() || !mass_storage_devices.empty()) {
+			if(analyser >= media.size()) media.resize(analyser + 1);
+			if(!media[analyser]) media[analyser] = GetMedia(file_name_);
+
+			const Media &source = *media[analyser];
+			if(
+				!select(target->media.disks, source.disks, disks) ||
+				!select(target->media.tapes, source.tapes, tapes) ||
+				!select(target->media.cartridges, source.cartridges, cartridges) ||
+				!select(target->media.mass_storage_devices, source.mass_storage_devices, mass_storage_devices)
+			) return {};
+		}
+
+		if(!bson.empty()) {
+			const auto reflective = dynamic_cast<Reflection::Struct *>(target.get());
+			if(!reflective || !reflective->deserialise(bson)) return {};
+		}
+
+		target->cache_fields(record);
+		if(!record.is_valid()) return {};
+
+		targets.push_back(std::move(target));
+	}
+	if(!record.is_at_end()) return {};
+
+	return targets;
+}
+
+void TargetCache::store(const TargetList &targets, const std::vector<Media> &media) {
+	if(targets.empty()) return;
+
+	std::vector<uint8_t> contents;
+	CacheFields record(contents);
+	uint32_t magic = Magic, version = AnalyserVersion, count = uint32_t(targets.size());
+	uint64_t hash = hash_, size = size_;
+	record(magic, version, hash, size, count);
+
+	for(const auto &target: targets) {
+		// A target can be restored only as a default instance of its type with fields applied;
+		// those with state or of unexpected types are therefore not cacheable.
+		const auto prototype = new_target(target->machine);
+		if(target->state || !prototype || typeid(*prototype) != typeid(*target)) return;
+
+		// Find the analyser that supplied this target's media.
+		std::vector<uint32_t> disks, tapes, cartridges, mass_storage_devices;
+		uint32_t analyser = 0;
+		while(analyser < media.size()) {
+			const Media &source = media[analyser];
+			if(
+				index(target->media.disks, source.disks, disks) &&
+				index(target->media.tapes, source.tapes, tapes) &&
+				index(target->media.cartridges, source.cartridges, cartridges) &&
+				index(target->media.mass_storage_devices, source.mass_storage_devices, mass_storage_devices)
+			) break;
+			++analyser;
+		}
+		if(analyser == media.size() && !target->media.empty()) return;
+
+		std::vector<uint8_t> bson;
+		if(const auto reflective = dynamic_cast<const Reflection::Struct *>(target.get())) {
+			bson = reflective->serialise();
+		}
+
+		Analyser::Machine machine = target->machine;
+		float confidence = target->confidence;
+		record(machine, confidence, analyser, disks, tapes, cartridges, mass_storage_devices, bson);
+		target->cache_fields(record);
+	}
+
+	// Write to a temporary file and then move that into place, so that an interrupted
+	// write can't leave a truncated list to be found later.
+	const std::string final_path = path();
+	const std::string temporary_path = final_path + ".tmp";
+	FILE *const file = fopen(temporary_path.c_str(), "wb");
+	if(!file) return;
+
+	const bool did_write = fwrite(contents.data(), 1, contents.size(), file) == contents.size();
+	if(fclose(file) || !did_write || rename(temporary_path.c_str(), final_path.c_str())) {
+		remove(temporary_path.c_str());
+	}
+}
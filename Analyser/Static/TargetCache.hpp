@@ -0,0 +1,67 @@
+//
+//  TargetCache.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 14/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#ifndef Analyser_Static_TargetCache_hpp
+#define Analyser_Static_TargetCache_hpp
+
+#include "StaticAnalyser.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Analyser {
+namespace Static {
+
+/*!
+	Stores the targets produced by static analysis between launches, so that a file needs to be
+	analysed only once.
+
+	Targets are stored in a file named for a hash of the analysed file's contents; each records its
+	machine, confidence, reflective fields and any others supplied via Target::cache_fields, plus
+	the positions of its media amongst those obtained from the file. Upon restoration the media are
+	obtained from the file anew and attached by position. Results are stored only if every target
+	can be described in that way.
+
+	Caching is disabled until a directory is supplied via @c set_directory.
+*/
+class TargetCache {
+	public:
+		/// Sets the directory in which targets are cached; an empty string disables caching.
+		static void set_directory(const std::string &directory);
+
+		/// @returns A cache for the targets of @c file_name, or @c nullptr if caching is disabled or the file can't be read.
+		static std::unique_ptr<TargetCache> cache_for(const std::string &file_name);
+
+		/// @returns The targets previously stored for this file, or an empty list if there are none.
+		TargetList get();
+
+		/*!
+			Stores @c targets, each of which should hold only media obtained from one of @c media,
+			which should be the media supplied to each analyser in turn; failure is silent as this is only a cache.
+		*/
+		void store(const TargetList &targets, const std::vector<Media> &media);
+
+		TargetCache(const std::string &directory, const std::string &file_name, uint64_t hash, uint64_t size);
+
+	private:
+		const std::string directory_;
+		const std::string file_name_;
+
+		// The file is identified by a hash of its contents plus its size; both are also
+		// stored with its targets so that hash collisions are detected.
+		const uint64_t hash_, size_;
+
+		std::string path() const;
+};
+
+}
+}
+
+#endif /* Analyser_Static_TargetCache_hpp */
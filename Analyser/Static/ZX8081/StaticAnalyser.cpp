@@ -12,6 +12,7 @@
 #include <vector>
 
 #include "Target.hpp"
+#include "../../../Storage/Tape/BoundedTape.hpp"
 #include "../../../Storage/Tape/Parsers/ZX8081.hpp"
 
 static std::vector<Storage::Data::ZX8081::File> GetFiles(const std::shared_ptr<Storage::Tape::Tape> &tape) {
@@ -31,7 +32,7 @@ static std::vector<Storage::Data::ZX8081::File> GetFiles(const std::shared_ptr<S
 Analyser::Static::TargetList Analyser::Static::ZX8081::GetTargets(const Media &media, const std::string &, TargetPlatform::IntType potential_platforms) {
 	TargetList destination;
 	if(!media.tapes.empty()) {
-		std::vector<Storage::Data::ZX8081::File> files = GetFiles(media.tapes.front());
+		std::vector<Storage::Data::ZX8081::File> files = Storage::Tape::AnalyseWithBudget(media.tapes.front(), [](const auto &tape) { return GetFiles(tape); });
 		media.tapes.front()->reset();
 		if(!files.empty()) {
 			Target *const target = new Target;
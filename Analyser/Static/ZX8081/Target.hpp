@@ -38,6 +38,10 @@ struct Target: public ::Analyser::Static::Target, public Reflection::StructImpl<
 			AnnounceEnum(MemoryModel);
 		}
 	}
+
+	void cache_fields(CacheFields &fields) final {
+		fields(loading_command);
+	}
 };
 
 }
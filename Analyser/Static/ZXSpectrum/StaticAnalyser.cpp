@@ -9,6 +9,7 @@
 #include "StaticAnalyser.hpp"
 
 #include "../../../Storage/Disk/Encodings/MFM/Parser.hpp"
+#include "../../../Storage/Tape/BoundedTape.hpp"
 #include "../../../Storage/Tape/Parsers/Spectrum.hpp"
 
 #include "Target.hpp"
@@ -19,9 +20,18 @@ bool IsSpectrumTape(const std::shared_ptr<Storage::Tape::Tape> &tape) {
 	using Parser = Storage::Tape::ZXSpectrum::Parser;
 	Parser parser(Parser::MachineType::ZXSpectrum);
 
+	// Look only at the start of the tape unless that contains no blocks at all.
+	const auto bounded = std::make_shared<Storage::Tape::BoundedTape>(tape);
+	const std::shared_ptr<Storage::Tape::Tape> source = bounded;
+	bool found_block = false;
 	while(true) {
-		const auto block = parser.find_block(tape);
-		if(!block) break;
+		const auto block = parser.find_block(source);
+		if(!block) {
+			if(found_block || !bounded->budget_is_exhausted()) break;
+			bounded->remove_budget();
+			continue;
+		}
+		found_block = true;
 
 		// Check for a Spectrum header block.
 		if(block->type == 0x00) {
@@ -36,6 +36,10 @@ struct Target: public ::Analyser::Static::Target, public Reflection::StructImpl<
 			AnnounceEnum(Model);
 		}
 	}
+
+	void cache_fields(CacheFields &fields) final {
+		fields(should_hold_enter);
+	}
 };
 
 }
@@ -0,0 +1,184 @@
+//
+//  ActorProfiling.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 14/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#ifndef ActorProfiling_h
+#define ActorProfiling_h
+
+#include "ClockReceiver.hpp"
+#include "ForceInline.hpp"
+#include "../Outputs/HostProfiler.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <typeinfo>
+#include <vector>
+
+#if __has_include(<cxxabi.h>)
+#include <cxxabi.h>
+#include <cstdlib>
+#endif
+
+/*!
+	Provides optional accounting of the time spent within, and the number of cycles supplied to, each
+	component that is clocked via a JustInTimeActor or AsyncJustInTimeActor.
+
+	Accounting is compiled in only if PROFILE_ACTORS is defined; otherwise it costs nothing.
+	Results are collected in the shared Registry, keyed by component name. By default the name
+	is that of the held type, but actors can be renamed via set_profiling_name.
+
+	Independently, each run_for is marked as a zone of the same name if a host profiler is enabled;
+	see HostProfiler.hpp.
+*/
+namespace ActorProfiling {
+
+#ifdef PROFILE_ACTORS
+constexpr bool is_enabled = true;
+#else
+constexpr bool is_enabled = false;
+#endif
+
+/// Accumulates the totals for a single named component; fields may be updated from any thread.
+struct Record {
+	std::atomic<uint64_t> nanoseconds = 0;
+	std::atomic<uint64_t> half_cycles = 0;
+	std::atomic<uint64_t> calls = 0;
+};
+
+/// A point-in-time copy of a Record.
+struct Summary {
+	std::string name;
+	double seconds;
+	double cycles;
+	uint64_t calls;
+};
+
+class Registry {
+	public:
+		/// @returns The registry to which all actors report.
+		static Registry &shared() {
+			static Registry registry;
+			return registry;
+		}
+
+		/// @returns The record for the component named @c name, creating it if necessary.
+		/// Records are never destroyed, so the reference remains valid indefinitely.
+		Record &record(const std::string &name) {
+			std::lock_guard lock(mutex_);
+			return records_[name];
+		}
+
+		/// @returns A copy of all totals accumulated so far, sorted by name.
+		std::vector<Summary> summaries() {
+			std::lock_guard lock(mutex_);
+			std::vector<Summary> result;
+			for(const auto &record: records_) {
+				result.push_back(Summary{
+					record.first,
+					double(record.second.nanoseconds) / 1'000'000'000.0,
+					double(record.second.half_cycles) / 2.0,
+					record.second.calls
+				});
+			}
+			return result;
+		}
+
+		/// Zeroes all totals.
+		void reset() {
+			std::lock_guard lock(mutex_);
+			for(auto &record: records_) {
+				record.second.nanoseconds = 0;
+				record.second.half_cycles = 0;
+				record.second.calls = 0;
+			}
+		}
+
+	private:
+		std::mutex mutex_;
+		std::map<std::string, Record> records_;
+};
+
+/// @returns The name of @c Type, demangled if possible.
+template <typename Type> std::string type_name() {
+	const char *const name = typeid(Type).name();
+#if __has_include(<cxxabi.h>)
+	int status = 0;
+	char *const demangled = abi::__cxa_demangle(name, nullptr, nullptr, &status);
+	if(demangled) {
+		std::string result = demangled;
+		std::free(demangled);
+		return result;
+	}
+#endif
+	return name;
+}
+
+/*!
+	A probe is owned by an actor and wraps each call into its component's run_for;
+	the disabled version does nothing other than perform the call, within a host profiler
+	zone if there is a host profiler.
+*/
+template <bool enabled = is_enabled> class Probe {
+	public:
+		template <typename Type> Probe(const Type *) {
+			if constexpr (Outputs::HostProfiler::is_enabled) {
+				set_name(type_name<Type>());
+			}
+		}
+		void set_name(const std::string &name) {
+			if constexpr (Outputs::HostProfiler::is_enabled) {
+				zone_name_ = Outputs::HostProfiler::Name(name);
+			}
+		}
+
+		template <typename TimeScale, typename Function> forceinline void measure(TimeScale, const Function &function) {
+			const Outputs::HostProfiler::Zone zone(zone_name_);
+			function();
+		}
+
+	private:
+		Outputs::HostProfiler::Name zone_name_;
+};
+
+template <> class Probe<true> {
+	public:
+		template <typename Type> Probe(const Type *) {
+			set_name(type_name<Type>());
+		}
+
+		void set_name(const std::string &name) {
+			record_ = &Registry::shared().record(name);
+			zone_name_ = Outputs::HostProfiler::Name(name);
+		}
+
+		template <typename TimeScale, typename Function> void measure(TimeScale duration, const Function &function) {
+			const Outputs::HostProfiler::Zone zone(zone_name_);
+			const auto start = std::chrono::steady_clock::now();
+			function();
+			const auto end = std::chrono::steady_clock::now();
+
+			record_->nanoseconds += uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+			record_->calls += 1;
+			if constexpr (std::is_same_v<TimeScale, HalfCycles>) {
+				record_->half_cycles += uint64_t(duration.as_integral());
+			} else {
+				record_->half_cycles += uint64_t(duration.as_integral()) * 2;
+			}
+		}
+
+	private:
+		Record *record_ = nullptr;
+		Outputs::HostProfiler::Name zone_name_;
+};
+
+}
+
+#endif /* ActorProfiling_h */
@@ -9,40 +9,48 @@
 #ifndef DeferredQueue_h
 #define DeferredQueue_h
 
+#include "../Concurrency/InlineTask.hpp"
+
 #include <functional>
 #include <vector>
 
 /*!
 	Provides the logic to insert into and traverse a list of future scheduled items.
+
+	Actions are stored as InlineTasks within a ring buffer that grows only if a new high-water mark is
+	reached, so in steady-state use neither deferral nor advancement allocates. Each action
+	is stored with the absolute time at which it should occur, so advancement is a single addition.
 */
 template <typename TimeUnit> class DeferredQueue {
 	public:
 		/*!
 			Schedules @c action to occur in @c delay units of time.
 		*/
-		void defer(TimeUnit delay, const std::function<void(void)> &action) {
+		template <typename Function> void defer(TimeUnit delay, Function &&action) {
 			// Apply immediately if there's no delay (or a negative delay).
 			if(delay <= TimeUnit(0)) {
 				action();
 				return;
 			}
 
-			if(!pending_actions_.empty()) {
-				// Otherwise enqueue, having subtracted the delay for any preceding events,
-				// and subtracting from the subsequent, if any.
-				auto insertion_point = pending_actions_.begin();
-				while(insertion_point != pending_actions_.end() && insertion_point->delay < delay) {
-					delay -= insertion_point->delay;
-					++insertion_point;
-				}
-				if(insertion_point != pending_actions_.end()) {
-					insertion_point->delay -= delay;
-				}
-
-				pending_actions_.emplace(insertion_point, delay, action);
-			} else {
-				pending_actions_.emplace_back(delay, action);
+			if(count_ == pending_actions_.size()) {
+				grow();
 			}
+
+			// Find the insertion point, searching backwards on the basis that new actions
+			// are most likely to be last. An action is inserted ahead of any others
+			// scheduled for the same time.
+			const TimeUnit time = now_ + delay;
+			size_t index = count_;
+			while(index && action_at(index - 1).time >= time) {
+				action_at(index) = std::move(action_at(index - 1));
+				--index;
+			}
+
+			auto &slot = action_at(index);
+			slot.time = time;
+			slot.action = std::forward<Function>(action);
+			++count_;
 		}
 
 		/*!
@@ -50,39 +58,57 @@ template <typename TimeUnit> class DeferredQueue {
 				or TimeUnit(-1) if the queue is empty.
 		*/
 		TimeUnit time_until_next_action() const {
-			if(pending_actions_.empty()) return TimeUnit(-1);
-			return pending_actions_.front().delay;
+			if(!count_) return TimeUnit(-1);
+			return pending_actions_[head_].time - now_;
 		}
 
 		/*!
 			Advances the queue the specified amount of time, performing any actions it reaches.
 		*/
 		void advance(TimeUnit time) {
-			auto erase_iterator = pending_actions_.begin();
-			while(erase_iterator != pending_actions_.end()) {
-				erase_iterator->delay -= time;
-				if(erase_iterator->delay <= TimeUnit(0)) {
-					time = -erase_iterator->delay;
-					erase_iterator->action();
-					++erase_iterator;
-				} else {
-					break;
-				}
+			now_ += time;
+
+			while(count_ && pending_actions_[head_].time <= now_) {
+				// Remove the action before performing it, in case it defers anything further.
+				auto action = std::move(pending_actions_[head_].action);
+				head_ = (head_ + 1) & (pending_actions_.size() - 1);
+				--count_;
+
+				action();
 			}
-			if(erase_iterator != pending_actions_.begin()) {
-				pending_actions_.erase(pending_actions_.begin(), erase_iterator);
+
+			// Keep time values small by resetting the origin whenever the queue is empty.
+			if(!count_) {
+				now_ = TimeUnit(0);
 			}
 		}
 
 	private:
 		// The list of deferred actions.
 		struct DeferredAction {
-			TimeUnit delay;
-			std::function<void(void)> action;
-
-			DeferredAction(TimeUnit delay, const std::function<void(void)> &action) : delay(delay), action(std::move(action)) {}
+			TimeUnit time;
+			Concurrency::InlineTask<> action;
 		};
-		std::vector<DeferredAction> pending_actions_;
+
+		// A ring buffer of actions, ordered by time, of which count_ are live starting from head_.
+		// Its size is always a power of two.
+		std::vector<DeferredAction> pending_actions_ = std::vector<DeferredAction>(8);
+		size_t head_ = 0;
+		size_t count_ = 0;
+		TimeUnit now_ = TimeUnit(0);
+
+		DeferredAction &action_at(size_t index) {
+			return pending_actions_[(head_ + index) & (pending_actions_.size() - 1)];
+		}
+
+		void grow() {
+			std::vector<DeferredAction> new_actions(pending_actions_.size() * 2);
+			for(size_t c = 0; c < count_; c++) {
+				new_actions[c] = std::move(action_at(c));
+			}
+			pending_actions_ = std::move(new_actions);
+			head_ = 0;
+		}
 };
 
 /*!
@@ -113,8 +139,6 @@ template <typename TimeUnit> class DeferredQueuePerformer: public DeferredQueue<
 
 			DeferredQueue<TimeUnit>::advance(length);
 			target_(length);
-
-			// TODO: optimise this to avoid the multiple std::vector deletes. Find a neat way to expose that solution, maybe?
 		}
 
 	private:
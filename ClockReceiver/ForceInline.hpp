@@ -23,4 +23,13 @@
 
 #endif
 
+// Marks functions that should be kept out of line, e.g. rarely-taken paths from a hot loop.
+#ifdef __GNUC__
+#define neverinline __attribute__((noinline))
+#elif _MSC_VER
+#define neverinline __declspec(noinline)
+#else
+#define neverinline
+#endif
+
 #endif /* ForceInline_h */
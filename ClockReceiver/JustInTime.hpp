@@ -10,9 +10,12 @@
 #define JustInTime_h
 
 #include "../Concurrency/AsyncTaskQueue.hpp"
+#include "ActorProfiling.hpp"
 #include "ClockingHintSource.hpp"
 #include "ForceInline.hpp"
 
+#include <cassert>
+
 /*!
 	A JustInTimeActor holds (i) an embedded object with a run_for method; and (ii) an amount
 	of time since run_for was last called.
@@ -30,7 +33,7 @@
 	observer and potentially stop clocking or stop delaying clocking until just-in-time references
 	as directed.
 
-	TODO: incorporate and codify AsyncJustInTimeActor.
+	See also AsyncJustInTimeActor, below, for objects that can run in parallel with their owner.
 */
 template <class T, class LocalTimeScale = HalfCycles, int multiplier = 1, int divider = 1> class JustInTimeActor:
 	public ClockingHint::Observer {
@@ -72,7 +75,7 @@ template <class T, class LocalTimeScale = HalfCycles, int multiplier = 1, int di
 
 	public:
 		/// Constructs a new JustInTimeActor using the same construction arguments as the included object.
-		template<typename... Args> JustInTimeActor(Args&&... args) : object_(std::forward<Args>(args)...) {
+		template<typename... Args> JustInTimeActor(Args&&... args) : object_(std::forward<Args>(args)...), probe_(&object_) {
 			if constexpr (std::is_base_of<ClockingHint::Source, T>::value) {
 				object_.set_clocking_hint_observer(this);
 			}
@@ -168,11 +171,11 @@ template <class T, class LocalTimeScale = HalfCycles, int multiplier = 1, int di
 				did_flush_ = is_flushed_ = true;
 				if constexpr (divider == 1) {
 					const auto duration = time_since_update_.template flush<TargetTimeScale>();
-					object_.run_for(duration);
+					probe_.measure(duration, [&] { object_.run_for(duration); });
 				} else {
 					const auto duration = time_since_update_.template divide<TargetTimeScale>(LocalTimeScale(divider));
 					if(duration > TargetTimeScale(0))
-						object_.run_for(duration);
+						probe_.measure(duration, [&] { object_.run_for(duration); });
 				}
 			}
 		}
@@ -193,7 +196,14 @@ template <class T, class LocalTimeScale = HalfCycles, int multiplier = 1, int di
 		/// @returns the number of cycles until the next sequence-point-based flush, if the embedded object
 		/// supports sequence points; @c LocalTimeScale() otherwise.
 		[[nodiscard]] LocalTimeScale cycles_until_implicit_flush() const {
-			return time_until_event_ / divider;
+			// time_until_event_ is kept in local units scaled by the multiplier; round up so that adding
+			// the result is sufficient to reach the sequence point.
+			if constexpr (multiplier == 1) {
+				return time_until_event_;
+			} else {
+				if(time_until_event_ == LocalTimeScale::max()) return time_until_event_;
+				return LocalTimeScale((time_until_event_.as_integral() + multiplier - 1) / multiplier);
+			}
 		}
 
 		/// Indicates whether a sequence-point-caused flush will occur if the specified period is added.
@@ -201,7 +211,7 @@ template <class T, class LocalTimeScale = HalfCycles, int multiplier = 1, int di
 			if constexpr (!has_sequence_points<T>::value) {
 				return false;
 			}
-			return rhs >= time_until_event_;
+			return rhs * multiplier >= time_until_event_;
 		}
 
 		/// Indicates the amount of time, in the local time scale, until the first local slot that falls wholly
@@ -234,11 +244,13 @@ template <class T, class LocalTimeScale = HalfCycles, int multiplier = 1, int di
 				if constexpr (divider == 1 && std::is_same_v<LocalTimeScale, TargetTimeScale>) {
 					time_until_event_ = object_.get_next_sequence_point();
 				} else {
+					// Any remainder left over by the most recent divided flush already counts
+					// towards the sequence point.
 					const auto time = object_.get_next_sequence_point();
 					if(time == TargetTimeScale::max()) {
 						time_until_event_ = LocalTimeScale::max();
 					} else {
-						time_until_event_ = time * divider;
+						time_until_event_ = LocalTimeScale(time * divider) - time_since_update_;
 					}
 				}
 				assert(time_until_event_ > LocalTimeScale(0));
@@ -250,11 +262,17 @@ template <class T, class LocalTimeScale = HalfCycles, int multiplier = 1, int di
 			return clocking_preference_;
 		}
 
+		/// Sets the name under which this actor's component is reported if ActorProfiling is enabled.
+		void set_profiling_name(const std::string &name) {
+			probe_.set_name(name);
+		}
+
 	private:
 		T object_;
 		LocalTimeScale time_since_update_, time_until_event_, time_overrun_;
 		bool is_flushed_ = true;
 		bool did_flush_ = false;
+		ActorProfiling::Probe<> probe_;
 
 		template <typename S, typename = void> struct has_sequence_points : std::false_type {};
 		template <typename S> struct has_sequence_points<S, decltype(void(std::declval<S &>().get_next_sequence_point()))> : std::true_type {};
@@ -268,53 +286,184 @@ template <class T, class LocalTimeScale = HalfCycles, int multiplier = 1, int di
 /*!
 	An AsyncJustInTimeActor acts like a JustInTimeActor but additionally contains an AsyncTaskQueue.
 	Any time the amount of accumulated time crosses a threshold provided at construction time,
-	the object will be updated on the AsyncTaskQueue.
+	that time will be pushed to the object on the AsyncTaskQueue, allowing the object to run in
+	parallel with the actor's owner.
+
+	The owner synchronises with the task queue only upon use of the -> operator or of flush(), or if
+	the held object implements get_next_sequence_point() then whenever a sequence point is reached.
+
+	Held objects must therefore tolerate running in parallel with whatever their owner does between
+	synchronisation points: they shouldn't signal back into their owner from within run_for, and shouldn't
+	depend on any state that the owner might modify without first using -> or flush().
+
+	Clocking hints are not currently supported.
 */
-template <class T, class LocalTimeScale = HalfCycles, class TargetTimeScale = LocalTimeScale> class AsyncJustInTimeActor {
+template <class T, class LocalTimeScale = HalfCycles, int multiplier = 1, int divider = 1> class AsyncJustInTimeActor {
+	private:
+		/// As per the JustInTimeActor equivalent: updates the actor's sequence point upon destruction.
+		class SequencePointAwareDeleter {
+			public:
+				explicit SequencePointAwareDeleter(AsyncJustInTimeActor<T, LocalTimeScale, multiplier, divider> *actor) noexcept
+					: actor_(actor) {}
+
+				forceinline void operator ()(const T *const) const {
+					if constexpr (has_sequence_points<T>::value) {
+						actor_->update_sequence_point();
+					}
+				}
+
+			private:
+				AsyncJustInTimeActor<T, LocalTimeScale, multiplier, divider> *const actor_;
+		};
+
+		// This block of SFINAE determines whether objects of type T accepts Cycles or HalfCycles.
+		using HalfRunFor = void (T::*const)(HalfCycles);
+		static uint8_t half_sig(...);
+		static uint16_t half_sig(HalfRunFor);
+		using TargetTimeScale =
+			std::conditional_t<
+				sizeof(half_sig(&T::run_for)) == sizeof(uint16_t),
+				HalfCycles,
+				Cycles>;
+
 	public:
-		/// Constructs a new AsyncJustInTimeActor using the same construction arguments as the included object.
-		template<typename... Args> AsyncJustInTimeActor(TargetTimeScale threshold, Args&&... args) :
+		/// Constructs a new AsyncJustInTimeActor using the same construction arguments as the included object;
+		/// accumulated time will be posted to the object asynchronously whenever more than @c threshold
+		/// has accumulated.
+		template<typename... Args> AsyncJustInTimeActor(LocalTimeScale threshold, Args&&... args) :
 			object_(std::forward<Args>(args)...),
-		 	threshold_(threshold) {}
+			threshold_(threshold * multiplier),
+			probe_(&object_) {}
 
 		/// Adds time to the actor.
-		inline void operator += (const LocalTimeScale &rhs) {
-			time_since_update_ += rhs;
-			if(time_since_update_ >= threshold_) {
-				time_since_update_ -= threshold_;
-				task_queue_.enqueue([this] () {
-					object_.run_for(threshold_);
-				});
+		///
+		/// @returns @c true if adding time caused a synchronous flush; @c false otherwise.
+		forceinline bool operator += (LocalTimeScale rhs) {
+			if constexpr (multiplier != 1) {
+				time_since_update_ += rhs * multiplier;
+			} else {
+				time_since_update_ += rhs;
 			}
 			is_flushed_ = false;
+
+			if constexpr (has_sequence_points<T>::value) {
+				time_until_event_ -= rhs * multiplier;
+				if(time_until_event_ <= LocalTimeScale(0)) {
+					flush();
+					update_sequence_point();
+					return true;
+				}
+			}
+
+			if(time_since_update_ >= threshold_) {
+				post_time();
+			}
+			return false;
 		}
 
-		/// Flushes all accumulated time and returns a pointer to the included object.
-		inline T *operator->() {
+		/// Flushes all accumulated time, waiting for the object to catch up, and returns a pointer to it.
+		///
+		/// If this object provides sequence points, checks for changes to the next
+		/// sequence point upon deletion of the pointer.
+		[[nodiscard]] forceinline auto operator->() {
 			flush();
-			return &object_;
+			return std::unique_ptr<T, SequencePointAwareDeleter>(&object_, SequencePointAwareDeleter(this));
 		}
 
-		/// Returns a pointer to the included object without flushing time.
-		inline T *last_valid() {
+		/// @returns a pointer to the included object, without flushing time. The object may currently
+		/// be running on the task queue.
+		[[nodiscard]] forceinline T *last_valid() {
 			return &object_;
 		}
 
-		/// Flushes all accumulated time.
-		inline void flush() {
+		/// Flushes all accumulated time, and waits until the object has caught up.
+		///
+		/// This does not affect this actor's record of when the next sequence point will occur.
+		forceinline void flush() {
 			if(!is_flushed_) {
-				task_queue_.flush();
-				object_.run_for(time_since_update_.template flush<TargetTimeScale>());
 				is_flushed_ = true;
+				task_queue_.flush();
+
+				const auto duration = target_time();
+				if(duration > TargetTimeScale(0)) {
+					probe_.measure(duration, [&] { object_.run_for(duration); });
+				}
 			}
 		}
 
+		/// @returns the number of cycles until the next sequence-point-based flush, if the embedded object
+		/// supports sequence points; @c LocalTimeScale() otherwise.
+		[[nodiscard]] LocalTimeScale cycles_until_implicit_flush() const {
+			// As per JustInTimeActor: time_until_event_ is kept in local units scaled by the multiplier.
+			if constexpr (multiplier == 1) {
+				return time_until_event_;
+			} else {
+				if(time_until_event_ == LocalTimeScale::max()) return time_until_event_;
+				return LocalTimeScale((time_until_event_.as_integral() + multiplier - 1) / multiplier);
+			}
+		}
+
+		/// Indicates whether a sequence-point-caused flush will occur if the specified period is added.
+		[[nodiscard]] forceinline bool will_flush(LocalTimeScale rhs) const {
+			if constexpr (!has_sequence_points<T>::value) {
+				return false;
+			}
+			return rhs * multiplier >= time_until_event_;
+		}
+
+		/// Updates this template's record of the next sequence point; this should be called only
+		/// while the actor is flushed.
+		void update_sequence_point() {
+			if constexpr (has_sequence_points<T>::value) {
+				// Any remainder left over by the most recent divided flush already counts
+				// towards the sequence point.
+				const auto time = object_.get_next_sequence_point();
+				if(time == TargetTimeScale::max()) {
+					time_until_event_ = LocalTimeScale::max();
+				} else {
+					time_until_event_ = LocalTimeScale(time * divider) - time_since_update_;
+				}
+				assert(time_until_event_ > LocalTimeScale(0));
+			}
+		}
+
+		/// Sets the name under which this actor's component is reported if ActorProfiling is enabled.
+		void set_profiling_name(const std::string &name) {
+			probe_.set_name(name);
+		}
+
 	private:
 		T object_;
-		LocalTimeScale time_since_update_;
-		TargetTimeScale threshold_;
+		LocalTimeScale time_since_update_, time_until_event_;
+		const LocalTimeScale threshold_;
 		bool is_flushed_ = true;
-		Concurrency::AsyncTaskQueue task_queue_;
+		ActorProfiling::Probe<> probe_;
+
+		template <typename S, typename = void> struct has_sequence_points : std::false_type {};
+		template <typename S> struct has_sequence_points<S, decltype(void(std::declval<S &>().get_next_sequence_point()))> : std::true_type {};
+
+		/// Converts as much accumulated time as possible to the target time scale, retaining any remainder.
+		forceinline TargetTimeScale target_time() {
+			if constexpr (divider == 1) {
+				return time_since_update_.template flush<TargetTimeScale>();
+			} else {
+				return time_since_update_.template divide<TargetTimeScale>(LocalTimeScale(divider));
+			}
+		}
+
+		/// Posts all accumulated time to the object via the task queue.
+		void post_time() {
+			const auto duration = target_time();
+			if(duration > TargetTimeScale(0)) {
+				task_queue_.enqueue([this, duration] {
+					probe_.measure(duration, [&] { object_.run_for(duration); });
+				});
+			}
+		}
+
+		// Declared last so that it is destroyed first, completing any outstanding work
+		// while object_ still exists.
+		Concurrency::AsyncTaskQueue task_queue_{Concurrency::AsyncTaskQueue::Producers::Single};
 };
 
 #endif /* JustInTime_h */
@@ -0,0 +1,166 @@
+//
+//  ParallelGroup.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 14/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#ifndef ParallelGroup_hpp
+#define ParallelGroup_hpp
+
+#include "ClockReceiver.hpp"
+#include "ForceInline.hpp"
+#include "../Concurrency/AsyncTaskQueue.hpp"
+
+#include <functional>
+#include <utility>
+#include <vector>
+
+/*!
+	Carries signals from a component that is run by a ParallelGroup to the rest of its machine.
+
+	A signal posted while the component is running on the group's thread is held until the owner
+	next synchronises with the group; a signal posted at any other time — including while the owner
+	is itself bringing the component up to date — is performed immediately.
+*/
+class ParallelSignals {
+	public:
+		/// Performs @c signal now if that is safe; otherwise defers it until the owner next synchronises.
+		void post(std::function<void(void)> &&signal) {
+			if(running_group_ != this) {
+				signal();
+				return;
+			}
+
+			// Signals are collected only on the group's thread and performed only once the owner
+			// has waited for that thread to finish, so need no further protection.
+			signals_.push_back(std::move(signal));
+		}
+
+	protected:
+		/// Performs all deferred signals in the order they were posted; this should be called
+		/// only by the owner while the group is idle.
+		void deliver() {
+			for(auto &signal: signals_) {
+				signal();
+			}
+			signals_.clear();
+		}
+
+		/// The signals to which anything posted on this thread should be directed, if any.
+		static inline thread_local const ParallelSignals *running_group_ = nullptr;
+
+	private:
+		std::vector<std::function<void(void)>> signals_;
+};
+
+/*!
+	Runs a loosely-coupled component — or a group of components behind a single run_for — on a thread
+	of its own, in parallel with the machine that owns it.
+
+	The owner adds time to the group as it runs and the component follows behind, catching up in
+	batches on a task queue. The owner calls @c synchronise, or uses the -> operator, at each of
+	the declared communication points between the two, i.e. before anything that might observe or
+	affect the component; that waits until the component has caught up fully. Lookahead is bounded:
+	at most @c MaxBatches may be outstanding before the owner waits for the component regardless.
+
+	The component must not signal directly into its owner, which may be running concurrently; it
+	should instead send signals via @c post. Those posted while running in parallel are performed when the
+	owner next synchronises — which is exactly when they would occur if the component were simply run up to date at
+	each communication point. So a component that is already run lazily in that fashion behaves identically when
+	run in parallel.
+
+	Batches are posted only once @c batch time has accumulated without a synchronisation, so this costs very little
+	while the two are interacting closely. Groups run synchronously until @c set_is_parallel is called.
+*/
+template <class T, class TimeScale = Cycles> class ParallelGroup: public ParallelSignals {
+	public:
+		/// The maximum number of batches that may be outstanding before the owner waits for the component.
+		static constexpr int MaxBatches = 8;
+
+		/// Constructs a group that will run @c component, which may instead be supplied later via
+		/// @c set_component, posting time in batches of @c batch.
+		ParallelGroup(TimeScale batch, T *component = nullptr) : batch_(batch), component_(component) {}
+
+		/// Synchronises and then sets the component that this group runs.
+		void set_component(T *component) {
+			synchronise();
+			component_ = component;
+		}
+
+		/// Synchronises and then sets whether this group runs its component in parallel with the owner.
+		void set_is_parallel(bool is_parallel) {
+			synchronise();
+			is_parallel_ = is_parallel;
+		}
+
+		/// Adds time to the group.
+		forceinline void operator += (TimeScale rhs) {
+			time_since_update_ += rhs;
+			if(is_parallel_ && time_since_update_ >= batch_) {
+				post_time();
+			}
+		}
+
+		/// Waits until the component has run for all time so far added, then performs any signals
+		/// it posted while doing so.
+		void synchronise() {
+			if(is_running_ahead_) {
+				queue_.flush();
+				deliver();
+				is_running_ahead_ = false;
+				outstanding_batches_ = 0;
+			}
+
+			const auto duration = time_since_update_.template flush<TimeScale>();
+			if(component_ && duration > TimeScale(0)) {
+				component_->run_for(duration);
+			}
+		}
+
+		/// Synchronises and returns the component.
+		[[nodiscard]] forceinline T *operator->() {
+			synchronise();
+			return component_;
+		}
+
+		/// @returns The component, without synchronising; it may currently be running.
+		[[nodiscard]] forceinline T *last_valid() {
+			return component_;
+		}
+
+	private:
+		const TimeScale batch_;
+		T *component_ = nullptr;
+		TimeScale time_since_update_;
+
+		bool is_parallel_ = false;
+		bool is_running_ahead_ = false;
+		int outstanding_batches_ = 0;
+
+		void post_time() {
+			const auto duration = time_since_update_.template flush<TimeScale>();
+			if(!component_) return;
+
+			// Bound the lookahead; signals remain deferred until the next synchronisation.
+			if(outstanding_batches_ == MaxBatches) {
+				queue_.flush();
+				outstanding_batches_ = 0;
+			}
+
+			++outstanding_batches_;
+			is_running_ahead_ = true;
+			queue_.enqueue([this, duration] {
+				running_group_ = this;
+				component_->run_for(duration);
+				running_group_ = nullptr;
+			});
+		}
+
+		// Declared last so that it is destroyed first, completing any outstanding work
+		// while the component still exists.
+		Concurrency::AsyncTaskQueue queue_{Concurrency::AsyncTaskQueue::Producers::Single};
+};
+
+#endif /* ParallelGroup_hpp */
@@ -10,8 +10,11 @@
 #define ScanSynchroniser_h
 
 #include "../Outputs/ScanTarget.hpp"
+#include "TimeHistogram.hpp"
 
 #include <cmath>
+#include <cstdint>
+#include <string>
 
 namespace Time {
 
@@ -28,6 +31,10 @@ class ScanSynchroniser {
 				current @c [scan]status and the host machine's @c frame_duration; @c false otherwise.
 		*/
 		bool can_synchronise(const Outputs::Display::ScanStatus &scan_status, double frame_duration) {
+			++statistics_.frames;
+			statistics_.emulation_time.post(emulation_time_);
+			emulation_time_ = 0;
+
 			ratio_ = 1.0;
 			if(scan_status.field_duration_gradient < 0.00001) {
 				// Check out the machine's current frame time.
@@ -37,7 +44,9 @@ class ScanSynchroniser {
 				const double integer_ratio = round(ratio_);
 				if(integer_ratio > 0.0) {
 					ratio_ /= integer_ratio;
-					return ratio_ <= maximum_rate_adjustment && ratio_ >= 1.0 / maximum_rate_adjustment;
+					const bool can_synchronise = ratio_ <= maximum_rate_adjustment && ratio_ >= 1.0 / maximum_rate_adjustment;
+					statistics_.synchronised_frames += can_synchronise;
+					return can_synchronise;
 				}
 			}
 			return false;
@@ -58,8 +67,10 @@ class ScanSynchroniser {
 			if(scan_status.current_position > 0.0) {
 				if(scan_status.current_position < 0.5) speed_multiplier /= phase_adjustment_ratio;
 				else speed_multiplier *= phase_adjustment_ratio;
+				++statistics_.phase_adjustments;
 			}
 			speed_multiplier_ = (speed_multiplier_ * 0.95) + (speed_multiplier * 0.05);
+			++statistics_.speed_adjustments;
 			return speed_multiplier_ * base_multiplier_;
 		}
 
@@ -71,6 +82,51 @@ class ScanSynchroniser {
 			return base_multiplier_;
 		}
 
+		/*!
+			Adds @c duration to the total amount of real time spent running the emulated machine during
+			the current host frame; totals are recorded as each frame ends with a call to @c can_synchronise.
+		*/
+		void add_emulation_time(Time::Nanos duration) {
+			emulation_time_ += duration;
+		}
+
+		/*!
+			Counts and distributions of synchronisation activity since construction or the last call to
+			@c reset_statistics, for use in tuning frame pacing.
+		*/
+		struct Statistics {
+			/// The number of host frames, i.e. calls to @c can_synchronise.
+			uint64_t frames = 0;
+			/// The number of frames for which synchronisation was possible.
+			uint64_t synchronised_frames = 0;
+			/// The number of speed multipliers supplied, i.e. calls to @c next_speed_multiplier.
+			uint64_t speed_adjustments = 0;
+			/// The number of those that were additionally nudged to bring vertical sync into phase.
+			uint64_t phase_adjustments = 0;
+			/// Real time spent in emulation per host frame, as supplied to @c add_emulation_time.
+			Histogram emulation_time{0, 500'000, 64};
+
+			/// @returns A multi-line summary of all of the above.
+			std::string summary() const {
+				return
+					"Frames: " + std::to_string(frames) +
+					", synchronised: " + std::to_string(synchronised_frames) +
+					", speed adjustments: " + std::to_string(speed_adjustments) +
+					", phase adjustments: " + std::to_string(phase_adjustments) + "\n"
+					"Emulation time per frame: " + emulation_time.summary();
+			}
+		};
+
+		/// @returns Statistics collected since construction or the most recent call to @c reset_statistics.
+		const Statistics &statistics() const {
+			return statistics_;
+		}
+
+		/// Discards all statistics collected so far; synchronisation is unaffected.
+		void reset_statistics() {
+			statistics_ = Statistics();
+		}
+
 	private:
 		static constexpr double maximum_rate_adjustment = 1.03;
 		static constexpr double phase_adjustment_ratio = 1.005;
@@ -81,6 +137,9 @@ class ScanSynchroniser {
 
 		// Temporary storage to bridge the can_synchronise -> next_speed_multiplier gap.
 		double ratio_ = 1.0;
+
+		Time::Nanos emulation_time_ = 0;
+		Statistics statistics_;
 };
 
 }
@@ -0,0 +1,95 @@
+//
+//  SlicePolicy.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 14/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#ifndef SlicePolicy_hpp
+#define SlicePolicy_hpp
+
+#include "TimeTypes.hpp"
+
+#include <algorithm>
+#include <atomic>
+
+namespace Time {
+
+/// The bounds within which a SlicePolicy operates.
+struct SliceLimits {
+	/// The shortest slice, used while responding to input or refilling the audio buffer.
+	Nanos minimum = 1'000'000;
+	/// The slice length adopted initially.
+	Nanos nominal = 4'000'000;
+	/// The longest slice, adopted only after a sustained absence of input.
+	Nanos maximum = 16'000'000;
+	/// The period for which slices are kept at the minimum after any input.
+	Nanos input_holdoff = 250'000'000;
+};
+
+/*!
+	Decides how long a host should wait between successive calls to run a machine.
+
+	Longer slices cost less in synchronisation and make better use of the host's caches, but
+	delay input and produce audio less regularly. So slices lengthen gradually while there has
+	been no recent input and the audio buffer is healthy, and drop back to the minimum as soon
+	as input arrives or the audio buffer runs low.
+
+	If the time of the next output vsync can be predicted, a slice that would otherwise span it
+	is cut short to end there, so that each frame is produced from as much emulation as possible.
+*/
+class SlicePolicy {
+	public:
+		SlicePolicy(SliceLimits limits = {}) : limits_(limits), slice_(limits.nominal) {}
+
+		/// Announces that input was received at @c time. This may be called from any thread.
+		void announce_input(Nanos time) {
+			last_input_.store(time, std::memory_order_relaxed);
+		}
+
+		/*!
+			Supplies the amount of audio currently buffered as a proportion of the amount that the
+			audio output aims to keep buffered, i.e. 1.0 is exactly on target.
+		*/
+		void set_audio_level(float level) {
+			audio_level_ = level;
+		}
+
+		/*!
+			@returns The time at which the machine should next be run, given that it has just been run
+			up to @c now and that the next output vsync is expected at @c next_vsync, or that vsync
+			can't currently be predicted if @c next_vsync is 0.
+		*/
+		Nanos next_update(Nanos now, Nanos next_vsync = 0) {
+			const bool input_is_recent = now - last_input_.load(std::memory_order_relaxed) < limits_.input_holdoff;
+			if(input_is_recent || audio_level_ < 0.5f) {
+				slice_ = limits_.minimum;
+			} else if(audio_level_ < 0.8f) {
+				slice_ = std::max(limits_.minimum, slice_ >> 1);
+			} else {
+				slice_ = std::min(limits_.maximum, slice_ + (slice_ >> 2));
+			}
+
+			const Nanos next = now + slice_;
+			if(next_vsync > now + limits_.minimum && next_vsync < next) {
+				return next_vsync;
+			}
+			return next;
+		}
+
+		/// @returns The slice length most recently selected by @c next_update, which may since have been cut short for vsync.
+		Nanos slice() const {
+			return slice_;
+		}
+
+	private:
+		const SliceLimits limits_;
+		Nanos slice_;
+		float audio_level_ = 1.0f;
+		std::atomic<Nanos> last_input_ = 0;
+};
+
+}
+
+#endif /* SlicePolicy_hpp */
@@ -0,0 +1,147 @@
+//
+//  TimeHistogram.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 14/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#ifndef TimeHistogram_h
+#define TimeHistogram_h
+
+#include "TimeTypes.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace Time {
+
+/*!
+	Records the distribution of a series of time periods: a count of values falling into each of
+	a fixed number of equally-sized buckets, plus the exact count, total, minimum and maximum.
+
+	Values below the range of the buckets are counted in the first; values above it in the last.
+
+	This class is not thread safe.
+*/
+class Histogram {
+	public:
+		/*!
+			Constructs a histogram with @c bucket_count buckets, each @c bucket_width nanoseconds wide,
+			the first of which begins at @c lowest.
+		*/
+		Histogram(Nanos lowest, Nanos bucket_width, size_t bucket_count = 32) :
+			lowest_(lowest), bucket_width_(std::max(bucket_width, Nanos(1))), buckets_(std::max(bucket_count, size_t(1))) {}
+
+		/// Adds @c value to the histogram.
+		void post(Nanos value) {
+			const Nanos index = (value - lowest_) / bucket_width_;
+			++buckets_[size_t(std::clamp(index, Nanos(0), Nanos(buckets_.size() - 1)))];
+
+			++count_;
+			total_ += value;
+			minimum_ = std::min(minimum_, value);
+			maximum_ = std::max(maximum_, value);
+		}
+
+		/// Discards all values posted so far.
+		void reset() {
+			std::fill(buckets_.begin(), buckets_.end(), 0);
+			count_ = 0;
+			total_ = 0;
+			minimum_ = std::numeric_limits<Nanos>::max();
+			maximum_ = std::numeric_limits<Nanos>::min();
+		}
+
+		/// @returns The number of values posted since construction or the last @c reset.
+		uint64_t count() const {
+			return count_;
+		}
+
+		/// @returns The mean of all values posted, or 0 if there are none.
+		Nanos mean() const {
+			return count_ ? total_ / Nanos(count_) : 0;
+		}
+
+		/// @returns The smallest value posted, or 0 if there are none.
+		Nanos minimum() const {
+			return count_ ? minimum_ : 0;
+		}
+
+		/// @returns The largest value posted, or 0 if there are none.
+		Nanos maximum() const {
+			return count_ ? maximum_ : 0;
+		}
+
+		/*!
+			@returns An estimate of the value below which @c fraction of all posted values fall, e.g. 0.5
+				for the median, interpolated linearly within the relevant bucket and clamped to the
+				observed minimum and maximum.
+		*/
+		Nanos percentile(double fraction) const {
+			if(!count_) return 0;
+
+			const double target = std::clamp(fraction, 0.0, 1.0) * double(count_);
+			double below = 0.0;
+			for(size_t c = 0; c < buckets_.size(); c++) {
+				if(!buckets_[c] || below + double(buckets_[c]) < target) {
+					below += double(buckets_[c]);
+					continue;
+				}
+
+				const double position = (target - below) / double(buckets_[c]);
+				const Nanos value = bucket_start(c) + Nanos(position * double(bucket_width_));
+				return std::clamp(value, minimum_, maximum_);
+			}
+			return maximum_;
+		}
+
+		/// @returns The number of buckets.
+		size_t bucket_count() const {
+			return buckets_.size();
+		}
+
+		/// @returns The number of values that fell into bucket @c index.
+		uint64_t bucket(size_t index) const {
+			return buckets_[index];
+		}
+
+		/// @returns The lowest value that falls into bucket @c index, ignoring clamping at either end.
+		Nanos bucket_start(size_t index) const {
+			return lowest_ + Nanos(index) * bucket_width_;
+		}
+
+		/// @returns A single-line summary of the count, mean, median, 99th percentile and extremes, in milliseconds.
+		std::string summary() const {
+			char buffer[160];
+			snprintf(buffer, sizeof(buffer), "n=%llu mean=%.2fms p50=%.2fms p99=%.2fms min=%.2fms max=%.2fms",
+				static_cast<unsigned long long>(count_),
+				milliseconds(mean()),
+				milliseconds(percentile(0.5)),
+				milliseconds(percentile(0.99)),
+				milliseconds(minimum()),
+				milliseconds(maximum()));
+			return buffer;
+		}
+
+	private:
+		Nanos lowest_, bucket_width_;
+		std::vector<uint64_t> buckets_;
+
+		uint64_t count_ = 0;
+		Nanos total_ = 0;
+		Nanos minimum_ = std::numeric_limits<Nanos>::max();
+		Nanos maximum_ = std::numeric_limits<Nanos>::min();
+
+		static double milliseconds(Nanos value) {
+			return double(value) / 1'000'000.0;
+		}
+};
+
+}
+
+#endif /* TimeHistogram_h */
@@ -9,6 +9,7 @@
 #ifndef VSyncPredictor_hpp
 #define VSyncPredictor_hpp
 
+#include "TimeHistogram.hpp"
 #include "TimeTypes.hpp"
 #include <cassert>
 #include <cmath>
@@ -36,7 +37,9 @@ class VSyncPredictor {
 			its expectations as to how long it takes to draw a frame.
 		*/
 		void end_redraw() {
-			redraw_period_.post(nanos_now() - redraw_begin_time_);
+			const auto duration = nanos_now() - redraw_begin_time_;
+			redraw_period_.post(duration);
+			statistics_.redraw_time.post(duration);
 		}
 
 		/*!
@@ -48,12 +51,16 @@ class VSyncPredictor {
 			const auto now = nanos_now();
 
 			if(last_vsync_) {
+				statistics_.frame_period.post(now - last_announced_vsync_);
+
 				last_vsync_ += frame_duration_;
 				vsync_jitter_.post(last_vsync_ - now);
+				statistics_.vsync_jitter.post(last_vsync_ - now);
 				last_vsync_ = (last_vsync_ + now) >> 1;
 			} else {
 				last_vsync_ = now;
 			}
+			last_announced_vsync_ = now;
 		}
 
 		/*!
@@ -78,6 +85,7 @@ class VSyncPredictor {
 		*/
 		void add_timer_jitter(Time::Nanos jitter) {
 			timer_jitter_.post(jitter);
+			statistics_.timer_jitter.post(jitter);
 		}
 
 		/*!
@@ -103,6 +111,43 @@ class VSyncPredictor {
 			return last_vsync_ + frame_duration_ - period;
 		}
 
+		/*!
+			Distributions of everything measured since construction or the last call to
+			@c reset_statistics, for use in tuning frame pacing.
+		*/
+		struct Statistics {
+			/// Time taken between each begin_redraw and end_redraw.
+			Histogram redraw_time{0, 250'000, 64};
+			/// Time between consecutive announce_vsyncs, excluding any that span a pause.
+			Histogram frame_period{0, 500'000, 64};
+			/// Difference between predicted and announced vsync time; positive values mean vsync was early.
+			Histogram vsync_jitter{-4'000'000, 250'000, 32};
+			/// Timer jitter as supplied to add_timer_jitter; positive values mean the timer was late.
+			Histogram timer_jitter{-4'000'000, 250'000, 32};
+
+			/// @returns A multi-line summary of all of the above.
+			std::string summary() const {
+				return
+					"Redraw time: " + redraw_time.summary() + "\n"
+					"Frame period: " + frame_period.summary() + "\n"
+					"Vsync jitter: " + vsync_jitter.summary() + "\n"
+					"Timer jitter: " + timer_jitter.summary();
+			}
+		};
+
+		/// @returns Statistics collected since construction or the most recent call to @c reset_statistics.
+		const Statistics &statistics() const {
+			return statistics_;
+		}
+
+		/// Discards all statistics collected so far; predictions are unaffected.
+		void reset_statistics() {
+			statistics_.redraw_time.reset();
+			statistics_.frame_period.reset();
+			statistics_.vsync_jitter.reset();
+			statistics_.timer_jitter.reset();
+		}
+
 	private:
 		class VarianceCollector {
 			public:
@@ -143,11 +188,14 @@ class VSyncPredictor {
 
 		Nanos redraw_begin_time_ = 0;
 		Nanos last_vsync_ = 0;
+		Nanos last_announced_vsync_ = 0;
 		Nanos frame_duration_ = 1'000'000'000 / 60;
 
 		VarianceCollector vsync_jitter_{0};
 		VarianceCollector redraw_period_{1'000'000'000 / 60};	// A less convincing first guess.
 		VarianceCollector timer_jitter_{0};						// Seed at 0 in case this feature isn't used by the owner.
+
+		Statistics statistics_;
 };
 
 }
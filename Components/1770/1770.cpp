@@ -9,6 +9,10 @@
 #include "1770.hpp"
 
 #include "../../Storage/Disk/Encodings/MFM/Constants.hpp"
+#include "../../Storage/Disk/Encodings/MFM/SegmentParser.hpp"
+#include "../../Storage/Disk/Track/TrackSerialiser.hpp"
+
+#include <algorithm>
 
 #define LOG_PREFIX "[WD FDC] "
 #include "../../Outputs/Log.hpp"
@@ -132,6 +136,7 @@ void WD1770::run_for(const Cycles cycles) {
 
 #define WAIT_FOR_EVENT(mask)	resume_point_ = __LINE__; interesting_event_mask_ = int(mask); return; case __LINE__:
 #define WAIT_FOR_TIME(ms)		resume_point_ = __LINE__; delay_time_ = ms * 8000; WAIT_FOR_EVENT(Event1770::Timer);
+#define WAIT_FOR_CYCLES(count)	resume_point_ = __LINE__; delay_time_ = count; WAIT_FOR_EVENT(Event1770::Timer);
 #define WAIT_FOR_BYTES(count)	resume_point_ = __LINE__; distance_into_section_ = 0; WAIT_FOR_EVENT(Event::Token); if(get_latest_token().type == Token::Byte) distance_into_section_++; if(distance_into_section_ < count) { interesting_event_mask_ = int(Event::Token); return; }
 #define BEGIN_SECTION()	switch(resume_point_) { default:
 #define END_SECTION()	(void)0; }
@@ -215,6 +220,7 @@ void WD1770::posit_event(int new_event_type) {
 		LOG("Idle...");
 		set_data_mode(DataMode::Scanning);
 		index_hole_count_ = 0;
+		is_reading_fast_ = false;
 
 		update_status([] (Status &status) {
 			status.busy = false;
@@ -334,6 +340,8 @@ void WD1770::posit_event(int new_event_type) {
 		index_hole_count_ = 0;
 		distance_into_section_ = 0;
 
+		if(fast_sector_reads_ && find_fast_id()) goto verify_fast;
+
 	verify_read_data:
 		WAIT_FOR_EVENT(int(Event::IndexHole) | int(Event::Token));
 		READ_ID();
@@ -366,6 +374,19 @@ void WD1770::posit_event(int new_event_type) {
 		}
 		goto verify_read_data;
 
+	verify_fast:
+		is_reading_fast_ = true;
+		if(fast_sector_latency_) {
+			WAIT_FOR_CYCLES(fast_sector_latency_);
+		}
+		is_reading_fast_ = false;
+
+		LOG("Reached track " << std::dec << int(track_) << " directly");
+		update_status([] (Status &status) {
+			status.crc_error = false;
+		});
+		goto wait_for_command;
+
 
 	/*
 		Type 2 entry point.
@@ -425,6 +446,8 @@ void WD1770::posit_event(int new_event_type) {
 		distance_into_section_ = 0;
 		set_data_mode(DataMode::Scanning);
 
+		if(fast_sector_reads_ && !(command_&0x20) && find_fast_sector()) goto type2_fast_read;
+
 	type2_get_header:
 		WAIT_FOR_EVENT(int(Event::IndexHole) | int(Event::Token));
 		READ_ID();
@@ -522,6 +545,49 @@ void WD1770::posit_event(int new_event_type) {
 		goto type2_check_crc;
 
 
+	type2_fast_read:
+		LOG("Reading sector " << std::dec << int(sector_) << " directly");
+		update_status([this] (Status &status) {
+			status.crc_error = false;
+			status.record_type = fast_sector_is_deleted_;
+		});
+		is_reading_fast_ = true;
+		distance_into_section_ = 0;
+		if(fast_sector_latency_) {
+			WAIT_FOR_CYCLES(fast_sector_latency_);
+		}
+
+	type2_fast_read_byte:
+		WAIT_FOR_CYCLES(fast_cycles_per_byte_);
+		data_ = fast_sector_data_[size_t(distance_into_section_)];
+		update_status([] (Status &status) {
+			status.lost_data |= status.data_request;
+			status.data_request = true;
+		});
+		distance_into_section_++;
+		if(distance_into_section_ < int(fast_sector_data_.size())) goto type2_fast_read_byte;
+
+		// Allow for the CRC.
+		WAIT_FOR_CYCLES(2 * fast_cycles_per_byte_);
+		is_reading_fast_ = false;
+		distance_into_section_ = 0;
+
+		if(fast_sector_has_crc_error_) {
+			LOG("CRC error; terminating");
+			update_status([] (Status &status) {
+				status.crc_error = true;
+			});
+			goto wait_for_command;
+		}
+
+		if(command_ & 0x10) {
+			sector_++;
+			LOG("Advancing to search for sector " << std::dec << int(sector_));
+			goto test_type2_write_protection;
+		}
+		goto wait_for_command;
+
+
 	type2_write_data:
 		WAIT_FOR_BYTES(2);
 		update_status([] (Status &status) {
@@ -540,6 +606,7 @@ void WD1770::posit_event(int new_event_type) {
 		}
 
 		set_data_mode(DataMode::Writing);
+		decoded_track_ = nullptr;
 		begin_writing(false);
 		for(int c = 0; c < (get_is_double_density() ? 12 : 6); c++) {
 			write_byte(0);
@@ -733,6 +800,7 @@ void WD1770::posit_event(int new_event_type) {
 		}
 
 		WAIT_FOR_EVENT(Event1770::IndexHoleTarget);
+		decoded_track_ = nullptr;
 		begin_writing(true);
 		index_hole_count_ = 0;
 
@@ -838,3 +906,100 @@ ClockingHint::Preference WD1770::preferred_clocking() const {
 	if(status_.busy) return ClockingHint::Preference::RealTime;
 	return Storage::Disk::MFMController::preferred_clocking();
 }
+
+// MARK: - Fast sector reads.
+
+void WD1770::set_fast_sector_reads(bool enabled, int cycles_per_byte, bool wait_for_rotation) {
+	fast_sector_reads_ = enabled;
+	fast_cycles_per_byte_ = std::max(cycles_per_byte, 1);
+	fast_sector_waits_for_rotation_ = wait_for_rotation;
+}
+
+void WD1770::set_accuracy(Configurable::Accuracy accuracy) {
+	switch(accuracy) {
+		case Configurable::Accuracy::CycleExact:	set_fast_sector_reads(false);			break;
+		case Configurable::Accuracy::Fast:			set_fast_sector_reads(true, 256, true);	break;
+		case Configurable::Accuracy::Turbo:			set_fast_sector_reads(true, 32, false);	break;
+	}
+}
+
+bool WD1770::decode_current_track() {
+	const auto track = get_drive().get_current_track();
+	if(!track) return false;
+
+	// Decode the track if it is new, or is being considered at a different density. Any write
+	// through this controller discards the decoding, as tracks are patched in place.
+	const bool is_double_density = get_is_double_density();
+	if(track != decoded_track_ || is_double_density != decoded_track_is_double_density_) {
+		decoded_track_ = track;
+		decoded_track_is_double_density_ = is_double_density;
+
+		auto segment = Storage::Disk::track_serialisation(
+			*track,
+			is_double_density ? Storage::Encodings::MFM::MFMBitLength : Storage::Encodings::MFM::FMBitLength);
+		decoded_track_length_ = segment.data.size();
+		decoded_sectors_ = Storage::Encodings::MFM::sectors_from_segment(std::move(segment), is_double_density);
+	}
+	return true;
+}
+
+Cycles::IntType WD1770::fast_latency(std::size_t position) {
+	if(!fast_sector_waits_for_rotation_ || !decoded_track_length_) return 0;
+
+	auto &drive = get_drive();
+	float distance = float(position) / float(decoded_track_length_) - drive.get_rotation();
+	if(distance < 0.0f) distance += 1.0f;
+	return Cycles::IntType(distance * float(drive.get_cycles_per_revolution()));
+}
+
+bool WD1770::find_fast_sector() {
+	if(!decode_current_track()) return false;
+
+	// Apply the same test as type2_get_header, insisting on a single match.
+	const Storage::Encodings::MFM::Sector *target = nullptr;
+	std::size_t position = 0;
+	for(const auto &pair: decoded_sectors_) {
+		const auto &sector = pair.second;
+		if(sector.address.track != track_ || sector.address.sector != sector_) continue;
+		if(!has_motor_on_line() && (command_&0x02) && ((command_&0x08) >> 3) != sector.address.side) continue;
+
+		if(target) return false;
+		target = &sector;
+		position = pair.first;
+	}
+
+	// Decline anything that the real process would treat unusually.
+	if(
+		!target ||
+		target->has_header_crc_error ||
+		target->samples.size() != 1 ||
+		target->samples[0].size() != size_t(128 << (target->size&3))
+	) return false;
+
+	header_[0] = target->address.track;
+	header_[1] = target->address.side;
+	header_[2] = target->address.sector;
+	header_[3] = target->size;
+	fast_sector_data_ = target->samples[0];
+	fast_sector_has_crc_error_ = target->has_data_crc_error;
+	fast_sector_is_deleted_ = target->is_deleted;
+	fast_sector_latency_ = fast_latency(position);
+	return true;
+}
+
+bool WD1770::find_fast_id() {
+	if(!decode_current_track()) return false;
+
+	// Apply the same test as verify_read_data, taking whichever suitable ID field will arrive first.
+	bool found = false;
+	for(const auto &pair: decoded_sectors_) {
+		if(pair.second.address.track != track_ || pair.second.has_header_crc_error) continue;
+
+		const auto latency = fast_latency(pair.first);
+		if(!found || latency < fast_sector_latency_) {
+			fast_sector_latency_ = latency;
+		}
+		found = true;
+	}
+	return found;
+}
@@ -9,7 +9,13 @@
 #ifndef _770_hpp
 #define _770_hpp
 
+#include "../../Configurable/StandardOptions.hpp"
 #include "../../Storage/Disk/Controller/MFMDiskController.hpp"
+#include "../../Storage/Disk/Encodings/MFM/Sector.hpp"
+
+#include <map>
+#include <memory>
+#include <vector>
 
 namespace WD {
 
@@ -76,6 +82,31 @@ class WD1770: public Storage::Disk::MFMController {
 
 		ClockingHint::Preference preferred_clocking() const final;
 
+		/*!
+			Enables or disables fast sector reads. This is **NOT A REALISTIC** controller behaviour;
+			it's a user-optional fast-loading mechanism.
+
+			While enabled, a read sector command that can find its target sector intact on the track under
+			the head takes the contents directly from a decoding of that track, rather than waiting for the
+			sector to pass beneath the head and separating it from the flux stream. Bytes are then offered
+			at intervals of @c cycles_per_byte; the default matches a real double-density transfer.
+
+			Seeks with verification similarly consult that decoding for an intact ID field on the proper track.
+
+			If @c wait_for_rotation is @c true then each such operation first waits until the relevant ID field
+			would have passed beneath the head, preserving rotational latency; otherwise it proceeds immediately.
+
+			Writes, and reads of sectors that are missing, damaged or duplicated, proceed as usual.
+		*/
+		void set_fast_sector_reads(bool enabled, int cycles_per_byte = 256, bool wait_for_rotation = false);
+
+		/*!
+			Configures fast sector reads as appropriate to @c accuracy, assuming a nominal 8Mhz clock:
+			disabled if cycle exact; at the real transfer rate and rotational latency if fast; and
+			immediate, at eight times the real rate, if turbo.
+		*/
+		void set_accuracy(Configurable::Accuracy accuracy);
+
 	protected:
 		virtual void set_head_load_request(bool head_load);
 		virtual void set_motor_on(bool motor_on);
@@ -85,6 +116,9 @@ class WD1770: public Storage::Disk::MFMController {
 		bool get_head_loaded() const;
 
 	private:
+		// Storage::Disk::Drive::EventDelegate; flux transitions are of interest only while a command is under way.
+		bool is_listening() const final { return status_.busy && !is_reading_fast_; }
+
 		const Personality personality_;
 		bool has_motor_on_line() const { return (personality_ != P1793 ) && (personality_ != P1773); }
 		bool has_head_load_line() const { return (personality_ == P1793 ); }
@@ -136,6 +170,30 @@ class WD1770: public Storage::Disk::MFMController {
 		// 1793 head-loading logic
 		bool head_is_loaded_ = false;
 
+		// Fast sector reads: fast_sector_data_ et al describe the sector being transferred, having been
+		// found by find_fast_sector amongst decoded_sectors_, which is a decoding of decoded_track_.
+		// decoded_track_length_ is the length of decoded_track_ in bits, allowing the keys of decoded_sectors_
+		// to be mapped to rotations; fast_sector_latency_ is the time until the located ID field arrives.
+		bool fast_sector_reads_ = false;
+		int fast_cycles_per_byte_ = 256;
+		bool fast_sector_waits_for_rotation_ = false;
+		bool is_reading_fast_ = false;
+
+		std::shared_ptr<Storage::Disk::Track> decoded_track_;
+		bool decoded_track_is_double_density_ = false;
+		std::size_t decoded_track_length_ = 0;
+		std::map<std::size_t, Storage::Encodings::MFM::Sector> decoded_sectors_;
+
+		std::vector<uint8_t> fast_sector_data_;
+		bool fast_sector_has_crc_error_ = false;
+		bool fast_sector_is_deleted_ = false;
+		Cycles::IntType fast_sector_latency_ = 0;
+
+		bool decode_current_track();
+		Cycles::IntType fast_latency(std::size_t position);
+		bool find_fast_sector();
+		bool find_fast_id();
+
 		// delegate
 		Delegate *delegate_ = nullptr;
 };
@@ -25,12 +25,20 @@ NCR5380::NCR5380(SCSI::Bus &bus, int clock_rate) :
 	(void)expected_phase_;
 }
 
-void NCR5380::write(int address, uint8_t value, bool) {
+void NCR5380::write(int address, uint8_t value, bool dma_acknowledge) {
 	switch(address & 7) {
 		case 0:
 //			LOG("[SCSI 0] Set current SCSI bus state to " << PADHEX(2) << int(value));
 			data_bus_ = value;
 
+			// A pseudo-DMA write to a target that is currently requesting a byte can be completed
+			// in one step, without stepping the bus through each stage of the handshake.
+			if(dma_acknowledge && can_bulk_transfer(DMAOperation::Send)) {
+				bus_.bulk_transfer()->transfer_from_initiator(value);
+				dma_request_ = false;
+				break;
+			}
+
 			if(dma_request_ && dma_operation_ == DMAOperation::Send) {
 //				printf("w %02x\n", value);
 				dma_acknowledge_ = true;
@@ -133,11 +141,17 @@ void NCR5380::write(int address, uint8_t value, bool) {
 	}
 }
 
-uint8_t NCR5380::read(int address, bool) {
+uint8_t NCR5380::read(int address, bool dma_acknowledge) {
 	switch(address & 7) {
 		case 0:
 //			LOG("[SCSI 0] Get current SCSI bus state: " << PADHEX(2) << (bus_.get_state() & 0xff));
 
+			// As for writes: complete a pseudo-DMA read in one step if possible.
+			if(dma_acknowledge && can_bulk_transfer(DMAOperation::InitiatorReceive)) {
+				dma_request_ = false;
+				return bus_.bulk_transfer()->transfer_to_initiator();
+			}
+
 			if(dma_request_ && dma_operation_ == DMAOperation::InitiatorReceive) {
 				dma_acknowledge_ = true;
 				dma_request_ = false;
@@ -235,6 +249,16 @@ void NCR5380::update_control_output() {
 	}
 }
 
+bool NCR5380::can_bulk_transfer(DMAOperation operation) {
+	// Bulk transfers are possible only while no handshake is partway through.
+	return
+		state_ == ExecutionState::PerformingDMA &&
+		dma_operation_ == operation &&
+		!dma_acknowledge_ &&
+		bus_.bulk_transfer() &&
+		bus_.bulk_transfer()->is_requesting_transfer(operation == DMAOperation::InitiatorReceive);
+}
+
 void NCR5380::scsi_bus_did_change(SCSI::Bus *, SCSI::BusState new_state, double time_since_change) {
 	switch(state_) {
 		default: break;
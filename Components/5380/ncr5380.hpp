@@ -65,6 +65,7 @@ class NCR5380 final: public SCSI::Bus::Observer {
 
 		SCSI::BusState target_output();
 		void update_control_output();
+		bool can_bulk_transfer(DMAOperation);
 
 		void scsi_bus_did_change(SCSI::Bus *, SCSI::BusState new_state, double time_since_change) final;
 };
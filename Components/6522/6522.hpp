@@ -114,12 +114,22 @@ template <class T> class MOS6522: public MOS6522Storage {
 		/// @returns @c true if the IRQ line is currently active; @c false otherwise.
 		bool get_interrupt_line() const;
 
+		/// @returns the time until the next point at which the interrupt line or PB7 _might_ change,
+		/// i.e. the next timer underflow, allowing this VIA to be clocked just-in-time.
+		HalfCycles get_next_sequence_point() const;
+
 		/// Updates the port handler to the current time and then requests that it flush.
 		void flush();
 
 	private:
 		void do_phase1();
 		void do_phase2();
+
+		/// @returns the number of whole cycles, from the start of phase 1, for which nothing other
+		/// than the timer counts will change; @c 0 if the next cycle needs to be stepped.
+		Cycles::IntType cycles_until_event() const;
+		/// Advances the timers by @c cycles whole cycles, which must not exceed @c cycles_until_event().
+		void skip_cycles(Cycles::IntType cycles);
 		void shift_in();
 		void shift_out();
 
@@ -8,6 +8,9 @@
 
 #include "../../../Outputs/Log.hpp"
 
+#include <algorithm>
+#include <limits>
+
 // As-yet unimplemented (incomplete list):
 //
 //	PB6 count-down mode for timer 2.
@@ -395,6 +398,13 @@ template <typename T> void MOS6522<T>::run_for(const HalfCycles half_cycles) {
 	}
 
 	while(number_of_half_cycles >= 2) {
+		const auto skippable = std::min(number_of_half_cycles >> 1, cycles_until_event());
+		if(skippable) {
+			skip_cycles(skippable);
+			number_of_half_cycles -= skippable * 2;
+			continue;
+		}
+
 		do_phase1();
 		do_phase2();
 		number_of_half_cycles -= 2;
@@ -416,10 +426,66 @@ template <typename T> void MOS6522<T>::flush() {
 /*! Runs for a specified number of cycles. */
 template <typename T> void MOS6522<T>::run_for(const Cycles cycles) {
 	auto number_of_cycles = cycles.as_integral();
-	while(number_of_cycles--) {
+	while(number_of_cycles) {
+		const auto skippable = std::min(number_of_cycles, cycles_until_event());
+		if(skippable) {
+			skip_cycles(skippable);
+			number_of_cycles -= skippable;
+			continue;
+		}
+
 		do_phase1();
 		do_phase2();
+		--number_of_cycles;
+	}
+}
+
+template <typename T> Cycles::IntType MOS6522<T>::cycles_until_event() const {
+	// Reloads, pending counter writes, pulse outputs and phase-2 shifting all need per-cycle attention.
+	if(
+		registers_.timer_needs_reload ||
+		registers_.next_timer[0] >= 0 || registers_.next_timer[1] >= 0 ||
+		handshake_modes_[0] == HandshakeMode::Pulse || handshake_modes_[1] == HandshakeMode::Pulse ||
+		shift_mode() == ShiftMode::InUnderPhase2 || shift_mode() == ShiftMode::OutUnderPhase2
+	) {
+		return 0;
 	}
+
+	// Otherwise the only events are underflows of running timers, which phase 1 spots once
+	// a count has moved from 0 to 0xffff, i.e. in the cycle after 1 + [current count] decrements.
+	auto cycles = std::numeric_limits<Cycles::IntType>::max();
+	const auto limit = [&](int timer, int decrement) {
+		if(!timer_is_running_[timer]) return;
+		if(registers_.timer[timer] == 0xffff && !registers_.last_timer[timer]) {
+			cycles = 0;
+		} else if(decrement) {
+			cycles = std::min(cycles, Cycles::IntType(registers_.timer[timer]) + 1);
+		}
+	};
+	limit(0, 1);
+	limit(1, timer2_clock_decrement());
+	return cycles;
+}
+
+template <typename T> void MOS6522<T>::skip_cycles(const Cycles::IntType cycles) {
+	// As per do_phase2, but in bulk: last_timer ends up holding the count from one cycle before the end.
+	const auto timer2_decrement = timer2_clock_decrement();
+	registers_.last_timer[0] = uint16_t(registers_.timer[0] - (cycles - 1));
+	registers_.last_timer[1] = uint16_t(registers_.timer[1] - (cycles - 1) * timer2_decrement);
+	registers_.timer[0] = uint16_t(registers_.timer[0] - cycles);
+	registers_.timer[1] = uint16_t(registers_.timer[1] - cycles * timer2_decrement);
+	time_since_bus_handler_call_ += HalfCycles(cycles * 2);
+}
+
+template <typename T> HalfCycles MOS6522<T>::get_next_sequence_point() const {
+	// Mid-cycle, or if something needs stepping, just offer the next half-cycle.
+	if(is_phase2_) return HalfCycles(1);
+
+	const auto cycles = cycles_until_event();
+	if(cycles == std::numeric_limits<Cycles::IntType>::max()) return HalfCycles::max();
+
+	// Include the phase 1 in which the event is spotted.
+	return HalfCycles(cycles * 2 + 1);
 }
 
 /*! @returns @c true if the IRQ line is currently active; @c false otherwise. */
@@ -15,6 +15,8 @@
 #include "../../Outputs/Speaker/Implementation/LowpassSpeaker.hpp"
 #include "../../Outputs/Speaker/Implementation/SampleSource.hpp"
 
+#include <algorithm>
+
 namespace MOS {
 namespace MOS6560 {
 
@@ -90,6 +92,12 @@ template <class BusHandler> class MOS6560 {
 		Outputs::Display::DisplayType get_display_type() const				{ return crt_.get_display_type(); 				}
 		Outputs::Speaker::Speaker *get_speaker()	 						{ return &speaker_; 							}
 
+		/// Completes all audio processing, then @returns the number of bytes occupied by the speaker's buffers.
+		size_t get_speaker_memory_footprint() {
+			audio_queue_.flush();
+			return speaker_.get_memory_footprint();
+		}
+
 		void set_high_frequency_cutoff(float cutoff) {
 			speaker_.set_high_frequency_cutoff(cutoff);
 		}
@@ -174,7 +182,17 @@ template <class BusHandler> class MOS6560 {
 			cycles_since_speaker_update_ += cycles;
 
 			auto number_of_cycles = cycles.as_integral();
-			while(number_of_cycles--) {
+			while(number_of_cycles) {
+				// Within a run of border or pixels most of the per-cycle tests below can't change anything,
+				// so take as much of the run as possible in bulk.
+				const auto run_length = std::min(number_of_cycles, Cycles::IntType(steady_run_length()));
+				if(run_length) {
+					run_steady(int(run_length));
+					number_of_cycles -= run_length;
+					continue;
+				}
+				--number_of_cycles;
+
 				// keep an old copy of the vertical count because that test is a cycle later than the actual changes
 				int previous_vertical_counter = vertical_counter_;
 
@@ -232,18 +250,7 @@ template <class BusHandler> class MOS6560 {
 
 				uint16_t fetch_address = 0x1c;
 				if(column_counter_ >= 0 && column_counter_ < columns_this_line_*2) {
-					if(column_counter_&1) {
-						fetch_address = registers_.character_cell_start_address + (character_code_*(registers_.tall_characters ? 16 : 8)) + current_character_row_;
-					} else {
-						fetch_address = uint16_t(registers_.video_matrix_start_address + video_matrix_address_counter_);
-						video_matrix_address_counter_++;
-						if(
-							(current_character_row_ == 15) ||
-							(current_character_row_ == 7 && !registers_.tall_characters)
-						) {
-							base_video_matrix_address_counter_ = video_matrix_address_counter_;
-						}
-					}
+					fetch_address = next_fetch_address();
 				}
 
 				fetch_address &= 0x3fff;
@@ -293,49 +300,7 @@ template <class BusHandler> class MOS6560 {
 				cycles_in_state_++;
 
 				if(this_state_ == State::Pixels) {
-					// TODO: palette changes can happen within half-characters; the below needs to be divided.
-					// Also: a perfect opportunity to rearrange this inner loop for no longer needing to be
-					// two parts with a cooperative owner?
-					if(column_counter_&1) {
-						character_value_ = pixel_data;
-
-						if(pixel_pointer) {
-							uint16_t cell_colour = colours_[character_colour_ & 0x7];
-							if(!(character_colour_&0x8)) {
-								uint16_t colours[2];
-								if(registers_.invertedCells) {
-									colours[0] = cell_colour;
-									colours[1] = registers_.backgroundColour;
-								} else {
-									colours[0] = registers_.backgroundColour;
-									colours[1] = cell_colour;
-								}
-								pixel_pointer[0] = colours[(character_value_ >> 7)&1];
-								pixel_pointer[1] = colours[(character_value_ >> 6)&1];
-								pixel_pointer[2] = colours[(character_value_ >> 5)&1];
-								pixel_pointer[3] = colours[(character_value_ >> 4)&1];
-								pixel_pointer[4] = colours[(character_value_ >> 3)&1];
-								pixel_pointer[5] = colours[(character_value_ >> 2)&1];
-								pixel_pointer[6] = colours[(character_value_ >> 1)&1];
-								pixel_pointer[7] = colours[(character_value_ >> 0)&1];
-							} else {
-								uint16_t colours[4] = {registers_.backgroundColour, registers_.borderColour, cell_colour, registers_.auxiliary_colour};
-								pixel_pointer[0] =
-								pixel_pointer[1] = colours[(character_value_ >> 6)&3];
-								pixel_pointer[2] =
-								pixel_pointer[3] = colours[(character_value_ >> 4)&3];
-								pixel_pointer[4] =
-								pixel_pointer[5] = colours[(character_value_ >> 2)&3];
-								pixel_pointer[6] =
-								pixel_pointer[7] = colours[(character_value_ >> 0)&3];
-							}
-
-							pixel_pointer += 8;
-						}
-					} else {
-						character_code_ = pixel_data;
-						character_colour_ = colour_data;
-					}
+					latch_pixels(pixel_data, colour_data);
 				}
 
 				// Keep counting columns even if sync or the colour burst have interceded.
@@ -510,6 +475,118 @@ template <class BusHandler> class MOS6560 {
 			crt_.output_level(number_of_cycles);
 		}
 
+		/// @returns the address of the next bus access within the pixel area, updating the video matrix address counters if relevant.
+		uint16_t next_fetch_address() {
+			if(column_counter_&1) {
+				return uint16_t(registers_.character_cell_start_address + (character_code_*(registers_.tall_characters ? 16 : 8)) + current_character_row_);
+			}
+
+			const uint16_t fetch_address = uint16_t(registers_.video_matrix_start_address + video_matrix_address_counter_);
+			video_matrix_address_counter_++;
+			if(
+				(current_character_row_ == 15) ||
+				(current_character_row_ == 7 && !registers_.tall_characters)
+			) {
+				base_video_matrix_address_counter_ = video_matrix_address_counter_;
+			}
+			return fetch_address;
+		}
+
+		/// Latches a character code and colour, or outputs a character's worth of pixels, depending on the current column.
+		void latch_pixels(uint8_t pixel_data, uint8_t colour_data) {
+			// TODO: palette changes can happen within half-characters; the below needs to be divided.
+			// Also: a perfect opportunity to rearrange this inner loop for no longer needing to be
+			// two parts with a cooperative owner?
+			if(column_counter_&1) {
+				character_value_ = pixel_data;
+
+				if(pixel_pointer) {
+					uint16_t cell_colour = colours_[character_colour_ & 0x7];
+					if(!(character_colour_&0x8)) {
+						uint16_t colours[2];
+						if(registers_.invertedCells) {
+							colours[0] = cell_colour;
+							colours[1] = registers_.backgroundColour;
+						} else {
+							colours[0] = registers_.backgroundColour;
+							colours[1] = cell_colour;
+						}
+						pixel_pointer[0] = colours[(character_value_ >> 7)&1];
+						pixel_pointer[1] = colours[(character_value_ >> 6)&1];
+						pixel_pointer[2] = colours[(character_value_ >> 5)&1];
+						pixel_pointer[3] = colours[(character_value_ >> 4)&1];
+						pixel_pointer[4] = colours[(character_value_ >> 3)&1];
+						pixel_pointer[5] = colours[(character_value_ >> 2)&1];
+						pixel_pointer[6] = colours[(character_value_ >> 1)&1];
+						pixel_pointer[7] = colours[(character_value_ >> 0)&1];
+					} else {
+						uint16_t colours[4] = {registers_.backgroundColour, registers_.borderColour, cell_colour, registers_.auxiliary_colour};
+						pixel_pointer[0] =
+						pixel_pointer[1] = colours[(character_value_ >> 6)&3];
+						pixel_pointer[2] =
+						pixel_pointer[3] = colours[(character_value_ >> 4)&3];
+						pixel_pointer[4] =
+						pixel_pointer[5] = colours[(character_value_ >> 2)&3];
+						pixel_pointer[6] =
+						pixel_pointer[7] = colours[(character_value_ >> 0)&3];
+					}
+
+					pixel_pointer += 8;
+				}
+			} else {
+				character_code_ = pixel_data;
+				character_colour_ = colour_data;
+			}
+		}
+
+		/*!
+			@returns the number of cycles from now that will definitely be spent continuing the current run of
+			border or pixels, with no change to line, output state or drawing latches.
+		*/
+		int steady_run_length() const {
+			if(output_state_ != this_state_) return 0;
+			if(vertical_counter_ <= 3 && (is_odd_frame() || registers_.interlaced)) return 0;
+
+			int run_length = timing_.cycles_per_line - 7 - horizontal_counter_;
+			switch(this_state_) {
+				default: return 0;
+
+				case State::Pixels:
+					if(pixel_line_cycle_ < 3) return 0;
+					run_length = std::min(run_length, columns_this_line_*2 - column_counter_);
+				break;
+
+				case State::Border:
+					// Neither latch may be about to be set, and the start of drawing must be either already
+					// past or not yet imminent.
+					if(!vertical_drawing_latch_ && registers_.first_row_location == (vertical_counter_ >> 1)) return 0;
+					if(!horizontal_drawing_latch_ && vertical_drawing_latch_ && registers_.first_column_location > horizontal_counter_) {
+						run_length = std::min(run_length, registers_.first_column_location - horizontal_counter_ - 1);
+					}
+					if(pixel_line_cycle_ == -1 ? horizontal_drawing_latch_ : pixel_line_cycle_ < 3) return 0;
+				break;
+			}
+			return std::max(0, run_length);
+		}
+
+		/// Runs for @c cycles, which must be no more than @c steady_run_length().
+		void run_steady(int cycles) {
+			horizontal_counter_ += cycles;
+			if(pixel_line_cycle_ >= 0) pixel_line_cycle_ += cycles;
+			cycles_in_state_ += cycles;
+
+			// Border cycles fetch only from the idle address, so there's nothing further to do for them.
+			if(this_state_ == State::Border) return;
+
+			while(cycles--) {
+				uint8_t pixel_data;
+				uint8_t colour_data;
+				bus_handler_.perform_read(next_fetch_address() & 0x3fff, &pixel_data, &colour_data);
+				latch_pixels(pixel_data, colour_data);
+				column_counter_++;
+			}
+		}
+
 		struct {
 			int cycles_per_line = 0;
 			int line_counter_increment_offset = 0;
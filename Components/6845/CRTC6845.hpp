@@ -11,6 +11,7 @@
 
 #include "../../ClockReceiver/ClockReceiver.hpp"
 
+#include <algorithm>
 #include <cstdint>
 #include <cstdio>
 
@@ -41,6 +42,20 @@ class BusHandler {
 			having to wait until the next cycle has begun.
 		*/
 		void perform_bus_cycle_phase2(const BusState &) {}
+
+		/*!
+			Performs both phases of @c count consecutive bus cycles during which nothing changes other than
+			the refresh address, which is @c state.refresh_address during the first and increments by one,
+			modulo 0x4000, for each subsequent cycle. This is semantically identical to the implementation
+			below but allows handlers to process entire runs of border or pixels at once.
+		*/
+		void perform_bus_cycles(BusState state, int count) {
+			while(count--) {
+				perform_bus_cycle_phase1(state);
+				perform_bus_cycle_phase2(state);
+				state.refresh_address = (state.refresh_address + 1) & 0x3fff;
+			}
+		}
 };
 
 enum Personality {
@@ -112,7 +127,16 @@ template <class T> class CRTC6845 {
 
 		void run_for(Cycles cycles) {
 			auto cyles_remaining = cycles.as_integral();
-			while(cyles_remaining--) {
+			while(cyles_remaining) {
+				// Hand off runs of cycles in which nothing but the refresh address changes as a single block.
+				const auto steady_cycles = std::min(cyles_remaining, Cycles::IntType(steady_run_length()));
+				if(steady_cycles) {
+					perform_bus_cycles(int(steady_cycles));
+					cyles_remaining -= steady_cycles;
+					continue;
+				}
+				--cyles_remaining;
+
 				// check for end of visible characters
 				if(character_counter_ == registers_[1]) {
 					// TODO: consider skew in character_is_visible_. Or maybe defer until perform_bus_cycle?
@@ -164,6 +188,20 @@ template <class T> class CRTC6845 {
 			return bus_state_;
 		}
 
+		/*!
+			@returns the number of cycles that can be run before either sync output might change; the change,
+			if any, will occur during the final cycle.
+		*/
+		int get_cycles_until_sync_change() const {
+			if(bus_state_.hsync) return 1;
+
+			// Sync can change only at the end of a line or at the start of horizontal sync.
+			return 1 + std::min(
+				cycles_until(character_counter_, registers_[0]),
+				cycles_until(uint8_t(character_counter_ + 1), registers_[2])
+			);
+		}
+
 	private:
 		inline void perform_bus_cycle_phase1() {
 			// Skew theory of operation: keep a history of the last three states, and apply whichever is selected.
@@ -176,6 +214,39 @@ template <class T> class CRTC6845 {
 			bus_handler_.perform_bus_cycle_phase2(bus_state_);
 		}
 
+		/// @returns the number of increments it will take for an 8-bit counter at @c value to reach @c target.
+		static int cycles_until(uint8_t value, uint8_t target) {
+			return uint8_t(target - value);
+		}
+
+		/*!
+			@returns the number of cycles from now in which no state will change other than the character counter and
+			refresh address, and hence in which bus state is constant other than the refresh address.
+		*/
+		int steady_run_length() const {
+			// Horizontal sync is counted on every cycle, and any change in visibility takes a few cycles
+			// to be fully reflected in display enable.
+			if(bus_state_.hsync) return 0;
+			if((character_is_visible_shifter_ & 3) != (character_is_visible_ ? 3 : 0)) return 0;
+
+			return std::min({
+				cycles_until(character_counter_, registers_[0]),
+				cycles_until(character_counter_, registers_[1]),
+				cycles_until(uint8_t(character_counter_ + 1), registers_[2]),
+			});
+		}
+
+		/// Performs @c count cycles, which must be no more than @c steady_run_length().
+		inline void perform_bus_cycles(int count) {
+			// Only the low three bits of the visibility shifter are ever inspected.
+			character_is_visible_shifter_ = character_is_visible_ ? 7 : 0;
+			bus_state_.display_enable = character_is_visible_ && line_is_visible_;
+			bus_handler_.perform_bus_cycles(bus_state_, count);
+
+			bus_state_.refresh_address = (bus_state_.refresh_address + count) & 0x3fff;
+			character_counter_ = uint8_t(character_counter_ + count);
+		}
+
 		inline void do_end_of_line() {
 			// check for end of vertical sync
 			if(bus_state_.vsync) {
@@ -10,6 +10,7 @@
 
 #include <algorithm>
 #include <cstring>
+#include <limits>
 
 #ifndef NDEBUG
 #define NDEBUG
@@ -20,17 +21,6 @@
 
 using namespace Motorola::MFP68901;
 
-ClockingHint::Preference MFP68901::preferred_clocking() const {
-	// Rule applied: if any timer is actively running and permitted to produce an
-	// interrupt, request real-time running.
-	return
-		(timers_[0].mode >= TimerMode::Delay && interrupt_enable_&Interrupt::TimerA) ||
-		(timers_[1].mode >= TimerMode::Delay && interrupt_enable_&Interrupt::TimerB) ||
-		(timers_[2].mode >= TimerMode::Delay && interrupt_enable_&Interrupt::TimerC) ||
-		(timers_[3].mode >= TimerMode::Delay && interrupt_enable_&Interrupt::TimerD)
-			? ClockingHint::Preference::RealTime : ClockingHint::Preference::JustInTime;
-}
-
 uint8_t MFP68901::read(int address) {
 	address &= 0x1f;
 
@@ -109,7 +99,6 @@ void MFP68901::write(int address, uint8_t value) {
 
 		// Whatever just happened may have affected the state of the interrupt line.
 		update_interrupts();
-		update_clocking_observer();
 		return;
 	}
 
@@ -175,8 +164,6 @@ void MFP68901::write(int address, uint8_t value) {
 		case 0x16:		LOG("Write: transmitter status");		break;
 		case 0x17:		LOG("Write: USART data");				break;
 	}
-
-	update_clocking_observer();
 }
 
 void MFP68901::run_for(HalfCycles time) {
@@ -207,8 +194,30 @@ void MFP68901::run_for(HalfCycles time) {
 	}
 }
 
-HalfCycles MFP68901::get_next_sequence_point() {
-	return HalfCycles::max();
+HalfCycles MFP68901::get_next_sequence_point() const {
+	constexpr int timer_interrupts[] = {
+		Interrupt::TimerA, Interrupt::TimerB, Interrupt::TimerC, Interrupt::TimerD
+	};
+
+	// Underflows are the only thing that can affect the interrupt line without a
+	// register access or input change, and only those that can become pending matter.
+	auto cycles = std::numeric_limits<HalfCycles::IntType>::max();
+	for(int c = 0; c < 4; ++c) {
+		if(timers_[c].mode < TimerMode::Delay || !(interrupt_enable_ & timer_interrupts[c])) continue;
+
+		// An underflow occurs upon the decrement that takes the value to 0; a value of 0 itself
+		// therefore means a full 256 decrements. Cf. run_for for the use of prescale_count.
+		const int decrements = timers_[c].value ? timers_[c].value : 256;
+		const auto timer_cycles = std::max(HalfCycles::IntType(decrements) * timers_[c].prescale - timers_[c].prescale_count, HalfCycles::IntType(1));
+		cycles = std::min(cycles, timer_cycles);
+	}
+
+	if(cycles == std::numeric_limits<HalfCycles::IntType>::max()) {
+		return HalfCycles::max();
+	}
+
+	// Allow for any half cycle already banked.
+	return HalfCycles(cycles * 2 - cycles_left_.as_integral());
 }
 
 // MARK: - Timers
@@ -11,7 +11,6 @@
 
 #include <cstdint>
 #include "../../ClockReceiver/ClockReceiver.hpp"
-#include "../../ClockReceiver/ClockingHintSource.hpp"
 
 namespace Motorola {
 namespace MFP68901 {
@@ -24,7 +23,7 @@ class PortHandler {
 /*!
 	Models the Motorola 68901 Multi-Function Peripheral ('MFP').
 */
-class MFP68901: public ClockingHint::Source {
+class MFP68901 {
 	public:
 		/// @returns the result of a read from @c address.
 		uint8_t read(int address);
@@ -36,11 +35,9 @@ class MFP68901: public ClockingHint::Source {
 		void run_for(HalfCycles);
 
 		/// @returns the number of cycles until the next possible sequence point — the next time
-		/// at which the interrupt line _might_ change. This object conforms to ClockingHint::Source
-		/// so that mechanism can also be used to reduce the quantity of calls into this class.
-		///
-		/// @discussion TODO, alas.
-		HalfCycles get_next_sequence_point();
+		/// at which the interrupt line _might_ change, i.e. the next underflow of a timer in delay
+		/// or pulse-width mode that is permitted to produce an interrupt.
+		HalfCycles get_next_sequence_point() const;
 
 		/// Sets the current level of either of the timer event inputs — TAI and TBI in datasheet terms.
 		void set_timer_event_input(int channel, bool value);
@@ -75,9 +72,6 @@ class MFP68901: public ClockingHint::Source {
 		/// Sets a delegate that will be notified upon any change in the interrupt line.
 		void set_interrupt_delegate(InterruptDelegate *delegate);
 
-		// ClockingHint::Source.
-		ClockingHint::Preference preferred_clocking() const final;
-
 	private:
 		// MARK: - Timers
 		enum class TimerMode {
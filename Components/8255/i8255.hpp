@@ -9,6 +9,8 @@
 #ifndef i8255_hpp
 #define i8255_hpp
 
+#include "../../Reflection/Struct.hpp"
+
 #include <cstdint>
 
 namespace Intel {
@@ -21,6 +23,8 @@ class PortHandler {
 };
 
 // TODO: Modes 1 and 2.
+struct State;
+
 template <class T> class i8255 {
 	public:
 		i8255(T &port_handler) : control_(0), outputs_{0, 0, 0}, port_handler_(port_handler) {}
@@ -86,6 +90,36 @@ template <class T> class i8255 {
 		uint8_t control_;
 		uint8_t outputs_[3];
 		T &port_handler_;
+
+		friend struct State;
+};
+
+struct State: public Reflection::StructImpl<State> {
+	uint8_t control = 0;
+	uint8_t outputs[3]{};
+
+	State() {
+		if(needs_declare()) {
+			DeclareField(control);
+			DeclareField(outputs);
+		}
+	}
+
+	template <typename PPI> State(const PPI &source) : State() {
+		control = source.control_;
+		for(size_t c = 0; c < 3; c++) {
+			outputs[c] = source.outputs_[c];
+		}
+	}
+
+	/// Applies this state to @c target, announcing all outputs to its port handler.
+	template <typename PPI> void apply(PPI &target) const {
+		target.control_ = control;
+		for(size_t c = 0; c < 3; c++) {
+			target.outputs_[c] = outputs[c];
+		}
+		target.update_outputs();
+	}
 };
 
 }
@@ -9,6 +9,7 @@
 #include "i8272.hpp"
 
 #include "../../Outputs/Log.hpp"
+#include "../../Outputs/Trace.hpp"
 
 using namespace Intel::i8272;
 
@@ -575,7 +576,7 @@ void i8272::posit_event(int event_type) {
 	// Performs the read ID command.
 	read_id:
 		// Establishes the drive and head being addressed, and whether in double density mode.
-			LOG(PADHEX(2) << "Read ID [" << int(command_[0]) << " " << int(command_[1]) << "]");
+			TRACE(DiskController, Info, "Read ID [%02x %02x]", command_[0], command_[1]);
 
 		// Sets a maximum index hole limit of 2 then waits either until it finds a header mark or sees too many index holes.
 		// If a header mark is found, reads in the following bytes that produce a header. Otherwise branches to data not found.
@@ -642,7 +643,7 @@ void i8272::posit_event(int event_type) {
 
 	// Performs format [/write] track.
 	format_track:
-			LOG("Format track");
+			TRACE(DiskController, Info, "Format track");
 			if(get_drive().get_is_read_only()) {
 				SetNotWriteable();
 				goto abort;
@@ -762,11 +763,11 @@ void i8272::posit_event(int event_type) {
 				// up in run_for understands to mean 'keep going until track 0 is active').
 				if(command_.size() > 2) {
 					drives_[drive].target_head_position = command_[2];
-					LOG(PADHEX(2) << "Seek to " << int(command_[2]));
+					TRACE(DiskController, Info, "Seek to %02x", command_[2]);
 				} else {
 					drives_[drive].target_head_position = -1;
 					drives_[drive].head_position = 0;
-					LOG("Recalibrate");
+					TRACE(DiskController, Info, "Recalibrate");
 				}
 
 				// Check whether any steps are even needed; if not then mark as completed already.
@@ -779,7 +780,7 @@ void i8272::posit_event(int event_type) {
 
 	// Performs sense interrupt status.
 	sense_interrupt_status:
-			LOG("Sense interrupt status");
+			TRACE(DiskController, Verbose, "Sense interrupt status");
 			{
 				// Find the first drive that is in the CompletedSeeking state.
 				int found_drive = -1;
@@ -807,7 +808,7 @@ void i8272::posit_event(int event_type) {
 	// Performs specify.
 	specify:
 		// Just store the values, and terminate the command.
-			LOG("Specify");
+			TRACE(DiskController, Info, "Specify");
 			step_rate_time_ = 16 - (command_[1] >> 4);			// i.e. 1 to 16ms
 			head_unload_time_ = (command_[1] & 0x0f) << 4;		// i.e. 16 to 240ms
 			head_load_time_ = command_[2] & ~1;					// i.e. 2 to 254 ms in increments of 2ms
@@ -818,7 +819,7 @@ void i8272::posit_event(int event_type) {
 			goto wait_for_command;
 
 	sense_drive_status:
-			LOG("Sense drive status");
+			TRACE(DiskController, Verbose, "Sense drive status");
 			{
 				int drive = command_[1] & 3;
 				select_drive(drive);
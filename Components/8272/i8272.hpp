@@ -42,10 +42,24 @@ class i8272 : public Storage::Disk::MFMController {
 
 		ClockingHint::Preference preferred_clocking() const final;
 
+		/*!
+			@returns @c true if the 8272 is waiting only upon the host, to supply a command or to collect
+			a result. Reads of either register then have results and effects independent of time, so a
+			host that clocks this chip lazily needn't bring it up to date before a status poll.
+		*/
+		bool is_awaiting_host() const {
+			return
+				!is_executing_ &&
+				!(interesting_event_mask_ & ~(int(Event8272::CommandByte) | int(Event8272::ResultEmpty)));
+		}
+
 	protected:
 		virtual void select_drive(int number) = 0;
 
 	private:
+		// Storage::Disk::Drive::EventDelegate; flux transitions are of interest only during the execution phase of an access command.
+		bool is_listening() const final { return is_executing_; }
+
 		// The bus handler, for interrupt and DMA-driven usage. [TODO]
 		BusHandler &bus_handler_;
 		std::unique_ptr<BusHandler> allocated_bus_handler_;
@@ -8,11 +8,22 @@
 
 #include "9918.hpp"
 
+#include <algorithm>
 #include <cassert>
 #include <cstring>
 #include <cstdlib>
 #include "../../Outputs/Log.hpp"
 
+// Use SSE2 or NEON if available; each is guaranteed to be present on
+// 64-bit x86 and ARM respectively.
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define USE_SSE2
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define USE_NEON
+#endif
+
 using namespace TI::TMS;
 
 namespace {
@@ -47,6 +58,169 @@ struct ReverseTable {
 	}
 } reverse_table;
 
+// MARK: - Pixel serialisation.
+
+/*!
+	Writes to @c target the first @c count pixels, where @c count is either 6 or 8, described by
+	@c pattern, starting from its most significant bit; each 0 is output as @c colours[0] and each 1
+	as @c colours[1].
+*/
+template <int count> void serialise(uint32_t *target, uint8_t pattern, const uint32_t *colours) {
+	static_assert(count == 6 || count == 8);
+
+#if defined(USE_SSE2)
+	const __m128i bits = _mm_set1_epi32(pattern);
+	const __m128i zero = _mm_set1_epi32(int(colours[0]));
+	const __m128i one = _mm_set1_epi32(int(colours[1]));
+	const auto select = [&](const __m128i &masks) {
+		const __m128i is_set = _mm_cmpeq_epi32(_mm_and_si128(bits, masks), masks);
+		return _mm_or_si128(_mm_and_si128(is_set, one), _mm_andnot_si128(is_set, zero));
+	};
+
+	_mm_storeu_si128(reinterpret_cast<__m128i *>(target), select(_mm_set_epi32(0x10, 0x20, 0x40, 0x80)));
+	if constexpr (count == 8) {
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(target + 4), select(_mm_set_epi32(0x01, 0x02, 0x04, 0x08)));
+		return;
+	}
+#elif defined(USE_NEON)
+	static constexpr uint32_t high_masks[] = {0x80, 0x40, 0x20, 0x10};
+	static constexpr uint32_t low_masks[] = {0x08, 0x04, 0x02, 0x01};
+	const uint32x4_t bits = vdupq_n_u32(pattern);
+	const uint32x4_t zero = vdupq_n_u32(colours[0]);
+	const uint32x4_t one = vdupq_n_u32(colours[1]);
+
+	vst1q_u32(target, vbslq_u32(vtstq_u32(bits, vld1q_u32(high_masks)), one, zero));
+	if constexpr (count == 8) {
+		vst1q_u32(target + 4, vbslq_u32(vtstq_u32(bits, vld1q_u32(low_masks)), one, zero));
+		return;
+	}
+#else
+	for(int c = 0; c < 4; ++c) {
+		target[c] = colours[(pattern >> (7 - c)) & 1];
+	}
+	if constexpr (count == 8) {
+		for(int c = 4; c < 8; ++c) {
+			target[c] = colours[(pattern >> (7 - c)) & 1];
+		}
+		return;
+	}
+#endif
+
+	if constexpr (count == 6) {
+		target[4] = colours[(pattern >> 3) & 1];
+		target[5] = colours[(pattern >> 2) & 1];
+	}
+}
+
+/*!
+	Writes to @c target the eight Master System colour indices described by the four bitplanes in
+	@c planes — plane 0 being the least significant byte — each ORd with @c palette_offset.
+	The leftmost pixel is taken from the most significant bit of each plane unless @c flipped is set,
+	in which case it is taken from the least.
+*/
+void serialise_planar(int *target, uint32_t planes, int palette_offset, bool flipped) {
+#if defined(USE_SSE2) || defined(USE_NEON)
+	// The bit that supplies each pixel within plane 0; other planes are at multiples of 8 bits above.
+	alignas(16) static constexpr uint32_t pixel_bits[2][8] = {
+		{0x80, 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01},
+		{0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80},
+	};
+	const uint32_t *const bits = pixel_bits[flipped];
+#endif
+
+#if defined(USE_SSE2)
+	const __m128i pattern = _mm_set1_epi32(int(planes));
+	const __m128i offset = _mm_set1_epi32(palette_offset);
+	const auto serialise4 = [&](const uint32_t *pixel_masks) {
+		__m128i masks = _mm_load_si128(reinterpret_cast<const __m128i *>(pixel_masks));
+		__m128i result = offset;
+		for(int plane = 0; plane < 4; ++plane) {
+			const __m128i is_set = _mm_cmpeq_epi32(_mm_and_si128(pattern, masks), masks);
+			result = _mm_or_si128(result, _mm_and_si128(is_set, _mm_set1_epi32(1 << plane)));
+			masks = _mm_slli_epi32(masks, 8);
+		}
+		return result;
+	};
+
+	_mm_storeu_si128(reinterpret_cast<__m128i *>(target), serialise4(bits));
+	_mm_storeu_si128(reinterpret_cast<__m128i *>(target + 4), serialise4(bits + 4));
+#elif defined(USE_NEON)
+	const uint32x4_t pattern = vdupq_n_u32(planes);
+	const uint32x4_t offset = vdupq_n_u32(uint32_t(palette_offset));
+	const auto serialise4 = [&](const uint32_t *pixel_masks) {
+		uint32x4_t masks = vld1q_u32(pixel_masks);
+		uint32x4_t result = offset;
+		for(int plane = 0; plane < 4; ++plane) {
+			result = vorrq_u32(result, vandq_u32(vtstq_u32(pattern, masks), vdupq_n_u32(1 << plane)));
+			masks = vshlq_n_u32(masks, 8);
+		}
+		return result;
+	};
+
+	vst1q_s32(target, vreinterpretq_s32_u32(serialise4(bits)));
+	vst1q_s32(target + 4, vreinterpretq_s32_u32(serialise4(bits + 4)));
+#else
+	for(int c = 0; c < 8; ++c) {
+		const int shift = flipped ? c : 7 - c;
+		const uint32_t pixel = (planes >> shift) & 0x01010101;
+		target[c] = int(
+			((pixel >> 21) & 0x08) |
+			((pixel >> 14) & 0x04) |
+			((pixel >> 7) & 0x02) |
+			(pixel & 0x01)
+		) | palette_offset;
+	}
+#endif
+}
+
+/*!
+	Copies into @c colour_buffer every non-zero value in @c sprite_buffer within [@c start, @c end)
+	that falls upon a tile pixel which either is transparent or doesn't have priority.
+*/
+void composite_sms_sprites(int *colour_buffer, const int *sprite_buffer, int start, int end) {
+	int c = start;
+
+#if defined(USE_SSE2)
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i priority = _mm_set1_epi32(0x20);
+	const __m128i colour = _mm_set1_epi32(0xf);
+	for(; c + 4 <= end; c += 4) {
+		const __m128i sprites = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&sprite_buffer[c]));
+		const __m128i tiles = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&colour_buffer[c]));
+
+		// A tile pixel obscures a sprite only if it both has priority and is opaque.
+		const __m128i tile_obscures = _mm_andnot_si128(
+			_mm_cmpeq_epi32(_mm_and_si128(tiles, colour), zero),
+			_mm_cmpeq_epi32(_mm_and_si128(tiles, priority), priority));
+		const __m128i use_sprite = _mm_andnot_si128(_mm_or_si128(_mm_cmpeq_epi32(sprites, zero), tile_obscures), _mm_set1_epi32(-1));
+
+		_mm_storeu_si128(
+			reinterpret_cast<__m128i *>(&colour_buffer[c]),
+			_mm_or_si128(_mm_and_si128(use_sprite, sprites), _mm_andnot_si128(use_sprite, tiles)));
+	}
+#elif defined(USE_NEON)
+	const int32x4_t priority = vdupq_n_s32(0x20);
+	const int32x4_t colour = vdupq_n_s32(0xf);
+	for(; c + 4 <= end; c += 4) {
+		const int32x4_t sprites = vld1q_s32(&sprite_buffer[c]);
+		const int32x4_t tiles = vld1q_s32(&colour_buffer[c]);
+
+		// A tile pixel obscures a sprite only if it both has priority and is opaque.
+		const uint32x4_t tile_obscures = vandq_u32(vtstq_s32(tiles, priority), vtstq_s32(tiles, colour));
+		const uint32x4_t use_sprite = vbicq_u32(vtstq_s32(sprites, sprites), tile_obscures);
+
+		vst1q_s32(&colour_buffer[c], vbslq_s32(use_sprite, sprites, tiles));
+	}
+#endif
+
+	for(; c < end; ++c) {
+		if(
+			sprite_buffer[c] &&
+			(!(colour_buffer[c]&0x20) || !(colour_buffer[c]&0xf))
+		) colour_buffer[c] = sprite_buffer[c];
+	}
+}
+
 }
 
 Base::Base(Personality p) :
@@ -234,10 +408,18 @@ void TMS9918::run_for(const HalfCycles cycles) {
 			// Perform memory accesses.
 			// ------------------------
 #define fetch(function)	\
-	if(final_window != 171) {	\
-		function<true>(first_window, final_window);\
+	if(queued_access_ == MemoryAccess::None) {	\
+		if(final_window != 171) {	\
+			function<true, false>(first_window, final_window);\
+		} else {\
+			function<false, false>(first_window, final_window);\
+		}\
 	} else {\
-		function<false>(first_window, final_window);\
+		if(final_window != 171) {	\
+			function<true, true>(first_window, final_window);\
+		} else {\
+			function<false, true>(first_window, final_window);\
+		}\
 	}
 
 			// column_ and end_column are in 342-per-line cycles;
@@ -704,6 +886,12 @@ uint8_t TMS9918::read(int address) {
 	return result;
 }
 
+bool TMS9918::write_is_latch_only(int address) const {
+	// The first half of a control-port pair updates only the latched low byte and the low
+	// byte of the RAM pointer; the latter is observed only by a queued memory access.
+	return (address & 1) && !write_phase_ && queued_access_ == MemoryAccess::None;
+}
+
 HalfCycles Base::half_cycles_before_internal_cycles(int internal_cycles) {
 	return HalfCycles(((internal_cycles << 2) + (2 - cycles_error_)) / 3);
 }
@@ -783,6 +971,89 @@ bool TMS9918::get_interrupt_line() {
 	return ((status_ & StatusInterrupt) && generate_interrupts_) || (enable_line_interrupts_ && line_interrupt_pending_);
 }
 
+// MARK: - State.
+
+State::State() {
+	if(needs_declare()) {
+		DeclareField(ram);
+		DeclareField(registers);
+		DeclareField(status);
+		DeclareField(ram_pointer);
+		DeclareField(read_ahead_buffer);
+		DeclareField(write_phase);
+		DeclareField(low_write);
+		DeclareField(queued_access);
+		DeclareField(cycles_until_access);
+		DeclareField(row);
+		DeclareField(column);
+		DeclareField(cycles_error);
+	}
+}
+
+State::State(const TMS9918 &source): State() {
+	ram = source.ram_;
+
+	// Registers aren't retained as written, so reassemble them from their decoded forms.
+	registers[0] = source.mode2_enable_ ? 0x02 : 0x00;
+	registers[1] = uint8_t(
+		(source.blank_display_ ? 0x00 : 0x40) |
+		(source.generate_interrupts_ ? 0x20 : 0x00) |
+		(source.mode1_enable_ ? 0x10 : 0x00) |
+		(source.mode3_enable_ ? 0x08 : 0x00) |
+		(source.sprites_16x16_ ? 0x02 : 0x00) |
+		(source.sprites_magnified_ ? 0x01 : 0x00)
+	);
+	registers[2] = uint8_t((source.pattern_name_address_ >> 10) & 0x0f);
+	registers[3] = uint8_t(source.colour_table_address_ >> 6);
+	registers[4] = uint8_t((source.pattern_generator_table_address_ >> 11) & 0x07);
+	registers[5] = uint8_t((source.sprite_attribute_table_address_ >> 7) & 0x7f);
+	registers[6] = uint8_t((source.sprite_generator_table_address_ >> 11) & 0x07);
+	registers[7] = uint8_t((source.text_colour_ << 4) | source.background_colour_);
+
+	status = source.status_;
+	ram_pointer = source.ram_pointer_;
+	read_ahead_buffer = source.read_ahead_buffer_;
+	write_phase = source.write_phase_;
+	low_write = source.low_write_;
+	queued_access = int(source.queued_access_);
+	cycles_until_access = source.cycles_until_access_;
+
+	row = source.write_pointer_.row;
+	column = source.write_pointer_.column;
+	cycles_error = source.cycles_error_;
+}
+
+void State::apply(TMS9918 &target) const {
+	// Set registers through the control port, as a programmer would.
+	target.write_phase_ = false;
+	for(int c = 0; c < 8; c++) {
+		target.write(1, registers[c]);
+		target.write(1, uint8_t(0x80 | c));
+	}
+	std::copy(ram.begin(), ram.begin() + std::min(ram.size(), target.ram_.size()), target.ram_.begin());
+
+	// Run to the captured position, without performing any access that was already queued;
+	// whichever is captured is reinstated below. cycles_error_ is zeroed so that exactly
+	// ceil(4n/3) half-cycles yield n internal cycles.
+	target.queued_access_ = Base::MemoryAccess::None;
+	const int frame_length = 342 * target.mode_timing_.total_lines;
+	const int position = ((row % target.mode_timing_.total_lines) * 342) + column;
+	const int distance = (position - (target.write_pointer_.row * 342 + target.write_pointer_.column) + frame_length) % frame_length;
+	if(distance) {
+		target.cycles_error_ = 0;
+		target.run_for(HalfCycles((distance * 4 + 2) / 3));
+	}
+
+	target.status_ = status;
+	target.ram_pointer_ = ram_pointer;
+	target.read_ahead_buffer_ = read_ahead_buffer;
+	target.write_phase_ = write_phase;
+	target.low_write_ = low_write;
+	target.queued_access_ = Base::MemoryAccess(queued_access);
+	target.cycles_until_access_ = cycles_until_access;
+	target.cycles_error_ = cycles_error;
+}
+
 // MARK: -
 
 void Base::draw_tms_character(int start, int end) {
@@ -812,9 +1083,13 @@ void Base::draw_tms_character(int start, int end) {
 		int background_pixels_left = pixels_left;
 		while(true) {
 			background_pixels_left -= length;
-			for(int c = 0; c < length; ++c) {
-				pixel_target_[c] = colours[pattern&0x01];
-				pattern >>= 1;
+			if(length == 8) {
+				serialise<8>(pixel_target_, line_buffer.patterns[byte_column][0], colours);
+			} else {
+				for(int c = 0; c < length; ++c) {
+					pixel_target_[c] = colours[pattern&0x01];
+					pattern >>= 1;
+				}
 			}
 			pixel_target_ += length;
 
@@ -888,9 +1163,13 @@ void Base::draw_tms_text(int start, int end) {
 	int length = std::min(pixels_left, 6 - shift);
 	while(true) {
 		pixels_left -= length;
-		for(int c = 0; c < length; ++c) {
-			pixel_target_[c] = colours[pattern&0x01];
-			pattern >>= 1;
+		if(length == 6) {
+			serialise<6>(pixel_target_, line_buffer.patterns[byte_column][0], colours);
+		} else {
+			for(int c = 0; c < length; ++c) {
+				pixel_target_[c] = colours[pattern&0x01];
+				pattern >>= 1;
+			}
 		}
 		pixel_target_ += length;
 
@@ -944,7 +1223,10 @@ void Base::draw_sms(int start, int end, uint32_t cram_dot) {
 
 		while(true) {
 			const int palette_offset = (line_buffer.names[byte_column].flags&0x18) << 1;
-			if(line_buffer.names[byte_column].flags&2) {
+			if(length == 8) {
+				serialise_planar(&colour_buffer[tile_offset], pattern, palette_offset, line_buffer.names[byte_column].flags&2);
+				tile_offset += 8;
+			} else if(line_buffer.names[byte_column].flags&2) {
 				for(int c = 0; c < length; ++c) {
 					colour_buffer[tile_offset] =
 						((pattern_index[3] & 0x01) << 3) |
@@ -1023,12 +1305,7 @@ void Base::draw_sms(int start, int end, uint32_t cram_dot) {
 
 		// Draw the sprite buffer onto the colour buffer, wherever the tile map doesn't have
 		// priority (or is transparent).
-		for(int c = start; c < end; ++c) {
-			if(
-				sprite_buffer[c] &&
-				(!(colour_buffer[c]&0x20) || !(colour_buffer[c]&0xf))
-			) colour_buffer[c] = sprite_buffer[c];
-		}
+		composite_sms_sprites(colour_buffer, sprite_buffer, start, end);
 
 		if(sprite_collision)
 			status_ |= StatusSpriteCollision;
@@ -11,6 +11,7 @@
 
 #include "../../Outputs/CRT/CRT.hpp"
 #include "../../ClockReceiver/ClockReceiver.hpp"
+#include "../../Reflection/Struct.hpp"
 
 #include "Implementation/9918Base.hpp"
 
@@ -53,6 +54,11 @@ class TMS9918: public Base {
 		/*! Gets the type of display the CRT will request. */
 		Outputs::Display::DisplayType get_display_type() const;
 
+		/*! @returns The number of bytes of video RAM. */
+		size_t get_video_ram_size() const {
+			return ram_.size();
+		}
+
 		/*!
 			Runs the VCP for the number of cycles indicate; it is an implicit assumption of the code
 			that the input clock rate is 3579545 Hz, the NTSC colour clock rate.
@@ -65,6 +71,12 @@ class TMS9918: public Base {
 		/*! Gets a register value. */
 		uint8_t read(int address);
 
+		/*!
+			@returns @c true if a write to @c address would merely latch a value that won't be observed
+			until some subsequent access; such a write can be made without first bringing the VDP up to date.
+		*/
+		bool write_is_latch_only(int address) const;
+
 		/*! Gets the current scan line; provided by the Master System only. */
 		uint8_t get_current_line();
 
@@ -99,6 +111,41 @@ class TMS9918: public Base {
 		bool get_interrupt_line();
 };
 
+/*!
+	Captures the programmer-visible state of a TMS9918A: video RAM, registers, the status
+	register, the state of the RAM-access mechanism and the current raster position.
+
+	Sega-specific registers and colour RAM are not included.
+*/
+struct State: public Reflection::StructImpl<State> {
+	std::vector<uint8_t> ram;
+	uint8_t registers[8]{};
+	uint8_t status = 0;
+
+	uint16_t ram_pointer = 0;
+	uint8_t read_ahead_buffer = 0;
+	bool write_phase = false;
+	uint8_t low_write = 0;
+
+	// 0 = read, 1 = write, 2 = none; cf. Base::MemoryAccess.
+	int queued_access = 2;
+	int cycles_until_access = 0;
+
+	// The position of the fetch process, in internal cycles, plus the
+	// fractional remainder of the input clock.
+	int row = 0, column = 0;
+	int cycles_error = 0;
+
+	State();
+	State(const TMS9918 &source);
+
+	/*!
+		Applies this state to @c target. @c target is run forward to the captured raster
+		position, so that its internal line buffers are refilled in the process.
+	*/
+	void apply(TMS9918 &target) const;
+};
+
 }
 }
 
@@ -38,6 +38,8 @@ enum class TVStandard {
 
 #define is_sega_vdp(x) ((x) >= SMSVDP)
 
+struct State;
+
 class Base {
 	public:
 		static uint32_t palette_pack(uint8_t r, uint8_t g, uint8_t b) {
@@ -412,9 +414,14 @@ class Base {
 			end is < 172, false otherwise. So functions can use it to eliminate should-exit-not checks,
 			for the more usual path of execution.
 
+		5)	they are also templated with a `has_access` parameter, which will be false if no external
+			access is queued. Since one can't be queued during a fetch, that allows all external slots
+			to be skipped; in the common case of the CPU not touching the VDP for the whole of a line,
+			the line's fetches are then performed in a single unbroken pass.
+
 	Provided for the benefit of the methods below:
 
-		*	the function external_slot(), which will perform any pending VRAM read/write.
+		*	the function do_external_slot(), which will perform any pending VRAM read/write.
 		*	the macros slot(n) and external_slot(n) which can be used to schedule those things inside a
 			switch(start)-based implementation.
 
@@ -429,7 +436,7 @@ class Base {
 		case n
 
 #define external_slot(n)	\
-	slot(n): do_external_slot((n)*2);
+	slot(n): if constexpr (has_access) do_external_slot((n)*2);
 
 #define external_slots_2(n)	\
 	external_slot(n);		\
@@ -456,7 +463,7 @@ class Base {
 	TMS9918 Fetching Code
 ************************************************/
 
-		template<bool use_end> void fetch_tms_refresh(int start, int end) {
+		template<bool use_end, bool has_access> void fetch_tms_refresh(int start, int end) {
 #define refresh(location)		\
 	slot(location):				\
 	external_slot(location+1);
@@ -500,7 +507,7 @@ class Base {
 #undef refresh
 		}
 
-		template<bool use_end> void fetch_tms_text(int start, int end) {
+		template<bool use_end, bool has_access> void fetch_tms_text(int start, int end) {
 #define fetch_tile_name(location, column)		slot(location): line_buffer.names[column].offset = ram_[row_base + column];
 #define fetch_tile_pattern(location, column)	slot(location): line_buffer.patterns[column][0] = ram_[row_offset + size_t(line_buffer.names[column].offset << 3)];
 
@@ -557,7 +564,7 @@ class Base {
 #undef fetch_tile_name
 		}
 
-		template<bool use_end> void fetch_tms_character(int start, int end) {
+		template<bool use_end, bool has_access> void fetch_tms_character(int start, int end) {
 #define sprite_fetch_coordinates(location, sprite)	\
 	slot(location):		\
 	slot(location+1):	\
@@ -661,7 +668,7 @@ class Base {
 
 				slot(31):
 					sprite_selection_buffer.reset_sprite_collection();
-					do_external_slot(31*2);
+					if constexpr (has_access) do_external_slot(31*2);
 				external_slots_2(32);
 				external_slot(34);
 
@@ -700,7 +707,7 @@ class Base {
 	Master System Fetching Code
 ************************************************/
 
-		template<bool use_end> void fetch_sms(int start, int end) {
+		template<bool use_end, bool has_access> void fetch_sms(int start, int end) {
 #define sprite_fetch(sprite)	{\
 		line_buffer.active_sprites[sprite].x = \
 			ram_[\
@@ -813,7 +820,7 @@ class Base {
 
 				slot(29):
 					sprite_selection_buffer.reset_sprite_collection();
-					do_external_slot(29*2);
+					if constexpr (has_access) do_external_slot(29*2);
 				external_slot(30);
 
 				sprite_y_read(31, 0);
@@ -855,6 +862,8 @@ class Base {
 		void draw_tms_character(int start, int end);
 		void draw_tms_text(int start, int end);
 		void draw_sms(int start, int end, uint32_t cram_dot);
+
+		friend struct State;
 };
 
 }
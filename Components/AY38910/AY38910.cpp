@@ -6,6 +6,7 @@
 //  Copyright 2016 Thomas Harte. All rights reserved.
 //
 
+#include <algorithm>
 #include <cmath>
 
 #include "AY38910.hpp"
@@ -16,7 +17,7 @@
 using namespace GI::AY38910;
 
 template <bool is_stereo>
-AY38910<is_stereo>::AY38910(Personality personality, Concurrency::DeferringAsyncTaskQueue &task_queue) : task_queue_(task_queue) {
+AY38910<is_stereo>::AY38910(Personality personality, Concurrency::DeferringAsyncTaskQueue &task_queue) : audio_log_(task_queue, *this) {
 	// Don't use the low bit of the envelope position if this is an AY.
 	envelope_position_mask_ |= personality == Personality::AY38910;
 
@@ -123,6 +124,31 @@ template <bool is_stereo> void AY38910<is_stereo>::get_samples(std::size_t numbe
 	}
 
 	while(c < number_of_samples) {
+		// If no counter will expire for a while then nothing that affects output will change; in that case
+		// just decrement all counters and output the current volume for as many whole steps as possible.
+		const int quiet_steps = std::min({tone_counters_[0], tone_counters_[1], tone_counters_[2], noise_counter_, envelope_divider_});
+		const std::size_t bulk_steps = std::min(std::size_t(quiet_steps), (number_of_samples - c) >> 2);
+		if(bulk_steps) {
+			const int steps = int(bulk_steps);
+			tone_counters_[0] -= steps;
+			tone_counters_[1] -= steps;
+			tone_counters_[2] -= steps;
+			noise_counter_ -= steps;
+			envelope_divider_ -= steps;
+
+			evaluate_output_volume();
+
+			const std::size_t samples = bulk_steps << 2;
+			if constexpr (is_stereo) {
+				std::fill_n(&reinterpret_cast<uint32_t *>(target)[c], samples, output_volume_);
+			} else {
+				std::fill_n(&target[c], samples, int16_t(output_volume_));
+			}
+			c += samples;
+			master_divider_ += int(samples);
+			continue;
+		}
+
 #define step_channel(c) \
 	if(tone_counters_[c]) tone_counters_[c]--;\
 	else {\
@@ -245,51 +271,53 @@ template <bool is_stereo> void AY38910<is_stereo>::select_register(uint8_t r) {
 	selected_register_ = r;
 }
 
-template <bool is_stereo> void AY38910<is_stereo>::set_register_value(uint8_t value) {
-	// There are only 16 registers.
-	if(selected_register_ > 15) return;
+template <bool is_stereo> void AY38910<is_stereo>::apply_register_write(uint16_t selected_register, uint8_t value) {
+	// Perform any register-specific mutation to output generation.
+	uint8_t masked_value = value;
+	switch(selected_register) {
+		case 0: case 2: case 4:
+		case 1: case 3: case 5: {
+			int channel = selected_register >> 1;
+
+			if(selected_register & 1)
+				tone_periods_[channel] = (tone_periods_[channel] & 0xff) | uint16_t((value&0xf) << 8);
+			else
+				tone_periods_[channel] = (tone_periods_[channel] & ~0xff) | value;
+		}
+		break;
 
-	// If this is a register that affects audio output, enqueue a mutation onto the
-	// audio generation thread.
-	if(selected_register_ < 14) {
-		task_queue_.defer([this, selected_register = selected_register_, value] () {
-			// Perform any register-specific mutation to output generation.
-			uint8_t masked_value = value;
-			switch(selected_register) {
-				case 0: case 2: case 4:
-				case 1: case 3: case 5: {
-					int channel = selected_register >> 1;
-
-					if(selected_register & 1)
-						tone_periods_[channel] = (tone_periods_[channel] & 0xff) | uint16_t((value&0xf) << 8);
-					else
-						tone_periods_[channel] = (tone_periods_[channel] & ~0xff) | value;
-				}
-				break;
+		case 6:
+			noise_period_ = value & 0x1f;
+		break;
 
-				case 6:
-					noise_period_ = value & 0x1f;
-				break;
+		case 11:
+			envelope_period_ = (envelope_period_ & ~0xff) | value;
+		break;
 
-				case 11:
-					envelope_period_ = (envelope_period_ & ~0xff) | value;
-				break;
+		case 12:
+			envelope_period_ = (envelope_period_ & 0xff) | int(value << 8);
+		break;
 
-				case 12:
-					envelope_period_ = (envelope_period_ & 0xff) | int(value << 8);
-				break;
+		case 13:
+			masked_value &= 0xf;
+			envelope_position_ = 0;
+		break;
+	}
 
-				case 13:
-					masked_value &= 0xf;
-					envelope_position_ = 0;
-				break;
-			}
+	// Store a copy of the current register within the storage used by the audio generation
+	// thread, and apply any changes to output volume.
+	output_registers_[selected_register] = masked_value;
+	evaluate_output_volume();
+}
 
-			// Store a copy of the current register within the storage used by the audio generation
-			// thread, and apply any changes to output volume.
-			output_registers_[selected_register] = masked_value;
-			evaluate_output_volume();
-		});
+template <bool is_stereo> void AY38910<is_stereo>::set_register_value(uint8_t value) {
+	// There are only 16 registers.
+	if(selected_register_ > 15) return;
+
+	// If this is a register that affects audio output, log it for application on the
+	// audio generation thread.
+	if(selected_register_ < 14) {
+		audio_log_.write(uint16_t(selected_register_), value);
 	}
 
 	// Decide which outputs are going to need updating (if any).
@@ -10,6 +10,7 @@
 #define AY_3_8910_hpp
 
 #include "../../Outputs/Speaker/Implementation/SampleSource.hpp"
+#include "../../Outputs/Speaker/Implementation/RegisterWriteLog.hpp"
 #include "../../Concurrency/AsyncTaskQueue.hpp"
 
 #include "../../Reflection/Struct.hpp"
@@ -114,7 +115,11 @@ template <bool is_stereo> class AY38910: public ::Outputs::Speaker::SampleSource
 		static constexpr bool get_is_stereo() { return is_stereo; }
 
 	private:
-		Concurrency::DeferringAsyncTaskQueue &task_queue_;
+		friend ::Outputs::Speaker::RegisterWriteLog<AY38910<is_stereo>>;
+		::Outputs::Speaker::RegisterWriteLog<AY38910<is_stereo>> audio_log_;
+
+		/// Applies a write to one of the registers that affect audio output; called on the audio generation thread.
+		void apply_register_write(uint16_t selected_register, uint8_t value);
 
 		int selected_register_ = 0;
 		uint8_t registers_[16] = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
@@ -209,7 +214,14 @@ struct State: public Reflection::StructImpl<State> {
 		}
 	}
 
-	template <typename AY> void apply(AY &target) {
+	template <typename AY> State(const AY &source) : State() {
+		for(size_t c = 0; c < 16; c++) {
+			registers[c] = source.registers_[c];
+		}
+		selected_register = uint8_t(source.selected_register_);
+	}
+
+	template <typename AY> void apply(AY &target) const {
 		// Establish emulator-thread state
 		for(uint8_t c = 0; c < 16; c++) {
 			target.select_register(c);
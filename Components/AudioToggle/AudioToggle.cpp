@@ -25,6 +25,11 @@ void Toggle::set_sample_volume_range(std::int16_t range) {
 
 void Toggle::skip_samples(std::size_t) {}
 
+bool Toggle::get_constant_level(std::int16_t *level) const {
+	*level = level_;
+	return true;
+}
+
 void Toggle::set_output(bool enabled) {
 	if(is_enabled_ == enabled) return;
 	is_enabled_ = enabled;
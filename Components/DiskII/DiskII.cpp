@@ -8,6 +8,7 @@
 
 #include "DiskII.hpp"
 
+#include <algorithm>
 #include <cstdio>
 #include <cstring>
 
@@ -79,45 +80,52 @@ void DiskII::run_for(const Cycles cycles) {
 	if(preferred_clocking() == ClockingHint::Preference::None) return;
 
 	auto integer_cycles = cycles.as_integral();
-	while(integer_cycles--) {
-		const int address = (state_ & 0xf0) | inputs_ | ((shift_register_&0x80) >> 6);
-		if(flux_duration_) {
-			--flux_duration_;
-			if(!flux_duration_) inputs_ |= input_flux;
-		}
-		state_ = state_machine_[size_t(address)];
-		switch(state_ & 0xf) {
-			default:	shift_register_ = 0;										break;	// clear
-			case 0x8:																break;	// nop
-
-			case 0x9:	shift_register_ = uint8_t(shift_register_ << 1);			break;	// shift left, bringing in a zero
-			case 0xd:	shift_register_ = uint8_t((shift_register_ << 1) | 1);		break;	// shift left, bringing in a one
-
-			case 0xa:	// shift right, bringing in write protected status
-				shift_register_ = (shift_register_ >> 1) | (is_write_protected() ? 0x80 : 0x00);
-
-				// If the controller is in the sense write protect loop but the register will never change,
-				// short circuit further work and return now.
-				if(shift_register_ == (is_write_protected() ? 0xff : 0x00)) {
-					if(!drive_is_sleeping_[0]) drives_[0].run_for(Cycles(integer_cycles));
-					if(!drive_is_sleeping_[1]) drives_[1].run_for(Cycles(integer_cycles));
-					decide_clocking_preference();
-					return;
-				}
-			break;
-			case 0xb:	shift_register_ = data_input_;								break;	// load data register from data bus
-		}
-
-		// Currently writing?
-		if(inputs_&input_mode) {
-			// state_ & 0x80 should be the current level sent to the disk;
-			// therefore transitions in that bit should become flux transitions
-			drives_[active_drive_].write_bit(!!((state_ ^ address) & 0x80));
+	while(integer_cycles) {
+		// While reading, the state machine's inputs change only upon drive events, so it can run up
+		// until the next of those before the drives need to catch up.
+		const auto batch = (inputs_&input_mode) ? 1 : cycles_until_drive_event(integer_cycles);
+		for(Cycles::IntType step = 0; step < batch; ++step) {
+			const int address = (state_ & 0xf0) | inputs_ | ((shift_register_&0x80) >> 6);
+			if(flux_duration_) {
+				--flux_duration_;
+				if(!flux_duration_) inputs_ |= input_flux;
+			}
+			state_ = state_machine_[size_t(address)];
+			switch(state_ & 0xf) {
+				default:	shift_register_ = 0;										break;	// clear
+				case 0x8:																break;	// nop
+
+				case 0x9:	shift_register_ = uint8_t(shift_register_ << 1);			break;	// shift left, bringing in a zero
+				case 0xd:	shift_register_ = uint8_t((shift_register_ << 1) | 1);		break;	// shift left, bringing in a one
+
+				case 0xa:	// shift right, bringing in write protected status
+					shift_register_ = (shift_register_ >> 1) | (is_write_protected() ? 0x80 : 0x00);
+
+					// If the controller is in the sense write protect loop but the register will never change,
+					// short circuit further work and return now.
+					if(shift_register_ == (is_write_protected() ? 0xff : 0x00)) {
+						// i.e. the steps completed so far in this batch, plus all those after this one.
+						const auto remaining = integer_cycles - 1;
+						if(!drive_is_sleeping_[0]) drives_[0].run_for(Cycles(remaining));
+						if(!drive_is_sleeping_[1]) drives_[1].run_for(Cycles(remaining));
+						decide_clocking_preference();
+						return;
+					}
+				break;
+				case 0xb:	shift_register_ = data_input_;								break;	// load data register from data bus
+			}
+
+			// Currently writing?
+			if(inputs_&input_mode) {
+				// state_ & 0x80 should be the current level sent to the disk;
+				// therefore transitions in that bit should become flux transitions
+				drives_[active_drive_].write_bit(!!((state_ ^ address) & 0x80));
+			}
 		}
 
-		// TODO: surely there's a less heavyweight solution than inline updates?
-		if(!drive_is_sleeping_[0]) drives_[0].run_for(Cycles(1));
-		if(!drive_is_sleeping_[1]) drives_[1].run_for(Cycles(1));
+		integer_cycles -= batch;
+		if(!drive_is_sleeping_[0]) drives_[0].run_for(Cycles(batch));
+		if(!drive_is_sleeping_[1]) drives_[1].run_for(Cycles(batch));
 	}
 
 	// Per comp.sys.apple2.programmer there is a delay between the controller
@@ -132,6 +140,14 @@ void DiskII::run_for(const Cycles cycles) {
 	decide_clocking_preference();
 }
 
+Cycles::IntType DiskII::cycles_until_drive_event(Cycles::IntType limit) const {
+	for(int c = 0; c < 2; c++) {
+		if(drive_is_sleeping_[c]) continue;
+		limit = std::min(limit, drives_[c].get_cycles_until_event());
+	}
+	return std::max(limit, Cycles::IntType(1));
+}
+
 void DiskII::decide_clocking_preference() {
 	ClockingHint::Preference prior_preference = clocking_preference_;
 
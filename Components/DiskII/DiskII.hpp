@@ -85,6 +85,11 @@ class DiskII :
 		// *NOT FOR HARDWARE EMULATION USAGE*.
 		Storage::Disk::Drive &get_drive(int index);
 
+		/// @returns The number of bytes of host memory occupied by tracks of the disks in both drives.
+		size_t get_disk_memory_footprint() const {
+			return drives_[0].get_disk_memory_footprint() + drives_[1].get_disk_memory_footprint();
+		}
+
 	private:
 		enum class Control {
 			P0, P1, P2, P3,
@@ -119,6 +124,7 @@ class DiskII :
 		bool motor_is_enabled_ = false;
 
 		void decide_clocking_preference();
+		Cycles::IntType cycles_until_drive_event(Cycles::IntType limit) const;
 		ClockingHint::Preference clocking_preference_ = ClockingHint::Preference::RealTime;
 
 		uint8_t data_input_ = 0;
@@ -8,6 +8,8 @@
 
 #include "IWM.hpp"
 
+#include <algorithm>
+
 #ifndef NDEBUG
 #define NDEBUG
 #endif
@@ -256,10 +258,19 @@ void IWM::run_for(const Cycles cycles) {
 			const auto error_margin = Cycles(bit_length_.as_integral() >> 1);
 
 			if(drive_is_rotating_[active_drive_]) {
-				while(integer_cycles--) {
-					drives_[active_drive_]->run_for(Cycles(1));
-					++cycles_since_shift_;
-					if(cycles_since_shift_ == bit_length_ + error_margin) {
+				auto &drive = *drives_[active_drive_];
+				const auto shift_time = bit_length_ + error_margin;
+				while(integer_cycles) {
+					// Flux transitions arrive only as drive events, so the drive can be run in a single
+					// step up until the cycle before its next, or until the next zero is due to be shifted.
+					auto run_length = std::min(integer_cycles, drive.get_cycles_until_event());
+					if(cycles_since_shift_ < shift_time) run_length = std::min(run_length, (shift_time - cycles_since_shift_).as_integral());
+					run_length = std::max(run_length, Cycles::IntType(1));
+
+					integer_cycles -= run_length;
+					drive.run_for(Cycles(run_length));
+					cycles_since_shift_ += Cycles(run_length);
+					if(cycles_since_shift_ == shift_time) {
 //						LOG("Shifting 0 at " << std::dec << cycles_since_shift_.as_integral());
 						propose_shift(0);
 					}
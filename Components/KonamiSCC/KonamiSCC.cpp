@@ -8,12 +8,13 @@
 
 #include "KonamiSCC.hpp"
 
+#include <algorithm>
 #include <cstring>
 
 using namespace Konami;
 
 SCC::SCC(Concurrency::DeferringAsyncTaskQueue &task_queue) :
-	task_queue_(task_queue) {}
+	audio_log_(task_queue, *this) {}
 
 bool SCC::is_zero_level() const {
 	return !(channel_enable_ & 0x1f);
@@ -33,6 +34,24 @@ void SCC::get_samples(std::size_t number_of_samples, std::int16_t *target) {
 	}
 
 	while(c < number_of_samples) {
+		// Output can change only when a channel advances its offset, so any whole groups of eight
+		// samples prior to the next such advance are of constant value.
+		int quiet_groups = int((number_of_samples - c) >> 3);
+		for(int channel = 0; channel < 5; ++channel) {
+			quiet_groups = std::min(quiet_groups, channels_[channel].tone_counter);
+		}
+		if(quiet_groups) {
+			for(int channel = 0; channel < 5; ++channel) {
+				channels_[channel].tone_counter -= quiet_groups;
+			}
+
+			const std::size_t length = std::size_t(quiet_groups) << 3;
+			std::fill(&target[c], &target[c + length], transient_output_level_);
+			c += length;
+			master_divider_ += int(length);
+			continue;
+		}
+
 		for(int channel = 0; channel < 5; ++channel) {
 			if(channels_[channel].tone_counter) channels_[channel].tone_counter--;
 			else {
@@ -51,38 +70,40 @@ void SCC::get_samples(std::size_t number_of_samples, std::int16_t *target) {
 	}
 }
 
+void SCC::apply_register_write(uint16_t address, uint8_t value) {
+	// Check for a write into waveform memory.
+	if(address < 0x80) {
+		waves_[address >> 5].samples[address & 0x1f] = value;
+	} else switch(address) {
+		default: break;
+
+		case 0x80: case 0x82: case 0x84: case 0x86: case 0x88: {
+			int channel = (address - 0x80) >> 1;
+			channels_[channel].period = (channels_[channel].period & ~0xff) | value;
+		} break;
+
+		case 0x81: case 0x83: case 0x85: case 0x87: case 0x89: {
+			int channel = (address - 0x80) >> 1;
+			channels_[channel].period = (channels_[channel].period & 0xff) | ((value & 0xf) << 8);
+		} break;
+
+		case 0x8a: case 0x8b: case 0x8c: case 0x8d: case 0x8e:
+			channels_[address - 0x8a].amplitude = value & 0xf;
+		break;
+
+		case 0x8f:
+			channel_enable_ = value;
+		break;
+	}
+
+	evaluate_output_volume();
+}
+
 void SCC::write(uint16_t address, uint8_t value) {
 	address &= 0xff;
 	if(address < 0x80) ram_[address] = value;
 
-	task_queue_.defer([this, address, value] {
-		// Check for a write into waveform memory.
-		if(address < 0x80) {
-			waves_[address >> 5].samples[address & 0x1f] = value;
-		} else switch(address) {
-			default: break;
-
-			case 0x80: case 0x82: case 0x84: case 0x86: case 0x88: {
-				int channel = (address - 0x80) >> 1;
-				channels_[channel].period = (channels_[channel].period & ~0xff) | value;
-			} break;
-
-			case 0x81: case 0x83: case 0x85: case 0x87: case 0x89: {
-				int channel = (address - 0x80) >> 1;
-				channels_[channel].period = (channels_[channel].period & 0xff) | ((value & 0xf) << 8);
-			} break;
-
-			case 0x8a: case 0x8b: case 0x8c: case 0x8d: case 0x8e:
-				channels_[address - 0x8a].amplitude = value & 0xf;
-			break;
-
-			case 0x8f:
-				channel_enable_ = value;
-			break;
-		}
-
-		evaluate_output_volume();
-	});
+	audio_log_.write(address, value);
 }
 
 void SCC::evaluate_output_volume() {
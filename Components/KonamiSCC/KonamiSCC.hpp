@@ -10,6 +10,7 @@
 #define KonamiSCC_hpp
 
 #include "../../Outputs/Speaker/Implementation/SampleSource.hpp"
+#include "../../Outputs/Speaker/Implementation/RegisterWriteLog.hpp"
 #include "../../Concurrency/AsyncTaskQueue.hpp"
 
 namespace Konami {
@@ -41,7 +42,9 @@ class SCC: public ::Outputs::Speaker::SampleSource {
 		uint8_t read(uint16_t address);
 
 	private:
-		Concurrency::DeferringAsyncTaskQueue &task_queue_;
+		friend ::Outputs::Speaker::RegisterWriteLog<SCC>;
+		::Outputs::Speaker::RegisterWriteLog<SCC> audio_log_;
+		void apply_register_write(uint16_t address, uint8_t value);
 
 		// State from here on down is accessed ony from the audio thread.
 		int master_divider_ = 0;
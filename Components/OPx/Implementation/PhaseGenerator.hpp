@@ -119,6 +119,109 @@ template <int precision> class PhaseGenerator {
 		int enable_vibrato_ = 0;
 };
 
+/*!
+	Models @c count OPL-style phase generators as a single structure of arrays, so that all can be advanced
+	together in a single vectorisable loop. Individual generators are accessed via the subscript operator,
+	which provides the same interface as an individual PhaseGenerator other than update().
+*/
+template <int precision, int count> class PhaseGeneratorBank {
+	public:
+		class Generator {
+			public:
+				/// As per PhaseGenerator::phase().
+				int phase() const {
+					return bank_.phase_[index_] >> precision_shift;
+				}
+
+				/// As per PhaseGenerator::scaled_phase().
+				int scaled_phase() const {
+					return bank_.phase_[index_] >> 1;
+				}
+
+				/// As per PhaseGenerator::apply_feedback().
+				void apply_feedback(LogSign first, LogSign second, int level) {
+					constexpr int masks[] = {0, ~0, ~0, ~0, ~0, ~0, ~0, ~0};
+					bank_.phase_[index_] += ((second.level(precision) + first.level(precision)) >> (8 - level)) & masks[level];
+				}
+
+				/// As per PhaseGenerator::set_multiple().
+				void set_multiple(int multiple) {
+					constexpr int multipliers[] = {
+						1, 2, 4, 6, 8, 10, 12, 14, 16, 18, 20, 20, 24, 24, 30, 30
+					};
+					assert(multiple < 16);
+					bank_.multiple_[index_] = multipliers[multiple];
+					bank_.update_scale(index_);
+				}
+
+				/// As per PhaseGenerator::set_period().
+				void set_period(int period, int octave) {
+					assert(octave < 8);
+					assert(period < (1 << precision));
+
+					bank_.period_[index_] = period;
+					bank_.octave_[index_] = octave;
+					bank_.update_scale(index_);
+				}
+
+				/// As per PhaseGenerator::set_vibrato_enabled().
+				void set_vibrato_enabled(bool enabled) {
+					bank_.vibrato_mask_[index_] = enabled ? ~0 : 0;
+				}
+
+				/// As per PhaseGenerator::reset().
+				void reset() {
+					bank_.phase_[index_] = 0;
+				}
+
+			private:
+				friend PhaseGeneratorBank;
+				Generator(PhaseGeneratorBank &bank, int index) : bank_(bank), index_(index) {}
+
+				PhaseGeneratorBank &bank_;
+				const int index_;
+		};
+
+		/// @returns The generator at @c index.
+		Generator operator[](int index) {
+			return Generator(*this, index);
+		}
+
+		/*!
+			Advances all phase generators a single step, given the current state of the low-frequency oscillator, @c oscillator.
+		*/
+		void update(const LowFrequencyOscillator &oscillator) {
+			constexpr int vibrato_shifts[4] = {3, 1, 0, 1};
+
+			// The vibrato shift and sign are the same for every generator; see PhaseGenerator::update for
+			// a fuller description of the calculation below.
+			const int vibrato_shift = vibrato_shifts[oscillator.vibrato & 3];
+			const int vibrato_negate = -(oscillator.vibrato >> 2);
+
+			for(int c = 0; c < count; c++) {
+				const int top_freq = period_[c] >> (precision - 3);
+				const int vibrato = (((top_freq >> vibrato_shift) ^ vibrato_negate) - vibrato_negate) & vibrato_mask_[c];
+				phase_[c] += (scale_[c] * ((period_[c] << 1) + vibrato)) >> 1;
+			}
+		}
+
+	private:
+		static constexpr int precision_shift =  1 + precision;
+
+		alignas(16) int phase_[count]{};
+		alignas(16) int period_[count]{};
+		alignas(16) int vibrato_mask_[count]{};
+
+		// scale_ is multiple_ << octave_, so that update needn't perform a per-generator shift.
+		alignas(16) int scale_[count]{};
+		int multiple_[count]{};
+		int octave_[count]{};
+
+		void update_scale(int index) {
+			scale_[index] = multiple_[index] << octave_[index];
+		}
+};
+
 }
 }
 
@@ -13,7 +13,7 @@
 using namespace Yamaha::OPL;
 
 OPLL::OPLL(Concurrency::DeferringAsyncTaskQueue &task_queue, int audio_divider, bool is_vrc7):
-	OPLBase(task_queue), audio_divider_(audio_divider), is_vrc7_(is_vrc7) {
+	OPLBase(task_queue), audio_log_(task_queue, *this), audio_divider_(audio_divider), is_vrc7_(is_vrc7) {
 	// Due to the way that sound mixing works on the OPLL, the audio divider may not
 	// be larger than 4.
 	assert(audio_divider <= 4);
@@ -71,105 +71,107 @@ OPLL::OPLL(Concurrency::DeferringAsyncTaskQueue &task_queue, int audio_divider,
 
 // MARK: - Machine-facing programmatic input.
 
-void OPLL::write_register(uint8_t address, uint8_t value) {
-	// The OPLL doesn't have timers or other non-audio functions, so all writes
-	// go to the audio queue.
-	task_queue_.defer([this, address, value] {
-		// The first 8 locations are used to define the custom instrument, and have
-		// exactly the same format as the patch set arrays at the head of this file.
-		if(address < 8) {
-			custom_instrument_[address] = value;
-
-			// Update all channels that refer to instrument 0.
-			for(int c = 0; c < 9; ++c) {
-				if(!channels_[c].instrument) {
-					install_instrument(c);
-				}
+void OPLL::apply_register_write(uint16_t address, uint8_t value) {
+	// The first 8 locations are used to define the custom instrument, and have
+	// exactly the same format as the patch set arrays at the head of this file.
+	if(address < 8) {
+		custom_instrument_[address] = value;
+
+		// Update all channels that refer to instrument 0.
+		for(int c = 0; c < 9; ++c) {
+			if(!channels_[c].instrument) {
+				install_instrument(c);
 			}
+		}
 
-			return;
+		return;
+	}
+
+	// Register 0xe enables or disables rhythm mode and contains the
+	// percussion key-on bits.
+	if(address == 0xe) {
+		const bool old_rhythm_mode = rhythm_mode_enabled_;
+		rhythm_mode_enabled_ = value & 0x20;
+		if(old_rhythm_mode != rhythm_mode_enabled_) {
+			// Change the instlled instruments for channels 6, 7 and 8
+			// if this was a transition into or out of rhythm mode.
+			install_instrument(6);
+			install_instrument(7);
+			install_instrument(8);
 		}
+		rhythm_envelope_generators_[HighHat].set_key_on(value & 0x01);
+		rhythm_envelope_generators_[Cymbal].set_key_on(value & 0x02);
+		rhythm_envelope_generators_[TomTom].set_key_on(value & 0x04);
+		rhythm_envelope_generators_[Snare].set_key_on(value & 0x08);
+		if(value & 0x10) {
+			rhythm_envelope_generators_[BassCarrier].set_key_on(true);
+		} else {
+			rhythm_envelope_generators_[BassCarrier].set_key_on(false);
+			rhythm_envelope_generators_[BassModulator].set_key_on(false);
 
-		// Register 0xe enables or disables rhythm mode and contains the
-		// percussion key-on bits.
-		if(address == 0xe) {
-			const bool old_rhythm_mode = rhythm_mode_enabled_;
-			rhythm_mode_enabled_ = value & 0x20;
-			if(old_rhythm_mode != rhythm_mode_enabled_) {
-				// Change the instlled instruments for channels 6, 7 and 8
-				// if this was a transition into or out of rhythm mode.
-				install_instrument(6);
-				install_instrument(7);
-				install_instrument(8);
-			}
-			rhythm_envelope_generators_[HighHat].set_key_on(value & 0x01);
-			rhythm_envelope_generators_[Cymbal].set_key_on(value & 0x02);
-			rhythm_envelope_generators_[TomTom].set_key_on(value & 0x04);
-			rhythm_envelope_generators_[Snare].set_key_on(value & 0x08);
+		}
+		return;
+	}
+
+	// That leaves only per-channel selections, for which the addressing
+	// is completely orthogonal; check that a valid channel is being requested.
+	const auto index = address & 0xf;
+	if(index > 8) return;
+
+	switch(address & 0xf0) {
+		default: break;
+
+		// Address 1x sets the low 8 bits of the period for channel x.
+		case 0x10:
+			channels_[index].period = (channels_[index].period & ~0xff) | value;
+			set_channel_period(index);
+		return;
+
+		// Address 2x Sets the octave and a single bit of the frequency, as well
+		// as setting key on and sustain mode.
+		case 0x20:
+			channels_[index].period = (channels_[index].period & 0xff) | ((value & 1) << 8);
+			channels_[index].octave = (value >> 1) & 7;
+			set_channel_period(index);
+
+			// In this implementation the first 9 envelope generators are for
+			// channel carriers, and their will_attack callback is used to trigger
+			// key-on for modulators. But key-off needs to be set to both envelope
+			// generators now.
 			if(value & 0x10) {
-				rhythm_envelope_generators_[BassCarrier].set_key_on(true);
+				envelope_generators_[index].set_key_on(true);
 			} else {
-				rhythm_envelope_generators_[BassCarrier].set_key_on(false);
-				rhythm_envelope_generators_[BassModulator].set_key_on(false);
-
+				envelope_generators_[index + 0].set_key_on(false);
+				envelope_generators_[index + 9].set_key_on(false);
 			}
-			return;
-		}
 
-		// That leaves only per-channel selections, for which the addressing
-		// is completely orthogonal; check that a valid channel is being requested.
-		const auto index = address & 0xf;
-		if(index > 8) return;
-
-		switch(address & 0xf0) {
-			default: break;
-
-			// Address 1x sets the low 8 bits of the period for channel x.
-			case 0x10:
-				channels_[index].period = (channels_[index].period & ~0xff) | value;
-				set_channel_period(index);
-			return;
-
-			// Address 2x Sets the octave and a single bit of the frequency, as well
-			// as setting key on and sustain mode.
-			case 0x20:
-				channels_[index].period = (channels_[index].period & 0xff) | ((value & 1) << 8);
-				channels_[index].octave = (value >> 1) & 7;
-				set_channel_period(index);
-
-				// In this implementation the first 9 envelope generators are for
-				// channel carriers, and their will_attack callback is used to trigger
-				// key-on for modulators. But key-off needs to be set to both envelope
-				// generators now.
-				if(value & 0x10) {
-					envelope_generators_[index].set_key_on(true);
-				} else {
-					envelope_generators_[index + 0].set_key_on(false);
-					envelope_generators_[index + 9].set_key_on(false);
+			// Set sustain bit to both the relevant operators.
+			channels_[index].use_sustain = value & 0x20;
+			set_use_sustain(index);
+		return;
+
+		// Address 3x selects the instrument and attenuation for a channel;
+		// in rhythm mode some of the nibbles that ordinarily identify instruments
+		// instead nominate additional attenuations. This code reads those back
+		// from the stored instrument values.
+		case 0x30:
+			channels_[index].attenuation = value & 0xf;
+
+			// Install an instrument only if it's new.
+			if(channels_[index].instrument != value >> 4) {
+				channels_[index].instrument = value >> 4;
+				if(index < 6 || !rhythm_mode_enabled_) {
+					install_instrument(index);
 				}
+			}
+		return;
+	}
+}
 
-				// Set sustain bit to both the relevant operators.
-				channels_[index].use_sustain = value & 0x20;
-				set_use_sustain(index);
-			return;
-
-			// Address 3x selects the instrument and attenuation for a channel;
-			// in rhythm mode some of the nibbles that ordinarily identify instruments
-			// instead nominate additional attenuations. This code reads those back
-			// from the stored instrument values.
-			case 0x30:
-				channels_[index].attenuation = value & 0xf;
-
-				// Install an instrument only if it's new.
-				if(channels_[index].instrument != value >> 4) {
-					channels_[index].instrument = value >> 4;
-					if(index < 6 || !rhythm_mode_enabled_) {
-						install_instrument(index);
-					}
-				}
-			return;
-		}
-	});
+void OPLL::write_register(uint8_t address, uint8_t value) {
+	// The OPLL doesn't have timers or other non-audio functions, so all writes
+	// are logged for the audio thread.
+	audio_log_.write(address, value);
 }
 
 void OPLL::set_channel_period(int channel) {
@@ -199,11 +201,11 @@ const uint8_t *OPLL::instrument_definition(int instrument, int channel) {
 
 void OPLL::install_instrument(int channel) {
 	auto &carrier_envelope = envelope_generators_[channel + 0];
-	auto &carrier_phase = phase_generators_[channel + 0];
+	auto carrier_phase = phase_generators_[channel + 0];
 	auto &carrier_scaler = key_level_scalers_[channel + 0];
 
 	auto &modulator_envelope = envelope_generators_[channel + 9];
-	auto &modulator_phase = phase_generators_[channel + 9];
+	auto modulator_phase = phase_generators_[channel + 9];
 	auto &modulator_scaler = key_level_scalers_[channel + 9];
 
 	const uint8_t *const instrument = instrument_definition(channels_[channel].instrument, channel);
@@ -299,9 +301,7 @@ void OPLL::update_all_channels() {
 	oscillator_.update();
 
 	// Update all phase generators. That's guaranteed.
-	for(int c = 0; c < 18; ++c) {
-		phase_generators_[c].update(oscillator_);
-	}
+	phase_generators_.update(oscillator_);
 
 	// Update the ADSR envelopes that are guaranteed to be melodic.
 	for(int c = 0; c < 6; ++c) {
@@ -10,6 +10,7 @@
 #define OPLL_hpp
 
 #include "Implementation/OPLBase.hpp"
+#include "../../Outputs/Speaker/Implementation/RegisterWriteLog.hpp"
 #include "Implementation/EnvelopeGenerator.hpp"
 #include "Implementation/KeyLevelScaler.hpp"
 #include "Implementation/PhaseGenerator.hpp"
@@ -41,6 +42,10 @@ class OPLL: public OPLBase<OPLL> {
 		friend OPLBase<OPLL>;
 		void write_register(uint8_t address, uint8_t value);
 
+		friend ::Outputs::Speaker::RegisterWriteLog<OPLL>;
+		::Outputs::Speaker::RegisterWriteLog<OPLL> audio_log_;
+		void apply_register_write(uint16_t address, uint8_t value);
+
 		int audio_divider_ = 0;
 		int audio_offset_ = 0;
 		std::atomic<int> total_volume_;
@@ -65,7 +70,7 @@ class OPLL: public OPLBase<OPLL> {
 		//		[x], 0 <= x < 9		= carrier for channel x;
 		//		[x+9]				= modulator for channel x.
 		//
-		PhaseGenerator<period_precision> phase_generators_[18];
+		PhaseGeneratorBank<period_precision, 18> phase_generators_;
 		EnvelopeGenerator<envelope_precision, period_precision> envelope_generators_[18];
 		KeyLevelScaler<period_precision> key_level_scalers_[18];
 
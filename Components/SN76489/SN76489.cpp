@@ -8,12 +8,13 @@
 
 #include "SN76489.hpp"
 
+#include <algorithm>
 #include <cassert>
 #include <cmath>
 
 using namespace TI;
 
-SN76489::SN76489(Personality personality, Concurrency::DeferringAsyncTaskQueue &task_queue, int additional_divider) : task_queue_(task_queue) {
+SN76489::SN76489(Personality personality, Concurrency::DeferringAsyncTaskQueue &task_queue, int additional_divider) : audio_log_(task_queue, *this) {
 	set_sample_volume_range(0);
 
 	switch(personality) {
@@ -48,42 +49,44 @@ void SN76489::set_sample_volume_range(std::int16_t range) {
 	evaluate_output_volume();
 }
 
-void SN76489::write(uint8_t value) {
-	task_queue_.defer([value, this] () {
-		if(value & 0x80) {
-			active_register_ = value;
-		}
+void SN76489::apply_register_write(uint16_t, uint8_t value) {
+	if(value & 0x80) {
+		active_register_ = value;
+	}
 
-		const int channel = (active_register_ >> 5)&3;
-		if(active_register_ & 0x10) {
-			// latch for volume
-			channels_[channel].volume = value & 0xf;
-			evaluate_output_volume();
+	const int channel = (active_register_ >> 5)&3;
+	if(active_register_ & 0x10) {
+		// latch for volume
+		channels_[channel].volume = value & 0xf;
+		evaluate_output_volume();
+	} else {
+		// latch for tone/data
+		if(channel < 3) {
+			if(value & 0x80) {
+				channels_[channel].divider = (channels_[channel].divider & ~0xf) | (value & 0xf);
+			} else {
+				channels_[channel].divider = uint16_t((channels_[channel].divider & 0xf) | ((value & 0x3f) << 4));
+			}
 		} else {
-			// latch for tone/data
-			if(channel < 3) {
-				if(value & 0x80) {
-					channels_[channel].divider = (channels_[channel].divider & ~0xf) | (value & 0xf);
-				} else {
-					channels_[channel].divider = uint16_t((channels_[channel].divider & 0xf) | ((value & 0x3f) << 4));
-				}
+			// writes to the noise register always reset the shifter
+			noise_shifter_ = shifter_is_16bit_ ? 0x8000 : 0x4000;
+
+			if(value & 4) {
+				noise_mode_ = shifter_is_16bit_ ? Noise16 : Noise15;
 			} else {
-				// writes to the noise register always reset the shifter
-				noise_shifter_ = shifter_is_16bit_ ? 0x8000 : 0x4000;
-
-				if(value & 4) {
-					noise_mode_ = shifter_is_16bit_ ? Noise16 : Noise15;
-				} else {
-					noise_mode_ = shifter_is_16bit_ ? Periodic16 : Periodic15;
-				}
-
-				channels_[3].divider = uint16_t(0x10 << (value & 3));
-				// Special case: if these bits are both set, the noise channel should track channel 2,
-				// which is marked with a divider of 0xffff.
-				if(channels_[3].divider == 0x80) channels_[3].divider = 0xffff;
+				noise_mode_ = shifter_is_16bit_ ? Periodic16 : Periodic15;
 			}
+
+			channels_[3].divider = uint16_t(0x10 << (value & 3));
+			// Special case: if these bits are both set, the noise channel should track channel 2,
+			// which is marked with a divider of 0xffff.
+			if(channels_[3].divider == 0x80) channels_[3].divider = 0xffff;
 		}
-	});
+	}
+}
+
+void SN76489::write(uint8_t value) {
+	audio_log_.write(0, value);
 }
 
 bool SN76489::is_zero_level() const {
@@ -108,6 +111,25 @@ void SN76489::get_samples(std::size_t number_of_samples, std::int16_t *target) {
 	}
 
 	while(c < number_of_samples) {
+		// Output can change only upon a counter expiry; if none is imminent then just decrement
+		// all counters and output the current volume for as many whole steps as possible.
+		int quiet_steps = std::min({channels_[0].counter, channels_[1].counter, channels_[2].counter});
+		if(channels_[3].divider != 0xffff) quiet_steps = std::min(quiet_steps, int(channels_[3].counter));
+		const std::size_t bulk_steps = std::min(std::size_t(quiet_steps), (number_of_samples - c) / std::size_t(master_divider_period_));
+		if(bulk_steps) {
+			const auto steps = uint16_t(bulk_steps);
+			channels_[0].counter -= steps;
+			channels_[1].counter -= steps;
+			channels_[2].counter -= steps;
+			if(channels_[3].divider != 0xffff) channels_[3].counter -= steps;
+
+			const std::size_t samples = bulk_steps * std::size_t(master_divider_period_);
+			std::fill_n(&target[c], samples, output_volume_);
+			c += samples;
+			master_divider_ += int(samples);
+			continue;
+		}
+
 		bool did_flip = false;
 
 #define step_channel(x, s) \
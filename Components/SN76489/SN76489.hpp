@@ -10,6 +10,7 @@
 #define SN76489_hpp
 
 #include "../../Outputs/Speaker/Implementation/SampleSource.hpp"
+#include "../../Outputs/Speaker/Implementation/RegisterWriteLog.hpp"
 #include "../../Concurrency/AsyncTaskQueue.hpp"
 
 namespace TI {
@@ -41,7 +42,9 @@ class SN76489: public Outputs::Speaker::SampleSource {
 		void evaluate_output_volume();
 		int volumes_[16];
 
-		Concurrency::DeferringAsyncTaskQueue &task_queue_;
+		friend ::Outputs::Speaker::RegisterWriteLog<SN76489>;
+		::Outputs::Speaker::RegisterWriteLog<SN76489> audio_log_;
+		void apply_register_write(uint16_t, uint8_t value);
 
 		struct ToneChannel {
 			// Programmatically-set state; updated by the processor.
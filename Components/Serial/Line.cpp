@@ -8,6 +8,8 @@
 
 #include "Line.hpp"
 
+#include <cstddef>
+
 using namespace Serial;
 
 void Line::set_writer_clock_rate(HalfCycles clock_rate) {
@@ -17,9 +19,9 @@ void Line::set_writer_clock_rate(HalfCycles clock_rate) {
 void Line::advance_writer(HalfCycles cycles) {
 	if(cycles == HalfCycles(0)) return;
 
-	const auto integral_cycles = cycles.as_integral();
+	auto integral_cycles = cycles.as_integral();
 	remaining_delays_ = std::max(remaining_delays_ - integral_cycles, Cycles::IntType(0));
-	if(events_.empty()) {
+	if(next_event_ == events_.size()) {
 		write_cycles_since_delegate_call_ += integral_cycles;
 		if(transmission_extra_) {
 			transmission_extra_ -= integral_cycles;
@@ -29,18 +31,20 @@ void Line::advance_writer(HalfCycles cycles) {
 			}
 		}
 	} else {
-		while(!events_.empty()) {
-			if(events_.front().delay <= integral_cycles) {
-				cycles -= events_.front().delay;
-				write_cycles_since_delegate_call_ += events_.front().delay;
+		// Events are consumed by advancing next_event_ rather than by erasure;
+		// the consumed prefix is discarded upon the next enqueue.
+		while(next_event_ != events_.size()) {
+			auto &event = events_[next_event_];
+			if(event.delay <= integral_cycles) {
+				integral_cycles -= event.delay;
+				write_cycles_since_delegate_call_ += event.delay;
 				const auto old_level = level_;
 
-				auto iterator = events_.begin() + 1;
-				while(iterator != events_.end() && iterator->type != Event::Delay) {
-					level_ = iterator->type == Event::SetHigh;
-					++iterator;
+				++next_event_;
+				while(next_event_ != events_.size() && events_[next_event_].type != Event::Delay) {
+					level_ = events_[next_event_].type == Event::SetHigh;
+					++next_event_;
 				}
-				events_.erase(events_.begin(), iterator);
 
 				if(old_level != level_) {
 					update_delegate(old_level);
@@ -48,11 +52,14 @@ void Line::advance_writer(HalfCycles cycles) {
 
 				// Book enough extra time for the read delegate to be posted
 				// the final bit if one is attached.
-				if(events_.empty()) {
+				if(next_event_ == events_.size()) {
+					events_.clear();
+					next_event_ = 0;
 					transmission_extra_ = minimum_write_cycles_for_read_delegate_bit();
+					break;
 				}
 			} else {
-				events_.front().delay -= integral_cycles;
+				event.delay -= integral_cycles;
 				write_cycles_since_delegate_call_ += integral_cycles;
 				break;
 			}
@@ -61,9 +68,8 @@ void Line::advance_writer(HalfCycles cycles) {
 }
 
 void Line::write(bool level) {
-	if(!events_.empty()) {
-		events_.emplace_back();
-		events_.back().type = level ? Event::SetHigh : Event::SetLow;
+	if(next_event_ != events_.size()) {
+		events_.push_back({level ? Event::SetHigh : Event::SetLow, 0});
 	} else {
 		level_ = level;
 		transmission_extra_ = minimum_write_cycles_for_read_delegate_bit();
@@ -73,20 +79,41 @@ void Line::write(bool level) {
 void Line::write(HalfCycles cycles, int count, int levels) {
 	remaining_delays_ += count * cycles.as_integral();
 
-	auto event = events_.size();
-	events_.resize(events_.size() + size_t(count)*2);
+	if(next_event_) {
+		events_.erase(events_.begin(), events_.begin() + std::ptrdiff_t(next_event_));
+		next_event_ = 0;
+	}
+
+	// A bit that doesn't change the level just extends the delay before the next change;
+	// trailing delays are permitted so that the total duration is preserved.
+	bool level = queued_level();
+	const int delay = int(cycles.as_integral());
 	while(count--) {
-		events_[event].type = Event::Delay;
-		events_[event].delay = int(cycles.as_integral());
-		events_[event+1].type = (levels&1) ? Event::SetHigh : Event::SetLow;
+		if(events_.empty() || events_.back().type != Event::Delay) {
+			events_.push_back({Event::Delay, 0});
+		}
+		events_.back().delay += delay;
+
+		const bool bit = levels & 1;
 		levels >>= 1;
-		event += 2;
+		if(bit != level) {
+			events_.push_back({bit ? Event::SetHigh : Event::SetLow, 0});
+			level = bit;
+		}
 	}
 }
 
+bool Line::queued_level() const {
+	for(auto event = events_.rbegin(); event != events_.rend() - std::ptrdiff_t(next_event_); ++event) {
+		if(event->type != Event::Delay) return event->type == Event::SetHigh;
+	}
+	return level_;
+}
+
 void Line::reset_writing() {
 	remaining_delays_ = 0;
 	events_.clear();
+	next_event_ = 0;
 }
 
 bool Line::read() const {
@@ -42,6 +42,9 @@ class Line {
 		/// is scheduled after the final output. The levels to output are
 		/// taken from @c levels which is read from lsb to msb. @c cycles is
 		/// relative to the writer's clock rate.
+		///
+		/// Runs of identical levels are stored as a single event, so e.g. idle stop
+		/// bits cost nothing further as time advances.
 		void write(HalfCycles cycles, int count, int levels);
 
 		/// @returns the number of cycles until currently enqueued write data is exhausted.
@@ -83,6 +86,7 @@ class Line {
 			int delay;
 		};
 		std::vector<Event> events_;
+		size_t next_event_ = 0;
 		HalfCycles::IntType remaining_delays_ = 0;
 		HalfCycles::IntType transmission_extra_ = 0;
 		bool level_ = true;
@@ -97,6 +101,7 @@ class Line {
 		} read_delegate_phase_ = ReadDelegatePhase::WaitingForZero;
 
 		void update_delegate(bool level);
+		bool queued_level() const;
 		HalfCycles::IntType minimum_write_cycles_for_read_delegate_bit();
 };
 
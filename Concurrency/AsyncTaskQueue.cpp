@@ -8,38 +8,26 @@
 
 #include "AsyncTaskQueue.hpp"
 
+#ifndef USE_GCD
+#include "ThreadPool.hpp"
+#endif
+
 using namespace Concurrency;
 
-AsyncTaskQueue::AsyncTaskQueue()
+AsyncTaskQueue::AsyncTaskQueue([[maybe_unused]] Producers producers)
 #ifndef USE_GCD
-	: should_destruct_(false)
+	: producers_(producers)
 #endif
 {
 #ifdef USE_GCD
 	serial_dispatch_queue_ = dispatch_queue_create("com.thomasharte.clocksignal.asyntaskqueue", DISPATCH_QUEUE_SERIAL);
 #else
-	thread_ = std::make_unique<std::thread>([this]() {
-		while(!should_destruct_) {
-			std::function<void(void)> next_function;
-
-			// Take lock, check for a new task
-			std::unique_lock lock(queue_mutex_);
-			if(!pending_tasks_.empty()) {
-				next_function = pending_tasks_.front();
-				pending_tasks_.pop_front();
-			}
-
-			if(next_function) {
-				// If there is a task, release lock and perform it
-				lock.unlock();
-				next_function();
-			} else {
-				// If there isn't a task, atomically block on the processing condition and release the lock
-				// until there's something pending (and then release it again via scope)
-				processing_condition_.wait(lock);
-			}
-		}
-	});
+	if(producers_ == Producers::Single) {
+		ring_.resize(256);
+		consumer_thread_ = std::make_unique<std::thread>([this] {
+			run_consumer();
+		});
+	}
 #endif
 }
 
@@ -49,10 +37,22 @@ AsyncTaskQueue::~AsyncTaskQueue() {
 	dispatch_release(serial_dispatch_queue_);
 	serial_dispatch_queue_ = nullptr;
 #else
-	should_destruct_ = true;
-	enqueue([](){});
-	thread_->join();
-	thread_.reset();
+	if(producers_ == Producers::Single) {
+		// The consumer will perform everything that is currently pending before
+		// checking for the request to quit.
+		{
+			std::lock_guard lock(queue_mutex_);
+			should_quit_ = true;
+		}
+		idle_condition_.notify_all();
+		consumer_thread_->join();
+		return;
+	}
+
+	// Wait until all pending functions have been performed and the drain task
+	// has finished touching this queue.
+	std::unique_lock lock(queue_mutex_);
+	idle_condition_.wait(lock, [this] { return !is_scheduled_; });
 #endif
 }
 
@@ -60,12 +60,94 @@ void AsyncTaskQueue::enqueue(std::function<void(void)> function) {
 #ifdef USE_GCD
 	dispatch_async(serial_dispatch_queue_, ^{function();});
 #else
+	if(producers_ == Producers::Single) {
+		// Wait for space if necessary, then post.
+		const size_t write = ring_write_.load(std::memory_order_relaxed);
+		while(write - ring_read_.load(std::memory_order_acquire) == ring_.size()) {
+			std::this_thread::yield();
+		}
+		ring_[write & (ring_.size() - 1)] = std::move(function);
+		ring_write_.store(write + 1);
+
+		// Wake the consumer only if it is definitely asleep; both this test and the
+		// store above are sequentially consistent, as are the consumer's counterparts.
+		if(consumer_is_sleeping_) {
+			std::lock_guard lock(queue_mutex_);
+			idle_condition_.notify_all();
+		}
+		return;
+	}
+
 	std::lock_guard lock(queue_mutex_);
-	pending_tasks_.push_back(function);
-	processing_condition_.notify_all();
+	pending_tasks_.push_back(std::move(function));
+
+	if(!is_scheduled_) {
+		is_scheduled_ = true;
+		ThreadPool::shared().submit([this] {
+			drain();
+		});
+	}
 #endif
 }
 
+#ifndef USE_GCD
+void AsyncTaskQueue::run_consumer() {
+	constexpr int spin_count = 64;
+
+	while(true) {
+		// Perform the next task if there is one.
+		const size_t read = ring_read_.load(std::memory_order_relaxed);
+		if(read != ring_write_.load(std::memory_order_acquire)) {
+			auto &function = ring_[read & (ring_.size() - 1)];
+			function();
+			function = nullptr;
+			ring_read_.store(read + 1, std::memory_order_release);
+			continue;
+		}
+		if(should_quit_) return;
+
+		// Spin briefly in case another task is imminent.
+		bool did_find_task = false;
+		for(int c = 0; c < spin_count; c++) {
+			if(read != ring_write_.load(std::memory_order_acquire)) {
+				did_find_task = true;
+				break;
+			}
+			std::this_thread::yield();
+		}
+		if(did_find_task) continue;
+
+		// Sleep until there's something to do.
+		std::unique_lock lock(queue_mutex_);
+		consumer_is_sleeping_ = true;
+		idle_condition_.wait(lock, [this, read] {
+			return read != ring_write_ || should_quit_;
+		});
+		consumer_is_sleeping_ = false;
+	}
+}
+
+void AsyncTaskQueue::drain() {
+	std::unique_lock lock(queue_mutex_);
+	while(!pending_tasks_.empty()) {
+		// Take all currently-pending tasks and perform them with the lock released,
+		// so that further tasks can be enqueued in the meantime.
+		std::swap(pending_tasks_, performing_tasks_);
+		lock.unlock();
+
+		for(const auto &function: performing_tasks_) {
+			function();
+		}
+		performing_tasks_.clear();
+
+		lock.lock();
+	}
+
+	is_scheduled_ = false;
+	idle_condition_.notify_all();
+}
+#endif
+
 void AsyncTaskQueue::flush() {
 #ifdef USE_GCD
 	dispatch_sync(serial_dispatch_queue_, ^{});
@@ -81,25 +163,34 @@ void AsyncTaskQueue::flush() {
 #endif
 }
 
+DeferringAsyncTaskQueue::DeferringAsyncTaskQueue(Producers producers) : AsyncTaskQueue(producers), deferred_tasks_(1024) {}
+
 DeferringAsyncTaskQueue::~DeferringAsyncTaskQueue() {
 	perform();
 	flush();
 }
 
-void DeferringAsyncTaskQueue::defer(std::function<void(void)> function) {
-	if(!deferred_tasks_) {
-		deferred_tasks_ = std::make_shared<std::list<std::function<void(void)>>>();
-	}
-	deferred_tasks_->push_back(function);
-}
-
 void DeferringAsyncTaskQueue::perform() {
-	if(!deferred_tasks_) return;
-	std::shared_ptr<std::list<std::function<void(void)>>> deferred_tasks = deferred_tasks_;
-	deferred_tasks_.reset();
-	enqueue([deferred_tasks] {
-		for(const auto &function : *deferred_tasks) {
-			function();
-		}
+	if(write_index_ == performable_index_.load(std::memory_order_relaxed)) return;
+	performable_index_.store(write_index_, std::memory_order_release);
+	++modification_count_;
+	enqueue([this] {
+		perform_deferred();
 	});
 }
+
+void DeferringAsyncTaskQueue::perform_deferred() {
+	// This might find nothing to do if a previous call already performed everything
+	// that was made performable before this call was enqueued.
+	const size_t end = performable_index_.load(std::memory_order_acquire);
+	size_t index = read_index_.load(std::memory_order_relaxed);
+
+	while(index != end) {
+		auto &task = deferred_tasks_[index & (deferred_tasks_.size() - 1)];
+		task();
+		task.reset();
+
+		++index;
+		read_index_.store(index, std::memory_order_release);
+	}
+}
@@ -9,12 +9,15 @@
 #ifndef AsyncTaskQueue_hpp
 #define AsyncTaskQueue_hpp
 
+#include "InlineTask.hpp"
+
 #include <atomic>
 #include <condition_variable>
 #include <functional>
-#include <list>
 #include <memory>
+#include <mutex>
 #include <thread>
+#include <vector>
 
 #if defined(__APPLE__) && !defined(IGNORE_APPLE)
 #include <dispatch/dispatch.h>
@@ -27,17 +30,34 @@ namespace Concurrency {
 	An async task queue allows a caller to enqueue void(void) functions. Those functions are guaranteed
 	to be performed serially and asynchronously from the caller. A caller may also request to flush,
 	causing it to block until all previously-enqueued functions are complete.
+
+	Other than where GCD is available:
+
+	* by default each queue is a strand on the shared ThreadPool: no thread is dedicated to any one
+	queue, and functions may be performed on any of the pool's threads, but never more than one at
+	a time per queue; or
+	* if constructed for a single producer, the queue has its own thread which is fed through a
+	lock-free ring buffer, and which briefly spins before sleeping when idle; the producer touches
+	a mutex only if the queue's thread is actually asleep.
 */
 class AsyncTaskQueue {
 	public:
-		AsyncTaskQueue();
+		enum class Producers {
+			/// Any number of threads may enqueue.
+			Multiple,
+			/// Only one thread will ever enqueue or flush, providing
+			/// the option of lower-latency handoff.
+			Single
+		};
+
+		AsyncTaskQueue(Producers producers = Producers::Multiple);
 		virtual ~AsyncTaskQueue();
 
 		/*!
 			Adds @c function to the queue.
 
 			@discussion Functions will be performed serially and asynchronously. This method is safe to
-			call from multiple threads.
+			call from multiple threads unless this queue was created for a single producer.
 			@parameter function The function to enqueue.
 		*/
 		void enqueue(std::function<void(void)> function);
@@ -51,12 +71,29 @@ class AsyncTaskQueue {
 #ifdef USE_GCD
 		dispatch_queue_t serial_dispatch_queue_;
 #else
-		std::unique_ptr<std::thread> thread_;
-
 		std::mutex queue_mutex_;
-		std::list<std::function<void(void)>> pending_tasks_;
-		std::condition_variable processing_condition_;
-		std::atomic_bool should_destruct_;
+
+		// Tasks are enqueued to pending_tasks_; the drain task swaps that for performing_tasks_
+		// before performing them so that, once both have grown to a sufficient capacity, neither
+		// enqueuing nor performing requires any further allocation.
+		std::vector<std::function<void(void)>> pending_tasks_, performing_tasks_;
+
+		// Indicates whether a task to drain pending_tasks_ is currently
+		// submitted to or running on the pool.
+		bool is_scheduled_ = false;
+		std::condition_variable idle_condition_;
+
+		void drain();
+
+		// Single-producer storage; the ring buffer is allocated only if required.
+		const Producers producers_;
+		std::vector<std::function<void(void)>> ring_;
+		std::atomic<size_t> ring_read_ = 0, ring_write_ = 0;
+		std::atomic_bool consumer_is_sleeping_ = false;
+		std::atomic_bool should_quit_ = false;
+		std::unique_ptr<std::thread> consumer_thread_;
+
+		void run_consumer();
 #endif
 };
 
@@ -67,9 +104,20 @@ class AsyncTaskQueue {
 
 	It therefore offers similar semantics to an asynchronous task queue, but allows for management of
 	synchronisation costs, since neither defer nor perform make any effort to be thread safe.
+
+	Deferred functions are held in a fixed-size ring buffer of InlineTasks, so neither deferral nor
+	performance allocates; if the ring buffer fills then defer will wait until older functions have
+	been performed.
+
+	Like any other queue, a deferring queue is by default a strand on the shared ThreadPool. Since deferral
+	and performance are already required to be serialised, it may instead be constructed for a single
+	producer, at the cost of a thread of its own.
 */
 class DeferringAsyncTaskQueue: public AsyncTaskQueue {
 	public:
+		using Task = InlineTask<>;
+
+		DeferringAsyncTaskQueue(Producers producers = Producers::Multiple);
 		~DeferringAsyncTaskQueue();
 
 		/*!
@@ -77,7 +125,16 @@ class DeferringAsyncTaskQueue: public AsyncTaskQueue {
 
 			This is not thread safe; it should be serialised with other calls to itself and to perform.
 		*/
-		void defer(std::function<void(void)> function);
+		template <typename Function> void defer(Function &&function) {
+			if(write_index_ - read_index_.load(std::memory_order_acquire) == deferred_tasks_.size()) {
+				perform();
+				flush();
+			}
+
+			deferred_tasks_[write_index_ & (deferred_tasks_.size() - 1)] = std::forward<Function>(function);
+			++write_index_;
+			++modification_count_;
+		}
 
 		/*!
 			Enqueues a function that will perform all currently deferred functions, in the
@@ -87,10 +144,28 @@ class DeferringAsyncTaskQueue: public AsyncTaskQueue {
 		*/
 		void perform();
 
+		/*!
+			@returns A count that changes whenever a function is deferred or deferred functions are made
+				performable; a caller that has just deferred a function may amend the state that function
+				will consume for as long as this is unchanged.
+		*/
+		size_t get_modification_count() const {
+			return modification_count_;
+		}
+
 	private:
-		// TODO: this is a shared_ptr because of the issues capturing moveables in C++11;
-		// switch to a unique_ptr if/when adapting to C++14
-		std::shared_ptr<std::list<std::function<void(void)>>> deferred_tasks_;
+		// Deferred tasks are written by defer at write_index_; perform publishes all tasks
+		// up to its current value via performable_index_, and tasks are performed
+		// and then reset asynchronously, with read_index_ being updated as they go.
+		//
+		// All indices increase monotonically and are mapped into deferred_tasks_ by masking.
+		std::vector<Task> deferred_tasks_;
+		size_t write_index_ = 0;
+		size_t modification_count_ = 0;
+		std::atomic<size_t> performable_index_ = 0;
+		std::atomic<size_t> read_index_ = 0;
+
+		void perform_deferred();
 };
 
 }
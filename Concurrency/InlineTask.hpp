@@ -0,0 +1,103 @@
+//
+//  InlineTask.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 14/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#ifndef InlineTask_hpp
+#define InlineTask_hpp
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace Concurrency {
+
+/*!
+	An inline task is a move-only equivalent of std::function<void(void)> that stores its
+	callable within itself, and therefore never allocates.
+
+	Any callable of up to @c capacity bytes can be stored; attempting to store anything larger is
+	a compile-time error. Most lambdas that capture only a pointer and a couple of values will
+	fit comfortably within the default.
+*/
+template <size_t capacity = 48> class InlineTask {
+	public:
+		InlineTask() noexcept = default;
+
+		template <typename Function, typename = std::enable_if_t<!std::is_same_v<std::decay_t<Function>, InlineTask>>>
+		InlineTask(Function &&function) {
+			using StoredFunction = std::decay_t<Function>;
+			static_assert(sizeof(StoredFunction) <= capacity, "Callable is too large for this InlineTask");
+			static_assert(alignof(StoredFunction) <= alignof(std::max_align_t), "Callable is over-aligned for an InlineTask");
+
+			new (&storage_) StoredFunction(std::forward<Function>(function));
+			perform_ = [](void *storage) {
+				(*static_cast<StoredFunction *>(storage))();
+			};
+			manage_ = [](void *target, void *source) {
+				if(source) {
+					new (target) StoredFunction(std::move(*static_cast<StoredFunction *>(source)));
+				}
+				static_cast<StoredFunction *>(source ? source : target)->~StoredFunction();
+			};
+		}
+
+		InlineTask(InlineTask &&rhs) noexcept {
+			*this = std::move(rhs);
+		}
+
+		InlineTask &operator =(InlineTask &&rhs) noexcept {
+			if(this != &rhs) {
+				reset();
+				if(rhs.perform_) {
+					rhs.manage_(&storage_, &rhs.storage_);
+					perform_ = rhs.perform_;
+					manage_ = rhs.manage_;
+					rhs.perform_ = nullptr;
+					rhs.manage_ = nullptr;
+				}
+			}
+			return *this;
+		}
+
+		InlineTask(const InlineTask &) = delete;
+		InlineTask &operator =(const InlineTask &) = delete;
+
+		~InlineTask() {
+			reset();
+		}
+
+		/// Performs the stored callable, if any.
+		void operator()() {
+			if(perform_) perform_(&storage_);
+		}
+
+		/// Destroys the stored callable, if any.
+		void reset() {
+			if(manage_) manage_(&storage_, nullptr);
+			perform_ = nullptr;
+			manage_ = nullptr;
+		}
+
+		/// @returns @c true if this task currently holds a callable; @c false otherwise.
+		explicit operator bool() const {
+			return perform_ != nullptr;
+		}
+
+	private:
+		std::aligned_storage_t<capacity, alignof(std::max_align_t)> storage_;
+
+		void (*perform_)(void *) = nullptr;
+
+		// If source is non-null, moves from source to target and then destroys source;
+		// otherwise destroys target.
+		void (*manage_)(void *target, void *source) = nullptr;
+};
+
+}
+
+#endif /* InlineTask_hpp */
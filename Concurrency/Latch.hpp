@@ -0,0 +1,60 @@
+//
+//  Latch.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 14/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#ifndef Latch_hpp
+#define Latch_hpp
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+
+namespace Concurrency {
+
+/*!
+	A single-use countdown, in the manner of C++20's std::latch: threads call @c count_down
+	as they complete their work, and @c wait returns once the count has reached zero.
+
+	Waiting spins briefly before sleeping, as joins are often imminent. It is safe to
+	destroy a latch as soon as @c wait has returned.
+*/
+class Latch {
+	public:
+		Latch(size_t count) : count_(count) {}
+
+		/// Decrements the count, releasing any waiters if it reaches zero.
+		void count_down() {
+			std::lock_guard lock(mutex_);
+			if(count_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+				condition_.notify_all();
+			}
+		}
+
+		/// Blocks until the count has reached zero.
+		void wait() {
+			constexpr int spin_count = 64;
+			for(int c = 0; c < spin_count && count_.load(std::memory_order_acquire); c++) {
+				std::this_thread::yield();
+			}
+
+			// Always acquire the mutex, even if the count has already been seen to be zero, so that
+			// the final count_down is guaranteed to have finished with this latch.
+			std::unique_lock lock(mutex_);
+			condition_.wait(lock, [this] { return !count_.load(std::memory_order_acquire); });
+		}
+
+	private:
+		std::atomic<size_t> count_;
+		std::mutex mutex_;
+		std::condition_variable condition_;
+};
+
+}
+
+#endif /* Latch_hpp */
@@ -0,0 +1,121 @@
+//
+//  ThreadPool.cpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 14/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#include "ThreadPool.hpp"
+
+#include <algorithm>
+
+using namespace Concurrency;
+
+namespace {
+
+/// Identifies the pool and worker index of the current thread, if it is a worker.
+thread_local const ThreadPool *current_pool = nullptr;
+thread_local size_t current_worker = 0;
+
+}
+
+ThreadPool::ThreadPool(size_t thread_count) {
+	if(!thread_count) {
+		thread_count = std::max(1u, std::thread::hardware_concurrency());
+	}
+
+	for(size_t c = 0; c < thread_count; c++) {
+		workers_.push_back(std::make_unique<Worker>());
+	}
+	for(size_t c = 0; c < thread_count; c++) {
+		threads_.emplace_back([this, c] {
+			run_worker(c);
+		});
+	}
+}
+
+ThreadPool::~ThreadPool() {
+	{
+		std::lock_guard lock(sleep_mutex_);
+		should_quit_ = true;
+	}
+	sleep_condition_.notify_all();
+
+	for(auto &thread: threads_) {
+		thread.join();
+	}
+}
+
+ThreadPool &ThreadPool::shared() {
+	static ThreadPool pool;
+	return pool;
+}
+
+void ThreadPool::submit(std::function<void(void)> &&function) {
+	// Tasks posted from within this pool go to the current worker's own list, otherwise
+	// they're distributed round robin.
+	const size_t worker =
+		current_pool == this ?
+			current_worker : next_worker_.fetch_add(1, std::memory_order_relaxed) % workers_.size();
+
+	++pending_tasks_;
+	{
+		std::lock_guard lock(workers_[worker]->mutex);
+		workers_[worker]->tasks.push_back(std::move(function));
+	}
+
+	// Take and release the sleep mutex to ensure that no worker can be between
+	// testing pending_tasks_ and beginning to wait.
+	{
+		std::lock_guard lock(sleep_mutex_);
+	}
+	sleep_condition_.notify_one();
+}
+
+bool ThreadPool::pop_task(size_t worker, std::function<void(void)> &target) {
+	// Check this worker's own list first, taking from the front.
+	{
+		auto &own = *workers_[worker];
+		std::lock_guard lock(own.mutex);
+		if(!own.tasks.empty()) {
+			target = std::move(own.tasks.front());
+			own.tasks.pop_front();
+			return true;
+		}
+	}
+
+	// Otherwise attempt to steal from the back of somebody else's.
+	for(size_t offset = 1; offset < workers_.size(); offset++) {
+		auto &victim = *workers_[(worker + offset) % workers_.size()];
+		std::lock_guard lock(victim.mutex);
+		if(!victim.tasks.empty()) {
+			target = std::move(victim.tasks.back());
+			victim.tasks.pop_back();
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void ThreadPool::run_worker(size_t worker) {
+	current_pool = this;
+	current_worker = worker;
+
+	std::function<void(void)> task;
+	while(true) {
+		if(pop_task(worker, task)) {
+			--pending_tasks_;
+			task();
+			task = nullptr;
+			continue;
+		}
+
+		std::unique_lock lock(sleep_mutex_);
+		sleep_condition_.wait(lock, [this] {
+			return should_quit_ || pending_tasks_ > 0;
+		});
+		if(should_quit_) return;
+	}
+}
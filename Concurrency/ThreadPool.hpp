@@ -0,0 +1,74 @@
+//
+//  ThreadPool.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 14/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#ifndef ThreadPool_hpp
+#define ThreadPool_hpp
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Concurrency {
+
+/*!
+	A thread pool maintains a fixed number of worker threads, each with its own list of pending tasks.
+	Idle workers steal from the lists of others.
+
+	No guarantees are offered as to the order in which tasks are performed, or on which thread they
+	will be performed. For serial execution, see AsyncTaskQueue, which on platforms without GCD is
+	implemented as a strand on the shared pool.
+
+	Tasks should not block waiting for the completion of other tasks in the same pool.
+*/
+class ThreadPool {
+	public:
+		/*!
+			Constructs a pool with @c thread_count workers; if @c thread_count is zero then one worker
+			is created per hardware thread.
+		*/
+		ThreadPool(size_t thread_count = 0);
+		~ThreadPool();
+
+		/*!
+			Adds @c function to the pool, to be performed at some point in the future on one of the workers.
+
+			This method is safe to call from multiple threads, including from within tasks.
+		*/
+		void submit(std::function<void(void)> &&function);
+
+		/// @returns A pool that is shared by everything in the process that doesn't need its own.
+		static ThreadPool &shared();
+
+	private:
+		struct Worker {
+			std::mutex mutex;
+			std::deque<std::function<void(void)>> tasks;
+		};
+		std::vector<std::unique_ptr<Worker>> workers_;
+		std::vector<std::thread> threads_;
+
+		std::atomic<size_t> next_worker_ = 0;
+		std::atomic<size_t> pending_tasks_ = 0;
+		std::atomic_bool should_quit_ = false;
+
+		std::mutex sleep_mutex_;
+		std::condition_variable sleep_condition_;
+
+		bool pop_task(size_t worker, std::function<void(void)> &target);
+		void run_worker(size_t worker);
+};
+
+}
+
+#endif /* ThreadPool_hpp */
@@ -20,6 +20,23 @@ ReflectableEnum(Display,
 	CompositeMonochrome
 );
 
+/*!
+	Describes how much accuracy may be traded for speed.
+
+	CycleExact permits no shortcuts. Fast permits shortcuts that preserve all timing visible
+	to software, such as bypassing flux-level decoding for intact disk sectors while still
+	waiting for them to come around. Turbo additionally permits shortcuts that alter timing,
+	such as delivering those sectors immediately and at an accelerated rate.
+
+	Shortcuts are abandoned in favour of the exact path whenever they can't be applied safely,
+	e.g. for copy-protected or damaged media.
+*/
+ReflectableEnum(Accuracy,
+	CycleExact,
+	Fast,
+	Turbo
+);
+
 //===
 // From here downward are a bunch of templates for individual option flags.
 // Using them saves you marginally in syntax, but the primary gain is to
@@ -49,6 +66,18 @@ template <typename Owner> class QuickloadOption {
 		}
 };
 
+template <typename Owner> class AccuracyOption {
+	public:
+		Configurable::Accuracy accuracy;
+		AccuracyOption(Configurable::Accuracy accuracy) : accuracy(accuracy) {}
+
+	protected:
+		void declare_accuracy_option() {
+			static_cast<Owner *>(this)->declare(&accuracy, "accuracy");
+			AnnounceEnumNS(Configurable, Accuracy);
+		}
+};
+
 template <typename Owner> class QuickbootOption {
 	public:
 		bool quickboot;
@@ -0,0 +1,216 @@
+//
+//  InputQueue.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 14/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#ifndef InputQueue_hpp
+#define InputQueue_hpp
+
+#include "Joystick.hpp"
+#include "Keyboard.hpp"
+#include "../ClockReceiver/TimeTypes.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+namespace Inputs {
+
+/*!
+	A single keyboard, joystick or mouse input, stamped with the host time at which it was received.
+*/
+struct InputEvent {
+	enum class Type: uint8_t {
+		/// @c key was pressed or released, with the printed symbol @c symbol if known; if @c is_logical then it should be
+		/// mapped as per KeyboardMachine::apply_key. If the keyboard doesn't consume it and @c has_fallback is set then
+		/// @c input is instead applied to joystick @c joystick.
+		Key,
+		/// All keys have been released.
+		ResetKeys,
+		/// @c input on joystick @c joystick is now @c is_pressed.
+		JoystickDigital,
+		/// @c input on joystick @c joystick now has analogue value @c value.
+		JoystickAnalogue,
+		/// The mouse has moved by (@c x, @c y).
+		MouseMotion,
+		/// Mouse button @c button is now @c is_pressed.
+		MouseButton,
+	};
+	Type type = Type::ResetKeys;
+	Time::Nanos timestamp = 0;
+
+	bool is_pressed = false;
+
+	Keyboard::Key key = Keyboard::Key::Space;
+	char symbol = 0;
+	bool is_logical = false;
+	bool has_fallback = false;
+
+	size_t joystick = 0;
+	Joystick::Input::Type input_type = Joystick::Input::Type::Fire;
+	size_t input_info = 0;
+	float value = 0.0f;
+
+	int x = 0, y = 0;
+	int button = 0;
+
+	static InputEvent key_event(Keyboard::Key key, char symbol, bool is_pressed, bool is_logical = false) {
+		InputEvent event(Type::Key);
+		event.key = key;
+		event.symbol = symbol;
+		event.is_pressed = is_pressed;
+		event.is_logical = is_logical;
+		return event;
+	}
+
+	static InputEvent reset_keys_event() {
+		return InputEvent(Type::ResetKeys);
+	}
+
+	static InputEvent joystick_event(size_t joystick, const Joystick::Input &input, bool is_pressed) {
+		InputEvent event(Type::JoystickDigital);
+		event.set_input(joystick, input);
+		event.is_pressed = is_pressed;
+		return event;
+	}
+
+	static InputEvent joystick_event(size_t joystick, const Joystick::Input &input, float value) {
+		InputEvent event(Type::JoystickAnalogue);
+		event.set_input(joystick, input);
+		event.value = value;
+		return event;
+	}
+
+	static InputEvent mouse_motion_event(int x, int y) {
+		InputEvent event(Type::MouseMotion);
+		event.x = x;
+		event.y = y;
+		return event;
+	}
+
+	static InputEvent mouse_button_event(int button, bool is_pressed) {
+		InputEvent event(Type::MouseButton);
+		event.button = button;
+		event.is_pressed = is_pressed;
+		return event;
+	}
+
+	/// Sets, on a key event, the joystick input to apply if the keyboard doesn't consume the key.
+	InputEvent &with_fallback(size_t joystick, const Joystick::Input &input) {
+		set_input(joystick, input);
+		has_fallback = true;
+		return *this;
+	}
+
+	/// @returns The joystick input this event describes.
+	Joystick::Input joystick_input() const {
+		if(input_type == Joystick::Input::Type::Key) return Joystick::Input(wchar_t(input_info));
+		return Joystick::Input(input_type, input_info);
+	}
+
+	InputEvent() {}
+
+	private:
+		InputEvent(Type type) : type(type) {}
+
+		// Joystick::Input has a const member and therefore can't be stored in something assignable; keep its parts instead.
+		void set_input(size_t joystick, const Joystick::Input &input) {
+			this->joystick = joystick;
+			input_type = input.type;
+			input_info = input.type == Joystick::Input::Type::Key ? size_t(input.info.key.symbol) : input.info.control.index;
+		}
+};
+
+/*!
+	Carries input from any number of UI threads to the thread that runs a machine, without locking.
+
+	Producers @c push events as they arrive, which never blocks; the emulation thread @c drain s them at
+	the start of each slice or, using their timestamps, at the precise emulated moments they correspond to.
+	Only one thread may drain at a time — e.g. only while holding the machine's lock.
+
+	The queue is bounded. If @c push fails because the queue is full, which should occur only if the
+	emulation thread has stalled, the producer should wait for exclusive access to the machine, drain
+	the queue itself and then apply its event directly, in order to preserve ordering.
+*/
+class InputQueue {
+	public:
+		static constexpr size_t Capacity = 1024;
+
+		InputQueue() {
+			for(size_t c = 0; c < Capacity; c++) {
+				cells_[c].sequence.store(c, std::memory_order_relaxed);
+			}
+		}
+
+		/// Stamps @c event with the current time and enqueues it. @returns @c true on success; @c false if the queue is full.
+		bool push(InputEvent event) {
+			event.timestamp = Time::nanos_now();
+
+			// Claim a cell, as per Dmitry Vyukov's bounded queue: a cell is free for position p
+			// if its sequence number is p, and holds a value for position p once it is p+1.
+			size_t position = enqueue_position_.load(std::memory_order_relaxed);
+			Cell *cell;
+			while(true) {
+				cell = &cells_[position & (Capacity - 1)];
+				const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+				const auto difference = intptr_t(sequence) - intptr_t(position);
+
+				if(!difference) {
+					if(enqueue_position_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) break;
+				} else if(difference < 0) {
+					return false;
+				} else {
+					position = enqueue_position_.load(std::memory_order_relaxed);
+				}
+			}
+
+			cell->event = event;
+			cell->sequence.store(position + 1, std::memory_order_release);
+			return true;
+		}
+
+		/*!
+			Removes, in order, each event stamped no later than @c until and passes it to @c apply.
+			Stops early at any event that a producer is still in the process of pushing.
+		*/
+		template <typename FunctionT> void drain(Time::Nanos until, FunctionT &&apply) {
+			while(true) {
+				Cell &cell = cells_[dequeue_position_ & (Capacity - 1)];
+				if(cell.sequence.load(std::memory_order_acquire) != dequeue_position_ + 1) return;
+				if(cell.event.timestamp > until) return;
+
+				const InputEvent event = cell.event;
+				cell.sequence.store(dequeue_position_ + Capacity, std::memory_order_release);
+				++dequeue_position_;
+
+				apply(event);
+			}
+		}
+
+		/// Removes every event now in the queue, passing each to @c apply.
+		template <typename FunctionT> void drain(FunctionT &&apply) {
+			drain(std::numeric_limits<Time::Nanos>::max(), apply);
+		}
+
+	private:
+		static_assert(!(Capacity & (Capacity - 1)), "Capacity must be a power of two");
+
+		struct Cell {
+			std::atomic<size_t> sequence;
+			InputEvent event;
+		};
+		std::array<Cell, Capacity> cells_;
+
+		// Producers contend for the enqueue position; keep it away from the consumer's.
+		alignas(64) std::atomic<size_t> enqueue_position_{0};
+		alignas(64) size_t dequeue_position_ = 0;
+};
+
+}
+
+#endif /* InputQueue_hpp */
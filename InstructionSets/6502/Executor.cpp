@@ -0,0 +1,705 @@
+//
+//  Executor.cpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 14/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#include "Executor.hpp"
+
+#include "../../Processors/6502/State/State.hpp"
+
+#include <utility>
+
+using namespace InstructionSet;
+using namespace InstructionSet::MOS6502;
+
+namespace {
+
+using Flag = CPU::MOS6502Esque::Flag;
+
+/*!
+	@returns The number of cycles that @c instruction takes, excluding any additional cycles for crossing a page
+	while indexing or for taking a branch. These follow CPU::MOS6502::Processor, including for its NOPs.
+*/
+constexpr int base_cycles(Instruction instruction) {
+	const auto mode = instruction.addressing_mode;
+
+	switch(access_type(instruction.operation)) {
+		case AccessType::None:
+			switch(instruction.operation) {
+				case Operation::BRK:	return 7;
+				case Operation::JSR:	case Operation::RTI:	case Operation::RTS:	return 6;
+				case Operation::JMP:	return mode == AddressingMode::Absolute ? 3 : 5;
+				case Operation::PHA:	case Operation::PHP:	return 3;
+				case Operation::PLA:	case Operation::PLP:	return 4;
+				default:				return 2;
+			}
+
+		case AccessType::Read:
+			if(instruction.operation == Operation::NOP) {
+				switch(mode) {
+					case AddressingMode::ZeroPage:		case AddressingMode::Absolute:	return 3;
+					case AddressingMode::ZeroPageX:		case AddressingMode::AbsoluteX:	return 4;
+					default:															return 2;
+				}
+			}
+			switch(mode) {
+				case AddressingMode::ZeroPage:		return 3;
+				case AddressingMode::XIndirect:		return 6;
+				case AddressingMode::IndirectY:		return 5;
+				case AddressingMode::Immediate:		return 2;
+				default:							return 4;
+			}
+
+		case AccessType::ReadModifyWrite:
+			switch(mode) {
+				case AddressingMode::Accumulator:	return 2;
+				case AddressingMode::ZeroPage:		return 5;
+				case AddressingMode::ZeroPageX:
+				case AddressingMode::Absolute:		return 6;
+				case AddressingMode::AbsoluteX:
+				case AddressingMode::AbsoluteY:		return 7;
+				default:							return 8;
+			}
+
+		default:
+			switch(mode) {
+				case AddressingMode::ZeroPage:		return 3;
+				case AddressingMode::ZeroPageX:
+				case AddressingMode::ZeroPageY:
+				case AddressingMode::Absolute:		return 4;
+				case AddressingMode::AbsoluteX:
+				case AddressingMode::AbsoluteY:		return 5;
+				default:							return 6;
+			}
+	}
+}
+
+}
+
+Executor::Executor(uint8_t *memory, BusHandler &bus_handler, bool has_decimal_mode) :
+	memory_(memory), bus_handler_(bus_handler), has_decimal_mode_(has_decimal_mode) {
+	install_performers(std::make_index_sequence<256>());
+	performers_[TrapPerformer] = &Executor::perform_trap;
+	reset();
+}
+
+template <size_t... opcodes> void Executor::install_performers(std::index_sequence<opcodes...>) {
+	((performers_[opcodes] = &Executor::perform<uint8_t(opcodes)>), ...);
+}
+
+// MARK: - Host interface.
+
+void Executor::run_for(Cycles cycles) {
+	if(is_jammed_) return;
+
+	if(did_modify_code_) {
+		did_modify_code_ = false;
+		resynchronise();
+	}
+
+	// Interrupts are otherwise accepted only upon branches, so check for one now in case
+	// the code being run doesn't branch for a while.
+	if(interrupt_is_pending()) {
+		perform_interrupt();
+	}
+
+	CachingExecutor::run_for(cycles.as<int>());
+}
+
+void Executor::reset() {
+	// The reset sequence performs three stack reads, in place of the pushes of an interrupt.
+	s_ = uint8_t(s_ - 3);
+	flags_.inverse_interrupt = 0;
+	is_jammed_ = false;
+	nmi_pending_ = false;
+	subtract_duration(7);
+
+	program_counter_ = uint16_t(read(0xfffc) | (read(0xfffd) << 8));
+	did_set_program_counter_ = true;
+	resynchronise();
+}
+
+void Executor::memory_did_change(uint16_t begin, uint16_t end) {
+	// Resynchronise only upon the next instruction boundary, as this may be a trap handler,
+	// or someone else acting in the middle of an instruction.
+	invalidate_code(begin, end);
+	did_modify_code_ = true;
+}
+
+void Executor::add_trap_address(uint16_t address) {
+	traps_[address] = true;
+	memory_did_change(address, address);
+}
+
+void Executor::set_is_io_page(uint8_t page, bool is_io) {
+	io_pages_[page] = is_io;
+}
+
+void Executor::set_irq_line(bool value) {
+	irq_line_ = value;
+}
+
+void Executor::set_nmi_line(bool value) {
+	// NMIs are edge triggered.
+	if(value && !nmi_line_) {
+		nmi_pending_ = true;
+	}
+	nmi_line_ = value;
+}
+
+void Executor::set_overflow_line(bool value) {
+	// A leading edge sets the overflow flag.
+	if(value && !overflow_line_) {
+		flags_.overflow = Flag::Overflow;
+	}
+	overflow_line_ = value;
+}
+
+uint16_t Executor::get_value_of_register(CPU::MOS6502Esque::Register reg) const {
+	using Register = CPU::MOS6502Esque::Register;
+	switch(reg) {
+		// A jammed 6502 has fetched, but not completed, the JAM.
+		case Register::ProgramCounter:			return uint16_t(program_counter_ + (is_jammed_ ? 1 : 0));
+		case Register::LastOperationAddress:	return last_operation_pc_;
+		case Register::StackPointer:			return s_;
+		case Register::Flags:					return flags_.get();
+		case Register::A:						return a_;
+		case Register::X:						return x_;
+		case Register::Y:						return y_;
+		default: 								return 0;
+	}
+}
+
+void Executor::set_value_of_register(CPU::MOS6502Esque::Register reg, uint16_t value) {
+	using Register = CPU::MOS6502Esque::Register;
+	switch(reg) {
+		case Register::ProgramCounter:
+			program_counter_ = value;
+			did_set_program_counter_ = true;
+			resynchronise();
+		break;
+		case Register::StackPointer:	s_ = uint8_t(value);			break;
+		case Register::Flags:			flags_.set(uint8_t(value));		break;
+		case Register::A:				a_ = uint8_t(value);			break;
+		case Register::X:				x_ = uint8_t(value);			break;
+		case Register::Y:				y_ = uint8_t(value);			break;
+		default: break;
+	}
+}
+
+void Executor::get_state(CPU::MOS6502::State &state) const {
+	using Phase = CPU::MOS6502::State::ExecutionState::Phase;
+
+	state.registers.program_counter = get_value_of_register(CPU::MOS6502Esque::Register::ProgramCounter);
+	state.registers.stack_pointer = s_;
+	state.registers.flags = flags_.get();
+	state.registers.a = a_;
+	state.registers.x = x_;
+	state.registers.y = y_;
+
+	state.inputs.ready = false;
+	state.inputs.irq = irq_line_;
+	state.inputs.nmi = nmi_line_;
+	state.inputs.reset = false;
+
+	auto &execution_state = state.execution_state;
+	execution_state.operation = memory_[program_counter_];
+	execution_state.operand = 0;
+	execution_state.address = 0;
+	execution_state.next_address = 0;
+	if(is_jammed_) {
+		// The processor loops indefinitely through the program for its preferred JAM opcode.
+		execution_state.phase = Phase::Jammed;
+		execution_state.micro_program = 0xf2;
+	} else {
+		// The program for the implied NOP, 0xea, consists only of the transition to the next
+		// instruction; being at its start therefore means that an instruction has just completed.
+		execution_state.phase = Phase::Instruction;
+		execution_state.micro_program = 0xea;
+	}
+	execution_state.micro_program_offset = 0;
+}
+
+void Executor::set_state(const CPU::MOS6502::State &state) {
+	a_ = state.registers.a;
+	x_ = state.registers.x;
+	y_ = state.registers.y;
+	s_ = state.registers.stack_pointer;
+	flags_.set(state.registers.flags);
+
+	irq_line_ = state.inputs.irq;
+	nmi_line_ = state.inputs.nmi;
+	nmi_pending_ = false;
+
+	// Both a jammed processor and one that has just fetched an opcode have incremented
+	// the program counter beyond it.
+	program_counter_ = uint16_t(state.registers.program_counter - 1);
+	is_jammed_ = state.execution_state.phase == CPU::MOS6502::State::ExecutionState::Phase::Jammed;
+
+	// The processor has already spent the opcode fetch cycle, so credit that to the executor.
+	subtract_duration(remaining_duration() - 1);
+
+	did_set_program_counter_ = true;
+	resynchronise();
+}
+
+// MARK: - Flow control.
+
+void Executor::branch(uint16_t address) {
+	// Any code modification is dealt with by the new translation lookup implied by moving the program counter.
+	did_modify_code_ = false;
+
+	program_counter_ = address;
+	if(interrupt_is_pending()) {
+		perform_interrupt();
+		return;
+	}
+	set_program_counter(address);
+}
+
+void Executor::perform_interrupt_sequence(uint16_t vector, uint8_t flags) {
+	push(uint8_t(program_counter_ >> 8));
+	push(uint8_t(program_counter_));
+	push(flags);
+	flags_.inverse_interrupt = 0;
+	subtract_duration(7);
+
+	set_program_counter(uint16_t(read(vector) | (read(uint16_t(vector + 1)) << 8)));
+	did_modify_code_ = false;
+}
+
+void Executor::perform_interrupt() {
+	if(nmi_pending_) {
+		nmi_pending_ = false;
+		perform_interrupt_sequence(0xfffa, flags_.get());
+		return;
+	}
+	perform_interrupt_sequence(0xfffe, flags_.get());
+}
+
+void Executor::perform_trap() {
+	did_set_program_counter_ = false;
+	bus_handler_.did_reach_trap(program_counter_);
+	if(did_set_program_counter_) return;
+
+	(this->*performers_[memory_[program_counter_]])();
+}
+
+void Executor::perform_jam() {
+	// A jammed 6502 does nothing further until reset, so consume all remaining time and
+	// end the current translated run; run_for will decline to resume it.
+	is_jammed_ = true;
+	subtract_duration(remaining_duration());
+	set_program_counter(program_counter_);
+}
+
+// MARK: - Memory access.
+
+void Executor::invalidate_code(uint16_t begin, uint16_t end) {
+	CachingExecutor::invalidate(begin, end);
+
+	// Clear the code marks for all pages now dropped, other than the first couple of bytes of
+	// the first, which may belong to an instruction that began on the page before it and which
+	// has therefore not been dropped. Marks are only a hint, so any left over do no harm.
+	const int first_page = (begin > 2 ? begin - 2 : 0) >> page_shift;
+	const int last_page = end >> page_shift;
+	const int first = first_page ? (first_page << page_shift) + 2 : 0;
+	const int last = (last_page << page_shift) + int(page_size) - 1;
+	for(int address = first; address <= last; address++) {
+		code_[size_t(address)] = false;
+	}
+}
+
+void Executor::write(uint16_t address, uint8_t value) {
+	if(io_pages_[address >> 8]) {
+		bus_handler_.write(address, value);
+		return;
+	}
+
+	memory_[address] = value;
+	if(code_[address]) {
+		invalidate_code(address, address);
+		did_modify_code_ = true;
+	}
+}
+
+void Executor::push(uint8_t value) {
+	write(uint16_t(0x100 | s_), value);
+	--s_;
+}
+
+uint8_t Executor::pull() {
+	++s_;
+	return memory_[0x100 | s_];
+}
+
+template <AddressingMode mode> uint16_t Executor::address(bool &page_crossed) const {
+	const auto indexed = [&page_crossed] (uint16_t base, uint8_t index) {
+		const uint16_t result = uint16_t(base + index);
+		page_crossed = (result ^ base) & 0xff00;
+		return result;
+	};
+
+	switch(mode) {
+		case AddressingMode::ZeroPage:		return operand(1);
+		case AddressingMode::ZeroPageX:		return uint8_t(operand(1) + x_);
+		case AddressingMode::ZeroPageY:		return uint8_t(operand(1) + y_);
+		case AddressingMode::Absolute:		return operand16(1);
+		case AddressingMode::AbsoluteX:		return indexed(operand16(1), x_);
+		case AddressingMode::AbsoluteY:		return indexed(operand16(1), y_);
+		case AddressingMode::XIndirect:		return read_zero_page_pointer(uint8_t(operand(1) + x_));
+		case AddressingMode::IndirectY:		return indexed(read_zero_page_pointer(operand(1)), y_);
+		default:							return 0;
+	}
+}
+
+// MARK: - Arithmetic.
+
+void Executor::perform_adc(uint8_t value) {
+	if(has_decimal_mode_ && flags_.decimal) {
+		// As per CPU::MOS6502::Processor: N and V reflect the intermediate result, Z the binary one.
+		const uint16_t decimal_result = uint16_t(a_ + value + flags_.carry);
+
+		uint8_t low_nibble = uint8_t((a_ & 0xf) + (value & 0xf) + flags_.carry);
+		if(low_nibble >= 0xa) low_nibble = uint8_t(((low_nibble + 0x6) & 0xf) + 0x10);
+		uint16_t result = uint16_t((a_ & 0xf0) + (value & 0xf0) + low_nibble);
+		flags_.negative_result = uint8_t(result);
+		flags_.overflow = (((result ^ a_) & (result ^ value)) & 0x80) >> 1;
+		if(result >= 0xa0) result += 0x60;
+
+		flags_.carry = (result >> 8) ? 1 : 0;
+		a_ = uint8_t(result);
+		flags_.zero_result = uint8_t(decimal_result);
+		return;
+	}
+
+	const uint16_t result = uint16_t(a_ + value + flags_.carry);
+	flags_.overflow = (((result ^ a_) & (result ^ value)) & 0x80) >> 1;
+	flags_.set_nz(a_ = uint8_t(result));
+	flags_.carry = (result >> 8) & 1;
+}
+
+void Executor::perform_sbc(uint8_t value) {
+	if(has_decimal_mode_ && flags_.decimal) {
+		const uint16_t not_carry = flags_.carry ^ 0x1;
+		const uint16_t decimal_result = uint16_t(a_ - value - not_carry);
+
+		uint16_t result = uint16_t((a_ & 0xf) - (value & 0xf) - not_carry);
+		if(result > 0xf) result -= 0x6;
+		result = uint16_t((result & 0x0f) | ((result > 0x0f) ? 0xfff0 : 0x00));
+		result = uint16_t(result + (a_ & 0xf0) - (value & 0xf0));
+
+		flags_.overflow = (((decimal_result ^ a_) & (~decimal_result ^ value)) & 0x80) >> 1;
+		flags_.negative_result = uint8_t(result);
+		flags_.zero_result = uint8_t(decimal_result);
+
+		if(result > 0xff) result -= 0x60;
+
+		flags_.carry = (result > 0xff) ? 0 : Flag::Carry;
+		a_ = uint8_t(result);
+		return;
+	}
+
+	// Binary subtraction is addition of the complement.
+	const auto complement = uint8_t(~value);
+	const uint16_t result = uint16_t(a_ + complement + flags_.carry);
+	flags_.overflow = (((result ^ a_) & (result ^ complement)) & 0x80) >> 1;
+	flags_.set_nz(a_ = uint8_t(result));
+	flags_.carry = (result >> 8) & 1;
+}
+
+void Executor::perform_compare(uint8_t reg, uint8_t value) {
+	const uint16_t difference = uint16_t(reg - value);
+	flags_.set_nz(uint8_t(difference));
+	flags_.carry = ((~difference) >> 8) & 1;
+}
+
+// MARK: - Performers.
+
+template <uint8_t opcode> void Executor::perform() {
+	constexpr Instruction instruction = decode(opcode);
+	constexpr auto operation = instruction.operation;
+	constexpr auto mode = instruction.addressing_mode;
+	constexpr int length = instruction.length();
+	constexpr int cycles = base_cycles(instruction);
+
+	last_operation_pc_ = program_counter_;
+
+	if constexpr (operation == Operation::JAM) {
+		perform_jam();
+	} else if constexpr (mode == AddressingMode::Relative) {
+		perform_branch<operation>();
+	} else if constexpr (access_type(operation) == AccessType::None) {
+		perform_implied<operation>();
+	} else if constexpr (mode == AddressingMode::Implied) {
+		// i.e. the single-byte NOPs.
+		advance(length, cycles);
+	} else if constexpr (mode == AddressingMode::Accumulator) {
+		a_ = perform_read_modify_write<operation>(a_);
+		advance(length, cycles);
+	} else if constexpr (mode == AddressingMode::Immediate) {
+		perform_read<operation>(operand(1));
+		advance(length, cycles);
+	} else {
+		bool page_crossed = false;
+		const uint16_t target = address<mode>(page_crossed);
+
+		if constexpr (operation == Operation::NOP) {
+			// The zero-page NOPs read their operand, but the zero page can't be IO, so that has no effect.
+			advance(length, cycles);
+		} else if constexpr (access_type(operation) == AccessType::Read) {
+			perform_read<operation>(read(target));
+			advance(length, cycles + (page_crossed ? 1 : 0));
+		} else if constexpr (access_type(operation) == AccessType::ReadModifyWrite) {
+			write(target, perform_read_modify_write<operation>(read(target)));
+			advance(length, cycles);
+		} else {
+			write(target, value_to_write<operation>(target));
+			advance(length, cycles);
+		}
+	}
+}
+
+template <Operation operation> void Executor::perform_branch() {
+	bool condition;
+	switch(operation) {
+		case Operation::BPL:	condition = !(flags_.negative_result & 0x80);	break;
+		case Operation::BMI:	condition = flags_.negative_result & 0x80;		break;
+		case Operation::BVC:	condition = !flags_.overflow;					break;
+		case Operation::BVS:	condition = flags_.overflow;					break;
+		case Operation::BCC:	condition = !flags_.carry;						break;
+		case Operation::BCS:	condition = flags_.carry;						break;
+		case Operation::BNE:	condition = flags_.zero_result;					break;
+		default:				condition = !flags_.zero_result;				break;
+	}
+
+	if(!condition) {
+		advance(2, 2);
+		return;
+	}
+
+	const auto next = uint16_t(program_counter_ + 2);
+	const auto target = uint16_t(next + int8_t(operand(1)));
+	subtract_duration(((next ^ target) & 0xff00) ? 4 : 3);
+	branch(target);
+}
+
+template <Operation operation> void Executor::perform_implied() {
+	constexpr int cycles = base_cycles(Instruction(operation, AddressingMode::Implied, 0));
+
+	switch(operation) {
+		case Operation::BRK: {
+			// As on the NMOS 6502, an NMI that is pending at this point takes over the BRK.
+			program_counter_ += 2;
+			const uint16_t vector = nmi_pending_ ? 0xfffa : 0xfffe;
+			nmi_pending_ = false;
+			perform_interrupt_sequence(vector, flags_.get() | Flag::Break);
+		} return;
+
+		case Operation::JSR: {
+			const uint16_t return_address = uint16_t(program_counter_ + 2);
+			push(uint8_t(return_address >> 8));
+			push(uint8_t(return_address));
+			subtract_duration(6);
+			branch(operand16(1));
+		} return;
+
+		case Operation::RTS: {
+			const uint8_t low = pull();
+			const uint8_t high = pull();
+			subtract_duration(6);
+			branch(uint16_t((low | (high << 8)) + 1));
+		} return;
+
+		case Operation::RTI: {
+			flags_.set(pull());
+			const uint8_t low = pull();
+			const uint8_t high = pull();
+			subtract_duration(6);
+			branch(uint16_t(low | (high << 8)));
+		} return;
+
+		case Operation::JMP: {
+			const uint16_t target = operand16(1);
+			if(memory_[program_counter_] == 0x4c) {
+				subtract_duration(3);
+				branch(target);
+			} else {
+				// The NMOS 6502 doesn't carry into the high byte when fetching the second byte of the vector.
+				const uint16_t high_address = uint16_t((target & 0xff00) | uint8_t(target + 1));
+				subtract_duration(5);
+				branch(uint16_t(read(target) | (read(high_address) << 8)));
+			}
+		} return;
+
+		case Operation::PHA:	push(a_);								break;
+		case Operation::PHP:	push(flags_.get() | Flag::Break);		break;
+		case Operation::PLA:	flags_.set_nz(a_ = pull());				break;
+		case Operation::PLP:	flags_.set(pull());						break;
+
+		case Operation::CLC:	flags_.carry = 0;							break;
+		case Operation::CLD:	flags_.decimal = 0;							break;
+		case Operation::CLI:	flags_.inverse_interrupt = Flag::Interrupt;	break;
+		case Operation::CLV:	flags_.overflow = 0;						break;
+		case Operation::SEC:	flags_.carry = Flag::Carry;					break;
+		case Operation::SED:	flags_.decimal = Flag::Decimal;				break;
+		case Operation::SEI:	flags_.inverse_interrupt = 0;				break;
+
+		case Operation::INX:	flags_.set_nz(++x_);	break;
+		case Operation::INY:	flags_.set_nz(++y_);	break;
+		case Operation::DEX:	flags_.set_nz(--x_);	break;
+		case Operation::DEY:	flags_.set_nz(--y_);	break;
+
+		case Operation::TAX:	flags_.set_nz(x_ = a_);	break;
+		case Operation::TAY:	flags_.set_nz(y_ = a_);	break;
+		case Operation::TSX:	flags_.set_nz(x_ = s_);	break;
+		case Operation::TXA:	flags_.set_nz(a_ = x_);	break;
+		case Operation::TXS:	s_ = x_;				break;
+		case Operation::TYA:	flags_.set_nz(a_ = y_);	break;
+
+		default: break;
+	}
+
+	advance(1, cycles);
+}
+
+template <Operation operation> void Executor::perform_read(uint8_t value) {
+	switch(operation) {
+		case Operation::ADC:	perform_adc(value);		break;
+		case Operation::SBC:	perform_sbc(value);		break;
+
+		case Operation::AND:	flags_.set_nz(a_ &= value);	break;
+		case Operation::ORA:	flags_.set_nz(a_ |= value);	break;
+		case Operation::EOR:	flags_.set_nz(a_ ^= value);	break;
+
+		case Operation::BIT:
+			flags_.zero_result = value & a_;
+			flags_.negative_result = value;
+			flags_.overflow = value & Flag::Overflow;
+		break;
+
+		case Operation::CMP:	perform_compare(a_, value);	break;
+		case Operation::CPX:	perform_compare(x_, value);	break;
+		case Operation::CPY:	perform_compare(y_, value);	break;
+
+		case Operation::LDA:	flags_.set_nz(a_ = value);			break;
+		case Operation::LDX:	flags_.set_nz(x_ = value);			break;
+		case Operation::LDY:	flags_.set_nz(y_ = value);			break;
+		case Operation::LAX:	flags_.set_nz(a_ = x_ = value);		break;
+
+		case Operation::ANC:
+			flags_.set_nz(a_ &= value);
+			flags_.carry = a_ >> 7;
+		break;
+
+		case Operation::ASR:
+			a_ &= value;
+			flags_.carry = a_ & 1;
+			flags_.set_nz(a_ >>= 1);
+		break;
+
+		case Operation::ARR:
+			// As per CPU::MOS6502::Processor, this observes the decimal flag even on processors without decimal mode.
+			a_ &= value;
+			if(flags_.decimal) {
+				const uint8_t unshifted_a = a_;
+				a_ = uint8_t((a_ >> 1) | (flags_.carry << 7));
+				flags_.set_nz(a_);
+				flags_.overflow = (a_ ^ (a_ << 1)) & Flag::Overflow;
+
+				if((unshifted_a & 0xf) + (unshifted_a & 0x1) > 5) a_ = ((a_ + 6) & 0xf) | (a_ & 0xf0);
+
+				flags_.carry = ((unshifted_a & 0xf0) + (unshifted_a & 0x10) > 0x50) ? 1 : 0;
+				if(flags_.carry) a_ += 0x60;
+			} else {
+				a_ = uint8_t((a_ >> 1) | (flags_.carry << 7));
+				flags_.set_nz(a_);
+				flags_.carry = (a_ >> 6) & 1;
+				flags_.overflow = (a_ ^ (a_ << 1)) & Flag::Overflow;
+			}
+		break;
+
+		case Operation::SBX: {
+			x_ &= a_;
+			const uint16_t difference = uint16_t(x_ - value);
+			flags_.set_nz(x_ = uint8_t(difference));
+			flags_.carry = ((difference >> 8) & 1) ^ 1;
+		} break;
+
+		case Operation::ANE:	flags_.set_nz(a_ = (a_ | 0xee) & value & x_);			break;
+		case Operation::LXA:	flags_.set_nz(a_ = x_ = (a_ | 0xee) & value);			break;
+		case Operation::LAS:	flags_.set_nz(a_ = x_ = s_ = s_ & value);				break;
+
+		default: break;
+	}
+}
+
+template <Operation operation> uint8_t Executor::perform_read_modify_write(uint8_t value) {
+	switch(operation) {
+		case Operation::ASL:
+		case Operation::ASO:
+			flags_.carry = value >> 7;
+			value = uint8_t(value << 1);
+		break;
+
+		case Operation::LSR:
+		case Operation::LSE:
+			flags_.carry = value & 1;
+			value >>= 1;
+		break;
+
+		case Operation::ROL:
+		case Operation::RLA: {
+			const uint8_t result = uint8_t((value << 1) | flags_.carry);
+			flags_.carry = value >> 7;
+			value = result;
+		} break;
+
+		case Operation::ROR:
+		case Operation::RRA: {
+			const uint8_t result = uint8_t((value >> 1) | (flags_.carry << 7));
+			flags_.carry = value & 1;
+			value = result;
+		} break;
+
+		case Operation::DEC:	case Operation::DCP:	--value;	break;
+		case Operation::INC:	case Operation::INS:	++value;	break;
+
+		default: break;
+	}
+
+	switch(operation) {
+		case Operation::ASO:	flags_.set_nz(a_ |= value);		break;
+		case Operation::LSE:	flags_.set_nz(a_ ^= value);		break;
+		case Operation::RLA:	flags_.set_nz(a_ &= value);		break;
+		case Operation::RRA:	perform_adc(value);				break;
+		case Operation::DCP:	perform_compare(a_, value);		break;
+		case Operation::INS:	perform_sbc(value);				break;
+		default:				flags_.set_nz(value);			break;
+	}
+
+	return value;
+}
+
+template <Operation operation> uint8_t Executor::value_to_write(uint16_t address) {
+	// As per CPU::MOS6502::Processor, the SH- group of operations AND with one more than the high byte of the final address.
+	const auto high = uint8_t((address >> 8) + 1);
+
+	switch(operation) {
+		case Operation::STA:	return a_;
+		case Operation::STX:	return x_;
+		case Operation::STY:	return y_;
+		case Operation::SAX:	return a_ & x_;
+		case Operation::SHA:	return a_ & x_ & high;
+		case Operation::SHX:	return x_ & high;
+		case Operation::SHY:	return y_ & high;
+		case Operation::SHS:
+			s_ = a_ & x_;
+		return s_ & high;
+
+		default:				return 0;
+	}
+}
@@ -0,0 +1,241 @@
+//
+//  Executor.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 14/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#ifndef InstructionSets_6502_Executor_hpp
+#define InstructionSets_6502_Executor_hpp
+
+#include "Instruction.hpp"
+#include "Parser.hpp"
+#include "../CachingExecutor.hpp"
+#include "../../ClockReceiver/ClockReceiver.hpp"
+#include "../../Processors/6502Esque/6502Esque.hpp"
+#include "../../Processors/6502Esque/Implementation/LazyFlags.hpp"
+
+#include <bitset>
+#include <cstdint>
+#include <utility>
+
+namespace CPU {
+namespace MOS6502 {
+struct State;
+}
+}
+
+namespace InstructionSet {
+namespace MOS6502 {
+
+class Executor;
+
+/// One performer per opcode, plus one for trap addresses.
+constexpr uint64_t TrapPerformer = 256;
+using CachingExecutor = CachingExecutor<Executor, 0xffff, TrapPerformer + 1, 3, Instruction, false>;
+
+struct BusHandler {
+	/// Reads from @c address, which is within a page marked via @c Executor::set_is_io_page.
+	virtual uint8_t read([[maybe_unused]] uint16_t address) { return 0xff; }
+
+	/// Writes to @c address, which is within a page marked via @c Executor::set_is_io_page.
+	virtual void write([[maybe_unused]] uint16_t address, [[maybe_unused]] uint8_t value) {}
+
+	/// Announces that execution has reached @c address, which was marked as a trap, just before the instruction there is performed.
+	virtual void did_reach_trap([[maybe_unused]] uint16_t address) {}
+};
+
+/*!
+	Executes NMOS 6502 code from a flat 64kb of RAM, for machines and test harnesses that need only
+	instruction-level timing, subject to the following limitations:
+
+		* timing is correct to whole-opcode boundaries only, and dummy accesses are not performed;
+		* interrupts are accepted only at the start of each call to @c run_for and upon taken branches,
+			jumps, calls and returns, rather than after any instruction;
+		* any change made to memory other than via the executor must be announced via @c memory_did_change;
+		* pages marked as IO are accessed via the BusHandler at the end of the instruction's time rather
+			than at the proper cycle, and code cannot be run from them; nor can they include the zero or stack pages; and
+		* traps are reported only as the instruction at the trap address is reached, not upon any other fetch from there.
+
+	Otherwise its results are identical to those of CPU::MOS6502::Processor, including undocumented opcodes;
+	use @c get_state and @c set_state to move execution between the two when exact timing becomes necessary.
+*/
+class Executor: public CachingExecutor {
+	public:
+		/// Constructs an executor that will run code from the 64kb of RAM at @c memory, which is not copied.
+		/// Supply @c has_decimal_mode as @c false to model the NES's 6502, which ignores the decimal flag.
+		Executor(uint8_t *memory, BusHandler &, bool has_decimal_mode = true);
+
+		/*!
+			Runs, in discrete steps, the minimum number of instructions as it takes to complete at least @c cycles;
+			any excess is deducted from the next call.
+		*/
+		void run_for(Cycles cycles);
+
+		/// Performs the equivalent of the 6502 reset sequence.
+		void reset();
+
+		/// Discards any translation of code in the range [@c begin, @c end] following changes made to memory by some other actor.
+		void memory_did_change(uint16_t begin, uint16_t end);
+
+		/// Marks @c address as a trap, causing @c BusHandler::did_reach_trap to be called whenever execution reaches it.
+		void add_trap_address(uint16_t address);
+
+		/// Sets whether all accesses to the 256 bytes from @c page << 8 should be directed to the BusHandler rather than to memory.
+		void set_is_io_page(uint8_t page, bool is_io);
+
+		uint16_t get_value_of_register(CPU::MOS6502Esque::Register) const;
+		void set_value_of_register(CPU::MOS6502Esque::Register, uint16_t value);
+
+		void set_irq_line(bool);
+		void set_nmi_line(bool);
+		void set_overflow_line(bool);
+		bool is_jammed() const {
+			return is_jammed_;
+		}
+
+		/*!
+			Captures complete processor state, in the format used by CPU::MOS6502::Processor, as if an instruction has
+			just completed; any overrun of the most recent call to @c run_for and any NMI not yet serviced are not captured.
+		*/
+		void get_state(CPU::MOS6502::State &) const;
+
+		/*!
+			Adopts @c state, which must describe a processor that is either jammed or has just
+			fetched an opcode in the course of ordinary execution.
+		*/
+		void set_state(const CPU::MOS6502::State &state);
+
+	private:
+		// MARK: - CachingExecutor-facing interface.
+
+		friend CachingExecutor;
+
+		inline PerformerIndex action_for(Instruction instruction) {
+			return instruction.opcode;
+		}
+
+		inline void parse(uint16_t start, uint16_t closing_bound) {
+			Parser<Executor> parser;
+			parser.parse(*this, memory_, start, closing_bound);
+		}
+
+		/*!
+			Passes @c instruction on to the CachingExecutor, records where its opcode is and, if it is
+			at a trap address, substitutes the trap performer.
+		*/
+		inline void announce_instruction(uint16_t address, Instruction instruction) {
+			CachingExecutor::announce_instruction(address, instruction);
+			code_[address] = true;
+
+			if(traps_[address]) {
+				replace_action(0, PerformerIndex(TrapPerformer));
+			}
+		}
+		friend Parser<Executor>;
+
+		// MARK: - Performers.
+
+		template <size_t... opcodes> void install_performers(std::index_sequence<opcodes...>);
+
+		template <uint8_t opcode> void perform();
+		template <Operation operation> void perform_implied();
+		template <Operation operation> void perform_branch();
+		template <Operation operation> void perform_read(uint8_t value);
+		template <Operation operation> uint8_t perform_read_modify_write(uint8_t value);
+		template <Operation operation> uint8_t value_to_write(uint16_t address);
+		void perform_trap();
+		void perform_jam();
+
+		inline void perform_adc(uint8_t value);
+		inline void perform_sbc(uint8_t value);
+		inline void perform_compare(uint8_t reg, uint8_t value);
+
+		/// Pushes the program counter and @c flags, then loads the program counter from @c vector.
+		void perform_interrupt_sequence(uint16_t vector, uint8_t flags);
+		void perform_interrupt();
+
+		/// Moves execution to @c address as the result of a branch, first accepting any pending interrupt.
+		inline void branch(uint16_t address);
+
+		/// Resumes translated execution at the current program counter.
+		inline void resynchronise() {
+			set_program_counter(program_counter_);
+		}
+
+		// MARK: - Memory access.
+
+		uint8_t *const memory_;
+		BusHandler &bus_handler_;
+
+		/// Indicates every opcode in a translation that might still be cached. Operands are read from memory
+		/// as each instruction is performed, so writes to them don't affect translations and aren't recorded.
+		std::bitset<65536> code_;
+		std::bitset<65536> traps_;
+		std::bitset<256> io_pages_;
+
+		/// Set when a write has modified translated code, to end the current run of translated code after the current instruction.
+		bool did_modify_code_ = false;
+
+		/// Set whenever the program counter is moved other than by translated code, so that the trap performer can tell whether its handler did so.
+		bool did_set_program_counter_ = false;
+
+		inline uint8_t read(uint16_t address) const {
+			return io_pages_[address >> 8] ? bus_handler_.read(address) : memory_[address];
+		}
+		inline void write(uint16_t address, uint8_t value);
+		inline void push(uint8_t value);
+		inline uint8_t pull();
+
+		/// @returns The 16-bit pointer stored at @c address within the zero page, the high byte being read from the same page.
+		inline uint16_t read_zero_page_pointer(uint8_t address) const {
+			return uint16_t(memory_[address] | (memory_[uint8_t(address + 1)] << 8));
+		}
+
+		/// @returns The byte @c offset bytes beyond the start of the current instruction.
+		inline uint8_t operand(int offset) const {
+			return memory_[uint16_t(program_counter_ + offset)];
+		}
+		inline uint16_t operand16(int offset) const {
+			return uint16_t(operand(offset) | (operand(offset + 1) << 8));
+		}
+
+		/*!
+			@returns The address accessed by the current instruction, which uses @c mode; sets @c page_crossed
+				if indexing carried into the high byte of the address.
+		*/
+		template <AddressingMode mode> inline uint16_t address(bool &page_crossed) const;
+
+		void invalidate_code(uint16_t begin, uint16_t end);
+
+		// MARK: - Instruction set state.
+
+		uint8_t a_ = 0, x_ = 0, y_ = 0, s_ = 0;
+		CPU::MOS6502Esque::LazyFlags flags_;
+		uint16_t last_operation_pc_ = 0;
+		const bool has_decimal_mode_;
+
+		bool irq_line_ = false, nmi_line_ = false, overflow_line_ = false;
+		bool nmi_pending_ = false;
+		bool is_jammed_ = false;
+
+		inline bool interrupt_is_pending() const {
+			return nmi_pending_ || (irq_line_ && flags_.inverse_interrupt);
+		}
+
+		/// Moves past the current instruction, which occupied @c length bytes and @c cycles cycles.
+		inline void advance(int length, int cycles) {
+			program_counter_ += length;
+			subtract_duration(cycles);
+			if(did_modify_code_) {
+				did_modify_code_ = false;
+				resynchronise();
+			}
+		}
+};
+
+}
+}
+
+#endif /* InstructionSets_6502_Executor_hpp */
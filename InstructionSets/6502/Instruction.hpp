@@ -0,0 +1,277 @@
+//
+//  Instruction.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 14/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#ifndef InstructionSets_6502_Instruction_hpp
+#define InstructionSets_6502_Instruction_hpp
+
+#include "../AccessType.hpp"
+
+#include <cstdint>
+
+namespace InstructionSet {
+namespace MOS6502 {
+
+enum class AddressingMode: uint8_t {
+	Implied,		Accumulator,	Immediate,
+	Absolute,		AbsoluteX,		AbsoluteY,
+	ZeroPage,		ZeroPageX,		ZeroPageY,
+	XIndirect,		IndirectY,
+	Relative,
+	AbsoluteIndirect,
+};
+
+/// @returns The number of operand bytes that follow an opcode with addressing mode @c mode.
+constexpr int size(AddressingMode mode) {
+	switch(mode) {
+		case AddressingMode::Implied:
+		case AddressingMode::Accumulator:		return 0;
+
+		case AddressingMode::Absolute:
+		case AddressingMode::AbsoluteX:
+		case AddressingMode::AbsoluteY:
+		case AddressingMode::AbsoluteIndirect:	return 2;
+
+		default:								return 1;
+	}
+}
+
+/*!
+	All operations of the NMOS 6502, including those that are undocumented. Undocumented operations
+	use the names given to them by CPU::MOS6502::Processor.
+*/
+enum class Operation: uint8_t {
+	// Operations that don't access memory.
+	BCC,	BCS,	BEQ,	BMI,	BNE,	BPL,	BVC,	BVS,
+	BRK,	JMP,	JSR,	RTI,	RTS,
+	CLC,	CLD,	CLI,	CLV,	SEC,	SED,	SEI,
+	INX,	INY,	DEX,	DEY,
+	PHA,	PHP,	PLA,	PLP,
+	TAX,	TAY,	TSX,	TXA,	TXS,	TYA,
+	JAM,
+
+	// Read operations; NOP is listed here because those forms that have an operand address do read from it.
+	ADC,	SBC,	AND,	ORA,	EOR,	BIT,
+	CMP,	CPX,	CPY,
+	LDA,	LDX,	LDY,
+	NOP,
+	LAX,	ANC,	ASR,	ARR,	SBX,	ANE,	LXA,	LAS,
+
+	// Read-modify-write operations.
+	ASL,	LSR,	ROL,	ROR,	DEC,	INC,
+	ASO,	LSE,	RLA,	RRA,	DCP,	INS,
+
+	// Write operations.
+	STA,	STX,	STY,
+	SAX,	SHA,	SHX,	SHY,	SHS,
+};
+
+constexpr AccessType access_type(Operation operation) {
+	if(operation < Operation::ADC)	return AccessType::None;
+	if(operation < Operation::ASL)	return AccessType::Read;
+	if(operation < Operation::STA)	return AccessType::ReadModifyWrite;
+	return AccessType::Write;
+}
+
+/*!
+	@returns The name of @c operation.
+*/
+inline constexpr const char *operation_name(Operation operation) {
+#define MAP(x)	case Operation::x: return #x;
+	switch(operation) {
+		MAP(BCC);	MAP(BCS);	MAP(BEQ);	MAP(BMI);	MAP(BNE);	MAP(BPL);	MAP(BVC);	MAP(BVS);
+		MAP(BRK);	MAP(JMP);	MAP(JSR);	MAP(RTI);	MAP(RTS);	MAP(CLC);	MAP(CLD);	MAP(CLI);
+		MAP(CLV);	MAP(SEC);	MAP(SED);	MAP(SEI);	MAP(INX);	MAP(INY);	MAP(DEX);	MAP(DEY);
+		MAP(PHA);	MAP(PHP);	MAP(PLA);	MAP(PLP);	MAP(TAX);	MAP(TAY);	MAP(TSX);	MAP(TXA);
+		MAP(TXS);	MAP(TYA);	MAP(JAM);	MAP(ADC);	MAP(SBC);	MAP(AND);	MAP(ORA);	MAP(EOR);
+		MAP(BIT);	MAP(CMP);	MAP(CPX);	MAP(CPY);	MAP(LDA);	MAP(LDX);	MAP(LDY);	MAP(NOP);
+		MAP(LAX);	MAP(ANC);	MAP(ASR);	MAP(ARR);	MAP(SBX);	MAP(ANE);	MAP(LXA);	MAP(LAS);
+		MAP(ASL);	MAP(LSR);	MAP(ROL);	MAP(ROR);	MAP(DEC);	MAP(INC);	MAP(ASO);	MAP(LSE);
+		MAP(RLA);	MAP(RRA);	MAP(DCP);	MAP(INS);	MAP(STA);	MAP(STX);	MAP(STY);	MAP(SAX);
+		MAP(SHA);	MAP(SHX);	MAP(SHY);	MAP(SHS);
+	}
+#undef MAP
+
+	return "???";
+}
+
+/*!
+	@returns The name of @c addressing_mode.
+*/
+inline constexpr const char *addressing_mode_name(AddressingMode addressing_mode) {
+	switch(addressing_mode) {
+		case AddressingMode::Implied:			return "";
+		case AddressingMode::Accumulator:		return "A";
+		case AddressingMode::Immediate:			return "#";
+		case AddressingMode::Absolute:			return "abs";
+		case AddressingMode::AbsoluteX:			return "abs, x";
+		case AddressingMode::AbsoluteY:			return "abs, y";
+		case AddressingMode::ZeroPage:			return "zp";
+		case AddressingMode::ZeroPageX:			return "zp, x";
+		case AddressingMode::ZeroPageY:			return "zp, y";
+		case AddressingMode::XIndirect:			return "(zp, x)";
+		case AddressingMode::IndirectY:			return "(zp), y";
+		case AddressingMode::Relative:			return "rel";
+		case AddressingMode::AbsoluteIndirect:	return "(abs)";
+	}
+
+	return "???";
+}
+
+/*!
+	Models a complete NMOS 6502 instruction: its operation, addressing mode and opcode.
+*/
+struct Instruction {
+	Operation operation = Operation::BRK;
+	AddressingMode addressing_mode = AddressingMode::Implied;
+	uint8_t opcode = 0;
+
+	constexpr Instruction() {}
+	constexpr Instruction(Operation operation, AddressingMode addressing_mode, uint8_t opcode) :
+		operation(operation), addressing_mode(addressing_mode), opcode(opcode) {}
+
+	/// @returns The length of this instruction, including its opcode.
+	constexpr int length() const {
+		return 1 + size(addressing_mode);
+	}
+
+	/// @returns @c true if this instruction unconditionally transfers control elsewhere, or never completes,
+	/// such that whatever follows it is reachable only by some other route.
+	constexpr bool is_terminal() const {
+		switch(operation) {
+			case Operation::JMP:	case Operation::RTS:	case Operation::RTI:
+			case Operation::BRK:	case Operation::JAM:
+			return true;
+			default:
+			return false;
+		}
+	}
+};
+
+/*!
+	Decodes @c opcode as it is interpreted by an NMOS 6502.
+
+	Opcodes are of the form aaabbbcc; with few exceptions the operation is selected by aaa and cc,
+	and the addressing mode by bbb and cc.
+*/
+constexpr Instruction decode(uint8_t opcode) {
+	using AM = AddressingMode;
+	using Op = Operation;
+
+	const int aaa = opcode >> 5, bbb = (opcode >> 2) & 7, cc = opcode & 3;
+
+	// The addressing modes used by the cc = 01 and cc = 11 columns.
+	constexpr AM group_one_modes[] = {
+		AM::XIndirect, AM::ZeroPage, AM::Immediate, AM::Absolute,
+		AM::IndirectY, AM::ZeroPageX, AM::AbsoluteY, AM::AbsoluteX,
+	};
+
+	switch(cc) {
+		case 0: {
+			switch(bbb) {
+				case 0: {
+					constexpr Op operations[] = {Op::BRK, Op::JSR, Op::RTI, Op::RTS, Op::NOP, Op::LDY, Op::CPY, Op::CPX};
+					constexpr AM modes[] = {AM::Implied, AM::Absolute, AM::Implied, AM::Implied, AM::Immediate, AM::Immediate, AM::Immediate, AM::Immediate};
+					return Instruction(operations[aaa], modes[aaa], opcode);
+				}
+				case 1: {
+					constexpr Op operations[] = {Op::NOP, Op::BIT, Op::NOP, Op::NOP, Op::STY, Op::LDY, Op::CPY, Op::CPX};
+					return Instruction(operations[aaa], AM::ZeroPage, opcode);
+				}
+				case 2: {
+					constexpr Op operations[] = {Op::PHP, Op::PLP, Op::PHA, Op::PLA, Op::DEY, Op::TAY, Op::INY, Op::INX};
+					return Instruction(operations[aaa], AM::Implied, opcode);
+				}
+				case 3: {
+					constexpr Op operations[] = {Op::NOP, Op::BIT, Op::JMP, Op::JMP, Op::STY, Op::LDY, Op::CPY, Op::CPX};
+					return Instruction(operations[aaa], aaa == 3 ? AM::AbsoluteIndirect : AM::Absolute, opcode);
+				}
+				case 4: {
+					constexpr Op operations[] = {Op::BPL, Op::BMI, Op::BVC, Op::BVS, Op::BCC, Op::BCS, Op::BNE, Op::BEQ};
+					return Instruction(operations[aaa], AM::Relative, opcode);
+				}
+				case 5: {
+					constexpr Op operations[] = {Op::NOP, Op::NOP, Op::NOP, Op::NOP, Op::STY, Op::LDY, Op::NOP, Op::NOP};
+					return Instruction(operations[aaa], AM::ZeroPageX, opcode);
+				}
+				case 6: {
+					constexpr Op operations[] = {Op::CLC, Op::SEC, Op::CLI, Op::SEI, Op::TYA, Op::CLV, Op::CLD, Op::SED};
+					return Instruction(operations[aaa], AM::Implied, opcode);
+				}
+				default: {
+					constexpr Op operations[] = {Op::NOP, Op::NOP, Op::NOP, Op::NOP, Op::SHY, Op::LDY, Op::NOP, Op::NOP};
+					return Instruction(operations[aaa], AM::AbsoluteX, opcode);
+				}
+			}
+		}
+
+		case 1: {
+			constexpr Op operations[] = {Op::ORA, Op::AND, Op::EOR, Op::ADC, Op::STA, Op::LDA, Op::CMP, Op::SBC};
+			if(opcode == 0x89) return Instruction(Op::NOP, AM::Immediate, opcode);
+			return Instruction(operations[aaa], group_one_modes[bbb], opcode);
+		}
+
+		case 2: {
+			constexpr Op operations[] = {Op::ASL, Op::ROL, Op::LSR, Op::ROR, Op::STX, Op::LDX, Op::DEC, Op::INC};
+			switch(bbb) {
+				case 0:
+					if(aaa < 4) return Instruction(Op::JAM, AM::Implied, opcode);
+					return Instruction(aaa == 5 ? Op::LDX : Op::NOP, AM::Immediate, opcode);
+				case 1:	return Instruction(operations[aaa], AM::ZeroPage, opcode);
+				case 2: {
+					if(aaa < 4) return Instruction(operations[aaa], AM::Accumulator, opcode);
+					constexpr Op implied[] = {Op::TXA, Op::TAX, Op::DEX, Op::NOP};
+					return Instruction(implied[aaa - 4], AM::Implied, opcode);
+				}
+				case 3:	return Instruction(operations[aaa], AM::Absolute, opcode);
+				case 4:	return Instruction(Op::JAM, AM::Implied, opcode);
+				case 5:	return Instruction(operations[aaa], (aaa == 4 || aaa == 5) ? AM::ZeroPageY : AM::ZeroPageX, opcode);
+				case 6:
+					if(aaa == 4) return Instruction(Op::TXS, AM::Implied, opcode);
+					if(aaa == 5) return Instruction(Op::TSX, AM::Implied, opcode);
+				return Instruction(Op::NOP, AM::Implied, opcode);
+				default:
+					if(aaa == 4) return Instruction(Op::SHX, AM::AbsoluteY, opcode);
+				return Instruction(operations[aaa], aaa == 5 ? AM::AbsoluteY : AM::AbsoluteX, opcode);
+			}
+		}
+
+		default: {
+			if(bbb == 2) {
+				constexpr Op operations[] = {Op::ANC, Op::ANC, Op::ASR, Op::ARR, Op::ANE, Op::LXA, Op::SBX, Op::SBC};
+				return Instruction(operations[aaa], AM::Immediate, opcode);
+			}
+
+			switch(aaa) {
+				case 4:
+					switch(bbb) {
+						case 4:		return Instruction(Op::SHA, AM::IndirectY, opcode);
+						case 5:		return Instruction(Op::SAX, AM::ZeroPageY, opcode);
+						case 6:		return Instruction(Op::SHS, AM::AbsoluteY, opcode);
+						case 7:		return Instruction(Op::SHA, AM::AbsoluteY, opcode);
+						default:	return Instruction(Op::SAX, group_one_modes[bbb], opcode);
+					}
+				case 5:
+					switch(bbb) {
+						case 5:		return Instruction(Op::LAX, AM::ZeroPageY, opcode);
+						case 6:		return Instruction(Op::LAS, AM::AbsoluteY, opcode);
+						case 7:		return Instruction(Op::LAX, AM::AbsoluteY, opcode);
+						default:	return Instruction(Op::LAX, group_one_modes[bbb], opcode);
+					}
+				default: {
+					constexpr Op operations[] = {Op::ASO, Op::RLA, Op::LSE, Op::RRA, Op::SAX, Op::LAX, Op::DCP, Op::INS};
+					return Instruction(operations[aaa], group_one_modes[bbb], opcode);
+				}
+			}
+		}
+	}
+}
+
+}
+}
+
+#endif /* InstructionSets_6502_Instruction_hpp */
@@ -11,13 +11,14 @@
 
 #include "../Numeric/Sizes.hpp"
 
+#include <algorithm>
 #include <array>
+#include <bitset>
 #include <cstdint>
 #include <limits>
 #include <list>
-#include <map>
-#include <queue>
 #include <unordered_map>
+#include <vector>
 
 namespace InstructionSet {
 
@@ -40,6 +41,8 @@ template <
 	uint64_t max_address,
 	/// Indicates the maximum number of potential performers that will be provided.
 	uint64_t max_performer_count,
+	/// Indicates the greatest length that a single instruction might have, in program counter units.
+	uint64_t max_instruction_length,
 	/// Provides the type of Instruction to expect.
 	typename InstructionType,
 	/// Indicates whether instructions should be treated as ephemeral or included in the cache.
@@ -47,20 +50,27 @@ template <
 > class CachingExecutor {
 	public:
 		using Performer = void (Executor::*)();
-		using PerformerIndex = typename MinIntTypeValue<max_performer_count>::type;
+		using PerformerIndex = typename MinIntTypeValue<max_performer_count + 1>::type;
 		using ProgramCounterType = typename MinIntTypeValue<max_address>::type;
 
 		// MARK: - Parser call-ins.
 
 		void announce_overflow(ProgramCounterType) {
 			/*
-				Should be impossible for now; this is intended to provide information
-				when page caching.
+				Nothing to do here: every translated run is terminated by a page-exit
+				performer, which will cause translation to resume at whatever
+				address the program counter has reached.
 			*/
 		}
-		void announce_instruction(ProgramCounterType, InstructionType instruction) {
+		void announce_instruction(ProgramCounterType address, InstructionType instruction) {
+			// Record this as a potential entry point if it's within the page being translated;
+			// the final instruction or two might spill into the next.
+			if(ProgramCounterType(address >> page_shift) == translation_page_->address) {
+				translation_page_->entry_points[address & (page_size - 1)] = uint32_t(translation_page_->actions.size());
+			}
+
 			// Dutifully map the instruction to a performer and keep it.
-			program_.push_back(static_cast<Executor *>(this)->action_for(instruction));
+			translation_page_->actions.push_back(static_cast<Executor *>(this)->action_for(instruction));
 
 			if constexpr (retain_instructions) {
 				// TODO.
@@ -68,11 +78,20 @@ template <
 		}
 
 	protected:
+		// TODO: are 1kb pages always appropriate?
+		static constexpr int page_shift = 10;
+		static constexpr uint64_t page_size = 1 << page_shift;
+
+		CachingExecutor() {
+			performers_[page_exit_index] = &CachingExecutor::exit_page;
+		}
 
 		// Storage for the statically-allocated list of performers. It's a bit more
 		// work for executors to fill this array, but subsequently performers can be
 		// indexed by array position, which is a lot more compact than a generic pointer.
-		std::array<Performer, max_performer_count+1> performers_;
+		//
+		// The final entry is reserved for use by the caching executor itself.
+		std::array<Performer, max_performer_count+2> performers_;
 		ProgramCounterType program_counter_;
 
 		/*!
@@ -85,18 +104,72 @@ template <
 			has_branched_ = true;
 			program_counter_ = address;
 
-			// Temporary implementation: just interpret.
-			program_.clear();
-			program_index_ = 0;
-			static_cast<Executor *>(this)->parse(address, ProgramCounterType(max_address));
-
-//			const auto page = find_page(address);
-//			const auto entry = page->entry_points.find(address);
-//			if(entry == page->entry_points.end()) {
-//				// Requested segment wasn't found; check whether it was
-//				// within the recently translated list and otherwise
-//				// translate it.
-//			}
+			// Most branches are local, so check the active page before
+			// doing any sort of search.
+			const auto page_address = ProgramCounterType(address >> page_shift);
+			if(!active_page_ || active_page_->address != page_address) {
+				active_page_ = find_page(page_address);
+			}
+
+			// If this address hasn't previously been reached, translate from here
+			// to the end of the page, or to the first unconditional branch.
+			auto entry = active_page_->entry_points[address & (page_size - 1)];
+			if(entry == no_entry) {
+				entry = uint32_t(active_page_->actions.size());
+				translation_page_ = active_page_;
+
+				const uint64_t page_end = (uint64_t(page_address) << page_shift) + page_size - 1;
+				static_cast<Executor *>(this)->parse(
+					address,
+					ProgramCounterType(std::min(page_end + max_instruction_length - 1, max_address))
+				);
+				active_page_->actions.push_back(PerformerIndex(page_exit_index));
+			}
+			program_ = &active_page_->actions[entry];
+		}
+
+		/*!
+			Discards any cached translations of code that overlaps the range [@c begin, @c end].
+			Translations will be regenerated if and when execution next reaches them.
+		*/
+		void invalidate(ProgramCounterType begin, ProgramCounterType end) {
+			// Translations may run up to max_instruction_length-1 addresses beyond the end of their page.
+			const auto first_page = ProgramCounterType(
+				(begin > max_instruction_length - 1 ? begin - (max_instruction_length - 1) : 0) >> page_shift
+			);
+			const auto last_page = ProgramCounterType(end >> page_shift);
+
+			for(uint64_t page_address = first_page; page_address <= last_page; page_address++) {
+				const auto page = cached_pages_.find(ProgramCounterType(page_address));
+				if(page == cached_pages_.end()) continue;
+
+				// Any code currently running from this page is permitted to run until the next branch;
+				// its storage will be reclaimed only upon the next translation.
+				if(page->second == active_page_) active_page_ = nullptr;
+				translated_pages_[page_address] = false;
+				page->second->address = no_page;
+				pages_.splice(pages_.end(), pages_, page->second->lru_position);
+				cached_pages_.erase(page);
+			}
+		}
+
+		/*!
+			Should be called by a specific executor upon every write to memory that might hold code;
+			discards any translation that the write may have affected.
+
+			This is cheap if there is no translated code near @c address. If the write modifies code
+			within a run of translated code that is currently executing then that run will continue
+			until its next branch; translation will be repeated if the modified code is subsequently
+			reached again.
+		*/
+		inline void did_write(ProgramCounterType address) {
+			const auto page_address = address >> page_shift;
+			if(
+				translated_pages_[page_address] ||
+				(page_address && (address & (page_size - 1)) < max_instruction_length - 1 && translated_pages_[page_address - 1])
+			) {
+				invalidate(address, address);
+			}
 		}
 
 		/*!
@@ -111,13 +184,44 @@ template <
 		*/
 		void run_to_branch() {
 			has_branched_ = false;
-			for(auto index: program_) {
-				const auto performer = performers_[index];
-				(static_cast<Executor *>(this)->*performer)();
-				if(has_branched_) break;
+			Executor *const executor = static_cast<Executor *>(this);
+			while(!has_branched_) {
+				const auto performer = performers_[*program_];
+				++program_;
+
+				(executor->*performer)();
 			}
 		}
 
+		/*!
+			Replaces the action most recently announced for the run currently being translated, or that
+			announced @c distance instructions before it, with @c performer.
+
+			This allows an executor to fuse a sequence of instructions into a single performer;
+			the original actions for the subsequent instructions remain in place so that they can still
+			be entered directly, so the fused performer should @c skip_actions(distance) before it
+			does anything else.
+		*/
+		void replace_action(size_t distance, PerformerIndex performer) {
+			auto &actions = translation_page_->actions;
+			actions[actions.size() - 1 - distance] = performer;
+		}
+
+		/*!
+			Skips the next @c count actions in the current run; for use by fused performers.
+		*/
+		void skip_actions(size_t count) {
+			program_ += count;
+		}
+
+		/*!
+			@returns the amount of time remaining in the current call to @c run_for, in the units
+				that are passed to @c subtract_duration.
+		*/
+		int remaining_duration() const {
+			return remaining_duration_;
+		}
+
 		/*!
 			Runs for @c duration; the intention is that subclasses provide a method
 			that is clear about units, and call this to count down in whatever units they
@@ -130,8 +234,8 @@ template <
 				has_branched_ = false;
 				Executor *const executor = static_cast<Executor *>(this);
 				while(remaining_duration_ > 0 && !has_branched_) {
-					const auto performer = performers_[program_[program_index_]];
-					++program_index_;
+					const auto performer = performers_[*program_];
+					++program_;
 
 					(executor->*performer)();
 				}
@@ -149,50 +253,89 @@ template <
 	private:
 		bool has_branched_ = false;
 		int remaining_duration_ = 0;
-		std::vector<PerformerIndex> program_;
-		size_t program_index_ = 0;
+		const PerformerIndex *program_ = nullptr;
+
+		/// The index of the performer that the caching executor appends to every translated run.
+		static constexpr uint64_t page_exit_index = max_performer_count + 1;
+
+		/*!
+			Ends any run of translated code that finishes without an unconditional branch,
+			i.e. one that has run up to the end of its page.
+		*/
+		void exit_page() {
+			set_program_counter(program_counter_);
+		}
+
+		// TODO: is 64 the correct amount to keep?
+		static constexpr size_t max_cached_pages = 64;
 
-		/* TODO: almost below here can be shoved off into an LRUCache object, or similar. */
+		static constexpr uint32_t no_entry = std::numeric_limits<uint32_t>::max();
+		static constexpr ProgramCounterType no_page = std::numeric_limits<ProgramCounterType>::max();
 
-//		static constexpr size_t max_cached_pages = 64;
+		struct Page {
+			/// The page number, i.e. the address of the start of this page shifted right by @c page_shift.
+			ProgramCounterType address = no_page;
 
-//		struct Page {
-//			std::map<ProgramCounterType, PerformerIndex> entry_points;
+			/// Maps from offsets within the page to indices into @c actions, or @c no_entry for any
+			/// address that has not yet been reached.
+			std::array<uint32_t, page_size> entry_points;
 
-			// TODO: can I statically these two? Should I?
-//			std::vector<PerformerIndex> actions_;
-//			std::vector<typename std::enable_if<!std::is_same<InstructionType, void>::value, InstructionType>::type> instructions_;
-//		};
-//		std::array<Page, max_cached_pages> pages_;
+			/// All translated code for the page; runs are appended in the order in which they are reached.
+			std::vector<PerformerIndex> actions;
+
+			/// This page's position within @c pages_.
+			typename std::list<Page>::iterator lru_position;
+
+			// TODO: retain instructions here, if requested.
+		};
+
+		// All allocated pages, in most-recently-used order.
+		std::list<Page> pages_;
 
 		// Maps from page numbers to pages.
-//		std::unordered_map<ProgramCounterType, Page *> cached_pages_;
+		std::unordered_map<ProgramCounterType, Page *> cached_pages_;
 
-		// Maintains an LRU of recently-used pages in case of a need for reuse.
-//		std::list<ProgramCounterType> touched_pages_;
+		// Provides a quick test for whether there is a cached page at any given page number.
+		std::bitset<(max_address >> page_shift) + 1> translated_pages_;
+
+		// The page that execution is currently running from, if any, and the page currently being translated.
+		Page *active_page_ = nullptr;
+		Page *translation_page_ = nullptr;
 
 		/*!
-			Finds or creates the page that contains @c address.
+			Finds or creates the page with page number @c page_address, marking it as the most recently used.
 		*/
-/*		Page *find_page(ProgramCounterType address) {
-			// TODO: are 1kb pages always appropriate? Is 64 the correct amount to keep?
-			const auto page_address = ProgramCounterType(address >> 10);
-
-			auto page = cached_pages_.find(page_address);
-			if(page == cached_pages_.end()) {
-				// Page wasn't found; either allocate a new one or
-				// reuse one that already exists.
-				if(cached_pages_.size() == max_cached_pages) {
-
-				} else {
+		Page *find_page(ProgramCounterType page_address) {
+			const auto cached = cached_pages_.find(page_address);
+			if(cached != cached_pages_.end()) {
+				// Page was found; LRU shuffle it.
+				Page *const page = cached->second;
+				pages_.splice(pages_.begin(), pages_, page->lru_position);
+				return page;
+			}
 
-				}
+			// Page wasn't found; either reuse the least recently used if it
+			// has been invalidated or if the cache is full, or else allocate a new one.
+			if(pages_.size() < max_cached_pages && (pages_.empty() || pages_.back().address != no_page)) {
+				pages_.emplace_front();
+				pages_.front().lru_position = pages_.begin();
 			} else {
-				// Page was found; LRU shuffle it.
+				Page &victim = pages_.back();
+				if(victim.address != no_page) {
+					cached_pages_.erase(victim.address);
+					translated_pages_[victim.address] = false;
+				}
+				pages_.splice(pages_.begin(), pages_, victim.lru_position);
 			}
 
-			return nullptr;
-		}*/
+			Page *const page = &pages_.front();
+			page->address = page_address;
+			page->entry_points.fill(no_entry);
+			page->actions.clear();
+			cached_pages_[page_address] = page;
+			translated_pages_[page_address] = true;
+			return page;
+		}
 };
 
 }
@@ -37,6 +37,7 @@ Executor::Executor(PortHandler &port_handler) : port_handler_(port_handler) {
 			performers_[c] = performer_lookup_.performer(instruction.operation, instruction.addressing_mode);
 		}
 	}
+	install_fused_performers<0>();
 
 	// Fuzz RAM; then set anything that may be replaced by ROM to FF.
 	Memory::Fuzz(memory_);
@@ -47,6 +48,7 @@ void Executor::set_rom(const std::vector<uint8_t> &rom) {
 	// Copy into place, and reset.
 	const auto length = std::min(size_t(0x1000), rom.size());
 	memcpy(&memory_[0x2000 - length], rom.data(), length);
+	CachingExecutor::invalidate(0x0000, 0x1fff);
 	reset();
 }
 
@@ -128,9 +130,10 @@ void Executor::set_port_output(int port) {
 void Executor::write(uint16_t address, uint8_t value) {
 	address &= 0x1fff;
 
-	// RAM writes are easy.
+	// RAM writes are easy, other than the possibility that they modify code.
 	if(address < 0x60) {
 		memory_[address] = value;
+		did_write(address);
 		return;
 	}
 
@@ -415,6 +418,7 @@ template <Operation operation, AddressingMode addressing_mode> void Executor::pe
 			case AddressingMode::ZeroPageRelative: {
 				// Order of bytes is: (i) zero page address; (ii) relative jump.
 				uint8_t value;
+				const uint16_t start = program_counter_;
 				if constexpr (addressing_mode == AddressingMode::AccumulatorRelative) {
 					value = a_;
 					address = unsigned(program_counter_ + 1 + size(addressing_mode) + int8_t(next8()));
@@ -423,25 +427,29 @@ template <Operation operation, AddressingMode addressing_mode> void Executor::pe
 					address = unsigned(program_counter_ + 1 + size(addressing_mode) + int8_t(memory_[(program_counter_+2)&0x1fff]));
 				}
 				program_counter_ += 1 + size(addressing_mode);
+
+				const auto branch = [&] {
+					set_program_counter(uint16_t(address));
+					subtract_duration(2);
+
+					// A branch to itself will be repeated for as long as the value it tests is unchanged.
+					if(addressing_mode == AddressingMode::ZeroPageRelative && ((address ^ start) & 0x1fff) == 0) {
+						idle_while_unchanged(memory_[(start + 1) & 0x1fff], value, 5 + 2);
+					}
+				};
 				switch(operation) {
 					case Operation::BBS0:	case Operation::BBS1:	case Operation::BBS2:	case Operation::BBS3:
 					case Operation::BBS4:	case Operation::BBS5:	case Operation::BBS6:	case Operation::BBS7: {
 						if constexpr (operation >= Operation::BBS0 && operation <= Operation::BBS7) {
 							constexpr uint8_t mask = 1 << (int(operation) - int(Operation::BBS0));
-							if(value & mask) {
-								set_program_counter(uint16_t(address));
-								subtract_duration(2);
-							}
+							if(value & mask) branch();
 						}
 					} return;
 					case Operation::BBC0:	case Operation::BBC1:	case Operation::BBC2:	case Operation::BBC3:
 					case Operation::BBC4:	case Operation::BBC5:	case Operation::BBC6:	case Operation::BBC7: {
 						if constexpr (operation >= Operation::BBC0 && operation <= Operation::BBC7) {
 							constexpr uint8_t mask = 1 << (int(operation) - int(Operation::BBC0));
-							if(!(value & mask)) {
-								set_program_counter(uint16_t(address));
-								subtract_duration(2);
-							}
+							if(!(value & mask)) branch();
 						}
 					} return;
 					default: assert(false);
@@ -530,6 +538,59 @@ template <Operation operation, AddressingMode addressing_mode> void Executor::pe
 	write(uint16_t(address), value);
 }
 
+template <size_t index> void Executor::perform_fused() {
+	constexpr FusedSequence sequence = fused_sequences[index];
+	constexpr Operation first_operation = sequence.operations[0];
+	constexpr AddressingMode first_mode = sequence.addressing_modes[0];
+
+	// Step over the original actions for the remainder of the sequence; they remain
+	// only in case of a branch directly to one of them.
+	skip_actions(size_t(sequence.length() - 1));
+
+	const uint16_t start = program_counter_;
+	const int initial_duration = remaining_duration();
+
+	perform<first_operation, first_mode>();
+
+	// If the sequence begins by reading a fixed address then, should it branch back to
+	// its start, its next iteration will have exactly the same effect unless that address
+	// produces a different value. So take note of both.
+	//
+	// This assumes that reads are free of side effects, which is true here.
+	constexpr bool is_poll =
+		(first_operation == Operation::LDA || first_operation == Operation::BIT) &&
+		(first_mode == AddressingMode::ZeroPage || first_mode == AddressingMode::Absolute);
+	[[maybe_unused]] uint16_t poll_address = 0;
+	[[maybe_unused]] uint8_t polled_value = 0;
+	if constexpr (is_poll) {
+		poll_address = first_mode == AddressingMode::ZeroPage ?
+			memory_[(start + 1) & 0x1fff] :
+			uint16_t(memory_[(start + 1) & 0x1fff] | (memory_[(start + 2) & 0x1fff] << 8));
+		polled_value = read(poll_address);
+	}
+
+	perform<sequence.operations[1], sequence.addressing_modes[1]>();
+	if constexpr (sequence.length() == 3) {
+		perform<sequence.operations[2], sequence.addressing_modes[2]>();
+	}
+
+	if constexpr (is_poll) {
+		if(program_counter_ == start) {
+			idle_while_unchanged(poll_address, polled_value, initial_duration - remaining_duration());
+		}
+	}
+}
+
+inline void Executor::idle_while_unchanged(uint16_t address, uint8_t value, int iteration_length) {
+	if(iteration_length <= 0) return;
+
+	// Each iteration is accounted for as a whole, so the value is sampled slightly earlier than
+	// it would be by the real loop; timing is exact only to whole-instruction boundaries anyway.
+	while(remaining_duration() > 0 && read(address) == value) {
+		subtract_duration(iteration_length);
+	}
+}
+
 template <Operation operation> void Executor::perform(uint8_t *operand [[maybe_unused]]) {
 
 #define set_nz(a)	negative_result_ = zero_result_ = (a)
@@ -21,8 +21,59 @@
 namespace InstructionSet {
 namespace M50740 {
 
+/*!
+	Describes a sequence of two or three instructions that, when found adjacent in the instruction stream,
+	are performed by a single performer. Pairs have a final operation of @c Operation::Invalid.
+*/
+struct FusedSequence {
+	Operation operations[3];
+	AddressingMode addressing_modes[3];
+
+	constexpr bool matches(int index, const Instruction &instruction) const {
+		return instruction.operation == operations[index] && instruction.addressing_mode == addressing_modes[index];
+	}
+	constexpr int length() const {
+		return operations[2] == Operation::Invalid ? 2 : 3;
+	}
+};
+
+#define Pair(op1, mode1, op2, mode2)				\
+	{	{Operation::op1, Operation::op2, Operation::Invalid},	\
+		{AddressingMode::mode1, AddressingMode::mode2, AddressingMode::Implied}	}
+#define Triple(op1, mode1, op2, mode2, op3, mode3)	\
+	{	{Operation::op1, Operation::op2, Operation::op3},	\
+		{AddressingMode::mode1, AddressingMode::mode2, AddressingMode::mode3}	}
+
+/// The instruction sequences that are fused; these are primarily the components of polling and delay loops.
+constexpr FusedSequence fused_sequences[] = {
+	Pair(LDA, ZeroPage, BEQ, Relative),		Pair(LDA, ZeroPage, BNE, Relative),
+	Pair(LDA, ZeroPage, BMI, Relative),		Pair(LDA, ZeroPage, BPL, Relative),
+	Pair(LDA, Absolute, BEQ, Relative),		Pair(LDA, Absolute, BNE, Relative),
+	Pair(LDA, Absolute, BMI, Relative),		Pair(LDA, Absolute, BPL, Relative),
+
+	Pair(BIT, ZeroPage, BEQ, Relative),		Pair(BIT, ZeroPage, BNE, Relative),
+	Pair(BIT, ZeroPage, BMI, Relative),		Pair(BIT, ZeroPage, BPL, Relative),
+	Pair(BIT, Absolute, BEQ, Relative),		Pair(BIT, Absolute, BNE, Relative),
+	Pair(BIT, Absolute, BMI, Relative),		Pair(BIT, Absolute, BPL, Relative),
+
+	Pair(CMP, Immediate, BEQ, Relative),	Pair(CMP, Immediate, BNE, Relative),
+	Pair(CMP, Immediate, BCC, Relative),	Pair(CMP, Immediate, BCS, Relative),
+	Pair(AND, Immediate, BEQ, Relative),	Pair(AND, Immediate, BNE, Relative),
+
+	Pair(DEX, Implied, BNE, Relative),		Pair(DEY, Implied, BNE, Relative),
+
+	Triple(LDA, ZeroPage, AND, Immediate, BEQ, Relative),	Triple(LDA, ZeroPage, AND, Immediate, BNE, Relative),
+	Triple(LDA, ZeroPage, CMP, Immediate, BEQ, Relative),	Triple(LDA, ZeroPage, CMP, Immediate, BNE, Relative),
+	Triple(LDA, Absolute, AND, Immediate, BEQ, Relative),	Triple(LDA, Absolute, AND, Immediate, BNE, Relative),
+	Triple(LDA, Absolute, CMP, Immediate, BEQ, Relative),	Triple(LDA, Absolute, CMP, Immediate, BNE, Relative),
+};
+constexpr size_t fused_sequence_count = sizeof(fused_sequences) / sizeof(*fused_sequences);
+
+#undef Triple
+#undef Pair
+
 class Executor;
-using CachingExecutor = CachingExecutor<Executor, 0x1fff, 255, Instruction, false>;
+using CachingExecutor = CachingExecutor<Executor, 0x1fff, 255 + fused_sequence_count, 3, Instruction, false>;
 
 struct PortHandler {
 	virtual void run_ports_for(Cycles) = 0;
@@ -68,10 +119,43 @@ class Executor: public CachingExecutor {
 			Parses from @c start and no later than @c max_address, using the CachingExecutor as a target.
 		*/
 		inline void parse(uint16_t start, uint16_t closing_bound) {
+			recent_instructions_[0] = recent_instructions_[1] = Instruction();
+
 			Parser<Executor, false> parser;
 			parser.parse(*this, &memory_[0], start & 0x1fff, closing_bound);
 		}
 
+		/*!
+			Passes @c instruction on to the CachingExecutor, then fuses it with the one or two instructions
+			before it if they form one of the @c fused_sequences.
+		*/
+		inline void announce_instruction(uint16_t address, Instruction instruction) {
+			CachingExecutor::announce_instruction(address, instruction);
+
+			for(size_t c = 0; c < fused_sequence_count; c++) {
+				const auto &sequence = fused_sequences[c];
+				if(!sequence.matches(sequence.length() - 1, instruction)) continue;
+
+				if(sequence.length() == 2 && sequence.matches(0, recent_instructions_[1])) {
+					replace_action(1, PerformerIndex(256 + c));
+				}
+				if(
+					sequence.length() == 3 &&
+					sequence.matches(0, recent_instructions_[0]) &&
+					sequence.matches(1, recent_instructions_[1])
+				) {
+					replace_action(2, PerformerIndex(256 + c));
+				}
+			}
+
+			recent_instructions_[0] = recent_instructions_[1];
+			recent_instructions_[1] = instruction;
+		}
+		friend Parser<Executor, false>;
+
+		/// The two instructions most recently announced in the current translation, oldest first.
+		Instruction recent_instructions_[2];
+
 	private:
 		// MARK: - Internal framework for generator performers.
 
@@ -123,6 +207,25 @@ class Executor: public CachingExecutor {
 		*/
 		template <Operation operation, AddressingMode addressing_mode> void perform();
 
+		/*!
+			Performs all instructions in @c fused_sequences[index]; if they form a loop that polls an
+			unchanging value then also fast-forwards through as many iterations as remain.
+		*/
+		template <size_t index> void perform_fused();
+
+		template <size_t index> void install_fused_performers() {
+			performers_[256 + index] = &Executor::perform_fused<index>;
+			if constexpr (index + 1 < fused_sequence_count) {
+				install_fused_performers<index + 1>();
+			}
+		}
+
+		/*!
+			Spins for as much of the remaining run time as is possible in @c iteration_length steps,
+			while the value read from @c address continues to be @c value.
+		*/
+		inline void idle_while_unchanged(uint16_t address, uint8_t value, int iteration_length);
+
 	private:
 		// MARK: - Instruction set state.
 
@@ -10,9 +10,53 @@
 
 using namespace InstructionSet::PowerPC;
 
-Decoder::Decoder(Model model) : model_(model) {}
+Decoder::Decoder(Model model) : model_(model) {
+	// Decoding of the primary opcodes with extended opcodes continues via the extended tables.
+	// Opcodes 16, 17 and 62 aren't fully determined by either, so are left to decode_fields.
+	constexpr uint32_t extended_primaries[] = {19, 31, 59, 63};
+	const auto install = [](TableEntry &entry, const Instruction &instruction) {
+		entry.operation = instruction.operation;
+		entry.is_supervisor = instruction.is_supervisor;
+	};
+
+	for(uint32_t primary = 0; primary < primary_.size(); primary++) {
+		install(primary_[primary], decode_fields(primary << 26));
+	}
+	primary_[16].extended = primary_[17].extended = primary_[62].extended = TableEntry::ByFields;
+
+	for(uint8_t table = 0; table < extended_.size(); table++) {
+		const uint32_t primary = extended_primaries[table];
+		primary_[primary].extended = table;
+
+		for(uint32_t index = 0; index < extended_[table].size(); index++) {
+			install(extended_[table][index], decode_fields((primary << 26) | index));
+		}
+	}
+}
 
 Instruction Decoder::decode(uint32_t opcode) {
+	const TableEntry &primary = primary_[opcode >> 26];
+	switch(primary.extended) {
+		case TableEntry::Complete:
+		return Instruction(primary.operation, opcode, primary.is_supervisor);
+
+		case TableEntry::ByFields:
+		return decode_fields(opcode);
+
+		default: {
+			const TableEntry &extended = extended_[primary.extended][opcode & 0x7ff];
+			return Instruction(extended.operation, opcode, extended.is_supervisor);
+		}
+	}
+}
+
+void Decoder::decode(const uint32_t *opcodes, size_t count, Instruction *instructions) {
+	for(size_t c = 0; c < count; c++) {
+		instructions[c] = decode(opcodes[c]);
+	}
+}
+
+Instruction Decoder::decode_fields(uint32_t opcode) const {
 	// Quick bluffer's guide to PowerPC instruction encoding:
 	//
 	// There is a six-bit field at the very top of the instruction.
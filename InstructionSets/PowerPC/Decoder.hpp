@@ -11,6 +11,9 @@
 
 #include "Instruction.hpp"
 
+#include <array>
+#include <cstddef>
+
 namespace InstructionSet {
 namespace PowerPC {
 
@@ -34,9 +37,35 @@ struct Decoder {
 
 		Instruction decode(uint32_t opcode);
 
+		/// Decodes the @c count opcodes at @c opcodes, storing the results to @c instructions.
+		void decode(const uint32_t *opcodes, size_t count, Instruction *instructions);
+
 	private:
 		Model model_;
 
+		/// Decodes @c opcode by inspection of its fields; this is used to populate the lookup
+		/// tables below, and directly for those primary opcodes that the tables can't resolve.
+		Instruction decode_fields(uint32_t opcode) const;
+
+		struct TableEntry {
+			Operation operation = Operation::Undefined;
+			bool is_supervisor = false;
+			/// For primary opcodes: the index into extended_ of the table from which to continue
+			/// decoding, or @c Complete if no further decoding is required, or @c ByFields if
+			/// the remaining fields must be inspected individually.
+			uint8_t extended = Complete;
+
+			static constexpr uint8_t Complete = 0xfe;
+			static constexpr uint8_t ByFields = 0xff;
+		};
+
+		/// Indexed by primary opcode, i.e. the top six bits.
+		std::array<TableEntry, 64> primary_;
+
+		/// The tables for the primary opcodes that take an extended opcode, i.e. 19, 31, 59 and 63;
+		/// indexed by the low eleven bits, i.e. the extended opcode plus the Rc bit.
+		std::array<std::array<TableEntry, 2048>, 4> extended_;
+
 		bool is64bit() const {
 			return model_ == Model::MPC620;
 		}
@@ -0,0 +1,1302 @@
+//
+//  Executor.cpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 14/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#include "Executor.hpp"
+
+#include "../../Processors/Z80/State/State.hpp"
+
+#include <algorithm>
+#include <utility>
+
+using namespace InstructionSet;
+using namespace InstructionSet::Z80;
+
+namespace {
+	using Flag = CPU::Z80::Flag;
+	using FlagTables = CPU::Z80::FlagTables;
+}
+
+Executor::Executor(uint8_t *memory, BusHandler &bus_handler) : memory_(memory), bus_handler_(bus_handler) {
+	install_performers<Z80::Page::Base>(std::make_index_sequence<256>());
+	install_performers<Z80::Page::CB>(std::make_index_sequence<256>());
+	install_performers<Z80::Page::ED>(std::make_index_sequence<256>());
+	install_performers<Z80::Page::DD>(std::make_index_sequence<256>());
+	install_performers<Z80::Page::FD>(std::make_index_sequence<256>());
+	install_performers<Z80::Page::DDCB>(std::make_index_sequence<256>());
+	install_performers<Z80::Page::FDCB>(std::make_index_sequence<256>());
+	performers_[TrapPerformer] = &Executor::perform_trap;
+
+	bc_.full = de_.full = hl_.full = 0;
+	af_dash_.full = bc_dash_.full = de_dash_.full = hl_dash_.full = 0;
+	ix_.full = iy_.full = memptr_.full = 0;
+	reset();
+}
+
+template <Z80::Page page, size_t... opcodes> void Executor::install_performers(std::index_sequence<opcodes...>) {
+	((performers_[size_t(page) * 256 + opcodes] = &Executor::perform<page, uint8_t(opcodes)>), ...);
+}
+
+// MARK: - Host interface.
+
+void Executor::run_for(Cycles cycles) {
+	if(did_modify_code_) {
+		did_modify_code_ = false;
+		resynchronise();
+	}
+
+	// Interrupts are otherwise accepted only upon branches, so check for one now in case
+	// the code being run doesn't branch for a while.
+	if(interrupt_pending_) {
+		perform_interrupt();
+	}
+
+	if(is_halted_) {
+		subtract_duration(-cycles.as<int>());
+		idle_while_halted();
+		return;
+	}
+
+	CachingExecutor::run_for(cycles.as<int>());
+}
+
+void Executor::reset() {
+	iff1_ = iff2_ = false;
+	interrupt_mode_ = 0;
+	sp_.full = 0xffff;
+	a_ = 0xff;
+	set_flags(0xff);
+	i_ = r_ = refresh_count_ = 0;
+	is_halted_ = false;
+	nmi_pending_ = false;
+	update_interrupt_pending();
+
+	program_counter_ = 0;
+	did_set_program_counter_ = true;
+	resynchronise();
+}
+
+void Executor::memory_did_change(uint16_t begin, uint16_t end) {
+	// Resynchronise only upon the next instruction boundary, as this may be a trap handler,
+	// or someone else acting in the middle of an instruction.
+	invalidate_code(begin, end);
+	did_modify_code_ = true;
+}
+
+void Executor::add_trap_address(uint16_t address) {
+	traps_[address] = true;
+	memory_did_change(address, address);
+}
+
+void Executor::set_interrupt_line(bool value) {
+	irq_line_ = value;
+	update_interrupt_pending();
+}
+
+void Executor::set_non_maskable_interrupt_line(bool value) {
+	// NMIs are edge triggered.
+	if(value && !nmi_line_) {
+		nmi_pending_ = true;
+	}
+	nmi_line_ = value;
+	update_interrupt_pending();
+}
+
+uint16_t Executor::get_value_of_register(CPU::Z80::Register reg) const {
+	using Register = CPU::Z80::Register;
+	switch(reg) {
+		case Register::ProgramCounter:			return program_counter_;
+		case Register::StackPointer:			return sp_.full;
+
+		case Register::A:						return a_;
+		case Register::Flags:					return get_flags();
+		case Register::AF:						return uint16_t((a_ << 8) | get_flags());
+		case Register::B:						return bc_.halves.high;
+		case Register::C:						return bc_.halves.low;
+		case Register::BC:						return bc_.full;
+		case Register::D:						return de_.halves.high;
+		case Register::E:						return de_.halves.low;
+		case Register::DE:						return de_.full;
+		case Register::H:						return hl_.halves.high;
+		case Register::L:						return hl_.halves.low;
+		case Register::HL:						return hl_.full;
+
+		case Register::ADash:					return af_dash_.halves.high;
+		case Register::FlagsDash:				return af_dash_.halves.low;
+		case Register::AFDash:					return af_dash_.full;
+		case Register::BDash:					return bc_dash_.halves.high;
+		case Register::CDash:					return bc_dash_.halves.low;
+		case Register::BCDash:					return bc_dash_.full;
+		case Register::DDash:					return de_dash_.halves.high;
+		case Register::EDash:					return de_dash_.halves.low;
+		case Register::DEDash:					return de_dash_.full;
+		case Register::HDash:					return hl_dash_.halves.high;
+		case Register::LDash:					return hl_dash_.halves.low;
+		case Register::HLDash:					return hl_dash_.full;
+
+		case Register::IXh:						return ix_.halves.high;
+		case Register::IXl:						return ix_.halves.low;
+		case Register::IX:						return ix_.full;
+		case Register::IYh:						return iy_.halves.high;
+		case Register::IYl:						return iy_.halves.low;
+		case Register::IY:						return iy_.full;
+
+		case Register::R:						return r();
+		case Register::I:						return i_;
+		case Register::Refresh:					return uint16_t((i_ << 8) | r());
+
+		case Register::IFF1:					return iff1_ ? 1 : 0;
+		case Register::IFF2:					return iff2_ ? 1 : 0;
+		case Register::IM:						return uint16_t(interrupt_mode_);
+
+		case Register::MemPtr:					return memptr_.full;
+
+		default: return 0;
+	}
+}
+
+void Executor::set_value_of_register(CPU::Z80::Register r, uint16_t value) {
+	using Register = CPU::Z80::Register;
+	switch(r) {
+		case Register::ProgramCounter:
+			program_counter_ = value;
+			is_halted_ = false;
+			did_set_program_counter_ = true;
+			resynchronise();
+		break;
+		case Register::StackPointer:	sp_.full = value;				break;
+
+		case Register::A:				a_ = uint8_t(value);			break;
+		case Register::AF:				a_ = uint8_t(value >> 8);		[[fallthrough]];
+		case Register::Flags:			set_flags(uint8_t(value));		break;
+
+		case Register::B:				bc_.halves.high = uint8_t(value);	break;
+		case Register::C:				bc_.halves.low = uint8_t(value);	break;
+		case Register::BC:				bc_.full = value;					break;
+		case Register::D:				de_.halves.high = uint8_t(value);	break;
+		case Register::E:				de_.halves.low = uint8_t(value);	break;
+		case Register::DE:				de_.full = value;					break;
+		case Register::H:				hl_.halves.high = uint8_t(value);	break;
+		case Register::L:				hl_.halves.low = uint8_t(value);	break;
+		case Register::HL:				hl_.full = value;					break;
+
+		case Register::ADash:			af_dash_.halves.high = uint8_t(value);	break;
+		case Register::FlagsDash:		af_dash_.halves.low = uint8_t(value);	break;
+		case Register::AFDash:			af_dash_.full = value;					break;
+		case Register::BDash:			bc_dash_.halves.high = uint8_t(value);	break;
+		case Register::CDash:			bc_dash_.halves.low = uint8_t(value);	break;
+		case Register::BCDash:			bc_dash_.full = value;					break;
+		case Register::DDash:			de_dash_.halves.high = uint8_t(value);	break;
+		case Register::EDash:			de_dash_.halves.low = uint8_t(value);	break;
+		case Register::DEDash:			de_dash_.full = value;					break;
+		case Register::HDash:			hl_dash_.halves.high = uint8_t(value);	break;
+		case Register::LDash:			hl_dash_.halves.low = uint8_t(value);	break;
+		case Register::HLDash:			hl_dash_.full = value;					break;
+
+		case Register::IXh:				ix_.halves.high = uint8_t(value);		break;
+		case Register::IXl:				ix_.halves.low = uint8_t(value);		break;
+		case Register::IX:				ix_.full = value;						break;
+		case Register::IYh:				iy_.halves.high = uint8_t(value);		break;
+		case Register::IYl:				iy_.halves.low = uint8_t(value);		break;
+		case Register::IY:				iy_.full = value;						break;
+
+		case Register::R:				r_ = uint8_t(value);	refresh_count_ = 0;		break;
+		case Register::I:				i_ = uint8_t(value);							break;
+		case Register::Refresh:
+			i_ = uint8_t(value >> 8);
+			r_ = uint8_t(value);
+			refresh_count_ = 0;
+		break;
+
+		case Register::IFF1:			iff1_ = !!value;	update_interrupt_pending();	break;
+		case Register::IFF2:			iff2_ = !!value;								break;
+		case Register::IM:				interrupt_mode_ = value % 3;					break;
+
+		case Register::MemPtr:			memptr_.full = value;			break;
+
+		default: break;
+	}
+}
+
+void Executor::get_state(CPU::Z80::State &state) const {
+	using Phase = CPU::Z80::State::ExecutionState::Phase;
+
+	state.registers.a = a_;
+	state.registers.flags = get_flags();
+	state.registers.bc = bc_.full;
+	state.registers.de = de_.full;
+	state.registers.hl = hl_.full;
+	state.registers.af_dash = af_dash_.full;
+	state.registers.bc_dash = bc_dash_.full;
+	state.registers.de_dash = de_dash_.full;
+	state.registers.hl_dash = hl_dash_.full;
+	state.registers.ix = ix_.full;
+	state.registers.iy = iy_.full;
+	state.registers.ir = uint16_t((i_ << 8) | r());
+	state.registers.program_counter = program_counter_;
+	state.registers.stack_pointer = sp_.full;
+	state.registers.memptr = memptr_.full;
+	state.registers.interrupt_mode = interrupt_mode_;
+	state.registers.iff1 = iff1_;
+	state.registers.iff2 = iff2_;
+
+	state.inputs.irq = irq_line_;
+	state.inputs.nmi = nmi_line_;
+	state.inputs.bus_request = false;
+	state.inputs.wait = false;
+
+	// The executor is always at an instruction boundary, which the processor represents
+	// as the very start of its fetch-decode-execute sequence.
+	auto &execution_state = state.execution_state;
+	execution_state.is_halted = is_halted_;
+	execution_state.requests = uint8_t(((irq_line_ && iff1_) ? 0x01 : 0x00) | (nmi_pending_ ? 0x02 : 0x00));
+	execution_state.last_requests = execution_state.requests;
+	execution_state.temp8 = 0;
+	execution_state.operation = 0;
+	execution_state.temp16 = 0;
+	execution_state.flag_adjustment_history = flag_adjustment_history_;
+	execution_state.pc_increment = 1;
+	execution_state.refresh_address = state.registers.ir;
+	execution_state.phase = Phase::FetchDecode;
+	execution_state.half_cycles_into_step = remaining_duration() * 2;
+	execution_state.steps_into_phase = 0;
+	execution_state.instruction_page = 0;
+}
+
+void Executor::set_state(const CPU::Z80::State &state) {
+	a_ = state.registers.a;
+	set_flags(state.registers.flags);
+	bc_.full = state.registers.bc;
+	de_.full = state.registers.de;
+	hl_.full = state.registers.hl;
+	af_dash_.full = state.registers.af_dash;
+	bc_dash_.full = state.registers.bc_dash;
+	de_dash_.full = state.registers.de_dash;
+	hl_dash_.full = state.registers.hl_dash;
+	ix_.full = state.registers.ix;
+	iy_.full = state.registers.iy;
+	i_ = uint8_t(state.registers.ir >> 8);
+	r_ = uint8_t(state.registers.ir);
+	refresh_count_ = 0;
+	sp_.full = state.registers.stack_pointer;
+	memptr_.full = state.registers.memptr;
+	interrupt_mode_ = state.registers.interrupt_mode;
+	iff1_ = state.registers.iff1;
+	iff2_ = state.registers.iff2;
+
+	irq_line_ = state.inputs.irq;
+	nmi_line_ = state.inputs.nmi;
+	nmi_pending_ = state.execution_state.requests & 0x02;
+	update_interrupt_pending();
+
+	is_halted_ = state.execution_state.is_halted;
+	flag_adjustment_history_ = state.execution_state.flag_adjustment_history;
+	subtract_duration(remaining_duration() - state.execution_state.half_cycles_into_step / 2);
+
+	program_counter_ = state.registers.program_counter;
+	did_set_program_counter_ = true;
+	resynchronise();
+}
+
+// MARK: - Flow control.
+
+void Executor::resynchronise() {
+	set_program_counter(program_counter_);
+}
+
+void Executor::branch(uint16_t address) {
+	// Any code modification is dealt with by the new translation lookup implied by moving the program counter.
+	did_modify_code_ = false;
+
+	if(interrupt_pending_) {
+		program_counter_ = address;
+		perform_interrupt();
+		return;
+	}
+	set_program_counter(address);
+}
+
+void Executor::perform_interrupt() {
+	is_halted_ = false;
+
+	if(nmi_pending_) {
+		nmi_pending_ = false;
+		iff2_ = iff1_;
+		iff1_ = false;
+		update_interrupt_pending();
+
+		push(program_counter_);
+		subtract_duration(11);
+		set_program_counter(0x66);
+		did_modify_code_ = false;
+		return;
+	}
+
+	iff1_ = iff2_ = false;
+	update_interrupt_pending();
+
+	uint16_t target;
+	switch(interrupt_mode_) {
+		default: {
+			// Only RSTs are supported in mode 0; anything else is treated as RST 38h.
+			const uint8_t opcode = bus_handler_.interrupt_acknowledge();
+			flag_adjustment_history_ <<= 1;
+			target = (opcode & 0xc7) == 0xc7 ? (opcode & 0x38) : 0x38;
+			memptr_.full = target;
+			subtract_duration(11);
+		} break;
+
+		case 1:
+			target = 0x38;
+			subtract_duration(13);
+		break;
+
+		case 2: {
+			const uint8_t vector = bus_handler_.interrupt_acknowledge();
+			memptr_.full = uint16_t((i_ << 8) | vector);
+			target = read16(memptr_.full);
+			subtract_duration(19);
+		} break;
+	}
+
+	push(program_counter_);
+	set_program_counter(target);
+	did_modify_code_ = false;
+}
+
+void Executor::idle_while_halted() {
+	// A halted Z80 repeatedly performs four-cycle refresh-only opcode fetches.
+	const int remaining = remaining_duration();
+	if(remaining <= 0) return;
+
+	const int steps = (remaining + 3) >> 2;
+	refresh_count_ = uint8_t(refresh_count_ + steps);
+	flag_adjustment_history_ <<= std::min(steps, 8);
+	subtract_duration(steps << 2);
+}
+
+void Executor::perform_trap() {
+	did_set_program_counter_ = false;
+	bus_handler_.did_reach_trap(program_counter_);
+	if(did_set_program_counter_) return;
+
+	const auto instruction = decode(memory_, program_counter_);
+	(this->*performers_[action_for(instruction)])();
+}
+
+// MARK: - Memory access.
+
+void Executor::invalidate_code(uint16_t begin, uint16_t end) {
+	CachingExecutor::invalidate(begin, end);
+
+	// Clear the code marks for all pages now dropped, other than the first few bytes of the
+	// first, which may belong to an instruction that began on the page before it and which
+	// has therefore not been dropped. Marks are only a hint, so any left over do no harm.
+	const int first_page = (begin > 3 ? begin - 3 : 0) >> page_shift;
+	const int last_page = end >> page_shift;
+	const int first = first_page ? (first_page << page_shift) + 3 : 0;
+	const int last = (last_page << page_shift) + int(page_size) - 1;
+	for(int address = first; address <= last; address++) {
+		code_[size_t(address)] = false;
+	}
+}
+
+void Executor::write(uint16_t address, uint8_t value) {
+	memory_[address] = value;
+	if(code_[address]) {
+		invalidate_code(address, address);
+		did_modify_code_ = true;
+	}
+}
+
+uint16_t Executor::read16(uint16_t address) const {
+	return uint16_t(read(address) | (read(uint16_t(address + 1)) << 8));
+}
+
+void Executor::write16(uint16_t address, uint16_t value) {
+	write(address, uint8_t(value));
+	write(uint16_t(address + 1), uint8_t(value >> 8));
+}
+
+void Executor::push(uint16_t value) {
+	--sp_.full;
+	write(sp_.full, uint8_t(value >> 8));
+	--sp_.full;
+	write(sp_.full, uint8_t(value));
+}
+
+uint16_t Executor::pop() {
+	const uint8_t low = read(sp_.full);
+	++sp_.full;
+	const uint8_t high = read(sp_.full);
+	++sp_.full;
+	return uint16_t(low | (high << 8));
+}
+
+// MARK: - Registers and flags.
+
+uint8_t Executor::get_flags() const {
+	return
+		(sign_result_ & Flag::Sign) |
+		(zero_result_ ? 0 : Flag::Zero) |
+		(bit53_result_ & (Flag::Bit5 | Flag::Bit3)) |
+		(half_carry_result_ & Flag::HalfCarry) |
+		(parity_overflow_result_ & Flag::Parity) |
+		subtract_flag_ |
+		(carry_result_ & Flag::Carry);
+}
+
+void Executor::set_flags(uint8_t flags) {
+	sign_result_			= flags;
+	zero_result_			= (flags & Flag::Zero) ^ Flag::Zero;
+	bit53_result_			= flags;
+	half_carry_result_		= flags;
+	parity_overflow_result_	= flags;
+	subtract_flag_			= flags & Flag::Subtract;
+	carry_result_			= flags;
+}
+
+template <Executor::Index index> CPU::RegisterPair16 &Executor::index_register() {
+	if constexpr (index == Index::HL) return hl_;
+	else if constexpr (index == Index::IX) return ix_;
+	else return iy_;
+}
+
+template <int r, Executor::Index index> uint8_t &Executor::register8() {
+	static_assert(r != 6, "(HL) is not a register");
+	if constexpr (r == 0) return bc_.halves.high;
+	else if constexpr (r == 1) return bc_.halves.low;
+	else if constexpr (r == 2) return de_.halves.high;
+	else if constexpr (r == 3) return de_.halves.low;
+	else if constexpr (r == 4) return index_register<index>().halves.high;
+	else if constexpr (r == 5) return index_register<index>().halves.low;
+	else return a_;
+}
+
+template <int p, Executor::Index index> uint16_t &Executor::register16() {
+	if constexpr (p == 0) return bc_.full;
+	else if constexpr (p == 1) return de_.full;
+	else if constexpr (p == 2) return index_register<index>().full;
+	else return sp_.full;
+}
+
+template <int cc> bool Executor::condition() const {
+	switch(cc) {
+		default:	return zero_result_;
+		case 1:		return !zero_result_;
+		case 2:		return !(carry_result_ & Flag::Carry);
+		case 3:		return carry_result_ & Flag::Carry;
+		case 4:		return !(parity_overflow_result_ & Flag::Parity);
+		case 5:		return parity_overflow_result_ & Flag::Parity;
+		case 6:		return !(sign_result_ & Flag::Sign);
+		case 7:		return sign_result_ & Flag::Sign;
+	}
+}
+
+template <Executor::Index index> uint16_t Executor::memory_address() {
+	if constexpr (index == Index::HL) {
+		return hl_.full;
+	} else {
+		memptr_.full = uint16_t(index_register<index>().full + int8_t(operand(2)));
+		return memptr_.full;
+	}
+}
+
+// MARK: - Operations shared between pages.
+
+template <int y> void Executor::perform_alu(uint8_t value) {
+#define set_arithmetic_flags(sub, b53)	\
+	sign_result_ = zero_result_ = uint8_t(result);	\
+	carry_result_ = uint8_t(result >> 8);	\
+	half_carry_result_ = uint8_t(half_result);	\
+	parity_overflow_result_ = uint8_t(overflow >> 5);	\
+	subtract_flag_ = sub;	\
+	bit53_result_ = uint8_t(b53);	\
+	set_flags_computed();
+
+#define set_logical_flags(hf)	\
+	sign_result_ = zero_result_ = bit53_result_ = a_;	\
+	parity_overflow_result_ = FlagTables::parity[a_];	\
+	half_carry_result_ = hf;	\
+	subtract_flag_ = 0;	\
+	carry_result_ = 0;	\
+	set_flags_computed();
+
+	if constexpr (y == 0 || y == 1) {
+		// ADD and ADC.
+		const int carry = y == 1 ? (carry_result_ & Flag::Carry) : 0;
+		const int result = a_ + value + carry;
+		const int half_result = (a_&0xf) + (value&0xf) + carry;
+		const int overflow = ~(value^a_) & (result^a_);
+		a_ = uint8_t(result);
+		set_arithmetic_flags(0, result);
+	} else if constexpr (y == 2 || y == 3 || y == 7) {
+		// SUB, SBC and CP.
+		const int carry = y == 3 ? (carry_result_ & Flag::Carry) : 0;
+		const int result = a_ - value - carry;
+		const int half_result = (a_&0xf) - (value&0xf) - carry;
+		const int overflow = (value^a_) & (result^a_);
+		if constexpr (y == 7) {
+			// The 5 and 3 flags come from the operand, atypically.
+			set_arithmetic_flags(Flag::Subtract, value);
+		} else {
+			a_ = uint8_t(result);
+			set_arithmetic_flags(Flag::Subtract, result);
+		}
+	} else if constexpr (y == 4) {
+		a_ &= value;
+		set_logical_flags(Flag::HalfCarry);
+	} else if constexpr (y == 5) {
+		a_ ^= value;
+		set_logical_flags(0);
+	} else {
+		a_ |= value;
+		set_logical_flags(0);
+	}
+
+#undef set_logical_flags
+#undef set_arithmetic_flags
+}
+
+template <int y> uint8_t Executor::perform_shift(uint8_t value) {
+	switch(y) {
+		default:	// RLC
+			carry_result_ = value >> 7;
+			value = uint8_t((value << 1) | carry_result_);
+		break;
+		case 1:		// RRC
+			carry_result_ = value;
+			value = uint8_t((value >> 1) | (carry_result_ << 7));
+		break;
+		case 2: {	// RL
+			const uint8_t next_carry = value >> 7;
+			value = uint8_t((value << 1) | (carry_result_ & Flag::Carry));
+			carry_result_ = next_carry;
+		} break;
+		case 3: {	// RR
+			const uint8_t next_carry = value;
+			value = uint8_t((value >> 1) | (carry_result_ << 7));
+			carry_result_ = next_carry;
+		} break;
+		case 4:		// SLA
+			carry_result_ = value >> 7;
+			value = uint8_t(value << 1);
+		break;
+		case 5:		// SRA
+			carry_result_ = value;
+			value = uint8_t((value >> 1) | (value & 0x80));
+		break;
+		case 6:		// SLL
+			carry_result_ = value >> 7;
+			value = uint8_t((value << 1) | 1);
+		break;
+		case 7:		// SRL
+			carry_result_ = value;
+			value >>= 1;
+		break;
+	}
+
+	sign_result_ = zero_result_ = bit53_result_ = value;
+	parity_overflow_result_ = FlagTables::parity[value];
+	half_carry_result_ = 0;
+	subtract_flag_ = 0;
+	set_flags_computed();
+	return value;
+}
+
+template <int y, bool is_memory> void Executor::perform_bit(uint8_t value) {
+	const uint8_t result = value & (1 << y);
+
+	// MEMPTR leaks into bits 5 and 3 if this is either BIT n,(HL) or BIT n,(IX/IY+d).
+	bit53_result_ = is_memory ? memptr_.halves.high : value;
+	sign_result_ = zero_result_ = result;
+	half_carry_result_ = Flag::HalfCarry;
+	subtract_flag_ = 0;
+	parity_overflow_result_ = result ? 0 : Flag::Parity;
+	set_flags_computed();
+}
+
+// MARK: - Block operations.
+//
+// The repeating forms iterate within a single performer for as long as time remains, there is
+// no interrupt to accept and they haven't modified code; otherwise they branch to themselves.
+
+#define REPEAT_BLOCK(test)	\
+	if(!repeat || !(test)) {	\
+		advance<2, 16>();	\
+		return;	\
+	}	\
+	subtract_duration(21);	\
+	if(remaining_duration() <= 0 || did_modify_code_ || interrupt_pending_) {	\
+		branch(program_counter_);	\
+		return;	\
+	}	\
+	begin<2, 2>();
+
+template <int direction, bool repeat> void Executor::perform_ld_block() {
+	while(true) {
+		const uint8_t value = read(hl_.full);
+		write(de_.full, value);
+
+		--bc_.full;
+		de_.full += direction;
+		hl_.full += direction;
+
+		const uint8_t sum = a_ + value;
+		bit53_result_ = uint8_t((sum&0x8) | ((sum & 0x02) << 4));
+		subtract_flag_ = 0;
+		half_carry_result_ = 0;
+		parity_overflow_result_ = bc_.full ? Flag::Parity : 0;
+		set_flags_computed();
+
+		if(repeat && bc_.full) memptr_.full = program_counter_ + 1;
+		REPEAT_BLOCK(bc_.full);
+	}
+}
+
+template <int direction, bool repeat> void Executor::perform_cp_block() {
+	while(true) {
+		const uint8_t value = read(hl_.full);
+
+		hl_.full += direction;
+		memptr_.full += direction;
+		--bc_.full;
+
+		uint8_t result = a_ - value;
+		const uint8_t half_result = (a_&0xf) - (value&0xf);
+
+		parity_overflow_result_ =  bc_.full ? Flag::Parity : 0;
+		half_carry_result_ = half_result;
+		subtract_flag_ = Flag::Subtract;
+		sign_result_ = zero_result_ = result;
+
+		result -= (half_result >> 4)&1;
+		bit53_result_ = uint8_t((result&0x8) | ((result&0x2) << 4));
+		set_flags_computed();
+
+		if(repeat && bc_.full && sign_result_) memptr_.full = program_counter_ + 1;
+		REPEAT_BLOCK(bc_.full && sign_result_);
+	}
+}
+
+template <int direction, bool repeat> void Executor::perform_in_block() {
+	while(true) {
+		const uint8_t value = bus_handler_.input(bc_.full);
+		write(hl_.full, value);
+
+		memptr_.full = uint16_t(bc_.full + direction);
+		--bc_.halves.high;
+		hl_.full += direction;
+
+		sign_result_ = zero_result_ = bit53_result_ = bc_.halves.high;
+		subtract_flag_ = (value >> 6) & Flag::Subtract;
+
+		const int next_bc = bc_.halves.low + direction;
+		const int summation = value + (next_bc&0xff);
+		carry_result_ = half_carry_result_ = summation > 0xff ? (Flag::Carry | Flag::HalfCarry) : 0;
+		parity_overflow_result_ = FlagTables::parity[uint8_t((summation&7) ^ bc_.halves.high)];
+		set_flags_computed();
+
+		REPEAT_BLOCK(bc_.halves.high);
+	}
+}
+
+template <int direction, bool repeat> void Executor::perform_out_block() {
+	while(true) {
+		const uint8_t value = read(hl_.full);
+
+		--bc_.halves.high;
+		memptr_.full = uint16_t(bc_.full + direction);
+		hl_.full += direction;
+
+		sign_result_ = zero_result_ = bit53_result_ = bc_.halves.high;
+		subtract_flag_ = (value >> 6) & Flag::Subtract;
+
+		const int summation = value + hl_.halves.low;
+		carry_result_ = half_carry_result_ = summation > 0xff ? (Flag::Carry | Flag::HalfCarry) : 0;
+		parity_overflow_result_ = FlagTables::parity[uint8_t((summation&7) ^ bc_.halves.high)];
+		set_flags_computed();
+
+		bus_handler_.output(bc_.full, value);
+
+		REPEAT_BLOCK(bc_.halves.high);
+	}
+}
+
+#undef REPEAT_BLOCK
+
+// MARK: - Performers.
+
+template <Z80::Page page, uint8_t opcode> void Executor::perform() {
+	if constexpr (page == Z80::Page::Base)			perform_base<Index::HL, opcode>();
+	else if constexpr (page == Z80::Page::DD)		perform_base<Index::IX, opcode>();
+	else if constexpr (page == Z80::Page::FD)		perform_base<Index::IY, opcode>();
+	else if constexpr (page == Z80::Page::CB)		perform_cb<Index::HL, opcode>();
+	else if constexpr (page == Z80::Page::DDCB)		perform_cb<Index::IX, opcode>();
+	else if constexpr (page == Z80::Page::FDCB)		perform_cb<Index::IY, opcode>();
+	else										perform_ed<opcode>();
+}
+
+template <Executor::Index index, uint8_t opcode> void Executor::perform_base() {
+	constexpr bool indexed = index != Index::HL;
+	constexpr int x = opcode >> 6, y = (opcode >> 3) & 7, z = opcode & 7, p = y >> 1, q = y & 1;
+
+	// Offset of anything following the opcode; cost of the prefix; cost of (IX+d) versus (HL).
+	constexpr int prefix = indexed ? 1 : 0;
+	constexpr int extra = indexed ? 4 : 0;
+	constexpr int memory_extra = indexed ? 12 : 0;
+	constexpr int length = Z80::length(index == Index::HL ? Z80::Page::Base : (index == Index::IX ? Z80::Page::DD : Z80::Page::FD), opcode);
+
+	if constexpr (is_superseding_prefix(opcode) || opcode == 0xcb) {
+		// A DD or FD that is followed by another prefix acts as a four-cycle NOP; the CB and ED
+		// opcodes of the unprefixed page are never reached, as they're decoded as pages of their own.
+		begin<1, 1>();
+		advance<1, 4>();
+		return;
+	}
+
+	begin<indexed ? 2 : 1, indexed ? 2 : 1>();
+
+	if constexpr (x == 0) {
+		if constexpr (z == 0) {
+			if constexpr (y == 0) {
+				advance<length, 4 + extra>();
+			} else if constexpr (y == 1) {
+				const uint8_t a = a_;
+				const uint8_t f = get_flags();
+				set_flags(af_dash_.halves.low);
+				a_ = af_dash_.halves.high;
+				af_dash_.halves.high = a;
+				af_dash_.halves.low = f;
+				advance<length, 4 + extra>();
+			} else if constexpr (y == 2) {
+				--bc_.halves.high;
+				if(bc_.halves.high) {
+					memptr_.full = uint16_t(program_counter_ + length + int8_t(operand(prefix + 1)));
+					subtract_duration(13 + extra);
+					branch(memptr_.full);
+				} else {
+					advance<length, 8 + extra>();
+				}
+			} else if constexpr (y == 3) {
+				memptr_.full = uint16_t(program_counter_ + length + int8_t(operand(prefix + 1)));
+				subtract_duration(12 + extra);
+				branch(memptr_.full);
+			} else {
+				if(condition<y - 4>()) {
+					memptr_.full = uint16_t(program_counter_ + length + int8_t(operand(prefix + 1)));
+					subtract_duration(12 + extra);
+					branch(memptr_.full);
+				} else {
+					advance<length, 7 + extra>();
+				}
+			}
+		} else if constexpr (z == 1) {
+			if constexpr (!q) {
+				register16<p, index>() = operand16(prefix + 1);
+				advance<length, 10 + extra>();
+			} else {
+				// ADD HL, rr.
+				auto &destination = index_register<index>().full;
+				const uint16_t source = register16<p, index>();
+				memptr_.full = destination;
+				const int result = source + destination;
+				const int half_result = (source&0xfff) + (destination&0xfff);
+
+				bit53_result_ = uint8_t(result >> 8);
+				carry_result_ = uint8_t(result >> 16);
+				half_carry_result_ = uint8_t(half_result >> 8);
+				subtract_flag_ = 0;
+				set_flags_computed();
+
+				destination = uint16_t(result);
+				++memptr_.full;
+				advance<length, 11 + extra>();
+			}
+		} else if constexpr (z == 2) {
+			if constexpr (p < 2) {
+				const uint16_t address = p ? de_.full : bc_.full;
+				if constexpr (!q) {
+					memptr_.full = uint16_t(((address + 1)&0xff) + (a_ << 8));
+					write(address, a_);
+				} else {
+					memptr_.full = uint16_t(address + 1);
+					a_ = read(address);
+				}
+				advance<length, 7 + extra>();
+			} else {
+				const uint16_t address = operand16(prefix + 1);
+				if constexpr (p == 2) {
+					auto &target = index_register<index>().full;
+					if constexpr (!q) write16(address, target);
+					else target = read16(address);
+					memptr_.full = uint16_t(address + 1);
+					advance<length, 16 + extra>();
+				} else {
+					if constexpr (!q) {
+						memptr_.full = uint16_t(((address + 1)&0xff) + (a_ << 8));
+						write(address, a_);
+					} else {
+						memptr_.full = uint16_t(address + 1);
+						a_ = read(address);
+					}
+					advance<length, 13 + extra>();
+				}
+			}
+		} else if constexpr (z == 3) {
+			if constexpr (!q) ++register16<p, index>();
+			else --register16<p, index>();
+			advance<length, 6 + extra>();
+		} else if constexpr (z == 4 || z == 5) {
+			// INC r and DEC r.
+			const auto apply = [this] (uint8_t value) -> uint8_t {
+				if constexpr (z == 4) {
+					const int result = value + 1;
+					const int overflow = (value ^ result) & ~value;
+					const int half_result = (value&0xf) + 1;
+					half_carry_result_ = uint8_t(half_result);
+					parity_overflow_result_ = uint8_t(overflow >> 5);
+					subtract_flag_ = 0;
+					bit53_result_ = sign_result_ = zero_result_ = uint8_t(result);
+				} else {
+					const int result = value - 1;
+					const int overflow = (value ^ result) & value;
+					const int half_result = (value&0xf) - 1;
+					half_carry_result_ = uint8_t(half_result);
+					parity_overflow_result_ = uint8_t(overflow >> 5);
+					subtract_flag_ = Flag::Subtract;
+					bit53_result_ = sign_result_ = zero_result_ = uint8_t(result);
+				}
+				set_flags_computed();
+				return sign_result_;
+			};
+
+			if constexpr (y == 6) {
+				const uint16_t address = memory_address<index>();
+				write(address, apply(read(address)));
+				advance<length, 11 + memory_extra>();
+			} else {
+				auto &target = register8<y, index>();
+				target = apply(target);
+				advance<length, 4 + extra>();
+			}
+		} else if constexpr (z == 6) {
+			if constexpr (y == 6) {
+				const uint16_t address = memory_address<index>();
+				write(address, operand(indexed ? 3 : 1));
+				advance<length, indexed ? 19 : 10>();
+			} else {
+				register8<y, index>() = operand(prefix + 1);
+				advance<length, 7 + extra>();
+			}
+		} else {
+			switch(y) {
+				case 0: {	// RLCA
+					const uint8_t new_carry = a_ >> 7;
+					a_ = uint8_t((a_ << 1) | new_carry);
+					carry_result_ = new_carry;
+					bit53_result_ = a_;
+					subtract_flag_ = half_carry_result_ = 0;
+				} break;
+				case 1: {	// RRCA
+					const uint8_t new_carry = a_ & 1;
+					a_ = uint8_t((a_ >> 1) | (new_carry << 7));
+					carry_result_ = new_carry;
+					bit53_result_ = a_;
+					subtract_flag_ = half_carry_result_ = 0;
+				} break;
+				case 2: {	// RLA
+					const uint8_t new_carry = a_ >> 7;
+					a_ = uint8_t((a_ << 1) | (carry_result_ & Flag::Carry));
+					carry_result_ = new_carry;
+					bit53_result_ = a_;
+					subtract_flag_ = half_carry_result_ = 0;
+				} break;
+				case 3: {	// RRA
+					const uint8_t new_carry = a_ & 1;
+					a_ = uint8_t((a_ >> 1) | (carry_result_ << 7));
+					carry_result_ = new_carry;
+					bit53_result_ = a_;
+					subtract_flag_ = half_carry_result_ = 0;
+				} break;
+				case 4: {	// DAA
+					const uint16_t result = FlagTables::daa[FlagTables::daa_index(a_, carry_result_ & Flag::Carry, half_carry_result_ & Flag::HalfCarry, subtract_flag_)];
+					a_ = uint8_t(result);
+					sign_result_ = zero_result_ = bit53_result_ = a_;
+
+					const uint8_t flags = uint8_t(result >> 8);
+					carry_result_ = flags & Flag::Carry;
+					half_carry_result_ = flags & Flag::HalfCarry;
+					parity_overflow_result_ = flags & Flag::Parity;
+				} break;
+				case 5:		// CPL
+					a_ ^= 0xff;
+					subtract_flag_ = Flag::Subtract;
+					half_carry_result_ = Flag::HalfCarry;
+					bit53_result_ = a_;
+				break;
+				case 6:		// SCF
+				case 7:		// CCF
+					if(y == 6) {
+						carry_result_ = Flag::Carry;
+						half_carry_result_ = 0;
+					} else {
+						half_carry_result_ = uint8_t(carry_result_ << 4);
+						carry_result_ ^= Flag::Carry;
+					}
+					subtract_flag_ = 0;
+					if(flag_adjustment_history_&2) {
+						bit53_result_ = a_;
+					} else {
+						bit53_result_ |= a_;
+					}
+				break;
+			}
+			set_flags_computed();
+			advance<length, 4 + extra>();
+		}
+	} else if constexpr (x == 1) {
+		if constexpr (opcode == 0x76) {
+			is_halted_ = true;
+			advance<length, 4 + extra>();
+			idle_while_halted();
+		} else if constexpr (z == 6) {
+			// With a memory operand, the other register is never substituted.
+			register8<y, Index::HL>() = read(memory_address<index>());
+			advance<length, 7 + memory_extra>();
+		} else if constexpr (y == 6) {
+			write(memory_address<index>(), register8<z, Index::HL>());
+			advance<length, 7 + memory_extra>();
+		} else {
+			register8<y, index>() = register8<z, index>();
+			advance<length, 4 + extra>();
+		}
+	} else if constexpr (x == 2) {
+		if constexpr (z == 6) {
+			perform_alu<y>(read(memory_address<index>()));
+			advance<length, 7 + memory_extra>();
+		} else {
+			perform_alu<y>(register8<z, index>());
+			advance<length, 4 + extra>();
+		}
+	} else {
+		if constexpr (z == 0) {
+			if(condition<y>()) {
+				memptr_.full = pop();
+				subtract_duration(11 + extra);
+				branch(memptr_.full);
+			} else {
+				advance<length, 5 + extra>();
+			}
+		} else if constexpr (z == 1) {
+			if constexpr (!q) {
+				const uint16_t value = pop();
+				if constexpr (p == 3) {
+					a_ = uint8_t(value >> 8);
+					set_flags(uint8_t(value));
+				} else {
+					register16<p, index>() = value;
+				}
+				advance<length, 10 + extra>();
+			} else if constexpr (p == 0) {
+				memptr_.full = pop();
+				subtract_duration(10 + extra);
+				branch(memptr_.full);
+			} else if constexpr (p == 1) {
+				std::swap(bc_.full, bc_dash_.full);
+				std::swap(de_.full, de_dash_.full);
+				std::swap(hl_.full, hl_dash_.full);
+				advance<length, 4 + extra>();
+			} else if constexpr (p == 2) {
+				subtract_duration(4 + extra);
+				branch(index_register<index>().full);
+			} else {
+				sp_.full = index_register<index>().full;
+				advance<length, 6 + extra>();
+			}
+		} else if constexpr (z == 2) {
+			memptr_.full = operand16(prefix + 1);
+			if(condition<y>()) {
+				subtract_duration(10 + extra);
+				branch(memptr_.full);
+			} else {
+				advance<length, 10 + extra>();
+			}
+		} else if constexpr (z == 3) {
+			if constexpr (y == 0) {
+				memptr_.full = operand16(prefix + 1);
+				subtract_duration(10 + extra);
+				branch(memptr_.full);
+			} else if constexpr (y == 2) {
+				const uint8_t port = operand(prefix + 1);
+				bus_handler_.output(uint16_t((a_ << 8) | port), a_);
+				memptr_.full = uint16_t((a_ << 8) | uint8_t(port + 1));
+				advance<length, 11 + extra>();
+			} else if constexpr (y == 3) {
+				memptr_.full = uint16_t((a_ << 8) | operand(prefix + 1));
+				a_ = bus_handler_.input(memptr_.full);
+				++memptr_.full;
+				advance<length, 11 + extra>();
+			} else if constexpr (y == 4) {
+				auto &target = index_register<index>().full;
+				memptr_.full = pop();
+				push(target);
+				target = memptr_.full;
+				advance<length, 19 + extra>();
+			} else if constexpr (y == 5) {
+				// EX DE, HL is unaffected by DD and FD.
+				std::swap(de_.full, hl_.full);
+				advance<length, 4 + extra>();
+			} else if constexpr (y == 6) {
+				iff1_ = iff2_ = false;
+				update_interrupt_pending();
+				advance<length, 4 + extra>();
+			} else if constexpr (y == 7) {
+				iff1_ = iff2_ = true;
+				update_interrupt_pending();
+				advance<length, 4 + extra>();
+			}
+		} else if constexpr (z == 4) {
+			memptr_.full = operand16(prefix + 1);
+			if(condition<y>()) {
+				push(uint16_t(program_counter_ + length));
+				subtract_duration(17 + extra);
+				branch(memptr_.full);
+			} else {
+				advance<length, 10 + extra>();
+			}
+		} else if constexpr (z == 5) {
+			if constexpr (!q) {
+				if constexpr (p == 3) {
+					push(uint16_t((a_ << 8) | get_flags()));
+				} else {
+					push(register16<p, index>());
+				}
+				advance<length, 11 + extra>();
+			} else {
+				// Only CALL nn remains; the prefixes are dealt with above.
+				memptr_.full = operand16(prefix + 1);
+				push(uint16_t(program_counter_ + length));
+				subtract_duration(17 + extra);
+				branch(memptr_.full);
+			}
+		} else if constexpr (z == 6) {
+			perform_alu<y>(operand(prefix + 1));
+			advance<length, 7 + extra>();
+		} else {
+			push(uint16_t(program_counter_ + length));
+			memptr_.full = y << 3;
+			subtract_duration(11 + extra);
+			branch(memptr_.full);
+		}
+	}
+}
+
+template <Executor::Index index, uint8_t opcode> void Executor::perform_cb() {
+	constexpr int x = opcode >> 6, y = (opcode >> 3) & 7, z = opcode & 7;
+
+	const auto apply = [this] (uint8_t value) -> uint8_t {
+		if constexpr (x == 0) return perform_shift<y>(value);
+		else if constexpr (x == 2) return uint8_t(value & ~(1 << y));
+		else return uint8_t(value | (1 << y));
+	};
+
+	if constexpr (index == Index::HL) {
+		begin<2, 2>();
+		if constexpr (z == 6) {
+			const uint8_t value = read(hl_.full);
+			if constexpr (x == 1) {
+				perform_bit<y, true>(value);
+				advance<2, 12>();
+			} else {
+				write(hl_.full, apply(value));
+				advance<2, 15>();
+			}
+		} else {
+			auto &target = register8<z, Index::HL>();
+			if constexpr (x == 1) {
+				perform_bit<y, false>(target);
+			} else {
+				target = apply(target);
+			}
+			advance<2, 8>();
+		}
+	} else {
+		// The second prefix byte is preceded by an offset rather than followed by an opcode fetch,
+		// so there are two refreshes but three decodes.
+		begin<3, 2>();
+		const uint16_t address = memory_address<index>();
+		const uint8_t value = read(address);
+		if constexpr (x == 1) {
+			perform_bit<y, true>(value);
+			advance<4, 20>();
+		} else {
+			// Other than for (HL), the result is also copied to the register that z would otherwise indicate.
+			const uint8_t result = apply(value);
+			write(address, result);
+			if constexpr (z != 6) {
+				register8<z, Index::HL>() = result;
+			}
+			advance<4, 23>();
+		}
+	}
+}
+
+template <uint8_t opcode> void Executor::perform_ed() {
+	constexpr int x = opcode >> 6, y = (opcode >> 3) & 7, z = opcode & 7, p = y >> 1, q = y & 1;
+
+	begin<2, 2>();
+
+	if constexpr (x == 1) {
+		if constexpr (z == 0) {
+			// IN r, (C); IN (C) affects only the flags.
+			memptr_.full = uint16_t(bc_.full + 1);
+			const uint8_t value = bus_handler_.input(bc_.full);
+			if constexpr (y != 6) {
+				register8<y, Index::HL>() = value;
+			}
+			subtract_flag_ = half_carry_result_ = 0;
+			sign_result_ = zero_result_ = bit53_result_ = value;
+			parity_overflow_result_ = FlagTables::parity[value];
+			set_flags_computed();
+			advance<2, 12>();
+		} else if constexpr (z == 1) {
+			// OUT (C), r; OUT (C), 0.
+			if constexpr (y == 6) {
+				bus_handler_.output(bc_.full, 0);
+			} else {
+				bus_handler_.output(bc_.full, register8<y, Index::HL>());
+			}
+			memptr_.full = uint16_t(bc_.full + 1);
+			advance<2, 12>();
+		} else if constexpr (z == 2) {
+			// SBC HL, rr and ADC HL, rr.
+			memptr_.full = hl_.full;
+			const uint16_t source = register16<p, Index::HL>();
+			const uint16_t destination = hl_.full;
+			const int carry = carry_result_ & Flag::Carry;
+
+			int result, half_result, overflow;
+			if constexpr (!q) {
+				result = destination - source - carry;
+				half_result = (destination&0xfff) - (source&0xfff) - carry;
+				overflow = (result ^ destination) & (source ^ destination);
+				subtract_flag_ = Flag::Subtract;
+			} else {
+				result = source + destination + carry;
+				half_result = (source&0xfff) + (destination&0xfff) + carry;
+				overflow = (result ^ destination) & ~(destination ^ source);
+				subtract_flag_ = 0;
+			}
+
+			bit53_result_	=
+			sign_result_	= uint8_t(result >> 8);
+			zero_result_	= uint8_t(result | sign_result_);
+			carry_result_	= uint8_t(result >> 16);
+			half_carry_result_ = uint8_t(half_result >> 8);
+			parity_overflow_result_ = uint8_t(overflow >> 13);
+			set_flags_computed();
+
+			hl_.full = uint16_t(result);
+			++memptr_.full;
+			advance<2, 15>();
+		} else if constexpr (z == 3) {
+			const uint16_t address = operand16(2);
+			if constexpr (!q) {
+				write16(address, register16<p, Index::HL>());
+			} else {
+				register16<p, Index::HL>() = read16(address);
+			}
+			memptr_.full = uint16_t(address + 1);
+			advance<4, 20>();
+		} else if constexpr (z == 4) {
+			// NEG.
+			const int overflow = (a_ == 0x80);
+			const int result = -a_;
+			const int half_result = -(a_&0xf);
+
+			a_ = uint8_t(result);
+			bit53_result_ = sign_result_ = zero_result_ = a_;
+			parity_overflow_result_ = overflow ? Flag::Overflow : 0;
+			subtract_flag_ = Flag::Subtract;
+			carry_result_ = uint8_t(result >> 8);
+			half_carry_result_ = uint8_t(half_result);
+			set_flags_computed();
+			advance<2, 8>();
+		} else if constexpr (z == 5) {
+			// RETN, and RETI, which acts identically.
+			memptr_.full = pop();
+			iff1_ = iff2_;
+			update_interrupt_pending();
+			subtract_duration(14);
+			branch(memptr_.full);
+		} else if constexpr (z == 6) {
+			switch(opcode & 0x18) {
+				case 0x00:	interrupt_mode_ = 0;	break;
+				case 0x08:	interrupt_mode_ = 0;	break;	// IM 0/1
+				case 0x10:	interrupt_mode_ = 1;	break;
+				case 0x18:	interrupt_mode_ = 2;	break;
+			}
+			advance<2, 8>();
+		} else {
+			switch(y) {
+				case 0:		// LD I, A
+					i_ = a_;
+					advance<2, 9>();
+				break;
+				case 1:		// LD R, A
+					r_ = a_;
+					refresh_count_ = 0;
+					advance<2, 9>();
+				break;
+				case 2:		// LD A, I
+				case 3:		// LD A, R
+					a_ = y == 2 ? i_ : r();
+					subtract_flag_ = half_carry_result_ = 0;
+					parity_overflow_result_ = iff2_ ? Flag::Parity : 0;
+					sign_result_ = zero_result_ = bit53_result_ = a_;
+					set_flags_computed();
+					advance<2, 9>();
+				break;
+				case 4:		// RRD
+				case 5: {	// RLD
+					memptr_.full = uint16_t(hl_.full + 1);
+					uint8_t value = read(hl_.full);
+					const uint8_t low_nibble = a_ & 0xf;
+					if(y == 4) {
+						a_ = (a_ & 0xf0) | (value & 0xf);
+						value = uint8_t((value >> 4) | (low_nibble << 4));
+					} else {
+						a_ = (a_ & 0xf0) | (value >> 4);
+						value = uint8_t((value << 4) | low_nibble);
+					}
+					write(hl_.full, value);
+
+					subtract_flag_ = 0;
+					half_carry_result_ = 0;
+					parity_overflow_result_ = FlagTables::parity[a_];
+					bit53_result_ = zero_result_ = sign_result_ = a_;
+					set_flags_computed();
+					advance<2, 18>();
+				} break;
+				default:
+					advance<2, 8>();
+				break;
+			}
+		}
+	} else if constexpr (x == 2 && z <= 3 && y >= 4) {
+		constexpr int direction = (y & 1) ? -1 : 1;
+		constexpr bool repeat = y >= 6;
+		if constexpr (z == 0) perform_ld_block<direction, repeat>();
+		else if constexpr (z == 1) perform_cp_block<direction, repeat>();
+		else if constexpr (z == 2) perform_in_block<direction, repeat>();
+		else perform_out_block<direction, repeat>();
+	} else {
+		// Undefined ED opcodes act as eight-cycle NOPs.
+		advance<2, 8>();
+	}
+}
@@ -0,0 +1,257 @@
+//
+//  Executor.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 14/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#ifndef InstructionSets_Z80_Executor_hpp
+#define InstructionSets_Z80_Executor_hpp
+
+#include "Instruction.hpp"
+#include "Parser.hpp"
+#include "../CachingExecutor.hpp"
+#include "../../ClockReceiver/ClockReceiver.hpp"
+#include "../../Processors/RegisterSizes.hpp"
+#include "../../Processors/Z80/Z80.hpp"
+
+#include <bitset>
+#include <cstdint>
+#include <utility>
+
+namespace CPU {
+namespace Z80 {
+struct State;
+}
+}
+
+namespace InstructionSet {
+namespace Z80 {
+
+class Executor;
+
+/// One performer per opcode of each page, plus one for trap addresses.
+constexpr uint64_t TrapPerformer = PageCount * 256;
+using CachingExecutor = CachingExecutor<Executor, 0xffff, TrapPerformer + 1, 4, Instruction, false>;
+
+struct BusHandler {
+	virtual uint8_t input([[maybe_unused]] uint16_t port) { return 0xff; }
+	virtual void output([[maybe_unused]] uint16_t port, [[maybe_unused]] uint8_t value) {}
+
+	/// @returns The value placed on the data bus when an interrupt is acknowledged in mode 0 or 2.
+	virtual uint8_t interrupt_acknowledge() { return 0xff; }
+
+	/// Announces that execution has reached @c address, which was marked as a trap, just before the instruction there is performed.
+	virtual void did_reach_trap([[maybe_unused]] uint16_t address) {}
+};
+
+/*!
+	Executes Z80 code from a flat 64kb of RAM, for machines and test harnesses that don't need to
+	observe individual bus cycles, subject to the following limitations:
+
+		* timing is correct to whole-opcode boundaries only, and there are no wait states;
+		* interrupts are accepted only at the start of each call to @c run_for and upon taken branches,
+			rather than after any instruction; in interrupt mode 0 only RST instructions may be supplied;
+		* any change made to memory other than via the executor must be announced via @c memory_did_change; and
+		* traps are reported only as the instruction at the trap address is reached, not upon any other fetch from there.
+
+	Otherwise its results are identical to those of CPU::Z80::Processor, including undocumented flags, MEMPTR and R;
+	use @c get_state and @c set_state to move execution between the two when exact timing becomes necessary.
+*/
+class Executor: public CachingExecutor {
+	public:
+		/// Constructs an executor that will run code from the 64kb of RAM at @c memory, which is not copied.
+		Executor(uint8_t *memory, BusHandler &);
+
+		/*!
+			Runs, in discrete steps, the minimum number of instructions as it takes to complete at least @c cycles;
+			any excess is deducted from the next call.
+		*/
+		void run_for(Cycles cycles);
+
+		/// Performs the equivalent of the Z80 reset sequence.
+		void reset();
+
+		/// Discards any translation of code in the range [@c begin, @c end] following changes made to memory by some other actor.
+		void memory_did_change(uint16_t begin, uint16_t end);
+
+		/// Marks @c address as a trap, causing @c BusHandler::did_reach_trap to be called whenever execution reaches it.
+		void add_trap_address(uint16_t address);
+
+		uint16_t get_value_of_register(CPU::Z80::Register) const;
+		void set_value_of_register(CPU::Z80::Register, uint16_t value);
+
+		void set_interrupt_line(bool);
+		void set_non_maskable_interrupt_line(bool);
+		bool get_halt_line() const {
+			return is_halted_;
+		}
+
+		/// Captures complete processor state, in the format used by CPU::Z80::Processor.
+		void get_state(CPU::Z80::State &) const;
+
+		/// Adopts @c state, which must describe a processor that is at an instruction boundary.
+		void set_state(const CPU::Z80::State &state);
+
+	private:
+		// MARK: - CachingExecutor-facing interface.
+
+		friend CachingExecutor;
+
+		inline PerformerIndex action_for(Instruction instruction) {
+			return PerformerIndex(int(instruction.page) * 256 + instruction.opcode);
+		}
+
+		inline void parse(uint16_t start, uint16_t closing_bound) {
+			Parser<Executor> parser;
+			parser.parse(*this, memory_, start, closing_bound);
+		}
+
+		/*!
+			Passes @c instruction on to the CachingExecutor, records which bytes it occupies and, if it is
+			at a trap address, substitutes the trap performer.
+		*/
+		inline void announce_instruction(uint16_t address, Instruction instruction) {
+			CachingExecutor::announce_instruction(address, instruction);
+
+			const int length = instruction.length();
+			for(int c = 0; c < length; c++) {
+				code_[uint16_t(address + c)] = true;
+			}
+
+			if(traps_[address]) {
+				replace_action(0, PerformerIndex(TrapPerformer));
+			}
+		}
+		friend Parser<Executor>;
+
+		// MARK: - Performers.
+
+		enum class Index {
+			HL, IX, IY
+		};
+
+		template <Z80::Page page, size_t... opcodes> void install_performers(std::index_sequence<opcodes...>);
+
+		template <Z80::Page page, uint8_t opcode> void perform();
+		template <Index index, uint8_t opcode> void perform_base();
+		template <Index index, uint8_t opcode> void perform_cb();
+		template <uint8_t opcode> void perform_ed();
+		void perform_trap();
+
+		template <int y> void perform_alu(uint8_t value);
+		template <int y> uint8_t perform_shift(uint8_t value);
+		template <int y, bool is_memory> void perform_bit(uint8_t value);
+		template <int direction, bool repeat> void perform_ld_block();
+		template <int direction, bool repeat> void perform_cp_block();
+		template <int direction, bool repeat> void perform_in_block();
+		template <int direction, bool repeat> void perform_out_block();
+
+		void perform_interrupt();
+		void idle_while_halted();
+
+		/// Moves execution to @c address as the result of a branch, first accepting any pending interrupt.
+		inline void branch(uint16_t address);
+
+		/// Resumes translated execution at the current program counter.
+		inline void resynchronise();
+
+		// MARK: - Memory and port access.
+
+		uint8_t *const memory_;
+		BusHandler &bus_handler_;
+
+		/// Indicates every byte that belongs to an instruction in a translation that might still be cached.
+		std::bitset<65536> code_;
+		std::bitset<65536> traps_;
+
+		/// Set when a write has modified translated code, to end the current run of translated code after the current instruction.
+		bool did_modify_code_ = false;
+
+		/// Set whenever the program counter is moved other than by translated code, so that the trap performer can tell whether its handler did so.
+		bool did_set_program_counter_ = false;
+
+		inline uint8_t read(uint16_t address) const {
+			return memory_[address];
+		}
+		inline void write(uint16_t address, uint8_t value);
+		inline uint16_t read16(uint16_t address) const;
+		inline void write16(uint16_t address, uint16_t value);
+		inline void push(uint16_t value);
+		inline uint16_t pop();
+
+		/// @returns The byte @c offset bytes beyond the start of the current instruction.
+		inline uint8_t operand(int offset) const {
+			return memory_[uint16_t(program_counter_ + offset)];
+		}
+		inline uint16_t operand16(int offset) const {
+			return uint16_t(operand(offset) | (operand(offset + 1) << 8));
+		}
+
+		void invalidate_code(uint16_t begin, uint16_t end);
+
+		// MARK: - Instruction set state.
+
+		uint8_t a_ = 0xff;
+		CPU::RegisterPair16 bc_, de_, hl_;
+		CPU::RegisterPair16 af_dash_, bc_dash_, de_dash_, hl_dash_;
+		CPU::RegisterPair16 ix_, iy_, sp_, memptr_;
+		uint8_t i_ = 0;
+
+		// R is kept as its value when last set plus a count of subsequent increments, only the low seven bits of which are applied.
+		uint8_t r_ = 0, refresh_count_ = 0;
+		inline uint8_t r() const {
+			return uint8_t((r_ & 0x80) | ((r_ + refresh_count_) & 0x7f));
+		}
+
+		bool iff1_ = false, iff2_ = false;
+		int interrupt_mode_ = 0;
+		bool irq_line_ = false, nmi_line_ = false;
+		bool nmi_pending_ = false;
+		bool interrupt_pending_ = false;
+		inline void update_interrupt_pending() {
+			interrupt_pending_ = nmi_pending_ || (irq_line_ && iff1_);
+		}
+		bool is_halted_ = false;
+
+		// Flags are stored as per CPU::Z80::ProcessorStorage.
+		uint8_t sign_result_ = 0, zero_result_ = 0, half_carry_result_ = 0, bit53_result_ = 0;
+		uint8_t parity_overflow_result_ = 0, subtract_flag_ = 0, carry_result_ = 0;
+		unsigned int flag_adjustment_history_ = 0;
+
+		inline uint8_t get_flags() const;
+		inline void set_flags(uint8_t);
+		inline void set_flags_computed() {
+			flag_adjustment_history_ |= 1;
+		}
+
+		template <Index index> inline CPU::RegisterPair16 &index_register();
+		template <int r, Index index> inline uint8_t &register8();
+		template <int p, Index index> inline uint16_t &register16();
+		template <int cc> inline bool condition() const;
+
+		/// @returns The address of the current instruction's (HL) operand, i.e. HL, or IX or IY plus offset, also setting MEMPTR in the latter cases.
+		template <Index index> inline uint16_t memory_address();
+
+		/// Accounts for the opcode fetches of the current instruction.
+		template <int decodes, int refreshes> inline void begin() {
+			flag_adjustment_history_ <<= decodes;
+			refresh_count_ += refreshes;
+		}
+
+		/// Moves past the current instruction, which occupied @c length bytes and @c cycles cycles.
+		template <int length, int cycles> inline void advance() {
+			program_counter_ += length;
+			subtract_duration(cycles);
+			if(did_modify_code_) {
+				did_modify_code_ = false;
+				resynchronise();
+			}
+		}
+};
+
+}
+}
+
+#endif /* InstructionSets_Z80_Executor_hpp */
@@ -0,0 +1,142 @@
+//
+//  Instruction.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 14/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#ifndef InstructionSets_Z80_Instruction_hpp
+#define InstructionSets_Z80_Instruction_hpp
+
+#include <cstdint>
+
+namespace InstructionSet {
+namespace Z80 {
+
+/*!
+	Identifies the opcode table that an instruction comes from: the unprefixed table, those
+	selected by a CB, ED, DD or FD prefix, or those selected by DD CB or FD CB.
+*/
+enum class Page: uint8_t {
+	Base, CB, ED, DD, FD, DDCB, FDCB
+};
+constexpr int PageCount = 7;
+
+/*!
+	@returns The length of unprefixed opcode @c opcode, including any operands; if @c opcode
+		is the CB prefix then this is the length of all CB-page instructions.
+*/
+constexpr int base_length(uint8_t opcode) {
+	const int x = opcode >> 6, y = (opcode >> 3) & 7, z = opcode & 7, p = y >> 1, q = y & 1;
+	switch(x) {
+		case 0:
+			switch(z) {
+				case 0:	return y < 2 ? 1 : 2;	// NOP and EX AF, AF' versus DJNZ and JR.
+				case 1:	return q ? 1 : 3;		// ADD HL, rr versus LD rr, nn.
+				case 2:	return p < 2 ? 1 : 3;	// LD (BC)/(DE) versus LD (nn).
+				case 6:	return 2;				// LD r, n.
+				default: return 1;
+			}
+		case 3:
+			switch(z) {
+				case 2:	case 4:	return 3;					// JP cc, nn and CALL cc, nn.
+				case 3:	return y == 0 ? 3 : (y < 4 ? 2 : 1);	// JP nn; CB, OUT (n), A and IN A, (n); then the rest.
+				case 5:	return (q && !p) ? 3 : 1;			// CALL nn.
+				case 6:	return 2;							// ALU n.
+				default: return 1;
+			}
+		default: return 1;
+	}
+}
+
+/// @returns @c true if unprefixed opcode @c opcode has (HL) as an operand, i.e. if it becomes (IX+d) or (IY+d) when indexed.
+constexpr bool accesses_hl_memory(uint8_t opcode) {
+	const int x = opcode >> 6, y = (opcode >> 3) & 7, z = opcode & 7;
+	switch(x) {
+		case 0:		return y == 6 && z >= 4 && z <= 6;
+		case 1:		return (y == 6 || z == 6) && opcode != 0x76;
+		case 2:		return z == 6;
+		default:	return false;
+	}
+}
+
+/// @returns @c true if @c opcode is a prefix that, following a DD or FD, causes that earlier prefix to be disregarded.
+constexpr bool is_superseding_prefix(uint8_t opcode) {
+	return opcode == 0xdd || opcode == 0xfd || opcode == 0xed;
+}
+
+/*!
+	@returns The length of the instruction @c opcode from @c page, including prefixes and operands.
+
+	A DD or FD that is followed by DD, FD or ED is treated as a single-byte instruction of its own;
+	it is represented by that following prefix as an opcode of the DD or FD page.
+*/
+constexpr int length(Page page, uint8_t opcode) {
+	switch(page) {
+		case Page::Base:	return base_length(opcode);
+		case Page::CB:		return 2;
+		case Page::ED:		return (opcode & 0xc7) == 0x43 ? 4 : 2;	// i.e. LD (nn), rr and LD rr, (nn).
+		case Page::DD:
+		case Page::FD:
+			if(is_superseding_prefix(opcode)) return 1;
+		return 1 + base_length(opcode) + (accesses_hl_memory(opcode) ? 1 : 0);
+		default:			return 4;
+	}
+}
+
+struct Instruction {
+	Page page = Page::Base;
+	uint8_t opcode = 0x00;
+
+	constexpr Instruction() {}
+	constexpr Instruction(Page page, uint8_t opcode) : page(page), opcode(opcode) {}
+
+	/// @returns The length of this instruction, including prefixes and operands.
+	constexpr int length() const {
+		return Z80::length(page, opcode);
+	}
+
+	/// @returns @c true if this instruction unconditionally transfers control elsewhere, such that
+	/// whatever follows it is reachable only by some other route.
+	constexpr bool is_terminal() const {
+		switch(page) {
+			case Page::Base:	case Page::DD:	case Page::FD:
+				// JR, HALT, JP, RET and JP (HL).
+				switch(opcode) {
+					case 0x18:	case 0x76:	case 0xc3:	case 0xc9:	case 0xe9:
+					return true;
+					default:	return false;
+				}
+			case Page::ED:
+				// RETN and RETI.
+				return (opcode & 0xc7) == 0x45;
+			default:
+			return false;
+		}
+	}
+};
+
+/*!
+	Decodes the instruction at @c address within the 64kb of @c memory, wrapping around at the end of the address space.
+*/
+inline Instruction decode(const uint8_t *memory, uint16_t address) {
+	const uint8_t first = memory[address];
+	const uint8_t second = memory[uint16_t(address + 1)];
+	switch(first) {
+		case 0xcb:	return Instruction(Page::CB, second);
+		case 0xed:	return Instruction(Page::ED, second);
+		case 0xdd:
+		case 0xfd:
+			if(second == 0xcb) {
+				return Instruction(first == 0xdd ? Page::DDCB : Page::FDCB, memory[uint16_t(address + 3)]);
+			}
+		return Instruction(first == 0xdd ? Page::DD : Page::FD, second);
+		default:	return Instruction(Page::Base, first);
+	}
+}
+
+}
+}
+
+#endif /* InstructionSets_Z80_Instruction_hpp */
@@ -0,0 +1,40 @@
+//
+//  Parser.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 14/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#ifndef InstructionSets_Z80_Parser_hpp
+#define InstructionSets_Z80_Parser_hpp
+
+#include "Instruction.hpp"
+
+#include <cstdint>
+
+namespace InstructionSet {
+namespace Z80 {
+
+/*!
+	Announces to @c target each instruction from @c start onwards, until either the first that
+	begins after @c closing_bound or the first terminal instruction, inclusive.
+*/
+template<typename Target> struct Parser {
+	void parse(Target &target, const uint8_t *memory, uint16_t start, uint16_t closing_bound) {
+		// Count in a wider type so that a closing bound at the very end of memory does terminate.
+		uint32_t address = start;
+		while(address <= closing_bound) {
+			const auto instruction = decode(memory, uint16_t(address));
+			target.announce_instruction(uint16_t(address), instruction);
+			if(instruction.is_terminal()) return;
+
+			address += uint32_t(instruction.length());
+		}
+	}
+};
+
+}
+}
+
+#endif /* InstructionSets_Z80_Parser_hpp */
@@ -17,76 +17,83 @@ using namespace InstructionSet::x86;
 // Only 8086 is suppoted for now.
 Decoder::Decoder(Model) {}
 
-std::pair<int, InstructionSet::x86::Instruction> Decoder::decode(const uint8_t *source, size_t length) {
-	const uint8_t *const end = source + length;
+// MARK: - Opcodes.
 
-	// MARK: - Prefixes (if present) and the opcode.
+const std::array<Decoder::OpcodeDescriptor, 256> Decoder::opcode_descriptors_ = [] () constexpr {
+	using Type = OpcodeDescriptor::Type;
+	std::array<OpcodeDescriptor, 256> descriptors{};
 
 /// Helper macro for those that follow.
 #define SetOpSrcDestSize(op, src, dest, size)	\
-	operation_ = Operation::op;			\
-	source_ = Source::src;				\
-	destination_ = Source::dest;		\
-	operation_size_ = size
+	descriptor.type = Type::Opcode;				\
+	descriptor.operation = Operation::op;		\
+	descriptor.source = Source::src;			\
+	descriptor.destination = Source::dest;		\
+	descriptor.operation_size = size
 
 /// Covers anything which is complete as soon as the opcode is encountered.
 #define Complete(op, src, dest, size)		\
 	SetOpSrcDestSize(op, src, dest, size);	\
-	phase_ = Phase::ReadyToPost
+	descriptor.phase = Phase::ReadyToPost
 
 /// Handles instructions of the form rr, kk and rr, jjkk, i.e. a destination register plus an operand.
 #define RegData(op, dest, size)							\
 	SetOpSrcDestSize(op, DirectAddress, dest, size);	\
-	source_ = Source::Immediate;						\
-	operand_size_ = size;								\
-	phase_ = Phase::AwaitingDisplacementOrOperand
+	descriptor.source = Source::Immediate;				\
+	descriptor.operand_size = size;						\
+	descriptor.phase = Phase::AwaitingDisplacementOrOperand
 
 /// Handles instructions of the form Ax, jjkk where the latter is implicitly an address.
 #define RegAddr(op, dest, op_size, addr_size)			\
 	SetOpSrcDestSize(op, DirectAddress, dest, op_size);	\
-	operand_size_ = addr_size;							\
-	phase_ = Phase::AwaitingDisplacementOrOperand
+	descriptor.operand_size = addr_size;				\
+	descriptor.phase = Phase::AwaitingDisplacementOrOperand
 
 /// Handles instructions of the form jjkk, Ax where the former is implicitly an address.
 #define AddrReg(op, source, op_size, addr_size)				\
 	SetOpSrcDestSize(op, source, DirectAddress, op_size);	\
-	operand_size_ = addr_size;								\
-	destination_ = Source::DirectAddress;					\
-	phase_ = Phase::AwaitingDisplacementOrOperand
+	descriptor.operand_size = addr_size;					\
+	descriptor.phase = Phase::AwaitingDisplacementOrOperand
 
 /// Covers both `mem/reg, reg` and `reg, mem/reg`.
-#define MemRegReg(op, format, size)				\
-	operation_ = Operation::op;					\
-	phase_ = Phase::ModRegRM;					\
-	modregrm_format_ = ModRegRMFormat::format;	\
-	operand_size_ = 0;							\
-	operation_size_ = size
+#define MemRegReg(op, modregrm_format, size)				\
+	descriptor.type = Type::Opcode;							\
+	descriptor.operation = Operation::op;					\
+	descriptor.phase = Phase::ModRegRM;						\
+	descriptor.format = ModRegRMFormat::modregrm_format;	\
+	descriptor.operation_size = size
 
 /// Handles JO, JNO, JB, etc — jumps with a single byte displacement.
-#define Jump(op)									\
-	operation_ = Operation::op;						\
-	phase_ = Phase::AwaitingDisplacementOrOperand;	\
-	displacement_size_ = 1
+#define Jump(op)													\
+	descriptor.type = Type::Opcode;									\
+	descriptor.operation = Operation::op;							\
+	descriptor.phase = Phase::AwaitingDisplacementOrOperand;		\
+	descriptor.operation_size = OpcodeDescriptor::UnspecifiedSize;	\
+	descriptor.displacement_size = 1
 
 /// Handles far CALL and far JMP — fixed four byte operand operations.
-#define Far(op)										\
-	operation_ = Operation::op;						\
-	phase_ = Phase::AwaitingDisplacementOrOperand;	\
-	operand_size_ = 4;								\
+#define Far(op)														\
+	descriptor.type = Type::Opcode;									\
+	descriptor.operation = Operation::op;							\
+	descriptor.phase = Phase::AwaitingDisplacementOrOperand;		\
+	descriptor.operation_size = OpcodeDescriptor::UnspecifiedSize;	\
+	descriptor.operand_size = 4
 
-	while(phase_ == Phase::Instruction && source != end) {
-		// Retain the instruction byte, in case additional decoding is deferred
-		// to the ModRegRM byte.
-		instr_ = *source;
-		++source;
-		++consumed_;
+/// Handles the segment override prefixes.
+#define SegmentPrefix(segment)				\
+	descriptor.type = Type::SegmentPrefix;	\
+	descriptor.source = Source::segment
 
-		switch(instr_) {
-			default: {
-				const auto result = std::make_pair(consumed_, Instruction());
-				reset_parsing();
-				return result;
-			}
+/// Handles the REP prefixes.
+#define RepetitionPrefix(rep)					\
+	descriptor.type = Type::RepetitionPrefix;	\
+	descriptor.repetition = Repetition::rep
+
+	for(size_t opcode = 0; opcode < descriptors.size(); opcode++) {
+		OpcodeDescriptor &descriptor = descriptors[opcode];
+
+		switch(opcode) {
+			default: break;
 
 #define PartialBlock(start, operation)								\
 	case start + 0x00: MemRegReg(operation, MemReg_Reg, 1);	break;	\
@@ -112,19 +119,19 @@ std::pair<int, InstructionSet::x86::Instruction> Decoder::decode(const uint8_t *
 			case 0x1f: Complete(POP, None, DS, 2);		break;
 
 			PartialBlock(0x20, AND);					break;
-			case 0x26: segment_override_ = Source::ES;	break;
+			case 0x26: SegmentPrefix(ES);			break;
 			case 0x27: Complete(DAA, AL, AL, 1);		break;
 
 			PartialBlock(0x28, SUB);					break;
-			case 0x2e: segment_override_ = Source::CS;	break;
+			case 0x2e: SegmentPrefix(CS);			break;
 			case 0x2f: Complete(DAS, AL, AL, 1);		break;
 
 			PartialBlock(0x30, XOR);					break;
-			case 0x36: segment_override_ = Source::SS;	break;
+			case 0x36: SegmentPrefix(SS);			break;
 			case 0x37: Complete(AAA, AL, AX, 1);		break;
 
 			PartialBlock(0x38, CMP);					break;
-			case 0x3e: segment_override_ = Source::DS;	break;
+			case 0x3e: SegmentPrefix(DS);			break;
 			case 0x3f: Complete(AAS, AL, AX, 1);		break;
 
 #undef PartialBlock
@@ -252,17 +259,19 @@ std::pair<int, InstructionSet::x86::Instruction> Decoder::decode(const uint8_t *
 			case 0xcf: Complete(IRET, None, None, 0);	break;
 
 			case 0xd0: case 0xd1:
-				phase_ = Phase::ModRegRM;
-				modregrm_format_ = ModRegRMFormat::MemRegROL_to_SAR;
-				operation_size_ = 1 + (instr_ & 1);
-				source_ = Source::Immediate;
-				operand_ = 1;
+				descriptor.type = Type::Opcode;
+				descriptor.phase = Phase::ModRegRM;
+				descriptor.format = ModRegRMFormat::MemRegROL_to_SAR;
+				descriptor.operation_size = uint8_t(1 + (opcode & 1));
+				descriptor.source = Source::Immediate;
+				descriptor.operand = 1;
 			break;
 			case 0xd2: case 0xd3:
-				phase_ = Phase::ModRegRM;
-				modregrm_format_ = ModRegRMFormat::MemRegROL_to_SAR;
-				operation_size_ = 1 + (instr_ & 1);
-				source_ = Source::CL;
+				descriptor.type = Type::Opcode;
+				descriptor.phase = Phase::ModRegRM;
+				descriptor.format = ModRegRMFormat::MemRegROL_to_SAR;
+				descriptor.operation_size = uint8_t(1 + (opcode & 1));
+				descriptor.source = Source::CL;
 			break;
 			case 0xd4: RegData(AAM, AX, 1);				break;
 			case 0xd5: RegData(AAD, AX, 1);				break;
@@ -314,12 +323,14 @@ std::pair<int, InstructionSet::x86::Instruction> Decoder::decode(const uint8_t *
 			case 0xff: MemRegReg(Invalid, MemRegINC_to_PUSH, 1);	break;
 
 			// Other prefix bytes.
-			case 0xf0:	lock_ = true;						break;
-			case 0xf2:	repetition_ = Repetition::RepNE;	break;
-			case 0xf3:	repetition_ = Repetition::RepE;		break;
+			case 0xf0:	descriptor.type = Type::LockPrefix;	break;
+			case 0xf2:	RepetitionPrefix(RepNE);			break;
+			case 0xf3:	RepetitionPrefix(RepE);				break;
 		}
 	}
 
+#undef RepetitionPrefix
+#undef SegmentPrefix
 #undef Far
 #undef Jump
 #undef MemRegReg
@@ -329,227 +340,257 @@ std::pair<int, InstructionSet::x86::Instruction> Decoder::decode(const uint8_t *
 #undef Complete
 #undef SetOpSrcDestSize
 
-	// MARK: - ModRegRM byte, if any.
+	return descriptors;
+} ();
+
+void Decoder::begin_opcode(const OpcodeDescriptor &descriptor) {
+	operation_ = descriptor.operation;
+	source_ = descriptor.source;
+	destination_ = descriptor.destination;
+	operand_size_ = descriptor.operand_size;
+	displacement_size_ = descriptor.displacement_size;
+	operand_ = descriptor.operand;
+	modregrm_format_ = descriptor.format;
+	phase_ = descriptor.phase;
+
+	if(descriptor.operation_size != OpcodeDescriptor::UnspecifiedSize) {
+		operation_size_ = descriptor.operation_size;
+	}
+}
 
-	if(phase_ == Phase::ModRegRM && source != end) {
-		const uint8_t mod = *source >> 6;		// i.e. mode.
-		const uint8_t reg = (*source >> 3) & 7;	// i.e. register.
-		const uint8_t rm = *source & 7;			// i.e. register/memory.
-		++source;
-		++consumed_;
+// MARK: - ModRegRM byte.
+
+bool Decoder::decode_modregrm(uint8_t modregrm) {
+	const uint8_t mod = modregrm >> 6;			// i.e. mode.
+	const uint8_t reg = (modregrm >> 3) & 7;	// i.e. register.
+	const uint8_t rm = modregrm & 7;			// i.e. register/memory.
+
+	Source memreg;
+	constexpr Source reg_table[3][8] = {
+		{},
+		{
+			Source::AL,	Source::CL,	Source::DL,	Source::BL,
+			Source::AH,	Source::CH,	Source::DH,	Source::BH,
+		}, {
+			Source::AX,	Source::CX,	Source::DX,	Source::BX,
+			Source::SP,	Source::BP,	Source::SI,	Source::DI,
+		}
+	};
+	switch(mod) {
+		case 0: {
+			constexpr Source rm_table[8] = {
+				Source::IndBXPlusSI,	Source::IndBXPlusDI,
+				Source::IndBPPlusSI,	Source::IndBPPlusDI,
+				Source::IndSI,			Source::IndDI,
+				Source::DirectAddress,	Source::IndBX,
+			};
+			memreg = rm_table[rm];
+		} break;
+
+		default: {
+			constexpr Source rm_table[8] = {
+				Source::IndBXPlusSI,	Source::IndBXPlusDI,
+				Source::IndBPPlusSI,	Source::IndBPPlusDI,
+				Source::IndSI,			Source::IndDI,
+				Source::IndBP,			Source::IndBX,
+			};
+			memreg = rm_table[rm];
+
+			displacement_size_ = 1 + (mod == 2);
+		} break;
+
+		// Other operand is just a register.
+		case 3:
+			memreg = reg_table[operation_size_][rm];
+
+			// LES and LDS accept a memory argument only, not a register.
+			if(operation_ == Operation::LES || operation_ == Operation::LDS) return false;
+		break;
+	}
 
-		Source memreg;
-		constexpr Source reg_table[3][8] = {
-			{},
-			{
-				Source::AL,	Source::CL,	Source::DL,	Source::BL,
-				Source::AH,	Source::CH,	Source::DH,	Source::BH,
-			}, {
-				Source::AX,	Source::CX,	Source::DX,	Source::BX,
-				Source::SP,	Source::BP,	Source::SI,	Source::DI,
+	switch(modregrm_format_) {
+		case ModRegRMFormat::Reg_MemReg:
+		case ModRegRMFormat::MemReg_Reg: {
+			if(modregrm_format_ == ModRegRMFormat::Reg_MemReg) {
+				source_ = memreg;
+				destination_ = reg_table[operation_size_][reg];
+			} else {
+				source_ = reg_table[operation_size_][reg];
+				destination_ = memreg;
 			}
-		};
-		switch(mod) {
-			case 0: {
-				constexpr Source rm_table[8] = {
-					Source::IndBXPlusSI,	Source::IndBXPlusDI,
-					Source::IndBPPlusSI,	Source::IndBPPlusDI,
-					Source::IndSI,			Source::IndDI,
-					Source::DirectAddress,	Source::IndBX,
-				};
-				memreg = rm_table[rm];
-			} break;
-
-			default: {
-				constexpr Source rm_table[8] = {
-					Source::IndBXPlusSI,	Source::IndBXPlusDI,
-					Source::IndBPPlusSI,	Source::IndBPPlusDI,
-					Source::IndSI,			Source::IndDI,
-					Source::IndBP,			Source::IndBX,
-				};
-				memreg = rm_table[rm];
-
-				displacement_size_ = 1 + (mod == 2);
-			} break;
-
-			// Other operand is just a register.
-			case 3:
-				memreg = reg_table[operation_size_][rm];
-
-				// LES and LDS accept a memory argument only, not a register.
-				if(operation_ == Operation::LES || operation_ == Operation::LDS) {
-					const auto result = std::make_pair(consumed_, Instruction());
-					reset_parsing();
-					return result;
-				}
-			break;
-		}
+		} break;
 
-		switch(modregrm_format_) {
-			case ModRegRMFormat::Reg_MemReg:
-			case ModRegRMFormat::MemReg_Reg: {
-				if(modregrm_format_ == ModRegRMFormat::Reg_MemReg) {
-					source_ = memreg;
-					destination_ = reg_table[operation_size_][reg];
-				} else {
-					source_ = reg_table[operation_size_][reg];
-					destination_ = memreg;
-				}
-			} break;
+		case ModRegRMFormat::MemRegTEST_to_IDIV:
+			source_ = destination_ = memreg;
 
-			case ModRegRMFormat::MemRegTEST_to_IDIV:
-				source_ = destination_ = memreg;
+			switch(reg) {
+				default: return false;
 
-				switch(reg) {
-					default: {
-						const auto result = std::make_pair(consumed_, Instruction());
-						reset_parsing();
-						return result;
-					}
+				case 0: 	operation_ = Operation::TEST;	break;
+				case 2: 	operation_ = Operation::NOT;	break;
+				case 3: 	operation_ = Operation::NEG;	break;
+				case 4: 	operation_ = Operation::MUL;	break;
+				case 5: 	operation_ = Operation::IMUL;	break;
+				case 6: 	operation_ = Operation::DIV;	break;
+				case 7: 	operation_ = Operation::IDIV;	break;
+			}
+		break;
 
-					case 0: 	operation_ = Operation::TEST;	break;
-					case 2: 	operation_ = Operation::NOT;	break;
-					case 3: 	operation_ = Operation::NEG;	break;
-					case 4: 	operation_ = Operation::MUL;	break;
-					case 5: 	operation_ = Operation::IMUL;	break;
-					case 6: 	operation_ = Operation::DIV;	break;
-					case 7: 	operation_ = Operation::IDIV;	break;
-				}
-			break;
+		case ModRegRMFormat::SegReg: {
+			source_ = memreg;
 
-			case ModRegRMFormat::SegReg: {
-				source_ = memreg;
+			constexpr Source seg_table[4] = {
+				Source::ES,	Source::CS,
+				Source::SS,	Source::DS,
+			};
 
-				constexpr Source seg_table[4] = {
-					Source::ES,	Source::CS,
-					Source::SS,	Source::DS,
-				};
+			if(reg & 4) return false;
 
-				if(reg & 4) {
-					const auto result = std::make_pair(consumed_, Instruction());
-					reset_parsing();
-					return result;
-				}
+			destination_ = seg_table[reg];
+		} break;
 
-				destination_ = seg_table[reg];
-			} break;
+		case ModRegRMFormat::MemRegROL_to_SAR:
+			destination_ = memreg;
 
-			case ModRegRMFormat::MemRegROL_to_SAR:
-				destination_ = memreg;
+			switch(reg) {
+				default: return false;
 
-				switch(reg) {
-					default: {
-						const auto result = std::make_pair(consumed_, Instruction());
-						reset_parsing();
-						return result;
-					}
+				case 0: 	operation_ = Operation::ROL;	break;
+				case 2: 	operation_ = Operation::ROR;	break;
+				case 3: 	operation_ = Operation::RCL;	break;
+				case 4: 	operation_ = Operation::RCR;	break;
+				case 5: 	operation_ = Operation::SAL;	break;
+				case 6: 	operation_ = Operation::SHR;	break;
+				case 7: 	operation_ = Operation::SAR;	break;
+			}
+		break;
 
-					case 0: 	operation_ = Operation::ROL;	break;
-					case 2: 	operation_ = Operation::ROR;	break;
-					case 3: 	operation_ = Operation::RCL;	break;
-					case 4: 	operation_ = Operation::RCR;	break;
-					case 5: 	operation_ = Operation::SAL;	break;
-					case 6: 	operation_ = Operation::SHR;	break;
-					case 7: 	operation_ = Operation::SAR;	break;
-				}
-			break;
+		case ModRegRMFormat::MemRegINC_DEC:
+			source_ = destination_ = memreg;
 
-			case ModRegRMFormat::MemRegINC_DEC:
-				source_ = destination_ = memreg;
+			switch(reg) {
+				default: return false;
 
-				switch(reg) {
-					default: {
-						const auto result = std::make_pair(consumed_, Instruction());
-						reset_parsing();
-						return result;
-					}
+				case 0:		operation_ = Operation::INC;	break;
+				case 1:		operation_ = Operation::DEC;	break;
+			}
+		break;
 
-					case 0:		operation_ = Operation::INC;	break;
-					case 1:		operation_ = Operation::DEC;	break;
-				}
-			break;
+		case ModRegRMFormat::MemRegINC_to_PUSH:
+			source_ = destination_ = memreg;
 
-			case ModRegRMFormat::MemRegINC_to_PUSH:
-				source_ = destination_ = memreg;
+			switch(reg) {
+				default: return false;
 
-				switch(reg) {
-					default: {
-						const auto result = std::make_pair(consumed_, Instruction());
-						reset_parsing();
-						return result;
-					}
+				case 0:		operation_ = Operation::INC;	break;
+				case 1:		operation_ = Operation::DEC;	break;
+				case 2:		operation_ = Operation::CALLN;	break;
+				case 3:
+					operation_ = Operation::CALLF;
+					operand_size_ = 4;
+					source_ = Source::Immediate;
+				break;
+				case 4:		operation_ = Operation::JMPN;	break;
+				case 5:
+					operation_ = Operation::JMPF;
+					operand_size_ = 4;
+					source_ = Source::Immediate;
+				break;
+				case 6:	operation_ = Operation::PUSH;		break;
+			}
+		break;
+
+		case ModRegRMFormat::MemRegPOP:
+			source_ = destination_ = memreg;
+
+			if(reg != 0) return false;
+		break;
+
+		case ModRegRMFormat::MemRegMOV:
+			source_ = Source::Immediate;
+			destination_ = memreg;
+			operand_size_ = operation_size_;
+		break;
+
+		case ModRegRMFormat::MemRegADD_to_CMP:
+			destination_ = memreg;
+			operand_size_ = operation_size_;
+
+			switch(reg) {
+				default:	operation_ = Operation::ADD;	break;
+				case 1:		operation_ = Operation::OR;		break;
+				case 2:		operation_ = Operation::ADC;	break;
+				case 3:		operation_ = Operation::SBB;	break;
+				case 4:		operation_ = Operation::AND;	break;
+				case 5:		operation_ = Operation::SUB;	break;
+				case 6:		operation_ = Operation::XOR;	break;
+				case 7:		operation_ = Operation::CMP;	break;
+			}
+		break;
+
+		case ModRegRMFormat::MemRegADC_to_CMP:
+			destination_ = memreg;
+			source_ = Source::Immediate;
+			operand_size_ = 1;	// ... and always 1; it'll be sign extended if
+								// the operation requires it.
+
+			switch(reg) {
+				default: return false;
+
+				case 0: 	operation_ = Operation::ADD;	break;
+				case 2: 	operation_ = Operation::ADC;	break;
+				case 3: 	operation_ = Operation::SBB;	break;
+				case 5: 	operation_ = Operation::SUB;	break;
+				case 7: 	operation_ = Operation::CMP;	break;
+			}
+		break;
 
-					case 0:		operation_ = Operation::INC;	break;
-					case 1:		operation_ = Operation::DEC;	break;
-					case 2:		operation_ = Operation::CALLN;	break;
-					case 3:
-						operation_ = Operation::CALLF;
-						operand_size_ = 4;
-						source_ = Source::Immediate;
-					break;
-					case 4:		operation_ = Operation::JMPN;	break;
-					case 5:
-						operation_ = Operation::JMPF;
-						operand_size_ = 4;
-						source_ = Source::Immediate;
-					break;
-					case 6:	operation_ = Operation::PUSH;		break;
-				}
-			break;
+		default: assert(false);
+	}
 
-			case ModRegRMFormat::MemRegPOP:
-				source_ = destination_ = memreg;
+	return true;
+}
 
-				if(reg != 0) {
-					reset_parsing();
-					return std::make_pair(consumed_, Instruction());
-				}
-			break;
+// MARK: - Incremental decoding.
 
-			case ModRegRMFormat::MemRegMOV:
-				source_ = Source::Immediate;
-				destination_ = memreg;
-				operand_size_ = operation_size_;
-			break;
+std::pair<int, InstructionSet::x86::Instruction> Decoder::decode(const uint8_t *source, size_t length) {
+	const uint8_t *const end = source + length;
 
-			case ModRegRMFormat::MemRegADD_to_CMP:
-				destination_ = memreg;
-				operand_size_ = operation_size_;
-
-				switch(reg) {
-					default:	operation_ = Operation::ADD;	break;
-					case 1:		operation_ = Operation::OR;		break;
-					case 2:		operation_ = Operation::ADC;	break;
-					case 3:		operation_ = Operation::SBB;	break;
-					case 4:		operation_ = Operation::AND;	break;
-					case 5:		operation_ = Operation::SUB;	break;
-					case 6:		operation_ = Operation::XOR;	break;
-					case 7:		operation_ = Operation::CMP;	break;
-				}
-			break;
+	// MARK: - Prefixes (if present) and the opcode.
 
-			case ModRegRMFormat::MemRegADC_to_CMP:
-				destination_ = memreg;
-				source_ = Source::Immediate;
-				operand_size_ = 1;	// ... and always 1; it'll be sign extended if
-									// the operation requires it.
-
-				switch(reg) {
-					default: {
-						const auto result = std::make_pair(consumed_, Instruction());
-						reset_parsing();
-						return result;
-					}
+	while(phase_ == Phase::Instruction && source != end) {
+		// Retain the instruction byte, in case additional decoding is deferred
+		// to the ModRegRM byte.
+		instr_ = *source;
+		++source;
+		++consumed_;
 
-					case 0: 	operation_ = Operation::ADD;	break;
-					case 2: 	operation_ = Operation::ADC;	break;
-					case 3: 	operation_ = Operation::SBB;	break;
-					case 5: 	operation_ = Operation::SUB;	break;
-					case 7: 	operation_ = Operation::CMP;	break;
-				}
-			break;
+		const OpcodeDescriptor &descriptor = opcode_descriptors_[instr_];
+		switch(descriptor.type) {
+			case OpcodeDescriptor::Type::Invalid: {
+				const auto result = std::make_pair(consumed_, Instruction());
+				reset_parsing();
+				return result;
+			}
 
-			default: assert(false);
+			case OpcodeDescriptor::Type::SegmentPrefix:		segment_override_ = descriptor.source;		break;
+			case OpcodeDescriptor::Type::LockPrefix:		lock_ = true;								break;
+			case OpcodeDescriptor::Type::RepetitionPrefix:	repetition_ = descriptor.repetition;		break;
+			case OpcodeDescriptor::Type::Opcode:			begin_opcode(descriptor);					break;
+		}
+	}
+
+	// MARK: - ModRegRM byte, if any.
+
+	if(phase_ == Phase::ModRegRM && source != end) {
+		const uint8_t modregrm = *source;
+		++source;
+		++consumed_;
+
+		if(!decode_modregrm(modregrm)) {
+			const auto result = std::make_pair(consumed_, Instruction());
+			reset_parsing();
+			return result;
 		}
 
 		phase_ = (displacement_size_ + operand_size_) ? Phase::AwaitingDisplacementOrOperand : Phase::ReadyToPost;
@@ -623,3 +664,102 @@ std::pair<int, InstructionSet::x86::Instruction> Decoder::decode(const uint8_t *
 	// i.e. not done yet.
 	return std::make_pair(0, Instruction());
 }
+
+
+// MARK: - Whole-instruction decoding.
+
+std::pair<int, InstructionSet::x86::Instruction> Decoder::decode_contiguous(const uint8_t *source, size_t length) {
+	// Anything already in progress is completed incrementally.
+	if(consumed_) {
+		return decode(source, length);
+	}
+
+	const uint8_t *const end = source + length;
+	const uint8_t *cursor = source;
+
+	// If the instruction turns out not to be entirely present, start again with the incremental decoder.
+	const auto defer = [&] {
+		reset_parsing();
+		return decode(source, length);
+	};
+	const auto invalid = [&] {
+		reset_parsing();
+		return std::make_pair(int(cursor - source), Instruction());
+	};
+
+	// Prefixes (if present) and the opcode.
+	const OpcodeDescriptor *descriptor;
+	while(true) {
+		if(cursor == end) return defer();
+
+		instr_ = *cursor;
+		++cursor;
+
+		descriptor = &opcode_descriptors_[instr_];
+		if(descriptor->type == OpcodeDescriptor::Type::Opcode) break;
+
+		switch(descriptor->type) {
+			default:										return invalid();
+			case OpcodeDescriptor::Type::SegmentPrefix:		segment_override_ = descriptor->source;		break;
+			case OpcodeDescriptor::Type::LockPrefix:		lock_ = true;								break;
+			case OpcodeDescriptor::Type::RepetitionPrefix:	repetition_ = descriptor->repetition;		break;
+		}
+	}
+	begin_opcode(*descriptor);
+
+	// ModRegRM byte, if any.
+	if(phase_ == Phase::ModRegRM) {
+		if(cursor == end) return defer();
+
+		const uint8_t modregrm = *cursor;
+		++cursor;
+		if(!decode_modregrm(modregrm)) return invalid();
+	}
+
+	// Displacement and operand, which are in that order in the instruction stream.
+	const int required_bytes = displacement_size_ + operand_size_;
+	if(required_bytes) {
+		if(end - cursor < required_bytes) return defer();
+		cursor += required_bytes;
+
+		const uint8_t *displacement_end = cursor;
+		switch(operand_size_) {
+			default:	operand_ = 0;	break;
+			case 1:
+				operand_ = cursor[-1];
+				--displacement_end;
+
+				// Sign extend if a single byte operand is feeding a two-byte instruction.
+				if(operation_size_ == 2 && operation_ != Operation::IN && operation_ != Operation::OUT) {
+					operand_ |= (operand_ & 0x80) ? 0xff00 : 0x0000;
+				}
+			break;
+			case 4:		displacement_size_ = 2;		[[fallthrough]];
+			case 2:
+				operand_ = uint16_t(cursor[-2] | (cursor[-1] << 8));
+				displacement_end -= 2;
+			break;
+		}
+		switch(displacement_size_) {
+			default:	displacement_ = 0;													break;
+			case 1:		displacement_ = int8_t(displacement_end[-1]);						break;
+			case 2:		displacement_ = int16_t(displacement_end[-2] | (displacement_end[-1] << 8));	break;
+		}
+	}
+
+	const auto result = std::make_pair(
+		int(cursor - source),
+		Instruction(
+			operation_,
+			source_,
+			destination_,
+			lock_,
+			segment_override_,
+			repetition_,
+			Size(operation_size_),
+			displacement_,
+			operand_)
+	);
+	reset_parsing();
+	return result;
+}
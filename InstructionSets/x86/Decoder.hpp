@@ -11,6 +11,7 @@
 
 #include "Instruction.hpp"
 
+#include <array>
 #include <cstddef>
 #include <utility>
 
@@ -39,6 +40,16 @@ class Decoder {
 		*/
 		std::pair<int, Instruction> decode(const uint8_t *source, size_t length);
 
+		/*!
+			Produces exactly the same results as @c decode, but is optimised for the case in which @c source holds
+			the whole of the next instruction, which it then decodes in a single pass; this suits bulk decoding
+			of code that is already entirely in memory.
+
+			If a previous call left an instruction partially decoded, or @c source proves to be too short to
+			contain the entire instruction, this defers to @c decode.
+		*/
+		std::pair<int, Instruction> decode_contiguous(const uint8_t *source, size_t length);
+
 	private:
 		enum class Phase {
 			/// Captures all prefixes and continues until an instruction byte is encountered.
@@ -112,6 +123,43 @@ class Decoder {
 			MemRegADC_to_CMP,
 		} modregrm_format_ = ModRegRMFormat::MemReg_Reg;
 
+		/// Records everything that can be determined from a single opcode byte.
+		struct OpcodeDescriptor {
+			enum class Type: uint8_t {
+				Invalid,
+				/// The segment override given by @c source.
+				SegmentPrefix,
+				LockPrefix,
+				/// The repetition given by @c repetition.
+				RepetitionPrefix,
+				/// An opcode, after which decoding continues from @c phase.
+				Opcode,
+			} type = Type::Invalid;
+
+			Phase phase = Phase::Instruction;
+			ModRegRMFormat format = ModRegRMFormat::MemReg_Reg;
+			Operation operation = Operation::Invalid;
+			Source source = Source::None;
+			Source destination = Source::None;
+			Repetition repetition = Repetition::None;
+
+			/// The operation size, or @c UnspecifiedSize if this opcode doesn't set one.
+			uint8_t operation_size = 0;
+			uint8_t operand_size = 0;
+			uint8_t displacement_size = 0;
+			uint16_t operand = 0;
+
+			static constexpr uint8_t UnspecifiedSize = 0xff;
+		};
+		static const std::array<OpcodeDescriptor, 256> opcode_descriptors_;
+
+		/// Populates the ephemeral decoding state from @c descriptor.
+		void begin_opcode(const OpcodeDescriptor &descriptor);
+
+		/// Interprets @c modregrm as per the current ModRegRMFormat, completing source_, destination_ and
+		/// operation_, and any sizes that depend on it. @returns @c false if the result is not a valid instruction.
+		bool decode_modregrm(uint8_t modregrm);
+
 		// Ephemeral decoding state.
 		Operation operation_ = Operation::Invalid;
 		uint8_t instr_ = 0x00;	// TODO: is this desired, versus loading more context into ModRegRMFormat?
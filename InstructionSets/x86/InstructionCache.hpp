@@ -0,0 +1,172 @@
+//
+//  InstructionCache.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 14/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#ifndef InstructionSets_x86_InstructionCache_hpp
+#define InstructionSets_x86_InstructionCache_hpp
+
+#include "Instruction.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace InstructionSet {
+namespace x86 {
+
+/*!
+	Caches the results of decoding, indexed by the linear address at which each instruction begins.
+
+	Decoding produces a size, which is ephemeral in that it is needed only to advance through the
+	instruction stream, and an @c Instruction, which is what's meaningful to keep. Rather than holding
+	the complete pair, this cache packs the size into the same 32-bit tag as the address, so
+	that each entry is that tag plus an @c Instruction: twelve bytes.
+
+	Entries are held in an open-addressed table with a small, fixed probe length; if all candidate slots
+	for an address are occupied then one is replaced. Invalidation is by page: each page has a generation
+	count, which is recorded in the tag of all entries inserted from it, so invalidating a page is just a
+	matter of incrementing its count.
+
+	Instructions longer than @c MaxLength bytes are not cached; on the 8086 such instructions can
+	be produced only by irrelevant repetition of prefixes.
+*/
+class InstructionCache {
+	public:
+		/// The number of bits of linear address that the cache supports.
+		static constexpr int AddressBits = 20;
+
+		/// The granularity of invalidation.
+		static constexpr int PageShift = 12;
+		static constexpr uint32_t PageSize = 1 << PageShift;
+
+		/// The length of the longest instruction that will be cached.
+		static constexpr int MaxLength = 15;
+
+		/// Constructs a cache of 2^@c log2_capacity entries.
+		InstructionCache(int log2_capacity = 14) :
+			entries_(size_t(1) << log2_capacity), mask_((uint32_t(1) << log2_capacity) - 1) {}
+
+		/*!
+			@returns the cached size and @c Instruction at @c address if there are any, in the same form as
+				they were originally returned by the decoder; otherwise a size of 0.
+		*/
+		std::pair<int, Instruction> find(uint32_t address) const {
+			address &= AddressMask;
+			const uint32_t expected = (address << AddressShift) | (uint32_t(generations_[address >> PageShift]) << GenerationShift);
+
+			for(uint32_t probe = 0; probe < Probes; probe++) {
+				const Entry &entry = entries_[(hash(address) + probe) & mask_];
+				if((entry.tag & ~LengthMask) == expected && (entry.tag & LengthMask)) {
+					return std::make_pair(int(entry.tag & LengthMask), entry.instruction);
+				}
+			}
+			return std::make_pair(0, Instruction());
+		}
+
+		/*!
+			Records @c decoded, being the result of decoding from @c address. Incomplete decodings
+			and those too long to cache are ignored.
+		*/
+		void insert(uint32_t address, const std::pair<int, Instruction> &decoded) {
+			if(decoded.first <= 0 || decoded.first > MaxLength) return;
+
+			address &= AddressMask;
+			const uint32_t generation = generations_[address >> PageShift];
+			const uint32_t tag =
+				(address << AddressShift) | (generation << GenerationShift) | uint32_t(decoded.first);
+
+			// Prefer, in order: a previous entry for this address, an empty or stale slot, and
+			// otherwise the first candidate.
+			Entry *target = &entries_[hash(address) & mask_];
+			for(uint32_t probe = 0; probe < Probes; probe++) {
+				Entry &entry = entries_[(hash(address) + probe) & mask_];
+				if((entry.tag >> AddressShift) == address || !is_live(entry)) {
+					target = &entry;
+					if((entry.tag >> AddressShift) == address) break;
+				}
+			}
+
+			target->tag = tag;
+			target->instruction = decoded.second;
+		}
+
+		/*!
+			Discards all cached instructions that overlap the range [@c begin, @c end], by discarding
+			all those from the pages overlapping that range, or that begin sufficiently close to
+			the start of it that they might run into it.
+		*/
+		void invalidate(uint32_t begin, uint32_t end) {
+			begin &= AddressMask;
+			end &= AddressMask;
+
+			const uint32_t first_page = (begin > MaxLength - 1 ? begin - (MaxLength - 1) : 0) >> PageShift;
+			const uint32_t last_page = end >> PageShift;
+			for(uint32_t page = first_page; page <= last_page; page++) {
+				invalidate_page(page);
+			}
+		}
+
+		/// Discards all cached instructions.
+		void clear() {
+			std::fill(entries_.begin(), entries_.end(), Entry());
+			generations_.fill(0);
+		}
+
+	private:
+		struct Entry {
+			// b0–b3: length, with 0 indicating an empty slot;
+			// b4–b11: generation of the owning page at insertion;
+			// b12–b31: address.
+			uint32_t tag = 0;
+			Instruction instruction;
+		};
+		static_assert(sizeof(Entry) <= 12);
+
+		static constexpr uint32_t LengthMask = 0xf;
+		static constexpr int GenerationShift = 4;
+		static constexpr int AddressShift = 12;
+		static constexpr uint32_t AddressMask = (1 << AddressBits) - 1;
+		static constexpr uint32_t Probes = 4;
+		static constexpr size_t PageCount = size_t(1) << (AddressBits - PageShift);
+
+		std::vector<Entry> entries_;
+		const uint32_t mask_;
+		std::array<uint8_t, PageCount> generations_{};
+
+		static uint32_t hash(uint32_t address) {
+			// Fibonacci hashing; the top bits of the product are the best mixed. Consecutive
+			// probes then fall into the same or the next cache line.
+			return (address * 2654435769u) >> 12;
+		}
+
+		bool is_live(const Entry &entry) const {
+			return
+				(entry.tag & LengthMask) &&
+				((entry.tag >> GenerationShift) & 0xff) == generations_[entry.tag >> (AddressShift + PageShift)];
+		}
+
+		void invalidate_page(uint32_t page) {
+			++generations_[page];
+			if(generations_[page]) return;
+
+			// The generation count has wrapped, so entries from long ago would appear to be current
+			// again; remove every entry from this page, whatever its generation.
+			for(auto &entry: entries_) {
+				if((entry.tag >> (AddressShift + PageShift)) == page) {
+					entry = Entry();
+				}
+			}
+		}
+};
+
+}
+}
+
+#endif /* InstructionSets_x86_InstructionCache_hpp */
@@ -34,6 +34,7 @@
 
 #include "../../Numeric/CRC.hpp"
 
+#include <algorithm>
 #include <array>
 #include <cstdint>
 #include <vector>
@@ -155,6 +156,12 @@ class AYDeferrer {
 			return ay_;
 		}
 
+		/// Completes all processing, then @returns the number of bytes occupied by the speaker's buffers.
+		size_t get_speaker_memory_footprint() {
+			audio_queue_.flush();
+			return speaker_.get_memory_footprint();
+		}
+
 	private:
 		Concurrency::DeferringAsyncTaskQueue audio_queue_;
 		GI::AY38910::AY38910<true> ay_;
@@ -214,86 +221,17 @@ class CRTCBusHandler {
 				output_mode = OutputMode::Border;
 			}
 
-			// If a transition between sync/border/pixels just occurred, flush whatever was
-			// in progress to the CRT and reset counting.
-			if(output_mode != previous_output_mode_) {
-				if(cycles_) {
-					switch(previous_output_mode_) {
-						default:
-						case OutputMode::Blank:			crt_.output_blank(cycles_ * 16);				break;
-						case OutputMode::Sync:			crt_.output_sync(cycles_ * 16);					break;
-						case OutputMode::Border:		output_border(cycles_);							break;
-						case OutputMode::ColourBurst:	crt_.output_default_colour_burst(cycles_ * 16);	break;
-						case OutputMode::Pixels:
-							crt_.output_data(cycles_ * 16, size_t(cycles_ * 16 / pixel_divider_));
-							pixel_pointer_ = pixel_data_ = nullptr;
-						break;
-					}
-				}
-
-				cycles_ = 0;
-				previous_output_mode_ = output_mode;
-			}
-
-			// increment cycles since state changed
-			cycles_++;
-
-			// collect some more pixels if output is ongoing
-			if(previous_output_mode_ == OutputMode::Pixels) {
-				if(!pixel_data_) {
-					pixel_pointer_ = pixel_data_ = crt_.begin_data(320, 8);
-				}
-				if(pixel_pointer_) {
-					// the CPC shuffles output lines as:
-					//	MA13 MA12	RA2 RA1 RA0		MA9 MA8 MA7 MA6 MA5 MA4 MA3 MA2 MA1 MA0		CCLK
-					// ... so form the real access address.
-					const uint16_t address =
-						uint16_t(
-							((state.refresh_address & 0x3ff) << 1) |
-							((state.row_address & 0x7) << 11) |
-							((state.refresh_address & 0x3000) << 2)
-						);
-
-					// Fetch two bytes and translate into pixels. Guaranteed: the mode can change only at
-					// hsync, so there's no risk of pixel_pointer_ overrunning 320 output pixels without
-					// exactly reaching 320 output pixels.
-					switch(mode_) {
-						case 0:
-							reinterpret_cast<uint16_t *>(pixel_pointer_)[0] = mode0_output_[ram_[address]];
-							reinterpret_cast<uint16_t *>(pixel_pointer_)[1] = mode0_output_[ram_[address+1]];
-							pixel_pointer_ += 2 * sizeof(uint16_t);
-						break;
-
-						case 1:
-							reinterpret_cast<uint32_t *>(pixel_pointer_)[0] = mode1_output_[ram_[address]];
-							reinterpret_cast<uint32_t *>(pixel_pointer_)[1] = mode1_output_[ram_[address+1]];
-							pixel_pointer_ += 2 * sizeof(uint32_t);
-						break;
-
-						case 2:
-							reinterpret_cast<uint64_t *>(pixel_pointer_)[0] = mode2_output_[ram_[address]];
-							reinterpret_cast<uint64_t *>(pixel_pointer_)[1] = mode2_output_[ram_[address+1]];
-							pixel_pointer_ += 2 * sizeof(uint64_t);
-						break;
-
-						case 3:
-							reinterpret_cast<uint16_t *>(pixel_pointer_)[0] = mode3_output_[ram_[address]];
-							reinterpret_cast<uint16_t *>(pixel_pointer_)[1] = mode3_output_[ram_[address+1]];
-							pixel_pointer_ += 2 * sizeof(uint16_t);
-						break;
-
-					}
+			output(output_mode, state, 1);
+		}
 
-					// Flush the current buffer pixel if full; the CRTC allows many different display
-					// widths so it's not necessarily possible to predict the correct number in advance
-					// and using the upper bound could lead to inefficient behaviour.
-					if(pixel_pointer_ == pixel_data_ + 320) {
-						crt_.output_data(cycles_ * 16, size_t(cycles_ * 16 / pixel_divider_));
-						pixel_pointer_ = pixel_data_ = nullptr;
-						cycles_ = 0;
-					}
-				}
-			}
+		/*!
+			The CRTC entry function for a run of cycles in which nothing changes other than the refresh
+			address; horizontal sync is never active during such a run.
+		*/
+		void perform_bus_cycles(const Motorola::CRTC::BusState &state, int count) {
+			cycles_into_hsync_ = 0;
+			output(state.vsync ? OutputMode::Sync : (state.display_enable ? OutputMode::Pixels : OutputMode::Border), state, count);
+			perform_bus_cycle_phase2(state);
 		}
 
 		/*!
@@ -559,6 +497,94 @@ class CRTCBusHandler {
 		} previous_output_mode_ = OutputMode::Sync;
 		int cycles_ = 0;
 
+		/// Outputs @c count cycles in @c output_mode, beginning at the refresh address in @c state.
+		forceinline void output(OutputMode output_mode, const Motorola::CRTC::BusState &state, int count) {
+			// If a transition between sync/border/pixels just occurred, flush whatever was
+			// in progress to the CRT and reset counting.
+			if(output_mode != previous_output_mode_) {
+				if(cycles_) {
+					switch(previous_output_mode_) {
+						default:
+						case OutputMode::Blank:			crt_.output_blank(cycles_ * 16);				break;
+						case OutputMode::Sync:			crt_.output_sync(cycles_ * 16);					break;
+						case OutputMode::Border:		output_border(cycles_);							break;
+						case OutputMode::ColourBurst:	crt_.output_default_colour_burst(cycles_ * 16);	break;
+						case OutputMode::Pixels:
+							crt_.output_data(cycles_ * 16, size_t(cycles_ * 16 / pixel_divider_));
+							pixel_pointer_ = pixel_data_ = nullptr;
+						break;
+					}
+				}
+
+				cycles_ = 0;
+				previous_output_mode_ = output_mode;
+			}
+
+			// if not outputting pixels, just increment cycles since state changed
+			if(previous_output_mode_ != OutputMode::Pixels) {
+				cycles_ += count;
+				return;
+			}
+
+			// otherwise collect some more pixels, selecting a lookup table just once per span
+			switch(mode_) {
+				case 0:	output_pixels(mode0_output_, state, count);	break;
+				case 1:	output_pixels(mode1_output_, state, count);	break;
+				case 2:	output_pixels(mode2_output_, state, count);	break;
+				case 3:	output_pixels(mode3_output_, state, count);	break;
+			}
+		}
+
+		/*!
+			Outputs @c count cycles of pixels, beginning at the refresh address in @c state, by mapping
+			each fetched byte through @c table, which is the byte-to-pixels table for the current mode
+			with the current palette already applied.
+		*/
+		template <typename PixelType> forceinline void output_pixels(const std::array<PixelType, 256> &table, const Motorola::CRTC::BusState &state, int count) {
+			uint16_t refresh_address = state.refresh_address;
+			while(count) {
+				if(!pixel_data_) {
+					pixel_pointer_ = pixel_data_ = crt_.begin_data(320, 8);
+				}
+				if(!pixel_pointer_) {
+					cycles_ += count;
+					return;
+				}
+
+				// Each cycle fetches two bytes. Guaranteed: the mode can change only at hsync, so there's no
+				// risk of pixel_pointer_ overrunning 320 output pixels without exactly reaching 320 output pixels.
+				const int run = std::min(count, int((pixel_data_ + 320 - pixel_pointer_) / (2 * sizeof(PixelType))));
+				PixelType *target = reinterpret_cast<PixelType *>(pixel_pointer_);
+				for(int c = 0; c < run; c++) {
+					// the CPC shuffles output lines as:
+					//	MA13 MA12	RA2 RA1 RA0		MA9 MA8 MA7 MA6 MA5 MA4 MA3 MA2 MA1 MA0		CCLK
+					// ... so form the real access address.
+					const uint16_t address =
+						uint16_t(
+							((refresh_address & 0x3ff) << 1) |
+							((state.row_address & 0x7) << 11) |
+							((refresh_address & 0x3000) << 2)
+						);
+					target[0] = table[ram_[address]];
+					target[1] = table[ram_[address+1]];
+					target += 2;
+					refresh_address = (refresh_address + 1) & 0x3fff;
+				}
+				pixel_pointer_ = reinterpret_cast<uint8_t *>(target);
+				cycles_ += run;
+				count -= run;
+
+				// Flush the current buffer pixel if full; the CRTC allows many different display
+				// widths so it's not necessarily possible to predict the correct number in advance
+				// and using the upper bound could lead to inefficient behaviour.
+				if(pixel_pointer_ == pixel_data_ + 320) {
+					crt_.output_data(cycles_ * 16, size_t(cycles_ * 16 / pixel_divider_));
+					pixel_pointer_ = pixel_data_ = nullptr;
+					cycles_ = 0;
+				}
+			}
+		}
+
 		bool was_hsync_ = false, was_vsync_ = false;
 		int cycles_into_hsync_ = 0;
 
@@ -757,6 +783,7 @@ template <bool has_fdc> class ConcreteMachine:
 	public MachineTypes::MediaTarget,
 	public MachineTypes::MappedKeyboardMachine,
 	public MachineTypes::JoystickMachine,
+	public MachineTypes::MemoryReporter,
 	public Utility::TypeRecipient<CharacterMapper>,
 	public CPU::Z80::BusHandler,
 	public ClockingHint::Observer,
@@ -838,9 +865,9 @@ template <bool has_fdc> class ConcreteMachine:
 			read_pointers_[2] = write_pointers_[2];
 			read_pointers_[3] = roms_[upper_rom_].data();
 
-			// Type whatever is required.
+			// Enter whatever is required.
 			if(!target.loading_command.empty()) {
-				type_string(target.loading_command);
+				inject_string(target.loading_command);
 			}
 
 			insert_media(target.media);
@@ -852,17 +879,13 @@ template <bool has_fdc> class ConcreteMachine:
 			clock_offset_ = (clock_offset_ + cycle.length) & HalfCycles(7);
 			z80_.set_wait_line(clock_offset_ >= HalfCycles(2));
 
-			// Update the CRTC once every eight half cycles; aiming for half-cycle 4 as
+			// The CRTC runs once every eight half cycles; aiming for half-cycle 4 as
 			// per the initial seed to the crtc_counter_, but any time in the final four
 			// will do as it's safe to conclude that nobody else has touched video RAM
-			// during that whole window
+			// during that whole window. It is clocked lazily, being updated here only if
+			// it might be about to change sync, and therefore affect the interrupt timer.
 			crtc_counter_ += cycle.length;
-			const Cycles crtc_cycles = crtc_counter_.divide_cycles(Cycles(4));
-			if(crtc_cycles > Cycles(0)) crtc_.run_for(crtc_cycles);
-
-			// Check whether that prompted a change in the interrupt line. If so then date
-			// it to whenever the cycle was triggered.
-			if(interrupt_timer_.request_has_changed()) z80_.set_interrupt_line(interrupt_timer_.get_request(), -crtc_counter_);
+			if(crtc_counter_ >= crtc_sequence_point_) flush_crtc();
 
 			// TODO (in the player, not here): adapt it to accept an input clock rate and
 			// run_for as HalfCycles
@@ -886,6 +909,29 @@ template <bool has_fdc> class ConcreteMachine:
 			switch(cycle.operation) {
 				case CPU::Z80::PartialMachineCycle::ReadOpcode:
 
+					// KM WAIT CHAR, KM READ CHAR, KM WAIT KEY and KM READ KEY all return
+					// a character in A with carry set; supply any injected text directly.
+					if(
+						!injected_text_.empty() &&
+						(address == 0xbb06 || address == 0xbb09 || address == 0xbb18 || address == 0xbb1b)
+					) {
+						z80_.set_value_of_register(CPU::Z80::Register::A, uint8_t(injected_text_.front()));
+						z80_.set_value_of_register(
+							CPU::Z80::Register::Flags,
+							z80_.get_value_of_register(CPU::Z80::Register::Flags) | CPU::Z80::Flag::Carry
+						);
+						injected_text_.erase(injected_text_.begin());
+
+						if(injected_text_.empty() && !typed_suffix_.empty()) {
+							type_string(typed_suffix_);
+							typed_suffix_.clear();
+						}
+
+						// RET.
+						*cycle.value = 0xc9;
+						break;
+					}
+
 					// TODO: just capturing byte reads as below doesn't seem to do that much in terms of acceleration;
 					// I'm not immediately clear whether that's just because the machine still has to sit through
 					// pilot tone in real time, or just that almost no software uses the ROM loader.
@@ -919,6 +965,7 @@ template <bool has_fdc> class ConcreteMachine:
 							tape_crc_.add(*byte);
 							crc_value = tape_crc_.get_value();
 
+							flush_crtc();
 							write_pointers_[tape_crc_address >> 14][tape_crc_address & 16383] = uint8_t(crc_value);
 							write_pointers_[(tape_crc_address+1) >> 14][(tape_crc_address+1) & 16383] = uint8_t(crc_value >> 8);
 
@@ -943,10 +990,13 @@ template <bool has_fdc> class ConcreteMachine:
 				break;
 
 				case CPU::Z80::PartialMachineCycle::Write:
+					flush_crtc();
 					write_pointers_[address >> 14][address & 16383] = *cycle.value;
 				break;
 
 				case CPU::Z80::PartialMachineCycle::Output:
+					flush_crtc();
+
 					// Check for a gate array access.
 					if((address & 0xc000) == 0x4000) {
 						write_to_gate_array(*cycle.value);
@@ -964,7 +1014,7 @@ template <bool has_fdc> class ConcreteMachine:
 					if(!(address & 0x4000)) {
 						switch((address >> 8) & 3) {
 							case 0:	crtc_.select_register(*cycle.value);	break;
-							case 1:	crtc_.set_register(*cycle.value);		break;
+							case 1:	crtc_.set_register(*cycle.value);	flush_crtc();	break;
 							default: break;
 						}
 					}
@@ -990,6 +1040,8 @@ template <bool has_fdc> class ConcreteMachine:
 				break;
 
 				case CPU::Z80::PartialMachineCycle::Input:
+					flush_crtc();
+
 					// Default to nothing answering
 					*cycle.value = 0xff;
 
@@ -1001,7 +1053,8 @@ template <bool has_fdc> class ConcreteMachine:
 					// Check for an FDC access
 					if constexpr (has_fdc) {
 						if((address & 0x580) == 0x100) {
-							flush_fdc();
+							// Polling an FDC that is waiting for the CPU can't observe the passage of time.
+							if(!fdc_.is_awaiting_host()) flush_fdc();
 							*cycle.value &= fdc_.read(address & 1);
 						}
 					}
@@ -1011,7 +1064,7 @@ template <bool has_fdc> class ConcreteMachine:
 					if(!(address & 0x4000)) {
 						switch((address >> 8) & 3) {
 							case 0:	crtc_.select_register(*cycle.value);	break;
-							case 1:	crtc_.set_register(*cycle.value);		break;
+							case 1:	crtc_.set_register(*cycle.value);	flush_crtc();	break;
 							case 2: *cycle.value &= crtc_.get_status();		break;
 							case 3:	*cycle.value &= crtc_.get_register();	break;
 						}
@@ -1028,6 +1081,7 @@ template <bool has_fdc> class ConcreteMachine:
 					// Nothing is loaded onto the bus during an interrupt acknowledge, but
 					// the fact of the acknowledge needs to be posted on to the interrupt timer.
 					*cycle.value = 0xff;
+					flush_crtc();
 					interrupt_timer_.signal_interrupt_acknowledge();
 				break;
 
@@ -1046,12 +1100,27 @@ template <bool has_fdc> class ConcreteMachine:
 
 		/// Another Z80 entry point; indicates that a partcular run request has concluded.
 		void flush() {
-			// Just flush the AY.
+			// Bring video up to date and flush the AY.
+			flush_crtc();
 			ay_.update();
 			ay_.flush();
 			flush_fdc();
 		}
 
+		/// The MemoryReporter entry point.
+		void report_memory(MachineTypes::MemoryFootprint &footprint) final {
+			using Kind = MachineTypes::MemoryFootprint::Kind;
+			flush();
+
+			footprint.add("RAM", Kind::RAM, sizeof(ram_));
+			footprint.add("ROM", Kind::ROM, roms_[0].size() + roms_[1].size() + roms_[2].size());
+			footprint.add("Z80", Kind::ProcessorTables, z80_.get_table_footprint());
+			footprint.add("AY", Kind::AudioBuffers, ay_.get_speaker_memory_footprint());
+			if constexpr (has_fdc) {
+				footprint.add("FDC", Kind::DiskTracks, fdc_.get_disk_memory_footprint());
+			}
+		}
+
 		/// A CRTMachine function; sets the destination for video.
 		void set_scan_target(Outputs::Display::ScanTarget *scan_target) final {
 			crtc_bus_handler_.set_scan_target(scan_target);
@@ -1114,6 +1183,30 @@ template <bool has_fdc> class ConcreteMachine:
 			return Utility::TypeRecipient<CharacterMapper>::can_type(c);
 		}
 
+		/*!
+			Supplies @c string directly to whatever next asks the firmware for characters, via the
+			key manager's jumpblock, rather than typing it. This avoids both waiting for the firmware
+			to finish starting up and the real-time cost of each key transition.
+
+			Anything after the final newline is typed as usual once the rest has been consumed, as
+			it may be intended for software that scans the keyboard directly.
+		*/
+		void inject_string(const std::string &string) {
+			const auto final_newline = string.rfind('\n');
+			if(final_newline == std::string::npos) {
+				type_string(string);
+				return;
+			}
+
+			std::transform(
+				string.begin(),
+				string.begin() + std::string::difference_type(final_newline + 1),
+				std::back_inserter(injected_text_),
+				[](unsigned char c) -> unsigned char { return (c == '\n') ? '\r' : c; }
+			);
+			typed_suffix_ += string.substr(final_newline + 1);
+		}
+
 		HalfCycles get_typer_delay(const std::string &) const final {
 			return z80_.get_is_resetting() ? Cycles(3'400'000) : Cycles(0);
 		}
@@ -1246,6 +1339,18 @@ template <bool has_fdc> class ConcreteMachine:
 
 		HalfCycles clock_offset_;
 		HalfCycles crtc_counter_;
+		HalfCycles crtc_sequence_point_;
+
+		/// Runs the CRTC up to now, and updates the interrupt line if that causes any change.
+		void flush_crtc() {
+			const Cycles crtc_cycles = crtc_counter_.divide_cycles(Cycles(4));
+			if(crtc_cycles > Cycles(0)) crtc_.run_for(crtc_cycles);
+			crtc_sequence_point_ = HalfCycles(8 * crtc_.get_cycles_until_sync_change());
+
+			// Check whether that prompted a change in the interrupt line. If so then date
+			// it to whenever the cycle was triggered.
+			if(interrupt_timer_.request_has_changed()) z80_.set_interrupt_line(interrupt_timer_.get_request(), -crtc_counter_);
+		}
 		HalfCycles half_cycles_since_ay_update_;
 
 		bool fdc_is_sleeping_;
@@ -1265,6 +1370,7 @@ template <bool has_fdc> class ConcreteMachine:
 
 		KeyboardState key_state_;
 		AmstradCPC::KeyboardMapper keyboard_mapper_;
+		std::string injected_text_, typed_suffix_;
 
 		bool has_run_ = false;
 		uint8_t ram_[128 * 1024];
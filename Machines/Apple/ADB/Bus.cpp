@@ -91,13 +91,15 @@ void Bus::shift(unsigned int value) {
 }
 
 bool Bus::get_state() const {
-	const auto microseconds = time_since_get_state_.as<double>() * half_cycles_to_microseconds_;
-	time_since_get_state_ = HalfCycles(0);
+	if(busy_devices_) {
+		const auto microseconds = time_since_get_state_.as<double>() * half_cycles_to_microseconds_;
 
-	const bool current_level = bus_state_.all();
-	for(auto device: devices_) {
-		device->advance_state(microseconds, current_level);
+		const bool current_level = bus_state_.all();
+		for(auto device: devices_) {
+			device->advance_state(microseconds, current_level);
+		}
 	}
+	time_since_get_state_ = HalfCycles(0);
 	return bus_state_.all();
 }
 
@@ -144,12 +144,22 @@ class Bus {
 		*/
 		size_t add_device(Device *);
 
+		/*!
+			Indicates that a reactive device has begun or ceased to have output pending. Devices
+			are offered @c advance_state only while at least one has; a device that has no pending
+			output must not be dependent on those calls.
+		*/
+		void set_device_is_busy(bool busy) {
+			busy_devices_ += busy ? 1 : -1;
+		}
+
 	private:
 		HalfCycles time_in_state_;
 		mutable HalfCycles time_since_get_state_;
 
 		double half_cycles_to_microseconds_ = 1.0;
 		std::vector<Device *> devices_;
+		int busy_devices_ = 0;
 		unsigned int shift_register_ = 0;
 		unsigned int start_target_ = 8;
 		bool data_level_ = true;
@@ -24,9 +24,23 @@ void ReactiveDevice::post_response(const std::vector<uint8_t> &&response) {
 	response_ = std::move(response);
 	microseconds_at_bit_ = 0.0;
 	bit_offset_ = -2;
+	update_busy();
+}
+
+void ReactiveDevice::update_busy() {
+	const bool is_busy = phase_ == Phase::ServiceRequestPending || !response_.empty();
+	if(is_busy != is_busy_) {
+		is_busy_ = is_busy;
+		bus_.set_device_is_busy(is_busy);
+	}
 }
 
 void ReactiveDevice::advance_state(double microseconds, bool current_level) {
+	advance_output(microseconds, current_level);
+	update_busy();
+}
+
+void ReactiveDevice::advance_output(double microseconds, bool current_level) {
 	// First test: is a service request desired?
 	if(phase_ == Phase::ServiceRequestPending) {
 		microseconds_at_bit_ += microseconds;
@@ -135,6 +149,7 @@ void ReactiveDevice::adb_bus_did_observe_event(Bus::Event event, uint8_t value)
 				stop_has_begin_ = false;
 				phase_ = Phase::ServiceRequestPending;
 				microseconds_at_bit_ = 0.0;
+				update_busy();
 			}
 			return;
 		}
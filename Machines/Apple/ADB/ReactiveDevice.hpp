@@ -33,6 +33,8 @@ class ReactiveDevice: public Bus::Device {
 		void advance_state(double microseconds, bool current_level) override;
 		void adb_bus_did_observe_event(Bus::Event event, uint8_t value) override;
 
+		void advance_output(double microseconds, bool current_level);
+
 	private:
 		Bus &bus_;
 		const size_t device_id_;
@@ -57,6 +59,11 @@ class ReactiveDevice: public Bus::Device {
 
 		std::atomic<bool> service_desired_ = false;
 
+		// Tracks whether there is output pending, i.e. either a service request
+		// or a response, and keeps the bus informed.
+		bool is_busy_ = false;
+		void update_busy();
+
 		void reset();
 };
 
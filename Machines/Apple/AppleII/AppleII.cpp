@@ -47,6 +47,7 @@ template <Analyser::Static::AppleII::Target::Model model> class ConcreteMachine:
 	public MachineTypes::MediaTarget,
 	public MachineTypes::MappedKeyboardMachine,
 	public MachineTypes::JoystickMachine,
+	public MachineTypes::MemoryReporter,
 	public CPU::MOS6502::BusHandler,
 	public Configurable::Device,
 	public Activity::Source,
@@ -189,7 +190,7 @@ template <Analyser::Static::AppleII::Target::Model model> class ConcreteMachine:
 		friend LanguageCardSwitches<ConcreteMachine>;
 		friend AuxiliaryMemorySwitches<ConcreteMachine>;
 
-		void set_language_card_paging() {
+		void set_language_card_paging(int changes = LanguageCardSwitches<ConcreteMachine>::AllRegions) {
 			const auto language_state = language_card_.state();
 			const auto zero_state = auxiliary_switches_.zero_state();
 
@@ -198,23 +199,28 @@ template <Analyser::Static::AppleII::Target::Model model> class ConcreteMachine:
 
 			// Which way the region here is mapped to be banks 1 and 2 is
 			// arbitrary.
-			page(0xd0, 0xe0,
-				language_state.read ? &ram[language_state.bank2 ? 0xd000 : 0xc000] : rom,
-				language_state.write ? nullptr : &ram[language_state.bank2 ? 0xd000 : 0xc000]);
+			if(changes & LanguageCardSwitches<ConcreteMachine>::RegionD0_E0) {
+				page(0xd0, 0xe0,
+					language_state.read ? &ram[language_state.bank2 ? 0xd000 : 0xc000] : rom,
+					language_state.write ? nullptr : &ram[language_state.bank2 ? 0xd000 : 0xc000]);
+			}
 
-			page(0xe0, 0x100,
-				language_state.read ? &ram[0xe000] : &rom[0x1000],
-				language_state.write ? nullptr : &ram[0xe000]);
+			if(changes & LanguageCardSwitches<ConcreteMachine>::RegionE0_100) {
+				page(0xe0, 0x100,
+					language_state.read ? &ram[0xe000] : &rom[0x1000],
+					language_state.write ? nullptr : &ram[0xe000]);
+			}
 		}
 
 		// MARK: Auxiliary memory and the other IIe improvements.
-		void set_card_paging() {
+		void set_card_paging(int changes = AuxiliaryMemorySwitches<ConcreteMachine>::CardAll) {
+			using Switches = AuxiliaryMemorySwitches<ConcreteMachine>;
 			const auto state = auxiliary_switches_.card_state();
 
-			page(0xc1, 0xc4, state.region_C1_C3 ? &rom_[0xc100 - 0xc100] : nullptr, nullptr);
-			read_pages_[0xc3] = state.region_C3 ? &rom_[0xc300 - 0xc100] : nullptr;
-			page(0xc4, 0xc8, state.region_C4_C8 ? &rom_[0xc400 - 0xc100]  : nullptr, nullptr);
-			page(0xc8, 0xd0, state.region_C8_D0 ? &rom_[0xc800 - 0xc100]  : nullptr, nullptr);
+			if(changes & Switches::CardC1_C3) page(0xc1, 0xc3, state.region_C1_C3 ? &rom_[0xc100 - 0xc100] : nullptr, nullptr);
+			if(changes & Switches::CardC3) page(0xc3, 0xc4, state.region_C3 ? &rom_[0xc300 - 0xc100] : nullptr, nullptr);
+			if(changes & Switches::CardC4_C8) page(0xc4, 0xc8, state.region_C4_C8 ? &rom_[0xc400 - 0xc100] : nullptr, nullptr);
+			if(changes & Switches::CardC8_D0) page(0xc8, 0xd0, state.region_C8_D0 ? &rom_[0xc800 - 0xc100] : nullptr, nullptr);
 		}
 		void set_zero_page_paging() {
 			if(auxiliary_switches_.zero_state()) {
@@ -229,26 +235,35 @@ template <Analyser::Static::AppleII::Target::Model model> class ConcreteMachine:
 			// Zero page banking also affects interpretation of the language card's switches.
 			set_language_card_paging();
 		}
-		void set_main_paging() {
+		void set_main_paging(int changes = AuxiliaryMemorySwitches<ConcreteMachine>::MainAll) {
+			using Switches = AuxiliaryMemorySwitches<ConcreteMachine>;
 			const auto state = auxiliary_switches_.main_state();
 
-			page(0x02, 0x04,
-				state.base.read ? &aux_ram_[0x0200] : &ram_[0x0200],
-				state.base.write ? &aux_ram_[0x0200] : &ram_[0x0200]);
-			page(0x08, 0x20,
-				state.base.read ? &aux_ram_[0x0800] : &ram_[0x0800],
-				state.base.write ? &aux_ram_[0x0800] : &ram_[0x0800]);
-			page(0x40, 0xc0,
-				state.base.read ? &aux_ram_[0x4000] : &ram_[0x4000],
-				state.base.write ? &aux_ram_[0x4000] : &ram_[0x4000]);
+			// Only those regions that have changed are repaged; PAGE2 under 80STORE, for example,
+			// therefore touches only the 16 pages of the text and high-resolution screens.
+			if(changes & Switches::MainBase) {
+				page(0x02, 0x04,
+					state.base.read ? &aux_ram_[0x0200] : &ram_[0x0200],
+					state.base.write ? &aux_ram_[0x0200] : &ram_[0x0200]);
+				page(0x08, 0x20,
+					state.base.read ? &aux_ram_[0x0800] : &ram_[0x0800],
+					state.base.write ? &aux_ram_[0x0800] : &ram_[0x0800]);
+				page(0x40, 0xc0,
+					state.base.read ? &aux_ram_[0x4000] : &ram_[0x4000],
+					state.base.write ? &aux_ram_[0x4000] : &ram_[0x4000]);
+			}
 
-			page(0x04, 0x08,
-				state.region_04_08.read ? &aux_ram_[0x0400] : &ram_[0x0400],
-				state.region_04_08.write ? &aux_ram_[0x0400] : &ram_[0x0400]);
+			if(changes & Switches::Main04_08) {
+				page(0x04, 0x08,
+					state.region_04_08.read ? &aux_ram_[0x0400] : &ram_[0x0400],
+					state.region_04_08.write ? &aux_ram_[0x0400] : &ram_[0x0400]);
+			}
 
-			page(0x20, 0x40,
-				state.region_20_40.read ? &aux_ram_[0x2000] : &ram_[0x2000],
-				state.region_20_40.write ? &aux_ram_[0x2000] : &ram_[0x2000]);
+			if(changes & Switches::Main20_40) {
+				page(0x20, 0x40,
+					state.region_20_40.read ? &aux_ram_[0x2000] : &ram_[0x2000],
+					state.region_20_40.write ? &aux_ram_[0x2000] : &ram_[0x2000]);
+			}
 		}
 
 		// MARK: - Keyboard and typing.
@@ -818,6 +833,21 @@ template <Analyser::Static::AppleII::Target::Model model> class ConcreteMachine:
 			audio_queue_.perform();
 		}
 
+		// MARK: - MemoryReporter.
+		void report_memory(MachineTypes::MemoryFootprint &footprint) final {
+			using Kind = MachineTypes::MemoryFootprint::Kind;
+			flush();
+			audio_queue_.flush();
+
+			footprint.add("RAM", Kind::RAM, sizeof(ram_) + sizeof(aux_ram_));
+			footprint.add("ROM", Kind::ROM, rom_.size());
+			footprint.add("6502", Kind::ProcessorTables, m6502_.get_table_footprint());
+			footprint.add("Speaker", Kind::AudioBuffers, speaker_.get_memory_footprint());
+
+			const auto diskii = diskii_card();
+			if(diskii) footprint.add("Disk II card", Kind::DiskTracks, diskii->get_disk_memory_footprint());
+		}
+
 		void run_for(const Cycles cycles) final {
 			m6502_.run_for(cycles);
 		}
@@ -17,10 +17,13 @@ namespace II {
 	the additional almost-4kb of ROM.
 
 	Relevant memory accesses should be fed to this class; it'll call:
-		* machine.set_main_paging() if anything in the 'main' state changes, i.e. the lower 48kb excluding the zero and stack pages;
-		* machine.set_card_state() if anything changes with where ROM should appear rather than cards in the $Cxxx range; and
+		* machine.set_main_paging(changes) if anything in the 'main' state changes, i.e. the lower 48kb excluding the zero and stack pages;
+		* machine.set_card_paging(changes) if anything changes with where ROM should appear rather than cards in the $Cxxx range; and
 		* machine.set_zero_page_paging() if the selection of the lowest two pages of RAM changes.
 
+	In each case @c changes is a combination of the relevant region flags below, identifying which regions have
+	changed so that the machine need remap only those pages.
+
 	Implementation observation: as implemented on the IIe, the zero page setting also affects what happens in the language card area.
 */
 template <typename Machine> class AuxiliaryMemorySwitches {
@@ -30,6 +33,19 @@ template <typename Machine> class AuxiliaryMemorySwitches {
 		static constexpr bool ROM = true;
 		static constexpr bool Card = false;
 
+		/// Flags identifying the regions of MainState.
+		static constexpr int MainBase = 1 << 0;
+		static constexpr int Main04_08 = 1 << 1;
+		static constexpr int Main20_40 = 1 << 2;
+		static constexpr int MainAll = MainBase | Main04_08 | Main20_40;
+
+		/// Flags identifying the regions of CardState.
+		static constexpr int CardC1_C3 = 1 << 0;
+		static constexpr int CardC3 = 1 << 1;
+		static constexpr int CardC4_C8 = 1 << 2;
+		static constexpr int CardC8_D0 = 1 << 3;
+		static constexpr int CardAll = CardC1_C3 | CardC3 | CardC4_C8 | CardC8_D0;
+
 		/// Describes banking state between $0200 and $BFFF.
 		struct MainState {
 			struct Region {
@@ -37,6 +53,10 @@ template <typename Machine> class AuxiliaryMemorySwitches {
 				bool read = false;
 				/// @c true indicates auxiliary memory should be written to; @c false indicates main.
 				bool write = false;
+
+				bool operator != (const Region &rhs) const {
+					return read != rhs.read || write != rhs.write;
+				}
 			};
 
 			/// Describes banking state in the ranges $0200–$03FF, $0800–$1FFF and $4000–$BFFF.
@@ -46,11 +66,12 @@ template <typename Machine> class AuxiliaryMemorySwitches {
 			/// Describes banking state in the range $2000–$3FFF.
 			Region region_20_40;
 
-			bool operator != (const MainState &rhs) const {
+			/// @returns The set of region flags identifying those regions that differ between this state and @c rhs.
+			int changes(const MainState &rhs) const {
 				return
-					base.read != rhs.base.read || base.write != rhs.base.write ||
-					region_04_08.read != rhs.region_04_08.read || region_04_08.write != rhs.region_04_08.write ||
-					region_20_40.read != rhs.region_20_40.read || region_20_40.write != rhs.region_20_40.write;
+					(base != rhs.base ? MainBase : 0) |
+					(region_04_08 != rhs.region_04_08 ? Main04_08 : 0) |
+					(region_20_40 != rhs.region_20_40 ? Main20_40 : 0);
 			}
 		};
 
@@ -65,12 +86,13 @@ template <typename Machine> class AuxiliaryMemorySwitches {
 			/// @c true indicates that the built-in ROM should appear from $C800 to $CFFF; @c false indicates that cards should service those accesses.
 			bool region_C8_D0 = false;
 
-			bool operator != (const CardState &rhs) const {
+			/// @returns The set of region flags identifying those regions that differ between this state and @c rhs.
+			int changes(const CardState &rhs) const {
 				return
-					region_C1_C3 != rhs.region_C1_C3 ||
-					region_C3 != rhs.region_C3 ||
-					region_C4_C8 != rhs.region_C4_C8 ||
-					region_C8_D0 != rhs.region_C8_D0;
+					(region_C1_C3 != rhs.region_C1_C3 ? CardC1_C3 : 0) |
+					(region_C3 != rhs.region_C3 ? CardC3 : 0) |
+					(region_C4_C8 != rhs.region_C4_C8 ? CardC4_C8 : 0) |
+					(region_C8_D0 != rhs.region_C8_D0 ? CardC8_D0 : 0);
 			}
 		};
 
@@ -234,8 +256,8 @@ template <typename Machine> class AuxiliaryMemorySwitches {
 				main_state_.region_04_08 = main_state_.region_20_40 = main_state_.base;
 			}
 
-			if(previous_state != main_state_) {
-				machine_.set_main_paging();
+			if(const int changes = main_state_.changes(previous_state)) {
+				machine_.set_main_paging(changes);
 			}
 		}
 
@@ -257,8 +279,8 @@ template <typename Machine> class AuxiliaryMemorySwitches {
 			// Apply the CX switch to $C800+, but also allow the C8 switch to select that region in isolation.
 			card_state_.region_C8_D0 = switches_.internal_CX_rom || switches_.internal_C8_rom;
 
-			if(previous_state != card_state_) {
-				machine_.set_card_paging();
+			if(const int changes = card_state_.changes(previous_state)) {
+				machine_.set_card_paging(changes);
 			}
 		}
 
@@ -36,6 +36,11 @@ class DiskIICard: public Card, public ClockingHint::Observer {
 		void set_disk(const std::shared_ptr<Storage::Disk::Disk> &disk, int drive);
 		Storage::Disk::Drive &get_drive(int drive);
 
+		/// @returns The number of bytes of host memory occupied by tracks of the disks in both drives.
+		size_t get_disk_memory_footprint() const {
+			return diskii_.get_disk_memory_footprint();
+		}
+
 	private:
 		void set_component_prefers_clocking(ClockingHint::Source *component, ClockingHint::Preference clocking) final;
 		std::vector<uint8_t> boot_;
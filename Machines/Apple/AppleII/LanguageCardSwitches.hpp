@@ -16,10 +16,16 @@ namespace II {
 	Models the language card soft switches, present on any Apple II with a language card and provided built-in from the IIe onwards.
 
 	Relevant memory accesses should be fed to this class; it'll call:
-		* machine.set_language_card_paging() if the proper mapped state changes.
+		* machine.set_language_card_paging(changes) if the proper mapped state changes, with @c changes being
+		a combination of the region flags below that identifies which parts of $D000–$FFFF are affected.
 */
 template <typename Machine> class LanguageCardSwitches {
 	public:
+		/// Flags identifying the two independently-banked parts of the language card area.
+		static constexpr int RegionD0_E0 = 1 << 0;
+		static constexpr int RegionE0_100 = 1 << 1;
+		static constexpr int AllRegions = RegionD0_E0 | RegionE0_100;
+
 		struct State {
 			/// When RAM is visible in the range $D000–$FFFF:
 			/// @c true indicates that bank 2 should be used between $D000 and $DFFF;
@@ -34,11 +40,12 @@ template <typename Machine> class LanguageCardSwitches {
 			/// @c false indicates that RAM is selected for writing.
 			bool write = false;
 
-			bool operator != (const State &rhs) const {
-				return
-					bank2 != rhs.bank2 ||
-					read != rhs.read ||
-					write != rhs.write;
+			/// @returns The set of region flags identifying those regions mapped differently by this state and @c rhs.
+			int changes(const State &rhs) const {
+				// Bank selection affects only $D000–$DFFF, and only if RAM is visible there for reading or writing.
+				if(read != rhs.read || write != rhs.write) return AllRegions;
+				if(bank2 != rhs.bank2 && (read || !write)) return RegionD0_E0;
+				return 0;
 			}
 		};
 
@@ -69,8 +76,8 @@ template <typename Machine> class LanguageCardSwitches {
 			pre_write_ = is_read ? (address&1) : false;
 
 			// Apply whatever the net effect of all that is to the memory map.
-			if(previous_state != state_) {
-				machine_.set_language_card_paging();
+			if(const int changes = state_.changes(previous_state)) {
+				machine_.set_language_card_paging(changes);
 			}
 		}
 
@@ -89,8 +96,8 @@ template <typename Machine> class LanguageCardSwitches {
 			// correcting the original, which lists them the other way around]
 			state_.bank2 = value & 0x04;
 
-			if(previous_state != state_) {
-				machine_.set_language_card_paging();
+			if(const int changes = state_.changes(previous_state)) {
+				machine_.set_language_card_paging(changes);
 			}
 		}
 
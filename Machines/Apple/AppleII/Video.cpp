@@ -8,6 +8,8 @@
 
 #include "Video.hpp"
 
+#include <cstring>
+
 using namespace Apple::II::Video;
 
 VideoBase::VideoBase(bool is_iie, std::function<void(Cycles)> &&target) :
@@ -76,6 +78,90 @@ Outputs::Display::DisplayType VideoBase::get_display_type() const {
 	return crt_.get_display_type();
 }
 
+namespace {
+
+/*!
+	Per-byte expansions from video bytes to the fourteen 14Mhz samples that they produce,
+	or the seven produced by each half of the double modes; entries hold exactly the values
+	that the equivalent bitwise tests would.
+*/
+struct ExpansionTables {
+	/// Character patterns, MSB first, each pixel doubled; indexed by the low seven bits of the pattern.
+	uint8_t text[128][14];
+
+	/// Character patterns, MSB first; indexed by the low seven bits of the pattern.
+	uint8_t double_text[128][7];
+
+	/// High-resolution bytes, LSB first, each pixel doubled; indexed by byte with bit 7 clear for an
+	/// undelayed byte or set for a byte delayed by half a pixel. Delayed bytes leave sample 0
+	/// for the caller to fill with the previous output level.
+	uint8_t high_resolution[256][14];
+
+	/// Double high-resolution bytes, LSB first; indexed by the low seven bits of each byte.
+	uint8_t double_high_resolution[128][7];
+
+	/// Low-resolution nibbles, indexed by whether the column is odd, then by nibble.
+	uint8_t low_resolution[2][16][14];
+
+	/// Fat low-resolution nibbles.
+	uint8_t fat_low_resolution[16][14];
+
+	/// Double low-resolution nibbles, indexed by whether the column is odd, then by nibble, for
+	/// auxiliary and main memory respectively; the main memory entries provide samples 7–13.
+	uint8_t double_low_resolution_auxiliary[2][16][7];
+	uint8_t double_low_resolution_main[2][16][7];
+};
+
+const ExpansionTables expansions = [] {
+	ExpansionTables tables{};
+
+	for(int c = 0; c < 128; c++) {
+		for(int bit = 0; bit < 7; bit++) {
+			tables.text[c][bit*2] = tables.text[c][bit*2 + 1] = uint8_t(c & (0x40 >> bit));
+			tables.double_text[c][bit] = uint8_t(c & (0x40 >> bit));
+			tables.double_high_resolution[c][bit] = uint8_t(c & (1 << bit));
+
+			tables.high_resolution[c][bit*2] = tables.high_resolution[c][bit*2 + 1] = uint8_t(c & (1 << bit));
+			if(bit < 6) {
+				tables.high_resolution[c | 0x80][bit*2 + 1] = tables.high_resolution[c | 0x80][bit*2 + 2] = uint8_t(c & (1 << bit));
+			}
+		}
+		tables.high_resolution[c | 0x80][13] = uint8_t(c & 0x40);
+	}
+
+	for(int c = 0; c < 16; c++) {
+		// Odd columns rotate the colour code by two bits relative to even.
+		auto &even = tables.low_resolution[0][c], &odd = tables.low_resolution[1][c];
+		for(int sample = 0; sample < 14; sample++) {
+			even[sample] = uint8_t(c & (1 << (sample & 3)));
+			odd[sample] = uint8_t(c & (1 << ((sample + 2) & 3)));
+		}
+
+		auto &fat = tables.fat_low_resolution[c];
+		for(int sample = 0; sample < 14; sample++) {
+			fat[sample] = uint8_t(c & (1 << ((sample >> 1) & 3)));
+		}
+
+		auto &even_auxiliary = tables.double_low_resolution_auxiliary[0][c];
+		auto &odd_auxiliary = tables.double_low_resolution_auxiliary[1][c];
+		for(int sample = 0; sample < 7; sample++) {
+			even_auxiliary[sample] = uint8_t(c & (1 << (sample & 3)));
+			odd_auxiliary[sample] = uint8_t(c & (1 << ((sample + 2) & 3)));
+		}
+
+		auto &even_main = tables.double_low_resolution_main[0][c];
+		auto &odd_main = tables.double_low_resolution_main[1][c];
+		for(int sample = 7; sample < 14; sample++) {
+			even_main[sample - 7] = uint8_t(c & (1 << ((sample + 1) & 3)));
+			odd_main[sample - 7] = uint8_t(c & (1 << ((sample + 3) & 3)));
+		}
+	}
+
+	return tables;
+}();
+
+}
+
 void VideoBase::output_text(uint8_t *target, const uint8_t *const source, size_t length, size_t pixel_row) const {
 	for(size_t c = 0; c < length; ++c) {
 		const int character = source[c] & character_zones_[source[c] >> 6].address_mask;
@@ -84,13 +170,7 @@ void VideoBase::output_text(uint8_t *target, const uint8_t *const source, size_t
 		const uint8_t character_pattern = character_rom_[character_address] ^ xor_mask;
 
 		// The character ROM is output MSB to LSB rather than LSB to MSB.
-		target[0] = target[1] = character_pattern & 0x40;
-		target[2] = target[3] = character_pattern & 0x20;
-		target[4] = target[5] = character_pattern & 0x10;
-		target[6] = target[7] = character_pattern & 0x08;
-		target[8] = target[9] = character_pattern & 0x04;
-		target[10] = target[11] = character_pattern & 0x02;
-		target[12] = target[13] = character_pattern & 0x01;
+		memcpy(target, expansions.text[character_pattern & 0x7f], 14);
 		graphics_carry_ = character_pattern & 0x01;
 		target += 14;
 	}
@@ -117,20 +197,8 @@ void VideoBase::output_double_text(uint8_t *target, const uint8_t *const source,
 		};
 
 		// The character ROM is output MSB to LSB rather than LSB to MSB.
-		target[0] = character_patterns[0] & 0x40;
-		target[1] = character_patterns[0] & 0x20;
-		target[2] = character_patterns[0] & 0x10;
-		target[3] = character_patterns[0] & 0x08;
-		target[4] = character_patterns[0] & 0x04;
-		target[5] = character_patterns[0] & 0x02;
-		target[6] = character_patterns[0] & 0x01;
-		target[7] = character_patterns[1] & 0x40;
-		target[8] = character_patterns[1] & 0x20;
-		target[9] = character_patterns[1] & 0x10;
-		target[10] = character_patterns[1] & 0x08;
-		target[11] = character_patterns[1] & 0x04;
-		target[12] = character_patterns[1] & 0x02;
-		target[13] = character_patterns[1] & 0x01;
+		memcpy(&target[0], expansions.double_text[character_patterns[0] & 0x7f], 7);
+		memcpy(&target[7], expansions.double_text[character_patterns[1] & 0x7f], 7);
 		graphics_carry_ = character_patterns[1] & 0x01;
 		target += 14;
 	}
@@ -141,19 +209,10 @@ void VideoBase::output_low_resolution(uint8_t *target, const uint8_t *const sour
 	for(size_t c = 0; c < length; ++c) {
 		// Low-resolution graphics mode shifts the colour code on a loop, but has to account for whether this
 		// 14-sample output window is starting at the beginning of a colour cycle or halfway through.
-		if((column + int(c))&1) {
-			target[0] = target[4] = target[8] = target[12] = (source[c] >> row_shift) & 4;
-			target[1] = target[5] = target[9] = target[13] = (source[c] >> row_shift) & 8;
-			target[2] = target[6] = target[10] = (source[c] >> row_shift) & 1;
-			target[3] = target[7] = target[11] = (source[c] >> row_shift) & 2;
-			graphics_carry_ = (source[c] >> row_shift) & 8;
-		} else {
-			target[0] = target[4] = target[8] = target[12] = (source[c] >> row_shift) & 1;
-			target[1] = target[5] = target[9] = target[13] = (source[c] >> row_shift) & 2;
-			target[2] = target[6] = target[10] = (source[c] >> row_shift) & 4;
-			target[3] = target[7] = target[11] = (source[c] >> row_shift) & 8;
-			graphics_carry_ = (source[c] >> row_shift) & 2;
-		}
+		const int is_odd = (column + int(c))&1;
+		const int nibble = (source[c] >> row_shift) & 0xf;
+		memcpy(target, expansions.low_resolution[is_odd][nibble], 14);
+		graphics_carry_ = uint8_t(nibble & (is_odd ? 8 : 2));
 		target += 14;
 	}
 }
@@ -163,11 +222,9 @@ void VideoBase::output_fat_low_resolution(uint8_t *target, const uint8_t *const
 	for(size_t c = 0; c < length; ++c) {
 		// Fat low-resolution mode appears not to do anything to try to make odd and
 		// even columns compatible.
-		target[0] = target[1] = target[8] = target[9] = (source[c] >> row_shift) & 1;
-		target[2] = target[3] = target[10] = target[11] = (source[c] >> row_shift) & 2;
-		target[4] = target[5] = target[12] = target[13] = (source[c] >> row_shift) & 4;
-		target[6] = target[7] = (source[c] >> row_shift) & 8;
-		graphics_carry_ = (source[c] >> row_shift) & 4;
+		const int nibble = (source[c] >> row_shift) & 0xf;
+		memcpy(target, expansions.fat_low_resolution[nibble], 14);
+		graphics_carry_ = uint8_t(nibble & 4);
 		target += 14;
 	}
 }
@@ -175,29 +232,11 @@ void VideoBase::output_fat_low_resolution(uint8_t *target, const uint8_t *const
 void VideoBase::output_double_low_resolution(uint8_t *target, const uint8_t *const source, const uint8_t *const auxiliary_source, size_t length, int column, int row) const {
 	const int row_shift = row&4;
 	for(size_t c = 0; c < length; ++c) {
-		if((column + int(c))&1) {
-			target[0] = target[4] = (auxiliary_source[c] >> row_shift) & 4;
-			target[1] = target[5] = (auxiliary_source[c] >> row_shift) & 8;
-			target[2] = target[6] = (auxiliary_source[c] >> row_shift) & 1;
-			target[3] = (auxiliary_source[c] >> row_shift) & 2;
-
-			target[8] = target[12] = (source[c] >> row_shift) & 8;
-			target[9] = target[13] = (source[c] >> row_shift) & 1;
-			target[10] = (source[c] >> row_shift) & 2;
-			target[7] = target[11] = (source[c] >> row_shift) & 4;
-			graphics_carry_ = (source[c] >> row_shift) & 8;
-		} else {
-			target[0] = target[4] = (auxiliary_source[c] >> row_shift) & 1;
-			target[1] = target[5] = (auxiliary_source[c] >> row_shift) & 2;
-			target[2] = target[6] = (auxiliary_source[c] >> row_shift) & 4;
-			target[3] = (auxiliary_source[c] >> row_shift) & 8;
-
-			target[8] = target[12] = (source[c] >> row_shift) & 2;
-			target[9] = target[13] = (source[c] >> row_shift) & 4;
-			target[10] = (source[c] >> row_shift) & 8;
-			target[7] = target[11] = (source[c] >> row_shift) & 1;
-			graphics_carry_ = (source[c] >> row_shift) & 2;
-		}
+		const int is_odd = (column + int(c))&1;
+		const int nibble = (source[c] >> row_shift) & 0xf;
+		memcpy(&target[0], expansions.double_low_resolution_auxiliary[is_odd][(auxiliary_source[c] >> row_shift) & 0xf], 7);
+		memcpy(&target[7], expansions.double_low_resolution_main[is_odd][nibble], 7);
+		graphics_carry_ = uint8_t(nibble & (is_odd ? 8 : 2));
 		target += 14;
 	}
 }
@@ -208,23 +247,10 @@ void VideoBase::output_high_resolution(uint8_t *target, const uint8_t *const sou
 		// If there is a delay, the previous output level is held to bridge the gap.
 		// Delays may be ignored on a IIe if Annunciator 3 is set; that's the state that
 		// high_resolution_mask_ models.
-		if(source[c] & high_resolution_mask_ & 0x80) {
+		const uint8_t byte = source[c] & high_resolution_mask_;
+		memcpy(target, expansions.high_resolution[byte], 14);
+		if(byte & 0x80) {
 			target[0] = graphics_carry_;
-			target[1] = target[2] = source[c] & 0x01;
-			target[3] = target[4] = source[c] & 0x02;
-			target[5] = target[6] = source[c] & 0x04;
-			target[7] = target[8] = source[c] & 0x08;
-			target[9] = target[10] = source[c] & 0x10;
-			target[11] = target[12] = source[c] & 0x20;
-			target[13] = source[c] & 0x40;
-		} else {
-			target[0] = target[1] = source[c] & 0x01;
-			target[2] = target[3] = source[c] & 0x02;
-			target[4] = target[5] = source[c] & 0x04;
-			target[6] = target[7] = source[c] & 0x08;
-			target[8] = target[9] = source[c] & 0x10;
-			target[10] = target[11] = source[c] & 0x20;
-			target[12] = target[13] = source[c] & 0x40;
 		}
 		graphics_carry_ = source[c] & 0x40;
 		target += 14;
@@ -233,21 +259,8 @@ void VideoBase::output_high_resolution(uint8_t *target, const uint8_t *const sou
 
 void VideoBase::output_double_high_resolution(uint8_t *target, const uint8_t *const source, const uint8_t *const auxiliary_source, size_t length) const {
 	for(size_t c = 0; c < length; ++c) {
-		target[0] = auxiliary_source[c] & 0x01;
-		target[1] = auxiliary_source[c] & 0x02;
-		target[2] = auxiliary_source[c] & 0x04;
-		target[3] = auxiliary_source[c] & 0x08;
-		target[4] = auxiliary_source[c] & 0x10;
-		target[5] = auxiliary_source[c] & 0x20;
-		target[6] = auxiliary_source[c] & 0x40;
-		target[7] = source[c] & 0x01;
-		target[8] = source[c] & 0x02;
-		target[9] = source[c] & 0x04;
-		target[10] = source[c] & 0x08;
-		target[11] = source[c] & 0x10;
-		target[12] = source[c] & 0x20;
-		target[13] = source[c] & 0x40;
-
+		memcpy(&target[0], expansions.double_high_resolution[auxiliary_source[c] & 0x7f], 7);
+		memcpy(&target[7], expansions.double_high_resolution[source[c] & 0x7f], 7);
 		graphics_carry_ = auxiliary_source[c] & 0x40;
 		target += 14;
 	}
@@ -192,6 +192,7 @@ class ConcreteMachine:
 	public MachineTypes::JoystickMachine,
 	public MachineTypes::MappedKeyboardMachine,
 	public MachineTypes::MediaTarget,
+	public MachineTypes::MemoryReporter,
 	public MachineTypes::MouseMachine,
 	public MachineTypes::ScanProducer,
 	public MachineTypes::TimedMachine,
@@ -297,6 +298,7 @@ class ConcreteMachine:
 			ram_.resize(ram_size * 1024);
 
 			memory_.set_storage(ram_, rom_);
+			m65816_.set_mapped_pages(memory_.mapped_pages.data());
 			video_->set_internal_ram(&ram_[ram_.size() - 128*1024]);
 
 			// Attach drives to the IWM.
@@ -335,6 +337,24 @@ class ConcreteMachine:
 			audio_queue_.perform();
 		}
 
+		void report_memory(MachineTypes::MemoryFootprint &footprint) final {
+			using Kind = MachineTypes::MemoryFootprint::Kind;
+			flush();
+			audio_queue_.flush();
+
+			footprint.add("RAM", Kind::RAM, ram_.size());
+			footprint.add("ROM", Kind::ROM, rom_.size());
+			footprint.add("Memory map", Kind::Other, sizeof(memory_));
+			footprint.add("65816", Kind::ProcessorTables, m65816_.get_table_footprint());
+
+			// The Ensoniq's RAM is duplicated for the audio thread, and writes to it are buffered.
+			footprint.add("Ensoniq", Kind::AudioBuffers, sizeof(sound_glu_));
+			footprint.add("Speaker", Kind::AudioBuffers, speaker_.get_memory_footprint());
+			footprint.add("Drives", Kind::DiskTracks,
+				drives35_[0].get_disk_memory_footprint() + drives35_[1].get_disk_memory_footprint() +
+				drives525_[0].get_disk_memory_footprint() + drives525_[1].get_disk_memory_footprint());
+		}
+
 		void set_scan_target(Outputs::Display::ScanTarget *target) override {
 			video_->set_scan_target(target);
 		}
@@ -954,11 +974,17 @@ class ConcreteMachine:
 
 					// Use a very broad test for flushing video: any write to $e0 or $e1, or any write that is shadowed.
 					// TODO: at least restrict the e0/e1 test to possible video buffers!
-					if((address >= 0xe0'0400 && address < 0xe1'a000) || is_shadowed) {
+					const bool affects_video = (address >= 0xe0'0400 && address < 0xe1'a000) || is_shadowed;
+					if(affects_video) {
 						video_.flush();
 					}
 
 					MemoryMapWrite(memory_, region, address, value);
+
+					// Let the video know where in its RAM this write, or its shadow, landed.
+					if(affects_video && region.write) {
+						video_.last_valid()->did_write_internal_ram(uint32_t(&region.shadow[address] - memory_.shadow_base[1]));
+					}
 				}
 			}
 
@@ -1019,6 +1045,17 @@ class ConcreteMachine:
 			}
 
 
+			return advance_bus_cycle(is_1Mhz, bool(region.write));
+		}
+
+		/// Completes a bus cycle that the 65816 performed itself, using the memory map's mapped pages.
+		forceinline Cycles perform_direct_bus_operation(CPU::WDC65816::BusOperation, const uint32_t address) {
+			const auto &region = MemoryMapRegion(memory_, address);
+			return advance_bus_cycle(bool(region.flags & MemoryMap::Region::Is1Mhz), bool(region.write));
+		}
+
+		/// Determines the length of a bus cycle that is @c is_1Mhz and accesses RAM if @c is_ram, and runs everything else for that long.
+		forceinline Cycles advance_bus_cycle(bool is_1Mhz, bool is_ram) {
 			Cycles duration;
 
 			// In preparation for this test: the top bit of speed_register_ has been inverted,
@@ -1042,7 +1079,7 @@ class ConcreteMachine:
 				//
 				// (and the IIgs is smart enough that refresh is applicable only to RAM accesses).
 				const int phase_adjust = (5 - fast_access_phase_%5)%5;
-				const int refresh = (fast_access_phase_ / 45) * bool(region.write) * 5;
+				const int refresh = (fast_access_phase_ / 45) * is_ram * 5;
 				duration = Cycles(5 + phase_adjust + refresh);
 			}
 			// TODO: lookup tables to avoid the above? LCM of the two phases is 22,800 so probably 912+50 bytes plus two counters.
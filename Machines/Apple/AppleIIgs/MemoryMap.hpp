@@ -15,6 +15,7 @@
 
 #include "../AppleII/LanguageCardSwitches.hpp"
 #include "../AppleII/AuxiliaryMemorySwitches.hpp"
+#include "../../../Processors/65816/65816.hpp"
 
 namespace Apple {
 namespace IIgs {
@@ -178,8 +179,9 @@ class MemoryMap {
 
 			// TODO: set 1Mhz flags.
 
-			// Apply initial language/auxiliary state.
+			// Apply initial language/auxiliary state, and populate the page table.
 			set_all_paging();
+			refresh_pages(0x0000, 0x10000);
 		}
 
 		// MARK: - Live bus access notifications and register access.
@@ -203,11 +205,15 @@ class MemoryMap {
 		}
 
 		void set_speed_register(uint8_t value) {
+			const uint8_t diff = value ^ speed_register_;
 			speed_register_ = value;
 
 			// Enable or disable shadowing from banks 0x02–0x80.
-			for(size_t c = 0x01; c < 0x40; c++) {
-				shadow_banks[c] = speed_register_ & 0x10;
+			if(diff & 0x10) {
+				for(size_t c = 0x01; c < 0x40; c++) {
+					shadow_banks[c] = speed_register_ & 0x10;
+					refresh_shadowable_pages(c);
+				}
 			}
 		}
 
@@ -254,8 +260,9 @@ class MemoryMap {
 		// Cf. LanguageCardSwitches; this function should update the region from
 		// $D000 onwards as per the state of the language card flags — there may
 		// end up being ROM or RAM (or auxiliary RAM), and the first 4kb of it
-		// may be drawn from either of two pools.
-		void set_language_card_paging() {
+		// may be drawn from either of two pools. Only the page table entries for
+		// the regions flagged in @c changes are rebuilt.
+		void set_language_card_paging(int changes = LanguageCardSwitches::AllRegions) {
 			const auto language_state = language_card_.state();
 			const auto zero_state = auxiliary_switches_.zero_state();
 			const bool inhibit_banks0001 = shadow_register_ & 0x40;
@@ -306,6 +313,11 @@ class MemoryMap {
 			uint8_t *const e0_ram = regions[region_map[0xe000]].write;
 			apply(0xe000, e0_ram);
 			apply(0xe100, e0_ram);
+
+			for(uint32_t bank_base: {0x0000, 0x0100, 0xe000, 0xe100}) {
+				if(changes & LanguageCardSwitches::RegionD0_E0) refresh_pages(bank_base | 0xd0, bank_base | 0xe0);
+				if(changes & LanguageCardSwitches::RegionE0_100) refresh_pages(bank_base | 0xe0, bank_base + 0x100);
+			}
 		}
 
 		// Cf. AuxiliarySwitches; this should establish whether ROM or card switches
@@ -316,7 +328,9 @@ class MemoryMap {
 		//
 		// TODO: so... shouldn't the card mask be incorporated here? I've got it implemented
 		// distinctly at present, but does that create any invalid state interactions?
-		void set_card_paging() {
+		//
+		// Only the page table entries for the regions flagged in @c changes are rebuilt.
+		void set_card_paging(int changes = AuxiliaryMemorySwitches::CardAll) {
 			const bool inhibit_banks0001 = shadow_register_ & 0x40;
 			const auto state = auxiliary_switches_.card_state();
 
@@ -380,6 +394,13 @@ class MemoryMap {
 			// Obey the card state for banks $e0 and $e1.
 			apply(0xe000);
 			apply(0xe100);
+
+			for(uint32_t bank_base: {0x0000, 0x0100, 0xe000, 0xe100}) {
+				if(changes & AuxiliaryMemorySwitches::CardC1_C3) refresh_pages(bank_base | 0xc0, bank_base | 0xc3);
+				if(changes & AuxiliaryMemorySwitches::CardC3) refresh_pages(bank_base | 0xc3, bank_base | 0xc4);
+				if(changes & AuxiliaryMemorySwitches::CardC4_C8) refresh_pages(bank_base | 0xc4, bank_base | 0xc8);
+				if(changes & AuxiliaryMemorySwitches::CardC8_D0) refresh_pages(bank_base | 0xc8, bank_base | 0xd0);
+			}
 		}
 
 		// Cf. LanguageCardSwitches; this should update whether base or auxiliary RAM is
@@ -391,6 +412,7 @@ class MemoryMap {
 			region.read = region.write = auxiliary_switches_.zero_state() ? &ram_base[0x01'0000] : ram_base;
 			assert(region_map[0x0000] == region_map[0x0001]);
 			assert(region_map[0x0001]+1 == region_map[0x0002]);
+			refresh_pages(0x00, 0x02);
 
 			// Switching to or from auxiliary RAM potentially affects the
 			// language card area.
@@ -464,11 +486,16 @@ class MemoryMap {
 			for(size_t c = 0x6000 >> shadow_shift; c < 0xa000 >> shadow_shift; c++) {
 				shadow_pages[c+auxiliary_offset] = !(shadow_register_ & 0x08);
 			}
+
+			for(size_t c = 0; c < shadow_banks.size(); c++) {
+				if(shadow_banks[c]) refresh_shadowable_pages(c);
+			}
 		}
 
 		// Cf. the AuxiliarySwitches; establishes whether main or auxiliary RAM
-		// is exposed in bank $00 for a bunch of regions.
-		void set_main_paging() {
+		// is exposed in bank $00 for a bunch of regions. Only the page table entries
+		// for the regions flagged in @c changes are rebuilt.
+		void set_main_paging(int changes = AuxiliaryMemorySwitches::MainAll) {
 			const auto state = auxiliary_switches_.main_state();
 
 #define set(page, flags)	{\
@@ -499,10 +526,19 @@ class MemoryMap {
 
 #undef set
 
-			// This also affects shadowing flags, if shadowing is enabled at all,
-			// and might affect RAM in the IO area of bank $00 because the language
-			// card can be inhibited on a IIgs.
-			set_card_paging();
+			if(changes & AuxiliaryMemorySwitches::MainBase) {
+				refresh_pages(0x02, 0x04);
+				refresh_pages(0x08, 0x20);
+				refresh_pages(0x40, 0xc0);
+			}
+			if(changes & AuxiliaryMemorySwitches::Main04_08) refresh_pages(0x04, 0x08);
+			if(changes & AuxiliaryMemorySwitches::Main20_40) refresh_pages(0x20, 0x40);
+
+			// The base state also determines which RAM appears in the IO area of bank $00
+			// if the language card is inhibited, as it can be on a IIgs.
+			if((changes & AuxiliaryMemorySwitches::MainBase) && (shadow_register_ & 0x40)) {
+				set_card_paging();
+			}
 		}
 
 		void set_all_paging() {
@@ -512,6 +548,52 @@ class MemoryMap {
 			set_shadowing();
 		}
 
+		// MARK: - Page table.
+
+		/// Rebuilds the page table entries for pages [@c start, @c end) from the current regions and shadowing state.
+		void refresh_pages(uint32_t start, uint32_t end) {
+			for(uint32_t page = start; page < end; page++) {
+				const auto &region = regions[region_map[page]];
+				auto &target = pages[page];
+				target.read = region.read;
+				target.write = region.write;
+				target.flags = region.flags;
+
+				// The 65816 may read anything other than IO directly.
+				auto &mapped = mapped_pages[page];
+				mapped.read = (region.flags & Region::IsIO) ? nullptr : region.read;
+				mapped.write = nullptr;
+
+				if(!region.write) {
+					target.shadow = nullptr;
+					continue;
+				}
+
+				// Determine the shadow target once for the whole page; if there's no shadowing then
+				// the shadow pointer just duplicates the write pointer.
+				const uint32_t address = page << 8;
+				const auto physical = &region.write[address] - ram_base;
+				const bool is_shadowed = shadow_pages[(physical >> 10) & 127] & shadow_banks[address >> 17];
+				target.shadow = shadow_base[is_shadowed] + (physical & shadow_mask[is_shadowed]) - address;
+				if(is_shadowed) target.flags |= Region::IsShadowed;
+
+				// ... but may write directly only if that can't affect video; cf. AppleIIgs.cpp.
+				if(!(target.flags & (Region::IsIO | Region::IsShadowed)) && (page < 0xe004 || page >= 0xe1a0)) {
+					mapped.write = region.write;
+				}
+			}
+		}
+
+		/// Rebuilds the page table entries that may be affected by a change in shadowing within the 128kb
+		/// chunk @c chunk — i.e. those in the range $0400–$A000 of each of its two banks. All paging
+		/// preserves the low 16 bits of addresses below $C000, so that's also the full range of physical
+		/// addresses subject to shadowing.
+		void refresh_shadowable_pages(size_t chunk) {
+			const uint32_t bank_base = uint32_t(chunk << 9);
+			refresh_pages(bank_base | 0x04, bank_base | 0xa0);
+			refresh_pages((bank_base + 0x100) | 0x04, (bank_base + 0x100) | 0xa0);
+		}
+
 		void print_state() {
 			uint8_t region = region_map[0];
 			uint32_t start = 0;
@@ -532,12 +614,14 @@ class MemoryMap {
 #undef assert_is_region
 
 	public:
-		// Memory layout here is done via double indirection; the main loop should:
-		//	(i) use the top two bytes of the address to get an index from memory_map_; and
-		//	(ii) use that to index the memory_regions table.
+		// Paging is expressed via double indirection: the top two bytes of an address give an index
+		// into region_map, and that indexes the regions table. So paging changes need to modify only
+		// a few regions.
 		//
-		// Pointers are eight bytes at the time of writing, so the extra level of indirection
-		// reduces what would otherwise be a 1.25mb table down to not a great deal more than 64kb.
+		// For bus accesses that's flattened into the page table below, which directly
+		// gives the pointers and flags for each 256-byte page, including the precomputed
+		// destination of any shadowed writes; entries are refreshed whenever the regions
+		// or shadowing state that they're derived from change.
 		std::array<uint8_t, 65536> region_map{};
 		uint8_t *ram_base = nullptr;
 		uint8_t *shadow_base[2] = {nullptr, nullptr};
@@ -551,9 +635,18 @@ class MemoryMap {
 			enum Flag: uint8_t {
 				Is1Mhz = 1 << 0,		// Both reads and writes should be synchronised with the 1Mhz clock.
 				IsIO = 1 << 1,			// Indicates that this region should be checked for soft switches, registers, etc.
+				IsShadowed = 1 << 2,	// Set only in the page table; indicates that writes to this page are shadowed.
 			};
 		};
 
+		struct Page {
+			uint8_t *write = nullptr;
+			const uint8_t *read = nullptr;
+			uint8_t *shadow = nullptr;	// Non-null whenever write is; the destination of shadowed writes
+										// if this page is shadowed, otherwise identical to write.
+			uint8_t flags = 0;
+		};
+
 		// Shadow_pages: divides the final 128kb of memory into 1kb chunks and includes a flag to indicate whether
 		// each is a potential destination for shadowing.
 		//
@@ -564,32 +657,37 @@ class MemoryMap {
 		std::array<Region, 40> regions;	// An assert above ensures that this is large enough; there's no
 										// doctrinal reason for it to be whatever size it is now, just
 										// adjust as required.
+
+		std::array<Page, 65536> pages;
+
+		// A further flattening of the page table for the 65816, describing only memory that
+		// it can access without the machine's involvement; see refresh_pages.
+		std::array<CPU::WDC65816::MappedPage, 65536> mapped_pages;
 };
 
 // TODO: branching below on region.read/write is predicated on the idea that extra scratch space
 // would be less efficient. Verify that?
 
-#define MemoryMapRegion(map, address) 			map.regions[map.region_map[address >> 8]]
-#define IsShadowed(map, region, address)		(map.shadow_pages[((&region.write[address] - map.ram_base) >> 10) & 127] & map.shadow_banks[address >> 17])
+#define MemoryMapRegion(map, address) 			map.pages[address >> 8]
+#define IsShadowed(map, region, address)		bool(region.flags & Apple::IIgs::MemoryMap::Region::IsShadowed)
 #define MemoryMapRead(region, address, value)	*value = region.read ? region.read[address] : 0xff
 #define MemoryMapWrite(map, region, address, value) \
 	if(region.write) {	\
 		region.write[address] = *value;	\
-		const bool _mm_is_shadowed = IsShadowed(map, region, address);	\
-		map.shadow_base[_mm_is_shadowed][(&region.write[address] - map.ram_base) & map.shadow_mask[_mm_is_shadowed]] = *value;	\
+		region.shadow[address] = *value;	\
 	}
 
-// Quick notes on ::IsShadowed contortions:
+// Quick notes on shadowing:
 //
 // The objective is to support shadowing:
-//	1. without storing a whole extra pointer, and such that the shadowing flags are orthogonal to the current auxiliary memory settings;
+//	1. such that the shadowing flags are orthogonal to the current auxiliary memory settings;
 //	2. in such a way as to support shadowing both in banks $00/$01 and elsewhere; and
 //	3. to do so without introducing too much in the way of branching.
 //
 // Hence the implemented solution: if shadowing is enabled then use the distance from the start of physical RAM
-// modulo 128k indexed into the bank $e0/$e1 RAM.
-//
-// With a further twist: the modulo and pointer are indexed on ::IsShadowed to eliminate a branch even on that.
+// modulo 128k indexed into the bank $e0/$e1 RAM. That's evaluated per page whenever the page table is refreshed,
+// with unshadowed pages using their own write pointer as the shadow pointer so that every write can be
+// duplicated without a branch.
 
 }
 }
@@ -68,6 +68,7 @@ void GLU::EnsoniqState::set_register(uint16_t address, uint8_t value) {
 		break;
 		case 0x80:
 			oscillators[address & 0x1f].address = value;
+			oscillators[address & 0x1f].update_sample_addressing();
 		break;
 		case 0xa0: {
 			oscillators[address & 0x1f].control = value;
@@ -82,6 +83,7 @@ void GLU::EnsoniqState::set_register(uint16_t address, uint8_t value) {
 
 			// The most-significant bit that should be used is 16 + (value & 7).
 			oscillators[address & 0x1f].overflow_mask = ~(0xffffff >> (7 - (value & 7)));
+			oscillators[address & 0x1f].update_sample_addressing();
 		break;
 
 		default:
@@ -259,6 +261,7 @@ void GLU::skip_audio(EnsoniqState &state, size_t number_of_samples) {
 void GLU::generate_audio(size_t number_of_samples, std::int16_t *target) {
 	auto next_store = pending_stores_[pending_store_read_].load(std::memory_order::memory_order_acquire);
 	uint8_t next_amplitude = 255;
+	uint8_t *const ram = remote_.ram_;
 	for(size_t sample = 0; sample < number_of_samples; sample++) {
 
 		// TODO: there's a bit of a hack here where it is assumed that the input clock has been
@@ -269,35 +272,37 @@ void GLU::generate_audio(size_t number_of_samples, std::int16_t *target) {
 
 		// Apply phase updates to all enabled oscillators.
 		for(int c = 0; c < remote_.oscillator_count; c++) {
+			auto &oscillator = remote_.oscillators[c];
+
 			// Don't do anything for halted oscillators.
-			if(remote_.oscillators[c].control&1) continue;
+			if(oscillator.control&1) continue;
 
-			remote_.oscillators[c].position += remote_.oscillators[c].velocity;
+			oscillator.position += oscillator.velocity;
 
 			// Test for a new halting event.
-			switch(remote_.oscillators[c].control & 6) {
+			switch(oscillator.control & 6) {
 				case 0:	// Free-run mode; don't truncate the position at all, in case the
 						// accumulator bits in use changes.
-					output += remote_.oscillators[c].output(remote_.ram_);
+					output += oscillator.output(ram);
 				break;
 
 				case 2:	// One-shot mode; check for end of run. Otherwise update sample.
-					if(remote_.oscillators[c].position & remote_.oscillators[c].overflow_mask) {
-						remote_.oscillators[c].position = 0;
-						remote_.oscillators[c].control |= 1;
+					if(oscillator.position & oscillator.overflow_mask) {
+						oscillator.position = 0;
+						oscillator.control |= 1;
 					}
 				break;
 
 				case 4:	// Sync/AM mode.
 					if(c&1) {
 						// Oscillator is odd-numbered; it will amplitude-modulate the next voice.
-						next_amplitude = remote_.oscillators[c].sample(remote_.ram_);
+						next_amplitude = oscillator.sample(ram);
 						continue;
 					} else {
 						// Oscillator is even-numbered; it will 'sync' to the even voice, i.e. any
 						// time it wraps around, it will reset the next oscillator.
-						if(remote_.oscillators[c].position & remote_.oscillators[c].overflow_mask) {
-							remote_.oscillators[c].position &= remote_.oscillators[c].overflow_mask;
+						if(oscillator.position & oscillator.overflow_mask) {
+							oscillator.position &= oscillator.overflow_mask;
 							remote_.oscillators[c+1].position = 0;
 						}
 					}
@@ -307,19 +312,19 @@ void GLU::generate_audio(size_t number_of_samples, std::int16_t *target) {
 						// Per tech note #11: "Whenever a swap occurs from a higher-numbered
 						// oscillator to a lower-numbered one, the output signal from the corresponding
 						// generator temporarily falls to the zero-crossing level (silence)"
-					if(remote_.oscillators[c].position & remote_.oscillators[c].overflow_mask) {
-						remote_.oscillators[c].control |= 1;
-						remote_.oscillators[c].position = 0;
+					if(oscillator.position & oscillator.overflow_mask) {
+						oscillator.control |= 1;
+						oscillator.position = 0;
 						remote_.oscillators[c^1].control &= ~1;
 					}
 				break;
 			}
 
 			// Don't add output for newly-halted oscillators.
-			if(remote_.oscillators[c].control&1) continue;
+			if(oscillator.control&1) continue;
 
 			// Append new output.
-			output += (remote_.oscillators[c].output(remote_.ram_) * next_amplitude) / 255;
+			output += (oscillator.output(ram) * next_amplitude) / 255;
 			next_amplitude = 255;
 		}
 
@@ -338,26 +343,28 @@ void GLU::generate_audio(size_t number_of_samples, std::int16_t *target) {
 	}
 }
 
-uint8_t GLU::EnsoniqState::Oscillator::sample(uint8_t *ram) {
+void GLU::EnsoniqState::Oscillator::update_sample_addressing() {
 	// Determines how many you'd have to shift a 16-bit pointer to the right for,
 	// in order to hit only the position-supplied bits.
 	const int pointer_shift = 8 - ((table_size >> 3) & 7);
 
 	// Table size mask should be 0x8000 for the largest table size, and 0xff00 for
 	// the smallest.
-	const uint16_t table_size_mask = 0xffff >> pointer_shift;
+	table_size_mask = 0xffff >> pointer_shift;
 
 	// The pointer should use (at most) 15 bits; starting with bit 1 for resolution 0
 	// and starting at bit 8 for resolution 7.
-	const uint16_t table_pointer = uint16_t(position >> ((table_size&7) + pointer_shift));
+	position_shift = (table_size&7) + pointer_shift;
 
 	// The full pointer is composed of the bits of the programmed address not touched by
 	// the table pointer, plus the table pointer.
-	const uint16_t sample_address = ((address << 8) & ~table_size_mask) | (table_pointer & table_size_mask);
+	address_bits = uint16_t((address << 8) & ~table_size_mask);
+}
 
+uint8_t GLU::EnsoniqState::Oscillator::sample(uint8_t *ram) {
 	// Ignored here: bit 6 should select between RAM banks. But for now this is IIgs-centric,
 	// and that has only one bank of RAM.
-	return ram[sample_address];
+	return ram[address_bits | (uint16_t(position >> position_shift) & table_size_mask)];
 }
 
 int16_t GLU::EnsoniqState::Oscillator::output(uint8_t *ram) {
@@ -84,6 +84,13 @@ class GLU: public Outputs::Speaker::SampleSource {
 				bool interrupt_request = false;	// Will be non-zero if this channel would request an interrupt, were
 												// it currently enabled to do so.
 
+				// Sample addressing, a function of table_size and address; a sample address is
+				// address_bits | ((position >> position_shift) & table_size_mask).
+				int position_shift = 8;
+				uint16_t table_size_mask = 0xff;
+				uint16_t address_bits = 0;
+				void update_sample_addressing();
+
 				uint8_t sample(uint8_t *ram);
 				int16_t output(uint8_t *ram);
 			} oscillators[32];
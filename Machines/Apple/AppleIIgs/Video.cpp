@@ -8,6 +8,8 @@
 
 #include "Video.hpp"
 
+#include <algorithm>
+
 using namespace Apple::IIgs::Video;
 
 namespace {
@@ -151,6 +153,7 @@ Outputs::Display::DisplayType Video::get_display_type() const {
 
 void Video::set_internal_ram(const uint8_t *ram) {
 	ram_ = ram;
+	dirty_lines_.set();
 }
 
 void Video::advance(Cycles cycles) {
@@ -296,6 +299,29 @@ void Video::output_row(int row, int start, int end) {
 				// Reset NTSC decoding and total line buffering.
 				ntsc_delay_ = 4;
 				pixels_start_column_ = start;
+
+				// Determine whether this line can be reproduced from the most recent output of it;
+				// if not then capture it for next time. Fill mode carries state from byte to byte
+				// via the palette so is always converted afresh.
+				line_cache_ = LineCache::None;
+				if(mode == GraphicsMode::SuperHighRes && !(line_control_ & 0x20)) {
+					auto &line = super_high_res_lines_[size_t(row)];
+					const uint32_t palette_generation = palette_generations_[line_control_ & 15];
+
+					if(
+						line.is_complete && !dirty_lines_[size_t(row)] &&
+						line.line_control == line_control_ && line.palette_generation == palette_generation
+					) {
+						line_cache_ = LineCache::Replay;
+					} else {
+						line_cache_ = LineCache::Record;
+						dirty_lines_[size_t(row)] = false;
+						line.line_control = line_control_;
+						line.palette_generation = palette_generation;
+						line.is_complete = false;
+						recorded_bytes_ = 0;
+					}
+				}
 			}
 
 			if(!next_pixel_ || pixels_format_ != format_for_mode(mode)) {
@@ -600,8 +626,23 @@ uint16_t *Video::output_double_text(uint16_t *target, int start, int end, int ro
 	return target;
 }
 
-uint16_t *Video::output_super_high_res(uint16_t *target, int start, int end, int row) const {
+uint16_t *Video::output_super_high_res(uint16_t *target, int start, int end, int row) {
 	const int row_address = row * 160 + 0x12000;
+	const int pixels_per_byte = (line_control_ & 0x80) ? 4 : 2;
+	auto &line = super_high_res_lines_[size_t(row)];
+
+	// Any write to this line's pixels since it began invalidates whatever is cached;
+	// conversion is otherwise a simple function of the pixels, palette and control byte.
+	if(line_cache_ != LineCache::None && dirty_lines_[size_t(row)]) {
+		line_cache_ = LineCache::None;
+	}
+
+	if(line_cache_ == LineCache::Replay) {
+		const size_t length = size_t((end - start) * 4 * pixels_per_byte);
+		std::copy(&line.pixels[start * 4 * pixels_per_byte], &line.pixels[start * 4 * pixels_per_byte] + length, target);
+		return target + length;
+	}
+	uint16_t *const first_pixel = target;
 
 	// The palette_zero_ writes ensure that palette colour 0 is replaced by whatever was last output,
 	// if fill mode is enabled. Otherwise they go to throwaway storage.
@@ -623,6 +664,17 @@ uint16_t *Video::output_super_high_res(uint16_t *target, int start, int end, int
 		}
 	}
 
+	// Capture this output for next time if it continues contiguously from the start of the line.
+	if(line_cache_ == LineCache::Record) {
+		if(recorded_bytes_ == start * 4) {
+			std::copy(first_pixel, target, &line.pixels[start * 4 * pixels_per_byte]);
+			recorded_bytes_ = end * 4;
+			line.is_complete = recorded_bytes_ == 160;
+		} else {
+			line_cache_ = LineCache::None;
+		}
+	}
+
 	return target;
 }
 
@@ -13,6 +13,10 @@
 #include "../../../Outputs/CRT/CRT.hpp"
 #include "../../../ClockReceiver/ClockReceiver.hpp"
 
+#include <array>
+#include <bitset>
+#include <cstdint>
+
 namespace Apple {
 namespace IIgs {
 namespace Video {
@@ -27,6 +31,24 @@ class Video: public Apple::II::VideoSwitches<Cycles> {
 		Video();
 		void set_internal_ram(const uint8_t *);
 
+		/*!
+			Indicates that the byte at @c offset within the internal RAM supplied via @c set_internal_ram
+			has just been written to; this is used to determine which super high-res lines can be output
+			again as they were last time, without reconversion.
+		*/
+		void did_write_internal_ram(uint32_t offset) {
+			if(offset < 0x1'2000 || offset >= 0x1'a000) return;
+
+			// Pixels, then the control bytes, then the palettes.
+			if(offset < 0x1'9d00) {
+				dirty_lines_[(offset - 0x1'2000) / 160] = true;
+			} else if(offset < 0x1'9e00) {
+				if(offset - 0x1'9d00 < 200) dirty_lines_[offset - 0x1'9d00] = true;
+			} else {
+				++palette_generations_[(offset - 0x1'9e00) >> 5];
+			}
+		}
+
 		bool get_is_vertical_blank(Cycles offset);
 		uint8_t get_horizontal_counter(Cycles offset);
 		uint8_t get_vertical_counter(Cycles offset);
@@ -145,7 +167,7 @@ class Video: public Apple::II::VideoSwitches<Cycles> {
 
 		void output_row(int row, int start, int end);
 
-		uint16_t *output_super_high_res(uint16_t *target, int start, int end, int row) const;
+		uint16_t *output_super_high_res(uint16_t *target, int start, int end, int row);
 
 		uint16_t *output_text(uint16_t *target, int start, int end, int row) const;
 		uint16_t *output_double_text(uint16_t *target, int start, int end, int row) const;
@@ -166,6 +188,25 @@ class Video: public Apple::II::VideoSwitches<Cycles> {
 		// Storage used for fill mode.
 		uint16_t *palette_zero_[4] = {nullptr, nullptr, nullptr, nullptr}, palette_throwaway_;
 
+		// Super high-res lines as most recently output, and the state necessary to determine whether
+		// each is still current: a line can be reused if it was completely output, if none of its pixels
+		// or its control byte has been written to since, and if its palette hasn't been modified.
+		struct SuperHighResLine {
+			uint16_t pixels[640];
+			uint8_t line_control = 0;
+			uint32_t palette_generation = 0;
+			bool is_complete = false;
+		};
+		std::array<SuperHighResLine, 200> super_high_res_lines_;
+		std::bitset<200> dirty_lines_;
+		std::array<uint32_t, 16> palette_generations_{};
+
+		// Whether the current line is being output from, or captured into, super_high_res_lines_.
+		enum class LineCache {
+			None, Record, Replay
+		} line_cache_ = LineCache::None;
+		int recorded_bytes_ = 0;
+
 		// Lookup tables and state to assist in the IIgs' mapping from NTSC to RGB.
 		//
 		// My understanding of the real-life algorithm is: maintain a four-bit buffer.
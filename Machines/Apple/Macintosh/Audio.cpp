@@ -8,6 +8,8 @@
 
 #include "Audio.hpp"
 
+#include <algorithm>
+
 using namespace Apple::Macintosh;
 
 namespace {
@@ -26,7 +28,7 @@ void Audio::post_sample(uint8_t sample) {
 	// Store sample directly indexed by current write pointer; this ensures that collected samples
 	// directly map to volume and enabled/disabled states.
 	sample_queue_.buffer[sample_queue_.write_pointer].store(sample, std::memory_order::memory_order_relaxed);
-	sample_queue_.write_pointer = (sample_queue_.write_pointer + 1) % sample_queue_.buffer.size();
+	if(++sample_queue_.write_pointer == sample_queue_.buffer.size()) sample_queue_.write_pointer = 0;
 }
 
 void Audio::set_volume(int volume) {
@@ -79,17 +81,16 @@ void Audio::get_samples(std::size_t number_of_samples, int16_t *target) {
 		const auto cycles_left_in_sample = std::min(number_of_samples, sample_length - subcycle_offset_);
 
 		// Determine the output level, and output that many samples.
-		// (Hoping that the copiler substitutes an effective memset16-type operation here).
 		const int16_t output_level = volume_multiplier_ * (int16_t(sample_queue_.buffer[sample_queue_.read_pointer].load(std::memory_order::memory_order_relaxed)) - 128);
-		for(size_t c = 0; c < cycles_left_in_sample; ++c) {
-			target[c] = output_level;
-		}
+		std::fill(target, target + cycles_left_in_sample, output_level);
 		target += cycles_left_in_sample;
 
 		// Advance the sample pointer.
 		subcycle_offset_ += cycles_left_in_sample;
-		sample_queue_.read_pointer = (sample_queue_.read_pointer + (subcycle_offset_ / sample_length)) % sample_queue_.buffer.size();
-		subcycle_offset_ %= sample_length;
+		if(subcycle_offset_ == sample_length) {
+			subcycle_offset_ = 0;
+			if(++sample_queue_.read_pointer == sample_queue_.buffer.size()) sample_queue_.read_pointer = 0;
+		}
 
 		// Decreate the number of samples left to write.
 		number_of_samples -= cycles_left_in_sample;
@@ -40,40 +40,50 @@ constexpr uint8_t pwm_lookup[] = {
 
 using namespace Apple::Macintosh;
 
-void DriveSpeedAccumulator::post_sample(uint8_t sample) {
+void DriveSpeedAccumulator::set_buffer(const uint16_t *buffer) {
+	buffer_ = buffer;
+
+	total_ = 0;
+	for(size_t c = 0; c < buffer_length; c++) {
+		widths_[c] = pwm_lookup[buffer_[c] & 0x3f];
+		total_ += widths_[c];
+	}
+	post_speed();
+}
+
+void DriveSpeedAccumulator::did_change_sample(size_t index) {
+	// Note the table lookup here; see text above. Most writes to the buffer will be
+	// of audio only, which doesn't affect drive speed.
+	const uint8_t width = pwm_lookup[buffer_[index] & 0x3f];
+	if(width == widths_[index]) return;
+
+	total_ += int(width) - int(widths_[index]);
+	widths_[index] = width;
+	post_speed();
+}
+
+void DriveSpeedAccumulator::post_speed() {
 	if(!delegate_) return;
 
-	// An Euler-esque approximation is used here: just collect all
-	// the samples until there is a certain small quantity of them,
-	// then produce a new estimate of rotation speed and start the
-	// buffer afresh.
+	// The below fits for a function like `a + bc`; it encapsultes the following
+	// beliefs:
 	//
-	// Note the table lookup here; see text above.
-	sample_total_ += pwm_lookup[sample & 0x3f];
-	++sample_count_;
-
-	if(sample_count_ == samples_per_bucket) {
-		// The below fits for a function like `a + bc`; it encapsultes the following
-		// beliefs:
-		//
-		//	(i) motor speed is proportional to voltage supplied;
-		//	(ii) with pulse-width modulation it's therefore proportional to the duty cycle;
-		//	(iii) the Mac pulse-width modulates whatever it reads from the disk speed buffer, as per the LFSR rules above;
-		//	(iv) ... subject to software pulse-width modulation of that pulse-width modulation.
-		//
-		// So, I believe current motor speed is proportional to a low-pass filtering of
-		// the speed buffer. Which I've implemented very coarsely via 'large' bucketed-averages,
-		// noting also that exact disk motor speed is always a little approximate.
-
-		// The formula below was derived from observing values the Mac wrote into its
-		// disk-speed buffer. Given that it runs a calibration loop before doing so,
-		// I cannot guarantee the accuracy of these numbers beyond being within the
-		// range that the computer would accept.
-		const float normalised_sum = float(sample_total_) / float(samples_per_bucket);
-		const float rotation_speed = (normalised_sum - 3.7f) * 17.6f;
-
-		delegate_->drive_speed_accumulator_set_drive_speed(this, rotation_speed);
-		sample_count_ = 0;
-		sample_total_ = 0;
-	}
+	//	(i) motor speed is proportional to voltage supplied;
+	//	(ii) with pulse-width modulation it's therefore proportional to the duty cycle;
+	//	(iii) the Mac pulse-width modulates whatever it reads from the disk speed buffer, as per the LFSR rules above;
+	//	(iv) ... subject to software pulse-width modulation of that pulse-width modulation.
+	//
+	// So, I believe current motor speed is proportional to a low-pass filtering of
+	// the speed buffer. Which I've implemented as the average of the entire buffer,
+	// as is fetched once per frame, noting also that exact disk motor speed is always
+	// a little approximate.
+
+	// The formula below was derived from observing values the Mac wrote into its
+	// disk-speed buffer. Given that it runs a calibration loop before doing so,
+	// I cannot guarantee the accuracy of these numbers beyond being within the
+	// range that the computer would accept.
+	const float normalised_sum = float(total_) / float(buffer_length);
+	const float rotation_speed = (normalised_sum - 3.7f) * 17.6f;
+
+	delegate_->drive_speed_accumulator_set_drive_speed(this, rotation_speed);
 }
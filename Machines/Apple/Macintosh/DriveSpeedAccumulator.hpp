@@ -18,10 +18,20 @@ namespace Macintosh {
 
 class DriveSpeedAccumulator {
 	public:
+		/// The number of words in the sound and disk-speed buffer.
+		static constexpr size_t buffer_length = 370;
+
 		/*!
-			Accepts fetched motor control values.
+			Sets the buffer of @c buffer_length words from which motor control values are taken,
+			one from the low byte of each word, and recalculates drive speed.
 		*/
-		void post_sample(uint8_t sample);
+		void set_buffer(const uint16_t *buffer);
+
+		/*!
+			Indicates that the word at @c index within the current buffer may have been modified;
+			drive speed is recalculated only if this affects it.
+		*/
+		void did_change_sample(size_t index);
 
 		struct Delegate {
 			virtual void drive_speed_accumulator_set_drive_speed(DriveSpeedAccumulator *, float speed) = 0;
@@ -34,10 +44,12 @@ class DriveSpeedAccumulator {
 		}
 
 	private:
-		static constexpr int samples_per_bucket = 20;
-		int sample_count_ = 0;
-		int sample_total_ = 0;
+		const uint16_t *buffer_ = nullptr;
+		std::array<uint8_t, buffer_length> widths_{};
+		int total_ = 0;
 		Delegate *delegate_ = nullptr;
+
+		void post_speed();
 };
 
 }
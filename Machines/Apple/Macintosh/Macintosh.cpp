@@ -42,6 +42,7 @@
 
 #include "../../../Analyser/Static/Macintosh/Target.hpp"
 
+#include "../../../Memory/Arena.hpp"
 #include "../../Utility/MemoryPacker.hpp"
 #include "../../Utility/MemoryFuzzer.hpp"
 
@@ -71,6 +72,7 @@ template <Analyser::Static::Macintosh::Target::Model model> class ConcreteMachin
 	public MachineTypes::MediaTarget,
 	public MachineTypes::MouseMachine,
 	public MachineTypes::MappedKeyboardMachine,
+	public MachineTypes::MemoryReporter,
 	public CPU::MC68000::BusHandler,
 	public Zilog::SCC::z8530::Delegate,
 	public Activity::Source,
@@ -88,7 +90,7 @@ template <Analyser::Static::Macintosh::Target::Model model> class ConcreteMachin
 			}),
 		 	mc68000_(*this),
 		 	iwm_(CLOCK_RATE),
-		 	video_(audio_, drive_speed_accumulator_),
+		 	video_(audio_),
 		 	via_(via_port_handler_),
 		 	via_port_handler_(*this, clock_, keyboard_, audio_, iwm_, mouse_),
 		 	scsi_bus_(CLOCK_RATE * 2),
@@ -98,7 +100,9 @@ template <Analyser::Static::Macintosh::Target::Model model> class ConcreteMachin
 		 		{CLOCK_RATE, model >= Analyser::Static::Macintosh::Target::Model::Mac512ke},
 		 		{CLOCK_RATE, model >= Analyser::Static::Macintosh::Target::Model::Mac512ke}
 			},
-			mouse_(1) {
+			mouse_(1),
+			rom_(arena_),
+			ram_(arena_) {
 
 			// Select a ROM name and determine the proper ROM and RAM sizes
 			// based on the machine model.
@@ -136,7 +140,8 @@ template <Analyser::Static::Macintosh::Target::Model model> class ConcreteMachin
 			if(!request.validate(roms)) {
 				throw ROMMachine::Error::MissingROMs;
 			}
-			Memory::PackBigEndian16(roms.find(rom_name)->second, rom_);
+			rom_.resize(128*1024);
+			Memory::PackBigEndian16(roms.find(rom_name)->second, rom_.data());
 
 			// Randomise memory contents.
 			Memory::Fuzz(ram_);
@@ -149,6 +154,7 @@ template <Analyser::Static::Macintosh::Target::Model model> class ConcreteMachin
 			if(!drives_[0].is_800k() || !drives_[1].is_800k()) {
 				drive_speed_accumulator_.set_delegate(this);
 			}
+			set_drive_speed_buffer(false);
 
 			// Make sure interrupt changes from the SCC are observed.
 			scc_.set_delegate(this);
@@ -360,7 +366,7 @@ template <Analyser::Static::Macintosh::Target::Model model> class ConcreteMachin
 
 				case BusDevice::ROM: {
 					if(!(cycle.operation & Microcycle::Read)) return delay;
-					memory_base = rom_;
+					memory_base = rom_.data();
 					address &= rom_mask_;
 				} break;
 			}
@@ -378,9 +384,11 @@ template <Analyser::Static::Macintosh::Target::Model model> class ConcreteMachin
 				break;
 				case Microcycle::SelectWord:
 					*reinterpret_cast<uint16_t *>(&memory_base[address]) = cycle.value->full;
+					did_write_ram(address);
 				break;
 				case Microcycle::SelectByte:
 					memory_base[address] = cycle.value->halves.low;
+					did_write_ram(address);
 				break;
 			}
 
@@ -403,6 +411,19 @@ template <Analyser::Static::Macintosh::Target::Model model> class ConcreteMachin
 			iwm_.flush();
 		}
 
+		void report_memory(MachineTypes::MemoryFootprint &footprint) final {
+			using Kind = MachineTypes::MemoryFootprint::Kind;
+			flush();
+			audio_.queue.flush();
+
+			footprint.add("RAM", Kind::RAM, ram_.size());
+			footprint.add("ROM", Kind::ROM, rom_.size());
+			footprint.add("68000", Kind::ProcessorTables, mc68000_.get_table_footprint());
+			footprint.add("Speaker", Kind::AudioBuffers, audio_.speaker.get_memory_footprint());
+			footprint.add("Floppy drives", Kind::DiskTracks,
+				drives_[0].get_disk_memory_footprint() + drives_[1].get_disk_memory_footprint());
+		}
+
 		void set_rom_is_overlay(bool rom_is_overlay) {
 			ROM_is_overlay_ = rom_is_overlay;
 
@@ -456,6 +477,7 @@ template <Analyser::Static::Macintosh::Target::Model model> class ConcreteMachin
 		void set_use_alternate_buffers(bool use_alternate_screen_buffer, bool use_alternate_audio_buffer) {
 			update_video();
 			video_.set_use_alternate_buffers(use_alternate_screen_buffer, use_alternate_audio_buffer);
+			set_drive_speed_buffer(use_alternate_audio_buffer);
 		}
 
 		bool insert_media(const Analyser::Static::Media &media) final {
@@ -562,6 +584,24 @@ template <Analyser::Static::Macintosh::Target::Model model> class ConcreteMachin
 			drives_[1].set_rotation_speed(speed);
 		}
 
+		// Drive speed is derived from the low bytes of the sound buffer, so is recalculated
+		// only when that buffer is switched or written to.
+		void set_drive_speed_buffer(bool use_alternate_audio_buffer) {
+			const uint32_t address = (use_alternate_audio_buffer ? 0xffff'a100 : 0xffff'fd00) & ram_mask_;
+			if(address == drive_speed_buffer_address_) return;
+
+			drive_speed_buffer_address_ = address;
+			drive_speed_accumulator_.set_buffer(reinterpret_cast<uint16_t *>(&ram_[address]));
+		}
+
+		/// Informs the drive-speed accumulator of any write to RAM at byte address @c address that touches its buffer.
+		forceinline void did_write_ram(uint32_t address) {
+			const uint32_t offset = address - drive_speed_buffer_address_;
+			if(offset < DriveSpeedAccumulator::buffer_length * 2) {
+				drive_speed_accumulator_.did_change_sample(offset >> 1);
+			}
+		}
+
 		forceinline void adjust_phase() {
 			++phase_;
 		}
@@ -818,10 +858,8 @@ template <Analyser::Static::Macintosh::Target::Model model> class ConcreteMachin
 		BusDevice memory_map_[128];
 
 		void setup_memory_map() {
-			// Apply the power-up memory map, i.e. assume that ROM_is_overlay_ = true;
-			// start by calling into set_rom_is_overlay to seed everything up to $800000.
-			set_rom_is_overlay(true);
-
+			// Apply the power-up memory map, i.e. assume that ROM_is_overlay_ = true.
+			// Everything from $800000 is fixed, so seed that first.
 			populate_memory_map(0x800000, [] (std::function<void(int target, BusDevice device)> map_to) {
 				map_to(0x900000, BusDevice::Unassigned);
 				map_to(0xa00000, BusDevice::SCCReadResetPhase);
@@ -834,6 +872,9 @@ template <Analyser::Static::Macintosh::Target::Model model> class ConcreteMachin
 				map_to(0xf80000, BusDevice::PhaseRead);
 				map_to(0x1000000, BusDevice::Unassigned);
 			});
+
+			// Then call into set_rom_is_overlay to seed everything up to $800000.
+			set_rom_is_overlay(true);
 		}
 
 		void populate_memory_map(int start_address, std::function<void(std::function<void(int, BusDevice)>)> populator) {
@@ -847,12 +888,22 @@ template <Analyser::Static::Macintosh::Target::Model model> class ConcreteMachin
 			};
 
 			populator(map_to);
+
+			// ROM is free of contention and side effects, so the 68000 can read it directly.
+			// RAM is subject to video contention, so continues to go via perform_bus_operation.
+			// Only the segments just populated are inspected.
+			for(int page = start_address >> 16; page < segment << 1; ++page) {
+				const bool is_rom = memory_map_[page >> 1] == BusDevice::ROM;
+				mc68000_.set_fast_memory(page, is_rom ? &rom_[(page << 16) & rom_mask_] : nullptr, nullptr);
+			}
 		}
 
 		uint32_t ram_mask_ = 0;
 		uint32_t rom_mask_ = 0;
-		uint8_t rom_[128*1024];
-		std::vector<uint8_t> ram_;
+		uint32_t drive_speed_buffer_address_ = 0;
+		Memory::Arena arena_{Memory::Arena::Backing::HugePages};
+		Memory::ArenaVector<uint8_t> rom_;
+		Memory::ArenaVector<uint8_t> ram_;
 };
 
 }
@@ -23,10 +23,9 @@ using namespace Apple::Macintosh;
 //	"The visible portion of a full-screen display consists of 342 horizontal scan lines...
 //	During the vertical blanking interval, the turned-off beam ... traces out an additional 28 scan lines,"
 //
-Video::Video(DeferredAudio &audio, DriveSpeedAccumulator &drive_speed_accumulator) :
+Video::Video(DeferredAudio &audio) :
 	audio_(audio),
-	drive_speed_accumulator_(drive_speed_accumulator),
- 	crt_(704, 1, 370, 6, Outputs::Display::InputDataType::Luminance1) {
+ 	crt_(704, 1, 370, 6, Outputs::Display::InputDataType::Luminance1Packed) {
 
  	crt_.set_display_type(Outputs::Display::DisplayType::RGB);
 
@@ -86,41 +85,28 @@ void Video::run_for(HalfCycles duration) {
 					const int final_pixel_word = std::min(final_word, 32);
 
 					if(!first_word) {
-						pixel_buffer_ = crt_.begin_data(512);
+						pixel_buffer_ = crt_.begin_data(64);
 					}
 
 					if(pixel_buffer_) {
-						for(int c = first_word; c < final_pixel_word; ++c) {
-							uint16_t pixels = ram_[video_base + video_address_] ^ 0xffff;
-							++video_address_;
-
-							pixel_buffer_[15] = pixels & 0x01;
-							pixel_buffer_[14] = pixels & 0x02;
-							pixel_buffer_[13] = pixels & 0x04;
-							pixel_buffer_[12] = pixels & 0x08;
-							pixel_buffer_[11] = pixels & 0x10;
-							pixel_buffer_[10] = pixels & 0x20;
-							pixel_buffer_[9] = pixels & 0x40;
-							pixel_buffer_[8] = pixels & 0x80;
-
-							pixels >>= 8;
-							pixel_buffer_[7] = pixels & 0x01;
-							pixel_buffer_[6] = pixels & 0x02;
-							pixel_buffer_[5] = pixels & 0x04;
-							pixel_buffer_[4] = pixels & 0x08;
-							pixel_buffer_[3] = pixels & 0x10;
-							pixel_buffer_[2] = pixels & 0x20;
-							pixel_buffer_[1] = pixels & 0x40;
-							pixel_buffer_[0] = pixels & 0x80;
-
-							pixel_buffer_ += 16;
+						// Video memory is read only as output is required, so a span will usually cover
+						// the whole of a line; the relevant words are contiguous in RAM. Pixels are output
+						// packed, most significant first, as they are in memory, but with set bits as black.
+						const uint16_t *const words = &ram_[video_base + video_address_];
+						const int count = final_pixel_word - first_word;
+						for(int c = 0; c < count; ++c) {
+							const uint16_t pixels = uint16_t(~words[c]);
+							pixel_buffer_[0] = uint8_t(pixels >> 8);
+							pixel_buffer_[1] = uint8_t(pixels);
+							pixel_buffer_ += 2;
 						}
+						video_address_ += size_t(count);
 					} else {
 						video_address_ += size_t(final_pixel_word - first_word);
 					}
 
 					if(final_pixel_word == 32) {
-						crt_.output_data(512);
+						crt_.output_data(512, 64);
 						pixel_buffer_ = nullptr;
 					}
 				}
@@ -142,12 +128,12 @@ void Video::run_for(HalfCycles duration) {
 				}
 			}
 
-			// Audio and disk fetches occur "just before video data".
+			// Audio fetches occur "just before video data". Disk-speed values share
+			// the same words, but are observed as they are written; see the DriveSpeedAccumulator.
 			if(final_word == 44) {
 				const uint16_t audio_word = ram_[audio_address_ + audio_base];
 				++audio_address_;
 				audio_.audio.post_sample(audio_word >> 8);
-				drive_speed_accumulator_.post_sample(audio_word & 0xff);
 			}
 		}
 
@@ -12,7 +12,6 @@
 #include "../../../Outputs/CRT/CRT.hpp"
 #include "../../../ClockReceiver/ClockReceiver.hpp"
 #include "DeferredAudio.hpp"
-#include "DriveSpeedAccumulator.hpp"
 
 namespace Apple {
 namespace Macintosh {
@@ -27,15 +26,15 @@ constexpr int sync_end = 38;
 	Models the 68000-era Macintosh video hardware, producing a 512x348 pixel image,
 	within a total scanning area of 370 lines, at 352 cycles per line.
 
-	This class also collects audio and 400kb drive-speed data, forwarding those values.
+	This class also collects audio data, forwarding those values.
 */
 class Video {
 	public:
 		/*!
 			Constructs an instance of @c Video sourcing its pixel data from @c ram and
-			providing audio and drive-speed bytes to @c audio and @c drive_speed_accumulator.
+			providing audio bytes to @c audio.
 		*/
-		Video(DeferredAudio &audio, DriveSpeedAccumulator &drive_speed_accumulator);
+		Video(DeferredAudio &audio);
 
 		/*!
 			Sets the target device for video data.
@@ -85,7 +84,6 @@ class Video {
 
 	private:
 		DeferredAudio &audio_;
-		DriveSpeedAccumulator &drive_speed_accumulator_;
 
 		Outputs::CRT::CRT crt_;
 		uint16_t *ram_ = nullptr;
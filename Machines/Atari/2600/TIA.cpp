@@ -529,8 +529,12 @@ void TIA::output_pixels(int start, int end) {
 void TIA::output_line() {
 	switch(output_mode_) {
 		default:
-			// TODO: optimise special case
-			output_for_cycles(cycles_per_line);
+			// Lines on which only the playfield can be visible are output directly; output_for_cycles handles all others.
+			if(!(output_mode_ & blank_flag) && objects_are_invisible()) {
+				output_playfield_line();
+			} else {
+				output_for_cycles(cycles_per_line);
+			}
 		break;
 		case sync_flag:
 		case sync_flag | blank_flag:
@@ -549,6 +553,71 @@ void TIA::output_line() {
 	}
 }
 
+bool TIA::objects_are_invisible() const {
+	// No register can change during a whole line, so if every object is currently
+	// disabled or blank then nothing but the playfield can reach the collision buffer.
+	return
+		!player_[0].graphic[player_[0].graphic_index] &&
+		!player_[1].graphic[player_[1].graphic_index] &&
+		(!missile_[0].enabled || missile_[0].locked_to_player) &&
+		(!missile_[1].enabled || missile_[1].locked_to_player) &&
+		!ball_.enabled[ball_.enabled_index];
+}
+
+void TIA::output_playfield_line() {
+	// Objects still need to be walked across the line so that their positions, copy counters and
+	// motion remain correct; none will draw anything, so the collision buffer needn't be cleared.
+	ball_.motion_time %= 228;
+	player_[0].motion_time %= 228;
+	player_[1].motion_time %= 228;
+	missile_[0].motion_time %= 228;
+	missile_[1].motion_time %= 228;
+
+	draw_object<Player>(player_[0], uint8_t(CollisionType::Player0), 0, cycles_per_line);
+	draw_object<Player>(player_[1], uint8_t(CollisionType::Player1), 0, cycles_per_line);
+	draw_missile(missile_[0], player_[0], uint8_t(CollisionType::Missile0), 0, cycles_per_line);
+	draw_missile(missile_[1], player_[1], uint8_t(CollisionType::Missile1), 0, cycles_per_line);
+	draw_object<Ball>(ball_, uint8_t(CollisionType::Ball), 0, cycles_per_line);
+
+	crt_.output_blank(32);
+	crt_.output_sync(32);
+	crt_.output_default_colour_burst(32);
+	crt_.output_blank(40);
+
+	// The playfield can't collide with itself, so collision flags are unaffected; output is just
+	// a sequence of four-pixel runs of either the playfield or background colour.
+	uint16_t *const target = reinterpret_cast<uint16_t *>(crt_.begin_data(160));
+	if(target) {
+		const auto colour = [this](ColourMode mode, bool playfield) {
+			return colour_palette_[colour_mask_by_mode_collision_flags_[int(mode)][playfield ? int(CollisionType::Playfield) : 0]].luminance_phase;
+		};
+
+		ColourMode left_mode, right_mode;
+		switch(playfield_priority_) {
+			default:						left_mode = right_mode = ColourMode::Standard;					break;
+			case PlayfieldPriority::OnTop:	left_mode = right_mode = ColourMode::OnTop;						break;
+			case PlayfieldPriority::Score:	left_mode = ColourMode::ScoreLeft; right_mode = ColourMode::ScoreRight;	break;
+		}
+		const uint16_t left[2] = {colour(left_mode, false), colour(left_mode, true)};
+		const uint16_t right[2] = {colour(right_mode, false), colour(right_mode, true)};
+
+		for(int offset = 0; offset < 40; offset++) {
+			const uint16_t *const colours = offset < 20 ? left : right;
+			const uint16_t pixel = colours[(background_[(offset/20)&background_half_mask_] >> (offset%20))&1];
+			target[(offset << 2) + 0] = target[(offset << 2) + 1] = target[(offset << 2) + 2] = target[(offset << 2) + 3] = pixel;
+		}
+
+		if(horizontal_blank_extend_) {
+			for(int c = 0; c < 8; c++) {
+				target[c] = 0xff00;	// TODO: this assumes little endianness.
+			}
+		}
+	}
+	crt_.output_data(320, 160);
+
+	horizontal_blank_extend_ = false;
+}
+
 // MARK: - Playfield output
 
 void TIA::draw_playfield(int start, int end) {
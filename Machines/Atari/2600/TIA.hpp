@@ -307,6 +307,10 @@ class TIA {
 		inline void output_for_cycles(int number_of_cycles);
 		inline void output_line();
 
+		// fast path for whole lines on which only the playfield and background can be visible
+		inline bool objects_are_invisible() const;
+		inline void output_playfield_line();
+
 		int pixels_start_location_ = 0;
 		uint16_t *pixel_target_ = nullptr;
 		inline void output_pixels(int start, int end);
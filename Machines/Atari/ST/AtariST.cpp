@@ -32,9 +32,12 @@
 #define LOG_PREFIX "[ST] "
 #include "../../../Outputs/Log.hpp"
 
+#include "../../../Memory/Arena.hpp"
 #include "../../Utility/MemoryPacker.hpp"
 #include "../../Utility/MemoryFuzzer.hpp"
 
+#include <algorithm>
+
 namespace Atari {
 namespace ST {
 
@@ -51,6 +54,7 @@ class ConcreteMachine:
 	public MachineTypes::JoystickMachine,
 	public MachineTypes::MappedKeyboardMachine,
 	public MachineTypes::MediaTarget,
+	public MachineTypes::MemoryReporter,
 	public ClockingHint::Observer,
 	public Motorola::ACIA::ACIA::InterruptDelegate,
 	public Motorola::MFP68901::MFP68901::InterruptDelegate,
@@ -66,7 +70,9 @@ class ConcreteMachine:
 			midi_acia_(Cycles(500000)),
 			ay_(GI::AY38910::Personality::YM2149F, audio_queue_),
 			speaker_(ay_),
-			ikbd_(keyboard_acia_->transmit, keyboard_acia_->receive) {
+			ikbd_(keyboard_acia_->transmit, keyboard_acia_->receive),
+			ram_(arena_),
+			rom_(arena_) {
 			set_clock_rate(CLOCK_RATE);
 			speaker_.set_input_rate(float(CLOCK_RATE) / 4.0f);
 
@@ -80,7 +86,9 @@ class ConcreteMachine:
 			if(!request.validate(roms)) {
 				throw ROMMachine::Error::MissingROMs;
 			}
-			Memory::PackBigEndian16(roms.find(rom_name)->second, rom_);
+			const auto &rom = roms.find(rom_name)->second;
+			rom_.resize(rom.size());
+			Memory::PackBigEndian16(rom, rom_.data());
 
 			// Set up basic memory map.
 			memory_map_[0] = BusDevice::MostlyRAM;
@@ -101,13 +109,21 @@ class ConcreteMachine:
 			memory_map_[0xfa] = memory_map_[0xfb] = BusDevice::Cartridge;
 			memory_map_[0xff] = BusDevice::IO;
 
+			// ROM is free of contention and side effects, so the 68000 can read it directly.
+			// RAM is subject to video contention, so continues to go via perform_bus_operation.
+			for(c = 0; c < 0xff; ++c) {
+				const size_t rom_offset = size_t((c << 16) - int(rom_start_));
+				if(memory_map_[c] == BusDevice::ROM && rom_offset + 0x10000 <= rom_.size()) {
+					mc68000_.set_fast_memory(c, &rom_[rom_offset], nullptr);
+				}
+			}
+
 			midi_acia_->set_interrupt_delegate(this);
 			keyboard_acia_->set_interrupt_delegate(this);
 
 			midi_acia_->set_clocking_hint_observer(this);
 			keyboard_acia_->set_clocking_hint_observer(this);
 			ikbd_.set_clocking_hint_observer(this);
-			mfp_->set_clocking_hint_observer(this);
 			dma_->set_clocking_hint_observer(this);
 
 			mfp_->set_interrupt_delegate(this);
@@ -158,6 +174,27 @@ class ConcreteMachine:
 
 		// MARK: MC68000::BusHandler
 		using Microcycle = CPU::MC68000::Microcycle;
+
+		HalfCycles perform_stopped_time(HalfCycles maximum) {
+			// Skip ahead only while video and the MFP's timers are the only things that might next
+			// change an interrupt input; keyboard, MIDI and disk activity proceed cycle by cycle.
+			if(keyboard_needs_clock_ || !may_defer_acias_ || dma_clocking_preference_ != ClockingHint::Preference::None) {
+				return HalfCycles(0);
+			}
+
+			const auto duration = HalfCycles(
+				std::min({maximum, video_.cycles_until_implicit_flush(), mfp_.cycles_until_implicit_flush()}).as_integral() & ~1
+			);
+			if(duration <= HalfCycles(0)) {
+				return HalfCycles(0);
+			}
+
+			mc68000_.set_is_peripheral_address(false);
+			mc68000_.set_bus_error(false);
+			advance_time(duration);
+			return duration;
+		}
+
 		HalfCycles perform_bus_operation(const CPU::MC68000::Microcycle &cycle, int is_supervisor) {
 			// Just in case the last cycle was an interrupt acknowledge or bus error. TODO: find a better solution?
 			mc68000_.set_is_peripheral_address(false);
@@ -424,6 +461,18 @@ class ConcreteMachine:
 			audio_queue_.perform();
 		}
 
+		void report_memory(MachineTypes::MemoryFootprint &footprint) final {
+			using Kind = MachineTypes::MemoryFootprint::Kind;
+			flush();
+			audio_queue_.flush();
+
+			footprint.add("RAM", Kind::RAM, ram_.size());
+			footprint.add("ROM", Kind::ROM, rom_.size());
+			footprint.add("68000", Kind::ProcessorTables, mc68000_.get_table_footprint());
+			footprint.add("Speaker", Kind::AudioBuffers, speaker_.get_memory_footprint());
+			footprint.add("DMA controller", Kind::DiskTracks, dma_.last_valid()->get_disk_memory_footprint());
+		}
+
 	private:
 		forceinline void advance_time(HalfCycles length) {
 			// Advance the relevant counters.
@@ -447,10 +496,6 @@ class ConcreteMachine:
 				midi_acia_.flush();
 			}
 
-			if(mfp_is_realtime_) {
-				mfp_.flush();
-			}
-
 			if(dma_clocking_preference_ == ClockingHint::Preference::RealTime) {
 				dma_.flush();
 			}
@@ -491,8 +536,9 @@ class ConcreteMachine:
 		HalfCycles cycles_since_ikbd_update_;
 		IntelligentKeyboard ikbd_;
 
-		std::vector<uint8_t> ram_;
-		std::vector<uint8_t> rom_;
+		Memory::Arena arena_{Memory::Arena::Backing::HugePages};
+		Memory::ArenaVector<uint8_t> ram_;
+		Memory::ArenaVector<uint8_t> rom_;
 		uint32_t rom_start_ = 0;
 
 		enum class BusDevice {
@@ -516,7 +562,6 @@ class ConcreteMachine:
 		// MARK: - Clocking Management.
 		bool may_defer_acias_ = true;
 		bool keyboard_needs_clock_ = false;
-		bool mfp_is_realtime_ = false;
 		ClockingHint::Preference dma_clocking_preference_ = ClockingHint::Preference::None;
 		void set_component_prefers_clocking(ClockingHint::Source *, ClockingHint::Preference) final {
 			// This is being called by one of the components; avoid any time flushing here as that's
@@ -525,7 +570,6 @@ class ConcreteMachine:
 				(keyboard_acia_.last_valid()->preferred_clocking() != ClockingHint::Preference::RealTime) &&
 				(midi_acia_.last_valid()->preferred_clocking() != ClockingHint::Preference::RealTime);
 			keyboard_needs_clock_ = ikbd_.preferred_clocking() != ClockingHint::Preference::None;
-			mfp_is_realtime_ = mfp_.last_valid()->preferred_clocking() == ClockingHint::Preference::RealTime;
 			dma_clocking_preference_ = dma_.last_valid()->preferred_clocking();
 		}
 
@@ -666,13 +710,18 @@ class ConcreteMachine:
 		std::unique_ptr<Reflection::Struct> get_options() final {
 			auto options = std::make_unique<Options>(Configurable::OptionsType::UserFriendly);
 			options->output = get_video_signal_configurable();
+			options->accuracy = accuracy_;
 			return options;
 		}
 
 		void set_options(const std::unique_ptr<Reflection::Struct> &str) final {
 			const auto options = dynamic_cast<Options *>(str.get());
 			set_video_signal_configurable(options->output);
+			accuracy_ = options->accuracy;
+			dma_->set_accuracy(accuracy_);
 		}
+
+		Configurable::Accuracy accuracy_ = Configurable::Accuracy::CycleExact;
 };
 
 }
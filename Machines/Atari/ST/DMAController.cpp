@@ -197,16 +197,7 @@ int DMAController::bus_grant(uint16_t *ram, size_t size) {
 #define b16(i) b4(i, 0) << b4(i, 4) << b4(i, 8) << b4(i, 12)
 //		LOG("[1] to " << PADHEX(6) << address_ << b16(active_buffer_ ^ 1));
 
-		for(int c = 0; c < 8; ++c) {
-			if(size_t(address_) < size) {
-				ram[address_ >> 1] = uint16_t(
-					(buffer_[active_buffer_ ^ 1].contents[(c << 1) + 0] << 8) |
-					(buffer_[active_buffer_ ^ 1].contents[(c << 1) + 1] << 0)
-				);
-			}
-			address_ += 2;
-		}
-		buffer_[active_buffer_ ^ 1].is_full = false;
+		commit(buffer_[active_buffer_ ^ 1], ram, size);
 
 		// Check that the newer buffer is full; stop if not.
 		if(!buffer_[active_buffer_ ].is_full) return 8;
@@ -217,16 +208,7 @@ int DMAController::bus_grant(uint16_t *ram, size_t size) {
 #undef b2
 #undef b
 
-		for(int c = 0; c < 8; ++c) {
-			if(size_t(address_) < size) {
-				ram[address_ >> 1] = uint16_t(
-					(buffer_[active_buffer_].contents[(c << 1) + 0] << 8) |
-					(buffer_[active_buffer_].contents[(c << 1) + 1] << 0)
-				);
-			}
-			address_ += 2;
-		}
-		buffer_[active_buffer_].is_full = false;
+		commit(buffer_[active_buffer_], ram, size);
 
 		// Both buffers were full, so unblock reading.
 		bytes_received_ = 0;
@@ -235,6 +217,29 @@ int DMAController::bus_grant(uint16_t *ram, size_t size) {
 	}
 }
 
+void DMAController::commit(Buffer &buffer, uint16_t *ram, size_t size) {
+	// Write the entire FIFO as a single burst if it fits within RAM, as it almost always will;
+	// otherwise write only those words that do.
+	const auto word = [&buffer](int c) {
+		return uint16_t((buffer.contents[(c << 1) + 0] << 8) | buffer.contents[(c << 1) + 1]);
+	};
+
+	if(size_t(address_) + 16 <= size) {
+		uint16_t *const target = &ram[address_ >> 1];
+		for(int c = 0; c < 8; ++c) {
+			target[c] = word(c);
+		}
+	} else {
+		for(int c = 0; c < 8; ++c) {
+			if(size_t(address_ + (c << 1)) < size) {
+				ram[(address_ >> 1) + c] = word(c);
+			}
+		}
+	}
+	address_ += 16;
+	buffer.is_full = false;
+}
+
 void DMAController::set_delegate(Delegate *delegate) {
 	delegate_ = delegate;
 }
@@ -258,3 +263,7 @@ ClockingHint::Preference DMAController::preferred_clocking() const {
 void DMAController::set_activity_observer(Activity::Observer *observer) {
 	fdc_.set_activity_observer(observer);
 }
+
+void DMAController::set_accuracy(Configurable::Accuracy accuracy) {
+	fdc_.set_accuracy(accuracy);
+}
@@ -42,6 +42,11 @@ class DMAController: public WD::WD1770::Delegate, public ClockingHint::Source, p
 		void set_floppy_drive_selection(bool drive1, bool drive2, bool side2);
 		void set_floppy_disk(std::shared_ptr<Storage::Disk::Disk> disk, size_t drive);
 
+		/// @returns The number of bytes of host memory occupied by tracks of the disks in both floppy drives.
+		size_t get_disk_memory_footprint() const {
+			return fdc_.get_disk_memory_footprint();
+		}
+
 		struct Delegate {
 			virtual void dma_controller_did_change_output(DMAController *) = 0;
 		};
@@ -49,6 +54,9 @@ class DMAController: public WD::WD1770::Delegate, public ClockingHint::Source, p
 
 		void set_activity_observer(Activity::Observer *observer);
 
+		/// Applies @c accuracy to the floppy controller's fast paths.
+		void set_accuracy(Configurable::Accuracy accuracy);
+
 		// ClockingHint::Source.
 		ClockingHint::Preference preferred_clocking() const final;
 
@@ -103,6 +111,10 @@ class DMAController: public WD::WD1770::Delegate, public ClockingHint::Source, p
 			uint8_t contents[16];
 			bool is_full = false;
 		} buffer_[2];
+
+		/// Writes the whole of @c buffer to @c ram at the current address, advancing the address
+		/// and marking the buffer as empty. @c size is the size of @c ram in bytes.
+		void commit(Buffer &buffer, uint16_t *ram, size_t size);
 		int active_buffer_ = 0;
 		int bytes_received_ = 0;
 		bool error_ = false;
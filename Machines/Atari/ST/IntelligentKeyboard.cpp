@@ -20,8 +20,8 @@ IntelligentKeyboard::IntelligentKeyboard(Serial::Line &input, Serial::Line &outp
 	output_line_.set_writer_clock_rate(15625);
 
 	// Add two joysticks into the mix.
-	joysticks_.emplace_back(new Joystick);
-	joysticks_.emplace_back(new Joystick);
+	joysticks_.emplace_back(new Joystick(input_did_change_));
+	joysticks_.emplace_back(new Joystick(input_did_change_));
 }
 
 bool IntelligentKeyboard::serial_line_did_produce_bit(Serial::Line *, int bit) {
@@ -46,7 +46,16 @@ ClockingHint::Preference IntelligentKeyboard::preferred_clocking() const {
 
 void IntelligentKeyboard::run_for(HalfCycles duration) {
 	// Take this opportunity to check for joystick, mouse and keyboard events,
-	// which will have been received asynchronously.
+	// which will have been received asynchronously. Nothing can be reported
+	// unless either an input or the reporting mode has changed since last time.
+	if(input_did_change_.load(std::memory_order_relaxed) && input_did_change_.exchange(false)) {
+		process_input();
+	}
+
+	output_line_.advance_writer(duration);
+}
+
+void IntelligentKeyboard::process_input() {
 	const int captured_movement[2] = { mouse_movement_[0].load(), mouse_movement_[1].load() };
 	switch(mouse_mode_) {
 		case MouseMode::Relative: {
@@ -137,8 +146,6 @@ void IntelligentKeyboard::run_for(HalfCycles duration) {
 			}
 		}
 	}
-
-	output_line_.advance_writer(duration);
 }
 
 void IntelligentKeyboard::output_bytes(std::initializer_list<uint8_t> values) {
@@ -249,7 +256,9 @@ void IntelligentKeyboard::dispatch_command(uint8_t command) {
 	}
 
 	// There was no premature exit, so a complete command sequence must have been satisfied.
+	// The reporting mode may have changed, so check input again.
 	command_sequence_.clear();
+	input_did_change_ = true;
 }
 
 void IntelligentKeyboard::reset() {
@@ -354,6 +363,7 @@ void IntelligentKeyboard::set_key_state(Key key, bool is_pressed) {
 	} else {
 		key_queue_.push_back(0x80 | uint8_t(key));
 	}
+	input_did_change_ = true;
 }
 
 uint16_t IntelligentKeyboard::KeyboardMapper::mapped_key_for_key(Inputs::Keyboard::Key key) const {
@@ -422,6 +432,7 @@ uint16_t IntelligentKeyboard::KeyboardMapper::mapped_key_for_key(Inputs::Keyboar
 void IntelligentKeyboard::move(int x, int y) {
 	mouse_movement_[0] += x;
 	mouse_movement_[1] += y;
+	input_did_change_ = true;
 }
 
 int IntelligentKeyboard::get_number_of_buttons() {
@@ -440,10 +451,12 @@ void IntelligentKeyboard::set_button_pressed(int index, bool is_pressed) {
 		mouse_button_state_ &= ~mask;
 		mouse_button_events_ |= event_mask << 1;
 	}
+	input_did_change_ = true;
 }
 
 void IntelligentKeyboard::reset_all_buttons() {
 	mouse_button_state_ = 0;
+	input_did_change_ = true;
 }
 
 // MARK: - Joystick Output
@@ -75,6 +75,13 @@ class IntelligentKeyboard:
 		std::mutex key_queue_mutex_;
 		std::vector<uint8_t> key_queue_;
 
+		// MARK: - Input polling.
+
+		/// Set whenever any key, mouse or joystick input arrives, or a command is processed;
+		/// input is otherwise not inspected.
+		std::atomic<bool> input_did_change_{true};
+		void process_input();
+
 		// MARK: - Serial line state.
 		int bit_count_ = 0;
 		int command_ = 0;
@@ -153,14 +160,14 @@ class IntelligentKeyboard:
 
 		class Joystick: public Inputs::ConcreteJoystick {
 			public:
-				Joystick() :
+				Joystick(std::atomic<bool> &did_change) :
 					ConcreteJoystick({
 						Input(Input::Up),
 						Input(Input::Down),
 						Input(Input::Left),
 						Input(Input::Right),
 						Input(Input::Fire, 0),
-					}) {}
+					}), did_change_(did_change) {}
 
 				void did_set_input(const Input &input, bool is_active) final {
 					uint8_t mask = 0;
@@ -174,6 +181,7 @@ class IntelligentKeyboard:
 					}
 
 					if(is_active) state_ |= mask; else state_ &= ~mask;
+					did_change_ = true;
 				}
 
 				uint8_t get_state() {
@@ -192,6 +200,7 @@ class IntelligentKeyboard:
 			private:
 				uint8_t state_ = 0x00;
 				uint8_t returned_state_ = 0x00;
+				std::atomic<bool> &did_change_;
 		};
 		std::vector<std::unique_ptr<Inputs::Joystick>> joysticks_;
 };
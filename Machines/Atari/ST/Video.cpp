@@ -11,8 +11,19 @@
 #include "../../../Outputs/Log.hpp"
 
 #include <algorithm>
+#include <array>
 #include <cstring>
 
+// Use SSE2 or NEON if available; each is guaranteed to be present on
+// 64-bit x86 and ARM respectively.
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define USE_SSE2
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define USE_NEON
+#endif
+
 #define CYCLE(x)	((x) * 2)
 
 using namespace Atari::ST;
@@ -645,6 +656,44 @@ namespace {
 #else
 	constexpr int upper = 1;
 #endif
+
+/// Maps the top four bits of a bitplane to four bytes, each being 0 or 1, with the
+/// leftmost pixel in the least significant byte. Combining one such word per plane,
+/// suitably shifted, gives four palette indices at once.
+constexpr auto nibble_spreads = [] {
+	std::array<uint32_t, 16> spreads{};
+	for(uint32_t c = 0; c < 16; c++) {
+		for(int pixel = 0; pixel < 4; pixel++) {
+			spreads[c] |= ((c >> (3 - pixel)) & 1) << (pixel * 8);
+		}
+	}
+	return spreads;
+} ();
+
+/// Writes to @c target the palette entries nominated by the four packed indices in @c indices.
+inline void output_indices(uint16_t *target, const uint16_t *palette, uint32_t indices) {
+	target[0] = palette[indices & 0xff];
+	target[1] = palette[(indices >> 8) & 0xff];
+	target[2] = palette[(indices >> 16) & 0xff];
+	target[3] = palette[indices >> 24];
+}
+
+/// Writes eight 1bpp pixels from @c bits to @c target, most significant first, as either 0xffff or 0.
+inline void output_mono_byte(uint16_t *target, uint8_t bits) {
+#if defined(USE_SSE2)
+	const __m128i masks = _mm_set_epi16(0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80);
+	const __m128i selected = _mm_and_si128(_mm_set1_epi16(short(bits)), masks);
+	_mm_storeu_si128(reinterpret_cast<__m128i *>(target), _mm_cmpeq_epi16(selected, masks));
+#elif defined(USE_NEON)
+	static constexpr uint16_t masks[] = {0x80, 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01};
+	vst1q_u16(target, vtstq_u16(vdupq_n_u16(bits), vld1q_u16(masks)));
+#else
+	for(int c = 0; c < 8; c++) {
+		target[c] = ((bits >> (7 - c)) & 1) * 0xffff;
+	}
+#endif
+}
+
 }
 
 void Video::VideoStream::shift(int duration) {
@@ -692,8 +741,17 @@ void Video::VideoStream::output_pixels(int duration) {
 		int pixels_to_draw = std::min(allocation_size - pixel_pointer_, pixels);
 		pixels -= pixels_to_draw;
 
+		// Whole groups of pixels are converted from planar to chunky in bulk; any remainder
+		// is shifted out one pixel at a time.
 		switch(bpp_) {
 			case OutputBpp::One:
+				for(; pixels_to_draw >= 8; pixels_to_draw -= 8) {
+					output_mono_byte(&pixel_buffer_[pixel_pointer_], uint8_t(output_shifter_ >> 56));
+					output_shifter_ <<= 8;
+
+					pixel_pointer_ += 8;
+				}
+
 				while(pixels_to_draw--) {
 					pixel_buffer_[pixel_pointer_] = ((output_shifter_ >> 63) & 1) * 0xffff;
 					output_shifter_ <<= 1;
@@ -703,6 +761,19 @@ void Video::VideoStream::output_pixels(int duration) {
 			break;
 
 			case OutputBpp::Two:
+				for(; pixels_to_draw >= 4; pixels_to_draw -= 4) {
+					output_indices(&pixel_buffer_[pixel_pointer_], palette_,
+						nibble_spreads[shifter_halves_[upper] >> 28] |
+						(nibble_spreads[(shifter_halves_[upper] >> 12) & 15] << 1)
+					);
+					// As below, but four pixels at once.
+					shifter_halves_[upper] = (shifter_halves_[upper] << 4) & 0xfff0fff0;
+					shifter_halves_[upper] |= (shifter_halves_[upper^1] >> 12) & 0x000f000f;
+					shifter_halves_[upper^1] = (shifter_halves_[upper^1] << 4) & 0xfff0fff0;
+
+					pixel_pointer_ += 4;
+				}
+
 				while(pixels_to_draw--) {
 					pixel_buffer_[pixel_pointer_] = palette_[
 						((output_shifter_ >> 63) & 1) |
@@ -720,6 +791,18 @@ void Video::VideoStream::output_pixels(int duration) {
 			break;
 
 			case OutputBpp::Four:
+				for(; pixels_to_draw >= 4; pixels_to_draw -= 4) {
+					output_indices(&pixel_buffer_[pixel_pointer_], palette_,
+						nibble_spreads[output_shifter_ >> 60] |
+						(nibble_spreads[(output_shifter_ >> 44) & 15] << 1) |
+						(nibble_spreads[(output_shifter_ >> 28) & 15] << 2) |
+						(nibble_spreads[(output_shifter_ >> 12) & 15] << 3)
+					);
+					output_shifter_ = (output_shifter_ << 4) & 0xfff0fff0fff0fff0;
+
+					pixel_pointer_ += 4;
+				}
+
 				while(pixels_to_draw--) {
 					pixel_buffer_[pixel_pointer_] = palette_[
 						((output_shifter_ >> 63) & 1) |
@@ -112,7 +112,8 @@ class ConcreteMachine:
 	public MachineTypes::TimedMachine,
 	public MachineTypes::ScanProducer,
 	public MachineTypes::AudioProducer,
-	public MachineTypes::JoystickMachine {
+	public MachineTypes::JoystickMachine,
+	public MachineTypes::MemoryReporter {
 
 	public:
 		ConcreteMachine(const Analyser::Static::Target &target, const ROMMachine::ROMFetcher &rom_fetcher) :
@@ -348,6 +349,19 @@ class ConcreteMachine:
 			audio_queue_.perform();
 		}
 
+		void report_memory(MachineTypes::MemoryFootprint &footprint) final {
+			using Kind = MachineTypes::MemoryFootprint::Kind;
+			flush();
+			audio_queue_.flush();
+
+			footprint.add("RAM", Kind::RAM, sizeof(ram_));
+			footprint.add("Super Game Module", Kind::RAM, sizeof(super_game_module_.ram));
+			footprint.add("ROM", Kind::ROM, bios_.size() + cartridge_.size());
+			footprint.add("VDP", Kind::RAM, vdp_.last_valid()->get_video_ram_size());
+			footprint.add("Z80", Kind::ProcessorTables, z80_.get_table_footprint());
+			footprint.add("Speaker", Kind::AudioBuffers, speaker_.get_memory_footprint());
+		}
+
 		float get_confidence() final {
 			if(pc_zero_accesses_ > 1) return 0.0f;
 			return confidence_counter_.get_confidence();
@@ -101,6 +101,13 @@ Cycles MachineBase::perform_bus_operation(CPU::MOS6502::BusOperation operation,
 	serial_port_VIA_.run_for(Cycles(1));
 	drive_VIA_.run_for(Cycles(1));
 
+	// The disk is clocked in lockstep with the CPU so that run_for can be supplied
+	// arbitrarily long periods without changing the CPU's view of disk data.
+	const bool drive_motor = drive_VIA_port_handler_.get_motor_enabled();
+	get_drive().set_motor_on(drive_motor);
+	if(drive_motor)
+		Storage::Disk::Controller::run_for(Cycles(1));
+
 	return Cycles(1);
 }
 
@@ -110,11 +117,6 @@ void Machine::set_disk(std::shared_ptr<Storage::Disk::Disk> disk) {
 
 void Machine::run_for(const Cycles cycles) {
 	m6502_.run_for(cycles);
-
-	const bool drive_motor = drive_VIA_port_handler_.get_motor_enabled();
-	get_drive().set_motor_on(drive_motor);
-	if(drive_motor)
-		Storage::Disk::Controller::run_for(cycles);
 }
 
 void MachineBase::set_activity_observer(Activity::Observer *observer) {
@@ -122,6 +124,14 @@ void MachineBase::set_activity_observer(Activity::Observer *observer) {
 	get_drive().set_activity_observer(observer, "Drive", false);
 }
 
+void MachineBase::report_memory(MachineTypes::MemoryFootprint &footprint, const std::string &name) {
+	using Kind = MachineTypes::MemoryFootprint::Kind;
+	footprint.add(name + " RAM", Kind::RAM, sizeof(ram_));
+	footprint.add(name + " ROM", Kind::ROM, sizeof(rom_));
+	footprint.add(name + " 6502", Kind::ProcessorTables, m6502_.get_table_footprint());
+	footprint.add(name, Kind::DiskTracks, get_disk_memory_footprint());
+}
+
 // MARK: - 6522 delegate
 
 void MachineBase::mos6522_did_change_interrupt_status(void *) {
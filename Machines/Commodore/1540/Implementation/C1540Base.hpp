@@ -15,6 +15,7 @@
 #include "../../SerialBus.hpp"
 
 #include "../../../../Activity/Source.hpp"
+#include "../../../MemoryReporter.hpp"
 #include "../../../../Storage/Disk/Disk.hpp"
 
 #include "../../../../Storage/Disk/Controller/DiskController.hpp"
@@ -142,6 +143,9 @@ class MachineBase:
 		/// Attaches the activity observer to this C1540.
 		void set_activity_observer(Activity::Observer *observer);
 
+		/// Adds to @c footprint the storage held by this C1540, naming each entry with @c name as a prefix.
+		void report_memory(MachineTypes::MemoryFootprint &footprint, const std::string &name);
+
 	protected:
 		CPU::MOS6502::Processor<CPU::MOS6502::Personality::P6502, MachineBase, false> m6502_;
 
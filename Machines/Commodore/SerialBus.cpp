@@ -33,7 +33,9 @@ void Bus::add_port(std::shared_ptr<Port> port) {
 	ports_.push_back(port);
 	for(int line = int(ServiceRequest); line <= int(Reset); line++) {
 		// the addition of a new device may change the line output...
-		set_line_output_did_change(Line(line));
+		if(port->get_output(Line(line)) == Low) {
+			set_port_output_did_change(Line(line), Low);
+		}
 
 		// ... but the new device will need to be told the current state regardless
 		port->set_input(Line(line), line_levels_[line]);
@@ -42,23 +44,31 @@ void Bus::add_port(std::shared_ptr<Port> port) {
 
 void Bus::set_line_output_did_change(Line line) {
 	// i.e. I believe these lines to be open collector
-	LineLevel new_line_level = High;
+	low_outputs_[line] = 0;
 	for(std::weak_ptr<Port> port : ports_) {
 		std::shared_ptr<Port> locked_port = port.lock();
-		if(locked_port) {
-			new_line_level = (LineLevel)(bool(new_line_level) & bool(locked_port->get_output(line)));
+		if(locked_port && locked_port->get_output(line) == Low) {
+			++low_outputs_[line];
 		}
 	}
 
+	set_line_level(line, low_outputs_[line] ? Low : High);
+}
+
+void Bus::set_port_output_did_change(Line line, LineLevel level) {
+	low_outputs_[line] += (level == Low) ? 1 : -1;
+	set_line_level(line, low_outputs_[line] ? Low : High);
+}
+
+void Bus::set_line_level(Line line, LineLevel level) {
 	// post an update only if one occurred
-	if(new_line_level != line_levels_[line]) {
-		line_levels_[line] = new_line_level;
+	if(level == line_levels_[line]) return;
+	line_levels_[line] = level;
 
-		for(std::weak_ptr<Port> port : ports_) {
-			std::shared_ptr<Port> locked_port = port.lock();
-			if(locked_port) {
-				locked_port->set_input(line, new_line_level);
-			}
+	for(std::weak_ptr<Port> port : ports_) {
+		std::shared_ptr<Port> locked_port = port.lock();
+		if(locked_port) {
+			locked_port->set_input(line, level);
 		}
 	}
 }
@@ -47,6 +47,9 @@ namespace Serial {
 		A serial bus is responsible for retaining a weakly-held collection of attached ports and for deciding the
 		current bus levels based upon the net result of each port's output, and for communicating changes in bus
 		levels to every port.
+
+		Lines are open collector, so the bus keeps a count of the ports pulling each line low; an output change
+		therefore costs a single adjustment, and only a change in overall level is propagated.
 	*/
 	class Bus {
 		public:
@@ -63,9 +66,17 @@ namespace Serial {
 			*/
 			void set_line_output_did_change(Line line);
 
+			/*!
+				Communicates to the bus that an attached port has changed its output for @c line to @c level.
+			*/
+			void set_port_output_did_change(Line line, LineLevel level);
+
 		private:
 			LineLevel line_levels_[5];
+			int low_outputs_[5]{};
 			std::vector<std::weak_ptr<Port>> ports_;
+
+			void set_line_level(Line line, LineLevel level);
 	};
 
 	/*!
@@ -75,7 +86,12 @@ namespace Serial {
 	class Port {
 		public:
 			Port() : line_levels_{High, High, High, High, High} {}
-			virtual ~Port() {}
+			virtual ~Port() {
+				// Release any lines this port is holding low.
+				for(int line = int(ServiceRequest); line <= int(Reset); line++) {
+					set_output(Line(line), High);
+				}
+			}
 
 			/*!
 				Sets the current level of an output line on this serial port.
@@ -84,7 +100,7 @@ namespace Serial {
 				if(line_levels_[line] != level) {
 					line_levels_[line] = level;
 					std::shared_ptr<Bus> bus = serial_bus_.lock();
-					if(bus) bus->set_line_output_did_change(line);
+					if(bus) bus->set_port_output_did_change(line, level);
 				}
 			}
 
@@ -18,6 +18,8 @@
 #include "../../../Components/6522/6522.hpp"
 
 #include "../../../ClockReceiver/ForceInline.hpp"
+#include "../../../ClockReceiver/JustInTime.hpp"
+#include "../../../ClockReceiver/ParallelGroup.hpp"
 #include "../../../Outputs/Log.hpp"
 
 #include "../../../Storage/Tape/Parsers/Commodore.hpp"
@@ -204,9 +206,13 @@ class KeyboardVIA: public MOS::MOS6522::IRQDelegatePortHandler {
 class SerialPort : public ::Commodore::Serial::Port {
 	public:
 		/// Receives an input change from the base serial port class, and communicates it to the user-port VIA.
+		///
+		/// Changes caused by a drive that is running in parallel are deferred until the machine next synchronises with it.
 		void set_input(::Commodore::Serial::Line line, ::Commodore::Serial::LineLevel level) {
-			std::shared_ptr<UserPortVIA> userPortVIA = user_port_via_.lock();
-			if(userPortVIA) userPortVIA->set_serial_line_state(line, bool(level));
+			signals_->post([this, line, level] {
+				std::shared_ptr<UserPortVIA> userPortVIA = user_port_via_.lock();
+				if(userPortVIA) userPortVIA->set_serial_line_state(line, bool(level));
+			});
 		}
 
 		/// Sets the user-port VIA with which this serial port communicates.
@@ -214,8 +220,14 @@ class SerialPort : public ::Commodore::Serial::Port {
 			user_port_via_ = userPortVIA;
 		}
 
+		/// Sets the route by which input changes are delivered.
+		void set_signals(ParallelSignals *signals) {
+			signals_ = signals;
+		}
+
 	private:
 		std::weak_ptr<UserPortVIA> user_port_via_;
+		ParallelSignals *signals_ = nullptr;
 };
 
 /*!
@@ -277,6 +289,7 @@ class ConcreteMachine:
 	public MachineTypes::MediaTarget,
 	public MachineTypes::MappedKeyboardMachine,
 	public MachineTypes::JoystickMachine,
+	public MachineTypes::MemoryReporter,
 	public Configurable::Device,
 	public CPU::MOS6502::BusHandler,
 	public MOS::MOS6522::IRQDelegatePortHandler::Delegate,
@@ -306,6 +319,7 @@ class ConcreteMachine:
 			user_port_via_port_handler_->set_serial_port(serial_port_);
 			keyboard_via_port_handler_->set_serial_port(serial_port_);
 			serial_port_->set_user_port_via(user_port_via_port_handler_);
+			serial_port_->set_signals(&c1540_group_);
 
 			// wire up the 6522s, tape and machine
 			user_port_via_port_handler_->set_interrupt_delegate(this);
@@ -364,6 +378,10 @@ class ConcreteMachine:
 
 				// give it a little warm up
 				c1540_->run_for(Cycles(2000000));
+
+				// From here on it can run in parallel with the Vic.
+				c1540_group_.set_component(c1540_.get());
+				c1540_group_.set_is_parallel(true);
 			}
 
 			// Determine PAL/NTSC
@@ -442,12 +460,19 @@ class ConcreteMachine:
 			}
 		}
 
+		~ConcreteMachine() {
+			// Release the drive while the group through which it signals still exists.
+			update_c1540();
+			c1540_.reset();
+		}
+
 		bool insert_media(const Analyser::Static::Media &media) final {
 			if(!media.tapes.empty()) {
 				tape_->set_tape(media.tapes.front());
 			}
 
 			if(!media.disks.empty() && c1540_) {
+				update_c1540();
 				c1540_->set_disk(media.disks.front());
 			}
 
@@ -472,7 +497,8 @@ class ConcreteMachine:
 			} else {
 				switch(key) {
 					case KeyRestore:
-						user_port_via_.set_control_line_input(MOS::MOS6522::Port::A, MOS::MOS6522::Line::One, !is_pressed);
+						update_c1540();
+						user_port_via_->set_control_line_input(MOS::MOS6522::Port::A, MOS::MOS6522::Line::One, !is_pressed);
 					break;
 #define ShiftedMap(source, target)	\
 					case source:	\
@@ -512,8 +538,9 @@ class ConcreteMachine:
 						update_video();
 						result &= mos6560_.read(address);
 					}
-					if(address & 0x10) result &= user_port_via_.read(address);
-					if(address & 0x20) result &= keyboard_via_.read(address);
+					if(address & 0x30) update_c1540();
+					if(address & 0x10) result &= user_port_via_->read(address);
+					if(address & 0x20) result &= keyboard_via_->read(address);
 				}
 				*value = result;
 
@@ -599,15 +626,20 @@ class ConcreteMachine:
 						update_video();
 						mos6560_.write(address, *value);
 					}
+					if(address & 0x30) update_c1540();
 					// The first VIA is selected by bit 4 = 1.
-					if(address & 0x10) user_port_via_.write(address, *value);
+					if(address & 0x10) user_port_via_->write(address, *value);
 					// The second VIA is selected by bit 5 = 1.
-					if(address & 0x20) keyboard_via_.write(address, *value);
+					if(address & 0x20) keyboard_via_->write(address, *value);
 				}
 			}
 
-			user_port_via_.run_for(Cycles(1));
-			keyboard_via_.run_for(Cycles(1));
+			// Any VIA event might change what the Vic is presenting to the serial bus.
+			if(user_port_via_.will_flush(Cycles(1)) || keyboard_via_.will_flush(Cycles(1))) {
+				update_c1540();
+			}
+			user_port_via_ += Cycles(1);
+			keyboard_via_ += Cycles(1);
 			if(typer_ && address == 0xeb1e && operation == CPU::MOS6502::BusOperation::ReadOpcode) {
 				if(!typer_->type_next_character()) {
 					clear_all_keys();
@@ -615,14 +647,28 @@ class ConcreteMachine:
 				}
 			}
 			if(!tape_is_sleeping_ && !hold_tape_) tape_->run_for(Cycles(1));
-			if(c1540_) c1540_->run_for(Cycles(1));
+			c1540_group_ += Cycles(1);
 
 			return Cycles(1);
 		}
 
 		void flush() {
+			update_c1540();
 			update_video();
 			mos6560_.flush();
+			user_port_via_.flush();
+			keyboard_via_.flush();
+		}
+
+		void report_memory(MachineTypes::MemoryFootprint &footprint) final {
+			using Kind = MachineTypes::MemoryFootprint::Kind;
+			flush();
+
+			footprint.add("RAM", Kind::RAM, sizeof(ram_) + sizeof(colour_ram_));
+			footprint.add("ROM", Kind::ROM, character_rom_.size() + basic_rom_.size() + kernel_rom_.size() + rom_.size());
+			footprint.add("6502", Kind::ProcessorTables, m6502_.get_table_footprint());
+			footprint.add("6560", Kind::AudioBuffers, mos6560_.get_speaker_memory_footprint());
+			if(c1540_) c1540_->report_memory(footprint, "C1540");
 		}
 
 		void run_for(const Cycles cycles) final {
@@ -650,8 +696,8 @@ class ConcreteMachine:
 		}
 
 		void mos6522_did_change_interrupt_status(void *) final {
-			m6502_.set_nmi_line(user_port_via_.get_interrupt_line());
-			m6502_.set_irq_line(keyboard_via_.get_interrupt_line());
+			m6502_.set_nmi_line(user_port_via_.last_valid()->get_interrupt_line());
+			m6502_.set_irq_line(keyboard_via_.last_valid()->get_interrupt_line());
 		}
 
 		void type_string(const std::string &string) final {
@@ -663,7 +709,8 @@ class ConcreteMachine:
 		}
 
 		void tape_did_change_input(Storage::Tape::BinaryTapePlayer *tape) final {
-			keyboard_via_.set_control_line_input(MOS::MOS6522::Port::A, MOS::MOS6522::Line::One, !tape->get_input());
+			update_c1540();
+			keyboard_via_->set_control_line_input(MOS::MOS6522::Port::A, MOS::MOS6522::Line::One, !tape->get_input());
 		}
 
 		KeyboardMapper *get_keyboard_mapper() final {
@@ -693,6 +740,7 @@ class ConcreteMachine:
 
 		// MARK: - Activity Source
 		void set_activity_observer(Activity::Observer *observer) final {
+			update_c1540();
 			if(c1540_) c1540_->set_activity_observer(observer);
 		}
 
@@ -734,8 +782,8 @@ class ConcreteMachine:
 		std::shared_ptr<SerialPort> serial_port_;
 		std::shared_ptr<::Commodore::Serial::Bus> serial_bus_;
 
-		MOS::MOS6522::MOS6522<UserPortVIA> user_port_via_;
-		MOS::MOS6522::MOS6522<KeyboardVIA> keyboard_via_;
+		JustInTimeActor<MOS::MOS6522::MOS6522<UserPortVIA>> user_port_via_;
+		JustInTimeActor<MOS::MOS6522::MOS6522<KeyboardVIA>> keyboard_via_;
 
 		// Tape
 		std::shared_ptr<Storage::Tape::BinaryTapePlayer> tape_;
@@ -749,6 +797,13 @@ class ConcreteMachine:
 
 		// Disk
 		std::shared_ptr<::Commodore::C1540::Machine> c1540_;
+
+		/// The drive interacts with the Vic only via the serial bus, so it is brought up to date only when
+		/// the Vic is about to sample or change that, and otherwise runs in parallel.
+		ParallelGroup<::Commodore::C1540::Machine> c1540_group_{Cycles(1024)};
+		void update_c1540() {
+			c1540_group_.synchronise();
+		}
 };
 
 }
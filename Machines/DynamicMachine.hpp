@@ -13,6 +13,10 @@
 #include "../Activity/Source.hpp"
 
 #include "MachineTypes.hpp"
+#include "Utility/StateHasher.hpp"
+
+#include <cstdint>
+#include <optional>
 
 namespace Machine {
 
@@ -32,6 +36,8 @@ struct DynamicMachine {
 	virtual MachineTypes::KeyboardMachine *keyboard_machine() = 0;
 	virtual MachineTypes::MouseMachine *mouse_machine() = 0;
 	virtual MachineTypes::MediaTarget *media_target() = 0;
+	virtual MachineTypes::StateProducer *state_producer() = 0;
+	virtual MachineTypes::MemoryReporter *memory_reporter() = 0;
 
 	/*!
 		Provides a raw pointer to the underlying machine if and only if this dynamic machine really is
@@ -44,6 +50,20 @@ struct DynamicMachine {
 		to the SDL/console port.
 	*/
 	virtual void *raw_pointer() = 0;
+
+	/*!
+		@returns A 64-bit hash of the machine's complete current state, as captured by its StateProducer, or
+			@c std::nullopt if it has none or can't currently capture its state. Only those parts of the state
+			that have changed since the previous call are rehashed; see Machine::StateHasher.
+	*/
+	std::optional<uint64_t> state_hash() {
+		const auto producer = state_producer();
+		if(!producer) return std::nullopt;
+		return state_hasher_.hash(*producer);
+	}
+
+	private:
+		StateHasher state_hasher_;
 };
 
 /*!
@@ -66,6 +86,7 @@ SpecialisedGet(MachineTypes::JoystickMachine, joystick_machine)
 SpecialisedGet(MachineTypes::KeyboardMachine, keyboard_machine)
 SpecialisedGet(MachineTypes::MouseMachine, mouse_machine)
 SpecialisedGet(MachineTypes::MediaTarget, media_target)
+SpecialisedGet(MachineTypes::MemoryReporter, memory_reporter)
 
 #undef SpecialisedGet
 
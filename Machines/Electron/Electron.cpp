@@ -43,6 +43,7 @@ template <bool has_scsi_bus> class ConcreteMachine:
 	public MachineTypes::AudioProducer,
 	public MachineTypes::MediaTarget,
 	public MachineTypes::MappedKeyboardMachine,
+	public MachineTypes::MemoryReporter,
 	public Configurable::Device,
 	public CPU::MOS6502::BusHandler,
 	public Tape::Delegate,
@@ -128,7 +129,7 @@ template <bool has_scsi_bus> class ConcreteMachine:
 			insert_media(target.media);
 
 			if(!target.loading_command.empty()) {
-				type_string(target.loading_command);
+				inject_string(target.loading_command);
 			}
 
 			if(target.should_shift_restart) {
@@ -402,7 +403,22 @@ template <bool has_scsi_bus> class ConcreteMachine:
 					default:
 						if(address >= 0xc000) {
 							if(isReadOperation(operation)) {
-								if(
+								if(operation == CPU::MOS6502::BusOperation::ReadOpcode && address == 0xffe0 && !injected_text_.empty()) {
+									// 0xffe0 is OSRDCH, which returns a character in A with carry clear
+									// if it isn't an escape; supply any injected text directly.
+									m6502_.set_value_of_register(CPU::MOS6502::Register::A, uint8_t(injected_text_.front()));
+									m6502_.set_value_of_register(
+										CPU::MOS6502::Register::Flags,
+										m6502_.get_value_of_register(CPU::MOS6502::Register::Flags) & ~CPU::MOS6502::Flag::Carry
+									);
+									injected_text_.erase(injected_text_.begin());
+
+									if(injected_text_.empty() && !typed_suffix_.empty()) {
+										type_string(typed_suffix_);
+										typed_suffix_.clear();
+									}
+									*value = 0x60; // 0x60 is RTS
+								} else if(
 									use_fast_tape_hack_ &&
 									(operation == CPU::MOS6502::BusOperation::ReadOpcode) &&
 									(
@@ -426,12 +442,13 @@ template <bool has_scsi_bus> class ConcreteMachine:
 										if(!ram_[0x247] && service_call == 14) {
 											tape_.set_delegate(nullptr);
 
-											int cycles_left_while_plausibly_in_data = 50;
+											// Allow roughly a byte and a half between bytes, whether measured in bits or pulses.
+											int events_left_while_plausibly_in_data = tape_.is_playing_bits() ? 16 : 50;
 											tape_.clear_interrupts(Interrupt::ReceiveDataFull);
 											while(!tape_.get_tape()->is_at_end()) {
-												tape_.run_for_input_pulse();
-												--cycles_left_while_plausibly_in_data;
-												if(!cycles_left_while_plausibly_in_data) fast_load_is_in_data_ = false;
+												tape_.run_for_input_event();
+												--events_left_while_plausibly_in_data;
+												if(!events_left_while_plausibly_in_data) fast_load_is_in_data_ = false;
 												if(	(tape_.get_interrupt_status() & Interrupt::ReceiveDataFull) &&
 													(fast_load_is_in_data_ || tape_.get_data_register() == 0x2a)
 												) break;
@@ -507,6 +524,26 @@ template <bool has_scsi_bus> class ConcreteMachine:
 			audio_queue_.perform();
 		}
 
+		void report_memory(MachineTypes::MemoryFootprint &footprint) final {
+			using Kind = MachineTypes::MemoryFootprint::Kind;
+			flush();
+			audio_queue_.flush();
+
+			// Writeable ROM slots are sideways RAM.
+			size_t sideways_ram = 0;
+			for(const auto is_writeable: rom_write_masks_) {
+				if(is_writeable) sideways_ram += sizeof(roms_[0]);
+			}
+			footprint.add("RAM", Kind::RAM, sizeof(ram_) + sideways_ram);
+			footprint.add("ROM", Kind::ROM,
+				sizeof(os_) + sizeof(roms_) - sideways_ram + dfs_.size() + adfs1_.size() + adfs2_.size());
+			footprint.add("6502", Kind::ProcessorTables, m6502_.get_table_footprint());
+			footprint.add("Speaker", Kind::AudioBuffers, speaker_.get_memory_footprint());
+			if(plus3_) {
+				footprint.add("Plus 3", Kind::DiskTracks, plus3_->get_disk_memory_footprint());
+			}
+		}
+
 		void set_scan_target(Outputs::Display::ScanTarget *scan_target) final {
 			video_.last_valid()->set_scan_target(scan_target);
 		}
@@ -579,6 +616,28 @@ template <bool has_scsi_bus> class ConcreteMachine:
 			Utility::TypeRecipient<CharacterMapper>::add_typer(string);
 		}
 
+		/*!
+			Supplies the newline-terminated prefix of @c string directly to whatever next calls OSRDCH,
+			rather than typing it. This avoids both waiting for the OS to finish starting up and the
+			real-time cost of each key transition. Anything after the final newline is typed as usual
+			once the rest has been consumed.
+		*/
+		void inject_string(const std::string &string) {
+			const auto final_newline = string.rfind('\n');
+			if(final_newline == std::string::npos) {
+				type_string(string);
+				return;
+			}
+
+			std::transform(
+				string.begin(),
+				string.begin() + std::string::difference_type(final_newline + 1),
+				std::back_inserter(injected_text_),
+				[](unsigned char c) -> unsigned char { return (c == '\n') ? '\r' : c; }
+			);
+			typed_suffix_ += string.substr(final_newline + 1);
+		}
+
 		bool can_type(char c) const final {
 			return Utility::TypeRecipient<CharacterMapper>::can_type(c);
 		}
@@ -739,6 +798,9 @@ template <bool has_scsi_bus> class ConcreteMachine:
 		}
 		bool fast_load_is_in_data_ = false;
 
+		// Keyboard
+		std::string injected_text_, typed_suffix_;
+
 		// Disk
 		std::unique_ptr<Plus3> plus3_;
 		bool is_holding_shift_ = false;
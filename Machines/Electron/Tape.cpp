@@ -10,10 +10,29 @@
 
 using namespace Electron;
 
-Tape::Tape() : TapePlayer(2000000) {
+namespace {
+constexpr Cycles::IntType ClockRate = 2000000;
+}
+
+Tape::Tape() : TapePlayer(int(ClockRate)) {
 	shifter_.set_delegate(this);
 }
 
+void Tape::set_tape(std::shared_ptr<Storage::Tape::Tape> tape) {
+	TapePlayer::set_tape(tape);
+
+	uef_ = std::dynamic_pointer_cast<Storage::Tape::UEF>(tape);
+	if(uef_ && !uef_->can_supply_bits()) uef_ = nullptr;
+	if(uef_) {
+		// The player will have begun reading pulses, so return to the start.
+		uef_->reset();
+		serial_.bits = Storage::Tape::UEF::Bits();
+		serial_.next_bit = 0;
+		serial_.remainder = 0;
+		fetch_bit();
+	}
+}
+
 void Tape::push_tape_bit(uint16_t bit) {
 	data_register_ = uint16_t((data_register_ >> 1) | (bit << 10));
 
@@ -76,11 +95,56 @@ void Tape::acorn_shifter_output_bit(int value) {
 	push_tape_bit(uint16_t(value));
 }
 
+void Tape::run_for_input_event() {
+	if(uef_) {
+		complete_bit();
+	} else {
+		run_for_input_pulse();
+	}
+}
+
+void Tape::run_bits_for(Cycles::IntType cycles) {
+	while(cycles >= serial_.cycles_until_next_bit) {
+		cycles -= serial_.cycles_until_next_bit;
+		complete_bit();
+	}
+	serial_.cycles_until_next_bit -= cycles;
+}
+
+void Tape::complete_bit() {
+	// A run of no bits is a gap, during which nothing is received.
+	if(serial_.bits.count) {
+		push_tape_bit(uint16_t((serial_.bits.value >> serial_.next_bit) & 1));
+	}
+	++serial_.next_bit;
+	fetch_bit();
+}
+
+void Tape::fetch_bit() {
+	if(serial_.next_bit >= serial_.bits.count) {
+		serial_.next_bit = 0;
+		if(!uef_->get_next_bits(serial_.bits)) {
+			// Beyond the end of the tape, supply a second of silence at a time.
+			serial_.bits = Storage::Tape::UEF::Bits();
+			serial_.bits.length = Storage::Time(1);
+		}
+	}
+
+	// Convert the length of the bit to whole cycles, carrying the remainder forward.
+	const uint64_t numerator = uint64_t(ClockRate) * serial_.bits.length.length + serial_.remainder;
+	serial_.cycles_until_next_bit = Cycles::IntType(numerator / serial_.bits.length.clock_rate);
+	serial_.remainder = numerator % serial_.bits.length.clock_rate;
+}
+
 void Tape::run_for(const Cycles cycles) {
 	if(is_enabled_) {
 		if(is_in_input_mode_) {
 			if(is_running_) {
-				TapePlayer::run_for(cycles);
+				if(uef_) {
+					run_bits_for(cycles.as_integral());
+				} else {
+					TapePlayer::run_for(cycles);
+				}
 			}
 		} else {
 			output_.cycles_into_pulse += unsigned(cycles.as_integral());
@@ -13,6 +13,7 @@
 
 #include "../../ClockReceiver/ClockReceiver.hpp"
 #include "../../Storage/Tape/Tape.hpp"
+#include "../../Storage/Tape/Formats/TapeUEF.hpp"
 #include "../../Storage/Tape/Parsers/Acorn.hpp"
 #include "Interrupts.hpp"
 
@@ -24,9 +25,24 @@ class Tape:
 	public:
 		Tape();
 
+		/*!
+			Inserts @c tape. UEFs are, where possible, played as bits decoded directly from their data
+			chunks, each of which is shifted into the data register at the end of the time it would occupy
+			on tape; other tapes are played as pulses, which are decoded into bits.
+		*/
+		void set_tape(std::shared_ptr<Storage::Tape::Tape> tape);
+
 		void run_for(const Cycles cycles);
 		using Storage::Tape::TapePlayer::run_for;
 
+		/// Runs the tape to the end of its next pulse or, if it is being played as bits, its next bit.
+		void run_for_input_event();
+
+		/// @returns @c true if the tape is being played as bits rather than as pulses.
+		bool is_playing_bits() const {
+			return bool(uef_);
+		}
+
 		uint8_t get_data_register();
 		void set_data_register(uint8_t value);
 		void set_counter(uint8_t value);
@@ -71,6 +87,18 @@ class Tape:
 		Delegate *delegate_ = nullptr;
 
 		::Storage::Tape::Acorn::Shifter shifter_;
+
+		// State for playing a UEF as bits.
+		std::shared_ptr<Storage::Tape::UEF> uef_;
+		struct {
+			Storage::Tape::UEF::Bits bits;
+			int next_bit = 0;
+			Cycles::IntType cycles_until_next_bit = 0;
+			uint64_t remainder = 0;
+		} serial_;
+		void run_bits_for(Cycles::IntType cycles);
+		void complete_bit();
+		void fetch_bit();
 };
 
 }
@@ -43,8 +43,10 @@ VideoOutput::VideoOutput(uint8_t *memory) :
 	crt_(crt_cycles_per_line,
 		1,
 		Outputs::Display::Type::PAL50,
-		Outputs::Display::InputDataType::Red1Green1Blue1) {
+		Outputs::Display::InputDataType::Palette4Packed) {
 	memset(palette_, 0xf, sizeof(palette_));
+	setup_index_tables();
+	update_palette();
 	setup_screen_map();
 	setup_base_address();
 
@@ -95,11 +97,57 @@ void VideoOutput::start_pixel_line() {
 }
 
 void VideoOutput::end_pixel_line() {
+	flush_output();
+	current_character_row_++;
+}
+
+void VideoOutput::setup_index_tables() {
+	// Palette indices are packed two to a byte, the first pixel in the high nibble.
+	const auto pack = [](int first, int second) {
+		return uint8_t((first << 4) | second);
+	};
+
+	for(int byte = 0; byte < 256; byte++) {
+		uint8_t *const eighty1bpp = reinterpret_cast<uint8_t *>(&index_tables_.eighty1bpp[byte]);
+		eighty1bpp[0] = pack((byte&0x80) >> 4, (byte&0x40) >> 3);
+		eighty1bpp[1] = pack((byte&0x20) >> 2, (byte&0x10) >> 1);
+		eighty1bpp[2] = pack((byte&0x08) >> 0, (byte&0x04) << 1);
+		eighty1bpp[3] = pack((byte&0x02) << 2, (byte&0x01) << 3);
+
+		uint8_t *const eighty2bpp = reinterpret_cast<uint8_t *>(&index_tables_.eighty2bpp[byte]);
+		eighty2bpp[0] = pack(((byte&0x80) >> 4) | ((byte&0x08) >> 2), ((byte&0x40) >> 3) | ((byte&0x04) >> 1));
+		eighty2bpp[1] = pack(((byte&0x20) >> 2) | ((byte&0x02) >> 0), ((byte&0x10) >> 1) | ((byte&0x01) << 1));
+
+		index_tables_.eighty4bpp[byte] = pack(
+			((byte&0x80) >> 4) | ((byte&0x20) >> 3) | ((byte&0x08) >> 2) | ((byte&0x02) >> 1),
+			((byte&0x40) >> 3) | ((byte&0x10) >> 2) | ((byte&0x04) >> 1) | ((byte&0x01) >> 0)
+		);
+
+		uint8_t *const forty1bpp = reinterpret_cast<uint8_t *>(&index_tables_.forty1bpp[byte]);
+		forty1bpp[0] = pack((byte&0x80) >> 4, (byte&0x40) >> 3);
+		forty1bpp[1] = pack((byte&0x20) >> 2, (byte&0x10) >> 1);
+
+		index_tables_.forty2bpp[byte] = pack(((byte&0x80) >> 4) | ((byte&0x08) >> 2), ((byte&0x40) >> 3) | ((byte&0x04) >> 1));
+	}
+}
+
+void VideoOutput::flush_output() {
 	const int data_length = int(current_output_target_ - initial_output_target_);
 	if(data_length) {
-		crt_.output_data(data_length * current_output_divider_, size_t(data_length));
+		crt_.output_data(data_length * 2 * current_output_divider_, size_t(data_length));
 	}
-	current_character_row_++;
+	initial_output_target_ = current_output_target_ = nullptr;
+}
+
+void VideoOutput::update_palette() {
+	uint8_t colours[16 * 4]{};
+	for(int c = 0; c < 16; c++) {
+		colours[c*4 + 0] = (palette_[c] & 4) ? 0xff : 0x00;
+		colours[c*4 + 1] = (palette_[c] & 2) ? 0xff : 0x00;
+		colours[c*4 + 2] = (palette_[c] & 1) ? 0xff : 0x00;
+	}
+	crt_.set_palette(colours, 16);
+	palette_is_dirty_ = false;
 }
 
 void VideoOutput::output_pixels(int number_of_cycles) {
@@ -108,6 +156,13 @@ void VideoOutput::output_pixels(int number_of_cycles) {
 	if(is_blank_line_) {
 		crt_.output_blank(number_of_cycles * crt_cycles_multiplier);
 	} else {
+		// A new palette applies to all data not yet output, so first output everything
+		// painted under the old.
+		if(palette_is_dirty_) {
+			flush_output();
+			update_palette();
+		}
+
 		int divider = 1;
 		switch(screen_mode_) {
 			case 0: case 3: divider = 1; break;
@@ -116,12 +171,9 @@ void VideoOutput::output_pixels(int number_of_cycles) {
 		}
 
 		if(!initial_output_target_ || divider != current_output_divider_) {
-			const int data_length = int(current_output_target_ - initial_output_target_);
-			if(data_length) {
-				crt_.output_data(data_length * current_output_divider_, size_t(data_length));
-			}
+			flush_output();
 			current_output_divider_ = divider;
-			initial_output_target_ = current_output_target_ = crt_.begin_data(size_t(640 / current_output_divider_), size_t(8 / divider));
+			initial_output_target_ = current_output_target_ = crt_.begin_data(size_t(320 / current_output_divider_), size_t(4 / divider));
 		}
 
 #define get_pixel()	\
@@ -136,95 +188,95 @@ void VideoOutput::output_pixels(int number_of_cycles) {
 				if(initial_output_target_) {
 					while(number_of_cycles--) {
 						get_pixel();
-						*reinterpret_cast<uint64_t *>(current_output_target_) = palette_tables_.eighty1bpp[last_pixel_byte_];
-						current_output_target_ += 8;
+						*reinterpret_cast<uint32_t *>(current_output_target_) = index_tables_.eighty1bpp[last_pixel_byte_];
+						current_output_target_ += 4;
 						current_pixel_column_++;
 					}
-				} else current_output_target_ += 8*number_of_cycles;
+				} else current_output_target_ += 4*number_of_cycles;
 			break;
 
 			case 1:
 				if(initial_output_target_) {
 					while(number_of_cycles--) {
 						get_pixel();
-						*reinterpret_cast<uint32_t *>(current_output_target_) = palette_tables_.eighty2bpp[last_pixel_byte_];
-						current_output_target_ += 4;
+						*reinterpret_cast<uint16_t *>(current_output_target_) = index_tables_.eighty2bpp[last_pixel_byte_];
+						current_output_target_ += 2;
 						current_pixel_column_++;
 					}
-				} else current_output_target_ += 4*number_of_cycles;
+				} else current_output_target_ += 2*number_of_cycles;
 			break;
 
 			case 2:
 				if(initial_output_target_) {
 					while(number_of_cycles--) {
 						get_pixel();
-						*reinterpret_cast<uint16_t *>(current_output_target_) = palette_tables_.eighty4bpp[last_pixel_byte_];
-						current_output_target_ += 2;
+						*current_output_target_ = index_tables_.eighty4bpp[last_pixel_byte_];
+						current_output_target_++;
 						current_pixel_column_++;
 					}
-				} else current_output_target_ += 2*number_of_cycles;
+				} else current_output_target_ += number_of_cycles;
 			break;
 
 			case 4: case 6:
 				if(initial_output_target_) {
 					if(current_pixel_column_&1) {
 						last_pixel_byte_ <<= 4;
-						*reinterpret_cast<uint32_t *>(current_output_target_) = palette_tables_.forty1bpp[last_pixel_byte_];
-						current_output_target_ += 4;
+						*reinterpret_cast<uint16_t *>(current_output_target_) = index_tables_.forty1bpp[last_pixel_byte_];
+						current_output_target_ += 2;
 
 						number_of_cycles--;
 						current_pixel_column_++;
 					}
 					while(number_of_cycles > 1) {
 						get_pixel();
-						*reinterpret_cast<uint32_t *>(current_output_target_) = palette_tables_.forty1bpp[last_pixel_byte_];
-						current_output_target_ += 4;
+						*reinterpret_cast<uint16_t *>(current_output_target_) = index_tables_.forty1bpp[last_pixel_byte_];
+						current_output_target_ += 2;
 
 						last_pixel_byte_ <<= 4;
-						*reinterpret_cast<uint32_t *>(current_output_target_) = palette_tables_.forty1bpp[last_pixel_byte_];
-						current_output_target_ += 4;
+						*reinterpret_cast<uint16_t *>(current_output_target_) = index_tables_.forty1bpp[last_pixel_byte_];
+						current_output_target_ += 2;
 
 						number_of_cycles -= 2;
 						current_pixel_column_+=2;
 					}
 					if(number_of_cycles) {
 						get_pixel();
-						*reinterpret_cast<uint32_t *>(current_output_target_) = palette_tables_.forty1bpp[last_pixel_byte_];
-						current_output_target_ += 4;
+						*reinterpret_cast<uint16_t *>(current_output_target_) = index_tables_.forty1bpp[last_pixel_byte_];
+						current_output_target_ += 2;
 						current_pixel_column_++;
 					}
-				} else current_output_target_ += 4 * number_of_cycles;
+				} else current_output_target_ += 2*number_of_cycles;
 			break;
 
 			case 5:
 				if(initial_output_target_) {
 					if(current_pixel_column_&1) {
 						last_pixel_byte_ <<= 2;
-						*reinterpret_cast<uint16_t *>(current_output_target_) = palette_tables_.forty2bpp[last_pixel_byte_];
-						current_output_target_ += 2;
+						*current_output_target_ = index_tables_.forty2bpp[last_pixel_byte_];
+						current_output_target_++;
 
 						number_of_cycles--;
 						current_pixel_column_++;
 					}
 					while(number_of_cycles > 1) {
 						get_pixel();
-						*reinterpret_cast<uint16_t *>(current_output_target_) = palette_tables_.forty2bpp[last_pixel_byte_];
-						current_output_target_ += 2;
+						*current_output_target_ = index_tables_.forty2bpp[last_pixel_byte_];
+						current_output_target_++;
 
 						last_pixel_byte_ <<= 2;
-						*reinterpret_cast<uint16_t *>(current_output_target_) = palette_tables_.forty2bpp[last_pixel_byte_];
-						current_output_target_ += 2;
+						*current_output_target_ = index_tables_.forty2bpp[last_pixel_byte_];
+						current_output_target_++;
 
 						number_of_cycles -= 2;
 						current_pixel_column_+=2;
 					}
 					if(number_of_cycles) {
 						get_pixel();
-						*reinterpret_cast<uint16_t *>(current_output_target_) = palette_tables_.forty2bpp[last_pixel_byte_];
-						current_output_target_ += 2;
+						*current_output_target_ = index_tables_.forty2bpp[last_pixel_byte_];
+						current_output_target_++;
 						current_pixel_column_++;
 					}
-				} else current_output_target_ += 2*number_of_cycles;
+				} else current_output_target_ += number_of_cycles;
 			break;
 		}
 
@@ -322,38 +374,7 @@ void VideoOutput::write(int address, uint8_t value) {
 				palette_[registers[index][1]]	= (palette_[registers[index][1]]&5)	| ((colour >> 1)&2);
 			}
 
-			// regenerate all palette tables for now
-			for(int byte = 0; byte < 256; byte++) {
-				uint8_t *target = reinterpret_cast<uint8_t *>(&palette_tables_.forty1bpp[byte]);
-				target[0] = palette_[(byte&0x80) >> 4];
-				target[1] = palette_[(byte&0x40) >> 3];
-				target[2] = palette_[(byte&0x20) >> 2];
-				target[3] = palette_[(byte&0x10) >> 1];
-
-				target = reinterpret_cast<uint8_t *>(&palette_tables_.eighty2bpp[byte]);
-				target[0] = palette_[((byte&0x80) >> 4) | ((byte&0x08) >> 2)];
-				target[1] = palette_[((byte&0x40) >> 3) | ((byte&0x04) >> 1)];
-				target[2] = palette_[((byte&0x20) >> 2) | ((byte&0x02) >> 0)];
-				target[3] = palette_[((byte&0x10) >> 1) | ((byte&0x01) << 1)];
-
-				target = reinterpret_cast<uint8_t *>(&palette_tables_.eighty1bpp[byte]);
-				target[0] = palette_[(byte&0x80) >> 4];
-				target[1] = palette_[(byte&0x40) >> 3];
-				target[2] = palette_[(byte&0x20) >> 2];
-				target[3] = palette_[(byte&0x10) >> 1];
-				target[4] = palette_[(byte&0x08) >> 0];
-				target[5] = palette_[(byte&0x04) << 1];
-				target[6] = palette_[(byte&0x02) << 2];
-				target[7] = palette_[(byte&0x01) << 3];
-
-				target = reinterpret_cast<uint8_t *>(&palette_tables_.forty2bpp[byte]);
-				target[0] = palette_[((byte&0x80) >> 4) | ((byte&0x08) >> 2)];
-				target[1] = palette_[((byte&0x40) >> 3) | ((byte&0x04) >> 1)];
-
-				target = reinterpret_cast<uint8_t *>(&palette_tables_.eighty4bpp[byte]);
-				target[0] = palette_[((byte&0x80) >> 4) | ((byte&0x20) >> 3) | ((byte&0x08) >> 2) | ((byte&0x02) >> 1)];
-				target[1] = palette_[((byte&0x40) >> 3) | ((byte&0x10) >> 2) | ((byte&0x04) >> 1) | ((byte&0x01) >> 0)];
-			}
+			palette_is_dirty_ = true;
 		}
 		break;
 	}
@@ -87,6 +87,9 @@ class VideoOutput {
 		inline void end_pixel_line();
 		inline void output_pixels(int number_of_cycles);
 		inline void setup_base_address();
+		inline void flush_output();
+		void update_palette();
+		void setup_index_tables();
 
 		int output_position_ = 0;
 
@@ -96,13 +99,20 @@ class VideoOutput {
 		uint16_t start_screen_address_ = 0;
 
 		uint8_t *ram_;
+
+		// Map each screen byte to the palette indices of the pixels it produces in each mode, packed
+		// two to a byte; these don't depend on the palette, which is instead supplied to the CRT.
 		struct {
-			uint32_t forty1bpp[256];
-			uint16_t forty2bpp[256];
-			uint64_t eighty1bpp[256];
-			uint32_t eighty2bpp[256];
-			uint16_t eighty4bpp[256];
-		} palette_tables_;
+			uint16_t forty1bpp[256];
+			uint8_t forty2bpp[256];
+			uint32_t eighty1bpp[256];
+			uint16_t eighty2bpp[256];
+			uint8_t eighty4bpp[256];
+		} index_tables_;
+
+		// Set upon any write to the palette registers; the new palette is passed to the CRT once
+		// all pixels painted under the old have been output.
+		bool palette_is_dirty_ = true;
 
 		// Display generation.
 		uint16_t start_line_address_ = 0;
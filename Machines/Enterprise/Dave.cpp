@@ -8,6 +8,8 @@
 
 #include "Dave.hpp"
 
+#include <algorithm>
+
 using namespace Enterprise::Dave;
 
 // MARK: - Audio generator
@@ -100,42 +102,50 @@ void Audio::update_channel(int c) {
 }
 
 void Audio::get_samples(std::size_t number_of_samples, int16_t *target) {
-	struct Frame {
-		int16_t left, right;
-	} output_level;
-	Frame *target_frames = reinterpret_cast<Frame *>(target);
+	generate_samples<true>(number_of_samples, reinterpret_cast<Frame *>(target));
+}
+
+void Audio::skip_samples(std::size_t number_of_samples) {
+	generate_samples<false>(number_of_samples, nullptr);
+}
+
+template <bool output> void Audio::generate_samples(std::size_t number_of_samples, Frame *target) {
+	// Amplitudes and volume can change only between calls, so tabulate the output level
+	// for every combination of channel outputs upfront. I'm unclear on the details of the
+	// time division multiplexing so, for now, just sum the outputs.
+	Frame levels[16];
+	if constexpr (output) {
+		for(int c = 0; c < 16; c++) {
+			const auto level = [&](int side) {
+				return int16_t(
+					volume_ *
+						(use_direct_output_[side] ?
+							channels_[0].amplitude[side]
+							: (
+								channels_[0].amplitude[side] * (c & 1) +
+								channels_[1].amplitude[side] * ((c >> 1) & 1) +
+								channels_[2].amplitude[side] * ((c >> 2) & 1) +
+								noise_.amplitude[side] * ((c >> 3) & 1)
+						))
+				);
+			};
+			levels[c].left = level(0);
+			levels[c].right = level(1);
+		}
+	}
 
 	size_t c = 0;
 	while(c < number_of_samples) {
-		// I'm unclear on the details of the time division multiplexing so,
-		// for now, just sum the outputs.
-		output_level.left =
-			volume_ *
-				(use_direct_output_[0] ?
-					channels_[0].amplitude[0]
-					: (
-						channels_[0].amplitude[0] * (channels_[0].output & 1) +
-						channels_[1].amplitude[0] * (channels_[1].output & 1) +
-						channels_[2].amplitude[0] * (channels_[2].output & 1) +
-						noise_.amplitude[0] * noise_.final_output
-				));
-
-		output_level.right =
-			volume_ *
-				(use_direct_output_[1] ?
-					channels_[0].amplitude[1]
-					: (
-						channels_[0].amplitude[1] * (channels_[0].output & 1) +
-						channels_[1].amplitude[1] * (channels_[1].output & 1) +
-						channels_[2].amplitude[1] * (channels_[2].output & 1) +
-						noise_.amplitude[1] * noise_.final_output
-				));
-
-		while(global_divider_ && c < number_of_samples) {
-			--global_divider_;
-			target_frames[c] = output_level;
-			++c;
+		const size_t duration = std::min(size_t(global_divider_), number_of_samples - c);
+		if constexpr (output) {
+			std::fill(&target[c], &target[c + duration], levels[
+				(channels_[0].output & 1) |
+				((channels_[1].output & 1) << 1) |
+				((channels_[2].output & 1) << 2) |
+				(noise_.final_output << 3)
+			]);
 		}
+		c += duration;
 
 		global_divider_ = global_divider_reload_;
 		if(!global_divider_) {
@@ -41,10 +41,17 @@ class Audio: public Outputs::Speaker::SampleSource {
 		void set_sample_volume_range(int16_t range);
 		static constexpr bool get_is_stereo() { return true; }	// Dave produces stereo sound.
 		void get_samples(std::size_t number_of_samples, int16_t *target);
+		void skip_samples(std::size_t number_of_samples);
 
 	private:
 		Concurrency::DeferringAsyncTaskQueue &audio_queue_;
 
+		struct Frame {
+			int16_t left, right;
+		};
+		/// Advances by @c number_of_samples, writing them to @c target only if @c output is @c true.
+		template <bool output> void generate_samples(std::size_t number_of_samples, Frame *target);
+
 		// Global divider (i.e. 8MHz/12Mhz switch).
 		uint8_t global_divider_;
 		uint8_t global_divider_reload_ = 2;
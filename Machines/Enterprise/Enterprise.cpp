@@ -73,6 +73,7 @@ template <bool has_disk_controller, bool is_6mhz> class ConcreteMachine:
 	public MachineTypes::AudioProducer,
 	public MachineTypes::MappedKeyboardMachine,
 	public MachineTypes::MediaTarget,
+	public MachineTypes::MemoryReporter,
 	public MachineTypes::ScanProducer,
 	public MachineTypes::TimedMachine,
 	public Utility::TypeRecipient<CharacterMapper> {
@@ -545,6 +546,21 @@ template <bool has_disk_controller, bool is_6mhz> class ConcreteMachine:
 			audio_queue_.perform();
 		}
 
+		// MARK: - MemoryReporter.
+		void report_memory(MachineTypes::MemoryFootprint &footprint) final {
+			using Kind = MachineTypes::MemoryFootprint::Kind;
+			flush();
+			audio_queue_.flush();
+
+			footprint.add("RAM", Kind::RAM, sizeof(ram_));
+			footprint.add("ROM", Kind::ROM, sizeof(exos_) + sizeof(basic_) + sizeof(exdos_rom_) + sizeof(epdos_rom_));
+			footprint.add("Z80", Kind::ProcessorTables, z80_.get_table_footprint());
+			footprint.add("Speaker", Kind::AudioBuffers, speaker_.get_memory_footprint());
+			if constexpr (has_disk_controller) {
+				footprint.add("EXDos", Kind::DiskTracks, exdos_.get_disk_memory_footprint());
+			}
+		}
+
 	private:
 		// MARK: - Memory layout
 		std::array<uint8_t, 256 * 1024> ram_{};
@@ -730,13 +746,21 @@ template <bool has_disk_controller, bool is_6mhz> class ConcreteMachine:
 		std::unique_ptr<Reflection::Struct> get_options() final {
 			auto options = std::make_unique<Options>(Configurable::OptionsType::UserFriendly);
 			options->output = get_video_signal_configurable();
+			options->accuracy = accuracy_;
 			return options;
 		}
 
 		void set_options(const std::unique_ptr<Reflection::Struct> &str) final {
 			const auto options = dynamic_cast<Options *>(str.get());
 			set_video_signal_configurable(options->output);
+
+			accuracy_ = options->accuracy;
+			if constexpr (has_disk_controller) {
+				exdos_.set_accuracy(accuracy_);
+			}
 		}
+
+		Configurable::Accuracy accuracy_ = Configurable::Accuracy::CycleExact;
 };
 
 }
@@ -29,13 +29,16 @@ class Machine {
 		static Machine *Enterprise(const Analyser::Static::Target *target, const ROMMachine::ROMFetcher &rom_fetcher);
 
 		/// Defines the runtime options available for an Enterprise.
-		class Options: public Reflection::StructImpl<Options>, public Configurable::DisplayOption<Options> {
+		class Options: public Reflection::StructImpl<Options>, public Configurable::DisplayOption<Options>, public Configurable::AccuracyOption<Options> {
 			friend Configurable::DisplayOption<Options>;
+			friend Configurable::AccuracyOption<Options>;
 			public:
 				Options(Configurable::OptionsType type) :
-					Configurable::DisplayOption<Options>(type == Configurable::OptionsType::UserFriendly ? Configurable::Display::RGB : Configurable::Display::CompositeColour) {
+					Configurable::DisplayOption<Options>(type == Configurable::OptionsType::UserFriendly ? Configurable::Display::RGB : Configurable::Display::CompositeColour),
+					Configurable::AccuracyOption<Options>(type == Configurable::OptionsType::UserFriendly ? Configurable::Accuracy::Fast : Configurable::Accuracy::CycleExact) {
 					if(needs_declare()) {
 						declare_display_option();
+						declare_accuracy_option();
 						limit_enum(&output, Configurable::Display::RGB, Configurable::Display::CompositeColour, Configurable::Display::CompositeMonochrome, -1);
 					}
 				}
@@ -8,6 +8,7 @@
 
 #include "Nick.hpp"
 
+#include <array>
 #include <cstdio>
 
 namespace  {
@@ -42,6 +43,15 @@ uint16_t mapped_colour(uint8_t source) {
 	return *reinterpret_cast<const uint16_t *>(parts);
 }
 
+/// Provides the result of mapped_colour for every possible source byte.
+const auto mapped_colours = [] {
+	std::array<uint16_t, 256> colours;
+	for(size_t c = 0; c < colours.size(); c++) {
+		colours[c] = mapped_colour(uint8_t(c));
+	}
+	return colours;
+} ();
+
 }
 
 using namespace Enterprise;
@@ -62,14 +72,14 @@ void Nick::write(uint16_t address, uint8_t value) {
 		case 0:
 			// Ignored: everything to do with external colour.
 			for(int c = 0; c < 8; c++) {
-				palette_[c + 8] = mapped_colour(uint8_t(((value & 0x1f) << 3) + c));
+				palette_[c + 8] = mapped_colours[((value & 0x1f) << 3) + c];
 			}
 		break;
 		case 1:
 			if(output_type_ == OutputType::Border) {
 				set_output_type(OutputType::Border, true);
 			}
-			border_colour_ = mapped_colour(value);
+			border_colour_ = mapped_colours[value];
 		break;
 		case 2:
 			line_parameter_base_ = uint16_t((line_parameter_base_ & 0xf000) | (value << 4));
@@ -192,6 +202,8 @@ void Nick::run_for(Cycles duration) {
 							break;
 						}
 
+						output_function_ = output_function(mode_, bpp_);
+
 						vres_ = ram_[line_parameter_pointer_ + 1] & 0x10;
 						reload_line_parameter_pointer_ = ram_[line_parameter_pointer_ + 1] & 0x01;
 					break;
@@ -303,8 +315,8 @@ void Nick::run_for(Cycles duration) {
 				if(should_reload_line_parameters_ && window < 8) {
 					const int base = (window - 4) << 1;
 					assert(base < 7);
-					palette_[base] = mapped_colour(ram_[line_parameter_pointer_ + base + 8]);
-					palette_[base + 1] = mapped_colour(ram_[line_parameter_pointer_ + base + 9]);
+					palette_[base] = mapped_colours[ram_[line_parameter_pointer_ + base + 8]];
+					palette_[base + 1] = mapped_colours[ram_[line_parameter_pointer_ + base + 9]];
 					last_read_ = ram_[line_parameter_pointer_ + base + 9];
 				}
 
@@ -323,23 +335,6 @@ void Nick::run_for(Cycles duration) {
 					if(window < right_margin_) next_event = std::min(next_event, right_margin_);
 
 					if(is_sync_or_pixels_) {
-
-#define DispatchBpp(func) \
-	switch(bpp_) {	\
-		default:	\
-		case 1: func(1)(pixel_pointer_, output_duration);	break;	\
-		case 2: func(2)(pixel_pointer_, output_duration);	break;	\
-		case 4: func(4)(pixel_pointer_, output_duration);	break;	\
-		case 8: func(8)(pixel_pointer_, output_duration);	break;	\
-	}
-
-#define pixel(x) output_pixel<x, false>
-#define lpixel(x) output_pixel<x, true>
-#define ch256(x) output_character<x, 8>
-#define ch128(x) output_character<x, 7>
-#define ch64(x) output_character<x, 6>
-#define attr(x) output_attributed<x>
-
 						int columns_remaining = next_event - window;
 						while(columns_remaining) {
 							if(!pixel_pointer_) {
@@ -352,15 +347,7 @@ void Nick::run_for(Cycles duration) {
 							if(allocated_pointer_) {
 								const int output_duration = std::min(columns_remaining, int(allocated_pointer_ + allocation_size - pixel_pointer_) / column_size_);
 
-								switch(mode_) {
-									default:
-									case Mode::Pixel:	DispatchBpp(pixel);		break;
-									case Mode::LPixel:	DispatchBpp(lpixel);	break;
-									case Mode::CH256:	DispatchBpp(ch256);		break;
-									case Mode::CH128:	DispatchBpp(ch128);		break;
-									case Mode::CH64:	DispatchBpp(ch64);		break;
-									case Mode::Attr:	DispatchBpp(attr);		break;
-								}
+								(this->*output_function_)(pixel_pointer_, output_duration);
 
 								pixel_pointer_ += output_duration * column_size_;
 								output_duration_ += output_duration;
@@ -375,14 +362,6 @@ void Nick::run_for(Cycles duration) {
 								columns_remaining = 0;
 							}
 						}
-
-#undef attr
-#undef ch64
-#undef ch128
-#undef ch256
-#undef pixel
-#undef lpixel
-#undef DispatchBpp
 					} else {
 						output_duration_ += next_event - window;
 						add_window(next_event - window);
@@ -502,6 +481,42 @@ Outputs::Display::DisplayType Nick::get_display_type() const {
 
 // MARK: - Specific pixel outputters.
 
+Nick::OutputFunction Nick::output_function(Mode mode, int bpp) {
+#define DispatchBpp(func) \
+	switch(bpp) {	\
+		default:	\
+		case 1: return &Nick::func(1);	\
+		case 2: return &Nick::func(2);	\
+		case 4: return &Nick::func(4);	\
+		case 8: return &Nick::func(8);	\
+	}
+
+#define pixel(x) output_pixel<x, false>
+#define lpixel(x) output_pixel<x, true>
+#define ch256(x) output_character<x, 8>
+#define ch128(x) output_character<x, 7>
+#define ch64(x) output_character<x, 6>
+#define attr(x) output_attributed<x>
+
+	switch(mode) {
+		default:
+		case Mode::Pixel:	DispatchBpp(pixel);
+		case Mode::LPixel:	DispatchBpp(lpixel);
+		case Mode::CH256:	DispatchBpp(ch256);
+		case Mode::CH128:	DispatchBpp(ch128);
+		case Mode::CH64:	DispatchBpp(ch64);
+		case Mode::Attr:	DispatchBpp(attr);
+	}
+
+#undef attr
+#undef ch64
+#undef ch128
+#undef ch256
+#undef pixel
+#undef lpixel
+#undef DispatchBpp
+}
+
 #define output1bpp(x)	\
 	target[0] = palette[(x & 0x80) >> 7];	\
 	target[1] = palette[(x & 0x40) >> 6];	\
@@ -526,7 +541,7 @@ Outputs::Display::DisplayType Nick::get_display_type() const {
 	target += 2
 
 #define output8bpp(x)	\
-	target[0] = mapped_colour(x);	\
+	target[0] = mapped_colours[x];	\
 	++target
 
 template <int bpp, bool is_lpixel> void Nick::output_pixel(uint16_t *target, int columns) const {
@@ -118,6 +118,12 @@ class Nick {
 		template <int bpp, bool is_lpixel> void output_pixel(uint16_t *target, int columns) const;
 		template <int bpp, int index_bits> void output_character(uint16_t *target, int columns) const;
 		template <int bpp> void output_attributed(uint16_t *target, int columns) const;
+
+		// The outputter for the current mode line, selected once as its mode byte is read
+		// so that pixel output needn't reconsider mode and depth.
+		using OutputFunction = void (Nick::*)(uint16_t *, int) const;
+		static OutputFunction output_function(Mode, int bpp);
+		OutputFunction output_function_ = &Nick::output_pixel<1, false>;
 };
 
 
@@ -10,6 +10,7 @@
 #define JoystickMachine_hpp
 
 #include "../Inputs/Joystick.hpp"
+#include <memory>
 #include <vector>
 
 namespace MachineTypes {
@@ -13,6 +13,7 @@
 #include "DiskROM.hpp"
 #include "Keyboard.hpp"
 #include "ROMSlotHandler.hpp"
+#include "State.hpp"
 
 #include "../../Analyser/Static/MSX/Cartridge.hpp"
 #include "Cartridges/ASCII8kb.hpp"
@@ -137,6 +138,8 @@ class ConcreteMachine:
 	public MachineTypes::MediaTarget,
 	public MachineTypes::MappedKeyboardMachine,
 	public MachineTypes::JoystickMachine,
+	public MachineTypes::MemoryReporter,
+	public MachineTypes::StateProducer,
 	public Configurable::Device,
 	public MemoryMap,
 	public ClockingHint::Observer,
@@ -341,6 +344,9 @@ class ConcreteMachine:
 						break;
 					}
 				}
+
+				// Refresh the record of paged handlers.
+				page_memory(paged_memory_);
 			}
 
 			if(!media.tapes.empty()) {
@@ -414,6 +420,7 @@ class ConcreteMachine:
 				write_pointers_[c] = memory_slots_[value & 3].write_pointers[c];
 				read_pointers_[c+1] = memory_slots_[value & 3].read_pointers[c+1];
 				write_pointers_[c+1] = memory_slots_[value & 3].write_pointers[c+1];
+				paged_handlers_[c] = paged_handlers_[c+1] = memory_slots_[value & 3].handler ? &memory_slots_[value & 3] : nullptr;
 				value >>= 2;
 			}
 			set_use_fast_tape();
@@ -429,10 +436,7 @@ class ConcreteMachine:
 				z80_.set_interrupt_line(vdp_->get_interrupt_line(), vdp_.last_sequence_point_overrun());
 			}
 			time_since_ay_update_ += total_length;
-			memory_slots_[0].cycles_since_update += total_length;
-			memory_slots_[1].cycles_since_update += total_length;
-			memory_slots_[2].cycles_since_update += total_length;
-			memory_slots_[3].cycles_since_update += total_length;
+			slot_clock_ += total_length;
 
 			if(cycle.is_terminal()) {
 				uint16_t address = cycle.address ? *cycle.address : 0x0000;
@@ -506,20 +510,19 @@ class ConcreteMachine:
 						if(read_pointers_[address >> 13]) {
 							*cycle.value = read_pointers_[address >> 13][address & 8191];
 						} else {
-							int slot_hit = (paged_memory_ >> ((address >> 14) * 2)) & 3;
-							memory_slots_[slot_hit].handler->run_for(memory_slots_[slot_hit].cycles_since_update.flush<HalfCycles>());
-							*cycle.value = memory_slots_[slot_hit].handler->read(address);
+							MemorySlots &slot = *paged_handlers_[address >> 13];
+							slot.update(slot_clock_);
+							*cycle.value = slot.handler->read(address);
 						}
 					break;
 
 					case CPU::Z80::PartialMachineCycle::Write: {
 						write_pointers_[address >> 13][address & 8191] = *cycle.value;
 
-						int slot_hit = (paged_memory_ >> ((address >> 14) * 2)) & 3;
-						if(memory_slots_[slot_hit].handler) {
+						if(MemorySlots *const slot = paged_handlers_[address >> 13]) {
 							update_audio();
-							memory_slots_[slot_hit].handler->run_for(memory_slots_[slot_hit].cycles_since_update.flush<HalfCycles>());
-							memory_slots_[slot_hit].handler->write(address, *cycle.value, read_pointers_[pc_address_ >> 13] != memory_slots_[0].read_pointers[pc_address_ >> 13]);
+							slot->update(slot_clock_);
+							slot->handler->write(address, *cycle.value, read_pointers_[pc_address_ >> 13] != memory_slots_[0].read_pointers[pc_address_ >> 13]);
 						}
 					} break;
 
@@ -621,6 +624,24 @@ class ConcreteMachine:
 			audio_queue_.perform();
 		}
 
+		void report_memory(MachineTypes::MemoryFootprint &footprint) final {
+			using Kind = MachineTypes::MemoryFootprint::Kind;
+			flush();
+			audio_queue_.flush();
+
+			size_t rom_size = 0;
+			for(const auto &slot: memory_slots_) rom_size += slot.source.size();
+
+			footprint.add("RAM", Kind::RAM, sizeof(ram_) + sizeof(scratch_) + sizeof(unpopulated_));
+			footprint.add("ROM", Kind::ROM, rom_size);
+			footprint.add("VDP", Kind::RAM, vdp_.last_valid()->get_video_ram_size());
+			footprint.add("Z80", Kind::ProcessorTables, z80_.get_table_footprint());
+			footprint.add("Speaker", Kind::AudioBuffers, speaker_.get_memory_footprint());
+
+			DiskROM *const disk_rom = get_disk_rom();
+			if(disk_rom) footprint.add("Disk ROM", Kind::DiskTracks, disk_rom->get_disk_memory_footprint());
+		}
+
 		void set_keyboard_line(int line) {
 			selected_key_line_ = line;
 		}
@@ -643,11 +664,55 @@ class ConcreteMachine:
 			return &keyboard_mapper_;
 		}
 
+		// MARK: - StateProducer.
+
+		std::unique_ptr<Reflection::Struct> get_state() final {
+			// Cartridge and disk hardware doesn't yet provide state, so machines with
+			// either can't be captured.
+			if(has_slot_handlers()) return nullptr;
+
+			// Bring everything up to date, including the audio thread, so that
+			// there's no work outstanding that predates the state.
+			flush();
+			audio_queue_.flush();
+
+			auto state = std::make_unique<State>();
+			state->z80 = CPU::Z80::State(z80_);
+			state->vdp = TI::TMS::State(*vdp_.last_valid());
+			state->ay = GI::AY38910::State(ay_);
+			state->ppi = Intel::i8255::State(i8255_);
+			state->ram.assign(std::begin(ram_), std::end(ram_));
+			return state;
+		}
+
+		bool set_state(const Reflection::Struct &state) final {
+			const auto msx_state = dynamic_cast<const State *>(&state);
+			if(!msx_state || has_slot_handlers()) return false;
+
+			flush();
+			audio_queue_.flush();
+
+			msx_state->z80.apply(z80_);
+			msx_state->ay.apply(ay_);
+
+			// Obtain the VDP via the actor's operator-> so that it
+			// will reconsider its next sequence point afterwards.
+			msx_state->vdp.apply(*vdp_.operator->());
+
+			// Port writes reapply paging, the keyboard line, the tape motor and the key click.
+			memcpy(ram_, msx_state->ram.data(), std::min(sizeof(ram_), msx_state->ram.size()));
+			msx_state->ppi.apply(i8255_);
+
+			z80_.set_interrupt_line(vdp_->get_interrupt_line());
+			return true;
+		}
+
 		// MARK: - Configuration options.
 		std::unique_ptr<Reflection::Struct> get_options() final {
 			auto options = std::make_unique<Options>(Configurable::OptionsType::UserFriendly);
 			options->output = get_video_signal_configurable();
 			options->quickload = allow_fast_tape_;
+			options->accuracy = accuracy_;
 			return options;
 		}
 
@@ -656,8 +721,14 @@ class ConcreteMachine:
 			set_video_signal_configurable(options->output);
 			allow_fast_tape_ = options->quickload;
 			set_use_fast_tape();
+
+			accuracy_ = options->accuracy;
+			DiskROM *const disk_rom = get_disk_rom();
+			if(disk_rom) disk_rom->set_accuracy(accuracy_);
 		}
 
+		Configurable::Accuracy accuracy_ = Configurable::Accuracy::CycleExact;
+
 		// MARK: - Sleeper
 		void set_component_prefers_clocking(ClockingHint::Source *, ClockingHint::Preference) final {
 			tape_player_is_sleeping_ = tape_player_.preferred_clocking() == ClockingHint::Preference::None;
@@ -679,6 +750,13 @@ class ConcreteMachine:
 		}
 
 	private:
+		bool has_slot_handlers() const {
+			for(const auto &slot: memory_slots_) {
+				if(slot.handler) return true;
+			}
+			return false;
+		}
+
 		DiskROM *get_disk_rom() {
 			return dynamic_cast<DiskROM *>(memory_slots_[2].handler.get());
 		}
@@ -774,12 +852,24 @@ class ConcreteMachine:
 				wrapping_strategy = handler->wrapping_strategy();
 			}
 
+			/// Brings the handler up to @c clock.
+			void update(HalfCycles clock) {
+				handler->run_for(clock - last_update);
+				last_update = clock;
+			}
+
 			std::unique_ptr<ROMSlotHandler> handler;
 			std::vector<uint8_t> source;
-			HalfCycles cycles_since_update;
+			HalfCycles last_update;
 			ROMSlotHandler::WrappingStrategy wrapping_strategy = ROMSlotHandler::WrappingStrategy::Repeat;
 		} memory_slots_[4];
 
+		/// Time as seen by slot handlers, each of which records when it was last updated.
+		HalfCycles slot_clock_;
+
+		/// The slot paged into each 8kb region, if that slot has a handler; @c nullptr otherwise.
+		MemorySlots *paged_handlers_[8]{};
+
 		uint8_t ram_[65536];
 		uint8_t scratch_[8192];
 		uint8_t unpopulated_[8192];
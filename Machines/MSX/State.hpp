@@ -0,0 +1,43 @@
+//
+//  State.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 14/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#ifndef MSX_State_hpp
+#define MSX_State_hpp
+
+#include "../../Reflection/Struct.hpp"
+#include "../../Processors/Z80/State/State.hpp"
+
+#include "../../Components/9918/9918.hpp"
+#include "../../Components/8255/i8255.hpp"
+#include "../../Components/AY38910/AY38910.hpp"
+
+namespace MSX {
+
+struct State: public Reflection::StructImpl<State> {
+	CPU::Z80::State z80;
+	TI::TMS::State vdp;
+	GI::AY38910::State ay;
+	Intel::i8255::State ppi;
+
+	// The 64kb of RAM in slot 3, in linear order.
+	std::vector<uint8_t> ram;
+
+	State() {
+		if(needs_declare()) {
+			DeclareField(z80);
+			DeclareField(vdp);
+			DeclareField(ay);
+			DeclareField(ppi);
+			DeclareField(ram);
+		}
+	}
+};
+
+}
+
+#endif /* MSX_State_hpp */
@@ -18,6 +18,7 @@
 #include "JoystickMachine.hpp"
 #include "KeyboardMachine.hpp"
 #include "MediaTarget.hpp"
+#include "MemoryReporter.hpp"
 #include "MouseMachine.hpp"
 #include "ScanProducer.hpp"
 #include "StateProducer.hpp"
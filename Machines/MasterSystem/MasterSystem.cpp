@@ -85,6 +85,7 @@ class ConcreteMachine:
 	public MachineTypes::AudioProducer,
 	public MachineTypes::KeyboardMachine,
 	public MachineTypes::JoystickMachine,
+	public MachineTypes::MemoryReporter,
 	public Configurable::Device,
 	public Inputs::Keyboard::Delegate {
 
@@ -264,7 +265,7 @@ class ConcreteMachine:
 							break;
 							case 0x80: case 0x81:
 								*cycle.value = vdp_->read(address);
-								z80_.set_interrupt_line(vdp_->get_interrupt_line());
+								z80_.set_interrupt_line(vdp_.last_valid()->get_interrupt_line());
 							break;
 							case 0xc0: {
 								if(memory_control_ & 0x4) {
@@ -326,8 +327,15 @@ class ConcreteMachine:
 								sn76489_.write(*cycle.value);
 							break;
 							case 0x80: case 0x81:	// i.e. ports 0x80–0xbf.
+								// Writes that only latch needn't synchronise the VDP; nor can they
+								// affect its interrupt output.
+								if(vdp_.last_valid()->write_is_latch_only(address)) {
+									vdp_.last_valid()->write(address, *cycle.value);
+									break;
+								}
+
 								vdp_->write(address, *cycle.value);
-								z80_.set_interrupt_line(vdp_->get_interrupt_line());
+								z80_.set_interrupt_line(vdp_.last_valid()->get_interrupt_line());
 							break;
 							case 0xc1: case 0xc0:	// i.e. ports 0xc0–0xff.
 								if(has_fm_audio_) {
@@ -388,6 +396,18 @@ class ConcreteMachine:
 			audio_queue_.perform();
 		}
 
+		void report_memory(MachineTypes::MemoryFootprint &footprint) final {
+			using Kind = MachineTypes::MemoryFootprint::Kind;
+			flush();
+			audio_queue_.flush();
+
+			footprint.add("RAM", Kind::RAM, sizeof(ram_));
+			footprint.add("ROM", Kind::ROM, sizeof(bios_) + cartridge_.size());
+			footprint.add("VDP", Kind::RAM, vdp_.last_valid()->get_video_ram_size());
+			footprint.add("Z80", Kind::ProcessorTables, z80_.get_table_footprint());
+			footprint.add("Speaker", Kind::AudioBuffers, speaker_.get_memory_footprint());
+		}
+
 		const std::vector<std::unique_ptr<Inputs::Joystick>> &get_joysticks() final {
 			return joysticks_;
 		}
@@ -0,0 +1,105 @@
+//
+//  MemoryReporter.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 14/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#ifndef MemoryReporter_h
+#define MemoryReporter_h
+
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace MachineTypes {
+
+/*!
+	A tally of the host memory held by an emulated machine and its outputs, grouped by the component that holds it.
+*/
+struct MemoryFootprint {
+	enum class Kind {
+		/// Storage for emulated RAM, including video and other device-local RAM.
+		RAM,
+		/// Storage for ROM images.
+		ROM,
+		/// Tables built by a processor or other component to speed up emulation.
+		ProcessorTables,
+		/// Disk tracks decoded and held in memory.
+		DiskTracks,
+		/// Audio sample buffers.
+		AudioBuffers,
+		/// Video buffers and textures, whether in host or GPU memory.
+		VideoBuffers,
+		/// Anything else.
+		Other,
+	};
+
+	struct Entry {
+		std::string component;
+		Kind kind;
+		size_t bytes;
+	};
+	std::vector<Entry> entries;
+
+	/// Records that @c component holds @c bytes of storage of kind @c kind; zero-sized entries are ignored.
+	void add(const std::string &component, Kind kind, size_t bytes) {
+		if(!bytes) return;
+		entries.push_back(Entry{component, kind, bytes});
+	}
+
+	/// @returns The total number of bytes recorded.
+	size_t total() const {
+		size_t result = 0;
+		for(const auto &entry: entries) result += entry.bytes;
+		return result;
+	}
+
+	/// @returns The total number of bytes recorded of kind @c kind.
+	size_t total(Kind kind) const {
+		size_t result = 0;
+		for(const auto &entry: entries) {
+			if(entry.kind == kind) result += entry.bytes;
+		}
+		return result;
+	}
+
+	static const char *name(Kind kind) {
+		switch(kind) {
+			case Kind::RAM:				return "RAM";
+			case Kind::ROM:				return "ROM";
+			case Kind::ProcessorTables:	return "processor tables";
+			case Kind::DiskTracks:		return "disk tracks";
+			case Kind::AudioBuffers:	return "audio buffers";
+			case Kind::VideoBuffers:	return "video buffers";
+			default:					return "other";
+		}
+	}
+
+	/// @returns A human-readable list of all entries, one per line, followed by the total.
+	std::string summary() const {
+		std::string result;
+		char line[160];
+		for(const auto &entry: entries) {
+			snprintf(line, sizeof(line), "%s (%s): %zu KiB\n", entry.component.c_str(), name(entry.kind), (entry.bytes + 1023) >> 10);
+			result += line;
+		}
+		snprintf(line, sizeof(line), "Total: %zu KiB\n", (total() + 1023) >> 10);
+		return result + line;
+	}
+};
+
+/*!
+	A memory reporter is any machine that can describe the host memory it has allocated, e.g. so
+	that a host can profile machines or budget for running several at once.
+*/
+struct MemoryReporter {
+	/// Adds to @c footprint entries for all storage held by this machine.
+	virtual void report_memory(MemoryFootprint &footprint) = 0;
+};
+
+}
+
+#endif /* MemoryReporter_h */
@@ -270,6 +270,7 @@ template <Analyser::Static::Oric::Target::DiskInterface disk_interface, CPU::MOS
 	public MachineTypes::JoystickMachine,
 	public MachineTypes::MediaTarget,
 	public MachineTypes::MappedKeyboardMachine,
+	public MachineTypes::MemoryReporter,
 	public Configurable::Device,
 	public CPU::MOS6502::BusHandler,
 	public MOS::MOS6522::IRQDelegatePortHandler::Delegate,
@@ -476,8 +477,8 @@ template <Analyser::Static::Oric::Target::DiskInterface disk_interface, CPU::MOS
 			} else {
 				if((address & 0xff00) == 0x0300) {
 					if(address < 0x0310 || (disk_interface == DiskInterface::None)) {
-						if(!isWriteOperation(operation)) *value = via_.read(address);
-						else via_.write(address, *value);
+						if(!isWriteOperation(operation)) *value = via_->read(address);
+						else via_->write(address, *value);
 					} else {
 						switch(disk_interface) {
 							default: break;
@@ -543,7 +544,7 @@ template <Analyser::Static::Oric::Target::DiskInterface disk_interface, CPU::MOS
 				if(!string_serialiser_->advance()) string_serialiser_.reset();
 			}
 
-			via_.run_for(Cycles(1));
+			via_ += Cycles(1);
 			tape_player_.run_for(Cycles(1));
 			switch(disk_interface) {
 				default: break;
@@ -580,10 +581,29 @@ template <Analyser::Static::Oric::Target::DiskInterface disk_interface, CPU::MOS
 
 		forceinline void flush() {
 			video_.flush();
-			via_.flush();
+			via_->flush();
 			diskii_.flush();
 		}
 
+		// to satisfy MachineTypes::MemoryReporter
+		void report_memory(MachineTypes::MemoryFootprint &footprint) final {
+			using Kind = MachineTypes::MemoryFootprint::Kind;
+			flush();
+			audio_queue_.flush();
+
+			footprint.add("RAM", Kind::RAM, sizeof(ram_));
+			footprint.add("ROM", Kind::ROM, rom_.size() + disk_rom_.size() + pravetz_rom_.size());
+			footprint.add("6502", Kind::ProcessorTables, m6502_.get_table_footprint());
+			footprint.add("Speaker", Kind::AudioBuffers, speaker_.get_memory_footprint());
+			switch(disk_interface) {
+				default: break;
+				case DiskInterface::BD500:		footprint.add("BD-500", Kind::DiskTracks, bd500_.get_disk_memory_footprint());			break;
+				case DiskInterface::Jasmin:		footprint.add("Jasmin", Kind::DiskTracks, jasmin_.get_disk_memory_footprint());			break;
+				case DiskInterface::Microdisc:	footprint.add("Microdisc", Kind::DiskTracks, microdisc_.get_disk_memory_footprint());	break;
+				case DiskInterface::Pravetz:	footprint.add("Disk II", Kind::DiskTracks, diskii_->get_disk_memory_footprint());		break;
+			}
+		}
+
 		// to satisfy CRTMachine::Machine
 		void set_scan_target(Outputs::Display::ScanTarget *scan_target) final {
 			video_.last_valid()->set_scan_target(scan_target);
@@ -617,7 +637,7 @@ template <Analyser::Static::Oric::Target::DiskInterface disk_interface, CPU::MOS
 		// to satisfy Storage::Tape::BinaryTapePlayer::Delegate
 		void tape_did_change_input(Storage::Tape::BinaryTapePlayer *tape_player) final {
 			// set CB1
-			via_.set_control_line_input(MOS::MOS6522::Port::B, MOS::MOS6522::Line::One, !tape_player->get_input());
+			via_->set_control_line_input(MOS::MOS6522::Port::B, MOS::MOS6522::Line::One, !tape_player->get_input());
 		}
 
 		// for Utility::TypeRecipient::Delegate
@@ -663,6 +683,7 @@ template <Analyser::Static::Oric::Target::DiskInterface disk_interface, CPU::MOS
 			auto options = std::make_unique<Options>(Configurable::OptionsType::UserFriendly);
 			options->output = get_video_signal_configurable();
 			options->quickload = use_fast_tape_hack_;
+			options->accuracy = accuracy_;
 			return options;
 		}
 
@@ -670,8 +691,18 @@ template <Analyser::Static::Oric::Target::DiskInterface disk_interface, CPU::MOS
 			const auto options = dynamic_cast<Options *>(str.get());
 			set_video_signal_configurable(options->output);
 			set_use_fast_tape_hack(options->quickload);
+
+			accuracy_ = options->accuracy;
+			switch(disk_interface) {
+				default: break;
+				case DiskInterface::BD500:		bd500_.set_accuracy(accuracy_);		break;
+				case DiskInterface::Jasmin:		jasmin_.set_accuracy(accuracy_);	break;
+				case DiskInterface::Microdisc:	microdisc_.set_accuracy(accuracy_);	break;
+			}
 		}
 
+		Configurable::Accuracy accuracy_ = Configurable::Accuracy::CycleExact;
+
 		void set_activity_observer(Activity::Observer *observer) final {
 			switch(disk_interface) {
 				default: break;
@@ -719,7 +750,7 @@ template <Analyser::Static::Oric::Target::DiskInterface disk_interface, CPU::MOS
 		bool use_fast_tape_hack_ = false;
 
 		VIAPortHandler via_port_handler_;
-		MOS::MOS6522::MOS6522<VIAPortHandler> via_;
+		JustInTimeActor<MOS::MOS6522::MOS6522<VIAPortHandler>> via_;
 		Keyboard keyboard_;
 
 		// the Microdisc, if in use.
@@ -743,7 +774,7 @@ template <Analyser::Static::Oric::Target::DiskInterface disk_interface, CPU::MOS
 
 		// Helper to discern current IRQ state
 		inline void set_interrupt_line() {
-			bool irq_line = via_.get_interrupt_line();
+			bool irq_line = via_.last_valid()->get_interrupt_line();
 
 			// The Microdisc directly provides an interrupt line.
 			if constexpr (disk_interface == DiskInterface::Microdisc) {
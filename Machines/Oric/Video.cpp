@@ -9,6 +9,8 @@
 #include "Video.hpp"
 
 #include <algorithm>
+#include <array>
+#include <cstring>
 
 //#define SUPPLY_COMPOSITE
 
@@ -21,6 +23,26 @@ namespace {
 	const unsigned int PAL60VSyncEndPosition = 238*64;
 	const unsigned int PAL50Period = 312*64;
 	const unsigned int PAL60Period = 262*64;
+
+	/// Maps six bits of pixels to bytes in output order, each being 0xff if the pixel is set
+	/// and 0x00 otherwise. These are used to select between paper and ink for all six
+	/// output pixels at once.
+	const auto pixel_masks = [] {
+		std::array<uint64_t, 64> masks{};
+		for(size_t c = 0; c < masks.size(); c++) {
+			uint8_t bytes[8]{};
+			for(int bit = 0; bit < 6; bit++) {
+				bytes[bit] = (c & (0x20 >> bit)) ? 0xff : 0x00;
+			}
+			memcpy(&masks[c], bytes, sizeof(bytes));
+		}
+		return masks;
+	} ();
+
+	/// @returns @c colour repeated in every byte.
+	constexpr uint64_t repeated(uint8_t colour) {
+		return colour * 0x0101'0101'0101'0101;
+	}
 }
 
 VideoOutput::VideoOutput(uint8_t *memory) :
@@ -173,16 +195,10 @@ void VideoOutput::run_for(const Cycles cycles) {
 
 				if(control_byte & 0x60) {
 					if(data_type_ == Outputs::Display::InputDataType::Red1Green1Blue1 && rgb_pixel_target_) {
-						const uint8_t colours[2] = {
-							uint8_t(paper_ ^ inverse_mask),
-							uint8_t(ink_ ^ inverse_mask)
-						};
-						rgb_pixel_target_[0] = colours[(pixels >> 5)&1];
-						rgb_pixel_target_[1] = colours[(pixels >> 4)&1];
-						rgb_pixel_target_[2] = colours[(pixels >> 3)&1];
-						rgb_pixel_target_[3] = colours[(pixels >> 2)&1];
-						rgb_pixel_target_[4] = colours[(pixels >> 1)&1];
-						rgb_pixel_target_[5] = colours[(pixels >> 0)&1];
+						const uint64_t paper = repeated(paper_ ^ inverse_mask);
+						const uint64_t ink = repeated(ink_ ^ inverse_mask);
+						const uint64_t output = paper ^ ((paper ^ ink) & pixel_masks[pixels & 0x3f]);
+						memcpy(rgb_pixel_target_, &output, 6);
 					} else if(composite_pixel_target_) {
 						const uint32_t colours[2] = {
 							colour_forms_[paper_ ^ inverse_mask],
@@ -233,9 +249,8 @@ void VideoOutput::run_for(const Cycles cycles) {
 					}
 
 					if(data_type_ == Outputs::Display::InputDataType::Red1Green1Blue1 && rgb_pixel_target_) {
-						rgb_pixel_target_[0] = rgb_pixel_target_[1] =
-						rgb_pixel_target_[2] = rgb_pixel_target_[3] =
-						rgb_pixel_target_[4] = rgb_pixel_target_[5] = paper_ ^ inverse_mask;
+						const uint64_t paper = repeated(paper_ ^ inverse_mask);
+						memcpy(rgb_pixel_target_, &paper, 6);
 					} else if(composite_pixel_target_) {
 						composite_pixel_target_[0] = composite_pixel_target_[1] =
 						composite_pixel_target_[2] = composite_pixel_target_[3] =
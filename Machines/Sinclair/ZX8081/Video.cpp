@@ -9,6 +9,8 @@
 #include "Video.hpp"
 
 #include <algorithm>
+#include <array>
+#include <cstring>
 
 using namespace Sinclair::ZX8081;
 
@@ -20,6 +22,24 @@ namespace {
 */
 const std::size_t StandardAllocationSize = 320;
 
+/*!
+	Maps each video byte to its eight output pixels, most significant first, with any
+	non-zero value acting as white.
+*/
+const auto serialised_bytes = [] {
+	std::array<uint64_t, 256> serialised{};
+	for(size_t byte = 0; byte < serialised.size(); byte++) {
+		uint8_t pixels[8];
+		uint8_t mask = 0x80;
+		for(int c = 0; c < 8; c++) {
+			pixels[c] = uint8_t(byte & mask);
+			mask >>= 1;
+		}
+		memcpy(&serialised[byte], pixels, sizeof(pixels));
+	}
+	return serialised;
+} ();
+
 }
 
 Video::Video() :
@@ -97,11 +117,7 @@ void Video::output_byte(uint8_t byte) {
 		}
 
 		// Convert to one-byte-per-pixel where any non-zero value will act as white.
-		uint8_t mask = 0x80;
-		for(int c = 0; c < 8; c++) {
-			line_data_pointer_[c] = byte & mask;
-			mask >>= 1;
-		}
+		memcpy(line_data_pointer_, &serialised_bytes[byte], 8);
 		line_data_pointer_ += 8;
 	}
 }
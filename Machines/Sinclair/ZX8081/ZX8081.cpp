@@ -57,6 +57,7 @@ template<bool is_zx81> class ConcreteMachine:
 	public MachineTypes::AudioProducer,
 	public MachineTypes::MediaTarget,
 	public MachineTypes::MappedKeyboardMachine,
+	public MachineTypes::MemoryReporter,
 	public Configurable::Device,
 	public Utility::TypeRecipient<CharacterMapper>,
 	public CPU::Z80::BusHandler,
@@ -300,6 +301,19 @@ template<bool is_zx81> class ConcreteMachine:
 			}
 		}
 
+		void report_memory(MachineTypes::MemoryFootprint &footprint) final {
+			using Kind = MachineTypes::MemoryFootprint::Kind;
+			flush();
+			audio_queue_.flush();
+
+			footprint.add("RAM", Kind::RAM, ram_.size());
+			footprint.add("ROM", Kind::ROM, rom_.size());
+			footprint.add("Z80", Kind::ProcessorTables, z80_.get_table_footprint());
+			if constexpr (is_zx81) {
+				footprint.add("Speaker", Kind::AudioBuffers, speaker_.get_memory_footprint());
+			}
+		}
+
 		void set_scan_target(Outputs::Display::ScanTarget *scan_target) final {
 			video_.set_scan_target(scan_target);
 		}
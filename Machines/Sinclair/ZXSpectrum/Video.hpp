@@ -15,6 +15,9 @@
 #include "../../../Reflection/Struct.hpp"
 
 #include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
 
 namespace Sinclair {
 namespace ZXSpectrum {
@@ -169,19 +172,12 @@ template <Timing timing> class Video {
 		const uint8_t pixels =														\
 			uint8_t(last_fetches_[n] ^ masks[flash_mask_ & (last_fetches_[n+1] >> 7)]);	\
 			\
-		const uint8_t colours[2] = {													\
-			palette[(last_fetches_[n+1] & 0x78) >> 3],									\
-			palette[((last_fetches_[n+1] & 0x40) >> 3) | (last_fetches_[n+1] & 0x07)],	\
-		};	\
+		const uint64_t paper = palette[(last_fetches_[n+1] & 0x78) >> 3] * 0x0101010101010101;						\
+		const uint64_t ink = palette[((last_fetches_[n+1] & 0x40) >> 3) | (last_fetches_[n+1] & 0x07)] * 0x0101010101010101;	\
+		const uint64_t ink_mask = pixel_masks_[pixels];	\
 			\
-		pixel_target_[0] = colours[(pixels >> 7) & 1];	\
-		pixel_target_[1] = colours[(pixels >> 6) & 1];	\
-		pixel_target_[2] = colours[(pixels >> 5) & 1];	\
-		pixel_target_[3] = colours[(pixels >> 4) & 1];	\
-		pixel_target_[4] = colours[(pixels >> 3) & 1];	\
-		pixel_target_[5] = colours[(pixels >> 2) & 1];	\
-		pixel_target_[6] = colours[(pixels >> 1) & 1];	\
-		pixel_target_[7] = colours[(pixels >> 0) & 1];	\
+		const uint64_t output = (ink & ink_mask) | (paper & ~ink_mask);	\
+		memcpy(pixel_target_, &output, sizeof(output));	\
 		pixel_target_ += 8;									\
 	}
 
@@ -267,7 +263,7 @@ template <Timing timing> class Video {
 			return HalfCycles(timings.half_cycles_per_line * timings.lines_per_frame);
 		}
 
-		HalfCycles time_since_interrupt() {
+		HalfCycles time_since_interrupt() const {
 			const auto timings = get_timings();
 			if(time_into_frame_ >= timings.interrupt_time) {
 				return HalfCycles(time_into_frame_ - timings.interrupt_time);
@@ -286,13 +282,13 @@ template <Timing timing> class Video {
 			if(target == now) return;
 
 			// Is the time within this frame?
-			if(time > now) {
-				run_for(target - time);
+			if(target > now) {
+				run_for(target - now);
 				return;
 			}
 
 			// Then it's necessary to finish this frame and run into the next.
-			run_for(frame_duration() - now + time);
+			run_for(frame_duration() - now + target);
 		}
 
 	public:
@@ -351,17 +347,7 @@ template <Timing timing> class Video {
 			const int delay_time = (time_into_frame_ + offset.as<int>() + timings.contention_leadin) % (timings.half_cycles_per_line * timings.lines_per_frame);
 			assert(!(delay_time&1));
 
-			// Check for a time within the no-contention window.
-			if(delay_time >= (191*timings.half_cycles_per_line + timings.contention_duration)) {
-				return 0;
-			}
-
-			const int time_into_line = delay_time % timings.half_cycles_per_line;
-			if(time_into_line >= timings.contention_duration) {
-				return 0;
-			}
-
-			return HalfCycles(timings.delays[(time_into_line >> 1) & 7]);
+			return HalfCycles(contention_delays_[size_t(delay_time >> 1)]);
 		}
 
 		/*!
@@ -415,7 +401,8 @@ template <Timing timing> class Video {
 
 		/// Gets the current scan status.
 		Outputs::Display::ScanStatus get_scaled_scan_status() const {
-			return crt_.get_scaled_scan_status();
+			// The CRT is clocked in half-cycles.
+			return crt_.get_scaled_scan_status() / 2.0f;
 		}
 
 		/*! Sets the type of display the CRT will request. */
@@ -448,6 +435,33 @@ template <Timing timing> class Video {
 
 		friend struct State;
 
+		/// Provides the contention delay, in half-cycles, that applies at each whole cycle in the frame,
+		/// with time measured from the start of contention.
+		static inline const auto contention_delays_ = [] {
+			constexpr auto timings = get_timings();
+			std::array<uint8_t, size_t(timings.half_cycles_per_line * timings.lines_per_frame / 2)> delays{};
+
+			for(int line = 0; line < 192; line++) {
+				for(int time_into_line = 0; time_into_line < timings.contention_duration; time_into_line += 2) {
+					delays[size_t((line * timings.half_cycles_per_line + time_into_line) >> 1)] = uint8_t(timings.delays[(time_into_line >> 1) & 7]);
+				}
+			}
+			return delays;
+		}();
+
+		/// Maps from a byte of pixels to a mask with 0xff in the place of each set bit and 0x00 in the place of each
+		/// clear one, in output order, for selection between ink and paper eight pixels at a time.
+		static inline const auto pixel_masks_ = [] {
+			std::array<uint64_t, 256> masks{};
+			for(size_t c = 0; c < 256; c++) {
+				uint8_t *const mask = reinterpret_cast<uint8_t *>(&masks[c]);
+				for(int bit = 0; bit < 8; bit++) {
+					mask[bit] = (c & (0x80 >> bit)) ? 0xff : 0x00;
+				}
+			}
+			return masks;
+		}();
+
 #define RGB(r, g, b)	(r << 4) | (g << 2) | b
 		static constexpr uint8_t palette[] = {
 			RGB(0, 0, 0),	RGB(0, 0, 2),	RGB(2, 0, 0),	RGB(2, 0, 2),
@@ -479,16 +493,18 @@ struct State: public Reflection::StructImpl<State> {
 		border_colour = source.border_byte_;
 		flash = source.flash_mask_;
 		flash_counter = source.flash_counter_;
-		is_alternate_line = source. is_alternate_line_;
+		is_alternate_line = source.is_alternate_line_;
 		half_cycles_since_interrupt = source.time_since_interrupt().template as<int>();
 	}
 
-	template <typename Video> void apply(Video &target) {
+	template <typename Video> void apply(Video &target) const {
+		// Getting to the right time may involve running through an interrupt, which would
+		// advance the flash counter, so do that before setting anything else.
+		target.set_time_since_interrupt(HalfCycles(half_cycles_since_interrupt));
 		target.set_border_colour(border_colour);
 		target.flash_mask_ = flash ? 0xff : 0x00;
 		target.flash_counter_ = flash_counter;
 		target.is_alternate_line_ = is_alternate_line;
-		target.set_time_since_interrupt(HalfCycles(half_cycles_since_interrupt));
 	}
 };
 
@@ -41,6 +41,7 @@
 
 #include "../../../ClockReceiver/JustInTime.hpp"
 
+#include <algorithm>
 #include <array>
 
 namespace {
@@ -127,7 +128,9 @@ template<Model model> class ConcreteMachine:
 	public MachineTypes::JoystickMachine,
 	public MachineTypes::MappedKeyboardMachine,
 	public MachineTypes::MediaTarget,
+	public MachineTypes::MemoryReporter,
 	public MachineTypes::ScanProducer,
+	public MachineTypes::StateProducer,
 	public MachineTypes::TimedMachine,
 	public Utility::TypeRecipient<CharacterMapper> {
 	public:
@@ -189,25 +192,7 @@ template<Model model> class ConcreteMachine:
 
 			// Install state if supplied.
 			if(target.state) {
-				const auto state = static_cast<State *>(target.state.get());
-				state->z80.apply(z80_);
-				state->video.apply(*video_.last_valid());
-				state->ay.apply(ay_);
-
-				// If this is a 48k or 16k machine, remap source data from its original
-				// linear form to whatever the banks end up being; otherwise copy as is.
-				if(model <= Model::FortyEightK) {
-					const size_t num_banks = std::min(size_t(48*1024), state->ram.size()) >> 14;
-					for(size_t c = 0; c < num_banks; c++) {
-						memcpy(&write_pointers_[c + 1][(c+1) * 0x4000], &state->ram[c * 0x4000], 0x4000);
-					}
-				} else {
-					memcpy(ram_.data(), state->ram.data(), std::min(ram_.size(), state->ram.size()));
-
-					port1ffd_ = state->last_1ffd;
-					port7ffd_ = state->last_7ffd;
-					update_memory_map();
-				}
+				install_state(*static_cast<State *>(target.state.get()));
 			}
 		}
 
@@ -273,6 +258,62 @@ template<Model model> class ConcreteMachine:
 			}
 		}
 
+		// MARK: - StateProducer.
+
+		std::unique_ptr<Reflection::Struct> get_state() final {
+			// Bring everything up to date, including the audio thread, so that
+			// there's no work outstanding that predates the state.
+			flush();
+			audio_queue_.flush();
+
+			auto state = std::make_unique<State>();
+			state->z80 = CPU::Z80::State(z80_);
+			state->video = Video::State(*video_.last_valid());
+			state->ay = GI::AY38910::State(ay_);
+
+			// As per install_state: 16kb and 48kb machines are stored linearly,
+			// all others as all their banks in order.
+			if constexpr (model <= Model::FortyEightK) {
+				const size_t num_banks = model == Model::SixteenK ? 1 : 3;
+				state->ram.resize(num_banks * 0x4000);
+				for(size_t c = 0; c < num_banks; c++) {
+					memcpy(&state->ram[c * 0x4000], &write_pointers_[c + 1][(c+1) * 0x4000], 0x4000);
+				}
+			} else {
+				state->ram.assign(ram_.begin(), ram_.end());
+				state->last_7ffd = port7ffd_;
+				state->last_1ffd = port1ffd_;
+			}
+
+			return state;
+		}
+
+		bool set_state(const Reflection::Struct &state) final {
+			const auto spectrum_state = dynamic_cast<const State *>(&state);
+			if(!spectrum_state) return false;
+
+			flush();
+			audio_queue_.flush();
+			install_state(*spectrum_state);
+			return true;
+		}
+
+		// MARK: - MemoryReporter.
+
+		void report_memory(MachineTypes::MemoryFootprint &footprint) final {
+			using Kind = MachineTypes::MemoryFootprint::Kind;
+			flush();
+			audio_queue_.flush();
+
+			footprint.add("RAM", Kind::RAM, sizeof(ram_) + sizeof(scratch_));
+			footprint.add("ROM", Kind::ROM, sizeof(rom_));
+			footprint.add("Z80", Kind::ProcessorTables, z80_.get_table_footprint());
+			footprint.add("Speaker", Kind::AudioBuffers, speaker_.get_memory_footprint());
+			if constexpr (model == Model::Plus3) {
+				footprint.add("FDC", Kind::DiskTracks, fdc_->get_disk_memory_footprint());
+			}
+		}
+
 		// MARK: - ScanProducer.
 
 		void set_scan_target(Outputs::Display::ScanTarget *scan_target) override {
@@ -293,6 +334,20 @@ template<Model model> class ConcreteMachine:
 
 		// MARK: - BusHandler.
 
+		int perform_halt_cycles(uint16_t address, int maximum) {
+			// Halted fetches can be skipped only if uncontended, and only until the video next
+			// has an opportunity to change the interrupt line.
+			if(is_contended_[address >> 14]) {
+				return 0;
+			}
+
+			const int fetches = int(std::min(HalfCycles::IntType(maximum), video_.cycles_until_implicit_flush().as_integral() >> 3));
+			if(fetches > 0) {
+				advance(HalfCycles(fetches * 8));
+			}
+			return std::max(fetches, 0);
+		}
+
 		forceinline HalfCycles perform_machine_cycle(const CPU::Z80::PartialMachineCycle &cycle) {
 			using PartialMachineCycle = CPU::Z80::PartialMachineCycle;
 
@@ -815,6 +870,38 @@ template<Model model> class ConcreteMachine:
 			disable_paging_ = port7ffd_ & 0x20;
 		}
 
+		void install_state(const State &state) {
+			state.z80.apply(z80_);
+			state.ay.apply(ay_);
+
+			// Obtain the video via the actor's operator-> so that it
+			// will reconsider its next sequence point afterwards.
+			state.video.apply(*video_.operator->());
+
+			// If this is a 48k or 16k machine, remap source data from its original
+			// linear form to whatever the banks end up being; otherwise copy as is.
+			if constexpr (model <= Model::FortyEightK) {
+				const size_t num_banks = std::min(size_t(48*1024), state.ram.size()) >> 14;
+				for(size_t c = 0; c < num_banks; c++) {
+					memcpy(&write_pointers_[c + 1][(c+1) * 0x4000], &state.ram[c * 0x4000], 0x4000);
+				}
+			} else {
+				memcpy(ram_.data(), state.ram.data(), std::min(ram_.size(), state.ram.size()));
+
+				// Paging may have been locked since the state was captured, so unlock
+				// it; update_memory_map will relock it if the new state says to.
+				port1ffd_ = state.last_1ffd;
+				port7ffd_ = state.last_7ffd;
+				disable_paging_ = false;
+				update_memory_map();
+				set_video_address();
+
+				if constexpr (model == Model::Plus3) {
+					fdc_->set_motor_on(port1ffd_ & 0x08);
+				}
+			}
+		}
+
 		void set_memory(int bank, uint8_t source) {
 			if constexpr (model >= Model::Plus2a) {
 				is_contended_[bank] = source >= 4 && source < 8;
@@ -890,7 +977,7 @@ template<Model model> class ConcreteMachine:
 		//
 		// In:
 		//	A': 0x00 or 0xff for block type;
-		//	F': carry set if loading, clear if verifying;
+		//	F': carry set if loading, clear if verifying; both are supported;
 		//	DE: block length;
 		//	IX: start address.
 		//
@@ -910,7 +997,7 @@ template<Model model> class ConcreteMachine:
 
 			using Register = CPU::Z80::Register;
 			uint8_t flags = uint8_t(z80_.get_value_of_register(Register::FlagsDash));
-			if(!(flags & 1)) return false;
+			const bool is_verifying = !(flags & 1);
 
 			const uint8_t block_type = uint8_t(z80_.get_value_of_register(Register::ADash));
 			const auto block = parser.find_block(tape_player_.get_tape());
@@ -928,7 +1015,16 @@ template<Model model> class ConcreteMachine:
 					break;
 				}
 
-				write_pointers_[target >> 14][target] = *next;
+				// When verifying, stop at the first byte that doesn't match memory;
+				// the ROM likewise exits with carry clear.
+				if(is_verifying) {
+					if(read_pointers_[target >> 14][target] != *next) {
+						flags &= ~1;
+						break;
+					}
+				} else {
+					write_pointers_[target >> 14][target] = *next;
+				}
 				parity ^= *next;
 				++target;
 			}
@@ -10,15 +10,67 @@
 #define State_h
 
 #include <memory>
+#include <vector>
 #include "../Analyser/Static/StaticAnalyser.hpp"
+#include "../Reflection/Struct.hpp"
 
 namespace MachineTypes {
 
+/*!
+	A state producer is any machine that can capture its current state and later return to it.
+
+	States are captured in the same form as is used to supply a state at construction, i.e. as
+	a @c Reflection::Struct, but are kept in memory rather than serialised, so are cheap enough
+	to take and reapply on every frame.
+*/
 struct StateProducer {
-	// TODO.
-//	virtual bool get_state(Analyser::Static::State *, [[maybe_unused]] bool advance_to_simple = false) {
-//		return false;
-//	}
+	/*!
+		Completes any work in flight, such as audio generation on another thread, then captures
+		the current state of the machine.
+
+		@returns The state, or @c nullptr if it cannot currently be captured.
+	*/
+	virtual std::unique_ptr<Reflection::Struct> get_state() {
+		return nullptr;
+	}
+
+	/*!
+		Completes any work in flight, then returns the machine to @c state, which should have been
+		obtained from @c get_state.
+
+		Time doesn't run backwards for outputs: video and audio continue from wherever they were.
+
+		@returns @c true if the state was applied; @c false otherwise.
+	*/
+	virtual bool set_state([[maybe_unused]] const Reflection::Struct &state) {
+		return false;
+	}
+
+	/*!
+		Captures the current state as a binary snapshot, per @c Reflection::Struct::snapshot, into
+		@c target, reusing its storage. Snapshots are compact and quick to take, so suit keeping a
+		history, e.g. for rewinding; see also @c Reflection::snapshot_delta.
+
+		@returns @c true if a snapshot was taken; @c false if no state could be captured.
+	*/
+	bool get_snapshot(std::vector<uint8_t> &target) {
+		const auto state = get_state();
+		if(!state) return false;
+		state->snapshot(target);
+		return true;
+	}
+
+	/*!
+		Returns the machine to the state captured in @c snapshot, which should have been
+		obtained from @c get_snapshot on the same machine.
+
+		@returns @c true if the state was applied; @c false otherwise.
+	*/
+	bool set_snapshot(const std::vector<uint8_t> &snapshot) {
+		// A freshly-captured state provides an instance of the right type to restore into.
+		const auto state = get_state();
+		return state && state->restore(snapshot) && set_state(*state);
+	}
 };
 
 };
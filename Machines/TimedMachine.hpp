@@ -11,6 +11,7 @@
 
 #include "../ClockReceiver/ClockReceiver.hpp"
 #include "../ClockReceiver/TimeTypes.hpp"
+#include "../Outputs/HostProfiler.hpp"
 
 #include "AudioProducer.hpp"
 #include "ScanProducer.hpp"
@@ -28,11 +29,23 @@ class TimedMachine {
 	public:
 		/// Runs the machine for @c duration seconds.
 		virtual void run_for(Time::Seconds duration) {
+			HOST_PROFILER_ZONE("Machine slice");
 			const double cycles = (duration * clock_rate_ * speed_multiplier_) + clock_conversion_error_;
 			clock_conversion_error_ = std::fmod(cycles, 1.0);
 			run_for(Cycles(int(cycles)));
 		}
 
+		/*!
+			Runs the machine for @c duration seconds, to the nearest whole cycle below, without
+			affecting the rounding carried between calls to run_for. This is intended for time
+			that will subsequently be undone, e.g. by a StateProducer, which mustn't alter how
+			the machine would otherwise have run.
+		*/
+		void run_speculatively_for(Time::Seconds duration) {
+			HOST_PROFILER_ZONE("Speculative machine slice");
+			run_for(Cycles(int(duration * clock_rate_ * speed_multiplier_)));
+		}
+
 		/*!
 			Sets a speed multiplier to apply to this machine; e.g. a multiplier of 1.5 will cause the
 			emulated machine to run 50% faster than a real machine. This speed-up is an emulation
@@ -57,6 +70,11 @@ class TimedMachine {
 			return speed_multiplier_;
 		}
 
+		/// @returns This machine's clock rate, in cycles per emulated second.
+		double get_clock_rate() const {
+			return clock_rate_;
+		}
+
 		/// @returns The confidence that this machine is running content it understands.
 		virtual float get_confidence() { return 0.5f; }
 		virtual std::string debug_type() { return ""; }
@@ -70,15 +88,7 @@ class TimedMachine {
 			clock_rate_ = clock_rate;
 		}
 
-		/// Gets this machine's clock rate.
-		double get_clock_rate() const {
-			return clock_rate_;
-		}
-
 	private:
-		// Give the ScanProducer access to this machine's clock rate.
-		friend class ScanProducer;
-
 		double clock_rate_ = 1.0;
 		double clock_conversion_error_ = 0.0;
 		double speed_multiplier_ = 1.0;
@@ -0,0 +1,71 @@
+//
+//  ApplyInput.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 14/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#ifndef ApplyInput_hpp
+#define ApplyInput_hpp
+
+#include "../DynamicMachine.hpp"
+#include "../../Inputs/InputQueue.hpp"
+
+namespace Machine {
+
+/*!
+	Applies @c event to whichever of @c machine's keyboard, joysticks or mouse it is directed at, if the machine has one.
+
+	Joystick indices are taken modulo the number of joysticks the machine has, so that a host may
+	direct each of its controllers at some joystick without knowing how many there are.
+*/
+inline void apply_input(DynamicMachine &machine, const Inputs::InputEvent &event) {
+	using Type = Inputs::InputEvent::Type;
+
+	const auto apply_to_joystick = [&machine, &event] (auto value) {
+		const auto joystick_machine = machine.joystick_machine();
+		if(!joystick_machine) return;
+
+		const auto &joysticks = joystick_machine->get_joysticks();
+		if(joysticks.empty()) return;
+		joysticks[event.joystick % joysticks.size()]->set_input(event.joystick_input(), value);
+	};
+
+	switch(event.type) {
+		case Type::Key: {
+			const auto keyboard_machine = machine.keyboard_machine();
+			bool was_consumed = false;
+			if(keyboard_machine) {
+				was_consumed = event.is_logical ?
+					keyboard_machine->apply_key(event.key, event.symbol, event.is_pressed, true) :
+					keyboard_machine->get_keyboard().set_key_pressed(event.key, event.symbol, event.is_pressed);
+			}
+			if(!was_consumed && event.has_fallback) {
+				apply_to_joystick(event.is_pressed);
+			}
+		} break;
+
+		case Type::ResetKeys: {
+			const auto keyboard_machine = machine.keyboard_machine();
+			if(keyboard_machine) keyboard_machine->get_keyboard().reset_all_keys();
+		} break;
+
+		case Type::JoystickDigital:		apply_to_joystick(event.is_pressed);	break;
+		case Type::JoystickAnalogue:	apply_to_joystick(event.value);			break;
+
+		case Type::MouseMotion: {
+			const auto mouse_machine = machine.mouse_machine();
+			if(mouse_machine) mouse_machine->get_mouse().move(event.x, event.y);
+		} break;
+
+		case Type::MouseButton: {
+			const auto mouse_machine = machine.mouse_machine();
+			if(mouse_machine) mouse_machine->get_mouse().set_button_pressed(event.button, event.is_pressed);
+		} break;
+	}
+}
+
+}
+
+#endif /* ApplyInput_hpp */
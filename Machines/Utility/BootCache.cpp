@@ -0,0 +1,114 @@
+//
+//  BootCache.cpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 14/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#include "BootCache.hpp"
+
+#include "../../Numeric/CRC.hpp"
+#include "../../Reflection/Struct.hpp"
+
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+
+using namespace Machine;
+
+namespace {
+
+/// Incremented whenever the key or file format changes, invalidating everything stored earlier.
+constexpr int FormatVersion = 1;
+
+}
+
+BootCache::BootCache(const std::string &directory, const Analyser::Static::Target &target, const ROM::Map &roms, Time::Seconds boot_duration) :
+	remaining_(boot_duration) {
+	if(directory.empty() || target.state || !target.media.empty()) return;
+
+	// Build the full key: everything that influences the machine at construction.
+	char buffer[64];
+	snprintf(buffer, sizeof(buffer), "version=%d;machine=%d;boot=%.3f;", FormatVersion, int(target.machine), boot_duration);
+	key_ = buffer;
+
+	const auto reflectable_target = dynamic_cast<const Reflection::Struct *>(&target);
+	if(reflectable_target) {
+		key_ += reflectable_target->description();
+	}
+
+	for(const auto &rom: roms) {
+		CRC::CRC32 generator;
+		snprintf(buffer, sizeof(buffer), ";rom%d=%08" PRIx32, int(rom.first), generator.compute_crc(rom.second));
+		key_ += buffer;
+	}
+
+	// Name the file for a hash of the key; the whole key is stored within the file so that
+	// collisions are detected upon restore.
+	uint64_t hash = 0xcbf29ce484222325;
+	for(const char c: key_) {
+		hash = (hash ^ uint8_t(c)) * 0x100000001b3;
+	}
+	snprintf(buffer, sizeof(buffer), "clksignal-boot-%016" PRIx64 ".state", hash);
+	path_ = directory;
+	if(path_.back() != '/') path_ += '/';
+	path_ += buffer;
+}
+
+bool BootCache::restore(MachineTypes::StateProducer &state_producer) {
+	if(path_.empty()) return false;
+
+	// Assume a capture is needed unless a valid state is found.
+	is_pending_ = true;
+
+	FILE *const file = fopen(path_.c_str(), "rb");
+	if(!file) return false;
+
+	std::vector<uint8_t> contents;
+	uint8_t chunk[16384];
+	size_t read;
+	while((read = fread(chunk, 1, sizeof(chunk), file)) > 0) {
+		contents.insert(contents.end(), chunk, chunk + read);
+	}
+	fclose(file);
+
+	// The file is the key, terminated by a NUL, then the serialised state.
+	if(contents.size() <= key_.size() || memcmp(contents.data(), key_.c_str(), key_.size() + 1)) {
+		return false;
+	}
+	contents.erase(contents.begin(), contents.begin() + ptrdiff_t(key_.size() + 1));
+
+	// A freshly-captured state provides an instance of the right type to deserialise into.
+	const auto state = state_producer.get_state();
+	if(!state || !state->deserialise(contents) || !state_producer.set_state(*state)) {
+		return false;
+	}
+	is_pending_ = false;
+	return true;
+}
+
+void BootCache::advance(MachineTypes::StateProducer &state_producer, Time::Seconds duration) {
+	if(!is_pending_) return;
+	remaining_ -= duration;
+	if(remaining_ > 0.0) return;
+	is_pending_ = false;
+
+	// Binary snapshots are specific to a build, so store the serialised form.
+	const auto state = state_producer.get_state();
+	if(!state) return;
+	const auto serialisation = state->serialise();
+
+	// Write to a temporary file and then move that into place, so that an interrupted
+	// write can't leave a truncated state to be found by a later launch.
+	const std::string temporary_path = path_ + ".tmp";
+	FILE *const file = fopen(temporary_path.c_str(), "wb");
+	if(!file) return;
+
+	const bool did_write =
+		fwrite(key_.c_str(), 1, key_.size() + 1, file) == key_.size() + 1 &&
+		fwrite(serialisation.data(), 1, serialisation.size(), file) == serialisation.size();
+	if(fclose(file) || !did_write || rename(temporary_path.c_str(), path_.c_str())) {
+		remove(temporary_path.c_str());
+	}
+}
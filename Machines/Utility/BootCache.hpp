@@ -0,0 +1,68 @@
+//
+//  BootCache.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 14/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#ifndef BootCache_hpp
+#define BootCache_hpp
+
+#include "ROMCatalogue.hpp"
+#include "../StateProducer.hpp"
+#include "../../Analyser/Static/StaticAnalyser.hpp"
+#include "../../ClockReceiver/TimeTypes.hpp"
+
+#include <string>
+#include <vector>
+
+namespace Machine {
+
+/*!
+	Caches the state of a machine once it has booted, so that later launches of the same
+	machine can skip straight to that point.
+
+	Cached states are keyed by the machine, every reflected field of its target and the CRC
+	of every ROM it was built with, and are stored one per file in a host-supplied directory.
+	A target that supplies its own state or that has media attached is specific to that
+	launch, and so is never cached.
+
+	Only machines that are StateProducers and return a state from @c get_state benefit;
+	for all others this is a no-op.
+*/
+class BootCache {
+	public:
+		/*!
+			Prepares to cache boots of @c target, built with @c roms, in @c directory, treating the
+			first @c boot_duration seconds of running as the boot.
+		*/
+		BootCache(const std::string &directory, const Analyser::Static::Target &target, const ROM::Map &roms, Time::Seconds boot_duration);
+
+		/*!
+			Applies a cached state to @c state_producer, which should be a machine that has just been
+			built from the target and ROMs supplied at construction.
+
+			@returns @c true if a cached state was found and applied; @c false otherwise,
+				in which case @c advance will capture one once boot is complete.
+		*/
+		bool restore(MachineTypes::StateProducer &state_producer);
+
+		/// Notes that @c state_producer has just run for @c duration; if that completes boot, a state is captured and stored.
+		void advance(MachineTypes::StateProducer &state_producer, Time::Seconds duration);
+
+		/// Abandons any pending capture, e.g. because media has now been inserted that would otherwise be captured.
+		void cancel() {
+			is_pending_ = false;
+		}
+
+	private:
+		std::string key_;
+		std::string path_;
+		Time::Seconds remaining_;
+		bool is_pending_ = false;
+};
+
+}
+
+#endif /* BootCache_hpp */
@@ -0,0 +1,176 @@
+//
+//  InputMovie.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 14/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#ifndef InputMovie_hpp
+#define InputMovie_hpp
+
+#include "ApplyInput.hpp"
+
+#include "../DynamicMachine.hpp"
+#include "../../ClockReceiver/TimeTypes.hpp"
+#include "../../Inputs/InputQueue.hpp"
+
+#include <cmath>
+#include <fstream>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace Machine {
+
+/*!
+	A recording of the keyboard, joystick and mouse input applied to a machine, each event stamped with
+	the emulated time since the machine was created, so that a session can be replayed exactly.
+
+	Movies are stored as text: a header line, then one line per event of its emulated time in nanoseconds
+	followed by the fields of its Inputs::InputEvent. The host timestamp of each event isn't retained.
+*/
+class InputMovie {
+	public:
+		struct Entry {
+			Time::Nanos time;
+			Inputs::InputEvent event;
+		};
+
+		/// Appends @c event, which was applied at emulated time @c time; events must be added in time order.
+		void add(Time::Nanos time, const Inputs::InputEvent &event) {
+			entries_.push_back(Entry{time, event});
+		}
+
+		const std::vector<Entry> &entries() const {
+			return entries_;
+		}
+
+		/// @returns The emulated time of the final event, or 0 if there are none.
+		Time::Nanos duration() const {
+			return entries_.empty() ? 0 : entries_.back().time;
+		}
+
+		/// Writes this movie to @c file_name, returning @c true on success.
+		bool write(const std::string &file_name) const {
+			std::ofstream file(file_name);
+			if(!file) return false;
+
+			file << Header << '\n';
+			file.precision(9);
+			for(const auto &entry: entries_) {
+				const auto &event = entry.event;
+				file << entry.time << ' ' << int(event.type) << ' ' << event.is_pressed << ' ';
+				file << int(event.key) << ' ' << int(event.symbol) << ' ' << event.is_logical << ' ' << event.has_fallback << ' ';
+				file << event.joystick << ' ' << int(event.input_type) << ' ' << event.input_info << ' ' << event.value << ' ';
+				file << event.x << ' ' << event.y << ' ' << event.button << '\n';
+			}
+			return bool(file);
+		}
+
+		/// @returns The movie stored in @c file_name, or @c std::nullopt if it can't be read.
+		static std::optional<InputMovie> read(const std::string &file_name) {
+			std::ifstream file(file_name);
+			std::string line;
+			if(!std::getline(file, line) || line != Header) return std::nullopt;
+
+			InputMovie movie;
+			while(std::getline(file, line)) {
+				if(line.empty()) continue;
+
+				std::istringstream fields(line);
+				Entry entry;
+				auto &event = entry.event;
+				int type, key, symbol, input_type;
+				fields >> entry.time >> type >> event.is_pressed;
+				fields >> key >> symbol >> event.is_logical >> event.has_fallback;
+				fields >> event.joystick >> input_type >> event.input_info >> event.value;
+				fields >> event.x >> event.y >> event.button;
+				if(!fields || type < 0 || type > int(Inputs::InputEvent::Type::MouseButton)) return std::nullopt;
+				if(!movie.entries_.empty() && entry.time < movie.entries_.back().time) return std::nullopt;
+
+				event.type = Inputs::InputEvent::Type(type);
+				event.key = Inputs::Keyboard::Key(key);
+				event.symbol = char(symbol);
+				event.input_type = Inputs::Joystick::Input::Type(input_type);
+				movie.entries_.push_back(entry);
+			}
+			return movie;
+		}
+
+	private:
+		static constexpr const char *Header = "Clock Signal input movie 1";
+		std::vector<Entry> entries_;
+};
+
+/*!
+	Tracks emulated time as a machine runs, in order to record the input applied to it as an InputMovie.
+*/
+class InputRecorder {
+	public:
+		/// Announces that the machine has run for @c duration emulated seconds.
+		void advance(Time::Seconds duration) {
+			time_ += Time::Nanos(std::round(duration * 1e9));
+		}
+
+		/// Records that @c event has been applied to the machine at the current emulated time.
+		void record(const Inputs::InputEvent &event) {
+			movie_.add(time_, event);
+		}
+
+		const InputMovie &movie() const {
+			return movie_;
+		}
+
+	private:
+		InputMovie movie_;
+		Time::Nanos time_ = 0;
+};
+
+/*!
+	Runs a machine while applying the input from an InputMovie at the emulated times recorded.
+
+	Playback depends only on the movie and on the durations supplied to @c run_for, so identical
+	calls produce identical results.
+*/
+class InputPlayer {
+	public:
+		InputPlayer(InputMovie movie) : movie_(std::move(movie)) {}
+
+		/// Runs @c machine for @c duration emulated seconds, applying all events that fall within that period.
+		void run_for(DynamicMachine &machine, Time::Seconds duration) {
+			const auto timed_machine = machine.timed_machine();
+			const Time::Nanos end = time_ + Time::Nanos(std::round(duration * 1e9));
+
+			const auto &entries = movie_.entries();
+			while(next_ != entries.size() && entries[next_].time <= end) {
+				if(entries[next_].time > time_) {
+					timed_machine->run_for(double(entries[next_].time - time_) / 1e9);
+					time_ = entries[next_].time;
+				}
+				apply_input(machine, entries[next_].event);
+				++next_;
+			}
+
+			if(end > time_) {
+				timed_machine->run_for(double(end - time_) / 1e9);
+			}
+			time_ = end;
+		}
+
+		/// @returns @c true if every event in the movie has been applied.
+		bool is_finished() const {
+			return next_ == movie_.entries().size();
+		}
+
+	private:
+		const InputMovie movie_;
+		size_t next_ = 0;
+		Time::Nanos time_ = 0;
+};
+
+}
+
+#endif /* InputMovie_hpp */
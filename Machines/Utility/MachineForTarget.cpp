@@ -9,6 +9,11 @@
 #include "MachineForTarget.hpp"
 
 #include <algorithm>
+#include <functional>
+#include <utility>
+
+#include "../../Concurrency/ThreadPool.hpp"
+#include "../../Processors/68000/68000.hpp"
 
 // Sources for runtime options and machines.
 #include "../AmstradCPC/AmstradCPC.hpp"
@@ -46,9 +51,18 @@
 #include "../../Analyser/Dynamic/MultiMachine/MultiMachine.hpp"
 #include "TypedDynamicMachine.hpp"
 
-Machine::DynamicMachine *Machine::MachineForTarget(const Analyser::Static::Target *target, const ROMMachine::ROMFetcher &rom_fetcher, Machine::Error &error) {
+Machine::DynamicMachine *Machine::MachineForTarget(const Analyser::Static::Target *target, const ROMMachine::ROMFetcher &supplied_rom_fetcher, Machine::Error &error, StartupProfile *profile) {
 	error = Machine::Error::None;
 
+	// If profiling, note time spent fetching ROMs separately from the remainder of construction.
+	const std::string name = profile ? LongNameForTargetMachine(target->machine) : std::string();
+	const ROMMachine::ROMFetcher profiled_rom_fetcher = [&supplied_rom_fetcher, profile, &name] (const ROM::Request &request) {
+		StartupProfile::Timer timer(profile, name + ": fetch ROMs");
+		return supplied_rom_fetcher(request);
+	};
+	const ROMMachine::ROMFetcher &rom_fetcher = profile ? profiled_rom_fetcher : supplied_rom_fetcher;
+	StartupProfile::Timer timer(profile, name + ": construct");
+
 	Machine::DynamicMachine *machine = nullptr;
 	try {
 #define BindD(name, m)	case Analyser::Machine::m: machine = new Machine::TypedDynamicMachine<::name::Machine>(name::Machine::m(target, rom_fetcher));	break;
@@ -89,7 +103,69 @@ Machine::DynamicMachine *Machine::MachineForTarget(const Analyser::Static::Targe
 	return machine;
 }
 
-Machine::DynamicMachine *Machine::MachineForTargets(const Analyser::Static::TargetList &targets, const ROMMachine::ROMFetcher &rom_fetcher, Error &error) {
+Machine::DynamicMachine *Machine::CloneMachine(DynamicMachine &source, const Analyser::Static::Target *target, const ROMMachine::ROMFetcher &rom_fetcher, Machine::Error &error) {
+	// Media would otherwise be shared between source and clone, including disk and tape state.
+	if(!target->media.empty()) {
+		error = Error::CannotClone;
+		return nullptr;
+	}
+
+	const auto source_state_producer = source.state_producer();
+	const auto state = source_state_producer ? source_state_producer->get_state() : nullptr;
+	if(!state) {
+		error = Error::CannotClone;
+		return nullptr;
+	}
+
+	std::unique_ptr<DynamicMachine> clone(MachineForTarget(target, rom_fetcher, error));
+	if(!clone) return nullptr;
+
+	if(!clone->state_producer() || !clone->state_producer()->set_state(*state)) {
+		error = Error::CannotClone;
+		return nullptr;
+	}
+
+	const auto source_configurable = source.configurable_device();
+	const auto clone_configurable = clone->configurable_device();
+	if(source_configurable && clone_configurable) {
+		clone_configurable->set_options(source_configurable->get_options());
+	}
+
+	return clone.release();
+}
+
+Machine::Preparation Machine::PrepareForTargets(const Analyser::Static::TargetList &targets, StartupProfile *profile) {
+	// Collect whatever can be done in advance; each is performed no more than once per process
+	// regardless, so duplicates are harmless.
+	std::vector<std::pair<std::string, std::function<void(void)>>> tasks;
+	for(const auto &target: targets) {
+		switch(target->machine) {
+			case Analyser::Machine::AtariST:
+			case Analyser::Machine::Macintosh:
+				tasks.emplace_back("68000 tables", [] { CPU::MC68000::ProcessorStorage::prepare(); });
+			break;
+
+			default: break;
+		}
+	}
+
+	Preparation preparation;
+	if(tasks.empty()) return preparation;
+
+	preparation.latch_ = std::make_unique<Concurrency::Latch>(tasks.size());
+	for(auto &task: tasks) {
+		Concurrency::ThreadPool::shared().submit([task = std::move(task), latch = preparation.latch_.get(), profile] {
+			{
+				StartupProfile::Timer timer(profile, task.first);
+				task.second();
+			}
+			latch->count_down();
+		});
+	}
+	return preparation;
+}
+
+Machine::DynamicMachine *Machine::MachineForTargets(const Analyser::Static::TargetList &targets, const ROMMachine::ROMFetcher &rom_fetcher, Error &error, StartupProfile *profile) {
 	// Zero targets implies no machine.
 	if(targets.empty()) {
 		error = Error::NoTargets;
@@ -98,9 +174,12 @@ Machine::DynamicMachine *Machine::MachineForTargets(const Analyser::Static::Targ
 
 	// If there's more than one target, get all the machines and combine them into a multimachine.
 	if(targets.size() > 1) {
+		// Get ahead on anything that later machines will need while constructing earlier ones.
+		Preparation preparation = PrepareForTargets(targets, profile);
+
 		std::vector<std::unique_ptr<Machine::DynamicMachine>> machines;
 		for(const auto &target: targets) {
-			machines.emplace_back(MachineForTarget(target.get(), rom_fetcher, error));
+			machines.emplace_back(MachineForTarget(target.get(), rom_fetcher, error, profile));
 
 			// Exit early if any errors have occurred.
 			if(error != Error::None) {
@@ -118,7 +197,7 @@ Machine::DynamicMachine *Machine::MachineForTargets(const Analyser::Static::Targ
 	}
 
 	// There's definitely exactly one target.
-	return MachineForTarget(targets.front().get(), rom_fetcher, error);
+	return MachineForTarget(targets.front().get(), rom_fetcher, error, profile);
 }
 
 std::string Machine::ShortNameForTargetMachine(const Analyser::Machine machine) {
@@ -14,6 +14,9 @@
 
 #include "../DynamicMachine.hpp"
 #include "../ROMMachine.hpp"
+#include "StartupProfile.hpp"
+
+#include "../../Concurrency/Latch.hpp"
 
 #include <map>
 #include <memory>
@@ -37,21 +40,80 @@ enum class Error {
 	UnknownError,
 	UnknownMachine,
 	MissingROM,
-	NoTargets
+	NoTargets,
+	CannotClone
 };
 
 /*!
 	Allocates an instance of DynamicMachine holding a machine that can
 	receive the supplied static analyser result. The machine has been allocated
 	on the heap. It is the caller's responsibility to delete the class when finished.
+
+	If @c profile is supplied then the time spent constructing each machine, and within that
+	fetching ROMs, is recorded to it.
 */
-DynamicMachine *MachineForTargets(const Analyser::Static::TargetList &targets, const ::ROMMachine::ROMFetcher &rom_fetcher, Error &error);
+DynamicMachine *MachineForTargets(const Analyser::Static::TargetList &targets, const ::ROMMachine::ROMFetcher &rom_fetcher, Error &error, StartupProfile *profile = nullptr);
 
 /*!
 	Allocates an instance of DynamicMaachine holding the machine described
 	by @c target. It is the caller's responsibility to delete the class when finished.
+
+	If @c profile is supplied then time spent is recorded to it, as per @c MachineForTargets.
+*/
+DynamicMachine *MachineForTarget(const Analyser::Static::Target *target, const ROMMachine::ROMFetcher &rom_fetcher, Machine::Error &error, StartupProfile *profile = nullptr);
+
+/*!
+	Represents work begun by @c PrepareForTargets; destruction blocks until that work is complete.
+*/
+class Preparation {
+	public:
+		Preparation() = default;
+		Preparation(Preparation &&) = default;
+		Preparation &operator =(Preparation &&) = delete;
+		~Preparation() {
+			wait();
+		}
+
+		/// Blocks until all preparation is complete.
+		void wait() {
+			if(!latch_) return;
+			latch_->wait();
+			latch_.reset();
+		}
+
+	private:
+		std::unique_ptr<Concurrency::Latch> latch_;
+		friend Preparation PrepareForTargets(const Analyser::Static::TargetList &, StartupProfile *);
+};
+
+/*!
+	Begins, on the shared thread pool, whatever work towards creating machines for @c targets depends on
+	neither ROMs nor media, such as building processor tables, so that it can overlap whatever the caller
+	does before calling @c MachineForTargets — e.g. locating ROMs.
+
+	It is never necessary to call this; any work not yet done will be done as part of construction.
+
+	If @c profile is supplied then each piece of work is recorded to it; the profile should therefore
+	outlive the returned Preparation.
+*/
+Preparation PrepareForTargets(const Analyser::Static::TargetList &targets, StartupProfile *profile = nullptr);
+
+/*!
+	Allocates a new instance of DynamicMachine that is a copy of @c source as it currently is,
+	including its runtime options. @c target should be that from which @c source was created.
+
+	Media can't be duplicated, and tapes and disks carry state of their own that two machines
+	could not safely share, so a @c target with any media can't be cloned. Media inserted into
+	@c source after construction is not carried over. A ROM fetcher that caches, such as
+	@c ROM::Repository, avoids any repeated file access.
+
+	Only machines that are StateProducers and return a state from @c get_state can be cloned;
+	for all others, and for targets with media, @c error is set to @c Error::CannotClone. Calls
+	should be serialised with anything else that is using @c source.
+
+	It is the caller's responsibility to delete the class when finished.
 */
-DynamicMachine *MachineForTarget(const Analyser::Static::Target *target, const ROMMachine::ROMFetcher &rom_fetcher, Machine::Error &error);
+DynamicMachine *CloneMachine(DynamicMachine &source, const Analyser::Static::Target *target, const ROMMachine::ROMFetcher &rom_fetcher, Machine::Error &error);
 
 /*!
 	Returns a short string name for the machine identified by the target,
@@ -0,0 +1,295 @@
+//
+//  ROMRepository.cpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 14/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#include "ROMRepository.hpp"
+
+#include "../../Numeric/CRC.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cinttypes>
+#include <cstdio>
+#include <thread>
+
+#include <dirent.h>
+#include <sys/stat.h>
+
+using namespace ROM;
+
+namespace {
+
+/// Files larger than this are assumed not to be ROMs, and are not hashed.
+constexpr size_t MaximumROMSize = 16 * 1024 * 1024;
+
+std::shared_ptr<const std::vector<uint8_t>> read_file(const std::string &path) {
+	FILE *const file = fopen(path.c_str(), "rb");
+	if(!file) return nullptr;
+
+	std::vector<uint8_t> data;
+	std::fseek(file, 0, SEEK_END);
+	data.resize(size_t(std::ftell(file)));
+	std::fseek(file, 0, SEEK_SET);
+	const size_t read = std::fread(data.data(), 1, data.size(), file);
+	std::fclose(file);
+
+	if(read != data.size()) return nullptr;
+	return std::make_shared<const std::vector<uint8_t>>(std::move(data));
+}
+
+std::string with_separator(std::string path) {
+	if(!path.empty() && path.back() != '/') path += '/';
+	return path;
+}
+
+/// Appends to @c files the names of all visible entries in @c directory, and to @c subdirectories
+/// the names of any that are themselves directories.
+void list(const std::string &directory, std::vector<std::string> &files, std::vector<std::string> *subdirectories) {
+	DIR *const dir = opendir(directory.c_str());
+	if(!dir) return;
+
+	while(const dirent *const entry = readdir(dir)) {
+		if(entry->d_name[0] == '.') continue;
+
+		const std::string path = directory + entry->d_name;
+		struct stat stats;
+		if(stat(path.c_str(), &stats)) continue;
+
+		if(S_ISDIR(stats.st_mode)) {
+			if(subdirectories) subdirectories->push_back(with_separator(path));
+		} else if(S_ISREG(stats.st_mode)) {
+			files.push_back(path);
+		}
+	}
+	closedir(dir);
+}
+
+}
+
+Repository &Repository::shared() {
+	static Repository repository;
+	return repository;
+}
+
+// MARK: - Index.
+
+void Repository::set_index_file(const std::string &path) {
+	std::lock_guard lock(mutex_);
+	index_file_ = path;
+	index_.clear();
+
+	FILE *const file = fopen(path.c_str(), "r");
+	if(!file) return;
+
+	// Each line is: CRC, size, modification time, path.
+	char line[4096];
+	while(std::fgets(line, sizeof(line), file)) {
+		uint32_t crc32;
+		unsigned long long size;
+		long long modification_time;
+		int path_start;
+		if(std::sscanf(line, "%" SCNx32 " %llu %lld %n", &crc32, &size, &modification_time, &path_start) < 3) continue;
+
+		std::string name(line + path_start);
+		while(!name.empty() && (name.back() == '\n' || name.back() == '\r')) name.pop_back();
+		if(name.empty()) continue;
+
+		index_[name] = IndexedCRC{size_t(size), int64_t(modification_time), crc32};
+	}
+	std::fclose(file);
+}
+
+void Repository::write_index() {
+	if(index_file_.empty()) return;
+
+	FILE *const file = fopen(index_file_.c_str(), "w");
+	if(!file) return;
+	for(const auto &entry: index_) {
+		std::fprintf(file, "%08" PRIx32 " %llu %lld %s\n",
+			entry.second.crc32,
+			static_cast<unsigned long long>(entry.second.size),
+			static_cast<long long>(entry.second.modification_time),
+			entry.first.c_str());
+	}
+	std::fclose(file);
+}
+
+// MARK: - Scanning.
+
+void Repository::add_directories(const std::vector<std::string> &paths) {
+	std::lock_guard lock(mutex_);
+
+	bool did_scan = false;
+	for(const auto &path: paths) {
+		const auto directory = with_separator(path);
+		if(std::find(directories_.begin(), directories_.end(), directory) != directories_.end()) continue;
+
+		directories_.push_back(directory);
+		scan(directory);
+		did_scan = true;
+	}
+
+	if(did_scan) write_index();
+}
+
+void Repository::scan(const std::string &directory) {
+	std::vector<std::string> files, subdirectories;
+	list(directory, files, &subdirectories);
+	for(const auto &subdirectory: subdirectories) {
+		list(subdirectory, files, nullptr);
+	}
+
+	// Establish new entries, collecting those that will need to be hashed.
+	std::vector<size_t> unhashed;
+	const size_t first_entry = entries_.size();
+	for(const auto &file: files) {
+		if(entries_by_path_.find(file) != entries_by_path_.end()) continue;
+
+		struct stat stats;
+		if(stat(file.c_str(), &stats) || size_t(stats.st_size) > MaximumROMSize) continue;
+
+		Entry entry;
+		entry.path = file;
+		entry.size = size_t(stats.st_size);
+		entry.modification_time = int64_t(stats.st_mtime);
+
+		const auto indexed = index_.find(file);
+		if(
+			indexed == index_.end() ||
+			indexed->second.size != entry.size ||
+			indexed->second.modification_time != entry.modification_time
+		) {
+			unhashed.push_back(entries_.size());
+		} else {
+			entry.crc32 = indexed->second.crc32;
+		}
+
+		entries_by_path_[file] = entries_.size();
+		entries_.push_back(std::move(entry));
+	}
+
+	// Hash in parallel. Contents aren't retained, as most files found are unlikely to be
+	// fetched; they'll be read again on demand.
+	std::atomic<size_t> next(0);
+	const auto hash = [&] {
+		CRC::CRC32 generator;
+		while(true) {
+			const size_t index = next++;
+			if(index >= unhashed.size()) break;
+
+			Entry &entry = entries_[unhashed[index]];
+			const auto contents = read_file(entry.path);
+			if(contents) {
+				entry.crc32 = generator.compute_crc(*contents);
+			}
+		}
+	};
+
+	const size_t thread_count = std::min<size_t>(std::max(1u, std::thread::hardware_concurrency()), unhashed.size());
+	std::vector<std::thread> threads;
+	for(size_t c = 1; c < thread_count; c++) {
+		threads.emplace_back(hash);
+	}
+	hash();
+	for(auto &thread: threads) {
+		thread.join();
+	}
+
+	for(size_t index = first_entry; index < entries_.size(); index++) {
+		const auto &entry = entries_[index];
+		entries_by_crc_.emplace(entry.crc32, index);
+		index_[entry.path] = IndexedCRC{entry.size, entry.modification_time, entry.crc32};
+	}
+}
+
+void Repository::unindex_crc(size_t index) {
+	const auto range = entries_by_crc_.equal_range(entries_[index].crc32);
+	for(auto entry = range.first; entry != range.second; ++entry) {
+		if(entry->second == index) {
+			entries_by_crc_.erase(entry);
+			break;
+		}
+	}
+}
+
+void Repository::add_file(const std::string &path) {
+	std::lock_guard lock(mutex_);
+
+	struct stat stats;
+	if(stat(path.c_str(), &stats)) return;
+	const auto contents = read_file(path);
+	if(!contents) return;
+
+	// Reuse any existing entry for this path.
+	size_t index;
+	const auto existing = entries_by_path_.find(path);
+	if(existing != entries_by_path_.end()) {
+		index = existing->second;
+		unindex_crc(index);
+	} else {
+		index = entries_.size();
+		entries_.emplace_back();
+		entries_by_path_[path] = index;
+	}
+
+	Entry &entry = entries_[index];
+	CRC::CRC32 generator;
+	entry.path = path;
+	entry.size = size_t(stats.st_size);
+	entry.modification_time = int64_t(stats.st_mtime);
+	entry.crc32 = generator.compute_crc(*contents);
+	entry.contents = contents;
+
+	entries_by_crc_.emplace(entry.crc32, index);
+	index_[entry.path] = IndexedCRC{entry.size, entry.modification_time, entry.crc32};
+	write_index();
+}
+
+// MARK: - Fetching.
+
+const std::vector<uint8_t> *Repository::contents(Entry &entry) {
+	if(!entry.contents) {
+		entry.contents = read_file(entry.path);
+	}
+	return entry.contents.get();
+}
+
+Map Repository::fetch(const Request &request) {
+	std::lock_guard lock(mutex_);
+
+	Map results;
+	for(const auto &description: request.all_descriptions()) {
+		if(results.find(description.name) != results.end()) continue;
+
+		// Prefer an exact path, in directory order.
+		const std::vector<uint8_t> *found = nullptr;
+		for(const auto &directory: directories_) {
+			for(const auto &file_name: description.file_names) {
+				const auto entry = entries_by_path_.find(directory + description.machine_name + "/" + file_name);
+				if(entry != entries_by_path_.end()) {
+					found = contents(entries_[entry->second]);
+				}
+				if(found) break;
+			}
+			if(found) break;
+		}
+
+		// Otherwise accept anything of a suitable CRC.
+		for(auto crc = description.crc32s.begin(); !found && crc != description.crc32s.end(); ++crc) {
+			const auto range = entries_by_crc_.equal_range(*crc);
+			for(auto entry = range.first; !found && entry != range.second; ++entry) {
+				found = contents(entries_[entry->second]);
+			}
+		}
+
+		if(found) {
+			results[description.name] = *found;
+		}
+	}
+
+	return results;
+}
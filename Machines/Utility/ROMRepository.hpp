@@ -0,0 +1,94 @@
+//
+//  ROMRepository.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 14/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#ifndef ROMRepository_hpp
+#define ROMRepository_hpp
+
+#include "ROMCatalogue.hpp"
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace ROM {
+
+/*!
+	A process-wide store of the ROM images found within a set of directories.
+
+	Each directory is scanned once, with CRC32s being computed in parallel, and each
+	ROM's contents are loaded at most once and then shared by all subsequent fetches;
+	multiple machine instances therefore don't each reread and rehash the same files.
+
+	If an index file is nominated then CRCs are also retained between runs, and a file
+	is rehashed only if its size or modification time has changed.
+*/
+class Repository {
+	public:
+		/// @returns the process-wide repository.
+		static Repository &shared();
+
+		/*!
+			Nominates @c path as the place in which to persist CRCs between runs, loading
+			whatever it already holds.
+		*/
+		void set_index_file(const std::string &path);
+
+		/*!
+			Scans each of @c paths that hasn't already been scanned. ROMs are expected to be found
+			at [path]/[machine name]/[file name], but anything within [path] or any of its
+			immediate subdirectories may be matched by CRC.
+		*/
+		void add_directories(const std::vector<std::string> &paths);
+
+		/*!
+			Adds or updates the file at @c path, e.g. because it has just been written.
+		*/
+		void add_file(const std::string &path);
+
+		/*!
+			@returns all ROMs relevant to @c request that can be found. Each is located preferably
+			by its expected path, with directories being searched in the order they were added,
+			and otherwise by CRC.
+		*/
+		Map fetch(const Request &request);
+
+	private:
+		struct Entry {
+			std::string path;
+			size_t size = 0;
+			int64_t modification_time = 0;
+			uint32_t crc32 = 0;
+			std::shared_ptr<const std::vector<uint8_t>> contents;
+		};
+
+		std::mutex mutex_;
+		std::vector<std::string> directories_;
+		std::vector<Entry> entries_;
+		std::map<std::string, size_t> entries_by_path_;
+		std::multimap<uint32_t, size_t> entries_by_crc_;
+
+		std::string index_file_;
+		struct IndexedCRC {
+			size_t size;
+			int64_t modification_time;
+			uint32_t crc32;
+		};
+		std::map<std::string, IndexedCRC> index_;
+
+		void scan(const std::string &directory);
+		void unindex_crc(size_t entry);
+		void write_index();
+		const std::vector<uint8_t> *contents(Entry &);
+};
+
+}
+
+#endif /* ROMRepository_hpp */
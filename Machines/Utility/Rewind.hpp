@@ -0,0 +1,148 @@
+//
+//  Rewind.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 14/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#ifndef Rewind_hpp
+#define Rewind_hpp
+
+#include "../StateProducer.hpp"
+#include "../../ClockReceiver/TimeTypes.hpp"
+#include "../../Reflection/SnapshotDelta.hpp"
+
+#include <algorithm>
+#include <deque>
+#include <utility>
+#include <vector>
+
+namespace Machine {
+
+/*!
+	Keeps a history of a machine's recent states, allowing it to be stepped backwards through them.
+
+	A snapshot is captured at a fixed interval of running. Only the most recent is held in full;
+	each earlier one is held as the XOR delta between it and its successor, which is mostly zeroes
+	and stored as only its non-zero stretches. Deltas are kept in an arena of fixed size, the
+	oldest being discarded to make room for the newest, so memory use is bounded regardless of the
+	size of the machine or the length of the history: beyond the arena, only the most recent
+	snapshot and working space for one more are held, each the size of a single snapshot.
+
+	Only machines that are StateProducers and return a state from @c get_state can be rewound.
+	Calls should be serialised with each other and anything else that uses the machine.
+*/
+class Rewind {
+	public:
+		/*!
+			Maintains a history for @c state_producer, capturing it every @c interval seconds of running
+			and keeping as many deltas as will fit in @c arena_size bytes.
+		*/
+		Rewind(MachineTypes::StateProducer &state_producer, size_t arena_size, Time::Seconds interval = 0.1) :
+			state_producer_(state_producer), arena_(arena_size), interval_(interval) {}
+
+		/// Notes that the machine has just run for @c duration, capturing a snapshot if one is due.
+		void advance(Time::Seconds duration) {
+			time_since_capture_ += duration;
+			if(has_latest_ && time_since_capture_ < interval_) return;
+			time_since_capture_ = 0.0;
+			capture();
+		}
+
+		/*!
+			Returns the machine to the most recent snapshot, then discards that snapshot so that the next
+			call goes back one further. The oldest snapshot in the history is never discarded, so that
+			repeated calls eventually stop there.
+
+			@returns @c true if the machine was moved; @c false if there is no history or the
+				snapshot could not be applied.
+		*/
+		bool step_back() {
+			if(!has_latest_ || !state_producer_.set_snapshot(latest_)) return false;
+			time_since_capture_ = 0.0;
+
+			if(!deltas_.empty()) {
+				const auto delta = deltas_.back();
+				deltas_.pop_back();
+
+				// Failure shouldn't happen, but if it does then the rest of the history is unreachable.
+				if(!Reflection::apply_xor_delta(latest_, &arena_[delta.first], delta.second)) {
+					deltas_.clear();
+					has_latest_ = false;
+				}
+			}
+			return true;
+		}
+
+		/// Discards all history.
+		void clear() {
+			deltas_.clear();
+			has_latest_ = false;
+			time_since_capture_ = 0.0;
+		}
+
+		/// @returns The number of snapshots currently available to step back through.
+		size_t size() const {
+			return has_latest_ ? deltas_.size() + 1 : 0;
+		}
+
+		/// @returns The number of bytes occupied by this history.
+		size_t get_memory_footprint() const {
+			return
+				arena_.capacity() + latest_.capacity() + capture_.capacity() + delta_.capacity() +
+				deltas_.size() * sizeof(deltas_.front());
+		}
+
+	private:
+		MachineTypes::StateProducer &state_producer_;
+
+		// Deltas are stored in the arena as a ring: each is placed immediately after the previous,
+		// or at the start if it won't fit before the end. Each is recorded as an (offset, size) pair,
+		// oldest first.
+		std::vector<uint8_t> arena_;
+		std::deque<std::pair<size_t, size_t>> deltas_;
+
+		std::vector<uint8_t> latest_, capture_, delta_;
+		bool has_latest_ = false;
+
+		const Time::Seconds interval_;
+		Time::Seconds time_since_capture_ = 0.0;
+
+		void capture() {
+			if(!state_producer_.get_snapshot(capture_)) return;
+
+			if(has_latest_) {
+				delta_.clear();
+				Reflection::append_xor_delta(delta_, latest_, capture_);
+				store(delta_);
+			}
+
+			std::swap(latest_, capture_);
+			has_latest_ = true;
+		}
+
+		void store(const std::vector<uint8_t> &delta) {
+			// If this delta can't be held then nothing before it can be reached either.
+			if(delta.size() > arena_.size()) {
+				deltas_.clear();
+				return;
+			}
+
+			size_t offset = deltas_.empty() ? 0 : deltas_.back().first + deltas_.back().second;
+			if(offset + delta.size() > arena_.size()) offset = 0;
+
+			// Discard as many of the oldest deltas as overlap the space required.
+			const size_t end = offset + delta.size();
+			while(!deltas_.empty() && deltas_.front().first < end && deltas_.front().first + deltas_.front().second > offset) {
+				deltas_.pop_front();
+			}
+
+			std::copy(delta.begin(), delta.end(), arena_.begin() + ptrdiff_t(offset));
+			deltas_.emplace_back(offset, delta.size());
+		}
+};
+
+}
+
+#endif /* Rewind_hpp */
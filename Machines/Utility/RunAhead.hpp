@@ -0,0 +1,313 @@
+//
+//  RunAhead.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 14/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#ifndef RunAhead_hpp
+#define RunAhead_hpp
+
+#include "../MachineTypes.hpp"
+#include "../../Outputs/ScanTarget.hpp"
+#include "../../Outputs/Speaker/Speaker.hpp"
+
+#include <algorithm>
+#include <deque>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace Machine {
+
+/*!
+	Reduces apparent input latency by showing the video that a machine will produce a few frames
+	from now, given the current inputs, rather than the video it has just produced.
+
+	Once per host frame, @c present captures the machine's state, runs it ahead by the requested
+	number of frames with video enabled and audio discarded, then restores the captured state.
+	All other running, via @c run_for, is of the real timeline, with its audio retained but its
+	video discarded. So each frame's video reflects inputs up to that point, a few frames early,
+	but audio follows the real timeline and is never heard twice.
+
+	Audio produced while running ahead is cut out sample by sample, using the speaker's count of
+	undelivered samples, and what remains is repacked into packets of the size the speaker was
+	delivering, so the delegate sees an uninterrupted stream.
+
+	Only machines that are StateProducers and return a state from @c get_state can run ahead; all
+	others are passed through unaltered.
+
+	The RunAhead installs itself as the scan target of the machine and as the delegate of its
+	speaker, if any, forwarding to whichever were set before; it reverses that upon destruction.
+	@c run_for and @c present should be serialised with each other and anything else that uses the machine.
+*/
+class RunAhead: public Outputs::Display::ScanTarget, public Outputs::Speaker::Speaker::Delegate {
+	public:
+		/*!
+			Wraps @c machine, which is currently outputting to @c scan_target, running ahead
+			by @c frames frames per call to @c present.
+		*/
+		RunAhead(
+			MachineTypes::TimedMachine &timed_machine,
+			MachineTypes::ScanProducer &scan_producer,
+			MachineTypes::StateProducer &state_producer,
+			Outputs::Display::ScanTarget *scan_target,
+			int frames) :
+				timed_machine_(timed_machine),
+				scan_producer_(scan_producer),
+				state_producer_(state_producer),
+				scan_target_(scan_target ? scan_target : &Outputs::Display::NullScanTarget::singleton),
+				frames_(frames) {
+			auto audio_producer = dynamic_cast<MachineTypes::AudioProducer *>(&timed_machine_);
+			speaker_ = audio_producer ? audio_producer->get_speaker() : nullptr;
+			if(speaker_) {
+				speaker_delegate_ = speaker_->get_delegate();
+				speaker_->set_delegate(this);
+			}
+			scan_producer_.set_scan_target(this);
+		}
+
+		~RunAhead() {
+			scan_producer_.set_scan_target(scan_target_);
+			if(speaker_) {
+				speaker_->set_delegate(speaker_delegate_);
+			}
+		}
+
+		/// Runs the real timeline for @c duration, discarding its video unless running ahead is impossible.
+		void run_for(Time::Seconds duration) {
+			set_video_enabled(!is_running_ahead_);
+			timed_machine_.run_for(duration);
+		}
+
+		/*!
+			Runs ahead and back again, producing the video that will be seen. Should be called once
+			per host frame, before that frame is drawn.
+
+			@returns @c true if the machine ran ahead; @c false if it is unable to.
+		*/
+		bool present() {
+			if(frames_ <= 0) {
+				is_running_ahead_ = false;
+				return false;
+			}
+
+			const auto state = state_producer_.get_state();
+			is_running_ahead_ = bool(state);
+			if(!state) return false;
+
+			// Discard all audio from here until the end of the run ahead, which isn't yet known.
+			{
+				std::lock_guard lock_guard(audio_mutex_);
+				discarded_ranges_.emplace_back(audio_position(), std::numeric_limits<size_t>::max());
+			}
+
+			// Aim to stop just short of an exact number of frames from now, so that restoration,
+			// which must run video forwards to get back to the captured position, has little to do.
+			auto field_duration = scan_producer_.get_scan_status().field_duration;
+			if(field_duration <= 0.0) field_duration = 1.0 / 50.0;
+			const Time::Seconds duration = 0.999 * field_duration * double(frames_) / timed_machine_.get_speed_multiplier();
+
+			set_video_enabled(true);
+			timed_machine_.run_speculatively_for(duration);
+			set_video_enabled(false);
+
+			state_producer_.set_state(*state);
+			{
+				std::lock_guard lock_guard(audio_mutex_);
+				discarded_ranges_.back().second = audio_position();
+			}
+			return true;
+		}
+
+		/// Sets the number of frames to run ahead by; 0 disables running ahead.
+		void set_frames(int frames) {
+			frames_ = frames;
+		}
+
+		// MARK: - ScanTarget.
+
+		void set_modals(Modals modals) final {
+			scan_target_->set_modals(modals);
+		}
+
+		Scan *begin_scan() final {
+			if(!is_passing_output()) return nullptr;
+			scan_ = scan_target_->begin_scan();
+			return scan_;
+		}
+
+		void end_scan() final {
+			if(!scan_) return;
+			last_location_ = scan_->end_points[1];
+			last_composite_amplitude_ = scan_->composite_amplitude;
+			scan_target_->end_scan();
+			scan_ = nullptr;
+		}
+
+		uint8_t *begin_data(size_t required_length, size_t required_alignment) final {
+			data_is_from_target_ = is_passing_output();
+			return data_is_from_target_ ? scan_target_->begin_data(required_length, required_alignment) : nullptr;
+		}
+
+		void end_data(size_t actual_length) final {
+			// Data allocated before output was disabled still needs to be returned.
+			if(!data_is_from_target_) return;
+			scan_target_->end_data(actual_length);
+			data_is_from_target_ = false;
+		}
+
+		void set_palette(const uint8_t *colours, size_t count) final {
+			// Changes made while running ahead are undone along with the rest of the machine state, so only
+			// those made while video is enabled are forwarded.
+			if(video_is_enabled_) scan_target_->set_palette(colours, count);
+		}
+
+		void will_change_owner() final {
+			scan_target_->will_change_owner();
+		}
+
+		void submit() final {
+			if(is_passing_output()) scan_target_->submit();
+		}
+
+		void announce(Event event, bool is_visible, const Scan::EndPoint &location, uint8_t composite_amplitude) final {
+			switch(event) {
+				// Frame boundaries are always forwarded, so that the scan target knows where each frame begins.
+				case Event::BeginVerticalRetrace:
+				case Event::EndVerticalRetrace:
+					scan_target_->announce(event, is_visible, location, composite_amplitude);
+				break;
+
+				// Lines are forwarded only while enabled, and only once a new one has begun after enabling.
+				case Event::EndHorizontalRetrace:
+					if(!video_is_enabled_) break;
+					awaiting_line_ = false;
+					line_is_open_ = is_visible;
+					scan_target_->announce(event, is_visible, location, composite_amplitude);
+				break;
+
+				case Event::BeginHorizontalRetrace:
+					if(!is_passing_output()) break;
+					line_is_open_ = false;
+					scan_target_->announce(event, is_visible, location, composite_amplitude);
+				break;
+			}
+			last_location_ = location;
+			last_composite_amplitude_ = composite_amplitude;
+		}
+
+		// MARK: - Speaker::Delegate.
+
+		void speaker_did_complete_samples(Outputs::Speaker::Speaker *speaker, const std::vector<int16_t> &buffer) final {
+			if(!speaker_delegate_) return;
+			std::lock_guard lock_guard(audio_mutex_);
+
+			const size_t start = samples_produced_;
+			const size_t end = start + buffer.size();
+			samples_produced_ = end;
+
+			while(!discarded_ranges_.empty() && discarded_ranges_.front().second <= start) {
+				discarded_ranges_.pop_front();
+			}
+
+			// Hope for the fast path first: nothing to discard, and nothing previously repacked.
+			if(packet_.empty() && (discarded_ranges_.empty() || discarded_ranges_.front().first >= end)) {
+				speaker_delegate_->speaker_did_complete_samples(speaker, buffer);
+				return;
+			}
+
+			// Otherwise copy whatever isn't to be discarded into the packet, posting it whenever full.
+			size_t position = start;
+			while(position < end) {
+				size_t next = end;
+				if(!discarded_ranges_.empty()) {
+					const auto &range = discarded_ranges_.front();
+					if(position >= range.first) {
+						position = std::min(range.second, end);
+						if(range.second <= end) discarded_ranges_.pop_front();
+						continue;
+					}
+					next = std::min(next, range.first);
+				}
+
+				while(position < next) {
+					const size_t length = std::min(next - position, buffer.size() - packet_.size());
+					packet_.insert(packet_.end(), buffer.begin() + ptrdiff_t(position - start), buffer.begin() + ptrdiff_t(position - start + length));
+					position += length;
+
+					if(packet_.size() == buffer.size()) {
+						speaker_delegate_->speaker_did_complete_samples(speaker, packet_);
+						packet_.clear();
+					}
+				}
+			}
+		}
+
+		void speaker_did_change_input_clock(Outputs::Speaker::Speaker *speaker) final {
+			if(speaker_delegate_) {
+				speaker_delegate_->speaker_did_change_input_clock(speaker);
+			}
+		}
+
+	private:
+		MachineTypes::TimedMachine &timed_machine_;
+		MachineTypes::ScanProducer &scan_producer_;
+		MachineTypes::StateProducer &state_producer_;
+		Outputs::Display::ScanTarget *const scan_target_;
+		int frames_;
+		bool is_running_ahead_ = false;
+
+		Outputs::Speaker::Speaker *speaker_ = nullptr;
+		Outputs::Speaker::Speaker::Delegate *speaker_delegate_ = nullptr;
+
+		// Audio is delivered on whichever thread the speaker runs on. Positions within it are counted
+		// in samples as delivered, from which the ranges produced while running ahead are discarded.
+		std::mutex audio_mutex_;
+		size_t samples_produced_ = 0;
+		std::deque<std::pair<size_t, size_t>> discarded_ranges_;
+		std::vector<int16_t> packet_;
+
+		/// @returns The current position in the audio stream. Valid only while the speaker is idle, e.g. immediately
+		/// after get_state or set_state, and with audio_mutex_ held.
+		size_t audio_position() const {
+			return samples_produced_ + (speaker_ ? speaker_->undelivered_samples() : 0);
+		}
+
+		// Output state: whether video is enabled, and if so whether a line has begun since;
+		// whether a visible line is open on the scan target; and whether the current data
+		// allocation and scan are the scan target's.
+		bool video_is_enabled_ = true;
+		bool awaiting_line_ = false;
+		bool line_is_open_ = false;
+		bool data_is_from_target_ = false;
+		Scan *scan_ = nullptr;
+
+		Scan::EndPoint last_location_{};
+		uint8_t last_composite_amplitude_ = 0;
+
+		bool is_passing_output() const {
+			return video_is_enabled_ && !awaiting_line_;
+		}
+
+		void set_video_enabled(bool enabled) {
+			if(enabled == video_is_enabled_) return;
+			video_is_enabled_ = enabled;
+
+			if(enabled) {
+				// Whatever is in progress began while disabled; wait for the next line.
+				awaiting_line_ = true;
+			} else if(line_is_open_) {
+				// Close the line that was in progress where it currently stands.
+				scan_target_->announce(Event::BeginHorizontalRetrace, false, last_location_, last_composite_amplitude_);
+				line_is_open_ = false;
+			}
+		}
+};
+
+}
+
+#endif /* RunAhead_hpp */
@@ -0,0 +1,98 @@
+//
+//  StartupProfile.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 14/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#ifndef StartupProfile_hpp
+#define StartupProfile_hpp
+
+#include "../../ClockReceiver/TimeTypes.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace Machine {
+
+/*!
+	Records how long each phase of getting a machine running took, e.g. so that a host can
+	report its time to first frame and see where that time went.
+
+	Phases may be recorded from any thread, and may overlap.
+*/
+class StartupProfile {
+	public:
+		struct Phase {
+			std::string name;
+			/// The start of this phase, relative to the construction of the profile.
+			Time::Nanos start;
+			Time::Nanos duration;
+		};
+
+		StartupProfile() : origin_(Time::nanos_now()) {}
+
+		/// Records that the phase @c name ran from @c start until @c end, both as per Time::nanos_now.
+		void add(const std::string &name, Time::Nanos start, Time::Nanos end) {
+			std::lock_guard lock(mutex_);
+			phases_.push_back(Phase{name, start - origin_, end - start});
+		}
+
+		/// Records that the phase @c name began when this profile was constructed and has just ended.
+		void mark(const std::string &name) {
+			add(name, origin_, Time::nanos_now());
+		}
+
+		/// @returns All phases recorded so far, in order of starting time.
+		std::vector<Phase> phases() const {
+			std::lock_guard lock(mutex_);
+			auto result = phases_;
+			std::stable_sort(result.begin(), result.end(), [] (const Phase &lhs, const Phase &rhs) {
+				return lhs.start < rhs.start;
+			});
+			return result;
+		}
+
+		/// @returns A human-readable list of all phases, one per line, with starting time and duration in milliseconds.
+		std::string summary() const {
+			std::string result;
+			char line[160];
+			for(const auto &phase: phases()) {
+				snprintf(line, sizeof(line), "%8.2f ms +%8.2f ms: %s\n", double(phase.start) / 1e6, double(phase.duration) / 1e6, phase.name.c_str());
+				result += line;
+			}
+			return result;
+		}
+
+		/*!
+			Times the scope in which it is declared, recording it as a phase of @c profile
+			upon destruction; does nothing if @c profile is @c nullptr.
+		*/
+		class Timer {
+			public:
+				Timer(StartupProfile *profile, const std::string &name) :
+					profile_(profile), name_(profile ? name : std::string()), start_(profile ? Time::nanos_now() : 0) {}
+
+				~Timer() {
+					if(profile_) profile_->add(name_, start_, Time::nanos_now());
+				}
+
+			private:
+				StartupProfile *const profile_;
+				const std::string name_;
+				const Time::Nanos start_;
+		};
+
+	private:
+		const Time::Nanos origin_;
+		mutable std::mutex mutex_;
+		std::vector<Phase> phases_;
+};
+
+}
+
+#endif /* StartupProfile_hpp */
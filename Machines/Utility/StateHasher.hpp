@@ -0,0 +1,127 @@
+//
+//  StateHasher.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 14/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#ifndef StateHasher_hpp
+#define StateHasher_hpp
+
+#include "../StateProducer.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace Machine {
+
+/*!
+	Produces 64-bit hashes of a machine's complete state — processor registers, RAM and the state of
+	every other component that it captures — e.g. so that runs of the same input on different hosts,
+	or with different threading arrangements, can be checked to have reached identical states.
+
+	Each hash is of the binary snapshot provided by the StateProducer. The snapshot is hashed in pages,
+	and the previous snapshot and its page hashes are retained so that only those pages that have changed
+	need be hashed again; most of a snapshot is usually RAM, of which little changes from one frame to the
+	next, so after the first hash the cost is mostly that of capturing the snapshot and comparing it to
+	the previous.
+
+	Snapshots are in host byte order, so hashes are comparable only between hosts of the same endianness.
+*/
+class StateHasher {
+	public:
+		/// The granularity, in bytes, at which changes are detected and hashes are recomputed.
+		static constexpr size_t PageSize = 4096;
+
+		/// @returns The hash of the current state of @c state_producer, or @c std::nullopt if it can't currently supply one.
+		std::optional<uint64_t> hash(MachineTypes::StateProducer &state_producer) {
+			if(!state_producer.get_snapshot(current_)) return std::nullopt;
+
+			const size_t pages = (current_.size() + PageSize - 1) / PageSize;
+			page_hashes_.resize(pages);
+
+			for(size_t page = 0; page < pages; page++) {
+				const size_t start = page * PageSize;
+				const size_t length = std::min(PageSize, current_.size() - start);
+
+				// A page is unchanged, and its hash still stands, only if it had the same length last time and holds the same bytes.
+				const size_t previous_length = page < previous_pages_ ? std::min(PageSize, previous_.size() - start) : 0;
+				if(previous_length == length && !memcmp(&previous_[start], &current_[start], length)) {
+					continue;
+				}
+				page_hashes_[page] = hash(&current_[start], length, page);
+			}
+
+			std::swap(previous_, current_);
+			previous_pages_ = pages;
+
+			uint64_t result = mix(uint64_t(previous_.size()));
+			for(const auto page_hash: page_hashes_) {
+				result = mix(result ^ page_hash);
+			}
+			return result;
+		}
+
+		/// Discards all retained state, so that the next hash is computed from scratch.
+		void clear() {
+			previous_.clear();
+			previous_pages_ = 0;
+		}
+
+		/// @returns The number of bytes occupied by retained snapshots and page hashes.
+		size_t get_memory_footprint() const {
+			return previous_.capacity() + current_.capacity() + page_hashes_.capacity() * sizeof(uint64_t);
+		}
+
+		/// Combines the hashes @c lhs and @c rhs, order dependently; e.g. to reduce a series of per-frame hashes to one.
+		static uint64_t combine(uint64_t lhs, uint64_t rhs) {
+			return mix(lhs ^ mix(rhs + 0x9e37'79b9'7f4a'7c15));
+		}
+
+	private:
+		std::vector<uint8_t> previous_, current_;
+		std::vector<uint64_t> page_hashes_;
+		size_t previous_pages_ = 0;
+
+		/// The finaliser of SplitMix64: a cheap bijection with good avalanche behaviour.
+		static uint64_t mix(uint64_t value) {
+			value = (value ^ (value >> 30)) * 0xbf58'476d'1ce4'e5b9;
+			value = (value ^ (value >> 27)) * 0x94d0'49bb'1331'11eb;
+			return value ^ (value >> 31);
+		}
+
+		/// @returns A hash of the @c length bytes at @c data, which constitute page @c page.
+		static uint64_t hash(const uint8_t *data, size_t length, size_t page) {
+			// Four independent lanes of multiply-and-rotate, eight bytes at a time, so that the work
+			// pipelines well; any remaining bytes are then folded into the first lane.
+			uint64_t lanes[4] = {
+				mix(page) ^ 0x243f'6a88'85a3'08d3, 0x1319'8a2e'0370'7344,
+				0xa409'3822'299f'31d0, 0x082e'fa98'ec4e'6c89,
+			};
+			constexpr uint64_t prime = 0x9e37'79b1'85eb'ca87;
+
+			size_t offset = 0;
+			for(; offset + 32 <= length; offset += 32) {
+				for(int lane = 0; lane < 4; lane++) {
+					uint64_t word;
+					memcpy(&word, &data[offset + size_t(lane) * 8], sizeof(word));
+					lanes[lane] = (lanes[lane] ^ word) * prime;
+					lanes[lane] = (lanes[lane] << 31) | (lanes[lane] >> 33);
+				}
+			}
+			for(; offset < length; offset++) {
+				lanes[0] = (lanes[0] ^ data[offset]) * prime;
+			}
+
+			return mix(lanes[0] ^ mix(lanes[1] ^ mix(lanes[2] ^ mix(lanes[3] ^ length))));
+		}
+};
+
+}
+
+#endif /* StateHasher_hpp */
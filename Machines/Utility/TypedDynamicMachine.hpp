@@ -39,6 +39,8 @@ template<typename T> class TypedDynamicMachine: public ::Machine::DynamicMachine
 		Provide(MachineTypes::KeyboardMachine, keyboard_machine)
 		Provide(MachineTypes::MouseMachine, mouse_machine)
 		Provide(MachineTypes::MediaTarget, media_target)
+		Provide(MachineTypes::StateProducer, state_producer)
+		Provide(MachineTypes::MemoryReporter, memory_reporter)
 
 #undef Provide
 
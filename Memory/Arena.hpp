@@ -0,0 +1,156 @@
+//
+//  Arena.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 14/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#ifndef Arena_hpp
+#define Arena_hpp
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <vector>
+
+#if __has_include(<sys/mman.h>)
+#include <sys/mman.h>
+#endif
+
+namespace Memory {
+
+/*!
+	Provides large buffers, such as a machine's RAM and ROM, from as few large blocks as possible, so that
+	they're contiguous rather than scattered across the heap and, if huge pages are requested and the host
+	supports them transparently, so that they can be mapped using far fewer TLB entries.
+
+	Allocations are made in increasing address order within each block. Memory is returned only when the
+	arena is destroyed, except that a block is reused once everything allocated from it has been released,
+	and releasing the most recent allocation in a block makes that space available again.
+
+	The arena must outlive everything allocated from it, and is not thread safe.
+*/
+class Arena {
+	public:
+		enum class Backing {
+			/// Blocks are obtained from the heap in multiples of 64kb.
+			Standard,
+			/// Blocks are aligned to and sized in multiples of 2mb, and advised as suitable for huge pages.
+			/// This suits owners of a few large buffers, which can afford to round their footprint up to 2mb.
+			HugePages,
+		};
+
+		Arena(Backing backing = Backing::Standard) :
+			granularity_(backing == Backing::HugePages ? HugePageSize : 64 * 1024),
+			backing_(backing) {}
+
+		~Arena() {
+			for(const auto &block: blocks_) {
+				::operator delete(block.base, std::align_val_t(granularity_));
+			}
+		}
+
+		Arena(const Arena &) = delete;
+		Arena &operator =(const Arena &) = delete;
+
+		/// @returns Storage for @c size bytes, aligned to @c alignment, which must be a power of two no greater than the block granularity.
+		void *allocate(size_t size, size_t alignment = alignof(std::max_align_t)) {
+			for(auto &block: blocks_) {
+				const size_t start = (block.used + alignment - 1) & ~(alignment - 1);
+				if(start + size <= block.size) {
+					block.used = start + size;
+					++block.allocations;
+					return block.base + start;
+				}
+			}
+
+			// Nothing fits, so add a block, rounded up to the granularity so that later
+			// allocations are likely to share it.
+			Block block;
+			block.size = (size + granularity_ - 1) & ~(granularity_ - 1);
+			block.base = static_cast<uint8_t *>(::operator new(block.size, std::align_val_t(granularity_)));
+#ifdef MADV_HUGEPAGE
+			if(backing_ == Backing::HugePages) {
+				madvise(block.base, block.size, MADV_HUGEPAGE);
+			}
+#endif
+			block.used = size;
+			block.allocations = 1;
+			blocks_.push_back(block);
+			return block.base;
+		}
+
+		/// Releases the @c size bytes at @c pointer, which must have been obtained from @c allocate on this arena.
+		void deallocate(void *pointer, size_t size) {
+			uint8_t *const address = static_cast<uint8_t *>(pointer);
+			for(auto &block: blocks_) {
+				if(address < block.base || address >= block.base + block.size) continue;
+
+				--block.allocations;
+				if(!block.allocations) {
+					block.used = 0;
+				} else if(address + size == block.base + block.used) {
+					block.used = size_t(address - block.base);
+				}
+				return;
+			}
+		}
+
+		/// @returns The number of bytes obtained from the host.
+		size_t get_memory_footprint() const {
+			size_t footprint = 0;
+			for(const auto &block: blocks_) {
+				footprint += block.size;
+			}
+			return footprint;
+		}
+
+	private:
+		static constexpr size_t HugePageSize = 2 * 1024 * 1024;
+
+		struct Block {
+			uint8_t *base = nullptr;
+			size_t size = 0;
+			size_t used = 0;
+			size_t allocations = 0;
+		};
+		std::vector<Block> blocks_;
+		const size_t granularity_;
+		const Backing backing_;
+};
+
+/// An allocator for standard containers that obtains storage from an Arena.
+template <typename T> class ArenaAllocator {
+	public:
+		using value_type = T;
+
+		ArenaAllocator(Arena &arena) noexcept : arena_(&arena) {}
+		template <typename U> ArenaAllocator(const ArenaAllocator<U> &rhs) noexcept : arena_(rhs.arena_) {}
+
+		T *allocate(size_t count) {
+			return static_cast<T *>(arena_->allocate(count * sizeof(T), alignof(T)));
+		}
+
+		void deallocate(T *pointer, size_t count) noexcept {
+			arena_->deallocate(pointer, count * sizeof(T));
+		}
+
+		template <typename U> bool operator ==(const ArenaAllocator<U> &rhs) const noexcept {
+			return arena_ == rhs.arena_;
+		}
+		template <typename U> bool operator !=(const ArenaAllocator<U> &rhs) const noexcept {
+			return arena_ != rhs.arena_;
+		}
+
+	private:
+		Arena *arena_;
+		template <typename U> friend class ArenaAllocator;
+};
+
+/// A vector whose storage is provided by an Arena, which should be supplied at construction.
+template <typename T> using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+
+}
+
+#endif /* Arena_hpp */
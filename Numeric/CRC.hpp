@@ -9,9 +9,16 @@
 #ifndef CRC_hpp
 #define CRC_hpp
 
+#include <array>
 #include <cstdint>
+#include <cstring>
+#include <type_traits>
 #include <vector>
 
+#if defined(__ARM_FEATURE_CRC32)
+#include <arm_acle.h>
+#endif
+
 namespace CRC {
 
 constexpr uint8_t reverse_byte(uint8_t byte) {
@@ -26,6 +33,15 @@ constexpr uint8_t reverse_byte(uint8_t byte) {
 		((byte & 0x01) ? 0x80 : 0x00);
 }
 
+/// A lookup table equivalent to @c reverse_byte.
+constexpr std::array<uint8_t, 256> reversed_bytes = [] {
+	std::array<uint8_t, 256> table{};
+	for(int c = 0; c < 256; c++) {
+		table[size_t(c)] = reverse_byte(uint8_t(c));
+	}
+	return table;
+}();
+
 /*! Provides a class capable of generating a CRC from source data. */
 template <typename IntType, IntType reset_value, IntType output_xor, bool reflect_input, bool reflect_output> class Generator {
 	public:
@@ -41,8 +57,24 @@ template <typename IntType, IntType reset_value, IntType output_xor, bool reflec
 					IntType exclusive_or = (shift_value&top_bit) ? polynomial : 0;
 					shift_value = IntType(shift_value << 1) ^ exclusive_or;
 				}
-				xor_table[c] = shift_value;
+				xor_table[0][size_t(c)] = shift_value;
+			}
+
+			// Table n gives the effect of a byte followed by n zero bytes, allowing
+			// eight bytes to be processed at once.
+			for(size_t n = 1; n < 8; n++) {
+				for(size_t c = 0; c < 256; c++) {
+					const IntType previous = xor_table[n-1][c];
+					xor_table[n][c] = IntType((previous << 8) ^ xor_table[0][previous >> multibyte_shift]);
+				}
 			}
+
+#if defined(__ARM_FEATURE_CRC32)
+			uses_arm_crc32_ =
+				std::is_same_v<IntType, uint32_t> && reflect_input && reflect_output &&
+				reset_value == IntType(~0) && output_xor == IntType(~0) &&
+				polynomial == 0x04c11db7;
+#endif
 		}
 
 		/// Resets the CRC to the reset value.
@@ -50,8 +82,39 @@ template <typename IntType, IntType reset_value, IntType output_xor, bool reflec
 
 		/// Updates the CRC to include @c byte.
 		void add(uint8_t byte) {
-			if constexpr (reflect_input) byte = reverse_byte(byte);
-			value_ = IntType((value_ << 8) ^ xor_table[(value_ >> multibyte_shift) ^ byte]);
+			if constexpr (reflect_input) byte = reversed_bytes[byte];
+			value_ = IntType((value_ << 8) ^ xor_table[0][(value_ >> multibyte_shift) ^ byte]);
+		}
+
+		/// Updates the CRC to include the @c length bytes from @c data.
+		void add(const uint8_t *data, std::size_t length) {
+#if defined(__ARM_FEATURE_CRC32)
+			if(uses_arm_crc32_) {
+				add_arm_crc32(data, length);
+				return;
+			}
+#endif
+
+			while(length >= 8) {
+				IntType value = 0;
+				for(std::size_t c = 0; c < 8; c++) {
+					uint8_t byte = data[c];
+					if constexpr (reflect_input) byte = reversed_bytes[byte];
+					if(c < sizeof(IntType)) {
+						byte ^= uint8_t(value_ >> (multibyte_shift - 8*c));
+					}
+					value ^= xor_table[7 - c][byte];
+				}
+				value_ = value;
+
+				data += 8;
+				length -= 8;
+			}
+
+			while(length--) {
+				add(*data);
+				++data;
+			}
 		}
 
 		/// @returns The current value of the CRC.
@@ -60,7 +123,7 @@ template <typename IntType, IntType reset_value, IntType output_xor, bool reflec
 			if constexpr (reflect_output) {
 				IntType reflected_output = 0;
 				for(std::size_t c = 0; c < sizeof(IntType); ++c) {
-					reflected_output = IntType(reflected_output << 8) | IntType(reverse_byte(result & 0xff));
+					reflected_output = IntType(reflected_output << 8) | IntType(reversed_bytes[result & 0xff]);
 					result >>= 8;
 				}
 				return reflected_output;
@@ -82,6 +145,11 @@ template <typename IntType, IntType reset_value, IntType output_xor, bool reflec
 			return compute_crc(data.begin(), data.end());
 		}
 
+		/// Equivalent to the generic @c compute_crc for collections, using the bulk form of @c add.
+		IntType compute_crc(const std::vector<uint8_t> &data) {
+			return compute_crc(data.data(), data.size());
+		}
+
 		/*!
 			A compound for:
 
@@ -90,18 +158,63 @@ template <typename IntType, IntType reset_value, IntType output_xor, bool reflec
 				get_value()
 		*/
 		template <typename Iterator> IntType compute_crc(Iterator begin, Iterator end) {
-			reset();
-			while(begin != end) {
-				add(*begin);
-				++begin;
+			if constexpr (
+				std::is_same_v<Iterator, std::vector<uint8_t>::iterator> ||
+				std::is_same_v<Iterator, std::vector<uint8_t>::const_iterator> ||
+				std::is_same_v<Iterator, uint8_t *> ||
+				std::is_same_v<Iterator, const uint8_t *>
+			) {
+				const auto length = std::size_t(end - begin);
+				return compute_crc(length ? &*begin : nullptr, length);
+			} else {
+				reset();
+				while(begin != end) {
+					add(*begin);
+					++begin;
+				}
+				return get_value();
 			}
+		}
+
+		/*!
+			A compound for:
+
+				reset()
+				add(data, length)
+				get_value()
+		*/
+		IntType compute_crc(const uint8_t *data, std::size_t length) {
+			reset();
+			add(data, length);
 			return get_value();
 		}
 
 	private:
 		static constexpr int multibyte_shift = (sizeof(IntType) * 8) - 8;
-		IntType xor_table[256];
+		std::array<std::array<IntType, 256>, 8> xor_table{};
 		IntType value_;
+
+#if defined(__ARM_FEATURE_CRC32)
+		bool uses_arm_crc32_ = false;
+
+		void add_arm_crc32(const uint8_t *data, std::size_t length) {
+			// The ARM instructions implement the reflected form of the algorithm, so work
+			// upon a reflected copy of the current value.
+			uint32_t value = __rbit(uint32_t(value_));
+			while(length >= 8) {
+				uint64_t word;
+				std::memcpy(&word, data, 8);
+				value = __crc32d(value, word);
+				data += 8;
+				length -= 8;
+			}
+			while(length--) {
+				value = __crc32b(value, *data);
+				++data;
+			}
+			value_ = IntType(__rbit(value));
+		}
+#endif
 };
 
 /*!
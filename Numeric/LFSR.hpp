@@ -9,8 +9,10 @@
 #ifndef LFSR_h
 #define LFSR_h
 
+#include <array>
 #include <cstdint>
 #include <cstdlib>
+#include <type_traits>
 
 #include "Sizes.hpp"
 
@@ -74,8 +76,116 @@ template <typename IntType = uint64_t, IntType polynomial = LSFRPolynomial<IntTy
 			return result;
 		}
 
+		/*!
+			Advances the LFSR by @c count steps, returning the bits shifted out packed into a single word
+			with the first in the least significant position, i.e. bit @c n is the result that the
+			<tt>n</tt>th call to @c next() would have returned.
+
+			Bits are generated eight per table lookup.
+		*/
+		template <int count = 64> uint64_t next_bits() {
+			static_assert(count > 0 && count <= 64);
+			const auto &steps = byte_steps();
+
+			auto value = UIntType(value_);
+			uint64_t result = 0;
+			int shift = 0;
+			for(; shift + 8 <= count; shift += 8) {
+				const auto &step = steps[value & 0xff];
+				result |= uint64_t(step.output) << shift;
+				value = UIntType((value >> 8) ^ step.feedback);
+			}
+			for(; shift < count; ++shift) {
+				const auto bit = UIntType(value & 1);
+				result |= uint64_t(bit) << shift;
+				value = UIntType((value >> 1) ^ (bit * UIntType(polynomial)));
+			}
+
+			value_ = IntType(value);
+			return result;
+		}
+
+		/*!
+			Advances the LFSR by @c steps steps, discarding the output. Longer skips are made in time
+			proportional to the number of bits set in @c steps, by applying precomputed powers of the
+			LFSR's transition matrix.
+		*/
+		void skip(uint64_t steps) {
+			auto value = UIntType(value_);
+
+			if(steps <= Width * 8) {
+				const auto &table = byte_steps();
+				for(; steps >= 8; steps -= 8) {
+					value = UIntType((value >> 8) ^ table[value & 0xff].feedback);
+				}
+			} else {
+				const auto &powers = transition_powers();
+				for(size_t power = 0; steps; ++power, steps >>= 1) {
+					if(steps & 1) value = apply(powers[power], value);
+				}
+			}
+
+			value_ = IntType(value);
+			while(steps--) next();
+		}
+
 	private:
 		IntType value_ = 0;
+
+		using UIntType = std::make_unsigned_t<IntType>;
+		static constexpr size_t Width = sizeof(IntType) * 8;
+
+		// Stepping a Galois LFSR eight times from any state shifts it right by eight and XORs in a
+		// feedback value that, like the eight bits output, depends only on its low byte.
+		struct ByteStep {
+			uint8_t output = 0;
+			UIntType feedback = 0;
+		};
+		static const std::array<ByteStep, 256> &byte_steps() {
+			static constexpr std::array<ByteStep, 256> table = [] {
+				std::array<ByteStep, 256> table{};
+				for(size_t c = 0; c < 256; c++) {
+					auto value = UIntType(c);
+					for(int bit = 0; bit < 8; bit++) {
+						const auto output = UIntType(value & 1);
+						table[c].output |= uint8_t(output << bit);
+						value = UIntType((value >> 1) ^ (output * UIntType(polynomial)));
+					}
+					table[c].feedback = value;
+				}
+				return table;
+			}();
+			return table;
+		}
+
+		// Each step is a linear map over GF(2), so is represented here by a matrix, stored as the image of each basis vector.
+		using Matrix = std::array<UIntType, Width>;
+		static UIntType apply(const Matrix &matrix, UIntType value) {
+			UIntType result = 0;
+			for(size_t column = 0; value; ++column, value >>= 1) {
+				if(value & 1) result ^= matrix[column];
+			}
+			return result;
+		}
+
+		/// @returns The transition matrix raised to the powers 1, 2, 4, 8, etc., up to 2^63.
+		static const std::array<Matrix, 64> &transition_powers() {
+			static const std::array<Matrix, 64> powers = [] {
+				std::array<Matrix, 64> powers{};
+				for(size_t column = 0; column < Width; column++) {
+					powers[0][column] = UIntType(UIntType(1) << column) >> 1;
+				}
+				powers[0][0] = UIntType(polynomial);
+
+				for(size_t power = 1; power < 64; power++) {
+					for(size_t column = 0; column < Width; column++) {
+						powers[power][column] = apply(powers[power - 1], powers[power - 1][column]);
+					}
+				}
+				return powers;
+			}();
+			return powers;
+		}
 };
 
 template <uint64_t polynomial> class LFSRv: public LFSR<typename MinIntTypeValue<polynomial>::type, polynomial> {};
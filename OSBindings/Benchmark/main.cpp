@@ -0,0 +1,316 @@
+//
+//  main.cpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 14/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#include "../../Analyser/Static/StaticAnalyser.hpp"
+#include "../../Machines/Utility/InputMovie.hpp"
+#include "../../Machines/Utility/MachineForTarget.hpp"
+#include "../../Machines/MachineTypes.hpp"
+#include "../../Outputs/ScanTargets/DiscardingScanTarget.hpp"
+#include "../../Outputs/ScanTargets/SoftwareScanTarget.hpp"
+#include "../../Reflection/Struct.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace {
+
+/*!
+	Discards all audio, but gives the speaker a reason to generate it so that
+	audio costs are included in any measurement.
+*/
+struct NullSpeakerDelegate: public Outputs::Speaker::Speaker::Delegate {
+	void speaker_did_complete_samples(Outputs::Speaker::Speaker *, const std::vector<int16_t> &) final {}
+};
+
+struct ParsedArguments {
+	std::vector<std::string> file_names;
+	std::map<std::string, std::string> selections;	// The empty string will be inserted for arguments without an = suffix.
+
+	void apply(Reflection::Struct *reflectable) const {
+		for(const auto &argument: selections) {
+			// Ignore the arguments that are specific to benchmarking.
+			if(argument.first == "new" || argument.first == "rompath" || argument.first == "seconds" || argument.first == "hash" || argument.first == "render" || argument.first == "replay") continue;
+
+			// Replace any dashes with underscores in the argument name.
+			std::string property;
+			std::transform(argument.first.begin(), argument.first.end(), std::back_inserter(property), [](char c) { return c == '-' ? '_' : c; });
+
+			if(argument.second.empty()) {
+				Reflection::set<bool>(*reflectable, property, true);
+			} else {
+				Reflection::fuzzy_set(*reflectable, property, argument.second);
+			}
+		}
+	}
+};
+
+/*! Parses an argc/argv pair to discern program arguments. */
+ParsedArguments parse_arguments(int argc, char *argv[]) {
+	ParsedArguments arguments;
+
+	for(int index = 1; index < argc; ++index) {
+		char *arg = argv[index];
+
+		// Accepted format is as per the SDL target:
+		//
+		//	--flag			sets a Boolean option to true.
+		//	--flag=value	sets the value for a list option.
+		//	name			sets the file name to load.
+		if(arg[0] == '-') {
+			while(*arg == '-') arg++;
+
+			std::string argument = arg;
+			std::size_t split_index = argument.find("=");
+
+			if(split_index == std::string::npos) {
+				arguments.selections[argument];
+			} else {
+				const std::string name = argument.substr(0, split_index);
+				std::string value = argument.substr(split_index+1, std::string::npos);
+				arguments.selections[name] = value;
+			}
+		} else {
+			arguments.file_names.push_back(arg);
+		}
+	}
+
+	return arguments;
+}
+
+/*!
+	@returns A target list for the machine named by @c name, which is checked case insensitively
+		against the available short names, or an empty list if no such machine exists.
+*/
+Analyser::Static::TargetList targets_for_machine(const std::string &name) {
+	Analyser::Static::TargetList targets;
+
+	const auto short_names = Machine::AllMachines(Machine::Type::DoesntRequireMedia, false);
+	const auto short_name = std::find_if(short_names.begin(), short_names.end(), [&name] (const std::string &candidate) {
+		return std::equal(
+			candidate.begin(), candidate.end(),
+			name.begin(), name.end(),
+			[](char a, char b) { return tolower(b) == tolower(a); });
+	});
+	if(short_name == short_names.end()) {
+		return targets;
+	}
+
+	const auto long_name = Machine::AllMachines(Machine::Type::DoesntRequireMedia, true)[size_t(short_name - short_names.begin())];
+	auto targets_by_machine = Machine::TargetsByMachineName(false);
+	targets.push_back(std::move(targets_by_machine[long_name]));
+	return targets;
+}
+
+/*!
+	As per the SDL target, assumes system ROMs can be found in one of:
+
+		/usr/local/share/CLK/[system];
+		/usr/share/CLK/[system]; or
+		[user-supplied path]/[system]
+*/
+ROMMachine::ROMFetcher rom_fetcher(const ParsedArguments &arguments, ROM::Request &missing_roms) {
+	std::vector<std::string> paths = {
+		"/usr/local/share/CLK/",
+		"/usr/share/CLK/"
+	};
+
+	const auto rompath = arguments.selections.find("rompath");
+	if(rompath != arguments.selections.end() && !rompath->second.empty()) {
+		std::string path = rompath->second;
+		if(path.back() != '/') {
+			path += '/';
+		}
+
+		const size_t tilde_position = path.find("~");
+		if(tilde_position != std::string::npos) {
+			path.replace(tilde_position, 1, getenv("HOME"));
+		}
+
+		paths.push_back(path);
+	}
+
+	return [paths, &missing_roms] (const ROM::Request &roms) -> ROM::Map {
+		ROM::Map results;
+		for(const auto &description: roms.all_descriptions()) {
+			for(const auto &file_name: description.file_names) {
+				FILE *file = nullptr;
+				for(const auto &path: paths) {
+					const std::string local_path = path + description.machine_name + "/" + file_name;
+					file = std::fopen(local_path.c_str(), "rb");
+					if(file) break;
+				}
+				if(!file) continue;
+
+				std::vector<uint8_t> data;
+				std::fseek(file, 0, SEEK_END);
+				data.resize(size_t(std::ftell(file)));
+				std::fseek(file, 0, SEEK_SET);
+				const std::size_t read = std::fread(data.data(), 1, data.size(), file);
+				std::fclose(file);
+
+				if(read == data.size()) {
+					results[description.name] = std::move(data);
+				}
+			}
+		}
+
+		missing_roms = roms.subtract(results);
+		return results;
+	};
+}
+
+}
+
+int main(int argc, char *argv[]) {
+	const ParsedArguments arguments = parse_arguments(argc, argv);
+
+	const auto new_argument = arguments.selections.find("new");
+	if(arguments.file_names.empty() && (new_argument == arguments.selections.end() || new_argument->second.empty())) {
+		std::cerr << "Usage: clksignal-bench [file or --new={machine}] [OPTIONS] [--seconds={emulated seconds, default 10}] [--hash] [--render] [--replay={input movie}] [--rompath={path to ROMs}]" << std::endl;
+		std::cerr << "With --replay, input recorded by clksignal's --record-input is applied as it was recorded; the default duration then extends one second beyond the final event." << std::endl;
+		std::cerr << "Machines are: ";
+		bool is_first = true;
+		for(const auto &name: Machine::AllMachines(Machine::Type::DoesntRequireMedia, false)) {
+			if(!is_first) std::cerr << ", ";
+			is_first = false;
+			std::cerr << name;
+		}
+		std::cerr << "." << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	// Determine the targets.
+	Analyser::Static::TargetList targets;
+	if(new_argument != arguments.selections.end() && !new_argument->second.empty()) {
+		targets = targets_for_machine(new_argument->second);
+		if(targets.empty()) {
+			std::cerr << "Unknown machine: " << new_argument->second << std::endl;
+			return EXIT_FAILURE;
+		}
+	} else {
+		for(const auto &file_name: arguments.file_names) {
+			targets = Analyser::Static::GetTargets(file_name);
+			if(!targets.empty()) break;
+		}
+		if(targets.empty()) {
+			std::cerr << "No target machine found for the supplied media." << std::endl;
+			return EXIT_FAILURE;
+		}
+	}
+
+	for(auto &target: targets) {
+		auto reflectable_target = dynamic_cast<Reflection::Struct *>(target.get());
+		if(!reflectable_target) continue;
+		arguments.apply(reflectable_target);
+	}
+
+	// Build the machine.
+	ROM::Request missing_roms;
+	::Machine::Error error;
+	std::unique_ptr<::Machine::DynamicMachine> machine(::Machine::MachineForTargets(targets, rom_fetcher(arguments, missing_roms), error));
+	if(!machine) {
+		switch(error) {
+			case ::Machine::Error::MissingROM: {
+				std::cerr << "Could not find system ROMs; please install to /usr/local/share/CLK/ or /usr/share/CLK/, or provide a --rompath." << std::endl;
+				std::cerr << "Needed but didn't find";
+				using DescriptionFlag = ROM::Description::DescriptionFlag;
+				std::wcerr << missing_roms.description(DescriptionFlag::Filename | DescriptionFlag::CRC, L'*');
+				std::cerr << std::endl;
+			} break;
+
+			default:
+				std::cerr << "Could not create machine." << std::endl;
+			break;
+		}
+		return EXIT_FAILURE;
+	}
+
+	// Attach null outputs; if hashing was requested then video output is hashed rather than
+	// just discarded, and if rendering was requested then it is rasterised in software.
+	NullSpeakerDelegate speaker_delegate;
+	Outputs::Display::DiscardingScanTarget discarding_scan_target;
+	Outputs::Display::HashingScanTarget hashing_scan_target;
+	std::unique_ptr<Outputs::Display::SoftwareScanTarget> software_scan_target;
+	const bool hash = arguments.selections.find("hash") != arguments.selections.end();
+	const bool render = !hash && arguments.selections.find("render") != arguments.selections.end();
+	if(const auto audio_producer = machine->audio_producer()) {
+		if(const auto speaker = audio_producer->get_speaker()) {
+			speaker->set_output_rate(44100.0f, 1024, speaker->get_is_stereo());
+			speaker->set_delegate(&speaker_delegate);
+		}
+	}
+	if(const auto scan_producer = machine->scan_producer()) {
+		if(render) {
+			software_scan_target = std::make_unique<Outputs::Display::SoftwareScanTarget>();
+			scan_producer->set_scan_target(software_scan_target.get());
+		} else {
+			scan_producer->set_scan_target(hash ? &hashing_scan_target : &discarding_scan_target);
+		}
+	}
+
+	// Load any input to replay.
+	std::optional<Machine::InputPlayer> input_player;
+	double seconds = 10.0;
+	const auto replay_argument = arguments.selections.find("replay");
+	if(replay_argument != arguments.selections.end()) {
+		auto movie = Machine::InputMovie::read(replay_argument->second);
+		if(!movie) {
+			std::cerr << "Could not read input movie: " << replay_argument->second << std::endl;
+			return EXIT_FAILURE;
+		}
+		seconds = double(movie->duration()) / 1e9 + 1.0;
+		input_player.emplace(std::move(*movie));
+	}
+
+	// Run for the requested period, in slices of approximately a frame.
+	const auto seconds_argument = arguments.selections.find("seconds");
+	if(seconds_argument != arguments.selections.end() && !seconds_argument->second.empty()) {
+		seconds = std::max(std::strtod(seconds_argument->second.c_str(), nullptr), 0.0);
+	}
+
+	const auto timed_machine = machine->timed_machine();
+	constexpr double slice = 1.0 / 50.0;
+	const auto start_time = std::chrono::steady_clock::now();
+	for(double elapsed = 0.0; elapsed < seconds; elapsed += slice) {
+		const double duration = std::min(slice, seconds - elapsed);
+		if(input_player) {
+			input_player->run_for(*machine, duration);
+		} else {
+			timed_machine->run_for(duration);
+		}
+		if(software_scan_target) {
+			software_scan_target->update();
+		}
+	}
+	const auto end_time = std::chrono::steady_clock::now();
+
+	// Report.
+	const double wall_seconds = std::chrono::duration<double>(end_time - start_time).count();
+	const double ratio = wall_seconds > 0.0 ? seconds / wall_seconds : 0.0;
+	std::cout << Machine::ShortNameForTargetMachine(targets.front()->machine) << ": ";
+	std::cout << seconds << " emulated seconds in " << wall_seconds << " wall seconds; ";
+	std::cout << ratio << " emulated seconds per wall second; ";
+	std::cout << timed_machine->get_clock_rate() * ratio << " machine cycles per wall second." << std::endl;
+	if(hash) {
+		std::cout << hashing_scan_target.frame_count() << " frames; final frame hash " << std::hex << hashing_scan_target.last_frame_hash() << std::dec;
+		if(const auto state_hash = machine->state_hash()) {
+			std::cout << "; final state hash " << std::hex << *state_hash << std::dec;
+		}
+		std::cout << "." << std::endl;
+	}
+
+	return EXIT_SUCCESS;
+}
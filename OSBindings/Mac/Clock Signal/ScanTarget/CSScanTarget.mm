@@ -691,10 +691,12 @@ using BufferingScanTarget = Outputs::Display::BufferingScanTarget;
 		/// Fragment shader that outputs directly as RGB, with gamma correction.
 		NSString *const directRGBWithGamma;
 	};
-	const FragmentSamplerDictionary samplerDictionary[8] = {
+	const FragmentSamplerDictionary samplerDictionary[12] = {
 		// Composite formats.
 		{@"compositeSampleLuminance1", 				nil,	@"sampleLuminance1",				@"sampleLuminance1",						@"sampleLuminance1",				@"sampleLuminance1"},
 		{@"compositeSampleLuminance8", 				nil,	@"sampleLuminance8", 				@"sampleLuminance8WithGamma",				@"sampleLuminance8", 				@"sampleLuminance8WithGamma"},
+		{@"compositeSampleLuminance1Packed", 		nil,	@"sampleLuminance1Packed",			@"sampleLuminance1Packed",					@"sampleLuminance1Packed",			@"sampleLuminance1Packed"},
+		{@"compositeSampleLuminance2Packed", 		nil,	@"sampleLuminance2Packed", 			@"sampleLuminance2PackedWithGamma",			@"sampleLuminance2Packed", 			@"sampleLuminance2PackedWithGamma"},
 		{@"compositeSamplePhaseLinkedLuminance8", 	nil,	@"samplePhaseLinkedLuminance8",		@"samplePhaseLinkedLuminance8WithGamma",	@"samplePhaseLinkedLuminance8",		@"samplePhaseLinkedLuminance8WithGamma"},
 
 		// S-Video formats.
@@ -705,11 +707,15 @@ using BufferingScanTarget = Outputs::Display::BufferingScanTarget;
 		{@"compositeSampleRed2Green2Blue2", @"svideoSampleRed2Green2Blue2", @"directCompositeSampleRed2Green2Blue2", @"directCompositeSampleRed2Green2Blue2WithGamma", @"sampleRed2Green2Blue2", @"sampleRed2Green2Blue2WithGamma"},
 		{@"compositeSampleRed4Green4Blue4", @"svideoSampleRed4Green4Blue4", @"directCompositeSampleRed4Green4Blue4", @"directCompositeSampleRed4Green4Blue4WithGamma", @"sampleRed4Green4Blue4", @"sampleRed4Green4Blue4WithGamma"},
 		{@"compositeSampleRed8Green8Blue8", @"svideoSampleRed8Green8Blue8", @"directCompositeSampleRed8Green8Blue8", @"directCompositeSampleRed8Green8Blue8WithGamma", @"sampleRed8Green8Blue8", @"sampleRed8Green8Blue8WithGamma"},
+
+		// Palette-indexed formats.
+		{@"compositeSamplePalette8", @"svideoSamplePalette8", @"directCompositeSamplePalette8", @"directCompositeSamplePalette8WithGamma", @"samplePalette8", @"samplePalette8WithGamma"},
+		{@"compositeSamplePalette4Packed", @"svideoSamplePalette4Packed", @"directCompositeSamplePalette4Packed", @"directCompositeSamplePalette4PackedWithGamma", @"samplePalette4Packed", @"samplePalette4PackedWithGamma"},
 	};
 
 #ifndef NDEBUG
 	// Do a quick check that all the shaders named above are defined in the Metal code. I don't think this is possible at compile time.
-	for(int c = 0; c < 8; ++c) {
+	for(int c = 0; c < 12; ++c) {
 #define Test(x)	if(samplerDictionary[c].x)	assert([library newFunctionWithName:samplerDictionary[c].x]);
 		Test(compositionComposite);
 		Test(compositionSVideo);
@@ -72,6 +72,7 @@ struct Scan {
 	uint8_t compositeAmplitude;
 	uint16_t dataY;
 	uint16_t line;
+	uint16_t paletteX, paletteY;
 };
 
 // This matches the BufferingScanTarget's `Line`.
@@ -94,6 +95,7 @@ struct SourceInterpolator {
 	float unitColourPhase;		// i.e. one unit per circle.
 	float colourPhase;			// i.e. 2*pi units per circle, just regular radians.
 	half colourAmplitude [[flat]];
+	float2 paletteLocation [[flat]];	// Meaningful only for scans of palette-indexed data.
 };
 
 struct CopyInterpolator {
@@ -115,6 +117,14 @@ float2 textureLocation(constant Scan *scan, float offset, constant Uniforms &) {
 		scan->dataY + 0.5f);
 }
 
+float2 paletteLocation(constant Line *) {
+	return float2(0.0f);
+}
+
+float2 paletteLocation(constant Scan *scan) {
+	return float2(scan->paletteX, scan->paletteY);
+}
+
 template <typename Input> SourceInterpolator toDisplay(
 	constant Uniforms &uniforms [[buffer(1)]],
 	constant Input *inputs [[buffer(0)]],
@@ -157,6 +167,7 @@ template <typename Input> SourceInterpolator toDisplay(
 		1.0f
 	);
 	output.textureCoordinates = textureLocation(&inputs[instanceID], float((vertexID&2) >> 1), uniforms);
+	output.paletteLocation = paletteLocation(&inputs[instanceID]);
 
 	return output;
 }
@@ -194,6 +205,7 @@ vertex SourceInterpolator scanToComposition(	constant Uniforms &uniforms [[buffe
 
 	result.textureCoordinates.x = mix(scans[instanceID].endPoints[0].dataOffset, scans[instanceID].endPoints[1].dataOffset, float(vertexID));
 	result.textureCoordinates.y = scans[instanceID].dataY;
+	result.paletteLocation = paletteLocation(&scans[instanceID]);
 
 	result.unitColourPhase = mix(
 		float(scans[instanceID].endPoints[0].compositeAngle),
@@ -258,6 +270,17 @@ half convertLuminance8(SourceInterpolator vert [[stage_in]], texture2d<half> tex
 	return texture.sample(standardSampler, vert.textureCoordinates).r;
 }
 
+// The packed formats use the fractional part of the texture coordinate to pick a pixel from within each byte.
+half convertLuminance1Packed(SourceInterpolator vert [[stage_in]], texture2d<ushort> texture [[texture(0)]]) {
+	const ushort shift = 7 - ushort(fract(vert.textureCoordinates.x) * 8.0f);
+	return half((texture.sample(standardSampler, vert.textureCoordinates).r >> shift) & 1);
+}
+
+half convertLuminance2Packed(SourceInterpolator vert [[stage_in]], texture2d<ushort> texture [[texture(0)]]) {
+	const ushort shift = (3 - ushort(fract(vert.textureCoordinates.x) * 4.0f)) * 2;
+	return half((texture.sample(standardSampler, vert.textureCoordinates).r >> shift) & 3) / half(3.0f);
+}
+
 half convertPhaseLinkedLuminance8(SourceInterpolator vert [[stage_in]], texture2d<half> texture [[texture(0)]]) {
 	const int offset = int(vert.unitColourPhase * 4.0f) & 3;
 	auto sample = texture.sample(standardSampler, vert.textureCoordinates);
@@ -283,6 +306,8 @@ half convertPhaseLinkedLuminance8(SourceInterpolator vert [[stage_in]], texture2
 
 CompositeSet(Luminance1, ushort);
 CompositeSet(Luminance8, half);
+CompositeSet(Luminance1Packed, ushort);
+CompositeSet(Luminance2Packed, ushort);
 CompositeSet(PhaseLinkedLuminance8, half);
 
 #undef CompositeSet
@@ -345,6 +370,24 @@ half3 convertRed1Green1Blue1(SourceInterpolator vert, texture2d<ushort> texture)
 	return clamp(half3(sample&4, sample&2, sample&1), half(0.0f), half(1.0f));
 }
 
+// The palette-indexed formats look up each index in the palette that the BufferingScanTarget placed
+// in the write area, four samples per entry.
+
+half3 paletteColour(SourceInterpolator vert, texture2d<ushort> texture, ushort index) {
+	const uint2 entry = uint2(vert.paletteLocation) + uint2(index * 4, 0);
+	return half3(texture.read(entry).r, texture.read(entry + uint2(1, 0)).r, texture.read(entry + uint2(2, 0)).r) / 255.0f;
+}
+
+half3 convertPalette8(SourceInterpolator vert, texture2d<ushort> texture) {
+	return paletteColour(vert, texture, texture.sample(standardSampler, vert.textureCoordinates).r);
+}
+
+half3 convertPalette4Packed(SourceInterpolator vert, texture2d<ushort> texture) {
+	const auto sample = texture.sample(standardSampler, vert.textureCoordinates).r;
+	const ushort shift = fract(vert.textureCoordinates.x) < 0.5f ? 4 : 0;
+	return paletteColour(vert, texture, (sample >> shift) & 15);
+}
+
 #define DeclareShaders(name, pixelType)	\
 	fragment half4 sample##name(SourceInterpolator vert [[stage_in]], texture2d<pixelType> texture [[texture(0)]], constant Uniforms &uniforms [[buffer(0)]]) {	\
 		return half4(convert##name(vert, texture), uniforms.outputAlpha);	\
@@ -389,6 +432,8 @@ DeclareShaders(Red8Green8Blue8, half)
 DeclareShaders(Red4Green4Blue4, ushort)
 DeclareShaders(Red2Green2Blue2, ushort)
 DeclareShaders(Red1Green1Blue1, ushort)
+DeclareShaders(Palette8, ushort)
+DeclareShaders(Palette4Packed, ushort)
 
 fragment half4 copyFragment(CopyInterpolator vert [[stage_in]], texture2d<half> texture [[texture(0)]]) {
 	return texture.sample(standardSampler, vert.textureCoordinates);
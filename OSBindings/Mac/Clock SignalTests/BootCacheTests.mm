@@ -0,0 +1,225 @@
+//
+//  BootCacheTests.mm
+//  Clock SignalTests
+//
+//  Created by Thomas Harte on 14/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#include "../../../Machines/Utility/BootCache.hpp"
+#include "../../../Analyser/Static/MSX/Target.hpp"
+
+#include <cstdio>
+#include <dirent.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct BootState: public Reflection::StructImpl<BootState> {
+	uint32_t frame = 0;
+	std::vector<uint8_t> ram;
+
+	BootState() {
+		if(needs_declare()) {
+			DeclareField(frame);
+			DeclareField(ram);
+		}
+	}
+};
+
+/// A minimal state producer, standing in for a machine.
+struct BootStateProducer: public MachineTypes::StateProducer {
+	BootState state;
+
+	std::unique_ptr<Reflection::Struct> get_state() final {
+		return std::make_unique<BootState>(state);
+	}
+
+	bool set_state(const Reflection::Struct &source) final {
+		const auto boot_state = dynamic_cast<const BootState *>(&source);
+		if(!boot_state) return false;
+		state = *boot_state;
+		return true;
+	}
+
+	/// Simulates having run for a frame.
+	void run_frame() {
+		++state.frame;
+		state.ram[state.frame % state.ram.size()] ^= uint8_t(state.frame);
+	}
+};
+
+BootStateProducer fresh_producer() {
+	BootStateProducer producer;
+	producer.state.ram.resize(1024);
+	return producer;
+}
+
+/// Runs @c producer under @c cache for @c frames frames of an eighth of a second, which sum exactly.
+void boot(BootStateProducer &producer, Machine::BootCache &cache, int frames) {
+	for(int c = 0; c < frames; c++) {
+		producer.run_frame();
+		cache.advance(producer, 0.125);
+	}
+}
+
+ROM::Map sample_roms() {
+	ROM::Map roms;
+	roms[ROM::Name::MSXGenericBIOS] = std::vector<uint8_t>(32768, 0xc9);
+	return roms;
+}
+
+std::vector<std::string> files_in(const std::string &directory) {
+	std::vector<std::string> files;
+	DIR *const dir = opendir(directory.c_str());
+	if(!dir) return files;
+	while(const dirent *const entry = readdir(dir)) {
+		if(entry->d_name[0] != '.') files.push_back(directory + "/" + entry->d_name);
+	}
+	closedir(dir);
+	return files;
+}
+
+}
+
+@interface BootCacheTests : XCTestCase
+@end
+
+@implementation BootCacheTests {
+	std::string _directory;
+}
+
+- (void)setUp {
+	NSString *const directory = [NSTemporaryDirectory() stringByAppendingPathComponent:[[NSUUID UUID] UUIDString]];
+	[[NSFileManager defaultManager] createDirectoryAtPath:directory withIntermediateDirectories:YES attributes:nil error:nil];
+	_directory = directory.UTF8String;
+}
+
+- (void)tearDown {
+	[[NSFileManager defaultManager] removeItemAtPath:[NSString stringWithUTF8String:_directory.c_str()] error:nil];
+}
+
+- (void)testRoundTrip {
+	const Analyser::Static::MSX::Target target;
+	const auto roms = sample_roms();
+
+	// The first launch finds nothing, and captures a state at the end of boot.
+	BootStateProducer first = fresh_producer();
+	BootState booted;
+	{
+		Machine::BootCache cache(_directory, target, roms, 1.0);
+		XCTAssertFalse(cache.restore(first));
+		boot(first, cache, 8);
+		booted = first.state;
+
+		// Running on after boot doesn't affect what was captured.
+		boot(first, cache, 4);
+	}
+
+	// The next launch of the same machine resumes from the end of boot.
+	BootStateProducer second = fresh_producer();
+	Machine::BootCache cache(_directory, target, roms, 1.0);
+	XCTAssertTrue(cache.restore(second));
+	XCTAssertEqual(second.state.frame, booted.frame);
+	XCTAssert(second.state.ram == booted.ram);
+}
+
+- (void)testCancelledBootIsNotCaptured {
+	const Analyser::Static::MSX::Target target;
+	const auto roms = sample_roms();
+
+	BootStateProducer producer = fresh_producer();
+	{
+		Machine::BootCache cache(_directory, target, roms, 1.0);
+		XCTAssertFalse(cache.restore(producer));
+		boot(producer, cache, 5);
+		cache.cancel();
+		boot(producer, cache, 8);
+	}
+
+	Machine::BootCache cache(_directory, target, roms, 1.0);
+	XCTAssertFalse(cache.restore(producer));
+}
+
+- (void)testKeyCoversTargetROMsAndDuration {
+	Analyser::Static::MSX::Target target;
+	const auto roms = sample_roms();
+	{
+		BootStateProducer producer = fresh_producer();
+		Machine::BootCache cache(_directory, target, roms, 1.0);
+		cache.restore(producer);
+		boot(producer, cache, 8);
+	}
+
+	BootStateProducer producer = fresh_producer();
+	{
+		Machine::BootCache cache(_directory, target, roms, 2.0);
+		XCTAssertFalse(cache.restore(producer), @"A different boot duration should miss");
+	}
+	{
+		auto other_roms = roms;
+		other_roms[ROM::Name::MSXGenericBIOS][0] = 0x00;
+		Machine::BootCache cache(_directory, target, other_roms, 1.0);
+		XCTAssertFalse(cache.restore(producer), @"Different ROM contents should miss");
+	}
+	{
+		Analyser::Static::MSX::Target other_target;
+		other_target.region = Analyser::Static::MSX::Target::Region::Japan;
+		Machine::BootCache cache(_directory, other_target, roms, 1.0);
+		XCTAssertFalse(cache.restore(producer), @"A different target should miss");
+	}
+	{
+		Machine::BootCache cache(_directory, target, roms, 1.0);
+		XCTAssertTrue(cache.restore(producer), @"The original configuration should still hit");
+	}
+}
+
+- (void)testTargetsWithMediaAreNotCached {
+	Analyser::Static::MSX::Target target;
+	target.media.cartridges.push_back(nullptr);
+	const auto roms = sample_roms();
+
+	for(int c = 0; c < 2; c++) {
+		BootStateProducer producer = fresh_producer();
+		Machine::BootCache cache(_directory, target, roms, 1.0);
+		XCTAssertFalse(cache.restore(producer));
+		boot(producer, cache, 8);
+	}
+	XCTAssertTrue(files_in(_directory).empty());
+}
+
+- (void)testCorruptStateIsIgnored {
+	const Analyser::Static::MSX::Target target;
+	const auto roms = sample_roms();
+	{
+		BootStateProducer producer = fresh_producer();
+		Machine::BootCache cache(_directory, target, roms, 1.0);
+		cache.restore(producer);
+		boot(producer, cache, 8);
+	}
+
+	// Truncate the stored state.
+	const auto files = files_in(_directory);
+	XCTAssertEqual(files.size(), 1);
+	for(const auto &file: files) {
+		std::vector<uint8_t> contents(1024 * 1024);
+		FILE *handle = fopen(file.c_str(), "rb");
+		contents.resize(fread(contents.data(), 1, contents.size(), handle));
+		fclose(handle);
+
+		handle = fopen(file.c_str(), "wb");
+		fwrite(contents.data(), 1, contents.size() - 8, handle);
+		fclose(handle);
+	}
+
+	BootStateProducer producer = fresh_producer();
+	Machine::BootCache cache(_directory, target, roms, 1.0);
+	XCTAssertFalse(cache.restore(producer));
+	XCTAssertEqual(producer.state.frame, 0);
+}
+
+@end
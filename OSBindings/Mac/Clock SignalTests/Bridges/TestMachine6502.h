@@ -48,7 +48,11 @@ extern const uint8_t CSTestMachine6502JamOpcode;
 
 @property (nonatomic, readonly) BOOL isJammed;
 @property (nonatomic, readonly) uint32_t timestamp;
+@property (nonatomic, readonly) uint64_t instructionCount;
 @property (nonatomic, assign) BOOL irqLine;
 @property (nonatomic, assign) BOOL nmiLine;
 
+/// Runs code via InstructionSet::MOS6502::Executor where the processor supports it; see CPU::MOS6502::AllRAMProcessor::set_uses_caching_executor.
+@property (nonatomic, assign) BOOL usesCachingExecutor;
+
 @end
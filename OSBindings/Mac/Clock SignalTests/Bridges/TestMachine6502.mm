@@ -94,6 +94,10 @@ static CPU::MOS6502::Register registerForRegister(CSTestMachine6502Register reg)
 	return uint32_t(_processor->get_timestamp().as_integral());
 }
 
+- (uint64_t)instructionCount {
+	return _processor->get_instruction_count();
+}
+
 - (void)setIrqLine:(BOOL)irqLine {
 	_irqLine = irqLine;
 	_processor->set_irq_line(irqLine);
@@ -104,6 +108,11 @@ static CPU::MOS6502::Register registerForRegister(CSTestMachine6502Register reg)
 	_processor->set_nmi_line(nmiLine);
 }
 
+- (void)setUsesCachingExecutor:(BOOL)usesCachingExecutor {
+	_usesCachingExecutor = usesCachingExecutor;
+	_processor->set_uses_caching_executor(usesCachingExecutor ? true : false);
+}
+
 - (CPU::AllRAMProcessor *)processor {
 	return _processor;
 }
@@ -53,6 +53,9 @@ typedef NS_ENUM(NSInteger, CSTestMachinePortLogic) {
 
 @interface CSTestMachineZ80 : CSTestMachine
 
+/// Creates a machine whose Z80 announces only those bus cycles that transfer data or refresh memory.
+- (nonnull instancetype)initWithCoarseTiming:(BOOL)coarseTiming;
+
 - (void)setData:(nonnull NSData *)data atAddress:(uint16_t)startAddress;
 - (void)setValue:(uint8_t)value atAddress:(uint16_t)address;
 - (uint8_t)valueAtAddress:(uint16_t)address;
@@ -75,4 +78,7 @@ typedef NS_ENUM(NSInteger, CSTestMachinePortLogic) {
 
 @property(nonatomic) CSTestMachinePortLogic portLogic;
 
+/// Runs code via InstructionSet::Z80::Executor whenever bus activity isn't being captured; see CPU::Z80::AllRAMProcessor::set_uses_caching_executor.
+@property(nonatomic) BOOL usesCachingExecutor;
+
 @end
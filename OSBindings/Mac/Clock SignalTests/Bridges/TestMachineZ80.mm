@@ -122,8 +122,12 @@ struct PortAccessDelegate191: public CPU::Z80::AllRAMProcessor::PortAccessDelega
 #pragma mark - Lifecycle
 
 - (instancetype)init {
+	return [self initWithCoarseTiming:NO];
+}
+
+- (instancetype)initWithCoarseTiming:(BOOL)coarseTiming {
 	if(self = [super init]) {
-		_processor = CPU::Z80::AllRAMProcessor::Processor();
+		_processor = CPU::Z80::AllRAMProcessor::Processor(coarseTiming);
 		_processor->reset_power_on();
 		_busOperationHandler = new BusOperationHandler(self);
 		_busOperationCaptures = [[NSMutableArray alloc] init];
@@ -201,6 +205,11 @@ struct PortAccessDelegate191: public CPU::Z80::AllRAMProcessor::PortAccessDelega
 	}
 }
 
+- (void)setUsesCachingExecutor:(BOOL)usesCachingExecutor {
+	_usesCachingExecutor = usesCachingExecutor;
+	_processor->set_uses_caching_executor(usesCachingExecutor ? true : false);
+}
+
 - (CPU::AllRAMProcessor *)processor {
 	return _processor;
 }
@@ -0,0 +1,236 @@
+//
+//  InputMovieTests.mm
+//  Clock SignalTests
+//
+//  Created by Thomas Harte on 14/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#include "../../../Machines/Utility/InputMovie.hpp"
+#include "../../../Machines/KeyboardMachine.hpp"
+#include "../../../Machines/MouseMachine.hpp"
+#include "../../../Machines/TimedMachine.hpp"
+#include "../../../Inputs/Keyboard.hpp"
+#include "../../../Inputs/Mouse.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace {
+
+/// A machine with a keyboard and a mouse that logs each input against the emulated time at which it arrived.
+class LoggingMachine:
+	public Machine::DynamicMachine,
+	public MachineTypes::TimedMachine,
+	public MachineTypes::KeyboardMachine,
+	public MachineTypes::MouseMachine,
+	public Inputs::Keyboard::Delegate,
+	public Inputs::Mouse {
+	public:
+		struct Record {
+			Time::Nanos time;
+			std::string description;
+
+			bool operator ==(const Record &rhs) const {
+				return time == rhs.time && description == rhs.description;
+			}
+		};
+		std::vector<Record> log;
+
+		LoggingMachine() {
+			keyboard_.set_delegate(this);
+		}
+
+		// DynamicMachine.
+		Activity::Source *activity_source() final 				{	return nullptr;	}
+		Configurable::Device *configurable_device() final		{	return nullptr;	}
+		MachineTypes::TimedMachine *timed_machine() final		{	return this;	}
+		MachineTypes::ScanProducer *scan_producer() final		{	return nullptr;	}
+		MachineTypes::AudioProducer *audio_producer() final		{	return nullptr;	}
+		MachineTypes::JoystickMachine *joystick_machine() final	{	return nullptr;	}
+		MachineTypes::KeyboardMachine *keyboard_machine() final	{	return this;	}
+		MachineTypes::MouseMachine *mouse_machine() final		{	return this;	}
+		MachineTypes::MediaTarget *media_target() final			{	return nullptr;	}
+		MachineTypes::StateProducer *state_producer() final		{	return nullptr;	}
+		MachineTypes::MemoryReporter *memory_reporter() final	{	return nullptr;	}
+		void *raw_pointer() final								{	return this;	}
+
+		// TimedMachine; time is kept to the nanosecond rather than rounded to whole cycles.
+		void run_for(Time::Seconds duration) final {
+			time_ += Time::Nanos(std::round(duration * 1e9));
+		}
+
+		// KeyboardMachine.
+		Inputs::Keyboard &get_keyboard() final {
+			return keyboard_;
+		}
+		bool keyboard_did_change_key(Inputs::Keyboard *, Inputs::Keyboard::Key key, bool is_pressed) final {
+			add("key " + std::to_string(int(key)) + (is_pressed ? " down" : " up"));
+			return true;
+		}
+		void reset_all_keys(Inputs::Keyboard *) final {
+			add("reset");
+		}
+
+		// MouseMachine.
+		Inputs::Mouse &get_mouse() final {
+			return *this;
+		}
+		void move(int x, int y) final {
+			add("move " + std::to_string(x) + "," + std::to_string(y));
+		}
+		int get_number_of_buttons() final {
+			return 2;
+		}
+		void set_button_pressed(int index, bool is_pressed) final {
+			add("button " + std::to_string(index) + (is_pressed ? " down" : " up"));
+		}
+
+	private:
+		Inputs::Keyboard keyboard_;
+		Time::Nanos time_ = 0;
+
+		void run_for(const Cycles) final {}
+
+		void add(const std::string &description) {
+			log.push_back(Record{time_, description});
+		}
+};
+
+Machine::InputMovie sample_movie() {
+	Machine::InputRecorder recorder;
+	recorder.advance(0.02);
+	recorder.record(Inputs::InputEvent::key_event(Inputs::Keyboard::Key::A, 'a', true));
+	recorder.advance(0.04);
+	recorder.record(Inputs::InputEvent::key_event(Inputs::Keyboard::Key::A, 'a', false));
+	recorder.record(Inputs::InputEvent::mouse_motion_event(-3, 7));
+	recorder.advance(0.5);
+	recorder.record(Inputs::InputEvent::mouse_button_event(1, true));
+	recorder.advance(0.25);
+	recorder.record(Inputs::InputEvent::mouse_button_event(1, false));
+	recorder.record(Inputs::InputEvent::reset_keys_event());
+	return recorder.movie();
+}
+
+/// Replays @c movie onto a fresh machine in slices of @c slice seconds, for @c duration seconds.
+std::vector<LoggingMachine::Record> replay(const Machine::InputMovie &movie, double slice, double duration) {
+	LoggingMachine machine;
+	Machine::InputPlayer player(movie);
+	for(double time = 0.0; time < duration; time += slice) {
+		player.run_for(machine, slice);
+	}
+	return machine.log;
+}
+
+}
+
+@interface InputMovieTests : XCTestCase
+@end
+
+@implementation InputMovieTests {
+	std::string _file_name;
+}
+
+- (void)setUp {
+	NSString *const file_name = [NSTemporaryDirectory() stringByAppendingPathComponent:[[NSUUID UUID] UUIDString]];
+	_file_name = file_name.UTF8String;
+}
+
+- (void)tearDown {
+	remove(_file_name.c_str());
+}
+
+- (void)testFileRoundTrip {
+	Machine::InputMovie movie = sample_movie();
+	Inputs::InputEvent analogue = Inputs::InputEvent::joystick_event(1, Inputs::Joystick::Input(Inputs::Joystick::Input::Horizontal), 0.375f);
+	movie.add(movie.duration() + 1, analogue);
+
+	XCTAssertTrue(movie.write(_file_name));
+	const auto read = Machine::InputMovie::read(_file_name);
+	XCTAssertTrue(read.has_value());
+	if(!read) return;
+
+	XCTAssertEqual(read->entries().size(), movie.entries().size());
+	XCTAssertEqual(read->duration(), movie.duration());
+	for(size_t c = 0; c < std::min(read->entries().size(), movie.entries().size()); c++) {
+		const auto &lhs = read->entries()[c];
+		const auto &rhs = movie.entries()[c];
+		XCTAssertEqual(lhs.time, rhs.time);
+		XCTAssert(lhs.event.type == rhs.event.type);
+		XCTAssertEqual(lhs.event.is_pressed, rhs.event.is_pressed);
+		XCTAssert(lhs.event.key == rhs.event.key);
+		XCTAssertEqual(lhs.event.symbol, rhs.event.symbol);
+		XCTAssertEqual(lhs.event.is_logical, rhs.event.is_logical);
+		XCTAssertEqual(lhs.event.has_fallback, rhs.event.has_fallback);
+		XCTAssertEqual(lhs.event.joystick, rhs.event.joystick);
+		XCTAssert(lhs.event.input_type == rhs.event.input_type);
+		XCTAssertEqual(lhs.event.input_info, rhs.event.input_info);
+		XCTAssertEqual(lhs.event.value, rhs.event.value);
+		XCTAssertEqual(lhs.event.x, rhs.event.x);
+		XCTAssertEqual(lhs.event.y, rhs.event.y);
+		XCTAssertEqual(lhs.event.button, rhs.event.button);
+	}
+}
+
+- (void)testMalformedFilesAreRejected {
+	FILE *file = fopen(_file_name.c_str(), "w");
+	fputs("Not a movie\n", file);
+	fclose(file);
+	XCTAssertFalse(Machine::InputMovie::read(_file_name).has_value());
+
+	// Events out of time order.
+	Machine::InputMovie movie;
+	movie.add(200, Inputs::InputEvent::reset_keys_event());
+	movie.add(100, Inputs::InputEvent::reset_keys_event());
+	XCTAssertTrue(movie.write(_file_name));
+	XCTAssertFalse(Machine::InputMovie::read(_file_name).has_value());
+}
+
+- (void)testReplayAppliesEventsAtRecordedTimes {
+	const auto log = replay(sample_movie(), 0.1, 1.0);
+
+	XCTAssertEqual(log.size(), 6);
+	if(log.size() != 6) return;
+
+	XCTAssertEqual(log[0].time, 20'000'000);
+	XCTAssert(log[0].description == "key " + std::to_string(int(Inputs::Keyboard::Key::A)) + " down");
+	XCTAssertEqual(log[1].time, 60'000'000);
+	XCTAssert(log[1].description == "key " + std::to_string(int(Inputs::Keyboard::Key::A)) + " up");
+	XCTAssertEqual(log[2].time, 60'000'000);
+	XCTAssert(log[2].description == "move -3,7");
+	XCTAssertEqual(log[3].time, 560'000'000);
+	XCTAssert(log[3].description == "button 1 down");
+	XCTAssertEqual(log[4].time, 810'000'000);
+	XCTAssert(log[4].description == "button 1 up");
+	XCTAssertEqual(log[5].time, 810'000'000);
+	XCTAssert(log[5].description == "reset");
+}
+
+- (void)testReplayIsIndependentOfSlicing {
+	const auto movie = sample_movie();
+	const auto reference = replay(movie, 1.0, 1.0);
+	XCTAssert(replay(movie, 0.01, 1.0) == reference);
+	XCTAssert(replay(movie, 0.3, 1.0) == reference);
+}
+
+- (void)testReplayOfRecordedFile {
+	XCTAssertTrue(sample_movie().write(_file_name));
+	const auto movie = Machine::InputMovie::read(_file_name);
+	XCTAssertTrue(movie.has_value());
+	if(!movie) return;
+
+	XCTAssert(replay(*movie, 0.1, 1.0) == replay(sample_movie(), 0.1, 1.0));
+
+	Machine::InputPlayer player(*movie);
+	LoggingMachine machine;
+	player.run_for(machine, 0.5);
+	XCTAssertFalse(player.is_finished());
+	player.run_for(machine, 0.5);
+	XCTAssertTrue(player.is_finished());
+}
+
+@end
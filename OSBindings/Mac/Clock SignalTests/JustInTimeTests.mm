@@ -0,0 +1,115 @@
+//
+//  JustInTimeTests.mm
+//  Clock SignalTests
+//
+//  Created by Thomas Harte on 14/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#include "../../../ClockReceiver/JustInTime.hpp"
+
+namespace {
+
+/// Counts the cycles it is run for, and declares a sequence point every @c Period cycles.
+struct SequencedCounter {
+	static constexpr Cycles::IntType Period = 10;
+	Cycles::IntType total = 0;
+
+	void run_for(Cycles cycles) {
+		total += cycles.as_integral();
+	}
+
+	Cycles get_next_sequence_point() const {
+		return Cycles(Period - (total % Period));
+	}
+};
+
+/// Feeds identical time to a JustInTimeActor and an AsyncJustInTimeActor with the same scaling, and
+/// checks that they predict, perform and deliver flushes identically.
+template <int multiplier, int divider> bool actors_agree() {
+	JustInTimeActor<SequencedCounter, Cycles, multiplier, divider> sync;
+	AsyncJustInTimeActor<SequencedCounter, Cycles, multiplier, divider> async(Cycles(3));
+
+	int flushes = 0;
+	for(int step = 0; step < 1000; step++) {
+		const Cycles length((step % 5) + 1);
+
+		if(sync.cycles_until_implicit_flush() != async.cycles_until_implicit_flush()) return false;
+		if(sync.will_flush(length) != async.will_flush(length)) return false;
+
+		// Adding exactly the predicted time to the next flush should trigger it; any less shouldn't.
+		const auto until_flush = async.cycles_until_implicit_flush();
+		if(!async.will_flush(until_flush)) return false;
+		if(until_flush > Cycles(1) && async.will_flush(until_flush - Cycles(1))) return false;
+
+		const bool will_flush = async.will_flush(length);
+		const bool sync_flushed = sync += length;
+		const bool async_flushed = async += length;
+		if(sync_flushed != async_flushed || async_flushed != will_flush) return false;
+
+		if(async_flushed) {
+			++flushes;
+			if(sync.last_valid()->total != async.last_valid()->total) return false;
+		}
+	}
+
+	sync.flush();
+	async.flush();
+	return flushes > 0 && sync.last_valid()->total == async.last_valid()->total;
+}
+
+}
+
+@interface JustInTimeTests : XCTestCase
+@end
+
+@implementation JustInTimeTests
+
+- (void)testAsyncFlushesAtSequencePoints {
+	AsyncJustInTimeActor<SequencedCounter, Cycles> actor(Cycles(3));
+
+	// The first addition establishes the next sequence point.
+	XCTAssertTrue(actor += Cycles(1));
+	for(Cycles::IntType total = 2; total < 100; total++) {
+		const bool did_flush = actor += Cycles(1);
+		XCTAssertEqual(did_flush, !(total % SequencedCounter::Period));
+
+		// The object may be reading only once the actor has synchronised with it.
+		if(did_flush) XCTAssertEqual(actor.last_valid()->total, total);
+	}
+}
+
+- (void)testAsyncFlushPredictionWithDivider {
+	// Two local cycles per target cycle: the sequence point 10 target cycles away is 20 local cycles away,
+	// including any half-cycle remainder left by the previous flush.
+	AsyncJustInTimeActor<SequencedCounter, Cycles, 1, 2> actor(Cycles(3));
+	XCTAssertTrue(actor += Cycles(3));
+	XCTAssertEqual(actor.last_valid()->total, 1);
+	XCTAssertEqual(actor.cycles_until_implicit_flush(), Cycles(17));
+	XCTAssertFalse(actor.will_flush(Cycles(16)));
+	XCTAssertTrue(actor.will_flush(Cycles(17)));
+
+	XCTAssertFalse(actor += Cycles(16));
+	XCTAssertTrue(actor += Cycles(1));
+	XCTAssertEqual(actor.last_valid()->total, 10);
+}
+
+- (void)testAsyncFlushPredictionWithMultiplier {
+	// Three target cycles per local cycle: 10 target cycles are reached within four local cycles.
+	AsyncJustInTimeActor<SequencedCounter, Cycles, 3, 1> actor(Cycles(3));
+	XCTAssertTrue(actor += Cycles(1));
+	XCTAssertEqual(actor.cycles_until_implicit_flush(), Cycles(3));
+	XCTAssertFalse(actor.will_flush(Cycles(2)));
+	XCTAssertTrue(actor.will_flush(Cycles(3)));
+}
+
+- (void)testAsyncMatchesSynchronousActor {
+	XCTAssertTrue((actors_agree<1, 1>()));
+	XCTAssertTrue((actors_agree<1, 2>()));
+	XCTAssertTrue((actors_agree<3, 1>()));
+	XCTAssertTrue((actors_agree<3, 2>()));
+}
+
+@end
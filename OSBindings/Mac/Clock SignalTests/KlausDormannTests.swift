@@ -11,14 +11,16 @@ import XCTest
 
 class KlausDormannTests: XCTestCase {
 
-	private func runTest(resource: String, processor: CSTestMachine6502Processor) -> UInt16 {
+	private func runTest(resource: String, processor: CSTestMachine6502Processor, cachingExecutor: Bool = false) -> UInt16 {
 		if let filename = Bundle(for: type(of: self)).path(forResource: resource, ofType: "bin") {
 			if let functionalTest = try? Data(contentsOf: URL(fileURLWithPath: filename)) {
 				let machine = CSTestMachine6502(processor: processor)
+				machine.usesCachingExecutor = cachingExecutor
 
 				machine.setData(functionalTest, atAddress: 0)
 				machine.setValue(0x400, for: .programCounter)
 
+				let startDate = Date()
 				while true {
 					let oldPC = machine.value(for: .lastOperationAddress)
 					machine.runForNumber(ofCycles: 1000)
@@ -29,6 +31,12 @@ class KlausDormannTests: XCTestCase {
 
 						let retestPC = machine.value(for: .lastOperationAddress)
 						if retestPC == oldPC {
+							// The caching executor doesn't count instructions, so report its throughput in cycles.
+							if cachingExecutor {
+								print("\(resource), caching executor: \(Double(machine.timestamp) / 2.0 / -startDate.timeIntervalSinceNow / 1_000_000.0) Mhz")
+							} else {
+								print("\(resource): \(Double(machine.instructionCount) / -startDate.timeIntervalSinceNow / 1_000_000.0) MIPS")
+							}
 							return newPC
 						}
 					}
@@ -39,7 +47,7 @@ class KlausDormannTests: XCTestCase {
 		return 0
 	}
 
-	private func runTest6502(processor: CSTestMachine6502Processor) {
+	private func runTest6502(processor: CSTestMachine6502Processor, cachingExecutor: Bool = false) {
 		func errorForTrapAddress(_ address: UInt16) -> String? {
 			switch address {
 				case 0x3399: return nil // success!
@@ -65,7 +73,7 @@ class KlausDormannTests: XCTestCase {
 			}
 		}
 
-		let destination = runTest(resource: "6502_functional_test", processor: processor)
+		let destination = runTest(resource: "6502_functional_test", processor: processor, cachingExecutor: cachingExecutor)
 		let error = errorForTrapAddress(destination)
 		XCTAssert(error == nil, "Failed with error \(error!)")
 	}
@@ -142,6 +150,11 @@ class KlausDormannTests: XCTestCase {
 		runTest6502(processor: .processor6502)
 	}
 
+	/// Runs Klaus Dormann's 6502 tests via the caching executor.
+	func test6502CachingExecutor() {
+		runTest6502(processor: .processor6502, cachingExecutor: true)
+	}
+
 	/// Runs Klaus Dormann's standard 6502 tests on a 65C02.
 	func test65C02As6502() {
 		runTest6502(processor: .processor65C02)
@@ -0,0 +1,224 @@
+//
+//  SnapshotTests.mm
+//  Clock SignalTests
+//
+//  Created by Thomas Harte on 14/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#include "../../../Reflection/Struct.hpp"
+#include "../../../Reflection/SnapshotDelta.hpp"
+
+#include <string>
+#include <vector>
+
+namespace {
+
+struct Registers: public Reflection::StructImpl<Registers> {
+	uint16_t pc = 0;
+	uint8_t a = 0, flags = 0;
+
+	Registers() {
+		if(needs_declare()) {
+			DeclareField(pc);
+			DeclareField(a);
+			DeclareField(flags);
+		}
+	}
+};
+
+struct SnapshotState: public Reflection::StructImpl<SnapshotState> {
+	Registers registers;
+	int32_t counter = 0;
+	bool is_halted = false;
+	uint8_t palette[16]{};
+	std::string name;
+	std::vector<uint8_t> ram;
+
+	SnapshotState() {
+		if(needs_declare()) {
+			DeclareField(registers);
+			DeclareField(counter);
+			DeclareField(is_halted);
+			DeclareField(palette);
+			DeclareField(name);
+			DeclareField(ram);
+		}
+	}
+};
+
+SnapshotState sample_state() {
+	SnapshotState state;
+	state.registers.pc = 0x1234;
+	state.registers.a = 0x56;
+	state.registers.flags = 0x78;
+	state.counter = -3;
+	state.is_halted = true;
+	for(int c = 0; c < 16; c++) state.palette[c] = uint8_t(c * 17);
+	state.name = "snapshot";
+	state.ram.resize(65536);
+	for(size_t c = 0; c < state.ram.size(); c++) state.ram[c] = uint8_t(c ^ (c >> 8));
+	return state;
+}
+
+bool operator ==(const SnapshotState &lhs, const SnapshotState &rhs) {
+	return
+		lhs.registers.pc == rhs.registers.pc &&
+		lhs.registers.a == rhs.registers.a &&
+		lhs.registers.flags == rhs.registers.flags &&
+		lhs.counter == rhs.counter &&
+		lhs.is_halted == rhs.is_halted &&
+		std::equal(std::begin(lhs.palette), std::end(lhs.palette), std::begin(rhs.palette)) &&
+		lhs.name == rhs.name &&
+		lhs.ram == rhs.ram;
+}
+
+}
+
+@interface SnapshotTests : XCTestCase
+@end
+
+@implementation SnapshotTests
+
+// MARK: - Snapshots
+
+- (void)testRoundTrip {
+	const SnapshotState source = sample_state();
+	const auto snapshot = source.snapshot();
+
+	SnapshotState destination;
+	XCTAssertTrue(destination.restore(snapshot));
+	XCTAssert(destination == source);
+}
+
+- (void)testSnapshotReusesTarget {
+	SnapshotState state = sample_state();
+	std::vector<uint8_t> snapshot = {1, 2, 3};
+	state.snapshot(snapshot);
+	XCTAssert(snapshot == state.snapshot());
+}
+
+- (void)testMalformedSnapshotsAreRejected {
+	const auto snapshot = sample_state().snapshot();
+
+	SnapshotState destination;
+	XCTAssertFalse(destination.restore(std::vector<uint8_t>(snapshot.begin(), snapshot.end() - 1)));
+
+	auto extended = snapshot;
+	extended.push_back(0);
+	XCTAssertFalse(destination.restore(extended));
+}
+
+// MARK: - Page deltas
+
+- (void)testPageDeltaRoundTrip {
+	SnapshotState state = sample_state();
+	const auto previous = state.snapshot();
+
+	state.registers.pc = 0x4321;
+	state.ram[0x100] ^= 0xff;
+	state.ram[0x8000] ^= 0xff;
+	state.ram[0x8001] ^= 0xff;
+	const auto current = state.snapshot();
+
+	const auto delta = Reflection::snapshot_delta(previous, current);
+	XCTAssertLessThanOrEqual(delta.size(), 8 * Reflection::SnapshotDeltaPageSize);
+
+	auto applied = previous;
+	XCTAssertTrue(Reflection::apply_snapshot_delta(applied, delta));
+	XCTAssert(applied == current);
+
+	// A delta in the opposite direction steps back again.
+	XCTAssertTrue(Reflection::apply_snapshot_delta(applied, Reflection::snapshot_delta(current, previous)));
+	XCTAssert(applied == previous);
+}
+
+- (void)testPageDeltaOfResizedSnapshot {
+	SnapshotState state = sample_state();
+	const auto previous = state.snapshot();
+
+	state.ram.resize(state.ram.size() + 300, 0xaa);
+	const auto longer = state.snapshot();
+
+	auto applied = previous;
+	XCTAssertTrue(Reflection::apply_snapshot_delta(applied, Reflection::snapshot_delta(previous, longer)));
+	XCTAssert(applied == longer);
+
+	XCTAssertTrue(Reflection::apply_snapshot_delta(applied, Reflection::snapshot_delta(longer, previous)));
+	XCTAssert(applied == previous);
+}
+
+- (void)testTruncatedPageDeltaIsRejected {
+	SnapshotState state = sample_state();
+	const auto previous = state.snapshot();
+	state.ram[0x2000] ^= 0xff;
+	const auto delta = Reflection::snapshot_delta(previous, state.snapshot());
+
+	auto applied = previous;
+	XCTAssertFalse(Reflection::apply_snapshot_delta(applied, std::vector<uint8_t>(delta.begin(), delta.end() - 1)));
+}
+
+// MARK: - XOR deltas
+
+- (void)testXORDeltaRunsInBothDirections {
+	SnapshotState state = sample_state();
+	const auto lhs = state.snapshot();
+
+	state.counter = 100;
+	state.ram[0x10] = 0;
+	state.ram[0xfff0] ^= 0x0f;
+	state.ram.resize(state.ram.size() - 1000);
+	const auto rhs = state.snapshot();
+
+	std::vector<uint8_t> delta;
+	Reflection::append_xor_delta(delta, lhs, rhs);
+	XCTAssertLessThan(delta.size(), 1200);
+
+	auto applied = lhs;
+	XCTAssertTrue(Reflection::apply_xor_delta(applied, delta.data(), delta.size()));
+	XCTAssert(applied == rhs);
+
+	XCTAssertTrue(Reflection::apply_xor_delta(applied, delta.data(), delta.size()));
+	XCTAssert(applied == lhs);
+}
+
+- (void)testXORDeltaChain {
+	// A history held as a single snapshot plus a chain of XOR records can be walked in either direction.
+	SnapshotState state = sample_state();
+	std::vector<std::vector<uint8_t>> history = {state.snapshot()};
+	std::vector<uint8_t> chain;
+	std::vector<size_t> offsets = {0};
+	for(int c = 0; c < 4; c++) {
+		state.counter += 1;
+		state.ram[size_t(c) * 0x1000] ^= 0x55;
+		history.push_back(state.snapshot());
+		Reflection::append_xor_delta(chain, history[history.size() - 2], history.back());
+		offsets.push_back(chain.size());
+	}
+
+	auto snapshot = history.back();
+	for(size_t c = history.size() - 1; c > 0; --c) {
+		XCTAssertTrue(Reflection::apply_xor_delta(snapshot, &chain[offsets[c - 1]], offsets[c] - offsets[c - 1]));
+		XCTAssert(snapshot == history[c - 1]);
+	}
+
+	SnapshotState restored;
+	XCTAssertTrue(restored.restore(snapshot));
+	XCTAssert(restored == sample_state());
+}
+
+- (void)testXORDeltaRejectsUnrelatedSnapshot {
+	const auto lhs = sample_state().snapshot();
+	std::vector<uint8_t> rhs = lhs;
+	rhs.resize(rhs.size() + 10);
+
+	std::vector<uint8_t> delta;
+	Reflection::append_xor_delta(delta, lhs, rhs);
+
+	std::vector<uint8_t> unrelated(lhs.size() + 5);
+	XCTAssertFalse(Reflection::apply_xor_delta(unrelated, delta.data(), delta.size()));
+}
+
+@end
@@ -0,0 +1,174 @@
+//
+//  TargetCacheTests.mm
+//  Clock SignalTests
+//
+//  Created by Thomas Harte on 14/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#include "../../../Analyser/Static/StaticAnalyser.hpp"
+#include "../../../Analyser/Static/TargetCache.hpp"
+#include "../../../Analyser/Static/Atari2600/Target.hpp"
+#include "../../../Analyser/Static/MSX/Target.hpp"
+#include "../../../Reflection/Struct.hpp"
+
+#include <cstdio>
+#include <dirent.h>
+#include <string>
+#include <vector>
+
+namespace {
+
+/// Writes an 8kb Atari 2600 cartridge, with its reset vectors pointing to the start of each bank, to @c file_name.
+void write_cartridge(const std::string &file_name, uint8_t fill) {
+	std::vector<uint8_t> contents(8192, fill);
+	for(size_t bank = 0; bank < contents.size(); bank += 4096) {
+		contents[bank + 0xffc] = 0x00;
+		contents[bank + 0xffd] = 0xf0;
+	}
+
+	FILE *const file = fopen(file_name.c_str(), "wb");
+	fwrite(contents.data(), 1, contents.size(), file);
+	fclose(file);
+}
+
+std::vector<std::string> files_in(const std::string &directory, const std::string &prefix) {
+	std::vector<std::string> files;
+	DIR *const dir = opendir(directory.c_str());
+	if(!dir) return files;
+	while(const dirent *const entry = readdir(dir)) {
+		if(!strncmp(entry->d_name, prefix.c_str(), prefix.size())) files.push_back(entry->d_name);
+	}
+	closedir(dir);
+	return files;
+}
+
+std::string description(const Analyser::Static::Target &target) {
+	const auto reflective = dynamic_cast<const Reflection::Struct *>(&target);
+	return reflective ? reflective->description() : "";
+}
+
+}
+
+@interface TargetCacheTests : XCTestCase
+@end
+
+@implementation TargetCacheTests {
+	std::string _directory;
+	std::string _file_name;
+}
+
+- (void)setUp {
+	NSString *const directory = [NSTemporaryDirectory() stringByAppendingPathComponent:[[NSUUID UUID] UUIDString]];
+	[[NSFileManager defaultManager] createDirectoryAtPath:directory withIntermediateDirectories:YES attributes:nil error:nil];
+	_directory = directory.UTF8String;
+	_file_name = _directory + "/cartridge.a26";
+	write_cartridge(_file_name, 0xc9);
+
+	Analyser::Static::TargetCache::set_directory(_directory);
+}
+
+- (void)tearDown {
+	Analyser::Static::TargetCache::set_directory("");
+	[[NSFileManager defaultManager] removeItemAtPath:[NSString stringWithUTF8String:_directory.c_str()] error:nil];
+}
+
+- (void)testAnalysisRoundTrip {
+	const auto analysed = Analyser::Static::GetTargets(_file_name);
+	XCTAssertFalse(analysed.empty());
+	XCTAssertEqual(files_in(_directory, "clksignal-targets-").size(), 1);
+
+	// A second analysis is served from the cache, and should be indistinguishable from the first.
+	const auto cached = Analyser::Static::GetTargets(_file_name);
+	XCTAssertEqual(cached.size(), analysed.size());
+	for(size_t c = 0; c < std::min(cached.size(), analysed.size()); c++) {
+		XCTAssert(cached[c]->machine == analysed[c]->machine);
+		XCTAssertEqual(cached[c]->confidence, analysed[c]->confidence);
+		XCTAssert(description(*cached[c]) == description(*analysed[c]));
+
+		XCTAssertEqual(cached[c]->media.cartridges.size(), analysed[c]->media.cartridges.size());
+		XCTAssertEqual(cached[c]->media.disks.size(), analysed[c]->media.disks.size());
+		XCTAssertEqual(cached[c]->media.tapes.size(), analysed[c]->media.tapes.size());
+		XCTAssertEqual(cached[c]->media.mass_storage_devices.size(), analysed[c]->media.mass_storage_devices.size());
+
+		// Media is obtained afresh rather than shared with the earlier analysis.
+		if(!cached[c]->media.cartridges.empty() && !analysed[c]->media.cartridges.empty()) {
+			XCTAssert(cached[c]->media.cartridges.front() != analysed[c]->media.cartridges.front());
+		}
+
+		// Fields supplied via cache_fields are also retained.
+		const auto cached_atari = dynamic_cast<const Analyser::Static::Atari2600::Target *>(cached[c].get());
+		const auto analysed_atari = dynamic_cast<const Analyser::Static::Atari2600::Target *>(analysed[c].get());
+		XCTAssertEqual(cached_atari != nullptr, analysed_atari != nullptr);
+		if(cached_atari && analysed_atari) {
+			XCTAssert(cached_atari->paging_model == analysed_atari->paging_model);
+			XCTAssertEqual(cached_atari->uses_superchip, analysed_atari->uses_superchip);
+		}
+	}
+}
+
+- (void)testStoredFieldsAreRestored {
+	// Store a target that analysis wouldn't produce, to show that it is what comes back.
+	Analyser::Static::TargetList targets;
+	auto target = std::make_unique<Analyser::Static::MSX::Target>();
+	target->confidence = 0.25f;
+	target->has_disk_drive = true;
+	target->region = Analyser::Static::MSX::Target::Region::Japan;
+	target->loading_command = "bload \"cas:\",r\n";
+	targets.push_back(std::move(target));
+
+	Analyser::Static::TargetCache::cache_for(_file_name)->store(targets, {});
+
+	const auto restored = Analyser::Static::TargetCache::cache_for(_file_name)->get();
+	XCTAssertEqual(restored.size(), 1);
+	if(restored.size() != 1) return;
+
+	const auto msx = dynamic_cast<const Analyser::Static::MSX::Target *>(restored.front().get());
+	XCTAssert(msx != nullptr);
+	if(!msx) return;
+	XCTAssertEqual(msx->confidence, 0.25f);
+	XCTAssertTrue(msx->has_disk_drive);
+	XCTAssert(msx->region == Analyser::Static::MSX::Target::Region::Japan);
+	XCTAssert(msx->loading_command == "bload \"cas:\",r\n");
+	XCTAssertTrue(msx->media.empty());
+}
+
+- (void)testChangedFileMisses {
+	Analyser::Static::GetTargets(_file_name);
+	XCTAssertFalse(Analyser::Static::TargetCache::cache_for(_file_name)->get().empty());
+
+	write_cartridge(_file_name, 0x00);
+	XCTAssertTrue(Analyser::Static::TargetCache::cache_for(_file_name)->get().empty());
+}
+
+- (void)testCorruptCacheIsIgnored {
+	const auto analysed = Analyser::Static::GetTargets(_file_name);
+	for(const auto &name: files_in(_directory, "clksignal-targets-")) {
+		const std::string path = _directory + "/" + name;
+		std::vector<uint8_t> contents(1024 * 1024);
+		FILE *handle = fopen(path.c_str(), "rb");
+		contents.resize(fread(contents.data(), 1, contents.size(), handle));
+		fclose(handle);
+
+		handle = fopen(path.c_str(), "wb");
+		fwrite(contents.data(), 1, contents.size() - 1, handle);
+		fclose(handle);
+	}
+
+	XCTAssertTrue(Analyser::Static::TargetCache::cache_for(_file_name)->get().empty());
+
+	// Analysis then proceeds as normal.
+	XCTAssertEqual(Analyser::Static::GetTargets(_file_name).size(), analysed.size());
+}
+
+- (void)testDisabledCache {
+	Analyser::Static::TargetCache::set_directory("");
+	XCTAssert(Analyser::Static::TargetCache::cache_for(_file_name) == nullptr);
+
+	Analyser::Static::GetTargets(_file_name);
+	XCTAssertTrue(files_in(_directory, "clksignal-targets-").empty());
+}
+
+@end
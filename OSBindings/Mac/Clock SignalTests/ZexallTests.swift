@@ -14,12 +14,13 @@ class ZexallTests: XCTestCase, CSTestMachineTrapHandler {
 	private var done = false
 	private var output = ""
 
-	private func runTest(_ name: String) {
+	private func runTest(_ name: String, coarseTiming: Bool = false, cachingExecutor: Bool = false) {
 		if let filename = Bundle(for: type(of: self)).path(forResource: name, ofType: "com") {
 			if let testData = try? Data(contentsOf: URL(fileURLWithPath: filename)) {
 
 				// Install test program, at the usual CP/M place.
-				let machine = CSTestMachineZ80()
+				let machine = CSTestMachineZ80(coarseTiming: coarseTiming)
+				machine.usesCachingExecutor = cachingExecutor
 				machine.setData(testData, atAddress: 0x0100)
 
 				// Add a RET at the CP/M entry location, set a high memtop, and
@@ -57,6 +58,7 @@ class ZexallTests: XCTestCase, CSTestMachineTrapHandler {
 						printDate = Date()
 					}
 				}
+				print("\(name)\(coarseTiming ? ", coarse timing" : "")\(cachingExecutor ? ", caching executor" : ""): \(cyclesToDate / -startDate.timeIntervalSinceNow / 1_000_000.0) Mhz")
 
 				let targetOutput =
 					"<adc,sbc> hl,<bc,de,hl,sp>....  OK\n\r"	+
@@ -141,6 +143,22 @@ class ZexallTests: XCTestCase, CSTestMachineTrapHandler {
 		runTest("zexdoc")
 	}
 
+	func testZexAllCoarseTiming() {
+		runTest("zexall", coarseTiming: true)
+	}
+
+	func testZexDocCoarseTiming() {
+		runTest("zexdoc", coarseTiming: true)
+	}
+
+	func testZexAllCachingExecutor() {
+		runTest("zexall", cachingExecutor: true)
+	}
+
+	func testZexDocCachingExecutor() {
+		runTest("zexdoc", cachingExecutor: true)
+	}
+
 	func testMachine(_ testMachine: CSTestMachine, didTrapAtAddress address: UInt16) {
 		let testMachineZ80 = testMachine as! CSTestMachineZ80
 		switch address {
@@ -0,0 +1,490 @@
+//
+//  main.cpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 14/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#include "../../Components/9918/9918.hpp"
+#include "../../Components/AY38910/AY38910.hpp"
+#include "../../Components/KonamiSCC/KonamiSCC.hpp"
+#include "../../Components/OPx/OPLL.hpp"
+#include "../../Components/SN76489/SN76489.hpp"
+#include "../../Concurrency/AsyncTaskQueue.hpp"
+#include "../../Machines/Atari/2600/TIA.hpp"
+#include "../../Numeric/CRC.hpp"
+#include "../../Outputs/ScanTargets/DiscardingScanTarget.hpp"
+#include "../../Outputs/Speaker/Implementation/LowpassSpeaker.hpp"
+#include "../../Processors/6502/AllRAM/6502AllRAM.hpp"
+#include "../../Processors/Z80/AllRAM/Z80AllRAM.hpp"
+#include "../../SignalProcessing/FIRFilter.hpp"
+#include "../../Storage/Disk/DPLL/DigitalPhaseLockedLoop.hpp"
+#include "../../Storage/Disk/Encodings/MFM/Encoder.hpp"
+#include "../../Storage/Disk/Track/PCMSegment.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+/*
+	Standalone micro-benchmarks of the emulator's hot kernels.
+
+	Each benchmark repeats a fixed-size workload in five batches of at least a fifth of the
+	requested time each and reports the fastest batch, in nanoseconds per operation; the
+	minimum is much less sensitive to scheduling noise than the mean.
+
+	Usage: clksignal-microbench [name filter ...] [--seconds={per benchmark, default 1}] [--resources={path}]
+
+	Only benchmarks whose names contain one of the filters are run. The CPU benchmarks require
+	the Zexall and Klaus Dormann test binaries, which are found by default in the Mac test target.
+*/
+
+namespace {
+
+/// Accumulates results so that the compiler can't discard the work that produced them.
+volatile uint64_t sink = 0;
+
+struct Options {
+	double seconds = 1.0;
+	std::string resources;
+	std::vector<std::string> filters;
+
+	bool should_run(const std::string &name) const {
+		if(filters.empty()) return true;
+		return std::any_of(filters.begin(), filters.end(), [&name] (const std::string &filter) {
+			return name.find(filter) != std::string::npos;
+		});
+	}
+};
+
+/*!
+	Calls @c iteration, which should perform @c operations_per_iteration operations of the kind
+	described by @c unit, repeatedly and prints the time per operation.
+*/
+template <typename Function> void measure(const Options &options, const std::string &name, const char *unit, std::size_t operations_per_iteration, Function &&iteration) {
+	if(!options.should_run(name)) return;
+
+	using Clock = std::chrono::steady_clock;
+	constexpr int batches = 5;
+	const double batch_seconds = options.seconds / double(batches);
+
+	// Warm up, and get a first estimate of the cost of an iteration.
+	auto start = Clock::now();
+	iteration();
+	double iteration_seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+	double best = -1.0;
+	for(int batch = 0; batch < batches; batch++) {
+		const auto iterations = std::max<std::size_t>(1, std::size_t(batch_seconds / std::max(iteration_seconds, 1e-9)));
+
+		start = Clock::now();
+		for(std::size_t c = 0; c < iterations; c++) {
+			iteration();
+		}
+		const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+		iteration_seconds = seconds / double(iterations);
+		const double nanos = 1e9 * iteration_seconds / double(operations_per_iteration);
+		if(best < 0.0 || nanos < best) best = nanos;
+	}
+
+	printf("%-32s %12.3f ns/%s\n", name.c_str(), best, unit);
+}
+
+/// @returns The contents of @c name within the resources directory, or an empty vector if it can't be read.
+std::vector<uint8_t> resource(const Options &options, const std::string &name) {
+	std::vector<uint8_t> contents;
+	FILE *const file = fopen((options.resources + name).c_str(), "rb");
+	if(!file) {
+		fprintf(stderr, "Skipping benchmark: couldn't read %s%s\n", options.resources.c_str(), name.c_str());
+		return contents;
+	}
+
+	uint8_t buffer[4096];
+	std::size_t read;
+	while((read = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+		contents.insert(contents.end(), buffer, buffer + read);
+	}
+	fclose(file);
+	return contents;
+}
+
+/// Provides a fixed, repeatable sequence of pseudo-random numbers.
+struct Random {
+	uint32_t value = 0x12345678;
+	uint32_t next() {
+		value ^= value << 13;
+		value ^= value >> 17;
+		value ^= value << 5;
+		return value;
+	}
+};
+
+// MARK: - Signal processing.
+
+void signal_processing(const Options &options) {
+	constexpr std::size_t samples = 4096;
+	constexpr std::size_t taps = 31;
+
+	Random random;
+	std::vector<short> input(samples + taps);
+	for(auto &sample: input) sample = short(random.next());
+
+	const SignalProcessing::FIRFilter filter(taps, 2'000'000.0f, 0.0f, 20'000.0f);
+	measure(options, "FIRFilter::apply (31 taps)", "sample", samples, [&] {
+		int total = 0;
+		for(std::size_t c = 0; c < samples; c++) {
+			total += filter.apply(&input[c]);
+		}
+		sink = sink + uint64_t(total);
+	});
+
+	struct SquareWave: public Outputs::Speaker::SampleSource {
+		void get_samples(std::size_t number_of_samples, std::int16_t *target) {
+			for(std::size_t c = 0; c < number_of_samples; c++) {
+				target[c] = (++counter_ & 256) ? volume_ : 0;
+			}
+		}
+		void set_sample_volume_range(std::int16_t volume) {
+			volume_ = volume;
+		}
+
+		private:
+			std::int16_t volume_ = 0;
+			uint32_t counter_ = 0;
+	} square_wave;
+
+	struct NullDelegate: public Outputs::Speaker::Speaker::Delegate {
+		void speaker_did_complete_samples(Outputs::Speaker::Speaker *, const std::vector<int16_t> &buffer) final {
+			sink = sink + buffer.size();
+		}
+	} delegate;
+
+	// The speaker runs only via a deferring queue; each iteration runs enough input for the
+	// cost of the handoff to be negligible.
+	constexpr int input_cycles = 1'000'000;
+	Concurrency::DeferringAsyncTaskQueue queue;
+	Outputs::Speaker::LowpassSpeaker<SquareWave> speaker(square_wave);
+	speaker.set_input_rate(2'000'000.0f);
+	speaker.set_output_rate(44'100.0f, 1024, false);
+	speaker.set_delegate(&delegate);
+	measure(options, "LowpassSpeaker::run_for", "input cycle", input_cycles, [&] {
+		speaker.run_for(queue, Cycles(input_cycles));
+		queue.perform();
+		queue.flush();
+	});
+}
+
+// MARK: - Audio chips.
+
+template <typename SampleSource> void measure_samples(const Options &options, const std::string &name, SampleSource &source) {
+	constexpr std::size_t samples = 4096;
+	std::vector<std::int16_t> target(samples * (SampleSource::get_is_stereo() ? 2 : 1));
+	source.set_sample_volume_range(32767);
+	measure(options, name, "sample", samples, [&] {
+		source.get_samples(samples, target.data());
+		sink = sink + uint64_t(target[samples / 2]);
+	});
+}
+
+void audio_chips(const Options &options) {
+	Concurrency::DeferringAsyncTaskQueue queue;
+	const auto apply_writes = [&queue] {
+		queue.perform();
+		queue.flush();
+	};
+
+	// AY: three tones at distinct pitches, noise on A and the envelope on C.
+	{
+		using AY = GI::AY38910::AY38910<false>;
+		AY ay(GI::AY38910::Personality::AY38910, queue);
+		const uint8_t registers[] = {
+			0x40, 0x01,	0x90, 0x01,	0xe0, 0x02,	// Tone periods.
+			0x0c,								// Noise period.
+			0x30,								// Mixer: all tones, and noise on A.
+			0x0f, 0x0c, 0x10,					// Volumes; C follows the envelope.
+			0x00, 0x08,							// Envelope period.
+			0x0e,								// Envelope shape: triangle.
+		};
+		for(uint8_t c = 0; c < sizeof(registers); c++) {
+			GI::AY38910::Utility::select_register(ay, c);
+			GI::AY38910::Utility::write_data(ay, registers[c]);
+		}
+		apply_writes();
+		measure_samples(options, "AY38910::get_samples", ay);
+	}
+
+	// SN76489: three tones and periodic noise.
+	{
+		TI::SN76489 sn(TI::SN76489::Personality::SN76489, queue);
+		for(const uint8_t value: {
+			0x80, 0x10,	0xa4, 0x12,	0xc8, 0x18,	// Tone periods.
+			0x90, 0xb4, 0xd8,					// Tone volumes.
+			0xe3, 0xf2,							// Noise control and volume.
+		}) {
+			sn.write(value);
+		}
+		apply_writes();
+		measure_samples(options, "SN76489::get_samples", sn);
+	}
+
+	// OPLL: six melodic channels keyed on, with a mix of instruments.
+	{
+		Yamaha::OPL::OPLL opll(queue);
+		for(uint8_t channel = 0; channel < 6; channel++) {
+			opll.write(0, uint8_t(0x10 + channel));	opll.write(1, uint8_t(0x40 + channel * 32));
+			opll.write(0, uint8_t(0x30 + channel));	opll.write(1, uint8_t((channel + 1) << 4));
+			opll.write(0, uint8_t(0x20 + channel));	opll.write(1, uint8_t(0x10 | (channel << 1) | 1));
+		}
+		apply_writes();
+		measure_samples(options, "OPLL::get_samples", opll);
+	}
+
+	// SCC: five channels at full volume, with sawtooth waves.
+	{
+		Konami::SCC scc(queue);
+		for(uint16_t address = 0; address < 0x80; address++) {
+			scc.write(address, uint8_t((address & 0x1f) << 3));
+		}
+		for(uint16_t channel = 0; channel < 5; channel++) {
+			scc.write(uint16_t(0x80 + channel * 2), uint8_t(0x40 + channel * 0x30));
+			scc.write(uint16_t(0x81 + channel * 2), 0x01);
+			scc.write(uint16_t(0x8a + channel), 0x0f);
+		}
+		scc.write(0x8f, 0x1f);
+		apply_writes();
+		measure_samples(options, "KonamiSCC::get_samples", scc);
+	}
+}
+
+// MARK: - Video chips.
+
+void video_chips(const Options &options) {
+	Outputs::Display::DiscardingScanTarget scan_target;
+
+	// Both VDPs run a full frame of lines per iteration, with the display enabled: the 9918 in
+	// Graphics I mode and the Master System VDP in mode 4.
+	constexpr int lines = 262;
+	constexpr int half_cycles_per_line = 455;
+	for(const auto personality: {TI::TMS::TMS9918A, TI::TMS::SMSVDP}) {
+		TI::TMS::TMS9918 vdp(personality);
+		vdp.set_scan_target(&scan_target);
+		vdp.write(1, personality == TI::TMS::SMSVDP ? 0x06 : 0x00);	vdp.write(1, 0x80);
+		vdp.write(1, 0x40);	vdp.write(1, 0x81);
+
+		measure(options, personality == TI::TMS::SMSVDP ? "TMS9918 line (SMS mode 4)" : "TMS9918 line (Graphics I)", "line", lines, [&] {
+			vdp.run_for(HalfCycles(lines * half_cycles_per_line));
+		});
+	}
+
+	// The TIA also runs a frame per iteration, with a playfield and both players set.
+	{
+		Atari2600::TIA tia;
+		tia.set_scan_target(&scan_target);
+		tia.set_background_colour(0x12);
+		tia.set_playfield_ball_colour(0x34);
+		tia.set_playfield(0, 0xf0);
+		tia.set_playfield(1, 0xa5);
+		tia.set_playfield(2, 0x5a);
+		for(int player = 0; player < 2; player++) {
+			tia.set_player_missile_colour(player, uint8_t(0x56 + player * 0x22));
+			tia.set_player_graphic(player, 0x3c);
+			tia.set_player_number_and_size(player, 0x03);
+		}
+
+		constexpr int cycles_per_line = 228;
+		measure(options, "TIA line", "line", lines, [&] {
+			for(int line = 0; line < lines; line++) {
+				tia.run_for(Cycles(cycles_per_line));
+			}
+		});
+	}
+}
+
+// MARK: - Storage.
+
+void storage(const Options &options) {
+	Random random;
+
+	// CRCs over a 64kb block.
+	{
+		std::vector<uint8_t> data(65536);
+		for(auto &byte: data) byte = uint8_t(random.next());
+
+		CRC::CCITT ccitt;
+		measure(options, "CRC::Generator (CCITT)", "byte", data.size(), [&] {
+			sink = sink + ccitt.compute_crc(data);
+		});
+
+		CRC::CRC32 crc32;
+		measure(options, "CRC::Generator (CRC32)", "byte", data.size(), [&] {
+			sink = sink + crc32.compute_crc(data);
+		});
+	}
+
+	// A DPLL locking to 4096 pulses that are a jittered one, two or three windows apart.
+	{
+		struct BitCounter {
+			void digital_phase_locked_loop_output_bit(int value) {
+				bits += uint64_t(value + 1);
+			}
+			uint64_t bits = 0;
+		} counter;
+
+		constexpr int clocks_per_bit = 100;
+		std::vector<int> intervals(4096);
+		for(auto &interval: intervals) {
+			interval = clocks_per_bit * int(2 + random.next() % 3) + int(random.next() % 21) - 10;
+		}
+
+		Storage::DigitalPhaseLockedLoop<BitCounter> pll(clocks_per_bit, counter);
+		measure(options, "DigitalPhaseLockedLoop", "pulse", intervals.size(), [&] {
+			for(const auto interval: intervals) {
+				pll.run_for(Cycles(interval));
+				pll.add_pulse();
+			}
+		});
+		sink = sink + counter.bits;
+	}
+
+	// MFM-encoding a whole 512-byte sector, with its header.
+	{
+		std::vector<uint8_t> sector(512);
+		for(auto &byte: sector) byte = uint8_t(random.next());
+
+		std::vector<bool> bits;
+		const auto encoder = Storage::Encodings::MFM::GetMFMEncoder(bits);
+		measure(options, "MFM::Encoder", "sector", 1, [&] {
+			bits.clear();
+			encoder->add_ID_address_mark();
+			for(const uint8_t byte: {0, 0, 1, 2}) encoder->add_byte(byte);
+			encoder->add_crc(false);
+			encoder->add_data_address_mark();
+			for(const auto byte: sector) encoder->add_byte(byte);
+			encoder->add_crc(false);
+			sink = sink + bits.size();
+		});
+	}
+
+	// Reading every flux transition from a track-sized PCM segment, a quarter of whose bits are set.
+	{
+		std::vector<bool> data(100'000);
+		std::size_t transitions = 0;
+		for(std::size_t c = 0; c < data.size(); c++) {
+			data[c] = !(random.next() & 3);
+			transitions += data[c];
+		}
+
+		const Storage::Disk::PCMSegment segment(Storage::Time(1, 500'000), data);
+		Storage::Disk::PCMSegmentEventSource source(segment);
+		measure(options, "PCMSegmentEventSource", "event", transitions + 1, [&] {
+			source.reset();
+			while(source.get_next_event().type != Storage::Disk::Track::Event::IndexHole);
+		});
+	}
+}
+
+// MARK: - CPUs.
+
+void processors(const Options &options) {
+	// Each iteration runs the first few million cycles of a test suite from a fresh load, so that
+	// exactly the same instructions are timed regardless of how many iterations are run.
+	constexpr int cycles = 5'000'000;
+
+	struct Z80Variant {
+		const char *name;
+		bool uses_direct_fetch;
+		bool uses_caching_executor;
+	};
+	for(const auto &variant: {
+		Z80Variant{"Z80 (zexall)", false, false},
+		Z80Variant{"Z80 (zexall, direct fetch)", true, false},
+		Z80Variant{"Z80 (zexall, caching executor)", false, true},
+	}) {
+		const std::string name = variant.name;
+		if(!options.should_run(name)) continue;
+
+		const auto zexall = resource(options, "Zexall/zexall.com");
+		if(!zexall.empty()) {
+			std::unique_ptr<CPU::Z80::AllRAMProcessor> z80(CPU::Z80::AllRAMProcessor::Processor());
+			z80->set_uses_direct_fetch(variant.uses_direct_fetch);
+			z80->set_uses_caching_executor(variant.uses_caching_executor);
+
+			// Install a RET at the CP/M BDOS entry point and a high memtop; a JP 0 at 0 catches any exit.
+			const uint8_t low_memory[] = {0xc3, 0x00, 0x00, 0x00, 0x00, 0xc9, 0xff, 0xff};
+			measure(options, name, "cycle", cycles, [&] {
+				z80->set_data_at_address(0, sizeof(low_memory), low_memory);
+				z80->set_data_at_address(0x100, zexall.size(), zexall.data());
+				z80->set_value_of_register(CPU::Z80::Register::ProgramCounter, 0x100);
+				z80->run_for(Cycles(cycles));
+			});
+		}
+	}
+
+	enum class Mode6502 {
+		Processor, DirectFetch, CachingExecutor
+	};
+	for(const auto mode: {Mode6502::Processor, Mode6502::DirectFetch, Mode6502::CachingExecutor}) {
+		const std::string name =
+			mode == Mode6502::CachingExecutor ? "6502 (Klaus Dormann, caching executor)" :
+			mode == Mode6502::DirectFetch ? "6502 (Klaus Dormann, direct fetch)" : "6502 (Klaus Dormann)";
+		if(!options.should_run(name)) continue;
+
+		const auto functional_test = resource(options, "Klaus Dormann/6502_functional_test.bin");
+		if(!functional_test.empty()) {
+			std::unique_ptr<CPU::MOS6502::AllRAMProcessor> m6502(CPU::MOS6502::AllRAMProcessor::Processor(CPU::MOS6502Esque::Type::T6502, mode == Mode6502::DirectFetch));
+			m6502->set_uses_caching_executor(mode == Mode6502::CachingExecutor);
+			measure(options, name, "cycle", cycles, [&] {
+				m6502->set_data_at_address(0, functional_test.size(), functional_test.data());
+				m6502->set_value_of_register(CPU::MOS6502::Register::ProgramCounter, 0x400);
+				m6502->run_for(Cycles(cycles));
+			});
+		}
+	}
+}
+
+/// @returns The directory containing the Mac test target's resources, as found relative to this file.
+std::string default_resources() {
+	std::string path = __FILE__;
+	const auto final_slash = path.find_last_of("/\\");
+	path = final_slash == std::string::npos ? std::string(".") : path.substr(0, final_slash);
+	return path + "/../Mac/Clock SignalTests/";
+}
+
+}
+
+int main(int argc, char *argv[]) {
+	Options options;
+	options.resources = default_resources();
+
+	for(int index = 1; index < argc; ++index) {
+		const std::string argument = argv[index];
+		if(argument.rfind("--seconds=", 0) == 0) {
+			options.seconds = std::max(strtod(argument.c_str() + 10, nullptr), 0.01);
+		} else if(argument.rfind("--resources=", 0) == 0) {
+			options.resources = argument.substr(12);
+			if(!options.resources.empty() && options.resources.back() != '/') {
+				options.resources += '/';
+			}
+		} else if(argument[0] == '-') {
+			fprintf(stderr, "Usage: clksignal-microbench [name filter ...] [--seconds={per benchmark, default 1}] [--resources={path to test binaries}]\n");
+			return EXIT_FAILURE;
+		} else {
+			options.filters.push_back(argument);
+		}
+	}
+
+	signal_processing(options);
+	audio_chips(options);
+	video_chips(options);
+	storage(options);
+	processors(options);
+
+	return EXIT_SUCCESS;
+}
@@ -2,11 +2,12 @@
 #define AUDIOSOURCE_H
 
 #include <cstdint>
-#include <mutex>
 #include <vector>
 
 #include <QIODevice>
 
+#include "../../Outputs/Speaker/AudioRingBuffer.hpp"
+
 /*!
  * \brief An intermediate recepticle for audio data.
  *
@@ -20,44 +21,35 @@
  *    permanent disadvantage after startup; and
  * 2. that such QAudioOutputs empirically seem to introduce a minimum
  *    16384-byte latency.
+ *
+ * Storage is a lock-free Outputs::Speaker::AudioRingBuffer, so the
+ * emulation thread never waits for the audio thread.
  */
 struct AudioBuffer: public QIODevice {
 	AudioBuffer() {
 		open(QIODevice::ReadOnly | QIODevice::Unbuffered);
 	}
 
-	void setDepth(size_t depth) {
-		std::lock_guard lock(mutex);
-		buffer.resize(depth);
+	// Sets the channel count and target latency, in frames; this should be called
+	// before any audio is posted or read.
+	void setFormat(int channels, size_t latency) {
+		frameSize = sizeof(int16_t) * size_t(channels);
+		buffer.set_format(channels, latency);
 	}
 
-	// AudioBuffer-specific behaviour: always provide the latest data,
-	// even if that means skipping some.
+	// AudioBuffer-specific behaviour: provide whatever is buffered, resampled
+	// slightly so as to keep latency close to the target.
 	qint64 readData(char *data, const qint64 maxlen) override {
-		if(!maxlen) {
+		if(maxlen <= 0) {
 			return 0;
 		}
 
-		std::lock_guard lock(mutex);
-		if(readPointer == writePointer || buffer.empty()) return 0;
-
-		const size_t dataAvailable = std::min(writePointer - readPointer, size_t(maxlen));
-		size_t bytesToCopy = dataAvailable;
-		while(bytesToCopy) {
-			const size_t nextLength = std::min(buffer.size() - (readPointer % buffer.size()), bytesToCopy);
-			memcpy(data, &buffer[readPointer % buffer.size()], nextLength);
-
-			bytesToCopy -= nextLength;
-			data += nextLength;
-			readPointer += nextLength;
-		}
-
-		return qint64(dataAvailable);
+		const size_t frames = buffer.read(reinterpret_cast<int16_t *>(data), size_t(maxlen) / frameSize);
+		return qint64(frames * frameSize);
 	}
 
 	qint64 bytesAvailable() const override {
-		std::lock_guard lock(mutex);
-		return qint64(writePointer - readPointer);
+		return qint64(buffer.buffered() * frameSize);
 	}
 
 	// Required to make QIODevice concrete; not used.
@@ -65,33 +57,15 @@ struct AudioBuffer: public QIODevice {
 		return 0;
 	}
 
-	// Posts a new set of source data. This buffer permits only the amount of data
-	// specified by @c setDepth to be enqueued into the future. Additional writes
-	// after the buffer is full will overwrite the newest data.
+	// Posts a new set of source data. If the buffer is full then the
+	// excess is discarded.
 	void write(const std::vector<int16_t> &source) {
-		std::lock_guard lock(mutex);
-		if(buffer.empty()) return;
-		const size_t sourceSize = source.size() * sizeof(int16_t);
-
-		size_t bytesToCopy = sourceSize;
-		auto data = reinterpret_cast<const uint8_t *>(source.data());
-		while(bytesToCopy) {
-			size_t nextLength = std::min(buffer.size() - (writePointer % buffer.size()), bytesToCopy);
-			memcpy(&buffer[writePointer % buffer.size()], data, nextLength);
-
-			bytesToCopy -= nextLength;
-			data += nextLength;
-			writePointer += nextLength;
-		}
-
-		readPointer = std::max(readPointer, writePointer - buffer.size());
+		buffer.write(source);
 	}
 
 	private:
-		mutable std::mutex mutex;
-		std::vector<uint8_t> buffer;
-		mutable size_t readPointer = 0;
-		size_t writePointer = 0;
+		Outputs::Speaker::AudioRingBuffer buffer;
+		size_t frameSize = sizeof(int16_t);
 };
 
 #endif // AUDIOSOURCE_H
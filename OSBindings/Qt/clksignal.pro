@@ -127,6 +127,7 @@ SOURCES += \
 	$$SRC/Storage/Data/*.cpp \
 	$$SRC/Storage/Disk/*.cpp \
 	$$SRC/Storage/Disk/Controller/*.cpp \
+	$$SRC/Storage/Disk/DiskImage/*.cpp \
 	$$SRC/Storage/Disk/DiskImage/Formats/*.cpp \
 	$$SRC/Storage/Disk/DiskImage/Formats/Utility/*.cpp \
 	$$SRC/Storage/Disk/Encodings/*.cpp \
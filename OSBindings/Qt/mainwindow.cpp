@@ -11,6 +11,8 @@
 #include <cstdio>
 
 #include "../../Numeric/CRC.hpp"
+#include "../../Machines/Utility/ApplyInput.hpp"
+#include "../../Machines/Utility/ROMRepository.hpp"
 
 namespace {
 
@@ -69,7 +71,8 @@ void MainWindow::deleteMachine() {
 		audioThread.stop();
 	}
 
-	// Release the machine.
+	// Release the machine, and any history of it.
+	rewind.reset();
 	machine.reset();
 
 	// Remove any machine-specific options.
@@ -77,7 +80,8 @@ void MainWindow::deleteMachine() {
 	if(enhancementsMenu)	menuBar()->removeAction(enhancementsMenu->menuAction());
 	if(controlsMenu)		menuBar()->removeAction(controlsMenu->menuAction());
 	if(inputMenu)			menuBar()->removeAction(inputMenu->menuAction());
-	displayMenu = enhancementsMenu = controlsMenu = inputMenu = nullptr;
+	if(rewindMenu)			menuBar()->removeAction(rewindMenu->menuAction());
+	displayMenu = enhancementsMenu = controlsMenu = inputMenu = rewindMenu = nullptr;
 
 	// Remove the status bar, if any.
 	setStatusBar(nullptr);
@@ -253,31 +257,27 @@ void MainWindow::tile(const QMainWindow *previous) {
 void MainWindow::launchMachine() {
 	const QStringList appDataLocations = QStandardPaths::standardLocations(QStandardPaths::AppDataLocation);
 
+	// Keep ROM CRCs in the cache location, nominating it only once.
+	static bool hasSetROMIndex = false;
+	if(!hasSetROMIndex) {
+		hasSetROMIndex = true;
+		const QString cacheLocation = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+		if(!cacheLocation.isEmpty() && QDir().mkpath(cacheLocation)) {
+			ROM::Repository::shared().set_index_file(cacheLocation.toStdString() + "/roms.index");
+		}
+	}
+
 	ROMMachine::ROMFetcher rom_fetcher = [&appDataLocations, this]
 		(const ROM::Request &roms) -> ROM::Map {
-		ROM::Map results;
-
-		for(const auto &description: roms.all_descriptions()) {
-			for(const auto &file_name: description.file_names) {
-				FILE *file = nullptr;
-				for(const auto &path: appDataLocations) {
-					const std::string source = path.toStdString() + "/ROMImages/" + description.machine_name + "/" + file_name;
-					const std::string nativeSource = QDir::toNativeSeparators(QString::fromStdString(source)).toStdString();
-
-					file = fopen(nativeSource.c_str(), "rb");
-					if(file) break;
-				}
-
-				if(file) {
-					auto data = fileContentsAndClose(file);
-					if(data) {
-						results[description.name] = *data;
-						continue;
-					}
-				}
-			}
+		// The repository scans each directory only once, and shares ROMs between machines.
+		auto &repository = ROM::Repository::shared();
+		std::vector<std::string> paths;
+		for(const auto &path: appDataLocations) {
+			paths.push_back(path.toStdString() + "/ROMImages/");
 		}
+		repository.add_directories(paths);
 
+		const ROM::Map results = repository.fetch(roms);
 		missingRoms = roms.subtract(results);
 		return results;
 	};
@@ -325,6 +325,9 @@ void MainWindow::launchMachine() {
 				idealFormat.setChannelCount(1 + int(audioIsStereo));
 				idealFormat.setSampleSize(audioIs8bit ? 8 : 16);
 
+				// Aim to buffer one packet from the speaker plus one read by the output.
+				audioBuffer.setFormat(1 + int(audioIsStereo), samplesPerBuffer * 2);
+
 				speaker->set_output_rate(idealFormat.sampleRate(), samplesPerBuffer, audioIsStereo);
 				speaker->set_delegate(this);
 
@@ -337,7 +340,6 @@ void MainWindow::launchMachine() {
 					// believe it or not, given Qt's semantics.
 					audioOutput->setBufferSize(samplesPerBuffer * sizeof(int16_t));
 					audioOutput->start(&audioBuffer);
-					audioBuffer.setDepth(audioOutput->bufferSize());
 				});
 			}
 		}
@@ -351,11 +353,18 @@ void MainWindow::launchMachine() {
 		configurable->set_options(Machine::AllOptionsByMachineName()[longMachineName]);
 	}
 
+	// Keep a rewind history if the machine can supply its state.
+	const auto stateProducer = machine->state_producer();
+	if(stateProducer) {
+		static constexpr size_t rewindArenaSize = 16 * 1024 * 1024;
+		rewind = std::make_unique<Machine::Rewind>(*stateProducer, rewindArenaSize);
+	}
+
 	// If this is a timed machine, start up the timer.
 	const auto timedMachine = machine->timed_machine();
 	if(timedMachine) {
 		timer = std::make_unique<Timer>(this);
-		timer->startWithMachine(timedMachine, &machineMutex);
+		timer->startWithMachine(machine.get(), &machineMutex, rewind.get(), &inputQueue);
 	}
 
 	// If the machine can accept new media while running, enable
@@ -462,6 +471,11 @@ void MainWindow::launchMachine() {
 		default: break;
 	}
 
+	// Offer rewinding if there's a history to rewind through.
+	if(rewind) {
+		addRewindMenu();
+	}
+
 	// Push the help menu after any that were just added.
 	addHelpMenu();
 
@@ -676,6 +690,19 @@ void MainWindow::toggleAtari2600Switch(Atari2600Switch toggleSwitch) {
 	});
 }
 
+void MainWindow::addRewindMenu() {
+	rewindMenu = menuBar()->addMenu(tr("&Rewind"));
+
+	// The shortcut auto-repeats, so holding it steps back continuously.
+	QAction *const stepBackAction = new QAction(tr("Step Back"), this);
+	stepBackAction->setShortcut(QKeySequence(Qt::CTRL + Qt::Key_Backspace));
+	rewindMenu->addAction(stepBackAction);
+	connect(stepBackAction, &QAction::triggered, this, [=] {
+		std::lock_guard lock_guard(machineMutex);
+		if(rewind) rewind->step_back();
+	});
+}
+
 void MainWindow::addAppleIIMenu() {
 	// Add the standard display settings.
 	addDisplayMenu("appleII", "Colour", "Monochrome", "", "");
@@ -777,6 +804,7 @@ void MainWindow::dropEvent(QDropEvent* event) {
 					FILE *const target = fopen(destination.c_str(), "wb");
 					fwrite(contents->data(), 1, contents->size(), target);
 					fclose(target);
+					ROM::Repository::shared().add_file(destination);
 
 					// Note that at least one meaningful ROM was supplied.
 					foundROM = true;
@@ -881,15 +909,16 @@ bool MainWindow::processEvent(QKeyEvent *event) {
 	if(!key) return true;
 
 	const bool isPressed = event->type() == QEvent::KeyPress;
-	std::unique_lock lock(machineMutex);
 
 	switch(keyboardInputMode) {
 		case KeyboardInputMode::Keyboard: {
 			const auto keyboardMachine = machine->keyboard_machine();
 			if(!keyboardMachine) return true;
 
-			auto &keyboard = keyboardMachine->get_keyboard();
-			keyboard.set_key_pressed(*key, event->text().size() ? event->text()[0].toLatin1() : '\0', isPressed);
+			postInput(Inputs::InputEvent::key_event(*key, event->text().size() ? event->text()[0].toLatin1() : '\0', isPressed));
+
+			// Which keys the keyboard observes is fixed, so may be inspected while the machine runs.
+			const auto &keyboard = keyboardMachine->get_keyboard();
 			if(keyboard.is_exclusive() || keyboard.observed_keys().find(*key) != keyboard.observed_keys().end()) {
 				return false;
 			}
@@ -897,30 +926,30 @@ bool MainWindow::processEvent(QKeyEvent *event) {
 		[[fallthrough]];
 
 		case KeyboardInputMode::Joystick: {
-			const auto joystickMachine = machine->joystick_machine();
-			if(!joystickMachine) return true;
-
-			const auto &joysticks = joystickMachine->get_joysticks();
-			if(!joysticks.empty()) {
-				using Key = Inputs::Keyboard::Key;
-				switch(*key) {
-					case Key::Left:		joysticks[0]->set_input(Inputs::Joystick::Input::Left, isPressed);		break;
-					case Key::Right:	joysticks[0]->set_input(Inputs::Joystick::Input::Right, isPressed);		break;
-					case Key::Up:		joysticks[0]->set_input(Inputs::Joystick::Input::Up, isPressed);		break;
-					case Key::Down:		joysticks[0]->set_input(Inputs::Joystick::Input::Down, isPressed);		break;
-					case Key::Space:	joysticks[0]->set_input(Inputs::Joystick::Input::Fire, isPressed);		break;
-					case Key::A:		joysticks[0]->set_input(Inputs::Joystick::Input(Inputs::Joystick::Input::Fire, 0), isPressed);	break;
-					case Key::S:		joysticks[0]->set_input(Inputs::Joystick::Input(Inputs::Joystick::Input::Fire, 1), isPressed);	break;
-					case Key::D:		joysticks[0]->set_input(Inputs::Joystick::Input(Inputs::Joystick::Input::Fire, 2), isPressed);	break;
-					case Key::F:		joysticks[0]->set_input(Inputs::Joystick::Input(Inputs::Joystick::Input::Fire, 3), isPressed);	break;
-					default:
-						if(event->text().size()) {
-							joysticks[0]->set_input(Inputs::Joystick::Input(event->text()[0].toLatin1()), isPressed);
-						} else {
-							joysticks[0]->set_input(Inputs::Joystick::Input::Fire, isPressed);
-						}
-					break;
-				}
+			if(!machine->joystick_machine()) return true;
+
+			const auto postJoystick = [this, isPressed](const Inputs::Joystick::Input &input) {
+				postInput(Inputs::InputEvent::joystick_event(0, input, isPressed));
+			};
+
+			using Key = Inputs::Keyboard::Key;
+			switch(*key) {
+				case Key::Left:		postJoystick(Inputs::Joystick::Input::Left);		break;
+				case Key::Right:	postJoystick(Inputs::Joystick::Input::Right);		break;
+				case Key::Up:		postJoystick(Inputs::Joystick::Input::Up);			break;
+				case Key::Down:		postJoystick(Inputs::Joystick::Input::Down);		break;
+				case Key::Space:	postJoystick(Inputs::Joystick::Input::Fire);		break;
+				case Key::A:		postJoystick(Inputs::Joystick::Input(Inputs::Joystick::Input::Fire, 0));	break;
+				case Key::S:		postJoystick(Inputs::Joystick::Input(Inputs::Joystick::Input::Fire, 1));	break;
+				case Key::D:		postJoystick(Inputs::Joystick::Input(Inputs::Joystick::Input::Fire, 2));	break;
+				case Key::F:		postJoystick(Inputs::Joystick::Input(Inputs::Joystick::Input::Fire, 3));	break;
+				default:
+					if(event->text().size()) {
+						postJoystick(Inputs::Joystick::Input(event->text()[0].toLatin1()));
+					} else {
+						postJoystick(Inputs::Joystick::Input::Fire);
+					}
+				break;
 			}
 		} break;
 	}
@@ -928,25 +957,31 @@ bool MainWindow::processEvent(QKeyEvent *event) {
 	return false;
 }
 
+void MainWindow::postInput(const Inputs::InputEvent &event) {
+	if(inputQueue.push(event)) return;
+
+	// The queue is full, so the timer must have stalled; wait for it, then apply
+	// everything queued so far plus this event directly, preserving order.
+	std::lock_guard lock_guard(machineMutex);
+	inputQueue.drain([this](const Inputs::InputEvent &queued) {
+		Machine::apply_input(*machine, queued);
+	});
+	Machine::apply_input(*machine, event);
+}
+
 void MainWindow::setMouseIsCaptured(bool isCaptured) {
 	mouseIsCaptured = isCaptured;
 	setWindowTitle();
 }
 
 void MainWindow::moveMouse(QPoint vector) {
-	std::unique_lock lock(machineMutex);
-	auto mouseMachine = machine->mouse_machine();
-	if(!mouseMachine) return;
-
-	mouseMachine->get_mouse().move(vector.x(), vector.y());
+	if(!machine || !machine->mouse_machine()) return;
+	postInput(Inputs::InputEvent::mouse_motion_event(vector.x(), vector.y()));
 }
 
 void MainWindow::setButtonPressed(int index, bool isPressed) {
-	std::unique_lock lock(machineMutex);
-	auto mouseMachine = machine->mouse_machine();
-	if(!mouseMachine) return;
-
-	mouseMachine->get_mouse().set_button_pressed(index, isPressed);
+	if(!machine || !machine->mouse_machine()) return;
+	postInput(Inputs::InputEvent::mouse_button_event(index, isPressed));
 }
 
 // MARK: - New Machine Creation
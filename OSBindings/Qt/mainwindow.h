@@ -15,6 +15,7 @@
 #include "keyboard.h"
 
 #include "../../Analyser/Static/StaticAnalyser.hpp"
+#include "../../Inputs/InputQueue.hpp"
 #include "../../Machines/Utility/MachineForTarget.hpp"
 
 #include "../../Activity/Observer.hpp"
@@ -70,6 +71,12 @@ class MainWindow : public QMainWindow, public Outputs::Speaker::Speaker::Delegat
 		// Ongoing state.
 		std::unique_ptr<Machine::DynamicMachine> machine;
 		std::mutex machineMutex;
+		std::unique_ptr<Machine::Rewind> rewind;
+
+		// Keyboard, joystick and mouse input is posted here, to be applied by the timer's thread,
+		// so that the UI never waits for emulation.
+		Inputs::InputQueue inputQueue;
+		void postInput(const Inputs::InputEvent &);
 
 		std::unique_ptr<QAudioOutput> audioOutput;
 		bool audioIs8bit = false, audioIsStereo = false;
@@ -150,6 +157,9 @@ class MainWindow : public QMainWindow, public Outputs::Speaker::Speaker::Delegat
 
 		QMenu *inputMenu = nullptr;
 
+		QMenu *rewindMenu = nullptr;
+		void addRewindMenu();
+
 		KeyboardMapper keyMapper;
 
 		void register_led(const std::string &, uint8_t) override;
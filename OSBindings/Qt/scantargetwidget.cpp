@@ -13,7 +13,9 @@
 
 #include "../../ClockReceiver/TimeTypes.hpp"
 
-ScanTargetWidget::ScanTargetWidget(QWidget *parent) : QOpenGLWidget(parent) {}
+ScanTargetWidget::ScanTargetWidget(QWidget *parent) :
+	QOpenGLWidget(parent),
+	logsFrameStatistics(qEnvironmentVariableIsSet("CLK_FRAME_STATISTICS")) {}
 ScanTargetWidget::~ScanTargetWidget() {}
 
 void ScanTargetWidget::initializeGL() {
@@ -83,6 +85,18 @@ void ScanTargetWidget::vsync() {
 
 	vsyncPredictor.announce_vsync();
 
+	// If requested, periodically log frame timing statistics.
+	if(logsFrameStatistics) {
+		const auto now = Time::nanos_now();
+		if(!lastFrameStatisticsTime) {
+			lastFrameStatisticsTime = now;
+		} else if(now - lastFrameStatisticsTime >= 10'000'000'000) {
+			lastFrameStatisticsTime = now;
+			qInfo().noquote() << QString::fromStdString(vsyncPredictor.statistics().summary());
+			vsyncPredictor.reset_statistics();
+		}
+	}
+
 	const auto time_now = Time::nanos_now();
 	requestedRedrawTime = vsyncPredictor.suggested_draw_time();
 	const auto delay_time = (requestedRedrawTime - time_now) / 1'000'000;
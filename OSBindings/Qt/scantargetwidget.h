@@ -58,6 +58,10 @@ class ScanTargetWidget : public QOpenGLWidget {
 
 		Time::Nanos requestedRedrawTime = 0;
 
+		// Set via the CLK_FRAME_STATISTICS environment variable.
+		const bool logsFrameStatistics;
+		Time::Nanos lastFrameStatisticsTime = 0;
+
 		void setDefaultClearColour();
 
 		int rawWidth = 0, rawHeight = 0;
@@ -1,43 +1,83 @@
 #include "timer.h"
 
-#include "../../ClockReceiver/TimeTypes.hpp"
+#include "../../Machines/Utility/ApplyInput.hpp"
 
 #include <algorithm>
-#include <QDebug>
+
+#ifdef __linux__
+#include <cerrno>
+#include <ctime>
+#endif
+
+namespace {
+
+/// Blocks the calling thread until @c deadline.
+void sleepUntil(std::chrono::steady_clock::time_point deadline) {
+#ifdef __linux__
+	// std::chrono::steady_clock is CLOCK_MONOTONIC on Linux; sleep against an absolute
+	// deadline on that clock directly for the finest available resolution.
+	const auto nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(deadline.time_since_epoch()).count();
+	timespec target;
+	target.tv_sec = time_t(nanos / 1'000'000'000);
+	target.tv_nsec = long(nanos % 1'000'000'000);
+	while(clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &target, nullptr) == EINTR);
+#else
+	std::this_thread::sleep_until(deadline);
+#endif
+}
+
+}
 
 Timer::Timer(QObject *parent) : QObject(parent) {}
 
-void Timer::startWithMachine(MachineTypes::TimedMachine *machine, std::mutex *machineMutex) {
+void Timer::startWithMachine(Machine::DynamicMachine *machine, std::mutex *machineMutex, Machine::Rewind *rewind, Inputs::InputQueue *inputs) {
 	this->machine = machine;
+	this->timedMachine = machine->timed_machine();
 	this->machineMutex = machineMutex;
+	this->rewind = rewind;
+	this->inputs = inputs;
+
+	isRunning = true;
+	thread = std::thread([this] {
+		lastTick = Clock::now();
+		auto deadline = lastTick;
 
-	thread.start();
-	thread.performAsync([this] {
-		// Set up the emulation timer. Bluffer's guide: the QTimer will post an
-		// event to an event loop. QThread is a thread with an event loop.
-		// My class, Timer, will be wired up to receive the QTimer's events.
-		timer = std::make_unique<QTimer>();
-		timer->setInterval(1);
+		while(isRunning) {
+			deadline += slicePeriod;
+			sleepUntil(deadline);
+			tick();
 
-		connect(timer.get(), &QTimer::timeout, this, &Timer::tick, Qt::DirectConnection);
-		timer->start();
+			// If this thread has been held up for long enough, pick up the schedule from
+			// now; the time missed has already been run by the most recent tick.
+			const auto now = Clock::now();
+			if(now - deadline > maximumLag) {
+				deadline = now;
+			}
+		}
 	});
 }
 
 void Timer::tick() {
-	const auto now = Time::nanos_now();
-	const auto duration = std::min(now - lastTickNanos, int64_t(500'000'000));
-	lastTickNanos = now;
+	const auto now = Clock::now();
+	const auto duration = std::min(
+		std::chrono::duration<double>(now - lastTick).count(),
+		0.5
+	);
+	lastTick = now;
 
 	std::lock_guard lock_guard(*machineMutex);
-	machine->run_for(double(duration) / 1e9);
+	if(inputs) {
+		inputs->drain([this](const Inputs::InputEvent &event) {
+			Machine::apply_input(*machine, event);
+		});
+	}
+	timedMachine->run_for(duration);
+	if(rewind) rewind->advance(duration);
 }
 
 Timer::~Timer() {
-	thread.performAsync([this] {
-		if(timer) {
-			timer->stop();
-		}
-	});
-	thread.stop();
+	if(thread.joinable()) {
+		isRunning = false;
+		thread.join();
+	}
 }
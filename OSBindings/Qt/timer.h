@@ -2,14 +2,26 @@
 #define TIMER_H
 
 #include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
 
 #include <QObject>
-#include <QThread>
-#include <QTimer>
 
+#include "../../Inputs/InputQueue.hpp"
 #include "../../Machines/Utility/MachineForTarget.hpp"
-#include "functionthread.h"
-
+#include "../../Machines/Utility/Rewind.hpp"
+
+/*!
+ * \brief The Timer class
+ *
+ * Runs a machine in real time, in small slices of consistent size, from a thread
+ * of its own.
+ *
+ * Slices are scheduled against absolute deadlines so that wakeup latency doesn't
+ * accumulate; each slice runs the machine for however much time has really passed,
+ * so emulated time cannot drift from real time even if a wakeup is late.
+ */
 class Timer : public QObject
 {
 		Q_OBJECT
@@ -18,17 +30,30 @@ class Timer : public QObject
 		explicit Timer(QObject *parent = nullptr);
 		~Timer();
 
-		void startWithMachine(MachineTypes::TimedMachine *machine, std::mutex *machineMutex);
+		/// Starts running @c machine, which must be a timed machine; any events in @c inputs are applied to it at the start of each slice.
+		void startWithMachine(Machine::DynamicMachine *machine, std::mutex *machineMutex, Machine::Rewind *rewind = nullptr, Inputs::InputQueue *inputs = nullptr);
+
+	private:
+		using Clock = std::chrono::steady_clock;
+
+		/// The target interval between slices.
+		static constexpr auto slicePeriod = std::chrono::milliseconds(1);
+
+		/// How far behind schedule the thread may fall before it abandons the missed deadlines
+		/// rather than running a burst of back-to-back slices to catch up.
+		static constexpr auto maximumLag = std::chrono::milliseconds(20);
 
-	public slots:
 		void tick();
 
-	private:
-		MachineTypes::TimedMachine *machine = nullptr;
+		Machine::DynamicMachine *machine = nullptr;
+		MachineTypes::TimedMachine *timedMachine = nullptr;
 		std::mutex *machineMutex = nullptr;
-		int64_t lastTickNanos = 0;
-		FunctionThread thread;
-		std::unique_ptr<QTimer> timer;
+		Machine::Rewind *rewind = nullptr;
+		Inputs::InputQueue *inputs = nullptr;
+		Clock::time_point lastTick;
+
+		std::thread thread;
+		std::atomic<bool> isRunning = false;
 };
 
 #endif // TIMER_H
@@ -9,62 +9,101 @@
 #include <algorithm>
 #include <array>
 #include <atomic>
+#include <chrono>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <future>
 #include <iomanip>
 #include <iostream>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <optional>
+#include <sstream>
+#include <thread>
 #include <sys/stat.h>
 #include <unistd.h>
 
 #include <SDL2/SDL.h>
 
 #include "../../Analyser/Static/StaticAnalyser.hpp"
+#include "../../Analyser/Static/TargetCache.hpp"
+#include "../../Machines/Utility/ApplyInput.hpp"
+#include "../../Machines/Utility/BootCache.hpp"
+#include "../../Machines/Utility/InputMovie.hpp"
 #include "../../Machines/Utility/MachineForTarget.hpp"
+#include "../../Machines/Utility/ROMRepository.hpp"
+#include "../../Machines/Utility/Rewind.hpp"
+#include "../../Machines/Utility/RunAhead.hpp"
+#include "../../Machines/Utility/StateHasher.hpp"
 
 #include "../../ClockReceiver/TimeTypes.hpp"
 #include "../../ClockReceiver/ScanSynchroniser.hpp"
+#include "../../ClockReceiver/SlicePolicy.hpp"
+#include "../../ClockReceiver/VSyncPredictor.hpp"
 
 #include "../../Machines/MachineTypes.hpp"
 
 #include "../../Activity/Observer.hpp"
+#include "../../Outputs/Metrics.hpp"
 #include "../../Outputs/OpenGL/Primitives/Rectangle.hpp"
+#include "../../Outputs/OpenGL/Primitives/Shader.hpp"
 #include "../../Outputs/OpenGL/ScanTarget.hpp"
 #include "../../Outputs/OpenGL/Screenshot.hpp"
+#include "../../Outputs/ScanTargets/SoftwareScanTarget.hpp"
+#include "../../Outputs/Speaker/AudioRingBuffer.hpp"
 
 #include "../../Reflection/Enum.hpp"
 #include "../../Reflection/Struct.hpp"
 
+#include "../../Storage/Disk/DiskImage/TrackCache.hpp"
+
 namespace {
 
-struct MachineRunner {
-	MachineRunner() {
-		frame_lock_.clear();
-	}
+/*!
+	Runs the machine on a thread of its own, in real time.
 
+	Completed frames reach the main thread through the scan target's lock-free buffers, so
+	emulation never waits for presentation; input arrives through @c inputs, so never waits for
+	emulation. @c machine_mutex is needed only to serialise other direct access to the machine,
+	such as media insertion.
+*/
+struct MachineRunner {
 	~MachineRunner() {
 		stop();
 	}
 
 	void start() {
 		last_time_ = Time::nanos_now();
-		timer_ = SDL_AddTimer(timer_period, &sdl_callback, reinterpret_cast<void *>(this));
+		is_running_ = true;
+		thread_ = std::thread([this] {
+			while(is_running_) {
+				update();
+
+				// Pick the next slice according to recent input, audio buffering and the predicted
+				// time of the next vsync. There's no attempt to catch up after a stall; update() runs
+				// for however much time has really passed regardless.
+				if(audio_buffer) {
+					slice_policy_.set_audio_level(float(audio_buffer->buffered()) / float(audio_buffer->target_latency()));
+				}
+				const double frame_period = _frame_period;
+				const auto next_vsync = frame_period > 0.0 ? vsync_time_.load() + Time::Nanos(1e9 / frame_period) : 0;
+				const auto next_update = slice_policy_.next_update(last_time_, next_vsync);
+				slice_targets_.set(double(slice_policy_.slice()) / 1e9);
+
+				const auto now = Time::nanos_now();
+				if(next_update > now) {
+					std::this_thread::sleep_for(std::chrono::nanoseconds(next_update - now));
+				}
+			}
+		});
 	}
 
 	void stop() {
-		if(timer_) {
-			// SDL doesn't define whether SDL_RemoveTimer will block until any pending calls
-			// have been completed, or will return instantly. So: do an ordered shutdown,
-			// then remove the timer.
-			state_ = State::Stopping;
-			while(state_ == State::Stopping) {
-				frame_lock_.clear();
-			}
-
-			SDL_RemoveTimer(timer_);
-			timer_ = 0;
+		if(thread_.joinable()) {
+			is_running_ = false;
+			thread_.join();
 		}
 	}
 
@@ -82,32 +121,88 @@ struct MachineRunner {
 		_frame_period.store((1e9 * 32.0) / double(frame_time_average_));
 	}
 
-	void signal_did_draw() {
-		frame_lock_.clear();
-	}
-
 	void set_speed_multiplier(double multiplier) {
 		scan_synchroniser_.set_base_speed_multiplier(multiplier);
 	}
 
+	/// @returns A summary of synchronisation statistics since the last call, which will then be reset.
+	/// The caller must hold @c machine_mutex.
+	std::string take_frame_statistics() {
+		const auto summary = scan_synchroniser_.statistics().summary();
+		scan_synchroniser_.reset_statistics();
+		return summary;
+	}
+
+	/// Runs ahead of the real timeline before each frame is drawn, if run_ahead is set.
+	/// The caller must hold @c machine_mutex.
+	void present() {
+		if(run_ahead) run_ahead->present();
+	}
+
 	std::mutex *machine_mutex;
 	Machine::DynamicMachine *machine;
 
+	/// Input for the machine; each event is applied as emulation reaches the moment at which it was received.
+	Inputs::InputQueue inputs;
+
+	/// Posts @c event to the machine, without waiting for emulation unless the input queue is full.
+	void post_input(const Inputs::InputEvent &event) {
+		slice_policy_.announce_input(Time::nanos_now());
+		if(inputs.push(event)) return;
+
+		std::lock_guard lock_guard(*machine_mutex);
+		inputs.drain([this](const Inputs::InputEvent &queued) {
+			apply_input(queued);
+		});
+		apply_input(event);
+	}
+
+	/// The buffer that audio output is read from, if any; slices are shortened whenever it runs low.
+	const Outputs::Speaker::AudioRingBuffer *audio_buffer = nullptr;
+
+	/// The number of frames to run ahead by, and the means of doing so if the current machine supports it.
+	int run_ahead_frames = 0;
+	std::unique_ptr<Machine::RunAhead> run_ahead;
+
+	/// The number of bytes of rewind history to keep, and the history itself if the current machine supports it.
+	size_t rewind_arena_size = 0;
+	std::unique_ptr<Machine::Rewind> rewind;
+
+	/// A cache of the current machine's boot, if requested and it supports one.
+	std::unique_ptr<Machine::BootCache> boot_cache;
+
+	/// A recording of all input applied to the machine, if requested.
+	std::unique_ptr<Machine::InputRecorder> input_recorder;
+
 	private:
-		SDL_TimerID timer_ = 0;
-		Time::Nanos last_time_ = 0;
-		std::atomic<Time::Nanos> vsync_time_;
-		std::atomic_flag frame_lock_;
+		Time::SlicePolicy slice_policy_;
+		std::thread thread_;
+		std::atomic<bool> is_running_{false};
 
-		enum class State {
-			Running,
-			Stopping,
-			Stopped
-		};
-		std::atomic<State> state_{State::Running};
+		Time::Nanos last_time_ = 0;
+		std::atomic<Time::Nanos> vsync_time_ = 0;
 
 		Time::ScanSynchroniser scan_synchroniser_;
 
+		// Metrics; the speed ratio is emulated time divided by the host time taken to emulate it,
+		// smoothed across slices.
+		Outputs::Metrics::Histogram &slice_durations_ = Outputs::Metrics::Registry::shared().histogram(
+			"clksignal_run_slice_seconds", "Host time taken by each call to run the machine.",
+			{0.0001, 0.00025, 0.0005, 0.001, 0.002, 0.004, 0.008, 0.016, 0.032});
+		Outputs::Metrics::Gauge &speed_ratio_ = Outputs::Metrics::Registry::shared().gauge(
+			"clksignal_emulation_speed_ratio", "Emulated time divided by the host time taken to emulate it.");
+		Outputs::Metrics::Gauge &speed_multiplier_ = Outputs::Metrics::Registry::shared().gauge(
+			"clksignal_speed_multiplier", "The speed multiplier currently applied to the machine.");
+		Outputs::Metrics::Gauge &slice_targets_ = Outputs::Metrics::Registry::shared().gauge(
+			"clksignal_run_slice_target_seconds", "The host time currently intended to elapse between calls to run the machine.");
+		double smoothed_speed_ratio_ = 0.0;
+
+		/// Applies @c event to the machine, recording it if input is being recorded. The caller must hold @c machine_mutex.
+		void apply_input(const Inputs::InputEvent &event) {
+			if(input_recorder) input_recorder->record(event);
+			Machine::apply_input(*machine, event);
+		}
+
 		// A slightly clumsy means of trying to derive frame rate from calls to
 		// signal_vsync(); SDL_DisplayMode provides only an integral quantity
 		// whereas, empirically, it's fairly common for monitors to run at the
@@ -115,21 +210,9 @@ struct MachineRunner {
 		std::array<Time::Nanos, 32> frame_times_;
 		Time::Nanos frame_time_average_ = 0;
 		size_t frame_time_pointer_ = 0;
-		std::atomic<double> _frame_period;
-
-		static constexpr Uint32 timer_period = 4;
-		static Uint32 sdl_callback(Uint32, void *param) {
-			reinterpret_cast<MachineRunner *>(param)->update();
-			return timer_period;
-		}
+		std::atomic<double> _frame_period = 0.0;
 
 		void update() {
-			// If a shutdown is in progress, signal stoppage and do nothing.
-			if(state_ != State::Running) {
-				state_ = State::Stopped;
-				return;
-			}
-
 			// Get time now and determine how long it has been since the last time this
 			// function was called. If it's more than half a second then forego any activity
 			// now, as there's obviously been some sort of substantial time glitch.
@@ -149,24 +232,54 @@ struct MachineRunner {
 				split_and_sync = scan_synchroniser_.can_synchronise(scan_producer->get_scan_status(), _frame_period);
 			}
 
+			// Runs the machine for @c seconds, noting how long that took.
+			const auto run_for = [&](double seconds) {
+				const auto start_time = Time::nanos_now();
+				if(run_ahead) {
+					run_ahead->run_for(seconds);
+				} else {
+					timed_machine->run_for(seconds);
+				}
+				if(rewind) rewind->advance(seconds);
+				if(input_recorder) input_recorder->advance(seconds * timed_machine->get_speed_multiplier());
+				if(boot_cache) boot_cache->advance(*machine->state_producer(), seconds);
+
+				const auto duration = Time::nanos_now() - start_time;
+				scan_synchroniser_.add_emulation_time(duration);
+
+				slice_durations_.observe(double(duration) / 1e9);
+				if(duration > 0) {
+					smoothed_speed_ratio_ = smoothed_speed_ratio_ * 0.99 + 0.01 * (seconds * 1e9 / double(duration));
+					speed_ratio_.set(smoothed_speed_ratio_);
+				}
+			};
+
+			// Runs the machine from host time @c begin to @c end, applying each input received within
+			// that period as emulation reaches the moment at which it arrived. So input is delayed by
+			// a constant one update period, rather than being quantised to update boundaries.
+			const auto run_between = [&](Time::Nanos begin, Time::Nanos end) {
+				inputs.drain(end, [&](const Inputs::InputEvent &event) {
+					if(event.timestamp > begin) {
+						run_for(double(event.timestamp - begin) / 1e9);
+						begin = event.timestamp;
+					}
+					apply_input(event);
+				});
+				run_for(double(end - begin) / 1e9);
+			};
+
 			if(split_and_sync) {
-				timed_machine->run_for(double(vsync_time - last_time_) / 1e9);
+				run_between(last_time_, vsync_time);
 				timed_machine->set_speed_multiplier(
 					scan_synchroniser_.next_speed_multiplier(scan_producer->get_scan_status())
 				);
 
-				// This is a bit of an SDL ugliness; wait here until the next frame is drawn.
-				// That is, unless and until I can think of a good way of running background
-				// updates via a share group — possibly an extra intermediate buffer is needed?
-				lock_guard.unlock();
-				while(frame_lock_.test_and_set());
-				lock_guard.lock();
-
-				timed_machine->run_for(double(time_now - vsync_time) / 1e9);
+				run_between(vsync_time, time_now);
 			} else {
 				timed_machine->set_speed_multiplier(scan_synchroniser_.get_base_speed_multiplier());
-				timed_machine->run_for(double(time_now - last_time_) / 1e9);
+				run_between(last_time_, time_now);
 			}
+			speed_multiplier_.set(timed_machine->get_speed_multiplier());
 			last_time_ = time_now;
 		}
 };
@@ -174,40 +287,49 @@ struct MachineRunner {
 struct SpeakerDelegate: public Outputs::Speaker::Speaker::Delegate {
 	// This is empirically the best that I can seem to do with SDL's timer precision.
 	static constexpr size_t buffered_samples = 1024;
-	bool is_stereo = false;
 
 	void speaker_did_complete_samples(Outputs::Speaker::Speaker *, const std::vector<int16_t> &buffer) final {
-		std::lock_guard lock_guard(audio_buffer_mutex_);
-		const size_t buffer_size = buffered_samples * (is_stereo ? 2 : 1);
-		if(audio_buffer_.size() > buffer_size) {
-			audio_buffer_.erase(audio_buffer_.begin(), audio_buffer_.end() - buffer_size);
-		}
-		audio_buffer_.insert(audio_buffer_.end(), buffer.begin(), buffer.end());
+		audio_buffer_.write(buffer);
 	}
 
 	void audio_callback(Uint8 *stream, int len) {
-		std::lock_guard lock_guard(audio_buffer_mutex_);
-
-		// SDL buffer length is in bytes, so there's no need to adjust for stereo/mono in here.
-		const std::size_t sample_length = size_t(len) / sizeof(int16_t);
-		const std::size_t copy_length = std::min(sample_length, audio_buffer_.size());
-		int16_t *const target = static_cast<int16_t *>(static_cast<void *>(stream));
-
-		std::memcpy(stream, audio_buffer_.data(), copy_length * sizeof(int16_t));
-		if(copy_length < sample_length) {
-			std::memset(&target[copy_length], 0, (sample_length - copy_length) * sizeof(int16_t));
+		// SDL buffer length is in bytes; the ring buffer works in frames.
+		const std::size_t frame_size = sizeof(int16_t) * (is_stereo_ ? 2 : 1);
+		const std::size_t frame_length = size_t(len) / frame_size;
+		const std::size_t read_length = audio_buffer_.read(reinterpret_cast<int16_t *>(stream), frame_length);
+		if(read_length < frame_length) {
+			std::memset(&stream[read_length * frame_size], 0, (frame_length - read_length) * frame_size);
 		}
-		audio_buffer_.erase(audio_buffer_.begin(), audio_buffer_.begin() + copy_length);
 	}
 
 	static void SDL_audio_callback(void *userdata, Uint8 *stream, int len) {
 		reinterpret_cast<SpeakerDelegate *>(userdata)->audio_callback(stream, len);
 	}
 
-	SDL_AudioDeviceID audio_device;
+	/// Prepares to receive audio; a speaker should not be attached until this has been called.
+	void set_format(bool stereo, size_t device_samples) {
+		is_stereo_ = stereo;
+
+		// Aim to hold a full packet from the speaker plus a full read by the device.
+		audio_buffer_.set_format(stereo ? 2 : 1, buffered_samples + device_samples);
+	}
+
+	/// Updates @c underruns and @c overruns to include all those that have occurred so far.
+	void follow_statistics(Outputs::Metrics::Counter &underruns, Outputs::Metrics::Counter &overruns) const {
+		underruns.follow(audio_buffer_.underruns());
+		overruns.follow(audio_buffer_.overruns());
+	}
+
+	/// @returns The buffer from which audio is supplied to the device.
+	const Outputs::Speaker::AudioRingBuffer &buffer() const {
+		return audio_buffer_;
+	}
+
+	SDL_AudioDeviceID audio_device = 0;
 
-	std::mutex audio_buffer_mutex_;
-	std::vector<int16_t> audio_buffer_;
+	private:
+		Outputs::Speaker::AudioRingBuffer audio_buffer_;
+		bool is_stereo_ = false;
 };
 
 class ActivityObserver: public Activity::Observer {
@@ -284,13 +406,22 @@ class ActivityObserver: public Activity::Observer {
 
 		void set_led_status(const std::string &name, bool lit) final {
 			std::lock_guard lock_guard(mutex);
-			if(lit) lit_leds_.insert(name);
-			else lit_leds_.erase(name);
+			if(!lit) {
+				lit_leds_.erase(name);
+			} else if(lit_leds_.insert(name).second) {
+				Outputs::Metrics::Registry::shared().counter(
+					"clksignal_led_activations_total", "Occasions on which each LED, such as a drive or tape motor light, has been lit.",
+					"led=\"" + name + "\"").increment();
+			}
 		}
 
 		void announce_drive_event(const std::string &name, DriveEvent) final {
 			std::lock_guard lock_guard(mutex);
 			blinking_leds_.insert(name);
+
+			Outputs::Metrics::Registry::shared().counter(
+				"clksignal_drive_events_total", "Head steps and other events announced by each drive.",
+				"drive=\"" + name + "\"").increment();
 		}
 
 		std::map<std::string, std::unique_ptr<Outputs::Display::OpenGL::Rectangle>> lights_;
@@ -414,6 +545,42 @@ ParsedArguments parse_arguments(int argc, char *argv[]) {
 	return arguments;
 }
 
+/*!
+	For vanilla SDL purposes, assume system ROMs can be found in one of:
+
+		/usr/local/share/CLK/[system];
+		/usr/share/CLK/[system]; or
+		[user-supplied path]/[system]
+
+	@returns The directories to search, each ending in a slash.
+*/
+std::vector<std::string> rom_paths(const ParsedArguments &arguments) {
+	std::vector<std::string> paths = {
+		"/usr/local/share/CLK/",
+		"/usr/share/CLK/"
+	};
+
+	const auto rompath = arguments.selections.find("rompath");
+	if(rompath != arguments.selections.end() && !rompath->second.empty()) {
+		std::string path = rompath->second;
+
+		// Ensure the path ends in a slash.
+		if(path.back() != '/') {
+			path += '/';
+		}
+
+		// If ~ is present, expand it to %HOME%.
+		const size_t tilde_position = path.find("~");
+		if(tilde_position != std::string::npos) {
+			path.replace(tilde_position, 1, getenv("HOME"));
+		}
+
+		paths.push_back(path);
+	}
+
+	return paths;
+}
+
 std::string final_path_component(const std::string &path) {
 	// An empty path has no final component.
 	if(path.empty()) {
@@ -522,23 +689,199 @@ class SDLJoystick {
 		std::vector<Uint8> hat_values_;
 };
 
+/*!
+	Discards all audio, but gives the speaker a reason to generate it so that
+	audio costs are included in batch speed reports.
+*/
+struct NullSpeakerDelegate: public Outputs::Speaker::Speaker::Delegate {
+	void speaker_did_complete_samples(Outputs::Speaker::Speaker *, const std::vector<int16_t> &) final {}
+};
+
+/*!
+	Runs every file named in @c arguments for @c seconds of emulated time without a window,
+	several at once, rendering in software. The final frame of each is saved as a BMP in
+	@c output_directory and a speed report is printed per file.
+
+	If @c hash_states is @c true then the machine's state is also hashed after every frame and the
+	report includes the final hash plus one combined from those of every frame, so that runs on
+	different hosts can be checked to have followed identical paths.
+
+	@returns The process exit code: failure if any file could not be run.
+*/
+int run_batch(const ParsedArguments &arguments, double seconds, const std::string &output_directory, bool hash_states) {
+	const auto paths = rom_paths(arguments);
+	ROM::Repository::shared().add_directories(paths);
+
+	std::atomic<size_t> next_file = 0;
+	std::atomic<bool> did_fail = false;
+	std::mutex output_mutex;
+
+	const auto run_file = [&] (const std::string &file_name) {
+		const auto report = [&] (const std::string &text) {
+			std::lock_guard lock_guard(output_mutex);
+			std::cout << file_name << ": " << text << std::endl;
+		};
+		const auto fail = [&] (const std::string &reason) {
+			did_fail = true;
+			report(reason);
+		};
+
+		auto targets = Analyser::Static::GetTargets(file_name);
+		if(targets.empty()) {
+			fail("no target machine found");
+			return;
+		}
+		for(auto &target: targets) {
+			auto reflectable_target = dynamic_cast<Reflection::Struct *>(target.get());
+			if(!reflectable_target) continue;
+			arguments.apply(reflectable_target);
+		}
+
+		::Machine::Error error;
+		std::unique_ptr<::Machine::DynamicMachine> machine(::Machine::MachineForTargets(
+			targets,
+			[] (const ROM::Request &roms) {
+				return ROM::Repository::shared().fetch(roms);
+			},
+			error));
+		if(!machine) {
+			fail(error == ::Machine::Error::MissingROM ? "missing system ROMs" : "could not create machine");
+			return;
+		}
+
+		const auto timed_machine = machine->timed_machine();
+		if(!timed_machine) {
+			fail("machine cannot be run headless");
+			return;
+		}
+
+		// Apply all command-line options to the machine.
+		if(const auto configurable = machine->configurable_device()) {
+			const auto options = configurable->get_options();
+			arguments.apply(options.get());
+			configurable->set_options(options);
+		}
+
+		NullSpeakerDelegate speaker_delegate;
+		if(const auto audio_producer = machine->audio_producer()) {
+			if(const auto speaker = audio_producer->get_speaker()) {
+				speaker->set_output_rate(44100.0f, 1024, speaker->get_is_stereo());
+				speaker->set_delegate(&speaker_delegate);
+			}
+		}
+
+		Outputs::Display::SoftwareScanTarget scan_target;
+		const auto scan_producer = machine->scan_producer();
+		if(scan_producer) {
+			scan_producer->set_scan_target(&scan_target);
+		}
+
+		// Run in slices of approximately a frame, so that the scan target's buffers are
+		// drained well before they could fill.
+		constexpr double slice = 1.0 / 50.0;
+		std::optional<uint64_t> state_hash;
+		uint64_t history_hash = 0;
+		const auto start_time = std::chrono::steady_clock::now();
+		for(double elapsed = 0.0; elapsed < seconds; elapsed += slice) {
+			timed_machine->run_for(std::min(slice, seconds - elapsed));
+			scan_target.update();
+
+			if(hash_states) {
+				state_hash = machine->state_hash();
+				if(state_hash) history_hash = Machine::StateHasher::combine(history_hash, *state_hash);
+			}
+		}
+		const double wall_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+
+		// Save the final frame, named for the file it came from.
+		std::string screenshot;
+		if(scan_producer) {
+			screenshot = output_directory + "/" + final_path_component(file_name) + ".bmp";
+
+			const bool is_big_endian = SDL_BYTEORDER == SDL_BIG_ENDIAN;
+			SDL_Surface *const surface = SDL_CreateRGBSurfaceFrom(
+				const_cast<uint32_t *>(scan_target.pixels()),
+				int(scan_target.width()), int(scan_target.height()),
+				8*4,
+				int(scan_target.width())*4,
+				is_big_endian ? 0xff000000 : 0x000000ff,
+				is_big_endian ? 0x00ff0000 : 0x0000ff00,
+				is_big_endian ? 0x0000ff00 : 0x00ff0000,
+				0);
+			if(!surface || SDL_SaveBMP(surface, screenshot.c_str())) {
+				did_fail = true;
+				screenshot = "could not save screenshot";
+			}
+			SDL_FreeSurface(surface);
+		}
+
+		std::ostringstream text;
+		text << Machine::ShortNameForTargetMachine(targets.front()->machine) << "; ";
+		text << seconds << " emulated seconds in " << wall_seconds << " wall seconds (";
+		text << (wall_seconds > 0.0 ? seconds / wall_seconds : 0.0) << "x real time)";
+		if(!screenshot.empty()) text << "; " << screenshot;
+		if(hash_states) {
+			if(state_hash) {
+				text << std::hex << std::setfill('0');
+				text << "; state " << std::setw(16) << *state_hash << ", history " << std::setw(16) << history_hash;
+			} else {
+				text << "; state can't be hashed";
+			}
+		}
+		report(text.str());
+	};
+
+	// Workers take files in order until none remain. Each machine runs on a single worker,
+	// but the software scan target spreads each frame across the shared thread pool, so
+	// workers are kept distinct from that pool.
+	const size_t worker_count = std::min<size_t>(std::max(std::thread::hardware_concurrency(), 1u), arguments.file_names.size());
+	std::vector<std::thread> workers;
+	for(size_t c = 0; c < worker_count; c++) {
+		workers.emplace_back([&] {
+			while(true) {
+				const size_t index = next_file++;
+				if(index >= arguments.file_names.size()) break;
+				run_file(arguments.file_names[index]);
+			}
+		});
+	}
+	for(auto &worker: workers) {
+		worker.join();
+	}
+
+	return did_fail ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
 }
 
 int main(int argc, char *argv[]) {
+	// Time to first frame is measured from here.
+	Machine::StartupProfile startup_profile;
 	SDL_Window *window = nullptr;
 
 	// Attempt to parse arguments.
 	const ParsedArguments arguments = parse_arguments(argc, argv);
 
 	// This may be printed either as
-	const std::string usage_suffix = " [file or --new={machine}] [OPTIONS] [--rompath={path to ROMs}] [--speed={speed multiplier, e.g. 1.5}]  [--logical-keyboard] [--volume={0.0 to 1.0}]";
+	const std::string usage_suffix = " [file or --new={machine}] [OPTIONS] [--rompath={path to ROMs}] [--speed={speed multiplier, e.g. 1.5}]  [--logical-keyboard] [--volume={0.0 to 1.0}] [--frame-statistics] [--run-ahead={frames, e.g. 1}] [--rewind={megabytes of history, e.g. 16}] [--boot-cache={seconds of boot to cache, e.g. 5}] [--batch={emulated seconds per file, e.g. 30}] [--batch-output={directory for final screenshots}] [--metrics={file to which to export runtime metrics}] [--threaded-crt] [--single-pass-crt] [--frame-skip={frames per displayed frame, e.g. 4}] [--track-cache] [--analysis-cache] [--memory-report] [--startup-profile] [--state-hashes] [--record-input={file to which to save an input movie}]";
 
 	// Print a help message if requested.
 	if(arguments.selections.find("help") != arguments.selections.end() || arguments.selections.find("h") != arguments.selections.end()) {
 		const auto all_machines = Machine::AllMachines(Machine::Type::DoesntRequireMedia, false);
 
 		std::cout << "Usage: " << final_path_component(argv[0]) << usage_suffix << std::endl;
-		std::cout << "Use alt+enter to toggle full screen display. Use control+shift+V to paste text." << std::endl;
+		std::cout << "Use alt+enter to toggle full screen display. Use control+shift+V to paste text. Hold control+shift+backspace to rewind, if enabled." << std::endl;
+		std::cout << "With --batch, every file listed is run without a window, several at once, and a screenshot of its final frame is saved to the --batch-output directory." << std::endl;
+		std::cout << "With --batch and --state-hashes, each machine's final state is hashed, as is its state after every frame, for comparison between runs." << std::endl;
+		std::cout << "With --metrics, runtime metrics are rewritten to the named file every second in the Prometheus text format, e.g. for a node_exporter textfile collector." << std::endl;
+		std::cout << "With --threaded-crt, video signal processing is performed on a separate thread from emulation; this is ineffective in combination with --run-ahead." << std::endl;
+		std::cout << "With --single-pass-crt, composite and S-Video signals are decoded in a single pass rather than via an intermediate texture, which is less demanding of GPU fill rate." << std::endl;
+		std::cout << "With --frame-skip, only one of every so many frames is generated and displayed; this is intended for use with a high --speed." << std::endl;
+		std::cout << "With --track-cache, tracks decoded from slow-to-decode disk images are kept in the cache directory for quicker subsequent launches." << std::endl;
+		std::cout << "With --analysis-cache, the machines and settings determined for each file are kept in the cache directory so that it needn't be analysed again." << std::endl;
+		std::cout << "With --memory-report, the memory held by the machine and its outputs is listed upon exit." << std::endl;
+		std::cout << "With --startup-profile, the time taken by each phase of startup is listed once the first frame has been displayed." << std::endl;
+		std::cout << "With --record-input, keyboard, joystick and mouse input is saved upon exit, or upon a change of machine, as a movie that clksignal-bench can replay; rewinding is disabled while recording, and pasted text and media changes aren't recorded." << std::endl;
 		std::cout << "Required machine type **and all options** are determined from the file if specified; otherwise use:" << std::endl << std::endl;
 		std::cout << "\t--new={";
 		bool is_first = true;
@@ -627,8 +970,58 @@ int main(int argc, char *argv[]) {
 		return EXIT_SUCCESS;
 	}
 
+	// ROM CRCs, any boot caches and, optionally, decoded disk tracks and analysis results are kept in the user's cache directory, if there is one.
+	std::string cache_directory;
+	{
+		const char *const cache_home = getenv("XDG_CACHE_HOME");
+		const char *const home = getenv("HOME");
+		cache_directory =
+			cache_home ? std::string(cache_home) : (home ? std::string(home) + "/.cache" : std::string());
+
+		struct stat cache_stats;
+		if(!cache_directory.empty() && !stat(cache_directory.c_str(), &cache_stats) && S_ISDIR(cache_stats.st_mode)) {
+			ROM::Repository::shared().set_index_file(cache_directory + "/clksignal-roms.index");
+		} else {
+			cache_directory.clear();
+		}
+	}
+
+	// Tracks are cached from the first time they're decoded, which may be during analysis.
+	if(arguments.selections.find("track-cache") != arguments.selections.end()) {
+		Storage::Disk::TrackCache::set_directory(cache_directory);
+	}
+	if(arguments.selections.find("analysis-cache") != arguments.selections.end()) {
+		Analyser::Static::TargetCache::set_directory(cache_directory);
+	}
+
+	// If batch mode was requested, run every file headless and exit.
+	const auto batch_argument = arguments.selections.find("batch");
+	if(batch_argument != arguments.selections.end()) {
+		const double seconds = strtod(batch_argument->second.c_str(), nullptr);
+		if(seconds <= 0.0 || arguments.file_names.empty()) {
+			std::cerr << "Batch mode requires a number of seconds to run for, e.g. --batch=30, and at least one file." << std::endl;
+			return EXIT_FAILURE;
+		}
+
+		const auto output_argument = arguments.selections.find("batch-output");
+		return run_batch(
+			arguments,
+			seconds,
+			output_argument != arguments.selections.end() && !output_argument->second.empty() ? output_argument->second : ".",
+			arguments.selections.find("state-hashes") != arguments.selections.end()
+		);
+	}
+
+	// Scan for ROMs while the supplied file is analysed; the ROM fetcher will wait for this to complete.
+	const auto rom_scan = std::async(std::launch::async, [&arguments, &startup_profile] {
+		Machine::StartupProfile::Timer timer(&startup_profile, "Scan for ROMs");
+		ROM::Repository::shared().add_directories(rom_paths(arguments));
+	});
+
 	// Determine the machine for the supplied file, if any, or from --new.
 	Analyser::Static::TargetList targets;
+	std::optional<Machine::StartupProfile::Timer> analysis_timer;
+	analysis_timer.emplace(&startup_profile, "Analyse media");
 
 	const auto new_argument = arguments.selections.find("new");
 	std::string long_machine_name;
@@ -663,6 +1056,11 @@ int main(int argc, char *argv[]) {
 		}
 	}
 
+	analysis_timer.reset();
+
+	// Begin whatever preparation for the machine can overlap the ROM scan.
+	auto preparation = ::Machine::PrepareForTargets(targets, &startup_profile);
+
 	if(targets.empty()) {
 		if(!arguments.file_names.empty()) {
 			std::cerr << "Cannot open ";
@@ -689,72 +1087,32 @@ int main(int argc, char *argv[]) {
 	MachineRunner machine_runner;
 	SpeakerDelegate speaker_delegate;
 
-	// For vanilla SDL purposes, assume system ROMs can be found in one of:
-	//
-	//	/usr/local/share/CLK/[system];
-	//	/usr/share/CLK/[system]; or
-	//	[user-supplied path]/[system]
 	ROM::Request missing_roms;
+	ROM::Map fetched_roms;
 	std::vector<std::string> checked_paths;
-	ROMMachine::ROMFetcher rom_fetcher = [&missing_roms, &arguments, &checked_paths]
+	ROMMachine::ROMFetcher rom_fetcher = [&missing_roms, &fetched_roms, &arguments, &checked_paths]
 		(const ROM::Request &roms) -> ROM::Map {
-			std::vector<std::string> paths = {
-				"/usr/local/share/CLK/",
-				"/usr/share/CLK/"
-			};
-
-			const auto rompath = arguments.selections.find("rompath");
-			if(rompath != arguments.selections.end()) {
-				std::string path = rompath->second;
-
-				// Ensure the path ends in a slash.
-				if(path.back() != '/') {
-					path += '/';
-				}
-
-				// If ~ is present, expand it to %HOME%.
-				const size_t tilde_position = path.find("~");
-				if(tilde_position != std::string::npos) {
-					path.replace(tilde_position, 1, getenv("HOME"));
-				}
+			const auto paths = rom_paths(arguments);
 
-				paths.push_back(path);
-			}
+			// The repository scans each directory only once, and shares ROMs between machines.
+			auto &repository = ROM::Repository::shared();
+			repository.add_directories(paths);
+			ROM::Map results = repository.fetch(roms);
 
-			ROM::Map results;
+			// Note every path that would have been checked for anything not found.
 			for(const auto &description: roms.all_descriptions()) {
+				if(results.find(description.name) != results.end()) continue;
 				for(const auto &file_name: description.file_names) {
-					FILE *file = nullptr;
-					std::vector<std::string> rom_checked_paths;
 					for(const auto &path: paths) {
-						std::string local_path = path + description.machine_name + "/" + file_name;
-						file = std::fopen(local_path.c_str(), "rb");
-						rom_checked_paths.push_back(local_path);
-						if(file) break;
-					}
-
-					if(!file) {
-						std::copy(rom_checked_paths.begin(), rom_checked_paths.end(), std::back_inserter(checked_paths));
-						continue;
-					}
-
-					std::vector<uint8_t> data;
-
-					std::fseek(file, 0, SEEK_END);
-					data.resize(std::ftell(file));
-					std::fseek(file, 0, SEEK_SET);
-					std::size_t read = fread(data.data(), 1, data.size(), file);
-					std::fclose(file);
-
-					if(read == data.size()) {
-						results[description.name] = std::move(data);
-					} else {
-						std::copy(rom_checked_paths.begin(), rom_checked_paths.end(), std::back_inserter(checked_paths));
+						checked_paths.push_back(path + description.machine_name + "/" + file_name);
 					}
 				}
 			}
 
 			missing_roms = roms.subtract(results);
+			for(const auto &rom: results) {
+				fetched_roms[rom.first] = rom.second;
+			}
 			return results;
 		};
 
@@ -768,7 +1126,8 @@ int main(int argc, char *argv[]) {
 	// Create and configure a machine.
 	::Machine::Error error;
 	std::mutex machine_mutex;
-	std::unique_ptr<::Machine::DynamicMachine> machine(::Machine::MachineForTargets(targets, rom_fetcher, error));
+	std::unique_ptr<::Machine::DynamicMachine> machine(::Machine::MachineForTargets(targets, rom_fetcher, error, &startup_profile));
+	preparation.wait();
 	if(!machine) {
 		switch(error) {
 			default: break;
@@ -819,6 +1178,49 @@ int main(int argc, char *argv[]) {
 		}
 	}
 
+	// Check whether running ahead has been requested.
+	{
+		const auto run_ahead_argument = arguments.selections.find("run-ahead");
+		if(run_ahead_argument != arguments.selections.end()) {
+			const char *frames_string = run_ahead_argument->second.c_str();
+			char *end;
+			const long frames = strtol(frames_string, &end, 10);
+
+			if(size_t(end - frames_string) != strlen(frames_string)) {
+				std::cerr << "Unable to parse run-ahead: " << frames_string << std::endl;
+			} else if(frames < 0 || frames > 8) {
+				std::cerr << "Cannot run ahead by " << frames_string << " frames; use between 0 and 8." << std::endl;
+			} else {
+				machine_runner.run_ahead_frames = int(frames);
+			}
+		}
+	}
+
+	// Check whether a rewind history has been requested.
+	{
+		const auto rewind_argument = arguments.selections.find("rewind");
+		if(rewind_argument != arguments.selections.end()) {
+			const char *megabytes_string = rewind_argument->second.c_str();
+			char *end;
+			const double megabytes = strtod(megabytes_string, &end);
+
+			if(size_t(end - megabytes_string) != strlen(megabytes_string)) {
+				std::cerr << "Unable to parse rewind: " << megabytes_string << std::endl;
+			} else if(megabytes <= 0.0 || megabytes > 4096.0) {
+				std::cerr << "Cannot keep " << megabytes_string << "mb of rewind history; use more than 0 and at most 4096." << std::endl;
+			} else {
+				machine_runner.rewind_arena_size = size_t(megabytes * 1024.0 * 1024.0);
+			}
+		}
+	}
+
+	// Check whether input is to be recorded; a movie needs an unbroken timeline, so this precludes rewinding.
+	const auto record_input_argument = arguments.selections.find("record-input");
+	if(record_input_argument != arguments.selections.end() && !record_input_argument->second.empty()) {
+		machine_runner.input_recorder = std::make_unique<Machine::InputRecorder>();
+		machine_runner.rewind_arena_size = 0;
+	}
+
 	// Apply the desired output volume, if requested.
 	{
 		const auto volume_argument = arguments.selections.find("volume");
@@ -849,6 +1251,27 @@ int main(int argc, char *argv[]) {
 		SDL_StartTextInput();
 	}
 
+	// Restore a cached boot if requested and available; otherwise prepare to capture one,
+	// unless media is about to be inserted.
+	{
+		const auto boot_cache_argument = arguments.selections.find("boot-cache");
+		const auto state_producer = machine->state_producer();
+		if(boot_cache_argument != arguments.selections.end() && state_producer && targets.size() == 1) {
+			const char *seconds_string = boot_cache_argument->second.c_str();
+			char *end;
+			const double seconds = strtod(seconds_string, &end);
+
+			if(size_t(end - seconds_string) != strlen(seconds_string) || seconds <= 0.0) {
+				std::cerr << "Unable to parse boot cache duration: " << seconds_string << std::endl;
+			} else {
+				machine_runner.boot_cache = std::make_unique<Machine::BootCache>(cache_directory, *targets.front(), fetched_roms, seconds);
+				if(!machine_runner.boot_cache->restore(*state_producer) && !arguments.file_names.empty()) {
+					machine_runner.boot_cache->cancel();
+				}
+			}
+		}
+	}
+
 	// Ensure all media is inserted, if this machine accepts it.
 	{
 		auto media_target = machine->media_target();
@@ -896,8 +1319,32 @@ int main(int argc, char *argv[]) {
 	GLint target_framebuffer = 0;
 	glGetIntegerv(GL_FRAMEBUFFER_BINDING, &target_framebuffer);
 
-	// Setup output, assuming a CRT machine for now, and prepare a best-effort updater.
+	// Setup output, assuming a CRT machine for now, and prepare a best-effort updater. Linked shaders
+	// are cached alongside everything else.
+	Outputs::Display::OpenGL::Shader::set_binary_cache_directory(cache_directory);
 	Outputs::Display::OpenGL::ScanTarget scan_target(target_framebuffer);
+	scan_target.set_allows_asynchronous_producers(arguments.selections.find("threaded-crt") != arguments.selections.end());
+	if(arguments.selections.find("single-pass-crt") != arguments.selections.end()) {
+		scan_target.set_pipeline(Outputs::Display::OpenGL::ScanTarget::Pipeline::SinglePass);
+	}
+
+	// Apply frame skipping, if requested.
+	{
+		const auto frame_skip_argument = arguments.selections.find("frame-skip");
+		if(frame_skip_argument != arguments.selections.end()) {
+			const char *frames_string = frame_skip_argument->second.c_str();
+			char *end;
+			const long frames = strtol(frames_string, &end, 10);
+
+			if(size_t(end - frames_string) != strlen(frames_string)) {
+				std::cerr << "Unable to parse frame-skip: " << frames_string << std::endl;
+			} else if(frames < 1 || frames > 60) {
+				std::cerr << "Cannot display one in " << frames_string << " frames; use between 1 and 60." << std::endl;
+			} else {
+				scan_target.set_frames_per_output(int(frames));
+			}
+		}
+	}
 	std::unique_ptr<ActivityObserver> activity_observer;
 	bool uses_mouse;
 	std::vector<SDLJoystick> joysticks;
@@ -926,15 +1373,37 @@ int main(int argc, char *argv[]) {
 				desired_audio_spec.callback = SpeakerDelegate::SDL_audio_callback;
 				desired_audio_spec.userdata = &speaker_delegate;
 
+				// Close any previous device, so that its callback can't overlap with
+				// reconfiguration of the delegate.
+				if(speaker_delegate.audio_device) {
+					SDL_CloseAudioDevice(speaker_delegate.audio_device);
+				}
 				speaker_delegate.audio_device = SDL_OpenAudioDevice(nullptr, 0, &desired_audio_spec, &obtained_audio_spec, SDL_AUDIO_ALLOW_FREQUENCY_CHANGE);
 
 				speaker->set_output_rate(obtained_audio_spec.freq, desired_audio_spec.samples, obtained_audio_spec.channels == 2);
-				speaker_delegate.is_stereo = obtained_audio_spec.channels == 2;
+				speaker_delegate.set_format(obtained_audio_spec.channels == 2, obtained_audio_spec.samples);
 				speaker->set_delegate(&speaker_delegate);
+				machine_runner.audio_buffer = &speaker_delegate.buffer();
 				SDL_PauseAudioDevice(speaker_delegate.audio_device, 0);
 			}
 		}
 
+		// Run ahead if requested and possible; this wraps the scan target and speaker delegate set above.
+		const auto state_producer = machine->state_producer();
+		if(machine_runner.run_ahead_frames && state_producer) {
+			machine_runner.run_ahead = std::make_unique<Machine::RunAhead>(
+				*machine->timed_machine(),
+				*machine->scan_producer(),
+				*state_producer,
+				&scan_target,
+				machine_runner.run_ahead_frames);
+		}
+
+		// Keep a rewind history if requested and possible.
+		if(machine_runner.rewind_arena_size && state_producer) {
+			machine_runner.rewind = std::make_unique<Machine::Rewind>(*state_producer, machine_runner.rewind_arena_size);
+		}
+
 		/*
 			If the machine offers anything for activity observation,
 			create and register an activity observer.
@@ -979,6 +1448,43 @@ int main(int argc, char *argv[]) {
 		KeyPress() {}
 	};
 	std::vector<KeyPress> keypresses;
+	std::vector<SDL_Event> events;
+
+	// If requested, collect frame timing statistics and log them periodically.
+	const bool log_frame_statistics = arguments.selections.find("frame-statistics") != arguments.selections.end();
+	const bool log_startup_profile = arguments.selections.find("startup-profile") != arguments.selections.end();
+	bool has_presented_frame = false;
+	constexpr Time::Nanos frame_statistics_period = 10'000'000'000;
+	Time::VSyncPredictor frame_timing;
+	Time::Nanos last_frame_statistics_time = Time::nanos_now();
+	{
+		SDL_DisplayMode display_mode;
+		if(!SDL_GetWindowDisplayMode(window, &display_mode) && display_mode.refresh_rate) {
+			frame_timing.set_frame_rate(float(display_mode.refresh_rate));
+		}
+	}
+
+	// If requested, export metrics periodically.
+	const auto metrics_argument = arguments.selections.find("metrics");
+	const std::string metrics_path = metrics_argument != arguments.selections.end() ? metrics_argument->second : "";
+	constexpr Time::Nanos metrics_period = 1'000'000'000;
+	Time::Nanos last_metrics_time = Time::nanos_now();
+
+	auto &metrics = Outputs::Metrics::Registry::shared();
+	auto &frames_presented = metrics.counter("clksignal_frames_presented_total", "Frames presented to the host display.");
+	auto &frames_produced = metrics.counter("clksignal_frames_produced_total", "Frames output by the emulated machine.");
+	auto &frames_incomplete = metrics.counter("clksignal_frames_incomplete_total", "Frames output by the emulated machine from which data was dropped because presentation fell behind.");
+	auto &audio_underruns = metrics.counter("clksignal_audio_underruns_total", "Occasions on which the audio device found insufficient audio.");
+	auto &audio_overruns = metrics.counter("clksignal_audio_overruns_total", "Occasions on which audio was discarded to bound latency.");
+	Outputs::Metrics::Gauge *machine_info = nullptr;
+	const auto announce_machine = [&metrics, &machine_info, &targets] {
+		if(machine_info) machine_info->set(0.0);
+		machine_info = &metrics.gauge(
+			"clksignal_machine_info", "Set for the machine currently being emulated.",
+			"machine=\"" + Machine::ShortNameForTargetMachine(targets.front()->machine) + "\"");
+		machine_info->set(1.0);
+	};
+	announce_machine();
 
 	// Run the main event loop until the OS tells us to quit.
 	bool should_quit = false;
@@ -986,24 +1492,62 @@ int main(int argc, char *argv[]) {
 	machine_runner.start();
 	while(!should_quit) {
 		// Draw a new frame, indicating completion of the draw to the machine runner.
+		frame_timing.begin_redraw();
+		{
+			std::lock_guard lock_guard(machine_mutex);
+			machine_runner.present();
+		}
 		scan_target.update(int(window_width), int(window_height));
 		scan_target.draw(int(window_width), int(window_height));
 		if(activity_observer) activity_observer->draw();
-		machine_runner.signal_did_draw();
+		frame_timing.end_redraw();
 
 		// Wait for presentation of that frame, posting a vsync.
 		SDL_GL_SwapWindow(window);
 		machine_runner.signal_vsync();
+		frame_timing.announce_vsync();
+		frames_presented.increment();
+
+		if(!has_presented_frame) {
+			has_presented_frame = true;
+			startup_profile.mark("First frame");
+			if(log_startup_profile) std::cout << startup_profile.summary();
+		}
+
+		if(!metrics_path.empty() && Time::nanos_now() - last_metrics_time >= metrics_period) {
+			last_metrics_time = Time::nanos_now();
+			frames_produced.follow(scan_target.frames());
+			frames_incomplete.follow(scan_target.incomplete_frames());
+			speaker_delegate.follow_statistics(audio_underruns, audio_overruns);
+			if(!metrics.write(metrics_path)) {
+				std::cerr << "Failed to write metrics to " << metrics_path << std::endl;
+			}
+		}
 
 		// NB: machine_mutex is *not* currently locked, therefore it shouldn't
 		// be 'most' of the time — assuming most of the time is spent waiting
 		// on vsync, anyway.
 
-		// Grab the machine lock and process all pending events.
-		std::lock_guard lock_guard(machine_mutex);
+		// Collect pending events before taking the machine lock, as pumping
+		// the event queue can be slow.
+		events.clear();
+		SDL_Event next_event;
+		while(SDL_PollEvent(&next_event)) {
+			events.push_back(next_event);
+		}
+
+		// Process all pending events. Input is posted to the machine runner, which never waits for
+		// emulation; the machine lock is taken only for anything else that accesses the machine.
+		if(log_frame_statistics && Time::nanos_now() - last_frame_statistics_time >= frame_statistics_period) {
+			std::lock_guard lock_guard(machine_mutex);
+			last_frame_statistics_time = Time::nanos_now();
+			std::cerr << frame_timing.statistics().summary() << std::endl;
+			std::cerr << machine_runner.take_frame_statistics() << std::endl;
+			frame_timing.reset_statistics();
+		}
+
 		const auto keyboard_machine = machine->keyboard_machine();
-		SDL_Event event;
-		while(SDL_PollEvent(&event)) {
+		for(const auto &event: events) {
 			switch(event.type) {
 				case SDL_QUIT:	should_quit = true;	break;
 
@@ -1022,12 +1566,14 @@ int main(int argc, char *argv[]) {
 				break;
 
 				case SDL_DROPFILE: {
+					std::lock_guard lock_guard(machine_mutex);
 					const Analyser::Static::Media media = Analyser::Static::GetMedia(event.drop.file);
 
 					// If the new file is only media, insert it; if it is a state snapshot then
 					// tear down the entire machine and replace it.
 					if(!media.empty()) {
 						machine->media_target()->insert_media(media);
+						if(machine_runner.boot_cache) machine_runner.boot_cache->cancel();
 						break;
 					}
 
@@ -1038,9 +1584,22 @@ int main(int argc, char *argv[]) {
 					std::unique_ptr<::Machine::DynamicMachine> new_machine(::Machine::MachineForTargets(targets, rom_fetcher, error));
 					if(error != Machine::Error::None) break;
 
+					machine_runner.run_ahead.reset();
+					machine_runner.rewind.reset();
+					machine_runner.boot_cache.reset();
+
+					// A movie applies only to the machine that it began with, so ends with it.
+					if(machine_runner.input_recorder) {
+						if(!machine_runner.input_recorder->movie().write(record_input_argument->second)) {
+							std::cerr << "Unable to save input movie to " << record_input_argument->second << std::endl;
+						}
+						machine_runner.input_recorder.reset();
+					}
+
 					machine = std::move(new_machine);
 					static_cast<Outputs::Display::ScanTarget *>(&scan_target)->will_change_owner();
 					setup_machine_input_output();
+					announce_machine();
 					window_titler.set_file_name(final_path_component(event.drop.file));
 				} break;
 
@@ -1054,11 +1613,21 @@ int main(int argc, char *argv[]) {
 						// Syphon off the key-press if it's control+shift+V (paste).
 						if(event.key.keysym.sym == SDLK_v && (SDL_GetModState()&KMOD_CTRL) && (SDL_GetModState()&KMOD_SHIFT)) {
 							if(keyboard_machine) {
+								std::lock_guard lock_guard(machine_mutex);
 								keyboard_machine->type_string(SDL_GetClipboardText());
 								break;
 							}
 						}
 
+						// Step back through the rewind history upon ctrl+shift+backspace, repeating while it is held.
+						if(event.key.keysym.sym == SDLK_BACKSPACE && (SDL_GetModState()&KMOD_CTRL) && (SDL_GetModState()&KMOD_SHIFT)) {
+							if(machine_runner.rewind) {
+								std::lock_guard lock_guard(machine_mutex);
+								machine_runner.rewind->step_back();
+								break;
+							}
+						}
+
 						// Use ctrl+escape to release the mouse (if captured).
 						if(event.key.keysym.sym == SDLK_ESCAPE && (SDL_GetModState()&KMOD_CTRL)) {
 							SDL_SetRelativeMouseMode(SDL_FALSE);
@@ -1119,10 +1688,7 @@ int main(int argc, char *argv[]) {
 						SDL_ShowCursor((fullscreen_mode&SDL_WINDOW_FULLSCREEN_DESKTOP) ? SDL_DISABLE : SDL_ENABLE);
 
 						// Announce a potential discontinuity in keyboard input.
-						const auto keyboard_machine = machine->keyboard_machine();
-						if(keyboard_machine) {
-							keyboard_machine->get_keyboard().reset_all_keys();
-						}
+						machine_runner.post_input(Inputs::InputEvent::reset_keys_event());
 						break;
 					}
 
@@ -1139,17 +1705,16 @@ int main(int argc, char *argv[]) {
 
 					const auto mouse_machine = machine->mouse_machine();
 					if(mouse_machine) {
-						mouse_machine->get_mouse().set_button_pressed(
+						machine_runner.post_input(Inputs::InputEvent::mouse_button_event(
 							event.button.button % mouse_machine->get_mouse().get_number_of_buttons(),
-							event.type == SDL_MOUSEBUTTONDOWN);
+							event.type == SDL_MOUSEBUTTONDOWN));
 					}
 				} break;
 
 				case SDL_MOUSEMOTION: {
 					if(SDL_GetRelativeMouseMode()) {
-						const auto mouse_machine = machine->mouse_machine();
-						if(mouse_machine) {
-							mouse_machine->get_mouse().move(event.motion.xrel, event.motion.yrel);
+						if(uses_mouse) {
+							machine_runner.post_input(Inputs::InputEvent::mouse_motion_event(event.motion.xrel, event.motion.yrel));
 						}
 					}
 				} break;
@@ -1200,71 +1765,65 @@ int main(int argc, char *argv[]) {
 			}
 		}
 
-		// Handle accumulated key states.
-		const auto joystick_machine = machine->joystick_machine();
+		// Handle accumulated key states, posting each to the keyboard if it has a corresponding key,
+		// with a joystick input to use instead should the keyboard not want it.
 		for (const auto &keypress: logical_keyboard ? matched_keypresses : keypresses) {
-			// Try to set this key on the keyboard first, if there is one.
-			if(keyboard_machine) {
-				Inputs::Keyboard::Key key = Inputs::Keyboard::Key::Space;
-				if(KeyboardKeyForSDLScancode(keypress.scancode, key)) {
-					// In principle there's no need for a conditional here; in practice logical_keyboard mode
-					// is sufficiently untested on SDL, and somewhat too reliant on empirical timestamp behaviour,
-					// for it to be trustworthy enough otherwise to expose.
-					if(logical_keyboard) {
-						if(keyboard_machine->apply_key(key, keypress.input.size() ? keypress.input[0] : 0, keypress.is_down, logical_keyboard)) {
-							continue;
-						}
-					} else {
-						// This is a slightly terrible way of obtaining a symbol for the key, e.g. for letters it will always return
-						// the capital letter version, at least empirically. But it'll have to do for now.
-						const char *key_name = SDL_GetKeyName(keypress.keycode);
-						if(keyboard_machine->get_keyboard().set_key_pressed(key, (strlen(key_name) == 1) ? key_name[0] : 0, keypress.is_down)) {
-							continue;
-						}
+			const bool is_pressed = keypress.is_down;
+
+			std::optional<Inputs::Joystick::Input> joystick_input;
+			switch(keypress.scancode) {
+				case SDL_SCANCODE_LEFT:		joystick_input.emplace(Inputs::Joystick::Input::Left);		break;
+				case SDL_SCANCODE_RIGHT:	joystick_input.emplace(Inputs::Joystick::Input::Right);		break;
+				case SDL_SCANCODE_UP:		joystick_input.emplace(Inputs::Joystick::Input::Up);		break;
+				case SDL_SCANCODE_DOWN:		joystick_input.emplace(Inputs::Joystick::Input::Down);		break;
+				case SDL_SCANCODE_SPACE:	joystick_input.emplace(Inputs::Joystick::Input::Fire);		break;
+				case SDL_SCANCODE_A:		joystick_input.emplace(Inputs::Joystick::Input::Fire, 0);	break;
+				case SDL_SCANCODE_S:		joystick_input.emplace(Inputs::Joystick::Input::Fire, 1);	break;
+				case SDL_SCANCODE_D:		joystick_input.emplace(Inputs::Joystick::Input::Fire, 2);	break;
+				case SDL_SCANCODE_F:		joystick_input.emplace(Inputs::Joystick::Input::Fire, 3);	break;
+				default: {
+					if(keypress.input.size()) {
+						joystick_input.emplace(wchar_t(keypress.input[0]));
 					}
-				}
+				} break;
 			}
 
-			// Having failed that, try converting it into a joystick action.
-			if(joystick_machine) {
-				auto &joysticks = joystick_machine->get_joysticks();
-				if(!joysticks.empty()) {
-					const bool is_pressed = keypress.is_down;
-					switch(keypress.scancode) {
-						case SDL_SCANCODE_LEFT:		joysticks[0]->set_input(Inputs::Joystick::Input::Left, is_pressed);		break;
-						case SDL_SCANCODE_RIGHT:	joysticks[0]->set_input(Inputs::Joystick::Input::Right, is_pressed);	break;
-						case SDL_SCANCODE_UP:		joysticks[0]->set_input(Inputs::Joystick::Input::Up, is_pressed);		break;
-						case SDL_SCANCODE_DOWN:		joysticks[0]->set_input(Inputs::Joystick::Input::Down, is_pressed);		break;
-						case SDL_SCANCODE_SPACE:	joysticks[0]->set_input(Inputs::Joystick::Input::Fire, is_pressed);		break;
-						case SDL_SCANCODE_A:		joysticks[0]->set_input(Inputs::Joystick::Input(Inputs::Joystick::Input::Fire, 0), is_pressed);	break;
-						case SDL_SCANCODE_S:		joysticks[0]->set_input(Inputs::Joystick::Input(Inputs::Joystick::Input::Fire, 1), is_pressed);	break;
-						case SDL_SCANCODE_D:		joysticks[0]->set_input(Inputs::Joystick::Input(Inputs::Joystick::Input::Fire, 2), is_pressed);	break;
-						case SDL_SCANCODE_F:		joysticks[0]->set_input(Inputs::Joystick::Input(Inputs::Joystick::Input::Fire, 3), is_pressed);	break;
-						default: {
-							if(keypress.input.size()) {
-								joysticks[0]->set_input(Inputs::Joystick::Input(keypress.input[0]), is_pressed);
-							}
-						} break;
+			Inputs::Keyboard::Key key = Inputs::Keyboard::Key::Space;
+			if(keyboard_machine && KeyboardKeyForSDLScancode(keypress.scancode, key)) {
+				// In principle there's no need for a conditional here; in practice logical_keyboard mode
+				// is sufficiently untested on SDL, and somewhat too reliant on empirical timestamp behaviour,
+				// for it to be trustworthy enough otherwise to expose.
+				auto key_event = [&] {
+					if(logical_keyboard) {
+						return Inputs::InputEvent::key_event(key, keypress.input.size() ? keypress.input[0] : 0, is_pressed, true);
 					}
+
+					// This is a slightly terrible way of obtaining a symbol for the key, e.g. for letters it will always return
+					// the capital letter version, at least empirically. But it'll have to do for now.
+					const char *key_name = SDL_GetKeyName(keypress.keycode);
+					return Inputs::InputEvent::key_event(key, (strlen(key_name) == 1) ? key_name[0] : 0, is_pressed);
+				}();
+				if(joystick_input) {
+					key_event.with_fallback(0, *joystick_input);
 				}
+				machine_runner.post_input(key_event);
+			} else if(joystick_input) {
+				machine_runner.post_input(Inputs::InputEvent::joystick_event(0, *joystick_input, is_pressed));
 			}
 		}
 		keypresses.clear();
 
-		// Push new joystick state, if any.
-		if(joystick_machine) {
-			auto &machine_joysticks = joystick_machine->get_joysticks();
+		// Push new joystick state, if any; each controller c is directed at machine joystick c modulo however many it has.
+		if(machine->joystick_machine()) {
 			for(size_t c = 0; c < joysticks.size(); ++c) {
-				size_t target = c % machine_joysticks.size();
-
 				// Post the first two analogue axes presented by the controller as horizontal and vertical inputs,
 				// unless the user seems to be using a hat.
 				// SDL will return a value in the range [-32768, 32767], so map from that to [0, 1.0]
 				if(!joysticks[c].hat_values()) {
 					const float x_axis = float(SDL_JoystickGetAxis(joysticks[c].get(), 0) + 32768) / 65535.0f;
 					const float y_axis = float(SDL_JoystickGetAxis(joysticks[c].get(), 1) + 32768) / 65535.0f;
-					machine_joysticks[target]->set_input(Inputs::Joystick::Input(Inputs::Joystick::Input::Type::Horizontal), x_axis);
-					machine_joysticks[target]->set_input(Inputs::Joystick::Input(Inputs::Joystick::Input::Type::Vertical), y_axis);
+					machine_runner.post_input(Inputs::InputEvent::joystick_event(c, Inputs::Joystick::Input(Inputs::Joystick::Input::Type::Horizontal), x_axis));
+					machine_runner.post_input(Inputs::InputEvent::joystick_event(c, Inputs::Joystick::Input(Inputs::Joystick::Input::Type::Vertical), y_axis));
 				}
 
 				// Forward hats as directions; hats always override analogue inputs.
@@ -1275,25 +1834,26 @@ int main(int argc, char *argv[]) {
 					joysticks[c].last_hat_value(hat) = hat_value;
 
 					if(changes & SDL_HAT_UP) {
-						machine_joysticks[target]->set_input(Inputs::Joystick::Input(Inputs::Joystick::Input::Type::Up), !!(hat_value & SDL_HAT_UP));
+						machine_runner.post_input(Inputs::InputEvent::joystick_event(c, Inputs::Joystick::Input(Inputs::Joystick::Input::Type::Up), !!(hat_value & SDL_HAT_UP)));
 					}
 					if(changes & SDL_HAT_DOWN) {
-						machine_joysticks[target]->set_input(Inputs::Joystick::Input(Inputs::Joystick::Input::Type::Down), !!(hat_value & SDL_HAT_DOWN));
+						machine_runner.post_input(Inputs::InputEvent::joystick_event(c, Inputs::Joystick::Input(Inputs::Joystick::Input::Type::Down), !!(hat_value & SDL_HAT_DOWN)));
 					}
 					if(changes & SDL_HAT_LEFT) {
-						machine_joysticks[target]->set_input(Inputs::Joystick::Input(Inputs::Joystick::Input::Type::Left), !!(hat_value & SDL_HAT_LEFT));
+						machine_runner.post_input(Inputs::InputEvent::joystick_event(c, Inputs::Joystick::Input(Inputs::Joystick::Input::Type::Left), !!(hat_value & SDL_HAT_LEFT)));
 					}
 					if(changes & SDL_HAT_RIGHT) {
-						machine_joysticks[target]->set_input(Inputs::Joystick::Input(Inputs::Joystick::Input::Type::Right), !!(hat_value & SDL_HAT_RIGHT));
+						machine_runner.post_input(Inputs::InputEvent::joystick_event(c, Inputs::Joystick::Input(Inputs::Joystick::Input::Type::Right), !!(hat_value & SDL_HAT_RIGHT)));
 					}
 				}
 
 				// Forward all fire buttons, retaining their original indices.
 				const int number_of_buttons = SDL_JoystickNumButtons(joysticks[c].get());
 				for(int button = 0; button < number_of_buttons; ++button) {
-					machine_joysticks[target]->set_input(
-						Inputs::Joystick::Input(Inputs::Joystick::Input::Type::Fire, button),
-						SDL_JoystickGetButton(joysticks[c].get(), button) ? true : false);
+					machine_runner.post_input(Inputs::InputEvent::joystick_event(
+						c,
+						Inputs::Joystick::Input(Inputs::Joystick::Input::Type::Fire, size_t(button)),
+						SDL_JoystickGetButton(joysticks[c].get(), button) ? true : false));
 				}
 			}
 		}
@@ -1301,6 +1861,23 @@ int main(int argc, char *argv[]) {
 
 	// Clean up.
 	machine_runner.stop();	// Ensure no further updates will occur.
+
+	if(machine_runner.input_recorder && !machine_runner.input_recorder->movie().write(record_input_argument->second)) {
+		std::cerr << "Unable to save input movie to " << record_input_argument->second << std::endl;
+	}
+
+	if(arguments.selections.find("memory-report") != arguments.selections.end()) {
+		using Kind = MachineTypes::MemoryFootprint::Kind;
+		MachineTypes::MemoryFootprint footprint;
+		const auto memory_reporter = machine_runner.machine->memory_reporter();
+		if(memory_reporter) memory_reporter->report_memory(footprint);
+		footprint.add("Scan target", Kind::VideoBuffers, scan_target.get_memory_footprint());
+		if(machine_runner.rewind) footprint.add("Rewind history", Kind::Other, machine_runner.rewind->get_memory_footprint());
+		std::cout << footprint.summary();
+	}
+
+	machine_runner.run_ahead.reset();
+	machine_runner.rewind.reset();
 	joysticks.clear();
 	SDL_DestroyWindow( window );
 	SDL_Quit();
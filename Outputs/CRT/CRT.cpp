@@ -8,10 +8,14 @@
 
 #include "CRT.hpp"
 
+#include "../../Concurrency/AsyncTaskQueue.hpp"
+#include "../HostProfiler.hpp"
+
 #include <cstdarg>
 #include <cmath>
 #include <algorithm>
 #include <cassert>
+#include <cstring>
 
 using namespace Outputs::CRT;
 
@@ -27,6 +31,7 @@ void CRT::set_new_timing(int cycles_per_line, int height_of_display, Outputs::Di
 															//	7 microseconds for horizontal retrace and 500 to 750 microseconds for vertical retrace
 															//  in NTSC and PAL TV."
 
+	synchronise();
 	time_multiplier_ = 63487 / cycles_per_line;	// 63475 = 65535 * 31/32, i.e. the same 1/32 error as below is permitted.
 	phase_denominator_ = int64_t(cycles_per_line) * int64_t(colour_cycle_denominator) * int64_t(time_multiplier_);
 	phase_numerator_ = 0;
@@ -68,27 +73,50 @@ void CRT::set_new_timing(int cycles_per_line, int height_of_display, Outputs::Di
 }
 
 void CRT::set_scan_target(Outputs::Display::ScanTarget *scan_target) {
+	synchronise();
+	flush_pending_level();
 	scan_target_ = scan_target;
 	if(!scan_target_) scan_target_ = &Outputs::Display::NullScanTarget::singleton;
 	scan_target_->set_modals(scan_target_modals_);
+	if(!palette_.empty()) {
+		scan_target_->set_palette(palette_.data(), palette_.size() / 4);
+	}
+	is_skipping_frame_ = false;
+	frames_until_output_ = 0;
+
+	if(!scan_target_->allows_asynchronous_producers()) {
+		queue_.reset();
+	} else if(!queue_) {
+		queue_ = std::make_unique<Concurrency::AsyncTaskQueue>();
+	}
+}
+
+void CRT::set_delegate(Delegate *delegate) {
+	synchronise();
+	delegate_ = delegate;
 }
 
 void CRT::set_new_data_type(Outputs::Display::InputDataType data_type) {
+	synchronise();
+	flush_pending_level();
 	scan_target_modals_.input_data_type = data_type;
 	scan_target_->set_modals(scan_target_modals_);
 }
 
 void CRT::set_aspect_ratio(float aspect_ratio) {
+	synchronise();
 	scan_target_modals_.aspect_ratio = aspect_ratio;
 	scan_target_->set_modals(scan_target_modals_);
 }
 
 void CRT::set_visible_area(Outputs::Display::Rect visible_area) {
+	synchronise();
 	scan_target_modals_.visible_area = visible_area;
 	scan_target_->set_modals(scan_target_modals_);
 }
 
 void CRT::set_display_type(Outputs::Display::DisplayType display_type) {
+	synchronise();
 	scan_target_modals_.display_type = display_type;
 	scan_target_->set_modals(scan_target_modals_);
 }
@@ -98,16 +126,20 @@ Outputs::Display::DisplayType CRT::get_display_type() const {
 }
 
 void CRT::set_phase_linked_luminance_offset(float offset) {
+	synchronise();
 	scan_target_modals_.input_data_tweaks.phase_linked_luminance_offset = offset;
 	scan_target_->set_modals(scan_target_modals_);
 }
 
 void CRT::set_input_data_type(Outputs::Display::InputDataType input_data_type) {
+	synchronise();
+	flush_pending_level();
 	scan_target_modals_.input_data_type = input_data_type;
 	scan_target_->set_modals(scan_target_modals_);
 }
 
 void CRT::set_brightness(float brightness) {
+	synchronise();
 	scan_target_modals_.brightness = brightness;
 	scan_target_->set_modals(scan_target_modals_);
 }
@@ -129,6 +161,7 @@ void CRT::set_new_display_type(int cycles_per_line, Outputs::Display::Type displ
 }
 
 void CRT::set_composite_function_type(CompositeSourceType type, float offset_of_first_sample) {
+	synchronise();
 	if(type == DiscreteFourSamplesPerCycle) {
 		colour_burst_phase_adjustment_ = uint8_t(offset_of_first_sample * 256.0f) & 63;
 	} else {
@@ -137,6 +170,7 @@ void CRT::set_composite_function_type(CompositeSourceType type, float offset_of_
 }
 
 void CRT::set_input_gamma(float gamma) {
+	synchronise();
 	scan_target_modals_.intended_gamma = gamma;
 	scan_target_->set_modals(scan_target_modals_);
 }
@@ -176,6 +210,8 @@ CRT::CRT(int cycles_per_line,
 	set_new_timing(cycles_per_line, height_of_display, Outputs::Display::ColourSpace::YIQ, 1, 1, vertical_sync_half_lines, false);
 }
 
+CRT::~CRT() {}
+
 
 // MARK: - Sync loop
 
@@ -209,6 +245,36 @@ void CRT::advance_cycles(int number_of_cycles, bool hsync_requested, bool vsync_
 	number_of_cycles *= time_multiplier_;
 
 	const bool is_output_run = ((type == Scan::Type::Level) || (type == Scan::Type::Data));
+
+	// Most runs requested no sync and end before either flywheel's next event, so are a single
+	// segment; deal with those directly.
+	if(
+		number_of_cycles && !hsync_requested && !vsync_requested &&
+		number_of_cycles < horizontal_flywheel_->get_time_until_next_event() &&
+		number_of_cycles < vertical_flywheel_->get_time_until_next_event()
+	) {
+		const bool is_output_segment = is_output_run && !is_skipping_frame_ && !horizontal_flywheel_->is_in_retrace() && !vertical_flywheel_->is_in_retrace();
+		Outputs::Display::ScanTarget::Scan *const next_scan = is_output_segment ? scan_target_->begin_scan() : nullptr;
+		if(next_scan) {
+			next_scan->end_points[0] = end_point(0);
+			next_scan->composite_amplitude = colour_burst_amplitude_;
+		}
+
+		phase_numerator_ += number_of_cycles * colour_cycle_numerator_;
+		cycles_since_horizontal_sync_ += number_of_cycles;
+		horizontal_flywheel_->advance(number_of_cycles);
+		vertical_flywheel_->advance(number_of_cycles);
+
+		if(next_scan) {
+			next_scan->end_points[1] = end_point(uint16_t(number_of_samples));
+			scan_target_->end_scan();
+		}
+		if(is_output_segment) {
+			scan_target_->submit();
+		}
+		return;
+	}
+
 	const auto total_cycles = number_of_cycles;
 	bool did_output = false;
 
@@ -226,7 +292,7 @@ void CRT::advance_cycles(int number_of_cycles, bool hsync_requested, bool vsync_
 		vsync_requested = false;
 
 		// Determine whether to output any data for this portion of the output; if so then grab somewhere to put it.
-		const bool is_output_segment = ((is_output_run && next_run_length) && !horizontal_flywheel_->is_in_retrace() && !vertical_flywheel_->is_in_retrace());
+		const bool is_output_segment = ((is_output_run && next_run_length) && !is_skipping_frame_ && !horizontal_flywheel_->is_in_retrace() && !vertical_flywheel_->is_in_retrace());
 		Outputs::Display::ScanTarget::Scan *const next_scan = is_output_segment ? scan_target_->begin_scan() : nullptr;
 		did_output |= is_output_segment;
 
@@ -264,14 +330,16 @@ void CRT::advance_cycles(int number_of_cycles, bool hsync_requested, bool vsync_
 			}
 
 			// Announce event.
-			const auto event =
-				(next_horizontal_sync_event == Flywheel::SyncEvent::StartRetrace)
-					? Outputs::Display::ScanTarget::Event::BeginHorizontalRetrace : Outputs::Display::ScanTarget::Event::EndHorizontalRetrace;
-			scan_target_->announce(
-				event,
-				!(horizontal_flywheel_->is_in_retrace() || vertical_flywheel_->is_in_retrace()),
-				end_point(uint16_t((total_cycles - number_of_cycles) * number_of_samples / total_cycles)),
-				colour_burst_amplitude_);
+			if(!is_skipping_frame_) {
+				const auto event =
+					(next_horizontal_sync_event == Flywheel::SyncEvent::StartRetrace)
+						? Outputs::Display::ScanTarget::Event::BeginHorizontalRetrace : Outputs::Display::ScanTarget::Event::EndHorizontalRetrace;
+				scan_target_->announce(
+					event,
+					!(horizontal_flywheel_->is_in_retrace() || vertical_flywheel_->is_in_retrace()),
+					end_point(uint16_t((total_cycles - number_of_cycles) * number_of_samples / total_cycles)),
+					colour_burst_amplitude_);
+			}
 
 			// If retrace is starting, update phase if required and mark no colour burst spotted yet.
 			if(next_horizontal_sync_event == Flywheel::SyncEvent::StartRetrace) {
@@ -280,16 +348,23 @@ void CRT::advance_cycles(int number_of_cycles, bool hsync_requested, bool vsync_
 			}
 		}
 
-		// Also announce vertical retrace events.
+		// Also announce vertical retrace events. The end of retrace begins a frame, which may be skipped;
+		// if so then the scan target sees the beginning of this retrace and the end of a later one.
 		if(next_run_length == time_until_vertical_sync_event && next_vertical_sync_event != Flywheel::SyncEvent::None) {
-			const auto event =
-				(next_vertical_sync_event == Flywheel::SyncEvent::StartRetrace)
-					? Outputs::Display::ScanTarget::Event::BeginVerticalRetrace : Outputs::Display::ScanTarget::Event::EndVerticalRetrace;
-			scan_target_->announce(
-				event,
-				!(horizontal_flywheel_->is_in_retrace() || vertical_flywheel_->is_in_retrace()),
-				end_point(uint16_t((total_cycles - number_of_cycles) * number_of_samples / total_cycles)),
-				colour_burst_amplitude_);
+			if(next_vertical_sync_event == Flywheel::SyncEvent::EndRetrace) {
+				begin_frame();
+			}
+
+			if(!is_skipping_frame_) {
+				const auto event =
+					(next_vertical_sync_event == Flywheel::SyncEvent::StartRetrace)
+						? Outputs::Display::ScanTarget::Event::BeginVerticalRetrace : Outputs::Display::ScanTarget::Event::EndVerticalRetrace;
+				scan_target_->announce(
+					event,
+					!(horizontal_flywheel_->is_in_retrace() || vertical_flywheel_->is_in_retrace()),
+					end_point(uint16_t((total_cycles - number_of_cycles) * number_of_samples / total_cycles)),
+					colour_burst_amplitude_);
+			}
 		}
 
 		// if this is vertical retrace then advance a field
@@ -297,7 +372,14 @@ void CRT::advance_cycles(int number_of_cycles, bool hsync_requested, bool vsync_
 			if(delegate_) {
 				frames_since_last_delegate_call_++;
 				if(frames_since_last_delegate_call_ == 20) {
-					delegate_->crt_did_end_batch_of_frames(this, frames_since_last_delegate_call_, vertical_flywheel_->get_and_reset_number_of_surprises());
+					const int surprises = vertical_flywheel_->get_and_reset_number_of_surprises();
+					if(queue_) {
+						// Leave the producer to inform the delegate, as the delegate may well reconfigure this CRT.
+						deferred_surprises_ += surprises;
+						deferred_frames_ += frames_since_last_delegate_call_;
+					} else {
+						delegate_->crt_did_end_batch_of_frames(this, frames_since_last_delegate_call_, surprises);
+					}
 					frames_since_last_delegate_call_ = 0;
 				}
 			}
@@ -385,21 +467,33 @@ void CRT::output_scan(const Scan *const scan) {
 /*
 	These all merely channel into advance_cycles, supplying appropriate arguments
 */
-void CRT::output_sync(int number_of_cycles) {
+void CRT::apply_sync(int number_of_cycles) {
+	flush_pending_level();
 	Scan scan;
 	scan.type = Scan::Type::Sync;
 	scan.number_of_cycles = number_of_cycles;
 	output_scan(&scan);
 }
 
-void CRT::output_blank(int number_of_cycles) {
+void CRT::apply_blank(int number_of_cycles) {
+	flush_pending_level();
 	Scan scan;
 	scan.type = Scan::Type::Blank;
 	scan.number_of_cycles = number_of_cycles;
 	output_scan(&scan);
 }
 
-void CRT::output_level(int number_of_cycles) {
+void CRT::apply_level(int number_of_cycles) {
+	if(data_is_withheld_) {
+		apply_blank(number_of_cycles);
+		return;
+	}
+	if(data_is_staged_) {
+		output_staged_level(number_of_cycles);
+		return;
+	}
+
+	flush_pending_level();
 	scan_target_->end_data(1);
 	Scan scan;
 	scan.type = Scan::Type::Level;
@@ -408,7 +502,8 @@ void CRT::output_level(int number_of_cycles) {
 	output_scan(&scan);
 }
 
-void CRT::output_colour_burst(int number_of_cycles, uint8_t phase, bool is_alternate_line, uint8_t amplitude) {
+void CRT::apply_colour_burst(int number_of_cycles, uint8_t phase, bool is_alternate_line, uint8_t amplitude) {
+	flush_pending_level();
 	Scan scan;
 	scan.type = Scan::Type::ColourBurst;
 	scan.number_of_cycles = number_of_cycles;
@@ -418,22 +513,41 @@ void CRT::output_colour_burst(int number_of_cycles, uint8_t phase, bool is_alter
 	output_scan(&scan);
 }
 
-void CRT::output_default_colour_burst(int number_of_cycles, uint8_t amplitude) {
+void CRT::apply_default_colour_burst(int number_of_cycles, uint8_t amplitude) {
+	// Bring the phase up to date before sampling it.
+	flush_pending_level();
+
 	// TODO: avoid applying a rounding error here?
-	output_colour_burst(number_of_cycles, uint8_t((phase_numerator_ * 256) / phase_denominator_), should_be_alternate_line_, amplitude);
+	apply_colour_burst(number_of_cycles, uint8_t((phase_numerator_ * 256) / phase_denominator_), should_be_alternate_line_, amplitude);
 }
 
-void CRT::set_immediate_default_phase(float phase) {
+void CRT::apply_default_phase(float phase) {
+	flush_pending_level();
 	phase = fmodf(phase, 1.0f);
 	phase_numerator_ = int(phase * float(phase_denominator_));
 }
 
-void CRT::output_data(int number_of_cycles, size_t number_of_samples) {
+void CRT::apply_palette(const uint8_t *colours, size_t count) {
+	// Any held level precedes the change.
+	flush_pending_level();
+	scan_target_->set_palette(colours, count);
+}
+
+void CRT::apply_data(int number_of_cycles, size_t number_of_samples) {
 #ifndef NDEBUG
 	assert(number_of_samples > 0);
 	assert(number_of_samples <= allocated_data_length_);
 	allocated_data_length_ = std::numeric_limits<size_t>::min();
 #endif
+	if(data_is_withheld_) {
+		apply_blank(number_of_cycles);
+		return;
+	}
+	if(data_is_staged_) {
+		output_staged_data(number_of_cycles, number_of_samples);
+		return;
+	}
+
 	scan_target_->end_data(number_of_samples);
 	Scan scan;
 	scan.type = Scan::Type::Data;
@@ -442,6 +556,286 @@ void CRT::output_data(int number_of_cycles, size_t number_of_samples) {
 	output_scan(&scan);
 }
 
+// MARK: - Output.
+
+void CRT::output_sync(int number_of_cycles) {
+	if(queue_) {
+		append(Command(Command::Type::Sync, number_of_cycles));
+		return;
+	}
+	apply_sync(number_of_cycles);
+}
+
+void CRT::output_blank(int number_of_cycles) {
+	if(queue_) {
+		append(Command(Command::Type::Blank, number_of_cycles));
+		return;
+	}
+	apply_blank(number_of_cycles);
+}
+
+void CRT::output_level(int number_of_cycles) {
+	if(queue_) {
+		data_is_open_ = false;
+		append(Command(Command::Type::Level, number_of_cycles));
+		return;
+	}
+	apply_level(number_of_cycles);
+}
+
+void CRT::output_data(int number_of_cycles, size_t number_of_samples) {
+	if(queue_) {
+		data_is_open_ = false;
+		Command command(Command::Type::Data, number_of_cycles);
+		command.data_length = uint32_t(number_of_samples);
+		append(command);
+		return;
+	}
+	apply_data(number_of_cycles, number_of_samples);
+}
+
+void CRT::output_colour_burst(int number_of_cycles, uint8_t phase, bool is_alternate_line, uint8_t amplitude) {
+	if(queue_) {
+		Command command(Command::Type::ColourBurst, number_of_cycles);
+		command.phase = phase;
+		command.is_alternate_line = is_alternate_line;
+		command.amplitude = amplitude;
+		append(command);
+		return;
+	}
+	apply_colour_burst(number_of_cycles, phase, is_alternate_line, amplitude);
+}
+
+void CRT::output_default_colour_burst(int number_of_cycles, uint8_t amplitude) {
+	if(queue_) {
+		Command command(Command::Type::DefaultColourBurst, number_of_cycles);
+		command.amplitude = amplitude;
+		append(command);
+		return;
+	}
+	apply_default_colour_burst(number_of_cycles, amplitude);
+}
+
+void CRT::set_immediate_default_phase(float phase) {
+	if(queue_) {
+		Command command(Command::Type::DefaultPhase, 0);
+		command.default_phase = phase;
+		append(command);
+		return;
+	}
+	apply_default_phase(phase);
+}
+
+void CRT::set_palette(const uint8_t *colours, size_t count) {
+	palette_.assign(colours, colours + count * 4);
+	if(queue_) {
+		auto &batch = batches_[batch_index_];
+		Command command(Command::Type::Palette, 0);
+		command.data_offset = uint32_t(batch.palettes.size());
+		command.data_length = uint32_t(count);
+		batch.palettes.insert(batch.palettes.end(), colours, colours + count * 4);
+		append(command);
+		return;
+	}
+	apply_palette(colours, count);
+}
+
+// MARK: - Asynchronous signal processing.
+
+uint8_t *CRT::defer_begin_data(std::size_t required_length, std::size_t required_alignment) {
+	// Any previous area is now superseded, so this is an opportunity to submit.
+	data_is_open_ = false;
+	submit_if_full();
+
+	// Allocate suitably-aligned space at the end of the current batch's data.
+	auto &batch = batches_[batch_index_];
+	const size_t sample_size = Outputs::Display::size_for_data_type(scan_target_modals_.input_data_type);
+	const size_t alignment = required_alignment * sample_size;
+	const size_t offset = (batch.data.size() + alignment - 1) / alignment * alignment;
+	batch.data.resize(offset + required_length * sample_size);
+
+	Command command(Command::Type::BeginData, 0);
+	command.data_offset = uint32_t(offset);
+	command.data_length = uint32_t(required_length);
+	command.data_alignment = uint32_t(required_alignment);
+	batch.commands.push_back(command);
+
+	data_is_open_ = true;
+	return &batch.data[offset];
+}
+
+void CRT::append(const Command &command) {
+	auto &batch = batches_[batch_index_];
+	batch.commands.push_back(command);
+	batch.number_of_cycles += command.number_of_cycles;
+	submit_if_full();
+}
+
+void CRT::submit_if_full() {
+	const auto &batch = batches_[batch_index_];
+	if(
+		!data_is_open_ && (
+			batch.number_of_cycles >= cycles_per_line_ * LinesPerBatch ||
+			batch.commands.size() >= CommandsPerBatch ||
+			batch.data.size() >= DataPerBatch
+		)
+	) {
+		submit();
+	}
+}
+
+void CRT::submit() {
+	auto &batch = batches_[batch_index_];
+	if(!batch.commands.empty()) {
+		batch.is_pending.store(true, std::memory_order_relaxed);
+		queue_->enqueue([this, &batch] {
+			perform(batch);
+			batch.commands.clear();
+			batch.data.clear();
+			batch.palettes.clear();
+			batch.number_of_cycles = 0;
+			batch.is_pending.store(false, std::memory_order_release);
+		});
+
+		// Move on to the next batch, waiting for it to become available if necessary.
+		batch_index_ = (batch_index_ + 1) % BatchCount;
+		if(batches_[batch_index_].is_pending.load(std::memory_order_acquire)) {
+			queue_->flush();
+		}
+	}
+
+	report_deferred_frames();
+}
+
+void CRT::synchronise() {
+	if(!queue_) return;
+
+	data_is_open_ = false;
+	submit();
+	queue_->flush();
+	report_deferred_frames();
+}
+
+void CRT::report_deferred_frames() {
+	const int frames = deferred_frames_.exchange(0, std::memory_order_relaxed);
+	if(!frames) return;
+
+	const int surprises = deferred_surprises_.exchange(0, std::memory_order_relaxed);
+	if(delegate_) {
+		delegate_->crt_did_end_batch_of_frames(this, frames, surprises);
+	}
+}
+
+void CRT::perform(Batch &batch) {
+	HOST_PROFILER_ZONE("CRT batch");
+	const size_t sample_size = Outputs::Display::size_for_data_type(scan_target_modals_.input_data_type);
+
+	for(const auto &command: batch.commands) {
+		switch(command.type) {
+			case Command::Type::Sync:		apply_sync(command.number_of_cycles);	break;
+			case Command::Type::Blank:		apply_blank(command.number_of_cycles);	break;
+			case Command::Type::Level:		apply_level(command.number_of_cycles);	break;
+			case Command::Type::Data:		apply_data(command.number_of_cycles, command.data_length);	break;
+
+			case Command::Type::BeginData: {
+				uint8_t *const target = apply_begin_data(command.data_length, command.data_alignment);
+				if(target) {
+					memcpy(target, &batch.data[command.data_offset], command.data_length * sample_size);
+				}
+			} break;
+
+			case Command::Type::ColourBurst:
+				apply_colour_burst(command.number_of_cycles, command.phase, command.is_alternate_line, command.amplitude);
+			break;
+			case Command::Type::DefaultColourBurst:
+				apply_default_colour_burst(command.number_of_cycles, command.amplitude);
+			break;
+			case Command::Type::DefaultPhase:
+				apply_default_phase(command.default_phase);
+			break;
+			case Command::Type::Palette:
+				apply_palette(&batch.palettes[command.data_offset], command.data_length);
+			break;
+		}
+	}
+}
+
+// MARK: - Frame skipping.
+
+void CRT::begin_frame() {
+	const int frames_per_output = scan_target_->frames_per_output();
+	if(frames_per_output <= 1) {
+		is_skipping_frame_ = false;
+		frames_until_output_ = 0;
+		return;
+	}
+
+	// Output the first of every frames_per_output frames, allowing for that number having
+	// reduced since the countdown began.
+	frames_until_output_ = std::min(frames_until_output_, frames_per_output - 1);
+	is_skipping_frame_ = frames_until_output_ > 0;
+	frames_until_output_ = is_skipping_frame_ ? frames_until_output_ - 1 : frames_per_output - 1;
+}
+
+// MARK: - Staged data.
+
+void CRT::output_staged_level(int number_of_cycles) {
+	data_is_staged_ = false;
+
+	// Continue the pending level if this is the same colour; otherwise output it and begin anew.
+	const size_t sample_size = Outputs::Display::size_for_data_type(scan_target_modals_.input_data_type);
+	if(pending_level_cycles_ && !memcmp(pending_level_, staging_area_, sample_size)) {
+		pending_level_cycles_ += number_of_cycles;
+		return;
+	}
+
+	flush_pending_level();
+	memcpy(pending_level_, staging_area_, sample_size);
+	pending_level_cycles_ = number_of_cycles;
+}
+
+void CRT::output_staged_data(int number_of_cycles, size_t number_of_samples) {
+	// A single sample is just a level by another name.
+	if(number_of_samples == 1) {
+		output_staged_level(number_of_cycles);
+		return;
+	}
+	data_is_staged_ = false;
+
+	// Otherwise move the samples to the scan target and output as usual.
+	flush_pending_level();
+	const size_t sample_size = Outputs::Display::size_for_data_type(scan_target_modals_.input_data_type);
+	uint8_t *const target = scan_target_->begin_data(number_of_samples, staging_alignment_);
+	if(target) {
+		memcpy(target, staging_area_, number_of_samples * sample_size);
+	}
+	scan_target_->end_data(number_of_samples);
+
+	Scan scan;
+	scan.type = Scan::Type::Data;
+	scan.number_of_cycles = number_of_cycles;
+	scan.number_of_samples = int(number_of_samples);
+	output_scan(&scan);
+}
+
+void CRT::flush_pending_level() {
+	if(!pending_level_cycles_) return;
+
+	const size_t sample_size = Outputs::Display::size_for_data_type(scan_target_modals_.input_data_type);
+	uint8_t *const target = scan_target_->begin_data(1);
+	if(target) {
+		memcpy(target, pending_level_, sample_size);
+	}
+	scan_target_->end_data(1);
+
+	Scan scan;
+	scan.type = Scan::Type::Level;
+	scan.number_of_cycles = pending_level_cycles_;
+	scan.number_of_samples = 1;
+	pending_level_cycles_ = 0;
+	output_scan(&scan);
+}
+
 // MARK: - Getters.
 
 Outputs::Display::Rect CRT::get_rect_for_area(int first_line_after_sync, int number_of_lines, int first_cycle_after_sync, int number_of_cycles, float aspect_ratio) const {
@@ -493,6 +887,9 @@ Outputs::Display::Rect CRT::get_rect_for_area(int first_line_after_sync, int num
 }
 
 Outputs::Display::ScanStatus CRT::get_scaled_scan_status() const {
+	// The pending batch is left alone, keeping this safe to call other than from the producer.
+	if(queue_) queue_->flush();
+
 	Outputs::Display::ScanStatus status;
 	status.field_duration = float(vertical_flywheel_->get_locked_period()) / float(time_multiplier_);
 	status.field_duration_gradient = float(vertical_flywheel_->get_last_period_adjustment()) / float(time_multiplier_);
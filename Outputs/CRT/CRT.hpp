@@ -10,13 +10,19 @@
 #define CRT_hpp
 
 #include <array>
+#include <atomic>
 #include <cstdint>
 #include <limits>
 #include <memory>
+#include <vector>
 
 #include "../ScanTarget.hpp"
 #include "Internals/Flywheel.hpp"
 
+namespace Concurrency {
+class AsyncTaskQueue;
+}
+
 namespace Outputs {
 namespace CRT {
 
@@ -31,6 +37,11 @@ class Delegate {
 	and generating the proper set of output spans. Attempts to act and react exactly as a real
 	TV would have to things like irregular or off-spec sync, and includes logic properly to track
 	colour phase for colour composite video.
+
+	If its scan target allows asynchronous producers then the CRT does its signal processing on a
+	queue of its own: the output_ methods and @c begin_data merely record what was requested, and
+	the flywheels and scan target are driven from that queue. All other methods synchronise with
+	the queue before acting, and the delegate is still called only from within the output_ methods.
 */
 class CRT {
 	private:
@@ -55,6 +66,71 @@ class CRT {
 		};
 		void output_scan(const Scan *scan);
 
+		// Short runs of data are staged here rather than being allocated from the scan target,
+		// allowing consecutive levels of the same colour to be merged into a single scan before
+		// they reach it. Samples are at most four bytes, so this is large enough for any data type.
+		static constexpr size_t StagingSamples = 4;
+		alignas(16) uint8_t staging_area_[StagingSamples * 4]{};
+		size_t staging_alignment_ = 1;
+		bool data_is_staged_ = false;
+
+		// A level that has been received but not yet output, in case it's continued.
+		uint8_t pending_level_[4]{};
+		int pending_level_cycles_ = 0;
+
+		void output_staged_level(int number_of_cycles);
+		void output_staged_data(int number_of_cycles, size_t number_of_samples);
+		void flush_pending_level();
+
+		// Frame skipping, as requested by the scan target via frames_per_output: while a frame is skipped
+		// nothing is passed to the scan target and data allocations are declined, in which case any
+		// subsequent output of that data is treated as blank.
+		int frames_until_output_ = 0;
+		bool is_skipping_frame_ = false;
+		bool data_is_withheld_ = false;
+		void begin_frame();
+
+		// The implementations of the output_ methods and begin_data, which act immediately.
+		void apply_sync(int number_of_cycles);
+		void apply_blank(int number_of_cycles);
+		void apply_level(int number_of_cycles);
+		void apply_data(int number_of_cycles, size_t number_of_samples);
+		void apply_colour_burst(int number_of_cycles, uint8_t phase, bool is_alternate_line, uint8_t amplitude);
+		void apply_default_colour_burst(int number_of_cycles, uint8_t amplitude);
+		void apply_default_phase(float phase);
+		void apply_palette(const uint8_t *colours, size_t count);
+		inline uint8_t *apply_begin_data(std::size_t required_length, std::size_t required_alignment) {
+			data_is_withheld_ = is_skipping_frame_;
+			if(data_is_withheld_) {
+#ifndef NDEBUG
+				allocated_data_length_ = std::numeric_limits<size_t>::max();
+#endif
+				data_is_staged_ = false;
+				return nullptr;
+			}
+
+			if(required_length <= StagingSamples && required_alignment <= StagingSamples) {
+#ifndef NDEBUG
+				allocated_data_length_ = required_length;
+#endif
+				data_is_staged_ = true;
+				staging_alignment_ = required_alignment;
+				return staging_area_;
+			}
+
+			flush_pending_level();
+			data_is_staged_ = false;
+			const auto result = scan_target_->begin_data(required_length, required_alignment);
+#ifndef NDEBUG
+			// If data was allocated, make a record of how much so as to be able to hold the caller to that
+			// contract later. If allocation failed, don't constrain the caller. This allows callers that
+			// allocate on demand but may allow one failure to hold for a longer period — e.g. until the
+			// next line.
+			allocated_data_length_ = result ? required_length : std::numeric_limits<size_t>::max();
+#endif
+			return result;
+		}
+
 		uint8_t colour_burst_amplitude_ = 30;
 		int colour_burst_phase_adjustment_ = 0xff;
 
@@ -81,12 +157,65 @@ class CRT {
 
 		Outputs::Display::ScanTarget *scan_target_ = &Outputs::Display::NullScanTarget::singleton;
 		Outputs::Display::ScanTarget::Modals scan_target_modals_;
+		std::vector<uint8_t> palette_;	// The most recent palette, for supply to any new scan target.
 		static constexpr uint8_t DefaultAmplitude = 41;	// Based upon a black level to maximum excursion and positive burst peak of: NTSC: 882 & 143; PAL: 933 & 150.
 
 #ifndef NDEBUG
 		size_t allocated_data_length_ = std::numeric_limits<size_t>::min();
 #endif
 
+		// MARK: - Asynchronous signal processing.
+
+		// When processing asynchronously, each call to an output_ method or to begin_data becomes a Command,
+		// appended to the current Batch along with a copy of any data. Batches are submitted to queue_ once
+		// they cover a few lines, and there replayed against the apply_ methods above.
+		struct Command {
+			enum class Type: uint8_t {
+				Sync, Blank, Level, Data, BeginData, ColourBurst, DefaultColourBurst, DefaultPhase, Palette
+			} type;
+			uint8_t phase = 0, amplitude = 0;
+			bool is_alternate_line = false;
+			int number_of_cycles = 0;
+			uint32_t data_offset = 0, data_length = 0, data_alignment = 0;
+			float default_phase = 0.0f;
+
+			Command(Type type, int number_of_cycles) : type(type), number_of_cycles(number_of_cycles) {}
+		};
+		struct Batch {
+			std::vector<Command> commands;
+			std::vector<uint8_t> data;
+			std::vector<uint8_t> palettes;	// Kept apart from data so that areas vended from it are never moved.
+			int number_of_cycles = 0;
+			std::atomic<bool> is_pending = false;
+		};
+
+		// Batches are recycled so that, once warmed up, recording doesn't allocate.
+		static constexpr size_t BatchCount = 4;
+		static constexpr int LinesPerBatch = 8;
+		static constexpr size_t CommandsPerBatch = 1024;
+		static constexpr size_t DataPerBatch = 256 * 1024;
+		std::array<Batch, BatchCount> batches_;
+		size_t batch_index_ = 0;
+
+		// Indicates that an area returned by begin_data may still be being written to, in which case the
+		// current batch can't yet be submitted.
+		bool data_is_open_ = false;
+
+		// Completed frames are counted on the queue and reported to the delegate by the producer.
+		std::atomic<int> deferred_frames_ = 0, deferred_surprises_ = 0;
+
+		void append(const Command &command);
+		void submit_if_full();
+		void submit();
+		void synchronise();
+		void perform(Batch &batch);
+		void report_deferred_frames();
+		uint8_t *defer_begin_data(std::size_t required_length, std::size_t required_alignment);
+
+		// Non-null only when processing asynchronously; declared last so that it is destroyed,
+		// and therefore drained, first.
+		std::unique_ptr<Concurrency::AsyncTaskQueue> queue_;
+
 	public:
 		/*!	Constructs the CRT with a specified clock rate, height and colour subcarrier frequency.
 			The requested number of buffers, each with the requested number of bytes per pixel,
@@ -138,6 +267,8 @@ class CRT {
 			Outputs::Display::Type display_type,
 			Outputs::Display::InputDataType data_type);
 
+		~CRT();
+
 		/*!	Resets the CRT with new timing information. The CRT then continues as though the new timing had
 			been provided at construction. */
 		void set_new_timing(
@@ -222,27 +353,32 @@ class CRT {
 		*/
 		void set_immediate_default_phase(float phase);
 
+		/*! Sets the palette for the palette-indexed input data types: @c count entries of four bytes apiece, in
+			Red8Green8Blue8 form. The palette applies to all data output via @c output_data or @c output_level from now on.
+
+			@see @c Outputs::Display::ScanTarget::set_palette
+		*/
+		void set_palette(const uint8_t *colours, size_t count);
+
 		/*!	Attempts to allocate the given number of output samples for writing.
 
 			The beginning of the most recently allocated area is used as the start
 			of data written by a call to @c output_data; it is acceptable to write and to
 			output less data than the amount requested but that may be less efficient.
 
-			Allocation should fail only if emulation is running significantly below real speed.
+			Allocation should fail only if emulation is running significantly below real speed, or during
+			frames that the scan target has asked to be skipped; see @c ScanTarget::frames_per_output.
+
+			Very short allocations are staged within the CRT and passed on to the scan target only
+			once output; consecutive levels — including single-sample calls to @c output_data —
+			of exactly the same value are then merged into a single scan.
 
 			@param required_length The number of samples to allocate.
 			@returns A pointer to the allocated area if room is available; @c nullptr otherwise.
 		*/
 		inline uint8_t *begin_data(std::size_t required_length, std::size_t required_alignment = 1) {
-			const auto result = scan_target_->begin_data(required_length, required_alignment);
-#ifndef NDEBUG
-			// If data was allocated, make a record of how much so as to be able to hold the caller to that
-			// contract later. If allocation failed, don't constrain the caller. This allows callers that
-			// allocate on demand but may allow one failure to hold for a longer period — e.g. until the
-			// next line.
-			allocated_data_length_ = result ? required_length : std::numeric_limits<size_t>::max();
-#endif
-			return result;
+			if(queue_) return defer_begin_data(required_length, required_alignment);
+			return apply_begin_data(required_length, required_alignment);
 		}
 
 		/*!	Sets the gamma exponent for the simulated screen. */
@@ -280,16 +416,17 @@ class CRT {
 			float aspect_ratio) const;
 
 		/*!	Sets the CRT delegate; set to @c nullptr if no delegate is desired. */
-		inline void set_delegate(Delegate *delegate) {
-			delegate_ = delegate;
-		}
+		void set_delegate(Delegate *delegate);
 
-		/*! Sets the scan target for CRT output. */
+		/*! Sets the scan target for CRT output, processing asynchronously if it allows asynchronous producers. */
 		void set_scan_target(Outputs::Display::ScanTarget *);
 
 		/*!
 			Gets current scan status, with time based fields being in the input scale — e.g. if you're supplying
 			86 cycles/line and 98 lines/field then it'll return a field duration of 86*98.
+
+			Position excludes any level that is being held for possible merger with the next and, if processing
+			asynchronously, anything not yet submitted to the queue — at most a few lines.
 		*/
 		Outputs::Display::ScanStatus get_scaled_scan_status() const;
 
@@ -9,6 +9,7 @@
 #ifndef Flywheel_hpp
 #define Flywheel_hpp
 
+#include <algorithm>
 #include <cassert>
 #include <cstdlib>
 #include <cstdint>
@@ -123,6 +124,27 @@ struct Flywheel {
 		}
 	}
 
+	/*!
+		@returns The amount of time until the next synchronisation event, assuming that no synchronisation
+		is requested in the meantime. A run of any shorter length can be applied via @c advance without
+		consulting @c get_next_event_in_period.
+	*/
+	inline int get_time_until_next_event() const {
+		const int time_until_sync = expected_next_sync_ - counter_;
+		if(counter_ < retrace_time_) {
+			return std::min(time_until_sync, retrace_time_ - counter_);
+		}
+		return time_until_sync;
+	}
+
+	/*!
+		Advances a nominated amount of time, which must be less than that returned by @c get_time_until_next_event.
+	*/
+	inline void advance(int cycles_advanced) {
+		assert(cycles_advanced < get_time_until_next_event());
+		counter_ += cycles_advanced;
+	}
+
 	/*!
 		Returns the current output position; while in retrace this will go down towards 0, while in scan
 		it will go upward.
@@ -0,0 +1,133 @@
+//
+//  HostProfiler.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 14/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#ifndef HostProfiler_hpp
+#define HostProfiler_hpp
+
+#include <string>
+
+/*!
+	Optionally marks named zones — machine slices, component flushes, scan target submission,
+	audio filtering, disk events and so on — for a native profiler, so that time otherwise
+	seen only as run_for can be attributed.
+
+	At most one of the following may be defined to select a profiler; with none, as by default,
+	zones compile to nothing:
+
+		* HOST_PROFILER_TRACY for Tracy, via its C API; requires Tracy 0.10 or later and TRACY_ENABLE;
+		* HOST_PROFILER_ITT for Intel VTune and other users of the ITT API, as tasks within the
+			"Clock Signal" domain; or
+		* HOST_PROFILER_SDT for statically-defined tracepoints clksignal:zone_begin and clksignal:zone_end,
+			each with the zone name as its argument, for e.g. perf or bpftrace.
+*/
+#define HOST_PROFILER_ZONE(name)	\
+	static const ::Outputs::HostProfiler::Name HOST_PROFILER_CONCAT(host_profiler_name_, __LINE__)(name);	\
+	const ::Outputs::HostProfiler::Zone HOST_PROFILER_CONCAT(host_profiler_zone_, __LINE__)(HOST_PROFILER_CONCAT(host_profiler_name_, __LINE__))
+
+#define HOST_PROFILER_CONCAT(x, y)	HOST_PROFILER_CONCAT_(x, y)
+#define HOST_PROFILER_CONCAT_(x, y)	x##y
+
+#if defined(HOST_PROFILER_TRACY)
+#include <tracy/TracyC.h>
+#elif defined(HOST_PROFILER_ITT)
+#include <ittnotify.h>
+#elif defined(HOST_PROFILER_SDT)
+#include <sys/sdt.h>
+#endif
+
+namespace Outputs {
+namespace HostProfiler {
+
+#if defined(HOST_PROFILER_TRACY) || defined(HOST_PROFILER_ITT) || defined(HOST_PROFILER_SDT)
+constexpr bool is_enabled = true;
+#else
+constexpr bool is_enabled = false;
+#endif
+
+/*!
+	The name of a zone. Creation may be costly, so names should be created once and retained;
+	HOST_PROFILER_ZONE does so automatically.
+*/
+class Name {
+	public:
+#if defined(HOST_PROFILER_ITT)
+		Name() : Name(std::string()) {}
+		explicit Name(const std::string &name) : handle_(__itt_string_handle_create(name.c_str())) {}
+#elif defined(HOST_PROFILER_TRACY) || defined(HOST_PROFILER_SDT)
+		Name() {}
+		explicit Name(const std::string &name) : name_(name) {}
+#else
+		// Without a profiler names are constant-initialised, so zones cost nothing.
+		constexpr Name() {}
+		constexpr explicit Name(const char *) {}
+		explicit Name(const std::string &) {}
+#endif
+
+	private:
+		friend class Zone;
+#if defined(HOST_PROFILER_ITT)
+		__itt_string_handle *handle_;
+#elif defined(HOST_PROFILER_TRACY) || defined(HOST_PROFILER_SDT)
+		std::string name_;
+#endif
+};
+
+/*!
+	Marks a zone for as long as it exists; zones should be nested properly, i.e. should be destroyed
+	in the reverse of the order in which they were created, on the thread that created them.
+*/
+class Zone {
+	public:
+#if defined(HOST_PROFILER_TRACY)
+		explicit Zone(const Name &name) {
+			context_ = ___tracy_emit_zone_begin_alloc(
+				___tracy_alloc_srcloc_name(0, "", 0, "", 0, name.name_.c_str(), name.name_.size(), 0),
+				1
+			);
+		}
+		~Zone() {
+			___tracy_emit_zone_end(context_);
+		}
+#elif defined(HOST_PROFILER_ITT)
+		explicit Zone(const Name &name) {
+			__itt_task_begin(domain(), __itt_null, __itt_null, name.handle_);
+		}
+		~Zone() {
+			__itt_task_end(domain());
+		}
+#elif defined(HOST_PROFILER_SDT)
+		explicit Zone(const Name &name) : name_(name.name_.c_str()) {
+			DTRACE_PROBE1(clksignal, zone_begin, name_);
+		}
+		~Zone() {
+			DTRACE_PROBE1(clksignal, zone_end, name_);
+		}
+#else
+		constexpr explicit Zone(const Name &) {}
+#endif
+
+		Zone(const Zone &) = delete;
+		Zone &operator =(const Zone &) = delete;
+
+	private:
+#if defined(HOST_PROFILER_TRACY)
+		TracyCZoneCtx context_;
+#elif defined(HOST_PROFILER_ITT)
+		static __itt_domain *domain() {
+			static __itt_domain *const domain = __itt_domain_create("Clock Signal");
+			return domain;
+		}
+#elif defined(HOST_PROFILER_SDT)
+		const char *name_;
+#endif
+};
+
+}
+}
+
+#endif /* HostProfiler_hpp */
@@ -0,0 +1,176 @@
+//
+//  Metrics.cpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 14/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#include "Metrics.hpp"
+
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+
+using namespace Outputs::Metrics;
+
+namespace {
+
+void add(std::atomic<double> &target, double amount) {
+	double expected = target.load(std::memory_order_relaxed);
+	while(!target.compare_exchange_weak(expected, expected + amount, std::memory_order_relaxed));
+}
+
+/// @returns The shortest decimal form of @c value that reads back exactly.
+std::string number(double value) {
+	char buffer[32];
+	for(int precision = 6; precision < 17; ++precision) {
+		snprintf(buffer, sizeof(buffer), "%.*g", precision, value);
+		if(strtod(buffer, nullptr) == value) return buffer;
+	}
+	snprintf(buffer, sizeof(buffer), "%.17g", value);
+	return buffer;
+}
+
+/// @returns The sample name @c name with label set @c labels and, if supplied, the additional label @c extra.
+std::string sample(const std::string &name, const std::string &labels, const std::string &extra = "") {
+	if(labels.empty() && extra.empty()) return name;
+
+	std::string result = name + "{" + labels;
+	if(!labels.empty() && !extra.empty()) result += ",";
+	return result + extra + "}";
+}
+
+}
+
+// MARK: - Counter.
+
+void Counter::follow(uint64_t total) {
+	const uint64_t previous = followed_.exchange(total, std::memory_order_relaxed);
+	increment(total >= previous ? total - previous : total);
+}
+
+// MARK: - Histogram.
+
+Histogram::Histogram(const std::vector<double> &bounds) :
+	bounds_(bounds),
+	counts_(std::make_unique<std::atomic<uint64_t>[]>(bounds.size() + 1)) {}
+
+void Histogram::observe(double value) {
+	// Counts are stored per bucket and accumulated only upon exposition, so that each
+	// observation touches a single count.
+	size_t index = 0;
+	while(index < bounds_.size() && value > bounds_[index]) ++index;
+	counts_[index].fetch_add(1, std::memory_order_relaxed);
+	add(sum_, value);
+}
+
+uint64_t Histogram::cumulative_count(size_t index) const {
+	uint64_t total = 0;
+	for(size_t c = 0; c <= index; ++c) {
+		total += counts_[c].load(std::memory_order_relaxed);
+	}
+	return total;
+}
+
+// MARK: - Registry.
+
+Registry &Registry::shared() {
+	static Registry registry;
+	return registry;
+}
+
+Registry::Family &Registry::family(const std::string &name, const std::string &help, Type type) {
+	auto iterator = families_.find(name);
+	if(iterator == families_.end()) {
+		iterator = families_.emplace(name, Family()).first;
+		iterator->second.help = help;
+		iterator->second.type = type;
+	}
+	assert(iterator->second.type == type);
+	return iterator->second;
+}
+
+Counter &Registry::counter(const std::string &name, const std::string &help, const std::string &labels) {
+	std::lock_guard lock_guard(mutex_);
+	auto &metric = family(name, help, Type::Counter).counters[labels];
+	if(!metric) metric = std::make_unique<Counter>();
+	return *metric;
+}
+
+Gauge &Registry::gauge(const std::string &name, const std::string &help, const std::string &labels) {
+	std::lock_guard lock_guard(mutex_);
+	auto &metric = family(name, help, Type::Gauge).gauges[labels];
+	if(!metric) metric = std::make_unique<Gauge>();
+	return *metric;
+}
+
+Histogram &Registry::histogram(const std::string &name, const std::string &help, const std::vector<double> &bounds, const std::string &labels) {
+	std::lock_guard lock_guard(mutex_);
+	auto &family = this->family(name, help, Type::Histogram);
+	if(family.bounds.empty()) family.bounds = bounds;
+
+	auto &metric = family.histograms[labels];
+	if(!metric) metric = std::make_unique<Histogram>(family.bounds);
+	return *metric;
+}
+
+std::string Registry::exposition() const {
+	std::lock_guard lock_guard(mutex_);
+	std::string result;
+
+	for(const auto &pair: families_) {
+		const auto &name = pair.first;
+		const auto &family = pair.second;
+
+		result += "# HELP " + name + " " + family.help + "\n";
+		switch(family.type) {
+			case Type::Counter:
+				result += "# TYPE " + name + " counter\n";
+				for(const auto &metric: family.counters) {
+					result += sample(name, metric.first) + " " + std::to_string(metric.second->value()) + "\n";
+				}
+			break;
+
+			case Type::Gauge:
+				result += "# TYPE " + name + " gauge\n";
+				for(const auto &metric: family.gauges) {
+					result += sample(name, metric.first) + " " + number(metric.second->value()) + "\n";
+				}
+			break;
+
+			case Type::Histogram:
+				result += "# TYPE " + name + " histogram\n";
+				for(const auto &metric: family.histograms) {
+					const auto &histogram = *metric.second;
+					for(size_t c = 0; c < histogram.bounds().size(); ++c) {
+						result += sample(name + "_bucket", metric.first, "le=\"" + number(histogram.bounds()[c]) + "\"") +
+							" " + std::to_string(histogram.cumulative_count(c)) + "\n";
+					}
+
+					const auto count = std::to_string(histogram.cumulative_count(histogram.bounds().size()));
+					result += sample(name + "_bucket", metric.first, "le=\"+Inf\"") + " " + count + "\n";
+					result += sample(name + "_sum", metric.first) + " " + number(histogram.sum()) + "\n";
+					result += sample(name + "_count", metric.first) + " " + count + "\n";
+				}
+			break;
+		}
+	}
+
+	return result;
+}
+
+bool Registry::write(const std::string &path) const {
+	const auto text = exposition();
+
+	const std::string temporary_path = path + ".tmp";
+	FILE *const file = fopen(temporary_path.c_str(), "wb");
+	if(!file) return false;
+
+	const bool did_write = fwrite(text.data(), 1, text.size(), file) == text.size();
+	if(fclose(file) || !did_write || rename(temporary_path.c_str(), path.c_str())) {
+		remove(temporary_path.c_str());
+		return false;
+	}
+	return true;
+}
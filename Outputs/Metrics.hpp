@@ -0,0 +1,148 @@
+//
+//  Metrics.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 14/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#ifndef Metrics_hpp
+#define Metrics_hpp
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/*!
+	A registry of runtime metrics — counters, gauges and histograms — that hosts can
+	update from any thread and periodically export in the Prometheus text exposition format,
+	e.g. to a file watched by a node_exporter textfile collector.
+
+	Metrics are looked up once, by name and an optional label set, and then updated through
+	the returned reference, which remains valid for the lifetime of the registry. Updates are
+	lock free; only lookup and exposition take the registry's lock.
+*/
+namespace Outputs {
+namespace Metrics {
+
+/// A monotonically-increasing count.
+class Counter {
+	public:
+		/// Adds @c amount to this counter.
+		void increment(uint64_t amount = 1) {
+			value_.fetch_add(amount, std::memory_order_relaxed);
+		}
+
+		/*!
+			Advances this counter to mirror @c total, a count maintained elsewhere. If @c total is less
+			than the previous mirrored value then the source is assumed to have been reset, and all
+			of @c total is added.
+		*/
+		void follow(uint64_t total);
+
+		uint64_t value() const {
+			return value_.load(std::memory_order_relaxed);
+		}
+
+	private:
+		std::atomic<uint64_t> value_ = 0;
+		std::atomic<uint64_t> followed_ = 0;
+};
+
+/// A value that may go up or down.
+class Gauge {
+	public:
+		void set(double value) {
+			value_.store(value, std::memory_order_relaxed);
+		}
+
+		double value() const {
+			return value_.load(std::memory_order_relaxed);
+		}
+
+	private:
+		std::atomic<double> value_ = 0.0;
+};
+
+/// A distribution of observations, counted into fixed buckets.
+class Histogram {
+	public:
+		/// Constructs a histogram with buckets of the supplied upper bounds, which should be in ascending order.
+		Histogram(const std::vector<double> &bounds);
+
+		/// Records the observation @c value.
+		void observe(double value);
+
+		/// @returns The bucket upper bounds, excluding the implicit +Inf.
+		const std::vector<double> &bounds() const {
+			return bounds_;
+		}
+
+		/// @returns The number of observations of at most @c bounds()[index], or of any value if index is @c bounds().size().
+		uint64_t cumulative_count(size_t index) const;
+
+		/// @returns The sum of all observations.
+		double sum() const {
+			return sum_.load(std::memory_order_relaxed);
+		}
+
+	private:
+		std::vector<double> bounds_;
+		std::unique_ptr<std::atomic<uint64_t>[]> counts_;
+		std::atomic<double> sum_ = 0.0;
+};
+
+/*!
+	Owns metrics and produces their exposition.
+
+	Names should follow Prometheus conventions, e.g. @c clksignal_frames_total. Labels are
+	supplied preformatted, e.g. @c drive="Drive 1", and distinguish metrics of the same name.
+	The help text and the bounds of the first lookup of each name are those used.
+*/
+class Registry {
+	public:
+		/// @returns A process-wide registry.
+		static Registry &shared();
+
+		Counter &counter(const std::string &name, const std::string &help, const std::string &labels = "");
+		Gauge &gauge(const std::string &name, const std::string &help, const std::string &labels = "");
+		Histogram &histogram(const std::string &name, const std::string &help, const std::vector<double> &bounds, const std::string &labels = "");
+
+		/// @returns All metrics in the Prometheus text exposition format.
+		std::string exposition() const;
+
+		/*!
+			Writes the exposition to @c path, via a temporary file that is then moved into place
+			so that readers never observe a partial file.
+
+			@returns @c true on success; @c false otherwise.
+		*/
+		bool write(const std::string &path) const;
+
+	private:
+		enum class Type {
+			Counter, Gauge, Histogram
+		};
+
+		struct Family {
+			std::string help;
+			Type type;
+			std::vector<double> bounds;
+			std::map<std::string, std::unique_ptr<Counter>> counters;
+			std::map<std::string, std::unique_ptr<Gauge>> gauges;
+			std::map<std::string, std::unique_ptr<Histogram>> histograms;
+		};
+		std::map<std::string, Family> families_;
+		mutable std::mutex mutex_;
+
+		Family &family(const std::string &name, const std::string &help, Type type);
+};
+
+}
+}
+
+#endif /* Metrics_hpp */
@@ -0,0 +1,148 @@
+//
+//  FrameCapture.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 14/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#ifndef FrameCapture_h
+#define FrameCapture_h
+
+#include "OpenGL.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Outputs {
+namespace Display {
+namespace OpenGL {
+
+/*!
+	Captures the centre portion of the currently-bound framebuffer asynchronously, via a ring of
+	pixel buffer objects, cropping to an image that matches the requested aspect ratio.
+
+	Each call to @c capture enqueues a read into the next free pixel buffer and places a fence
+	behind it; @c collect then hands over the oldest capture once the GPU has signalled that
+	fence, mapped directly from the pixel buffer so that no copy is made. That avoids the pipeline
+	stall of a synchronous glReadPixels, at the cost of a frame or two of latency.
+
+	All methods must be called with the same OpenGL context current.
+*/
+class FrameCapture {
+	public:
+		/// Constructs a capturer that can hold up to @c buffer_count captures awaiting collection.
+		FrameCapture(size_t buffer_count = 3) : buffers_(buffer_count ? buffer_count : 1) {}
+
+		~FrameCapture() {
+			for(auto &buffer: buffers_) {
+				if(buffer.fence) glDeleteSync(buffer.fence);
+				if(buffer.name) glDeleteBuffers(1, &buffer.name);
+			}
+		}
+
+		FrameCapture(const FrameCapture &) = delete;
+		FrameCapture &operator =(const FrameCapture &) = delete;
+
+		/*!
+			Begins a capture of the centre portion of the currently-bound framebuffer.
+
+			@returns @c true if the capture was begun; @c false if every buffer is still awaiting collection.
+		*/
+		bool capture(int aspect_width, int aspect_height) {
+			if(pending_ == buffers_.size()) return false;
+			Buffer &buffer = buffers_[(first_pending_ + pending_) % buffers_.size()];
+
+			// Get the current viewport to establish framebuffer size. Then determine how wide the
+			// centre portion of that would be, allowing for the requested aspect ratio.
+			GLint dimensions[4];
+			glGetIntegerv(GL_VIEWPORT, dimensions);
+			buffer.height = int(dimensions[3]);
+			buffer.width = (buffer.height * aspect_width) / aspect_height;
+
+			// (Re)allocate the pixel buffer if necessary.
+			if(!buffer.name) {
+				test_gl(glGenBuffers, 1, &buffer.name);
+			}
+			test_gl(glBindBuffer, GL_PIXEL_PACK_BUFFER, buffer.name);
+			const size_t size = size_t(buffer.width * buffer.height * 4);
+			if(size != buffer.size) {
+				test_gl(glBufferData, GL_PIXEL_PACK_BUFFER, GLsizeiptr(size), nullptr, GL_STREAM_READ);
+				buffer.size = size;
+			}
+
+			// Enqueue the read, and a fence to signal its completion. Rows of RGBA are always a
+			// multiple of four bytes, so the prevailing pack alignment is irrelevant.
+			test_gl(glReadPixels, (dimensions[2] - GLint(buffer.width)) >> 1, 0, GLint(buffer.width), GLint(buffer.height), GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+			buffer.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+			test_gl(glBindBuffer, GL_PIXEL_PACK_BUFFER, 0);
+
+			++pending_;
+			return true;
+		}
+
+		/// Describes a completed capture. Rows are in OpenGL order: bottom to top.
+		struct Frame {
+			const uint8_t *pixels;
+			int width, height;
+			size_t line_size;
+		};
+
+		/*!
+			If the oldest outstanding capture has completed, or if @c wait is @c true, calls
+			@c receiver with that capture as a @c Frame. The pixels are valid only for the
+			duration of that call.
+
+			@returns @c true if @c receiver was called; @c false otherwise.
+		*/
+		template <typename ReceiverT> bool collect(ReceiverT &&receiver, bool wait = false) {
+			if(!pending_) return false;
+			Buffer &buffer = buffers_[first_pending_];
+
+			const GLuint64 timeout = wait ? GL_TIMEOUT_IGNORED : 0;
+			const GLenum status = glClientWaitSync(buffer.fence, GL_SYNC_FLUSH_COMMANDS_BIT, timeout);
+			if(status == GL_TIMEOUT_EXPIRED) return false;
+			glDeleteSync(buffer.fence);
+			buffer.fence = nullptr;
+
+			first_pending_ = (first_pending_ + 1) % buffers_.size();
+			--pending_;
+
+			// Give the receiver direct access to the buffer's contents.
+			test_gl(glBindBuffer, GL_PIXEL_PACK_BUFFER, buffer.name);
+			const void *const contents = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, GLsizeiptr(buffer.size), GL_MAP_READ_BIT);
+			if(contents) {
+				receiver(Frame{
+					static_cast<const uint8_t *>(contents),
+					buffer.width, buffer.height,
+					size_t(buffer.width * 4)
+				});
+				glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+			}
+			test_gl(glBindBuffer, GL_PIXEL_PACK_BUFFER, 0);
+
+			return bool(contents);
+		}
+
+		/// @returns The number of captures that are awaiting collection.
+		size_t pending() const {
+			return pending_;
+		}
+
+	private:
+		struct Buffer {
+			GLuint name = 0;
+			GLsync fence = nullptr;
+			size_t size = 0;
+			int width = 0, height = 0;
+		};
+		std::vector<Buffer> buffers_;
+		size_t first_pending_ = 0, pending_ = 0;
+};
+
+}
+}
+}
+
+#endif /* FrameCapture_h */
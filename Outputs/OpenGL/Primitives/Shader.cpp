@@ -9,6 +9,13 @@
 #include "Shader.hpp"
 
 #include "../../Log.hpp"
+
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <mutex>
 #include <vector>
 
 using namespace Outputs::Display::OpenGL;
@@ -17,6 +24,178 @@ namespace {
 	// The below is disabled because it isn't context/thread-specific. Which makes it
 	// fairly 'unuseful'.
 //	Shader *bound_shader = nullptr;
+
+	std::string &binary_cache_directory() {
+		static std::string directory;
+		return directory;
+	}
+
+	/// @returns A description of the current OpenGL driver; stored binaries are valid only for the driver that produced them.
+	std::string driver_identity() {
+		std::string identity;
+		for(const GLenum name: {GL_VENDOR, GL_RENDERER, GL_VERSION}) {
+			const auto string = reinterpret_cast<const char *>(glGetString(name));
+			identity += string ? string : "";
+			identity += '\n';
+		}
+		return identity;
+	}
+
+	/// @returns @c true if the current driver can supply and accept linked program binaries.
+	bool supports_program_binaries() {
+#ifdef GL_PROGRAM_BINARY_LENGTH
+		GLint formats = 0;
+		glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+		return formats > 0;
+#else
+		return false;
+#endif
+	}
+
+	/// @returns A hash of everything that affects the described program, using FNV-1a.
+	uint64_t program_hash(const std::string &identity, const std::string &vertex_shader, const std::string &fragment_shader, const std::vector<Shader::AttributeBinding> &attribute_bindings) {
+		uint64_t hash = 0xcbf29ce484222325;
+		const auto fold = [&hash](const std::string &string) {
+			for(const char c: string) {
+				hash = (hash ^ uint8_t(c)) * 0x100000001b3;
+			}
+			hash = (hash ^ 0xff) * 0x100000001b3;
+		};
+		fold(identity);
+		fold(vertex_shader);
+		fold(fragment_shader);
+		for(const auto &binding: attribute_bindings) {
+			fold(binding.name + "=" + std::to_string(binding.index));
+		}
+		return hash;
+	}
+
+	/// @returns The path at which a binary for the program with @c hash would be cached, or an empty string if there is no cache directory.
+	std::string binary_cache_path(uint64_t hash) {
+		if(binary_cache_directory().empty()) return "";
+
+		char name[64];
+		snprintf(name, sizeof(name), "clksignal-shader-%016" PRIx64 ".bin", hash);
+		std::string path = binary_cache_directory();
+		if(path.back() != '/') path += '/';
+		return path + name;
+	}
+
+	struct ProgramBinary {
+		GLenum format = 0;
+		std::vector<uint8_t> data;
+	};
+
+	/*!
+		Retains the binaries of the programs most recently linked or loaded by this process, so that
+		further constructions of the same program — e.g. by each of several scan targets displaying the
+		same sort of machine — are loaded from the driver's own output rather than compiled again,
+		whether or not there is a cache directory.
+	*/
+	class BinaryStore {
+		public:
+			std::shared_ptr<const ProgramBinary> find(uint64_t hash) {
+				std::lock_guard lock(mutex_);
+				for(const auto &entry: entries_) {
+					if(entry.first == hash) return entry.second;
+				}
+				return nullptr;
+			}
+
+			void insert(uint64_t hash, std::shared_ptr<const ProgramBinary> binary) {
+				std::lock_guard lock(mutex_);
+				for(const auto &entry: entries_) {
+					if(entry.first == hash) return;
+				}
+				if(entries_.size() == Capacity) {
+					entries_.pop_front();
+				}
+				entries_.emplace_back(hash, std::move(binary));
+			}
+
+		private:
+			static constexpr size_t Capacity = 32;
+			std::mutex mutex_;
+			std::deque<std::pair<uint64_t, std::shared_ptr<const ProgramBinary>>> entries_;
+	};
+
+	BinaryStore &binary_store() {
+		static BinaryStore store;
+		return store;
+	}
+
+#ifdef GL_PROGRAM_BINARY_LENGTH
+	/// Attempts to load @c program from @c binary. @returns @c true if the program is now linked; @c false otherwise.
+	bool load_binary(GLuint program, const ProgramBinary &binary) {
+		// The driver may reject a binary regardless, e.g. after an update that didn't change its version string.
+		glProgramBinary(program, binary.format, binary.data.data(), GLsizei(binary.data.size()));
+		GLint did_link = GL_FALSE;
+		glGetProgramiv(program, GL_LINK_STATUS, &did_link);
+		while(glGetError());
+		return did_link == GL_TRUE;
+	}
+
+	/// @returns The binary of the linked @c program, or @c nullptr if it can't be obtained.
+	std::shared_ptr<const ProgramBinary> retrieve_binary(GLuint program) {
+		GLint did_link = GL_FALSE, length = 0;
+		glGetProgramiv(program, GL_LINK_STATUS, &did_link);
+		glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+		if(did_link != GL_TRUE || length <= 0) return nullptr;
+
+		auto binary = std::make_shared<ProgramBinary>();
+		binary->data.resize(static_cast<size_t>(length));
+		glGetProgramBinary(program, length, &length, &binary->format, binary->data.data());
+		if(glGetError() != GL_NO_ERROR || length <= 0) return nullptr;
+		binary->data.resize(size_t(length));
+		return binary;
+	}
+
+	/// @returns The binary stored at @c path by the driver described by @c identity, or @c nullptr if there is none.
+	std::shared_ptr<const ProgramBinary> read_binary(const std::string &path, const std::string &identity) {
+		FILE *const file = fopen(path.c_str(), "rb");
+		if(!file) return nullptr;
+
+		std::vector<uint8_t> contents;
+		uint8_t chunk[16384];
+		size_t read;
+		while((read = fread(chunk, 1, sizeof(chunk), file)) > 0) {
+			contents.insert(contents.end(), chunk, chunk + read);
+		}
+		fclose(file);
+
+		// The file is the driver identity, terminated by a NUL, then the binary format and the binary itself.
+		const size_t header_size = identity.size() + 1 + sizeof(GLenum);
+		if(contents.size() <= header_size || memcmp(contents.data(), identity.c_str(), identity.size() + 1)) {
+			return nullptr;
+		}
+
+		auto binary = std::make_shared<ProgramBinary>();
+		memcpy(&binary->format, &contents[identity.size() + 1], sizeof(binary->format));
+		binary->data.assign(contents.begin() + ptrdiff_t(header_size), contents.end());
+		return binary;
+	}
+
+	/// Stores @c binary to @c path; failure is silent as this is only a cache.
+	void write_binary(const ProgramBinary &binary, const std::string &path, const std::string &identity) {
+		// Write to a temporary file and then move that into place, so that an interrupted
+		// write can't leave a truncated binary to be found later.
+		const std::string temporary_path = path + ".tmp";
+		FILE *const file = fopen(temporary_path.c_str(), "wb");
+		if(!file) return;
+
+		const bool did_write =
+			fwrite(identity.c_str(), 1, identity.size() + 1, file) == identity.size() + 1 &&
+			fwrite(&binary.format, 1, sizeof(binary.format), file) == sizeof(binary.format) &&
+			fwrite(binary.data.data(), 1, binary.data.size(), file) == binary.data.size();
+		if(fclose(file) || !did_write || rename(temporary_path.c_str(), path.c_str())) {
+			remove(temporary_path.c_str());
+		}
+	}
+#endif
+}
+
+void Shader::set_binary_cache_directory(const std::string &directory) {
+	binary_cache_directory() = directory;
 }
 
 GLuint Shader::compile_shader(const std::string &source, GLenum type) {
@@ -61,6 +240,32 @@ Shader::Shader(const std::string &vertex_shader, const std::string &fragment_sha
 
 void Shader::init(const std::string &vertex_shader, const std::string &fragment_shader, const std::vector<AttributeBinding> &attribute_bindings) {
 	shader_program_ = glCreateProgram();
+
+	// Use a binary from earlier in this run or from the cache directory if there is one.
+#ifdef GL_PROGRAM_BINARY_LENGTH
+	if(supports_program_binaries()) {
+		const std::string identity = driver_identity();
+		const uint64_t hash = program_hash(identity, vertex_shader, fragment_shader, attribute_bindings);
+
+		if(const auto binary = binary_store().find(hash); binary && load_binary(shader_program_, *binary)) {
+			return;
+		}
+
+		const std::string cache_path = binary_cache_path(hash);
+		if(!cache_path.empty()) {
+			if(const auto binary = read_binary(cache_path, identity); binary && load_binary(shader_program_, *binary)) {
+				binary_store().insert(hash, binary);
+				return;
+			}
+		}
+
+		// Defer retrieval of the binary until first use: querying it now would wait for linkage
+		// to complete, defeating any parallel compilation.
+		test_gl(glProgramParameteri, shader_program_, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+		pending_binary_ = PendingBinary{hash, cache_path, identity};
+	}
+#endif
+
 	const GLuint vertex = compile_shader(vertex_shader, GL_VERTEX_SHADER);
 	const GLuint fragment = compile_shader(fragment_shader, GL_FRAGMENT_SHADER);
 
@@ -104,6 +309,38 @@ void Shader::init(const std::string &vertex_shader, const std::string &fragment_
 		throw ProgramLinkageError;
 	}
 #endif
+
+}
+
+bool Shader::supports_parallel_compilation() {
+#ifdef GL_COMPLETION_STATUS_KHR
+	static const bool supports = [] {
+		GLint count = 0;
+		glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+		for(GLint c = 0; c < count; c++) {
+			const auto name = reinterpret_cast<const char *>(glGetStringi(GL_EXTENSIONS, GLuint(c)));
+			if(name && (!strcmp(name, "GL_KHR_parallel_shader_compile") || !strcmp(name, "GL_ARB_parallel_shader_compile"))) {
+				return true;
+			}
+		}
+		return false;
+	}();
+	return supports;
+#else
+	return false;
+#endif
+}
+
+bool Shader::is_ready() const {
+#ifdef GL_COMPLETION_STATUS_KHR
+	if(!supports_parallel_compilation()) return true;
+
+	GLint is_complete = GL_TRUE;
+	test_gl(glGetProgramiv, shader_program_, GL_COMPLETION_STATUS_KHR, &is_complete);
+	return is_complete == GL_TRUE;
+#else
+	return true;
+#endif
 }
 
 Shader::~Shader() {
@@ -112,6 +349,18 @@ Shader::~Shader() {
 }
 
 void Shader::bind() const {
+#ifdef GL_PROGRAM_BINARY_LENGTH
+	if(pending_binary_) {
+		if(const auto binary = retrieve_binary(shader_program_)) {
+			binary_store().insert(pending_binary_->hash, binary);
+			if(!pending_binary_->cache_path.empty()) {
+				write_binary(*binary, pending_binary_->cache_path, pending_binary_->identity);
+			}
+		}
+		pending_binary_.reset();
+	}
+#endif
+
 //	if(bound_shader != this) {
 		test_gl(glUseProgram, shader_program_);
 //		bound_shader = this;
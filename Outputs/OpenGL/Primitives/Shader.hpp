@@ -12,7 +12,9 @@
 #include "../OpenGL.hpp"
 
 #include <functional>
+#include <cstdint>
 #include <mutex>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -116,12 +118,44 @@ public:
 	void set_uniform_matrix(const std::string &name, GLint size, bool transpose, const GLfloat *values);
 	void set_uniform_matrix(const std::string &name, GLint size, GLsizei count, bool transpose, const GLfloat *values);
 
+	/*!
+		Nominates a directory in which to cache linked programs, keyed by their source, attribute bindings and
+		the identity of the OpenGL driver, so that later constructions of the same shader by another process
+		can skip compilation and linkage. Caching to disk is disabled while @c directory is empty, as by default.
+
+		Independently of this, the binaries of recently-linked programs are retained in memory, so that
+		further constructions of the same shader within this process — e.g. by any number of scan
+		targets showing the same sort of machine — need not compile it again. Neither applies if the
+		driver supports no program binary formats.
+	*/
+	static void set_binary_cache_directory(const std::string &directory);
+
+	/*!
+		@returns @c true if the driver compiles and links shaders in parallel with the caller, in which case
+		construction of a @c Shader doesn't wait for either; @c false otherwise.
+	*/
+	static bool supports_parallel_compilation();
+
+	/*!
+		@returns @c true if this shader's compilation and linkage are complete, so that using it won't block;
+		@c false otherwise. Always @c true without parallel compilation. Does not block.
+	*/
+	bool is_ready() const;
+
 private:
 	void init(const std::string &vertex_shader, const std::string &fragment_shader, const std::vector<AttributeBinding> &attribute_bindings);
 
 	GLuint compile_shader(const std::string &source, GLenum type);
 	GLuint shader_program_;
 
+	// Where and how to retain this program's binary upon first use, if at all.
+	struct PendingBinary {
+		uint64_t hash;
+		std::string cache_path;
+		std::string identity;
+	};
+	mutable std::optional<PendingBinary> pending_binary_;
+
 	void flush_functions() const;
 	mutable std::vector<std::function<void(void)>> enqueued_functions_;
 	mutable std::mutex function_mutex_;
@@ -62,6 +62,14 @@ class TextureTarget {
 			return height_;
 		}
 
+		/*!
+			@returns the number of bytes of GPU memory occupied by the texture and any stencil buffer.
+		*/
+		size_t get_memory_footprint() const {
+			const size_t pixels = size_t(expanded_width_) * size_t(expanded_height_);
+			return pixels * 4 + (renderbuffer_ ? pixels : 0);
+		}
+
 		/*!
 			Draws this texture to the currently-bound framebuffer, which has the aspect ratio
 			@c aspect_ratio. This texture will fill the height of the frame buffer, and pick
@@ -11,7 +11,7 @@
 
 #include "../Log.hpp"
 #include "../DisplayMetrics.hpp"
-#include "../ScanTargets/BufferingScanTarget.hpp"
+#include "../ScanTargets/GPUScanTarget.hpp"
 
 #include "OpenGL.hpp"
 #include "Primitives/TextureTarget.hpp"
@@ -38,7 +38,7 @@ namespace OpenGL {
 	this uses various internal buffers so that the only geometry
 	drawn to the target framebuffer is a quad.
 */
-class ScanTarget: public Outputs::Display::BufferingScanTarget {	// TODO: use private inheritance and expose only display_metrics() and a custom cast?
+class ScanTarget: public Outputs::Display::GPUScanTarget {	// TODO: use private inheritance and expose only display_metrics() and a custom cast?
 	public:
 		ScanTarget(GLuint target_framebuffer = 0, float output_gamma = 2.2f);
 		~ScanTarget();
@@ -47,8 +47,23 @@ class ScanTarget: public Outputs::Display::BufferingScanTarget {	// TODO: use pr
 
 		/*! Pushes the current state of output to the target framebuffer. */
 		void draw(int output_width, int output_height);
-		/*! Processes all the latest input, at a resolution suitable for later output to a framebuffer of the specified size. */
-		void update(int output_width, int output_height);
+
+		/*!
+			@returns The number of bytes occupied by this scan target's buffers, in both host and GPU memory,
+			and by its textures. Should be called from the thread that calls @c draw.
+		*/
+		size_t get_memory_footprint() final;
+		enum class Pipeline {
+			/// Composite and S-Video chrominance is separated at a fixed resolution into an
+			/// intermediate texture, which is then sampled during output.
+			MultiPass,
+			/// Chrominance is separated as part of output, with no intermediate texture or
+			/// additional draw calls. This costs more samples per output pixel, but saves a pass
+			/// and two render-target switches per batch of lines, so suits fill-rate-limited hosts.
+			SinglePass,
+		};
+		/*! Selects the decoding pipeline; this takes effect from the next call to @c update. */
+		void set_pipeline(Pipeline);
 
 	private:
 		static constexpr int LineBufferWidth = 2048;
@@ -69,9 +84,6 @@ class ScanTarget: public Outputs::Display::BufferingScanTarget {	// TODO: use pr
 		int resolution_reduction_level_ = 1;
 		int output_height_ = 0;
 
-		size_t lines_submitted_ = 0;
-		std::chrono::high_resolution_clock::time_point line_submission_begin_time_;
-
 		// Contains the first composition of scans into lines;
 		// they're accumulated prior to output to allow for continuous
 		// application of any necessary conversions — e.g. composite processing.
@@ -91,14 +103,56 @@ class ScanTarget: public Outputs::Display::BufferingScanTarget {	// TODO: use pr
 		GLuint scan_buffer_name_ = 0, scan_vertex_array_ = 0;
 		GLuint line_buffer_name_ = 0, line_vertex_array_ = 0;
 
-		template <typename T> void allocate_buffer(const T &array, GLuint &buffer_name, GLuint &vertex_array_name);
+		/// Creates a buffer and vertex array for @c array, mapping the buffer persistently if
+		/// uses_persistent_buffers_ is set. @returns The mapping, if any.
+		template <typename T> void *allocate_buffer(const T &array, GLuint &buffer_name, GLuint &vertex_array_name);
 		template <typename T> void patch_buffer(const T &array, GLuint target, uint16_t submit_pointer, uint16_t read_pointer);
 
+		// If persistent buffers are in use then BufferingScanTarget writes scans and lines
+		// directly into GPU-visible memory, and scan_buffer_ and line_buffer_ serve only
+		// to size those buffers. Otherwise they're staging areas, copied upon each update.
+		bool uses_persistent_buffers_ = false;
+		static bool supports_persistent_buffers();
+
+		/// Draws @c count instances starting from @c first, within a circular buffer of size @c buffer_size.
+		void draw_instances(size_t first, size_t count, size_t buffer_size);
+
 		GLuint write_area_texture_name_ = 0;
 		bool texture_exists_ = false;
 
+		// New rows of the write area are uploaded via a ring of pixel buffer objects, each
+		// guarded by a fence so that it is refilled only once the GPU has finished reading it.
+		struct UploadBuffer {
+			GLuint name = 0;
+			size_t size = 0;
+			GLsync fence = nullptr;
+		};
+		std::array<UploadBuffer, 3> upload_buffers_;
+		size_t upload_buffer_pointer_ = 0;
+		void upload_write_area(const OutputArea &area);
+
+		// GPUScanTarget overrides.
+		bool submission_is_complete() final;
+		bool reads_buffers_in_place() const final;
+		void begin_submission(const OutputArea &area, bool modals_did_change, int output_width, int output_height) final;
+		void submit_lines(size_t first, size_t count) final;
+		void end_submission(const OutputArea &area) final;
+
 		// Receives scan target modals.
 		void setup_pipeline();
+		bool needs_qam_buffer() const;
+
+		// If the driver compiles in parallel then shaders for new modals are prepared here while
+		// output continues with the previous pipeline; new input is processed only once they're ready,
+		// and setup_pipeline then adopts them.
+		struct PreparedShaders {
+			uint64_t generation = 0;
+			Pipeline pipeline = Pipeline::MultiPass;
+			std::unique_ptr<Shader> input, output, qam;
+		} prepared_;
+		bool pipeline_is_prepared();
+		Pipeline pipeline_ = Pipeline::MultiPass;
+		bool pipeline_is_dirty_ = false;
 
 		enum class ShaderType {
 			Composition,
@@ -141,6 +195,12 @@ class ScanTarget: public Outputs::Display::BufferingScanTarget {	// TODO: use pr
 
 		void set_sampling_window(int output_Width, int output_height, Shader &target);
 
+		/*!
+			Supplies @c chromaCoordinateOffsets, the clock offsets of the quarter-colour-cycle taps around
+			each output pixel at which a single-pass conversion shader separates chrominance.
+		*/
+		void set_chroma_offsets(Shader &target) const;
+
 		std::string sampling_function() const;
 
 		/*!
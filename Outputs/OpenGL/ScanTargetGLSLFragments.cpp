@@ -61,6 +61,16 @@ void ScanTarget::set_uniforms(ShaderType type, Shader &target) const {
 	}
 }
 
+void ScanTarget::set_chroma_offsets(Shader &target) const {
+	const auto modals = BufferingScanTarget::modals();
+	const float clocks_per_angle = float(modals.cycles_per_line) * float(modals.colour_cycle_denominator) / float(modals.colour_cycle_numerator);
+	GLfloat texture_offsets[4];
+	for(int c = 0; c < 4; ++c) {
+		texture_offsets[c] = ((GLfloat(c) - 1.5f) / 4.0f) * clocks_per_angle;
+	}
+	target.set_uniform("chromaCoordinateOffsets", 1, 4, texture_offsets);
+}
+
 void ScanTarget::set_sampling_window(int output_width, int, Shader &target) {
 	const auto modals = BufferingScanTarget::modals();
 	if(modals.display_type != DisplayType::CompositeColour) {
@@ -117,6 +127,23 @@ void ScanTarget::enable_vertex_attributes(ShaderType type, Shader &target) {
 				sizeof(Scan),
 				reinterpret_cast<void *>(offsetof(Scan, line)),
 				1);
+
+			// Only the composition shaders for palette-indexed types make use of a palette location.
+			if(target.get_attrib_location("paletteX") >= 0) {
+				target.enable_vertex_attribute_with_pointer(
+					"paletteX",
+					1, GL_UNSIGNED_SHORT, GL_FALSE,
+					sizeof(Scan),
+					reinterpret_cast<void *>(offsetof(Scan, palette_x)),
+					1);
+
+				target.enable_vertex_attribute_with_pointer(
+					"paletteY",
+					1, GL_UNSIGNED_SHORT, GL_FALSE,
+					sizeof(Scan),
+					reinterpret_cast<void *>(offsetof(Scan, palette_y)),
+					1);
+			}
 		break;
 
 		default:
@@ -173,7 +200,9 @@ std::vector<std::string> ScanTarget::bindings(ShaderType type) const {
 			"endDataX",
 			"endClock",
 			"dataY",
-			"lineY"
+			"lineY",
+			"paletteX",
+			"paletteY"
 		};
 
 		default: return {
@@ -207,6 +236,8 @@ std::string ScanTarget::sampling_function() const {
 	switch(modals.input_data_type) {
 		case InputDataType::Luminance1:
 		case InputDataType::Luminance8:
+		case InputDataType::Luminance1Packed:
+		case InputDataType::Luminance2Packed:
 			// Easy, just copy across.
 			fragment_shader +=
 				is_svideo ?
@@ -241,6 +272,8 @@ std::string ScanTarget::sampling_function() const {
 		case InputDataType::Red2Green2Blue2:
 		case InputDataType::Red4Green4Blue4:
 		case InputDataType::Red8Green8Blue8:
+		case InputDataType::Palette8:
+		case InputDataType::Palette4Packed:
 			fragment_shader +=
 				"vec3 colour = rgbToLumaChroma * textureLod(textureName, coordinate, 0).rgb;"
 				"vec2 quadrature = vec2(cos(angle), sin(angle));";
@@ -259,6 +292,7 @@ std::string ScanTarget::sampling_function() const {
 
 std::unique_ptr<Shader> ScanTarget::conversion_shader() const {
 	const auto modals = BufferingScanTarget::modals();
+	const bool is_single_pass = pipeline_ == Pipeline::SinglePass;
 
 	// Compose a vertex shader. If the display type is RGB, generate just the proper
 	// geometry position, plus a solitary textureCoordinate.
@@ -294,6 +328,7 @@ std::unique_ptr<Shader> ScanTarget::conversion_shader() const {
 		"uniform vec2 size;"
 
 		"uniform float textureCoordinateOffsets[4];"
+		"uniform float chromaCoordinateOffsets[4];"
 		"out vec2 textureCoordinates[4];";
 
 	std::string fragment_shader =
@@ -351,7 +386,15 @@ std::unique_ptr<Shader> ScanTarget::conversion_shader() const {
 		"textureCoordinates[2] = vec2(centreClock + textureCoordinateOffsets[2], lineY + 0.5) / textureSize(textureName, 0);"
 		"textureCoordinates[3] = vec2(centreClock + textureCoordinateOffsets[3], lineY + 0.5) / textureSize(textureName, 0);";
 
-	if((modals.display_type == DisplayType::SVideo) || (modals.display_type == DisplayType::CompositeColour)) {
+	// In the single-pass pipeline, qamTextureCoordinates are instead the centres of four chrominance
+	// taps, a quarter of a colour cycle apart in the unprocessed line texture.
+	if(is_single_pass && ((modals.display_type == DisplayType::SVideo) || (modals.display_type == DisplayType::CompositeColour))) {
+		vertex_shader +=
+			"qamTextureCoordinates[0] = vec2(centreClock + chromaCoordinateOffsets[0], lineY + 0.5) / textureSize(textureName, 0);"
+			"qamTextureCoordinates[1] = vec2(centreClock + chromaCoordinateOffsets[1], lineY + 0.5) / textureSize(textureName, 0);"
+			"qamTextureCoordinates[2] = vec2(centreClock + chromaCoordinateOffsets[2], lineY + 0.5) / textureSize(textureName, 0);"
+			"qamTextureCoordinates[3] = vec2(centreClock + chromaCoordinateOffsets[3], lineY + 0.5) / textureSize(textureName, 0);";
+	} else if((modals.display_type == DisplayType::SVideo) || (modals.display_type == DisplayType::CompositeColour)) {
 		vertex_shader +=
 			"float centreCompositeAngle = abs(mix(startCompositeAngle, endCompositeAngle, lateral)) * 4.0 / 64.0;"
 			"centreCompositeAngle = floor(centreCompositeAngle);"
@@ -373,6 +416,66 @@ std::unique_ptr<Shader> ScanTarget::conversion_shader() const {
 		fragment_shader += sampling_function();
 	}
 
+	// Provide single-pass chrominance separation if required. This reproduces in place what the
+	// QAM separation shader would have written to each of the four texels that the output would
+	// otherwise sample; for composite video that needs seven composite samples, at the tap centres
+	// plus or minus a half and one-and-a-half quarter colour cycles.
+	if(is_single_pass) {
+		switch(modals.display_type) {
+			default: break;
+
+			case DisplayType::CompositeColour:
+				fragment_shader += R"x(
+					vec2 separated_chrominance() {
+						vec2 quarterStep = qamTextureCoordinates[1] - qamTextureCoordinates[0];
+						vec2 firstCoordinate = qamTextureCoordinates[0] - quarterStep*1.5;
+
+						float samples[7];
+						for(int c = 0; c < 7; ++c) {
+							samples[c] = composite_sample(firstCoordinate + quarterStep*float(c), compositeAngle + (float(c) - 3.0) * 1.570796327);
+						}
+
+						vec2 channels = vec2(0.0);
+						for(int c = 0; c < 4; ++c) {
+							float tapLuminance = (samples[c] + samples[c+1] + samples[c+2] + samples[c+3]) * 0.25;
+							float tapChrominance = ((samples[c+1] + samples[c+2]) * 0.5 - tapLuminance) * oneOverCompositeAmplitude;
+							float tapAngle = compositeAngle + (float(c) - 1.5) * 1.570796327;
+							channels += vec2(cos(tapAngle), sin(tapAngle)) * tapChrominance;
+						}
+						return channels * 0.25;
+					}
+				)x";
+			break;
+
+			case DisplayType::SVideo:
+				fragment_shader += R"x(
+					vec2 separated_chrominance() {
+						vec2 channels = vec2(0.0);
+						for(int c = 0; c < 4; ++c) {
+							float tapAngle = compositeAngle + (float(c) - 1.5) * 1.570796327;
+							channels += vec2(cos(tapAngle), sin(tapAngle)) * svideo_sample(qamTextureCoordinates[c], tapAngle).y;
+						}
+						return channels * 0.25;
+					}
+				)x";
+			break;
+		}
+	}
+
+	// In the multi-pass pipeline, chrominance is already separated; average the four nearest texels.
+	const std::string chrominance =
+		is_single_pass ?
+			"vec2 channels = separated_chrominance();" :
+			R"x(
+				vec2 chrominances[4] = vec2[4](
+					textureLod(qamTextureName, qamTextureCoordinates[0], 0).gb,
+					textureLod(qamTextureName, qamTextureCoordinates[1], 0).gb,
+					textureLod(qamTextureName, qamTextureCoordinates[2], 0).gb,
+					textureLod(qamTextureName, qamTextureCoordinates[3], 0).gb
+				);
+				vec2 channels = (chrominances[0] + chrominances[1] + chrominances[2] + chrominances[3])*0.5 - vec2(1.0);
+			)x";
+
 	fragment_shader +=
 		"void main(void) {"
 			"vec3 fragColour3;";
@@ -403,13 +506,7 @@ std::unique_ptr<Shader> ScanTarget::conversion_shader() const {
 					float luminance = dot(samples, vec4(0.25));
 
 					// Split and average chrominance.
-					vec2 chrominances[4] = vec2[4](
-						textureLod(qamTextureName, qamTextureCoordinates[0], 0).gb,
-						textureLod(qamTextureName, qamTextureCoordinates[1], 0).gb,
-						textureLod(qamTextureName, qamTextureCoordinates[2], 0).gb,
-						textureLod(qamTextureName, qamTextureCoordinates[3], 0).gb
-					);
-					vec2 channels = (chrominances[0] + chrominances[1] + chrominances[2] + chrominances[3])*0.5 - vec2(1.0);
+			)x" + chrominance + R"x(
 
 					// Apply a colour space conversion to get RGB.
 					fragColour3 = lumaChromaToRGB * vec3(luminance / (1.0 - compositeAmplitude), channels);
@@ -453,13 +550,7 @@ std::unique_ptr<Shader> ScanTarget::conversion_shader() const {
 				"float luminance = dot(samples, vec4(0.15, 0.35, 0.35, 0.25));"
 
 				// Split and average chrominaxnce.
-				"vec2 chrominances[4] = vec2[4]("
-					"textureLod(qamTextureName, qamTextureCoordinates[0], 0).gb,"
-					"textureLod(qamTextureName, qamTextureCoordinates[1], 0).gb,"
-					"textureLod(qamTextureName, qamTextureCoordinates[2], 0).gb,"
-					"textureLod(qamTextureName, qamTextureCoordinates[3], 0).gb"
-				");"
-				"vec2 channels = (chrominances[0] + chrominances[1] + chrominances[2] + chrominances[3])*0.5 - vec2(1.0);"
+				+ chrominance +
 
 				// Apply a colour space conversion to get RGB.
 				"fragColour3 = lumaChromaToRGB * vec3(luminance, channels);";
@@ -502,13 +593,18 @@ std::unique_ptr<Shader> ScanTarget::composition_shader() const {
 		in float dataY;
 		in float lineY;
 
+		in float paletteX;
+		in float paletteY;
+
 		out vec2 textureCoordinate;
+		flat out vec2 paletteLocation;
 		uniform usampler2D textureName;
 
 		void main(void) {
 			float lateral = float(gl_VertexID & 1);
 			float longitudinal = float((gl_VertexID & 2) >> 1);
 
+			paletteLocation = vec2(paletteX, paletteY);
 			textureCoordinate = vec2(mix(startDataX, endDataX, lateral), dataY + 0.5) / textureSize(textureName, 0);
 			vec2 eyePosition = vec2(mix(startClock, endClock, lateral), lineY + longitudinal) / vec2(2048.0, 2048.0);
 			gl_Position = vec4(eyePosition*2.0 - vec2(1.0), 0.0, 1.0);
@@ -520,12 +616,28 @@ std::unique_ptr<Shader> ScanTarget::composition_shader() const {
 
 		out vec4 fragColour;
 		in vec2 textureCoordinate;
+		flat in vec2 paletteLocation;
 
 		uniform usampler2D textureName;
-
-		void main(void) {
 	)x";
 
+	// The palette-indexed types look up each index in the palette that the BufferingScanTarget
+	// placed in the write area, four samples per entry.
+	if(palette_size_for_data_type(modals.input_data_type)) {
+		fragment_shader += R"x(
+			vec4 paletteColour(uint index) {
+				ivec2 entry = ivec2(paletteLocation) + ivec2(int(index) * 4, 0);
+				return vec4(
+					float(texelFetch(textureName, entry, 0).r),
+					float(texelFetch(textureName, entry + ivec2(1, 0), 0).r),
+					float(texelFetch(textureName, entry + ivec2(2, 0), 0).r),
+					255.0) / 255.0;
+			}
+		)x";
+	}
+
+	fragment_shader += "void main(void) {";
+
 	switch(modals.input_data_type) {
 		case InputDataType::Luminance1:
 			fragment_shader += "fragColour = textureLod(textureName, textureCoordinate, 0).rrrr;";
@@ -535,6 +647,21 @@ std::unique_ptr<Shader> ScanTarget::composition_shader() const {
 			fragment_shader += "fragColour = textureLod(textureName, textureCoordinate, 0).rrrr / vec4(255.0);";
 		break;
 
+		// For the packed types, the fractional part of the texel position picks a pixel from within its byte.
+		case InputDataType::Luminance1Packed:
+			fragment_shader +=
+				"uint textureValue = textureLod(textureName, textureCoordinate, 0).r;"
+				"uint shift = 7u - uint(fract(textureCoordinate.x * float(textureSize(textureName, 0).x)) * 8.0);"
+				"fragColour = vec4(float((textureValue >> shift) & 1u));";
+		break;
+
+		case InputDataType::Luminance2Packed:
+			fragment_shader +=
+				"uint textureValue = textureLod(textureName, textureCoordinate, 0).r;"
+				"uint shift = (3u - uint(fract(textureCoordinate.x * float(textureSize(textureName, 0).x)) * 4.0)) * 2u;"
+				"fragColour = vec4(float((textureValue >> shift) & 3u) / 3.0);";
+		break;
+
 		case InputDataType::PhaseLinkedLuminance8:
 		case InputDataType::Luminance8Phase8:
 		case InputDataType::Red8Green8Blue8:
@@ -556,6 +683,17 @@ std::unique_ptr<Shader> ScanTarget::composition_shader() const {
 				"uvec2 textureValue = textureLod(textureName, textureCoordinate, 0).rg;"
 				"fragColour = vec4(float(textureValue.r) / 15.0, float(textureValue.g & 240u) / 240.0, float(textureValue.g & 15u) / 15.0, 1.0);";
 		break;
+
+		case InputDataType::Palette8:
+			fragment_shader += "fragColour = paletteColour(textureLod(textureName, textureCoordinate, 0).r);";
+		break;
+
+		case InputDataType::Palette4Packed:
+			fragment_shader +=
+				"uint textureValue = textureLod(textureName, textureCoordinate, 0).r;"
+				"uint shift = 4u - uint(fract(textureCoordinate.x * float(textureSize(textureName, 0).x)) * 2.0) * 4u;"
+				"fragColour = paletteColour((textureValue >> shift) & 15u);";
+		break;
 	}
 
 	return std::make_unique<Shader>(
@@ -9,7 +9,10 @@
 #ifndef Screenshot_h
 #define Screenshot_h
 
-#include "OpenGL.hpp"
+#include "FrameCapture.hpp"
+
+#include <cstring>
+#include <vector>
 
 namespace Outputs {
 namespace Display {
@@ -20,38 +23,29 @@ namespace OpenGL {
 	cropping to an image that matches the requested aspect ratio.
 
 	The image will then be available as RGBA data, in raster order via the struct members.
+
+	This blocks until the GPU has produced the image; use FrameCapture directly to capture
+	frames without stalling.
 */
 struct Screenshot {
 	Screenshot(int aspect_width, int aspect_height) {
-		// Get the current viewport to establish framebuffer size. Then determine how wide the
-		// centre portion of that would be, allowing for the requested aspect ratio.
-		GLint dimensions[4];
-		glGetIntegerv(GL_VIEWPORT, dimensions);
-
-		height = int(dimensions[3]);
-		width = (height * aspect_width) / aspect_height;
-		pixel_data.resize(size_t(width * height * 4));
-
-		// Grab the framebuffer contents, temporarily setting single-byte alignment.
-		int prior_alignment;
-		glGetIntegerv(GL_PACK_ALIGNMENT, &prior_alignment);
-		glReadPixels((dimensions[2] - GLint(width)) >> 1, 0, GLint(width), GLint(height), GL_RGBA, GL_UNSIGNED_BYTE, pixel_data.data());
-		glPixelStorei(GL_PACK_ALIGNMENT, prior_alignment);
-
-		// Flip the contents into raster order.
-		const size_t line_size = size_t(width * 4);
-		for(size_t y = 0; y < size_t(height) / 2; ++y) {
-			const size_t flipped_y = size_t(height - 1) - y;
-
-			uint8_t temp[line_size];
-			memcpy(temp, &pixel_data[flipped_y * line_size], line_size);
-			memcpy(&pixel_data[flipped_y * line_size], &pixel_data[y * line_size], line_size);
-			memcpy(&pixel_data[y * line_size], temp, line_size);
-		}
+		FrameCapture capture(1);
+		capture.capture(aspect_width, aspect_height);
+		capture.collect([this] (const FrameCapture::Frame &frame) {
+			width = frame.width;
+			height = frame.height;
+			pixel_data.resize(size_t(height) * frame.line_size);
+
+			// Flip the contents into raster order.
+			for(size_t y = 0; y < size_t(height); ++y) {
+				const size_t flipped_y = size_t(height - 1) - y;
+				memcpy(&pixel_data[y * frame.line_size], &frame.pixels[flipped_y * frame.line_size], frame.line_size);
+			}
+		}, true);
 	}
 
 	std::vector<uint8_t> pixel_data;
-	int width, height;
+	int width = 0, height = 0;
 };
 
 }
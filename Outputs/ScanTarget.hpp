@@ -66,6 +66,13 @@ enum class InputDataType {
 	Luminance1,				// 1 byte/pixel; any bit set => white; no bits set => black.
 	Luminance8,				// 1 byte/pixel; linear scale.
 
+	Luminance1Packed,		// 8 pixels/byte, most significant bit first; set => white; clear => black.
+	Luminance2Packed,		// 4 pixels/byte, most significant pair of bits first; linear scale from 0 to 3.
+							//
+							// For the packed types a sample is one byte: lengths passed to begin_data and
+							// output_data are in bytes, and pixels are spread over equal parts of the time
+							// allotted to their byte.
+
 	PhaseLinkedLuminance8,	// 4 bytes/pixel; each byte is an individual 8-bit luminance
 							// value and which value is output is a function of
 							// colour subcarrier phase — byte 0 defines the first quarter
@@ -91,6 +98,12 @@ enum class InputDataType {
 	Red4Green4Blue4,		// 2 bytes/pixel; low nibble in first byte is red, high nibble in second is green, low is blue.
 							// i.e. if it were a little endian word, 0xgb0r; or 0x0rgb big endian.
 	Red8Green8Blue8,		// 4 bytes/pixel; first is red, second is green, third is blue, fourth is vacant.
+
+	// The palette-indexed types are mapped through whichever palette was most recently supplied via
+	// ScanTarget::set_palette, and can then feed any pipeline that an RGB type can.
+
+	Palette8,				// 1 byte/pixel; an index into a palette of up to 256 entries.
+	Palette4Packed,			// 2 pixels/byte, most significant nibble first; each an index into a palette of up to 16 entries.
 };
 
 /// @returns the number of bytes per sample for data of type @c data_type.
@@ -99,8 +112,12 @@ constexpr inline size_t size_for_data_type(InputDataType data_type) {
 	switch(data_type) {
 		case InputDataType::Luminance1:
 		case InputDataType::Luminance8:
+		case InputDataType::Luminance1Packed:
+		case InputDataType::Luminance2Packed:
 		case InputDataType::Red1Green1Blue1:
 		case InputDataType::Red2Green2Blue2:
+		case InputDataType::Palette8:
+		case InputDataType::Palette4Packed:
 			return 1;
 
 		case InputDataType::Luminance8Phase8:
@@ -116,6 +133,16 @@ constexpr inline size_t size_for_data_type(InputDataType data_type) {
 	}
 }
 
+/// @returns the number of pixels packed into each sample of data of type @c data_type; 1 for all unpacked types.
+constexpr inline int pixels_per_sample(InputDataType data_type) {
+	switch(data_type) {
+		case InputDataType::Luminance1Packed:	return 8;
+		case InputDataType::Luminance2Packed:	return 4;
+		case InputDataType::Palette4Packed:		return 2;
+		default:								return 1;
+	}
+}
+
 /// @returns @c true if this data type presents normalised data, i.e. each byte holds a
 /// value in the range [0, 255] representing a real number in the range [0.0, 1.0]; @c false otherwise.
 constexpr inline size_t data_type_is_normalised(InputDataType data_type) {
@@ -128,13 +155,26 @@ constexpr inline size_t data_type_is_normalised(InputDataType data_type) {
 
 		default:
 		case InputDataType::Luminance1:
+		case InputDataType::Luminance1Packed:
+		case InputDataType::Luminance2Packed:
 		case InputDataType::Red1Green1Blue1:
 		case InputDataType::Red2Green2Blue2:
 		case InputDataType::Red4Green4Blue4:
+		case InputDataType::Palette8:
+		case InputDataType::Palette4Packed:
 			return false;
 	}
 }
 
+/// @returns The maximum number of entries in a palette for data of type @c data_type, or 0 if it isn't palette-indexed.
+constexpr inline size_t palette_size_for_data_type(InputDataType data_type) {
+	switch(data_type) {
+		case InputDataType::Palette8:		return 256;
+		case InputDataType::Palette4Packed:	return 16;
+		default:							return 0;
+	}
+}
+
 /// @returns The 'natural' display type for data of type @c data_type. The natural display is whichever would
 /// display it with the least number of conversions. Caveat: a colour display is assumed for pure-composite data types.
 constexpr inline DisplayType natural_display_type_for_data_type(InputDataType data_type) {
@@ -142,6 +182,8 @@ constexpr inline DisplayType natural_display_type_for_data_type(InputDataType da
 		default:
 		case InputDataType::Luminance1:
 		case InputDataType::Luminance8:
+		case InputDataType::Luminance1Packed:
+		case InputDataType::Luminance2Packed:
 		case InputDataType::PhaseLinkedLuminance8:
 			return DisplayType::CompositeColour;
 
@@ -149,6 +191,8 @@ constexpr inline DisplayType natural_display_type_for_data_type(InputDataType da
 		case InputDataType::Red2Green2Blue2:
 		case InputDataType::Red4Green4Blue4:
 		case InputDataType::Red8Green8Blue8:
+		case InputDataType::Palette8:
+		case InputDataType::Palette4Packed:
 			return DisplayType::RGB;
 
 		case InputDataType::Luminance8Phase8:
@@ -329,10 +373,24 @@ struct ScanTarget {
 		/// It is required that every call to begin_data be paired with a call to end_data.
 		virtual void end_data([[maybe_unused]] size_t actual_length) {}
 
+		/// Sets the palette for the palette-indexed input data types: @c count entries in Red8Green8Blue8 form, i.e.
+		/// four bytes apiece. The new palette applies to any data not yet completed via @c end_data, and to all data
+		/// that follows; data already completed retains whichever palette was then in effect.
+		virtual void set_palette([[maybe_unused]] const uint8_t *colours, [[maybe_unused]] size_t count) {}
+
 		/// Tells the scan target that its owner is about to change; this is a hint that existing
 		/// data and scan allocations should be invalidated.
 		virtual void will_change_owner() {}
 
+		/// @returns @c true if producers may call this scan target from a thread of their own, doing their
+		/// signal processing asynchronously to whatever drives them; @c false otherwise.
+		virtual bool allows_asynchronous_producers() const { return false; }
+
+		/// @returns The number of frames of which producers should output only the first, e.g. 4 to indicate that
+		/// three of every four frames should be skipped. Producers consult this once per frame; skipped frames pass
+		/// nothing to the scan target, and producers' requests to @c begin_data during them are declined.
+		virtual int frames_per_output() const { return 1; }
+
 		/// Acts as a fence, marking the end of an atomic set of [begin/end]_[scan/data] calls] — all future pieces of
 		/// data will have no relation to scans prior to the submit() and all future scans will similarly have no relation to
 		/// prior runs of data.
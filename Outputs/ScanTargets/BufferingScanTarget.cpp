@@ -18,6 +18,41 @@
 
 using namespace Outputs::Display;
 
+namespace {
+
+// Line hashes are FNV-1a, albeit over 64-bit words where possible.
+constexpr uint64_t HashSeed = 0xcbf29ce484222325;
+constexpr uint64_t HashPrime = 0x100000001b3;
+
+void fold(uint64_t &hash, const uint8_t *data, size_t length) {
+	while(length >= sizeof(uint64_t)) {
+		uint64_t word;
+		memcpy(&word, data, sizeof(word));
+		hash = (hash ^ word) * HashPrime;
+		data += sizeof(word);
+		length -= sizeof(word);
+	}
+	while(length--) {
+		hash = (hash ^ *data) * HashPrime;
+		++data;
+	}
+}
+
+void fold(uint64_t &hash, uint64_t value) {
+	hash = (hash ^ value) * HashPrime;
+}
+
+/// Folds the timing and colour phase of @c end_point, optionally omitting either. Absolute position
+/// is omitted; consumers compare that separately, with some tolerance. The data offset is omitted
+/// as it is meaningful only for scans.
+void fold(uint64_t &hash, const Outputs::Display::ScanTarget::Scan::EndPoint &end_point, bool include_timing, bool include_phase) {
+	fold(hash,
+		(include_timing ? (uint64_t(end_point.x) | (uint64_t(end_point.cycles_since_end_of_horizontal_retrace) << 16)) : 0) |
+		(include_phase ? (uint64_t(uint16_t(end_point.composite_angle)) << 32) : 0));
+}
+
+}
+
 BufferingScanTarget::BufferingScanTarget() {
 	// Ensure proper initialisation of the two atomic pointer sets.
 	read_pointers_.store(write_pointers_, std::memory_order::memory_order_relaxed);
@@ -44,6 +79,29 @@ uint8_t *BufferingScanTarget::begin_data(size_t required_length, size_t required
 		return nullptr;
 	}
 
+	// Scans of this data may refer to the palette, so ensure that it is available.
+	write_palette();
+	if(allocation_has_failed_) return nullptr;
+
+	const int address = allocate(required_length, required_alignment);
+	if(address < 0) {
+		allocation_has_failed_ = true;
+		return nullptr;
+	}
+
+	// Everything checks out, note expectation of a future end_data and return the pointer.
+	assert(!data_is_allocated_);
+	data_is_allocated_ = true;
+	vended_write_area_pointer_ = write_pointers_.write_area = address;
+
+	assert(write_pointers_.write_area >= 1 && ((size_t(write_pointers_.write_area) + required_length + 1) * data_type_size_) <= WriteAreaWidth*WriteAreaHeight*data_type_size_);
+	return &write_area_[size_t(write_pointers_.write_area) * data_type_size_];
+
+	// Note state at exit:
+	//		write_pointers_.write_area points to the first pixel the client is expected to draw to.
+}
+
+int BufferingScanTarget::allocate(size_t required_length, size_t required_alignment) {
 	// Determine where the proposed write area would start and end.
 	uint16_t output_y = TextureAddressGetY(write_pointers_.write_area);
 
@@ -73,20 +131,44 @@ uint8_t *BufferingScanTarget::begin_data(size_t required_length, size_t required
 	// If allocating this would somehow make the write pointer back away from the read pointer,
 	// there must not be enough space left.
 	if(end_distance < previous_distance) {
+		return -1;
+	}
+
+	return TextureAddress(aligned_start_x, output_y);
+}
+
+void BufferingScanTarget::write_palette() {
+	if(!data_type_is_indexed_ || !palette_length_) return;
+
+	// The palette can be overwritten only once the write pointer has lapped it, which requires the write pointer
+	// to advance across almost the whole write area while scans that refer to it remain unread. Scans therefore
+	// keep referring to the same copy only while it is within a quarter of the write area behind the write pointer.
+	constexpr int WriteAreaSize = WriteAreaWidth * WriteAreaHeight;
+	if(palette_is_written_ && TextureSub(write_pointers_.write_area, palette_write_area_) < WriteAreaSize / 4) return;
+
+	const int address = allocate(palette_length_, 1);
+	if(address < 0) {
 		allocation_has_failed_ = true;
-		return nullptr;
+		return;
 	}
 
-	// Everything checks out, note expectation of a future end_data and return the pointer.
-	assert(!data_is_allocated_);
-	data_is_allocated_ = true;
-	vended_write_area_pointer_ = write_pointers_.write_area = TextureAddress(aligned_start_x, output_y);
+	memcpy(&write_area_[size_t(address)], palette_.data(), palette_length_);
+	palette_write_area_ = address;
+	palette_is_written_ = true;
+	write_pointers_.write_area = (address + int(palette_length_) + 1) % WriteAreaSize;
+}
 
-	assert(write_pointers_.write_area >= 1 && ((size_t(write_pointers_.write_area) + required_length + 1) * data_type_size_) <= WriteAreaWidth*WriteAreaHeight*data_type_size_);
-	return &write_area_[size_t(write_pointers_.write_area) * data_type_size_];
+void BufferingScanTarget::set_palette(const uint8_t *colours, size_t count) {
+	std::lock_guard lock_guard(producer_mutex_);
 
-	// Note state at exit:
-	//		write_pointers_.write_area points to the first pixel the client is expected to draw to.
+	palette_length_ = std::min(count * 4, palette_.size());
+	memcpy(palette_.data(), colours, palette_length_);
+	palette_hash_ = HashSeed;
+	fold(palette_hash_, palette_.data(), palette_length_);
+
+	// The new palette will be written ahead of the scans of any data currently allocated, or
+	// otherwise ahead of the next allocation.
+	palette_is_written_ = false;
 }
 
 template <typename DataUnit> void BufferingScanTarget::end_data(size_t actual_length) {
@@ -120,6 +202,9 @@ void BufferingScanTarget::end_data(size_t actual_length) {
 		case 4:	end_data<uint32_t>(actual_length);	break;
 	}
 
+	// Include the new data in the line hash.
+	fold(line_hash_, &write_area_[size_t(write_pointers_.write_area) * data_type_size_], actual_length * data_type_size_);
+
 	// Advance to the end of the current run.
 	write_pointers_.write_area += actual_length + 1;
 
@@ -127,6 +212,11 @@ void BufferingScanTarget::end_data(size_t actual_length) {
 	// distance left on the current line, but there's a risk of exactly filling
 	// the final line, in which case this should wrap back to 0.
 	write_pointers_.write_area %= WriteAreaWidth*WriteAreaHeight;
+
+	// If the palette changed while this data was allocated, make the new one available to its scans.
+	if(!palette_is_written_) {
+		write_palette();
+	}
 }
 
 // MARK: - Producer; scans.
@@ -155,9 +245,8 @@ Outputs::Display::ScanTarget::Scan *BufferingScanTarget::begin_scan() {
 	write_pointers_.scan = next_write_pointer;
 	++provided_scans_;
 
-	// Fill in extra OpenGL-specific details.
-	result->line = write_pointers_.line;
-
+	// The scan buffer may be write-only memory, such as a persistent GPU mapping, so the
+	// producer is given a staging copy; end_scan completes that and writes it out in one go.
 	vended_scan_ = result;
 
 #ifndef NDEBUG
@@ -165,7 +254,7 @@ Outputs::Display::ScanTarget::Scan *BufferingScanTarget::begin_scan() {
 	scan_is_ongoing_ = true;
 #endif
 
-	return &result->scan;
+	return &staged_scan_.scan;
 }
 
 void BufferingScanTarget::end_scan() {
@@ -178,10 +267,28 @@ void BufferingScanTarget::end_scan() {
 
 	// Complete the scan only if one is afoot.
 	if(vended_scan_) {
-		vended_scan_->data_y = TextureAddressGetY(vended_write_area_pointer_);
-		vended_scan_->line = write_pointers_.line;
-		vended_scan_->scan.end_points[0].data_offset += TextureAddressGetX(vended_write_area_pointer_);
-		vended_scan_->scan.end_points[1].data_offset += TextureAddressGetX(vended_write_area_pointer_);
+		// Hash while data offsets are still relative to the allocation, so that repeated
+		// content hashes identically wherever it happens to lie in the write area.
+		fold(line_hash_, staged_scan_.scan.end_points[0], hashes_scan_extents_, hashes_phase_);
+		fold(line_hash_, staged_scan_.scan.end_points[1], hashes_scan_extents_, hashes_phase_);
+		fold(line_hash_,
+			(hashes_scan_extents_ ? (
+				uint64_t(staged_scan_.scan.end_points[0].data_offset) |
+				(uint64_t(staged_scan_.scan.end_points[1].data_offset) << 16)
+			) : 0) |
+			(uint64_t(staged_scan_.scan.composite_amplitude) << 32));
+
+		if(data_type_is_indexed_) {
+			fold(line_hash_, palette_hash_);
+		}
+
+		staged_scan_.data_y = TextureAddressGetY(vended_write_area_pointer_);
+		staged_scan_.palette_x = TextureAddressGetX(palette_write_area_);
+		staged_scan_.palette_y = TextureAddressGetY(palette_write_area_);
+		staged_scan_.line = write_pointers_.line;
+		staged_scan_.scan.end_points[0].data_offset += TextureAddressGetX(vended_write_area_pointer_);
+		staged_scan_.scan.end_points[1].data_offset += TextureAddressGetX(vended_write_area_pointer_);
+		*vended_scan_ = staged_scan_;
 		vended_scan_ = nullptr;
 	}
 }
@@ -202,6 +309,9 @@ void BufferingScanTarget::announce(Event event, bool is_visible, const Outputs::
 		is_first_in_frame_ = true;
 		previous_frame_was_complete_ = frame_is_complete_;
 		frame_is_complete_ = true;
+
+		frames_.fetch_add(1, std::memory_order_relaxed);
+		if(!previous_frame_was_complete_) incomplete_frames_.fetch_add(1, std::memory_order_relaxed);
 	}
 
 	// Proceed from here only if a change in visibility has occurred.
@@ -228,7 +338,19 @@ void BufferingScanTarget::announce(Event event, bool is_visible, const Outputs::
 			active_line.line = write_pointers_.line;
 			active_line.composite_amplitude = composite_amplitude;
 
+			LineMetadata &metadata = line_metadata_buffer_[size_t(write_pointers_.line)];
+			metadata.end_points[0].x = location.x;
+			metadata.end_points[0].y = location.y;
+
 			provided_scans_ = 0;
+
+			// The first line of a frame begins wherever vertical retrace happens to end, which
+			// the vertical flywheel doesn't fix exactly; its scans are therefore hashed without
+			// their horizontal extents, lest it never repeat.
+			line_hash_ = HashSeed;
+			hashes_scan_extents_ = !is_first_in_frame_;
+			fold(line_hash_, location, false, hashes_phase_);
+			fold(line_hash_, composite_amplitude);
 		}
 	} else {
 		// Commit the most recent line only if any scans fell on it and all allocation was successful.
@@ -240,8 +362,13 @@ void BufferingScanTarget::announce(Event event, bool is_visible, const Outputs::
 			metadata.is_first_in_frame = is_first_in_frame_;
 			metadata.previous_frame_was_complete = previous_frame_was_complete_;
 			metadata.first_scan = submit_pointers.scan;
+			metadata.end_points[1].x = location.x;
+			metadata.end_points[1].y = location.y;
 			is_first_in_frame_ = false;
 
+			fold(line_hash_, location, false, hashes_phase_);
+			metadata.hash = line_hash_;
+
 			// Sanity check.
 			assert(((metadata.first_scan + size_t(provided_scans_)) % scan_buffer_size_) == write_pointers_.scan);
 
@@ -263,6 +390,9 @@ void BufferingScanTarget::announce(Event event, bool is_visible, const Outputs::
 			// were before this line. Mark frame as incomplete if this was an allocation failure.
 			write_pointers_ = submit_pointers_.load(std::memory_order::memory_order_relaxed);
 			frame_is_complete_ &= !allocation_has_failed_;
+
+			// Any palette written on this line has been discarded along with everything else.
+			palette_is_written_ = false;
 		}
 
 		// Don't permit anything to be allocated on invisible areas.
@@ -290,9 +420,18 @@ void BufferingScanTarget::set_write_area(uint8_t *base) {
 	write_area_ = base;
 	write_pointers_ = submit_pointers_ = read_pointers_ = PointerSet();
 	allocation_has_failed_ = true;
+	palette_is_written_ = false;
 	vended_scan_ = nullptr;
 }
 
+size_t BufferingScanTarget::get_memory_footprint() {
+	std::lock_guard lock_guard(producer_mutex_);
+	return
+		scan_buffer_size_ * sizeof(Scan) +
+		line_buffer_size_ * (sizeof(Line) + sizeof(LineMetadata)) +
+		(write_area_ ? size_t(WriteAreaWidth * WriteAreaHeight) * data_type_size_ : 0);
+}
+
 size_t BufferingScanTarget::write_area_data_size() const {
 	// TODO: can I guarantee this is safe without requiring that set_write_area
 	// be within an @c perform block?
@@ -303,6 +442,11 @@ void BufferingScanTarget::set_modals(Modals modals) {
 	perform([=] {
 		modals_ = modals;
 		modals_are_dirty_ = true;
+		++modals_generation_;
+
+		// The colour subcarrier usually isn't locked to the line rate, so RGB output would
+		// never repeat if its phase were included in line hashes.
+		hashes_phase_ = modals.display_type != DisplayType::RGB;
 	});
 }
 
@@ -385,6 +529,8 @@ const Outputs::Display::ScanTarget::Modals *BufferingScanTarget::new_modals() {
 	std::lock_guard lock_guard(producer_mutex_);
 	data_type_size_ = Outputs::Display::size_for_data_type(modals_.input_data_type);
 	assert((data_type_size_ == 1) || (data_type_size_ == 2) || (data_type_size_ == 4));
+	data_type_is_indexed_ = Outputs::Display::palette_size_for_data_type(modals_.input_data_type);
+	palette_is_written_ = false;
 
 	return &modals_;
 }
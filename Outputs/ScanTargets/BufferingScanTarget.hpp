@@ -12,6 +12,7 @@
 #include "../ScanTarget.hpp"
 #include "../DisplayMetrics.hpp"
 
+#include <algorithm>
 #include <array>
 #include <atomic>
 #include <functional>
@@ -62,6 +63,9 @@ class BufferingScanTarget: public Outputs::Display::ScanTarget {
 			/// Use this plus this scan's endpoints' x locations to determine where to composite
 			/// this data for intermediate processing.
 			uint16_t line;
+			/// For the palette-indexed data types, stores the location within the write area of this scan's
+			/// palette: its entries are in Red8Green8Blue8 form, each occupying four consecutive samples.
+			uint16_t palette_x, palette_y;
 		};
 
 		/// Defines the boundaries of a complete line of video — a 2d start and end location,
@@ -90,6 +94,16 @@ class BufferingScanTarget: public Outputs::Display::ScanTarget {
 			bool previous_frame_was_complete;
 			/// The index of the first scan that will appear on this line.
 			size_t first_scan;
+			/// A hash of this line's scans and pixel data; two lines with the same hash and the same
+			/// end points can be assumed to produce the same output, allowing consumers to detect
+			/// repetition. The line's end points are excluded so that consumers can tolerate the
+			/// small amount of jitter that the CRT's flywheels introduce.
+			uint64_t hash;
+			/// The positions of this line's end points, duplicated from the line buffer so that
+			/// consumers can compare them without reading from buffer memory that may be write-only.
+			struct EndPoint {
+				uint16_t x, y;
+			} end_points[2];
 		};
 
 		/// Sets the area of memory to use as a scan buffer.
@@ -158,16 +172,77 @@ class BufferingScanTarget: public Outputs::Display::ScanTarget {
 		///		The caller must be within a @c perform block.
 		const Modals *new_modals();
 
+		/// @returns @c true if there are new Modals that haven't yet been collected via new_modals().
+		///		The caller must be within a @c perform block.
+		bool has_new_modals() const {
+			return modals_are_dirty_;
+		}
+
+		/// @returns A count of calls to set_modals, so that anything derived from a particular set of
+		///		Modals can be identified. The caller must be within a @c perform block.
+		uint64_t modals_generation() const {
+			return modals_generation_;
+		}
+
 		/// @returns the current @c Modals.
 		const Modals &modals() const;
 
+		/// Sets whether producers may do their signal processing on a thread of their own; this takes
+		/// effect as this scan target is next supplied to each producer. Off by default.
+		void set_allows_asynchronous_producers(bool allows) {
+			allows_asynchronous_producers_ = allows;
+		}
+
+		/// Sets the number of frames of which producers should output only the first, e.g. while fast-forwarding;
+		/// this may be changed at any time and takes effect from each producer's next frame. 1 by default.
+		void set_frames_per_output(int frames) {
+			frames_per_output_.store(std::max(frames, 1), std::memory_order_relaxed);
+		}
+
+		/// @returns The number of frames begun since construction.
+		size_t frames() const {
+			return frames_.load(std::memory_order_relaxed);
+		}
+
+		/// @returns The number of frames from which data was dropped because the consumer fell behind.
+		size_t incomplete_frames() const {
+			return incomplete_frames_.load(std::memory_order_relaxed);
+		}
+
+		/// @returns The number of bytes occupied by the scan, line and write-area buffers currently in use.
+		/// Subclasses that allocate further storage, e.g. textures, include that too.
+		virtual size_t get_memory_footprint();
+
+	protected:
+		/// @returns Line @c index within the buffer supplied to @c set_line_buffer.
+		const Line &line(size_t index) const {
+			return line_buffer_[index];
+		}
+
+		/// @returns The metadata for line @c index within the buffer supplied to @c set_line_buffer.
+		const LineMetadata &line_metadata(size_t index) const {
+			return line_metadata_buffer_[index];
+		}
+
+		/// @returns The number of lines in the buffer supplied to @c set_line_buffer.
+		size_t line_buffer_size() const {
+			return line_buffer_size_;
+		}
+
 	private:
 		// ScanTarget overrides.
 		void set_modals(Modals) final;
+		bool allows_asynchronous_producers() const final {
+			return allows_asynchronous_producers_;
+		}
+		int frames_per_output() const final {
+			return frames_per_output_.load(std::memory_order_relaxed);
+		}
 		Outputs::Display::ScanTarget::Scan *begin_scan() final;
 		void end_scan() final;
 		uint8_t *begin_data(size_t required_length, size_t required_alignment) final;
 		void end_data(size_t actual_length) final;
+		void set_palette(const uint8_t *colours, size_t count) final;
 		void announce(Event event, bool is_visible, const Outputs::Display::ScanTarget::Scan::EndPoint &location, uint8_t colour_burst_amplitude) final;
 		void will_change_owner() final;
 
@@ -175,24 +250,55 @@ class BufferingScanTarget: public Outputs::Display::ScanTarget {
 		uint8_t *write_area_ = nullptr;
 		size_t data_type_size_ = 0;
 
+		// The palette most recently supplied for the palette-indexed data types is copied into the write area,
+		// where scans can refer to it. It is written again whenever it changes, after any failed line, and
+		// once it falls so far behind the write pointer as to be at risk of being overwritten.
+		std::array<uint8_t, 1024> palette_{};
+		size_t palette_length_ = 0;
+		bool data_type_is_indexed_ = false;
+		bool palette_is_written_ = false;
+		int palette_write_area_ = 0;
+		uint64_t palette_hash_ = 0;
+
+		/// @returns The address at which @c required_length samples can be written, suitably aligned and after
+		/// a guard sample, or -1 if there isn't space. The caller must hold the producer lock.
+		int allocate(size_t required_length, size_t required_alignment);
+
+		/// Ensures that the current palette is in the write area if an indexed data type is in use, marking
+		/// allocation as failed if there isn't space. The caller must hold the producer lock.
+		void write_palette();
+
 		// Tracks changes in raster visibility in order to populate
 		// Lines and LineMetadatas.
 		bool output_is_visible_ = false;
 
+		// Set by the host; see set_allows_asynchronous_producers.
+		bool allows_asynchronous_producers_ = false;
+
+		// Set by the host; see set_frames_per_output.
+		std::atomic<int> frames_per_output_ = 1;
+
 		// Track allocation failures.
 		bool data_is_allocated_ = false;
 		bool allocation_has_failed_ = false;
 
 		// Ephemeral information for the begin/end functions.
 		Scan *vended_scan_ = nullptr;
+		Scan staged_scan_{};
 		int vended_write_area_pointer_ = 0;
 
 		// Ephemeral state that helps in line composition.
 		int provided_scans_ = 0;
+		uint64_t line_hash_ = 0;
+		bool hashes_phase_ = true;
+		bool hashes_scan_extents_ = true;
 		bool is_first_in_frame_ = true;
 		bool frame_is_complete_ = true;
 		bool previous_frame_was_complete_ = true;
 
+		// Statistics, for the benefit of hosts.
+		std::atomic<size_t> frames_ = 0, incomplete_frames_ = 0;
+
 		// By convention everything in the PointerSet points to the next instance
 		// of whatever it is that will be used. So a client should start with whatever
 		// is pointed to by the read pointers and carry until it gets to a value that
@@ -254,6 +360,7 @@ class BufferingScanTarget: public Outputs::Display::ScanTarget {
 		// from a call to @c get_new_modals.
 		Modals modals_;
 		bool modals_are_dirty_ = false;
+		uint64_t modals_generation_ = 0;
 
 		// Provides a per-data size implementation of end_data; a previous
 		// implementation used blind memcpy and that turned into something
@@ -0,0 +1,75 @@
+//
+//  DiscardingScanTarget.cpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 14/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#include "DiscardingScanTarget.hpp"
+
+using namespace Outputs::Display;
+
+// MARK: - DiscardingScanTarget.
+
+void DiscardingScanTarget::set_modals(Modals modals) {
+	data_type_size_ = size_for_data_type(modals.input_data_type);
+	if(!data_type_size_) data_type_size_ = 1;
+}
+
+ScanTarget::Scan *DiscardingScanTarget::begin_scan() {
+	return &scan_;
+}
+
+uint8_t *DiscardingScanTarget::begin_data(size_t required_length, size_t required_alignment) {
+	// Allow for the requested alignment, in samples, plus a sample of slack either side.
+	const size_t alignment = required_alignment * data_type_size_;
+	const size_t size = (required_length + 2) * data_type_size_ + alignment;
+	if(scratch_.size() < size) {
+		scratch_.resize(size);
+	}
+
+	const auto base = reinterpret_cast<uintptr_t>(scratch_.data()) + data_type_size_;
+	const auto aligned = alignment > 1 ? (base + alignment - 1) / alignment * alignment : base;
+	last_data_ = reinterpret_cast<uint8_t *>(aligned);
+	return last_data_;
+}
+
+// MARK: - HashingScanTarget.
+
+void HashingScanTarget::end_scan() {
+	for(const auto &end_point: scan_.end_points) {
+		fold(end_point.x);
+		fold(end_point.y);
+		fold(end_point.data_offset);
+		fold(end_point.composite_angle);
+	}
+	fold(scan_.composite_amplitude);
+}
+
+void HashingScanTarget::end_data(size_t actual_length) {
+	if(last_data()) {
+		fold(last_data(), actual_length * data_type_size());
+	}
+}
+
+void HashingScanTarget::set_palette(const uint8_t *colours, size_t count) {
+	fold(colours, count * 4);
+}
+
+void HashingScanTarget::announce(Event event, bool, const Scan::EndPoint &, uint8_t) {
+	if(event != Event::BeginVerticalRetrace) return;
+
+	last_frame_hash_ = hash_;
+	hash_ = hash_seed;
+	++frame_count_;
+	if(delegate_) {
+		delegate_->scan_target_did_complete_frame(this, last_frame_hash_);
+	}
+}
+
+void HashingScanTarget::fold(const uint8_t *data, size_t length) {
+	for(size_t c = 0; c < length; c++) {
+		hash_ = (hash_ ^ data[c]) * hash_prime;
+	}
+}
@@ -0,0 +1,103 @@
+//
+//  DiscardingScanTarget.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 14/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#ifndef DiscardingScanTarget_hpp
+#define DiscardingScanTarget_hpp
+
+#include "../ScanTarget.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace Outputs {
+namespace Display {
+
+/*!
+	Accepts all scans and pixel data, then discards them.
+
+	Unlike the NullScanTarget, which refuses all allocations, this hands out a reusable
+	scratch buffer and scan so that producers do exactly the same amount of work as they
+	would with a real target; it is therefore suited to headless benchmarking.
+*/
+class DiscardingScanTarget: public ScanTarget {
+	public:
+		void set_modals(Modals) override;
+		Scan *begin_scan() override;
+		uint8_t *begin_data(size_t required_length, size_t required_alignment) override;
+
+	protected:
+		/// @returns The number of bytes per pixel implied by the most recent modals.
+		size_t data_type_size() const {
+			return data_type_size_;
+		}
+
+		/// @returns The area most recently vended by begin_data, or @c nullptr if none.
+		const uint8_t *last_data() const {
+			return last_data_;
+		}
+
+		Scan scan_;
+
+	private:
+		std::vector<uint8_t> scratch_;
+		uint8_t *last_data_ = nullptr;
+		size_t data_type_size_ = 1;
+};
+
+/*!
+	Acts as a DiscardingScanTarget but folds all pixel data, and the end points of all
+	scans, into a running hash. The hash is completed and restarted at the beginning of each
+	vertical retrace, giving a per-frame fingerprint that can be used to detect divergence
+	between runs without rasterising anything.
+*/
+class HashingScanTarget: public DiscardingScanTarget {
+	public:
+		struct Delegate {
+			virtual void scan_target_did_complete_frame(HashingScanTarget *, uint64_t hash) = 0;
+		};
+		void set_delegate(Delegate *delegate) {
+			delegate_ = delegate;
+		}
+
+		/// @returns The hash of the most-recently completed frame.
+		uint64_t last_frame_hash() const {
+			return last_frame_hash_;
+		}
+
+		/// @returns The number of frames completed so far.
+		size_t frame_count() const {
+			return frame_count_;
+		}
+
+		void end_scan() override;
+		void end_data(size_t actual_length) override;
+		void set_palette(const uint8_t *colours, size_t count) override;
+		void announce(Event event, bool is_visible, const Scan::EndPoint &location, uint8_t composite_amplitude) override;
+
+	private:
+		// FNV-1a.
+		static constexpr uint64_t hash_seed = 0xcbf29ce484222325;
+		static constexpr uint64_t hash_prime = 0x100000001b3;
+
+		uint64_t hash_ = hash_seed;
+		uint64_t last_frame_hash_ = hash_seed;
+		size_t frame_count_ = 0;
+		Delegate *delegate_ = nullptr;
+
+		void fold(const uint8_t *data, size_t length);
+		template <typename IntT> void fold(IntT value) {
+			for(size_t c = 0; c < sizeof(IntT); c++) {
+				hash_ = (hash_ ^ uint8_t(value >> (c * 8))) * hash_prime;
+			}
+		}
+};
+
+}
+}
+
+#endif /* DiscardingScanTarget_hpp */
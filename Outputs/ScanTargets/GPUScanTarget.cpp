@@ -0,0 +1,158 @@
+//
+//  GPUScanTarget.cpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 14/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#include "GPUScanTarget.hpp"
+
+#include "../HostProfiler.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+
+using namespace Outputs::Display;
+
+void GPUScanTarget::update(int output_width, int output_height) {
+	HOST_PROFILER_ZONE("Scan target submission");
+
+	// If the GPU is still busy, don't wait; we'll catch it next time.
+	if(!submission_is_complete()) {
+		display_metrics_.announce_draw_status(
+			lines_submitted_,
+			std::chrono::high_resolution_clock::now() - line_submission_begin_time_,
+			false);
+		return;
+	}
+
+	// If the GPU was reading directly from the scan and line buffers then only now is
+	// it safe to release the area it was drawing.
+	if(has_pending_output_area_) {
+		complete_output_area(pending_output_area_);
+		has_pending_output_area_ = false;
+	}
+
+	// Update the display metrics.
+	display_metrics_.announce_draw_status(
+		lines_submitted_,
+		std::chrono::high_resolution_clock::now() - line_submission_begin_time_,
+		true);
+
+	// Grab the new output list.
+	perform([=] {
+		const OutputArea area = get_output_area();
+		const bool modals_did_change = bool(new_modals());
+		const size_t line_buffer_size = this->line_buffer_size();
+
+		// Anything that would alter how existing input is drawn means it can't be skipped.
+		if(modals_did_change || output_width != last_output_width_ || output_height != last_output_height_) {
+			last_output_width_ = output_width;
+			last_output_height_ = output_height;
+			invalidate_output();
+
+			const auto &scale = modals().output_scale;
+			horizontal_tolerance_ = int(scale.x) / std::max(2 * output_width, 1);
+			vertical_tolerance_ = int(scale.y) / std::max(2 * output_height, 1);
+		}
+
+		// If this area just repeats what's already on display, return it without drawing anything.
+		output_is_unchanged_ = area_repeats(area);
+		if(output_is_unchanged_) {
+			lines_submitted_ = 0;
+			complete_output_area(area);
+			return;
+		}
+
+		// Determine the start time of this submission group and the number of lines it will contain.
+		line_submission_begin_time_ = std::chrono::high_resolution_clock::now();
+		lines_submitted_ = (area.end.line - area.start.line + line_buffer_size) % line_buffer_size;
+
+		begin_submission(area, modals_did_change, output_width, output_height);
+
+		// Divide lines by which frame they're in.
+		size_t new_lines = lines_submitted_;
+		size_t start_line = area.start.line;
+		while(new_lines) {
+			size_t end_line = (start_line + 1) % line_buffer_size;
+
+			// Find the limit of lines to draw in this batch.
+			size_t lines = 1;
+			while(end_line != area.end.line && !line_metadata(end_line).is_first_in_frame) {
+				end_line = (end_line + 1) % line_buffer_size;
+				++lines;
+			}
+
+			submit_lines(start_line, lines);
+
+			start_line = end_line;
+			new_lines -= lines;
+		}
+
+		end_submission(area);
+
+		if(reads_buffers_in_place()) {
+			pending_output_area_ = area;
+			has_pending_output_area_ = true;
+		} else {
+			complete_output_area(area);
+		}
+	});
+}
+
+bool GPUScanTarget::area_repeats(const OutputArea &area) {
+	const size_t line_buffer_size = this->line_buffer_size();
+	if(area.start.line == area.end.line) return false;
+
+	const auto is_near = [](uint16_t lhs, uint16_t rhs, int tolerance) {
+		return std::abs(int(lhs) - int(rhs)) <= tolerance;
+	};
+
+	// Compare every line to whatever was at the same position in the previous frame, noting
+	// the new records as they go in order to keep positions in step regardless of outcome.
+	// End points are retained from the first frame of a run, so that slow drift can't
+	// accumulate undetected.
+	bool repeats = true;
+	for(size_t index = area.start.line; index != area.end.line; index = (index + 1) % line_buffer_size) {
+		const auto &metadata = line_metadata(index);
+		if(metadata.is_first_in_frame) {
+			line_in_frame_ = 0;
+		}
+		if(line_in_frame_ >= line_records_.size()) {
+			line_records_.resize(line_in_frame_ + 1);
+		}
+
+		auto &record = line_records_[line_in_frame_];
+		// The first line of a frame begins wherever vertical retrace happens to end, which isn't
+		// exact; since that's at the very top of the display, its start isn't compared.
+		bool line_repeats = record.hash == metadata.hash;
+		for(int c = 0; c < 2; c++) {
+			line_repeats &=
+				((!c && metadata.is_first_in_frame) || is_near(record.x[c], metadata.end_points[c].x, horizontal_tolerance_)) &&
+				is_near(record.y[c], metadata.end_points[c].y, vertical_tolerance_);
+		}
+
+		if(line_repeats) {
+			record.repeats = uint8_t(std::min(record.repeats + 1, int(StableFrames)));
+		} else {
+			record.hash = metadata.hash;
+			for(int c = 0; c < 2; c++) {
+				record.x[c] = metadata.end_points[c].x;
+				record.y[c] = metadata.end_points[c].y;
+			}
+			record.repeats = 0;
+		}
+		repeats &= record.repeats == StableFrames;
+
+		++line_in_frame_;
+	}
+
+	return repeats;
+}
+
+void GPUScanTarget::invalidate_output() {
+	for(auto &record: line_records_) {
+		record.repeats = 0;
+	}
+}
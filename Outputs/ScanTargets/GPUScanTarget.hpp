@@ -0,0 +1,128 @@
+//
+//  GPUScanTarget.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 14/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#ifndef GPUScanTarget_hpp
+#define GPUScanTarget_hpp
+
+#include "BufferingScanTarget.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Outputs {
+namespace Display {
+
+/*!
+	Provides the API-neutral part of consuming a BufferingScanTarget on a GPU: pacing
+	submissions against the GPU's progress, reporting draw status to the display metrics,
+	dividing new lines into per-frame batches and returning buffer space to the producer
+	once it is safe to do so.
+
+	Subclasses supply the graphics-API-specific work by implementing the submission hooks,
+	all of which are called from within a @c perform block.
+
+	Output that exactly repeats what was drawn for the same lines of the previous frame is not
+	submitted at all, once it has repeated for long enough that any persistence effects will
+	have settled; whatever was previously drawn is left in place.
+*/
+class GPUScanTarget: public BufferingScanTarget {
+	public:
+		/*!
+			Processes all the latest input, at a resolution suitable for later output to
+			a framebuffer of the specified size.
+
+			If the GPU has not yet completed the previous submission then this returns
+			immediately, without blocking.
+		*/
+		void update(int output_width, int output_height);
+
+		/*!
+			@returns @c true if the most recent call to update found only output that repeats
+				what has already been drawn, and therefore submitted nothing; @c false otherwise.
+		*/
+		bool output_is_unchanged() const {
+			return output_is_unchanged_;
+		}
+
+	protected:
+		/*!
+			@returns @c true if the GPU has finished with the most recent submission;
+				@c false if it is still in progress. This should not block.
+		*/
+		virtual bool submission_is_complete() = 0;
+
+		/*!
+			@returns @c true if the GPU reads scans and lines directly from the buffers supplied
+				to set_scan_buffer and set_line_buffer, in which case each output area is returned
+				to the producer only once submission_is_complete indicates that the GPU is done with it;
+				@c false if they are copied during submission.
+		*/
+		virtual bool reads_buffers_in_place() const = 0;
+
+		/*!
+			Begins a submission of @c area, which should include composition of all of its scans.
+
+			@param modals_did_change @c true if modals have changed since the previous submission.
+		*/
+		virtual void begin_submission(const OutputArea &area, bool modals_did_change, int output_width, int output_height) = 0;
+
+		/*!
+			Outputs the @c count lines starting from @c first, wrapping around the line buffer if necessary.
+			Only the first line of each batch can be the first in a frame.
+		*/
+		virtual void submit_lines(size_t first, size_t count) = 0;
+
+		/*!
+			Completes the submission of @c area.
+		*/
+		virtual void end_submission(const OutputArea &area) = 0;
+
+		/*!
+			Indicates that the output would change even if the input doesn't, e.g. because the
+			subclass has altered its processing, so repeated input should not be skipped.
+			Should be called from within a @c perform block.
+		*/
+		void invalidate_output();
+
+	private:
+		size_t lines_submitted_ = 0;
+		std::chrono::high_resolution_clock::time_point line_submission_begin_time_;
+
+		OutputArea pending_output_area_;
+		bool has_pending_output_area_ = false;
+
+		// Change detection: the hash and end points most recently seen for each line of the
+		// frame, by position within the frame, and the number of consecutive frames for which
+		// they have repeated.
+		//
+		// StableFrames is chosen so that a change blended in at 64% opacity per frame, as
+		// per the OpenGL ScanTarget, will have converged to within an 8-bit quantum.
+		//
+		// End points are compared to within half an output pixel, to absorb the jitter
+		// of the CRT's flywheels, which hunt slightly even when locked.
+		static constexpr uint8_t StableFrames = 8;
+		struct LineRecord {
+			uint64_t hash = 0;
+			uint16_t x[2]{}, y[2]{};
+			uint8_t repeats = 0;
+		};
+		std::vector<LineRecord> line_records_;
+		int horizontal_tolerance_ = 0, vertical_tolerance_ = 0;
+		size_t line_in_frame_ = 0;
+		int last_output_width_ = 0, last_output_height_ = 0;
+		bool output_is_unchanged_ = false;
+
+		bool area_repeats(const OutputArea &area);
+};
+
+}
+}
+
+#endif /* GPUScanTarget_hpp */
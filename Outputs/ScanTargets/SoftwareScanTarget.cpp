@@ -0,0 +1,624 @@
+//
+//  SoftwareScanTarget.cpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 14/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#include "SoftwareScanTarget.hpp"
+
+#include "../../Concurrency/ThreadPool.hpp"
+#include "../HostProfiler.hpp"
+
+// Use SSE2 or NEON if available; each is guaranteed to be present on
+// 64-bit x86 and ARM respectively.
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define USE_SSE2
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define USE_NEON
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+using namespace Outputs::Display;
+
+namespace {
+
+constexpr float Pi = 3.141592654f;
+
+/*!
+	Converts @c count pixels from the planar channels @c a, @c b and @c c to packed RGBA,
+	applying the row-major 3x3 matrix @c m, which should map to the range [0, 255].
+*/
+void convert(const float *a, const float *b, const float *c, const float *m, size_t count, uint32_t *target) {
+	size_t index = 0;
+
+#if defined(USE_SSE2)
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 limit = _mm_set1_ps(255.0f);
+	const __m128 half = _mm_set1_ps(0.5f);
+	const __m128i alpha = _mm_set1_epi32(int(0xff000000));
+
+	const auto channel = [&](const __m128 &first, const __m128 &second, const __m128 &third, const float *row) {
+		const __m128 value = _mm_add_ps(
+			_mm_add_ps(_mm_mul_ps(first, _mm_set1_ps(row[0])), _mm_mul_ps(second, _mm_set1_ps(row[1]))),
+			_mm_mul_ps(third, _mm_set1_ps(row[2])));
+
+		// Order of operands is significant here: _mm_max_ps returns its second operand if either is
+		// a NaN, so a malformed input will be output as black.
+		return _mm_cvttps_epi32(_mm_add_ps(_mm_min_ps(_mm_max_ps(value, zero), limit), half));
+	};
+
+	for(; index + 4 <= count; index += 4) {
+		const __m128 va = _mm_loadu_ps(&a[index]);
+		const __m128 vb = _mm_loadu_ps(&b[index]);
+		const __m128 vc = _mm_loadu_ps(&c[index]);
+
+		const __m128i red = channel(va, vb, vc, &m[0]);
+		const __m128i green = channel(va, vb, vc, &m[3]);
+		const __m128i blue = channel(va, vb, vc, &m[6]);
+
+		const __m128i pixels = _mm_or_si128(
+			_mm_or_si128(red, _mm_slli_epi32(green, 8)),
+			_mm_or_si128(_mm_slli_epi32(blue, 16), alpha));
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(&target[index]), pixels);
+	}
+#elif defined(USE_NEON)
+	const float32x4_t zero = vdupq_n_f32(0.0f);
+	const float32x4_t limit = vdupq_n_f32(255.0f);
+	const float32x4_t half = vdupq_n_f32(0.5f);
+	const uint32x4_t alpha = vdupq_n_u32(0xff000000);
+
+	const auto channel = [&](const float32x4_t &first, const float32x4_t &second, const float32x4_t &third, const float *row) {
+		const float32x4_t value = vmlaq_n_f32(vmlaq_n_f32(vmulq_n_f32(first, row[0]), second, row[1]), third, row[2]);
+		return vcvtq_u32_f32(vaddq_f32(vminq_f32(vmaxq_f32(value, zero), limit), half));
+	};
+
+	for(; index + 4 <= count; index += 4) {
+		const float32x4_t va = vld1q_f32(&a[index]);
+		const float32x4_t vb = vld1q_f32(&b[index]);
+		const float32x4_t vc = vld1q_f32(&c[index]);
+
+		const uint32x4_t red = channel(va, vb, vc, &m[0]);
+		const uint32x4_t green = channel(va, vb, vc, &m[3]);
+		const uint32x4_t blue = channel(va, vb, vc, &m[6]);
+
+		const uint32x4_t pixels = vorrq_u32(
+			vorrq_u32(red, vshlq_n_u32(green, 8)),
+			vorrq_u32(vshlq_n_u32(blue, 16), alpha));
+		vst1q_u32(&target[index], pixels);
+	}
+#endif
+
+	for(; index < count; ++index) {
+		const auto channel = [&](const float *row) {
+			const float value = a[index] * row[0] + b[index] * row[1] + c[index] * row[2];
+			return value > 0.0f ? uint32_t(std::min(value, 255.0f) + 0.5f) : 0;
+		};
+		target[index] = channel(&m[0]) | (channel(&m[3]) << 8) | (channel(&m[6]) << 16) | 0xff000000;
+	}
+}
+
+}
+
+SoftwareScanTarget::SoftwareScanTarget(size_t output_width, size_t output_height, float output_gamma) :
+	write_area_(arena_),
+	width_(output_width), height_(output_height),
+	requested_width_(output_width), requested_height_(output_height),
+	output_gamma_(output_gamma) {
+	set_scan_buffer(scan_buffer_.data(), scan_buffer_.size());
+	set_line_buffer(line_buffer_.data(), line_metadata_buffer_.data(), line_buffer_.size());
+	resize_framebuffer();
+}
+
+void SoftwareScanTarget::set_output_size(size_t output_width, size_t output_height) {
+	perform([=] {
+		requested_width_ = output_width;
+		requested_height_ = output_height;
+	});
+}
+
+void SoftwareScanTarget::resize_framebuffer() {
+	width_ = requested_width_;
+	height_ = requested_height_;
+	framebuffer_.assign(width_ * height_, 0xff000000);
+	row_was_painted_.assign(height_, 0);
+}
+
+// MARK: - Setup.
+
+void SoftwareScanTarget::setup_conversion() {
+	const auto modals = BufferingScanTarget::modals();
+
+	// Resize the write area only if required.
+	const size_t required_size = WriteAreaWidth*WriteAreaHeight*Outputs::Display::size_for_data_type(modals.input_data_type);
+	if(required_size != write_area_.size()) {
+		write_area_.resize(required_size);
+		set_write_area(write_area_.data());
+	}
+
+	// Map to the framebuffer as per the OpenGL ScanTarget, including its slight over-amping of row height.
+	scale_x_ = float(modals.output_scale.x);
+	scale_y_ = float(modals.output_scale.y) * modals.aspect_ratio * (3.0f / 4.0f);
+	row_height_ = 1.05f / float(modals.expected_vertical_lines);
+
+	// Chrominance is always sampled at quarter-colour-cycle intervals. Luminance is too for composite
+	// colour, as the average is what separates it from chrominance; otherwise it's sampled across the
+	// width of a pixel.
+	const float clocks_per_angle = float(modals.cycles_per_line) * float(modals.colour_cycle_denominator) / float(modals.colour_cycle_numerator);
+	const float one_pixel_width = float(modals.cycles_per_line) * modals.visible_area.size.width / float(width_);
+	for(int c = 0; c < 4; ++c) {
+		chrominance_offsets_[c] = ((float(c) - 1.5f) / 4.0f) * clocks_per_angle;
+		if(modals.display_type == DisplayType::CompositeColour) {
+			luminance_offsets_[c] = chrominance_offsets_[c];
+		} else {
+			luminance_offsets_[c] = ((one_pixel_width * float(c)) / 3.0f) - (one_pixel_width * 0.5f);
+		}
+	}
+	const float weights[] = {0.15f, 0.35f, 0.35f, 0.15f};
+	std::copy(std::begin(weights), std::end(weights), std::begin(luminance_weights_));
+	margin_ = int(std::ceil(std::max(
+		std::fabs(chrominance_offsets_[0]),
+		std::fabs(luminance_offsets_[0])
+	))) + 1;
+
+	// Pick colour-space matrices. Those supplied are laid out by column, as per the GPU scan targets,
+	// so transpose them for use here.
+	const auto to_rgb = to_rgb_matrix(modals.composite_colour_space);
+	const auto from_rgb = from_rgb_matrix(modals.composite_colour_space);
+	for(int row = 0; row < 3; ++row) {
+		for(int column = 0; column < 3; ++column) {
+			luma_chroma_to_rgb_[row*3 + column] = to_rgb[size_t(column*3 + row)];
+			rgb_to_luma_chroma_[row*3 + column] = from_rgb[size_t(column*3 + row)];
+		}
+	}
+
+	// Produce the final output matrix, which also applies brightness and scales to the range [0, 255].
+	const float scale = 255.0f * modals.brightness;
+	for(int c = 0; c < 9; ++c) {
+		if(modals.display_type == DisplayType::RGB) {
+			output_matrix_[c] = (c % 4) ? 0.0f : scale;
+		} else {
+			output_matrix_[c] = luma_chroma_to_rgb_[c] * scale;
+		}
+	}
+
+	// Build a gamma table if required.
+	applies_gamma_ = std::fabs(output_gamma_ - modals.intended_gamma) > 0.05f;
+	if(applies_gamma_) {
+		const float gamma_ratio = output_gamma_ / modals.intended_gamma;
+		for(size_t c = 0; c < gamma_table_.size(); ++c) {
+			gamma_table_[c] = uint8_t(std::pow(float(c) / 255.0f, gamma_ratio) * 255.0f + 0.5f);
+		}
+	}
+}
+
+// MARK: - Output.
+
+void SoftwareScanTarget::update() {
+	perform([=] {
+		HOST_PROFILER_ZONE("Software scan target update");
+		const auto begin_time = std::chrono::high_resolution_clock::now();
+		const OutputArea area = get_output_area();
+
+		const bool size_did_change = requested_width_ != width_ || requested_height_ != height_;
+		if(size_did_change) {
+			resize_framebuffer();
+		}
+		if(new_modals() || (size_did_change && !write_area_.empty())) {
+			setup_conversion();
+		}
+
+		// Divide lines by which frame they're in.
+		area_end_scan_ = area.end.scan;
+		const size_t lines_submitted = (area.end.line - area.start.line + line_buffer_.size()) % line_buffer_.size();
+		size_t new_lines = lines_submitted;
+		size_t start_line = area.start.line;
+		while(new_lines) {
+			size_t end_line = (start_line + 1) % line_buffer_.size();
+
+			// Find the limit of lines to draw in this batch.
+			size_t lines = 1;
+			while(end_line != area.end.line && !line_metadata_buffer_[end_line].is_first_in_frame) {
+				end_line = (end_line + 1) % line_buffer_.size();
+				++lines;
+			}
+
+			const auto &metadata = line_metadata_buffer_[start_line];
+			if(metadata.is_first_in_frame) {
+				end_frame(metadata.previous_frame_was_complete);
+			}
+			draw_lines(start_line, lines);
+
+			start_line = end_line;
+			new_lines -= lines;
+		}
+
+		complete_output_area(area);
+
+		display_metrics_.announce_draw_status(
+			lines_submitted,
+			std::chrono::high_resolution_clock::now() - begin_time,
+			true);
+	});
+}
+
+void SoftwareScanTarget::end_frame(bool was_complete) {
+	if(!frame_has_output_) return;
+	frame_has_output_ = false;
+
+	// Rows that weren't painted during a complete frame are no longer part of the display.
+	if(was_complete) {
+		for(size_t y = 0; y < height_; ++y) {
+			if(!row_was_painted_[y]) {
+				std::fill_n(&framebuffer_[y * width_], width_, 0xff000000);
+			}
+		}
+	}
+	std::fill(row_was_painted_.begin(), row_was_painted_.end(), 0);
+
+	if(delegate_) {
+		delegate_->software_scan_target_did_complete_frame(*this);
+	}
+}
+
+void SoftwareScanTarget::draw_lines(size_t first, size_t count) {
+	if(write_area_.empty() || !width_ || !height_) return;
+	frame_has_output_ = true;
+
+	// Locate all lines within the framebuffer.
+	const auto &modals = BufferingScanTarget::modals();
+	const float width = float(width_), height = float(height_);
+	const auto &area = modals.visible_area;
+
+	jobs_.clear();
+	for(size_t c = 0; c < count; ++c) {
+		Job job;
+		job.line = (first + c) % line_buffer_.size();
+		const Line &line = line_buffer_[job.line];
+		if(line.end_points[1].x <= line.end_points[0].x) continue;
+		if(line.end_points[1].cycles_since_end_of_horizontal_retrace <= line.end_points[0].cycles_since_end_of_horizontal_retrace) continue;
+
+		const float centre = (float(line.end_points[0].y) / scale_y_ - area.origin.y) / area.size.height;
+		const float half_height = row_height_ * 0.5f / area.size.height;
+		job.top = std::clamp(int(std::ceil((centre - half_height) * height - 0.5f)), 0, int(height_));
+		job.bottom = std::clamp(int(std::ceil((centre + half_height) * height - 0.5f)), 0, int(height_));
+
+		const float left = (float(line.end_points[0].x) / scale_x_ - area.origin.x) / area.size.width;
+		const float right = (float(line.end_points[1].x) / scale_x_ - area.origin.x) / area.size.width;
+		job.left = std::clamp(int(std::ceil(left * width - 0.5f)), 0, int(width_));
+		job.right = std::clamp(int(std::ceil(right * width - 0.5f)), 0, int(width_));
+
+		if(job.top == job.bottom || job.left == job.right) continue;
+
+		// This line's scans are all those from its first until either the end of the area
+		// or the first that belongs to a different line.
+		job.first_scan = job.end_scan = line_metadata_buffer_[job.line].first_scan;
+		while(job.end_scan != area_end_scan_ && scan_buffer_[job.end_scan].line == job.line) {
+			job.end_scan = (job.end_scan + 1) % scan_buffer_.size();
+		}
+
+		jobs_.push_back(job);
+	}
+	if(jobs_.empty()) return;
+
+	// Draw in horizontal bands, one per hardware thread. This thread draws the final band itself.
+	const int bands = std::clamp(int(std::thread::hardware_concurrency()), 1, int(height_));
+	const auto band_top = [=](int band) {
+		return int((height_ * size_t(band)) / size_t(bands));
+	};
+
+	std::mutex mutex;
+	std::condition_variable condition;
+	int outstanding = bands - 1;
+	for(int band = 0; band < bands - 1; ++band) {
+		Concurrency::ThreadPool::shared().submit([&, band] {
+			draw_band(band_top(band), band_top(band + 1));
+
+			std::lock_guard lock(mutex);
+			--outstanding;
+			condition.notify_all();
+		});
+	}
+	draw_band(band_top(bands - 1), int(height_));
+
+	std::unique_lock lock(mutex);
+	condition.wait(lock, [&] { return !outstanding; });
+}
+
+void SoftwareScanTarget::draw_band(int top, int bottom) {
+	std::vector<float> signal[4], channels[3];
+	std::vector<uint32_t> row(width_);
+
+	// Lines are drawn in order, so where they overlap the later will take precedence.
+	for(const auto &job: jobs_) {
+		if(job.bottom <= top || job.top >= bottom) continue;
+		draw_job(job, signal, channels, row.data());
+
+		const int first_row = std::max(job.top, top);
+		const int end_row = std::min(job.bottom, bottom);
+		for(int y = first_row; y < end_row; ++y) {
+			std::copy(&row[size_t(job.left)], &row[size_t(job.right)], &framebuffer_[size_t(y) * width_ + size_t(job.left)]);
+			row_was_painted_[size_t(y)] = 1;
+		}
+	}
+}
+
+void SoftwareScanTarget::compose(const Job &job, int first_clock, std::vector<float> *signal) {
+	const auto &modals = BufferingScanTarget::modals();
+	const size_t data_size = Outputs::Display::size_for_data_type(modals.input_data_type);
+	const bool is_rgb_display = modals.display_type == DisplayType::RGB;
+	const float *const m = rgb_to_luma_chroma_;
+
+	for(size_t scan_index = job.first_scan; scan_index != job.end_scan; scan_index = (scan_index + 1) % scan_buffer_.size()) {
+		const Scan &scan = scan_buffer_[scan_index];
+		const int start = scan.scan.end_points[0].cycles_since_end_of_horizontal_retrace;
+		const int end = scan.scan.end_points[1].cycles_since_end_of_horizontal_retrace;
+		if(end <= start) continue;
+
+		const float first_x = float(scan.scan.end_points[0].data_offset);
+		const float x_per_clock = float(scan.scan.end_points[1].data_offset - scan.scan.end_points[0].data_offset) / float(end - start);
+		const uint8_t *const source = &write_area_[size_t(scan.data_y) * WriteAreaWidth * data_size];
+		const uint8_t *const palette = &write_area_[size_t(scan.palette_y) * WriteAreaWidth + scan.palette_x];
+
+		const int first = std::max(start, first_clock);
+		const int last = std::min(end, first_clock + int(signal[0].size()));
+		for(int clock = first; clock < last; ++clock) {
+			const float position = first_x + (float(clock - start) + 0.5f) * x_per_clock;
+			const int x = std::clamp(int(position), 0, WriteAreaWidth - 1);
+			const uint8_t *const texel = &source[size_t(x) * data_size];
+			const size_t index = size_t(clock - first_clock);
+
+			// Decode to either RGB or else whatever will be needed for composite sampling.
+			// See draw_job for the meaning of each.
+			float rgb[3]{};
+			switch(modals.input_data_type) {
+				case InputDataType::Luminance1:
+					signal[0][index] = texel[0] ? 1.0f : 0.0f;
+					signal[1][index] = signal[2][index] = is_rgb_display ? signal[0][index] : 0.0f;
+				continue;
+				case InputDataType::Luminance8:
+					signal[0][index] = float(texel[0]) / 255.0f;
+					signal[1][index] = signal[2][index] = is_rgb_display ? signal[0][index] : 0.0f;
+				continue;
+
+				// For the packed types, the fractional part of the position picks a pixel from within its byte.
+				case InputDataType::Luminance1Packed: {
+					const int shift = 7 - std::clamp(int((position - float(x)) * 8.0f), 0, 7);
+					signal[0][index] = float((texel[0] >> shift) & 1);
+					signal[1][index] = signal[2][index] = is_rgb_display ? signal[0][index] : 0.0f;
+				} continue;
+				case InputDataType::Luminance2Packed: {
+					const int shift = (3 - std::clamp(int((position - float(x)) * 4.0f), 0, 3)) * 2;
+					signal[0][index] = float((texel[0] >> shift) & 3) / 3.0f;
+					signal[1][index] = signal[2][index] = is_rgb_display ? signal[0][index] : 0.0f;
+				} continue;
+				case InputDataType::PhaseLinkedLuminance8:
+					if(is_rgb_display) {
+						signal[0][index] = signal[1][index] = signal[2][index] =
+							float(texel[0] + texel[1] + texel[2] + texel[3]) / (4.0f * 255.0f);
+					} else {
+						for(int c = 0; c < 4; ++c) {
+							signal[c][index] = float(texel[c]) / 255.0f;
+						}
+					}
+				continue;
+				case InputDataType::Luminance8Phase8: {
+					const float luminance = float(texel[0]) / 255.0f;
+					const float phase = float(texel[1]) / 255.0f;
+					if(is_rgb_display) {
+						signal[0][index] = signal[1][index] = signal[2][index] = luminance;
+					} else {
+						// cos(angle + phase) = cos(angle)cos(phase) - sin(angle)sin(phase).
+						const bool has_chroma = phase <= 0.75f;
+						signal[0][index] = luminance;
+						signal[1][index] = has_chroma ? std::cos(Pi * 4.0f * phase) : 0.0f;
+						signal[2][index] = has_chroma ? -std::sin(Pi * 4.0f * phase) : 0.0f;
+					}
+				} continue;
+
+				case InputDataType::Red1Green1Blue1:
+					rgb[0] = (texel[0] & 4) ? 1.0f : 0.0f;
+					rgb[1] = (texel[0] & 2) ? 1.0f : 0.0f;
+					rgb[2] = (texel[0] & 1) ? 1.0f : 0.0f;
+				break;
+				case InputDataType::Red2Green2Blue2:
+					rgb[0] = float((texel[0] >> 4) & 3) / 3.0f;
+					rgb[1] = float((texel[0] >> 2) & 3) / 3.0f;
+					rgb[2] = float(texel[0] & 3) / 3.0f;
+				break;
+				case InputDataType::Red4Green4Blue4:
+					rgb[0] = std::min(float(texel[0]) / 15.0f, 1.0f);
+					rgb[1] = float(texel[1] & 0xf0) / 240.0f;
+					rgb[2] = float(texel[1] & 0x0f) / 15.0f;
+				break;
+				case InputDataType::Red8Green8Blue8:
+					rgb[0] = float(texel[0]) / 255.0f;
+					rgb[1] = float(texel[1]) / 255.0f;
+					rgb[2] = float(texel[2]) / 255.0f;
+				break;
+
+				case InputDataType::Palette8:
+				case InputDataType::Palette4Packed: {
+					const int index = (modals.input_data_type == InputDataType::Palette8) ?
+						texel[0] :
+						(texel[0] >> ((position - float(x) < 0.5f) ? 4 : 0)) & 0xf;
+					const uint8_t *const entry = &palette[index * 4];
+					rgb[0] = float(entry[0]) / 255.0f;
+					rgb[1] = float(entry[1]) / 255.0f;
+					rgb[2] = float(entry[2]) / 255.0f;
+				} break;
+			}
+
+			if(is_rgb_display) {
+				for(int c = 0; c < 3; ++c) {
+					signal[c][index] = rgb[c];
+				}
+			} else {
+				for(int c = 0; c < 3; ++c) {
+					signal[c][index] = m[c*3 + 0]*rgb[0] + m[c*3 + 1]*rgb[1] + m[c*3 + 2]*rgb[2];
+				}
+			}
+		}
+	}
+}
+
+void SoftwareScanTarget::draw_job(const Job &job, std::vector<float> *signal, std::vector<float> *channels, uint32_t *row) {
+	const auto &modals = BufferingScanTarget::modals();
+	const Line &line = line_buffer_[job.line];
+	const auto &area = modals.visible_area;
+	const float amplitude = float(line.composite_amplitude) / 255.0f;
+
+	const float start_clock = float(line.end_points[0].cycles_since_end_of_horizontal_retrace);
+	const float end_clock = float(line.end_points[1].cycles_since_end_of_horizontal_retrace);
+
+	// Compose the line's scans into a continuous signal, indexed by clock.
+	//
+	// For RGB displays the planes of signal are red, green and blue. Otherwise they are arranged so that
+	// a composite sample at angle a is:
+	//
+	//	* for phase-linked luminance, whichever of the four planes is selected by a; or
+	//	* for everything else, mix(signal[0], cos(a)*signal[1] + sin(a)*signal[2], amplitude).
+	const int first_clock = int(start_clock) - margin_;
+	const size_t length = size_t(int(end_clock) - int(start_clock) + 2*margin_ + 1);
+	for(int c = 0; c < 4; ++c) {
+		signal[c].assign(length, 0.0f);
+	}
+	for(int c = 0; c < 3; ++c) {
+		channels[c].resize(size_t(job.right - job.left));
+	}
+	compose(job, first_clock, signal);
+
+	// Clock and angle are both linear in output position; get them in terms of signal index
+	// and radians respectively. The margin guarantees that all taps are in range.
+	const float start_x = float(line.end_points[0].x);
+	const float end_x = float(line.end_points[1].x);
+	const float lateral_per_pixel = area.size.width * scale_x_ / (float(width_) * (end_x - start_x));
+	const float first_lateral = ((float(job.left) + 0.5f) / float(width_) * area.size.width + area.origin.x) * scale_x_;
+	const float lateral_offset = (first_lateral - start_x) / (end_x - start_x);
+
+	const float clock_per_pixel = (end_clock - start_clock) * lateral_per_pixel;
+	const float first_index = start_clock + (end_clock - start_clock) * lateral_offset - float(first_clock);
+
+	const float start_angle = float(line.end_points[0].composite_angle) * (Pi / 32.0f);
+	const float end_angle = float(line.end_points[1].composite_angle) * (Pi / 32.0f);
+	const float angle_per_pixel = (end_angle - start_angle) * lateral_per_pixel;
+	const float first_angle = start_angle + (end_angle - start_angle) * lateral_offset;
+
+	// Chrominance taps are a quarter of a colour cycle apart, so the cosine and sine of each tap angle
+	// are a rotation of those for the first. Track the first by repeated rotation, in double precision
+	// to limit drift, rather than recomputing it at every pixel.
+	const double tap_angle = double(first_angle) - 0.75 * double(Pi);
+	double cosine = std::cos(tap_angle), sine = std::sin(tap_angle);
+	const double step_cosine = std::cos(double(angle_per_pixel)), step_sine = std::sin(double(angle_per_pixel));
+
+	const bool is_phase_linked = modals.input_data_type == InputDataType::PhaseLinkedLuminance8;
+	const size_t count = size_t(job.right - job.left);
+	for(size_t index = 0; index < count; ++index) {
+		const float position = first_index + float(index) * clock_per_pixel;
+		const float angle = first_angle + float(index) * angle_per_pixel;
+		const float tap_cosines[] = {float(cosine), float(-sine), float(-cosine), float(sine)};
+		const float tap_sines[] = {float(sine), float(cosine), float(-sine), float(-cosine)};
+
+		const double next_cosine = cosine * step_cosine - sine * step_sine;
+		sine = sine * step_cosine + cosine * step_sine;
+		cosine = next_cosine;
+
+		// Provides the composite sample at signal index i and tap number t.
+		const auto composite_sample = [&](size_t i, int t) {
+			if(is_phase_linked) {
+				const float a = angle + (float(t) - 1.5f) * (Pi / 2.0f);
+				const unsigned phase = (a <= 0.0f ? 3 : 0) ^ (unsigned(std::fabs(a * 2.0f / Pi)) & 3);
+				return signal[phase][i];
+			}
+			const float chrominance = tap_cosines[t] * signal[1][i] + tap_sines[t] * signal[2][i];
+			return signal[0][i] + (chrominance - signal[0][i]) * amplitude;
+		};
+
+		switch(modals.display_type) {
+			case DisplayType::RGB:
+				for(int c = 0; c < 3; ++c) {
+					float value = 0.0f;
+					for(int tap = 0; tap < 4; ++tap) {
+						value += signal[c][size_t(position + luminance_offsets_[tap])] * luminance_weights_[tap];
+					}
+					channels[c][index] = value;
+				}
+			break;
+
+			case DisplayType::CompositeMonochrome: {
+				float luminance = 0.0f;
+				for(int tap = 0; tap < 4; ++tap) {
+					luminance += composite_sample(size_t(position + luminance_offsets_[tap]), tap) * luminance_weights_[tap];
+				}
+				channels[0][index] = luminance;
+				channels[1][index] = channels[2][index] = 0.0f;
+			} break;
+
+			case DisplayType::CompositeColour: {
+				float samples[4];
+				for(int tap = 0; tap < 4; ++tap) {
+					samples[tap] = composite_sample(size_t(position + luminance_offsets_[tap]), tap);
+				}
+
+				if(amplitude < 0.01f) {
+					// Compute only a luminance if there's no colour information.
+					channels[0][index] = (samples[0] + samples[3]) * 0.15f + (samples[1] + samples[2]) * 0.35f;
+					channels[1][index] = channels[2][index] = 0.0f;
+					break;
+				}
+
+				// Four samples a quarter of a colour cycle apart sum to four times the luminance, as the
+				// chrominance cancels out; demodulating them yields twice the chrominance.
+				float luminance = 0.0f, u = 0.0f, v = 0.0f;
+				for(int tap = 0; tap < 4; ++tap) {
+					luminance += samples[tap];
+					u += samples[tap] * tap_cosines[tap];
+					v += samples[tap] * tap_sines[tap];
+				}
+				channels[0][index] = luminance * 0.25f / (1.0f - amplitude);
+				channels[1][index] = u * 0.5f / amplitude;
+				channels[2][index] = v * 0.5f / amplitude;
+			} break;
+
+			case DisplayType::SVideo: {
+				float luminance = 0.0f, u = 0.0f, v = 0.0f;
+				for(int tap = 0; tap < 4; ++tap) {
+					luminance += signal[0][size_t(position + luminance_offsets_[tap])] * luminance_weights_[tap];
+					if(is_phase_linked) continue;
+
+					const size_t i = size_t(position + chrominance_offsets_[tap]);
+					const float chrominance = tap_cosines[tap] * signal[1][i] + tap_sines[tap] * signal[2][i];
+					u += chrominance * tap_cosines[tap];
+					v += chrominance * tap_sines[tap];
+				}
+				channels[0][index] = luminance;
+				channels[1][index] = u * 0.5f;
+				channels[2][index] = v * 0.5f;
+			} break;
+		}
+	}
+
+	// Convert to RGBA.
+	uint32_t *const target = &row[job.left];
+	convert(channels[0].data(), channels[1].data(), channels[2].data(), output_matrix_, count, target);
+
+	if(applies_gamma_) {
+		for(size_t c = 0; c < count; ++c) {
+			const uint32_t pixel = target[c];
+			target[c] =
+				uint32_t(gamma_table_[pixel & 0xff]) |
+				uint32_t(gamma_table_[(pixel >> 8) & 0xff] << 8) |
+				uint32_t(gamma_table_[(pixel >> 16) & 0xff] << 16) |
+				0xff000000;
+		}
+	}
+}
@@ -0,0 +1,134 @@
+//
+//  SoftwareScanTarget.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 14/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#ifndef SoftwareScanTarget_hpp
+#define SoftwareScanTarget_hpp
+
+#include "BufferingScanTarget.hpp"
+#include "../../Memory/Arena.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Outputs {
+namespace Display {
+
+/*!
+	Provides a ScanTarget that rasterises entirely on the CPU, into an RGBA framebuffer,
+	for hosts without a GPU.
+
+	RGB output is sampled directly; composite and S-Video output are decoded by a simplified
+	version of the OpenGL ScanTarget's single-pass pipeline: luminance is the average of four
+	samples across a colour cycle, and chrominance is demodulated from the same four samples.
+	Phosphor decay and persistence are not modelled: each line simply replaces whatever was
+	previously at its location.
+
+	Lines are distributed across Concurrency::ThreadPool::shared() in horizontal bands of the
+	framebuffer, so update should not itself be called from a task on that pool.
+*/
+class SoftwareScanTarget: public BufferingScanTarget {
+	public:
+		SoftwareScanTarget(size_t output_width = 640, size_t output_height = 480, float output_gamma = 2.2f);
+
+		struct Delegate {
+			/*!
+				Announces that the framebuffer now contains a complete frame, which will remain
+				unmodified until update is next called.
+			*/
+			virtual void software_scan_target_did_complete_frame(SoftwareScanTarget &) = 0;
+		};
+		void set_delegate(Delegate *delegate) {
+			delegate_ = delegate;
+		}
+
+		/// Sets the size of the framebuffer, which will be cleared to black. This takes effect upon the next update.
+		void set_output_size(size_t output_width, size_t output_height);
+
+		/*!
+			Processes all the latest input, drawing it into the framebuffer. Any frame that is completed
+			is announced to the delegate before it is modified further.
+		*/
+		void update();
+
+		/*!
+			@returns The framebuffer, as @c height() rows of @c width() pixels, top to bottom. Each pixel
+				is 0xAABBGGRR, i.e. bytes are in the order red, green, blue and alpha on a little-endian
+				host. Alpha is always 0xff.
+		*/
+		const uint32_t *pixels() const {
+			return framebuffer_.data();
+		}
+		size_t width() const {
+			return width_;
+		}
+		size_t height() const {
+			return height_;
+		}
+
+	private:
+		static constexpr int LineBufferHeight = 2048;
+
+		std::array<Scan, LineBufferHeight*5> scan_buffer_;
+		std::array<Line, LineBufferHeight> line_buffer_;
+		std::array<LineMetadata, LineBufferHeight> line_metadata_buffer_;
+
+		// The write area is the largest buffer, and is written to throughout by the producer,
+		// so is kept in an arena for huge-page backing.
+		Memory::Arena arena_{Memory::Arena::Backing::HugePages};
+		Memory::ArenaVector<uint8_t> write_area_;
+
+		size_t width_, height_;
+		size_t requested_width_, requested_height_;
+		std::vector<uint32_t> framebuffer_;
+		const float output_gamma_;
+		Delegate *delegate_ = nullptr;
+
+		/// Records which rows were painted during the current frame, so that any left unpainted
+		/// can be cleared at its end.
+		std::vector<uint8_t> row_was_painted_;
+		bool frame_has_output_ = false;
+
+		/// Describes a single line to draw, as located within the framebuffer.
+		struct Job {
+			size_t line;
+			size_t first_scan, end_scan;
+			int top, bottom;
+			int left, right;
+		};
+		std::vector<Job> jobs_;
+
+		// State derived from the modals, established by setup_conversion; matrices are row-major.
+		float scale_x_ = 1.0f, scale_y_ = 1.0f;
+		float row_height_ = 0.0f;
+		float luminance_offsets_[4]{}, luminance_weights_[4]{};
+		float chrominance_offsets_[4]{};
+		int margin_ = 0;
+		float luma_chroma_to_rgb_[9]{};
+		float rgb_to_luma_chroma_[9]{};
+		float output_matrix_[9]{};
+		std::array<uint8_t, 256> gamma_table_{};
+		bool applies_gamma_ = false;
+
+		void setup_conversion();
+		void resize_framebuffer();
+
+		size_t area_end_scan_ = 0;
+
+		void end_frame(bool was_complete);
+		void draw_lines(size_t first, size_t count);
+		void draw_band(int top, int bottom);
+		void draw_job(const Job &, std::vector<float> *signal, std::vector<float> *channels, uint32_t *row);
+		void compose(const Job &, int first_clock, std::vector<float> *signal);
+};
+
+}
+}
+
+#endif /* SoftwareScanTarget_hpp */
@@ -0,0 +1,205 @@
+//
+//  AudioRingBuffer.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 14/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#ifndef AudioRingBuffer_hpp
+#define AudioRingBuffer_hpp
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Outputs {
+namespace Speaker {
+
+/*!
+	Provides a single-producer, single-consumer, lock-free buffer for carrying audio from the thread
+	that receives speaker_did_complete_samples to whichever thread services the host's audio output.
+
+	The producer never blocks: if the buffer is full then the newest samples are discarded.
+
+	The consumer resamples slightly in order to hold the amount of buffered audio near a target
+	latency, absorbing any drift between the emulated and host sample clocks. It consumes up to half a percent
+	faster than real time if the buffer is fuller than the target, and up to half a percent slower
+	if it is emptier. If the buffer ever exceeds three times the target latency, e.g. after the
+	output has stalled, the oldest audio is skipped to return immediately to the target.
+
+	Samples are interleaved if there is more than one channel, as per Speaker::Delegate.
+*/
+class AudioRingBuffer {
+	public:
+		/*!
+			Sets the number of channels and the target latency, in frames.
+
+			This is not thread safe; it should be called before either the producer or the consumer
+			is active.
+		*/
+		void set_format(int channels, size_t target_latency) {
+			channels_ = std::clamp(channels, 1, 2);
+			target_latency_ = std::max(target_latency, size_t(1));
+
+			size_t capacity = 1;
+			while(capacity < target_latency_ * 4) capacity <<= 1;
+			buffer_.resize(capacity * size_t(channels_));
+			capacity_ = capacity;
+
+			read_ = write_ = 0;
+			phase_ = 0;
+			previous_[0] = previous_[1] = 0;
+			drift_ = 0.0f;
+			averaged_fill_ = float(target_latency_);
+			underruns_ = overruns_ = 0;
+		}
+
+		// MARK: - Producer.
+
+		/*!
+			Enqueues @c count samples from @c samples; @c count should be a multiple of the
+			number of channels.
+
+			@returns The number of samples accepted.
+		*/
+		size_t write(const int16_t *samples, size_t count) {
+			if(buffer_.empty()) return 0;
+
+			const size_t write = write_.load(std::memory_order_relaxed);
+			const size_t free = capacity_ - (write - read_.load(std::memory_order_acquire));
+			const size_t frames = std::min(count / size_t(channels_), free);
+			if(frames < count / size_t(channels_)) {
+				++overruns_;
+			}
+
+			// Copy in up to two parts, to allow for wrapping.
+			const size_t start = write & (capacity_ - 1);
+			const size_t first = std::min(frames, capacity_ - start);
+			std::copy(samples, samples + first * size_t(channels_), &buffer_[start * size_t(channels_)]);
+			std::copy(samples + first * size_t(channels_), samples + frames * size_t(channels_), buffer_.data());
+
+			write_.store(write + frames, std::memory_order_release);
+			return frames * size_t(channels_);
+		}
+
+		size_t write(const std::vector<int16_t> &samples) {
+			return write(samples.data(), samples.size());
+		}
+
+		// MARK: - Consumer.
+
+		/*!
+			Resamples up to @c frames frames of audio into @c target.
+
+			@returns The number of frames written, which will be fewer than @c frames
+				only if the buffer ran dry.
+		*/
+		size_t read(int16_t *target, size_t frames) {
+			if(buffer_.empty()) return 0;
+
+			size_t read = read_.load(std::memory_order_relaxed);
+			size_t available = write_.load(std::memory_order_acquire) - read;
+
+			// Skip stale audio if latency has grown unreasonably.
+			if(available > target_latency_ * 3) {
+				read += available - target_latency_;
+				available = target_latency_;
+				++overruns_;
+			}
+
+			// Pick a rate of consumption, in 16.16 fixed point, based on a smoothed fill level.
+			float averaged_fill = averaged_fill_.load(std::memory_order_relaxed);
+			averaged_fill += (float(available) - averaged_fill) * 0.125f;
+			averaged_fill_.store(averaged_fill, std::memory_order_relaxed);
+			//
+			// A proportional term alone would leave a standing offset from the target for any fixed
+			// clock drift, so an integral term is added to trim that away over time.
+			const float error = std::clamp((averaged_fill - float(target_latency_)) / float(target_latency_), -1.0f, 1.0f);
+			drift_ = std::clamp(drift_ + error * MaximumAdjustment * 0.01f, -MaximumAdjustment, MaximumAdjustment);
+			const float adjustment = std::clamp(MaximumAdjustment * error + drift_, -MaximumAdjustment, MaximumAdjustment);
+			const auto step = uint32_t(65536.0f * (1.0f + adjustment));
+
+			// Output is a linear interpolation between the previously-consumed frame
+			// and the next, so only a single frame need be available.
+			size_t produced = 0;
+			while(produced < frames) {
+				while(phase_ >= 65536 && available) {
+					const int16_t *const consumed = &buffer_[(read & (capacity_ - 1)) * size_t(channels_)];
+					std::copy(consumed, consumed + channels_, previous_);
+					phase_ -= 65536;
+					++read;
+					--available;
+				}
+				if(!available) break;
+
+				const int16_t *const next = &buffer_[(read & (capacity_ - 1)) * size_t(channels_)];
+				for(int c = 0; c < channels_; c++) {
+					target[c] = int16_t(previous_[c] + (((next[c] - previous_[c]) * int(phase_ >> 1)) >> 15));
+				}
+				target += channels_;
+				++produced;
+				phase_ += step;
+			}
+
+			if(produced < frames) {
+				++underruns_;
+			}
+			read_.store(read, std::memory_order_release);
+			return produced;
+		}
+
+		/// @returns The number of frames currently buffered.
+		size_t buffered() const {
+			// Load read_ first: it can never overtake write_, so this can't underflow.
+			const size_t read = read_.load(std::memory_order_acquire);
+			return write_.load(std::memory_order_acquire) - read;
+		}
+
+		/// @returns The target latency, in frames.
+		size_t target_latency() const {
+			return target_latency_;
+		}
+
+		/// @returns The current smoothed latency, in frames, as observed by the consumer.
+		float latency() const {
+			return averaged_fill_.load(std::memory_order_relaxed);
+		}
+
+		/// @returns The number of occasions on which the consumer found insufficient audio.
+		size_t underruns() const {
+			return underruns_;
+		}
+
+		/// @returns The number of occasions on which audio has been discarded to bound latency.
+		size_t overruns() const {
+			return overruns_;
+		}
+
+	private:
+		static constexpr float MaximumAdjustment = 0.005f;
+
+		int channels_ = 1;
+		size_t target_latency_ = 1;
+		size_t capacity_ = 0;
+		std::vector<int16_t> buffer_;
+
+		// Both indices increase monotonically, in frames, and are mapped into buffer_ by masking.
+		std::atomic<size_t> read_ = 0, write_ = 0;
+
+		// Consumer state.
+		uint32_t phase_ = 0;
+		int previous_[2]{};
+		float drift_ = 0.0f;
+
+		// Shared statistics.
+		std::atomic<float> averaged_fill_ = 0.0f;
+		std::atomic<size_t> underruns_ = 0, overruns_ = 0;
+};
+
+}
+}
+
+#endif /* AudioRingBuffer_hpp */
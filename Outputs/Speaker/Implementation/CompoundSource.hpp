@@ -11,6 +11,7 @@
 
 #include "SampleSource.hpp"
 
+#include <algorithm>
 #include <cassert>
 #include <cstring>
 #include <atomic>
@@ -34,7 +35,31 @@ template <typename... T> class CompoundSource:
 		}
 
 		void get_samples(std::size_t number_of_samples, std::int16_t *target) {
-			source_holder_.template get_samples<get_is_stereo()>(number_of_samples, target);
+			constexpr std::size_t source_count = CompoundSourceHolder<T...>::size();
+			constexpr std::size_t channels = get_is_stereo() ? 2 : 1;
+
+			if constexpr (!source_count) {
+				std::memset(target, 0, sizeof(std::int16_t) * number_of_samples * channels);
+			} else {
+				// Have each source fill its own block, then sum them all in a single pass.
+				alignas(BufferAlignment) std::int16_t blocks[source_count][MaxBlockSize * channels];
+				while(number_of_samples) {
+					const std::size_t block_size = std::min(number_of_samples, MaxBlockSize);
+					source_holder_.template get_samples<get_is_stereo()>(block_size, blocks);
+
+					// Sum with saturation; this loop is intended to be vectorised by the compiler.
+					for(std::size_t c = 0; c < block_size * channels; c++) {
+						int sum = 0;
+						for(std::size_t source = 0; source < source_count; source++) {
+							sum += blocks[source][c];
+						}
+						target[c] = std::int16_t(std::clamp(sum, -32768, 32767));
+					}
+
+					target += block_size * channels;
+					number_of_samples -= block_size;
+				}
+			}
 		}
 
 		void skip_samples(const std::size_t number_of_samples) {
@@ -82,9 +107,7 @@ template <typename... T> class CompoundSource:
 
 		template <typename... S> class CompoundSourceHolder: public Outputs::Speaker::SampleSource {
 			public:
-				template <bool output_stereo> void get_samples(std::size_t number_of_samples, std::int16_t *target) {
-					std::memset(target, 0, sizeof(std::int16_t) * number_of_samples);
-				}
+				template <bool output_stereo, typename BlockT> void get_samples(std::size_t, BlockT *) {}
 
 				void set_scaled_volume_range(int16_t, double *, double) {}
 
@@ -105,39 +128,52 @@ template <typename... T> class CompoundSource:
 			public:
 				CompoundSourceHolder(S &source, R &...next) : source_(source), next_source_(next...) {}
 
-				template <bool output_stereo> void get_samples(std::size_t number_of_samples, std::int16_t *target) {
-					// Get the rest of the output.
-					next_source_.template get_samples<output_stereo>(number_of_samples, target);
+				/// Writes @c number_of_samples samples to the first of @c blocks; the remaining sources write to those that follow.
+				template <bool output_stereo, typename BlockT> void get_samples(std::size_t number_of_samples, BlockT *blocks) {
+					next_source_.template get_samples<output_stereo>(number_of_samples, &blocks[1]);
+
+					std::int16_t *const target = blocks[0];
+					constexpr std::size_t channels = output_stereo ? 2 : 1;
 
 					if(source_.is_zero_level()) {
-						// This component is currently outputting silence; therefore don't add anything to the output
+						// This component is currently outputting silence; therefore don't generate any output
 						// audio — just pass the call onward.
 						source_.skip_samples(number_of_samples);
+						std::fill(target, target + number_of_samples * channels, 0);
 						return;
 					}
 
-					// Get this component's output.
-					auto buffer_size = number_of_samples * (output_stereo ? 2 : 1);
-					int16_t local_samples[buffer_size];
-					source_.get_samples(number_of_samples, local_samples);
-
-					// Merge it in; furthermore if total output is stereo but this source isn't,
-					// map it to stereo.
-					if constexpr (output_stereo == S::get_is_stereo()) {
-						while(buffer_size--) {
-							target[buffer_size] += local_samples[buffer_size];
-						}
-					} else {
-						// This will happen only if mapping from mono to stereo, never in the
-						// other direction, because the compound source outputs stereo if any
-						// subcomponent does. So it outputs mono only if no stereo devices are
-						// in the mixing chain.
-						while(buffer_size--) {
-							target[buffer_size] += local_samples[buffer_size >> 1];
+					// If this component is currently outputting a constant level, just fill with that.
+					std::int16_t level[2];
+					if(source_.get_constant_level(level)) {
+						source_.skip_samples(number_of_samples);
+						if constexpr (output_stereo) {
+							if constexpr (!S::get_is_stereo()) {
+								level[1] = level[0];
+							}
+							for(std::size_t c = 0; c < number_of_samples; c++) {
+								target[c*2 + 0] = level[0];
+								target[c*2 + 1] = level[1];
+							}
+						} else {
+							std::fill(target, target + number_of_samples, level[0]);
 						}
+						return;
 					}
 
-					// TODO: accelerate above?
+					// Get this component's output; if total output is stereo but this source isn't,
+					// map it to stereo working backwards from the end of the block.
+					//
+					// This will happen only if mapping from mono to stereo, never in the
+					// other direction, because the compound source outputs stereo if any
+					// subcomponent does. So it outputs mono only if no stereo devices are
+					// in the mixing chain.
+					source_.get_samples(number_of_samples, target);
+					if constexpr (output_stereo && !S::get_is_stereo()) {
+						for(std::size_t c = number_of_samples; c--;) {
+							target[c*2 + 0] = target[c*2 + 1] = target[c];
+						}
+					}
 				}
 
 				void skip_samples(const std::size_t number_of_samples) {
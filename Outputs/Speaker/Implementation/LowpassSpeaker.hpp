@@ -13,7 +13,9 @@
 #include "../../../SignalProcessing/FIRFilter.hpp"
 #include "../../../ClockReceiver/ClockReceiver.hpp"
 #include "../../../Concurrency/AsyncTaskQueue.hpp"
+#include "../../HostProfiler.hpp"
 
+#include <atomic>
 #include <mutex>
 #include <cstring>
 #include <cmath>
@@ -38,6 +40,11 @@ template <typename SampleSource> class LowpassSpeaker: public Speaker {
 			// Clamp to the acceptable range, and set.
 			volume = std::min(std::max(0.0f, volume), 1.0f);
 			sample_source_.set_sample_volume_range(int16_t(32767.0f * volume));
+			is_silent_.store(volume == 0.0f, std::memory_order::memory_order_relaxed);
+		}
+
+		void set_is_muted(bool is_muted) final {
+			is_muted_.store(is_muted, std::memory_order::memory_order_relaxed);
 		}
 
 		// Implemented as per Speaker.
@@ -72,6 +79,7 @@ template <typename SampleSource> class LowpassSpeaker: public Speaker {
 
 			filter_parameters_.output_cycles_per_second = cycles_per_second;
 			filter_parameters_.parameters_are_dirty = true;
+			filter_parameters_version_.fetch_add(1, std::memory_order::memory_order_release);
 			output_buffer_.resize(std::size_t(buffer_size) * (SampleSource::get_is_stereo() ? 2 : 1));
 		}
 
@@ -90,6 +98,7 @@ template <typename SampleSource> class LowpassSpeaker: public Speaker {
 			filter_parameters_.input_cycles_per_second = cycles_per_second;
 			filter_parameters_.parameters_are_dirty = true;
 			filter_parameters_.input_rate_changed = true;
+			filter_parameters_version_.fetch_add(1, std::memory_order::memory_order_release);
 		}
 
 		/*!
@@ -105,6 +114,7 @@ template <typename SampleSource> class LowpassSpeaker: public Speaker {
 			}
 			filter_parameters_.high_frequency_cutoff = high_frequency;
 			filter_parameters_.parameters_are_dirty = true;
+			filter_parameters_version_.fetch_add(1, std::memory_order::memory_order_release);
 		}
 
 		/*!
@@ -118,7 +128,18 @@ template <typename SampleSource> class LowpassSpeaker: public Speaker {
 			});
 		}
 
+		size_t get_memory_footprint() const final {
+			return
+				Speaker::get_memory_footprint() +
+				(input_buffer_.capacity() + output_buffer_.capacity()) * sizeof(int16_t) +
+				(filter_ ? filter_->get_number_of_taps() * sizeof(short) : 0);
+		}
+
 	private:
+		size_t buffered_samples_per_channel() const final {
+			return output_buffer_pointer_ / (SampleSource::get_is_stereo() ? 2 : 1);
+		}
+
 		enum class Conversion {
 			ResampleSmaller,
 			Copy,
@@ -138,16 +159,33 @@ template <typename SampleSource> class LowpassSpeaker: public Speaker {
 			std::size_t cycles_remaining = size_t(cycles.as_integral());
 			if(!cycles_remaining) return;
 
-			FilterParameters filter_parameters;
-			{
-				std::lock_guard lock_guard(filter_parameters_mutex_);
-				filter_parameters = filter_parameters_;
-				filter_parameters_.parameters_are_dirty = false;
-				filter_parameters_.input_rate_changed = false;
+			HOST_PROFILER_ZONE("Speaker generation and filtering");
+
+			// Parameters change very rarely, so check for a new version without locking and
+			// take the lock only if there is something new to collect.
+			if(filter_parameters_version_.load(std::memory_order::memory_order_acquire) != applied_filter_parameters_version_) {
+				FilterParameters filter_parameters;
+				{
+					std::lock_guard lock_guard(filter_parameters_mutex_);
+					filter_parameters = filter_parameters_;
+					filter_parameters_.parameters_are_dirty = false;
+					filter_parameters_.input_rate_changed = false;
+					applied_filter_parameters_version_ = filter_parameters_version_.load(std::memory_order::memory_order_relaxed);
+				}
+				if(filter_parameters.parameters_are_dirty) update_filter_coefficients(filter_parameters);
+				if(filter_parameters.input_rate_changed) {
+					delegate->speaker_did_change_input_clock(this);
+				}
 			}
-			if(filter_parameters.parameters_are_dirty) update_filter_coefficients(filter_parameters);
-			if(filter_parameters.input_rate_changed) {
-				delegate->speaker_did_change_input_clock(this);
+
+			// If nobody will hear the result, don't generate any audio.
+			if(
+				is_silent_.load(std::memory_order::memory_order_relaxed) ||
+				is_muted_.load(std::memory_order::memory_order_relaxed) ||
+				is_fast_forwarding()
+			) {
+				output_silence(cycles_remaining);
+				return;
 			}
 
 			switch(conversion_) {
@@ -182,6 +220,9 @@ template <typename SampleSource> class LowpassSpeaker: public Speaker {
 
 						cycles_remaining -= cycles_to_read;
 					}
+
+					// Filter whatever else is now available, to avoid adding latency.
+					resample_input_buffer(scale);
 				break;
 
 				case Conversion::ResampleLarger:
@@ -190,6 +231,49 @@ template <typename SampleSource> class LowpassSpeaker: public Speaker {
 			}
 		}
 
+		/*!
+			Advances the sample source by @c cycles without obtaining any samples from it, and supplies the
+			delegate with the corresponding amount of silence so that hosts' output remains paced.
+		*/
+		void output_silence(std::size_t cycles) {
+			constexpr size_t channels = SampleSource::get_is_stereo() ? 2 : 1;
+
+			// Skip in blocks, as some sources implement skipping via a temporary buffer.
+			std::size_t remaining = cycles;
+			while(remaining) {
+				const auto block = std::min(remaining, InputBlockSize);
+				sample_source_.skip_samples(block);
+				remaining -= block;
+			}
+
+			// Anything partially filtered is now stale.
+			input_buffer_depth_ = 0;
+			window_offset_ = 0;
+			position_error_ = 0.0f;
+
+			// Resampling to a larger size is currently unimplemented, and produces no output.
+			if(conversion_ == Conversion::ResampleLarger) return;
+
+			silence_error_ += float(cycles) / (conversion_ == Conversion::Copy ? 1.0f : step_rate_);
+			std::size_t outputs = std::size_t(silence_error_);
+			silence_error_ -= float(outputs);
+
+			while(outputs) {
+				const auto count = std::min((output_buffer_.size() - output_buffer_pointer_) / channels, outputs);
+				std::fill(&output_buffer_[output_buffer_pointer_], &output_buffer_[output_buffer_pointer_ + count * channels], int16_t(0));
+				output_buffer_pointer_ += count * channels;
+				outputs -= count;
+
+				if(output_buffer_pointer_ == output_buffer_.size()) {
+					output_buffer_pointer_ = 0;
+					did_complete_samples(this, output_buffer_, SampleSource::get_is_stereo());
+				}
+			}
+		}
+		std::atomic<bool> is_silent_ = false;	// i.e. the output volume is zero.
+		std::atomic<bool> is_muted_ = false;
+		float silence_error_ = 0.0f;
+
 		SampleSource &sample_source_;
 
 		std::size_t output_buffer_pointer_ = 0;
@@ -199,9 +283,15 @@ template <typename SampleSource> class LowpassSpeaker: public Speaker {
 
 		float step_rate_ = 0.0f;
 		float position_error_ = 0.0f;
+		std::size_t window_offset_ = 0;	// In frames.
 		std::unique_ptr<SignalProcessing::FIRFilter> filter_;
 
+		// Writes to filter_parameters_ occur only with filter_parameters_mutex_ held, and each
+		// increments filter_parameters_version_; applied_filter_parameters_version_ is the version
+		// most recently collected by run_for.
 		std::mutex filter_parameters_mutex_;
+		std::atomic<int> filter_parameters_version_ = 1;
+		int applied_filter_parameters_version_ = 0;
 		struct FilterParameters {
 			float input_cycles_per_second = 0.0f;
 			float output_cycles_per_second = 0.0f;
@@ -225,6 +315,7 @@ template <typename SampleSource> class LowpassSpeaker: public Speaker {
 
 			step_rate_ = filter_parameters.input_cycles_per_second / filter_parameters.output_cycles_per_second;
 			position_error_ = 0.0f;
+			window_offset_ = 0;
 
 			filter_ = std::make_unique<SignalProcessing::FIRFilter>(
 				unsigned(number_of_taps),
@@ -257,14 +348,20 @@ template <typename SampleSource> class LowpassSpeaker: public Speaker {
 				default: break;
 
 				case Conversion::ResampleSmaller: {
+					// The input buffer holds enough for a filter window plus a block of further input,
+					// so that many output samples can be produced for each eventual shuffle of the buffer.
+					//
 					// Reize the input buffer only if absolutely necessary; if sizing downward
-					// such that a sample would otherwise be lost then output it now. Keep anything
+					// such that samples would otherwise be lost then output them now. Keep anything
 					// currently in the input buffer that hasn't yet been processed.
-					const size_t required_buffer_size = size_t(number_of_taps) * (SampleSource::get_is_stereo() ? 2 : 1);
+					const size_t required_buffer_size =
+						(size_t(number_of_taps) + InputBlockSize) * (SampleSource::get_is_stereo() ? 2 : 1);
 					if(input_buffer_.size() != required_buffer_size) {
-						if(input_buffer_depth_ >= required_buffer_size) {
+						if(input_buffer_depth_ > required_buffer_size) {
 							resample_input_buffer(scale);
-							input_buffer_depth_ %= required_buffer_size;
+						}
+						if(input_buffer_depth_ > required_buffer_size) {
+							input_buffer_depth_ = 0;
 						}
 						input_buffer_.resize(required_buffer_size);
 					}
@@ -272,51 +369,52 @@ template <typename SampleSource> class LowpassSpeaker: public Speaker {
 			}
 		}
 
-		inline void resample_input_buffer(int scale) {
-			if constexpr (SampleSource::get_is_stereo()) {
-				output_buffer_[output_buffer_pointer_ + 0] = filter_->apply(input_buffer_.data(), 2);
-				output_buffer_[output_buffer_pointer_ + 1] = filter_->apply(input_buffer_.data() + 1, 2);
-				output_buffer_pointer_+= 2;
-			} else {
-				output_buffer_[output_buffer_pointer_] = filter_->apply(input_buffer_.data());
-				output_buffer_pointer_++;
-			}
+		/// The number of input frames beyond the length of the filter that are buffered before filtering.
+		static constexpr size_t InputBlockSize = 2048;
 
-			// Apply scale, if supplied, clamping appropriately.
-			if(scale != 65536) {
-				#define SCALE(x) x = int16_t(std::max(std::min((int(x) * scale) >> 16, 32767), -32768))
-				if constexpr (SampleSource::get_is_stereo()) {
-					SCALE(output_buffer_[output_buffer_pointer_ - 2]);
-					SCALE(output_buffer_[output_buffer_pointer_ - 1]);
-				} else {
-					SCALE(output_buffer_[output_buffer_pointer_ - 1]);
+		inline void resample_input_buffer(int scale) {
+			constexpr int channels = SampleSource::get_is_stereo() ? 2 : 1;
+
+			// Filter as much of the input buffer as possible, announcing output whenever the output buffer fills.
+			while(true) {
+				const size_t outputs = filter_->template apply<channels>(
+					input_buffer_.data(), input_buffer_depth_ / channels,
+					&output_buffer_[output_buffer_pointer_], (output_buffer_.size() - output_buffer_pointer_) / channels,
+					step_rate_, window_offset_, position_error_);
+				if(!outputs) break;
+
+				// Apply scale, if supplied, clamping appropriately.
+				if(scale != 65536) {
+					for(size_t c = 0; c < outputs * channels; c++) {
+						auto &sample = output_buffer_[output_buffer_pointer_ + c];
+						sample = int16_t(std::max(std::min((int(sample) * scale) >> 16, 32767), -32768));
+					}
 				}
-				#undef SCALE
-			}
+				output_buffer_pointer_ += outputs * channels;
 
-			// Announce to delegate if full.
-			if(output_buffer_pointer_ == output_buffer_.size()) {
-				output_buffer_pointer_ = 0;
-				did_complete_samples(this, output_buffer_, SampleSource::get_is_stereo());
+				// Announce to delegate if full.
+				if(output_buffer_pointer_ == output_buffer_.size()) {
+					output_buffer_pointer_ = 0;
+					did_complete_samples(this, output_buffer_, SampleSource::get_is_stereo());
+				}
 			}
 
-			// If the next loop around is going to reuse some of the samples just collected, use a memmove to
-			// preserve them in the correct locations (TODO: use a longer buffer to fix that?) and don't skip
-			// anything. Otherwise skip as required to get to the next sample batch and don't expect to reuse.
-			const size_t steps = size_t(step_rate_ + position_error_) * (SampleSource::get_is_stereo() ? 2 : 1);
-			position_error_ = fmodf(step_rate_ + position_error_, 1.0f);
-			if(steps < input_buffer_.size()) {
+			// Preserve whatever will be used by the next window, if anything; otherwise skip as
+			// required to get to the next sample batch.
+			const size_t consumed = window_offset_ * channels;
+			if(consumed < input_buffer_depth_) {
 				auto *const input_buffer = input_buffer_.data();
 				std::memmove(	input_buffer,
-								&input_buffer[steps],
-								sizeof(int16_t) * (input_buffer_.size() - steps));
-				input_buffer_depth_ -= steps;
+								&input_buffer[consumed],
+								sizeof(int16_t) * (input_buffer_depth_ - consumed));
+				input_buffer_depth_ -= consumed;
 			} else {
-				if(steps > input_buffer_.size()) {
-					sample_source_.skip_samples((steps - input_buffer_.size()) / (SampleSource::get_is_stereo() ? 2 : 1));
+				if(consumed > input_buffer_depth_) {
+					sample_source_.skip_samples((consumed - input_buffer_depth_) / channels);
 				}
 				input_buffer_depth_ = 0;
 			}
+			window_offset_ = 0;
 		}
 
 		int get_scale() {
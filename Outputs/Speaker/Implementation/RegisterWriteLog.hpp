@@ -0,0 +1,104 @@
+//
+//  RegisterWriteLog.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 14/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#ifndef RegisterWriteLog_hpp
+#define RegisterWriteLog_hpp
+
+#include "../../../Concurrency/AsyncTaskQueue.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Outputs {
+namespace Speaker {
+
+/*!
+	Records writes to the registers of a sample source, so that they can be applied on the audio
+	thread without deferring a function for each.
+
+	Writes are held in a fixed-size ring buffer, and each run of writes that is made without any other
+	use of the DeferringAsyncTaskQueue in between is applied by a single deferred function. That function
+	occupies the queue position that the first of those writes would have if it had been deferred
+	individually, so the sample source observes exactly the same sequence of writes and speaker
+	advancements as it otherwise would.
+
+	@c Target should implement `void apply_register_write(uint16_t address, uint8_t value)`, which will
+	be called on the audio thread. It may be private if @c Target befriends this class.
+*/
+template <typename Target> class RegisterWriteLog {
+	public:
+		/// The number of writes that can be logged before a writer has to wait for earlier writes to be applied.
+		static constexpr size_t Capacity = 2048;
+
+		RegisterWriteLog(Concurrency::DeferringAsyncTaskQueue &queue, Target &target) :
+			queue_(queue), target_(target), writes_(Capacity), batch_lengths_(Capacity) {}
+
+		/*!
+			Logs a write of @c value to @c address.
+
+			This is not thread safe; it should be serialised with all other uses of the queue.
+		*/
+		void write(uint16_t address, uint8_t value) {
+			// If the ring buffer is full, wait until everything logged so far has been applied.
+			if(write_index_ - read_index_.load(std::memory_order_acquire) == Capacity) {
+				queue_.perform();
+				queue_.flush();
+			}
+
+			// Extend the current batch if nothing else has been deferred since it began, and it hasn't
+			// yet been made performable; otherwise start a new batch with its own deferred function.
+			if(queue_.get_modification_count() != batch_modification_count_) {
+				batch_begin_ = write_index_;
+				batch_lengths_[batch_begin_ & (Capacity - 1)] = 0;
+				queue_.defer([this, begin = batch_begin_] {
+					apply(begin);
+				});
+				batch_modification_count_ = queue_.get_modification_count();
+			}
+
+			writes_[write_index_ & (Capacity - 1)] = Write{address, value};
+			++write_index_;
+			++batch_lengths_[batch_begin_ & (Capacity - 1)];
+		}
+
+	private:
+		Concurrency::DeferringAsyncTaskQueue &queue_;
+		Target &target_;
+
+		struct Write {
+			uint16_t address;
+			uint8_t value;
+		};
+		std::vector<Write> writes_;
+
+		// The length of each batch is stored at the index of its first write; it is final once
+		// the batch's function has been made performable, which precedes that function being called.
+		std::vector<uint16_t> batch_lengths_;
+		size_t batch_begin_ = 0;
+		size_t batch_modification_count_ = ~size_t(0);
+
+		// All indices increase monotonically and are mapped into the ring buffer by masking.
+		size_t write_index_ = 0;
+		std::atomic<size_t> read_index_ = 0;
+
+		void apply(size_t begin) {
+			const size_t end = begin + batch_lengths_[begin & (Capacity - 1)];
+			for(size_t index = begin; index != end; ++index) {
+				const Write &write = writes_[index & (Capacity - 1)];
+				target_.apply_register_write(write.address, write.value);
+			}
+			read_index_.store(end, std::memory_order_release);
+		}
+};
+
+}
+}
+
+#endif /* RegisterWriteLog_hpp */
@@ -24,9 +24,16 @@ class SampleSource {
 	public:
 		/*!
 			Should write the next @c number_of_samples to @c target.
+
+			When called by a CompoundSource, @c target will be aligned to at least @c BufferAlignment
+			bytes and @c number_of_samples will be no greater than @c MaxBlockSize, permitting simple
+			vectorised loops.
 		*/
 		void get_samples([[maybe_unused]] std::size_t number_of_samples, [[maybe_unused]] std::int16_t *target) {}
 
+		static constexpr std::size_t BufferAlignment = 16;
+		static constexpr std::size_t MaxBlockSize = 256;
+
 		/*!
 			Should skip the next @c number_of_samples. Subclasses of this SampleSource
 			need not implement this if it would no more efficient to do so than it is
@@ -47,6 +54,17 @@ class SampleSource {
 			return false;
 		}
 
+		/*!
+			@returns @c true if it is trivially true that a call to get_samples would just
+				fill the target with a single repeated sample — or, for stereo sources, a single
+				repeated pair — in which case that value is written to @c level; @c false otherwise.
+
+			If this returns @c true then a CompoundSource will call skip_samples rather than get_samples.
+		*/
+		bool get_constant_level([[maybe_unused]] std::int16_t *level) const {
+			return false;
+		}
+
 		/*!
 			Sets the proper output range for this sample source; it should write values
 			between 0 and volume.
@@ -10,6 +10,7 @@
 #define Speaker_hpp
 
 #include <atomic>
+#include <cstddef>
 #include <cstdint>
 #include <vector>
 
@@ -58,9 +59,18 @@ class Speaker {
 		/// Sets the output volume, in the range [0, 1].
 		virtual void set_output_volume(float) = 0;
 
+		/*!
+			Mutes or unmutes this speaker independently of its output volume. A muted speaker advances
+			its source without generating any audio, and supplies silence to its delegate.
+		*/
+		virtual void set_is_muted(bool) {}
+
 		/*!
 			Speeds a speed multiplier for this machine, e.g. that it is currently being run at 2.0x its normal rate.
 			This will affect the number of input samples that are combined to produce one output sample.
+
+			At multipliers of @c FastForwardMultiplier or more, speakers may output silence rather than
+			generating audio.
 		*/
 		void set_input_rate_multiplier(float multiplier) {
 			input_rate_multiplier_ = multiplier;
@@ -72,6 +82,25 @@ class Speaker {
 		*/
 		int completed_sample_sets() const { return completed_sample_sets_; }
 
+		/*!
+			@returns The number of samples that have been produced but not yet delivered to the delegate because
+			they don't yet fill a packet, counted as they will be delivered, i.e. with one per channel per sample.
+
+			This may be called only when the speaker isn't running, e.g. after flushing its task queue.
+		*/
+		size_t undelivered_samples() const {
+			return buffered_samples_per_channel() * (stereo_output_ ? 2 : 1);
+		}
+
+		/*!
+			@returns The number of bytes of host memory occupied by this speaker's sample buffers and filter.
+
+			This may be called only when the speaker isn't running, e.g. after flushing its task queue.
+		*/
+		virtual size_t get_memory_footprint() const {
+			return mix_buffer_.capacity() * sizeof(int16_t);
+		}
+
 		/*!
 			Defines a receiver for audio packets.
 		*/
@@ -92,6 +121,11 @@ class Speaker {
 			delegate_.store(delegate, std::memory_order::memory_order_relaxed);
 		}
 
+		/// @returns The delegate most recently supplied to @c set_delegate, if any.
+		Delegate *get_delegate() const {
+			return delegate_.load(std::memory_order::memory_order_relaxed);
+		}
+
 
 		// This is primarily exposed for MultiSpeaker et al; it's not for general callers.
 		virtual void set_computed_output_rate(float cycles_per_second, int buffer_size, bool stereo) = 0;
@@ -130,6 +164,18 @@ class Speaker {
 		}
 		std::atomic<Delegate *> delegate_{nullptr};
 
+		/// @returns The number of samples per channel currently buffered towards the next packet, if known; otherwise 0.
+		virtual size_t buffered_samples_per_channel() const { return 0; }
+
+		/// Speed multipliers of at least this are taken to be fast-forwarding, as distinct from the small
+		/// adjustments that hosts make in order to synchronise with their displays.
+		static constexpr float FastForwardMultiplier = 1.25f;
+
+		/// @returns @c true if the current input rate multiplier indicates fast-forwarding.
+		bool is_fast_forwarding() const {
+			return input_rate_multiplier_.load(std::memory_order::memory_order_relaxed) >= FastForwardMultiplier;
+		}
+
 	private:
 		void compute_output_rate() {
 			// The input rate multiplier is actually used as an output rate divider,
@@ -138,7 +184,7 @@ class Speaker {
 		}
 
 		int completed_sample_sets_ = 0;
-		float input_rate_multiplier_ = 1.0f;
+		std::atomic<float> input_rate_multiplier_ = 1.0f;
 		float output_cycles_per_second_ = 1.0f;
 		int output_buffer_size_ = 1;
 		std::atomic<bool> stereo_output_{false};
@@ -0,0 +1,148 @@
+//
+//  Trace.cpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 14/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#include "Trace.hpp"
+
+#include "../Concurrency/AsyncTaskQueue.hpp"
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstring>
+#include <iterator>
+#include <memory>
+
+using namespace Outputs::Trace;
+
+namespace Outputs {
+namespace Trace {
+namespace Internal {
+
+std::array<Entry, BufferSize> buffer;
+std::atomic<size_t> write_pointer{0};
+std::array<std::atomic<Level>, size_t(Category::Count)> minimum_levels = {
+	Level::Info, Level::Info, Level::Info, Level::Info, Level::Info,
+};
+static_assert(size_t(Category::Count) == 5, "Provide an initial minimum level for each category");
+
+uint64_t timestamp() {
+	static const auto epoch = std::chrono::steady_clock::now();
+	return uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch).count());
+}
+
+}
+}
+}
+
+namespace {
+
+Concurrency::AsyncTaskQueue &dump_queue() {
+	static Concurrency::AsyncTaskQueue queue;
+	return queue;
+}
+
+constexpr const char *category_names[] = {
+	"CPU", "Disk", "Video", "Audio", "Machine",
+};
+static_assert(std::size(category_names) == size_t(Category::Count));
+
+constexpr const char *level_names[] = {
+	"verbose", "info", "warning", "error",
+};
+
+}
+
+void Outputs::Trace::set_minimum_level(Category category, Level level) {
+	Internal::minimum_levels[size_t(category)] = level;
+}
+
+std::vector<Entry> Outputs::Trace::snapshot() {
+	// Entries may be overwritten while being copied if other threads are actively
+	// tracing; that is accepted as the cost of not synchronising the producers.
+	const size_t end = Internal::write_pointer.load(std::memory_order_acquire);
+	const size_t count = std::min(end, Internal::BufferSize);
+
+	std::vector<Entry> entries;
+	entries.reserve(count);
+	for(size_t index = end - count; index != end; ++index) {
+		entries.push_back(Internal::buffer[index & (Internal::BufferSize - 1)]);
+	}
+	return entries;
+}
+
+std::string Outputs::Trace::format(const Entry &entry) {
+	char prefix[64];
+	snprintf(prefix, sizeof(prefix), "%12.6f [%s:%s] ",
+		double(entry.timestamp) / 1e9,
+		category_names[size_t(entry.category)],
+		level_names[std::min(size_t(entry.level), std::size(level_names) - 1)]);
+	std::string result = prefix;
+	if(!entry.format) return result;
+
+	// Substitute arguments according to each conversion; all are stored as 64-bit
+	// quantities so each specification is widened before use.
+	int argument = 0;
+	for(const char *cursor = entry.format; *cursor; ++cursor) {
+		if(*cursor != '%') {
+			result.push_back(*cursor);
+			continue;
+		}
+		if(cursor[1] == '%') {
+			result.push_back('%');
+			++cursor;
+			continue;
+		}
+
+		const char *const start = cursor++;
+		while(*cursor && strchr("-+ #0123456789", *cursor)) ++cursor;
+		if(!*cursor) break;
+
+		const char conversion = *cursor;
+		const uint64_t value = argument < Entry::MaxArguments ? entry.arguments[argument++] : 0;
+
+		char specification[32];
+		const int flags_length = std::min(int(cursor - start), int(sizeof(specification)) - 8);
+		memcpy(specification, start, size_t(flags_length));
+
+		char formatted[64];
+		switch(conversion) {
+			case 'd': case 'i':
+				strcpy(&specification[flags_length], PRId64);
+				snprintf(formatted, sizeof(formatted), specification, int64_t(value));
+			break;
+			case 'u': case 'x': case 'X': case 'o':
+				specification[flags_length] = '\0';
+				strcat(specification, conversion == 'u' ? PRIu64 : conversion == 'x' ? PRIx64 : conversion == 'X' ? PRIX64 : PRIo64);
+				snprintf(formatted, sizeof(formatted), specification, value);
+			break;
+			case 'c':
+				specification[flags_length] = 'c';
+				specification[flags_length + 1] = '\0';
+				snprintf(formatted, sizeof(formatted), specification, int(value));
+			break;
+			default:
+				snprintf(formatted, sizeof(formatted), "<%c?>", conversion);
+			break;
+		}
+		result += formatted;
+	}
+	return result;
+}
+
+void Outputs::Trace::dump(FILE *file) {
+	auto entries = std::make_shared<std::vector<Entry>>(snapshot());
+	dump_queue().enqueue([entries, file] {
+		for(const auto &entry: *entries) {
+			fprintf(file, "%s\n", format(entry).c_str());
+		}
+		fflush(file);
+	});
+}
+
+void Outputs::Trace::flush() {
+	dump_queue().flush();
+}
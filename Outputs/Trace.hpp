@@ -0,0 +1,151 @@
+//
+//  Trace.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 14/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#ifndef Trace_hpp
+#define Trace_hpp
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+/*!
+	A binary trace facility, cheap enough to leave enabled.
+
+	Each trace point records a fixed-size entry — a timestamp, category, level, format
+	string and up to four integral or pointer arguments — into a process-wide ring buffer,
+	without any formatting. Entries are formatted only when the buffer is dumped, and then
+	off the calling thread.
+
+	Categories are filtered at compile time via TRACE_CATEGORIES, a bitmask of
+	(1 << Category) values that defaults to all categories; a category that is compiled
+	out costs nothing. Each category also has a runtime minimum level.
+
+	Format strings use printf conversions (d, i, u, x, X, o and c, with optional flags and
+	width) and must be string literals, as only their addresses are stored.
+*/
+#define TRACE(category, level, ...)	\
+	::Outputs::Trace::record<::Outputs::Trace::Category::category>(::Outputs::Trace::Level::level, __VA_ARGS__)
+
+#ifndef TRACE_CATEGORIES
+#define TRACE_CATEGORIES 0xffffffff
+#endif
+
+namespace Outputs {
+namespace Trace {
+
+enum class Category: uint8_t {
+	CPU,
+	DiskController,
+	Video,
+	Audio,
+	Machine,
+
+	Count
+};
+
+enum class Level: uint8_t {
+	Verbose,
+	Info,
+	Warning,
+	Error,
+
+	/// Permitted only as a runtime minimum, to disable a category.
+	None
+};
+
+struct Entry {
+	static constexpr int MaxArguments = 4;
+
+	/// Nanoseconds since the first trace point was recorded.
+	uint64_t timestamp = 0;
+	const char *format = nullptr;
+	uint64_t arguments[MaxArguments]{};
+	Category category = Category::Machine;
+	Level level = Level::Verbose;
+};
+
+/// @returns @c true if @c category has been compiled in.
+constexpr bool is_compiled_in(Category category) {
+	return (TRACE_CATEGORIES) & (1u << unsigned(category));
+}
+
+/// Sets the minimum level that will be recorded for @c category; the default is @c Level::Info.
+void set_minimum_level(Category category, Level level);
+
+/// @returns A copy of all entries currently in the ring buffer, oldest first.
+std::vector<Entry> snapshot();
+
+/// @returns @c entry formatted as a single line of text, without a trailing newline.
+std::string format(const Entry &entry);
+
+/*!
+	Takes a snapshot of the ring buffer and then, asynchronously, formats it to @c file,
+	which the caller should not close until @c flush has been called.
+*/
+void dump(FILE *file);
+
+/// Blocks until any dumps that are underway have completed.
+void flush();
+
+// MARK: - Implementation details.
+
+namespace Internal {
+
+constexpr size_t BufferSize = 8192;
+static_assert(!(BufferSize & (BufferSize - 1)), "The trace buffer must be a power of two in size");
+
+extern std::array<Entry, BufferSize> buffer;
+extern std::atomic<size_t> write_pointer;
+extern std::array<std::atomic<Level>, size_t(Category::Count)> minimum_levels;
+
+uint64_t timestamp();
+
+template <typename T> constexpr uint64_t argument(T value) {
+	if constexpr (std::is_pointer_v<T>) {
+		return uint64_t(reinterpret_cast<uintptr_t>(value));
+	} else {
+		static_assert(std::is_integral_v<T> || std::is_enum_v<T>, "Trace arguments must be integral, enumerations or pointers");
+		if constexpr (std::is_signed_v<T>) {
+			return uint64_t(int64_t(value));
+		} else {
+			return uint64_t(value);
+		}
+	}
+}
+
+}
+
+template <Category category, typename... Args> inline void record(Level level, const char *format, Args... args) {
+	static_assert(sizeof...(Args) <= Entry::MaxArguments, "Too many trace arguments");
+	if constexpr (is_compiled_in(category)) {
+		if(level < Internal::minimum_levels[size_t(category)].load(std::memory_order_relaxed)) return;
+
+		Entry &entry = Internal::buffer[Internal::write_pointer.fetch_add(1, std::memory_order_relaxed) & (Internal::BufferSize - 1)];
+		entry.timestamp = Internal::timestamp();
+		entry.format = format;
+		entry.category = category;
+		entry.level = level;
+
+		size_t index = 0;
+		((entry.arguments[index++] = Internal::argument(args)), ...);
+	} else {
+		(void)level;
+		(void)format;
+		((void)args, ...);
+	}
+}
+
+}
+}
+
+#endif /* Trace_hpp */
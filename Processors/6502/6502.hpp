@@ -9,14 +9,17 @@
 #ifndef MOS6502_cpp
 #define MOS6502_cpp
 
+#include <array>
 #include <cassert>
 #include <cstdio>
 #include <cstdint>
 
 #include "../6502Esque/6502Esque.hpp"
 #include "../6502Esque/Implementation/LazyFlags.hpp"
+#include "../PCProfiler.hpp"
 #include "../RegisterSizes.hpp"
 #include "../../ClockReceiver/ClockReceiver.hpp"
+#include "../../ClockReceiver/ForceInline.hpp"
 
 namespace CPU {
 namespace MOS6502 {
@@ -57,6 +60,16 @@ class ProcessorBase: public ProcessorStorage {
 	public:
 		ProcessorBase(Personality personality) : ProcessorStorage(personality) {}
 
+		/// Attaches @c profiler, which will be supplied with program counter samples if CPU_PROFILING is enabled.
+		void set_profiler(CPU::PCProfiler *profiler) {
+			profiler_ = profiler;
+		}
+
+		/// @returns The number of bytes occupied by this processor's micro-op programs.
+		size_t get_table_footprint() const {
+			return sizeof(operations_);
+		}
+
 		/*!
 			Gets the value of a register.
 
@@ -134,8 +147,11 @@ class ProcessorBase: public ProcessorStorage {
 	will announce its cycle-by-cycle activity via the bus handler, which is responsible for marrying it to a bus. They
 	can also nominate whether the processor includes support for the ready line. Declining to support the ready line
 	can produce a minor runtime performance improvement.
+
+	Similarly they can nominate whether the processor supports direct fetch, by which it reads operands from memory
+	published via @c set_fetch_pages without involving the bus handler. Support costs a little even if nothing is published.
 */
-template <Personality personality, typename BusHandler, bool uses_ready_line> class Processor: public ProcessorBase {
+template <Personality personality, typename BusHandler, bool uses_ready_line, bool uses_direct_fetch = false> class Processor: public ProcessorBase {
 	public:
 		/*!
 			Constructs an instance of the 6502 that will use @c bus_handler for all bus communications.
@@ -156,8 +172,38 @@ template <Personality personality, typename BusHandler, bool uses_ready_line> cl
 		*/
 		void set_ready_line(bool active);
 
+		/*!
+			Publishes @c data as the memory that operands should be read from in the range [@c start, @c start + @c length),
+			which must be aligned to 256-byte boundaries; supply @c nullptr to return the range to the bus handler.
+			Available only if this processor was declared to use direct fetch.
+
+			Within published ranges the 6502 will read the bytes that follow each opcode directly rather than announcing
+			those reads; opcode fetches themselves are always announced, as are all other accesses. The time taken by
+			direct reads is announced via the bus handler's @c perform_direct_fetches immediately ahead of its next call.
+			In the meantime the bus handler doesn't run, so any interrupt that it would have signalled during those
+			cycles is observed late.
+
+			So only ranges in which reading has no side effects and never lengthens a cycle should be published.
+			Publications remain in effect until replaced, so should be updated whenever paging changes.
+		*/
+		void set_fetch_pages(uint16_t start, std::size_t length, const uint8_t *data) {
+			static_assert(uses_direct_fetch);
+			assert(!(start & 0xff) && !(length & 0xff) && start + length <= 0x10000);
+			for(std::size_t page = start >> 8; page < (start + length) >> 8; page++) {
+				fetch_pages_[page] = data;
+				if(data) data += 0x100;
+			}
+		}
+
 	private:
 		BusHandler &bus_handler_;
+
+		// Direct fetch support; the page table is empty unless enabled.
+		Cycles unannounced_fetch_cycles_;
+		std::array<const uint8_t *, uses_direct_fetch ? 256 : 0> fetch_pages_{};
+
+		// Announces time spent on direct operand reads since the last announcement.
+		forceinline void announce_direct_fetches();
 };
 
 #include "Implementation/6502Implementation.hpp"
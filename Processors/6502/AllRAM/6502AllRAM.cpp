@@ -7,6 +7,8 @@
 //
 
 #include "6502AllRAM.hpp"
+#include "../State/State.hpp"
+#include "../../../InstructionSets/6502/Executor.hpp"
 
 #include <algorithm>
 #include <cstring>
@@ -19,16 +21,25 @@ namespace {
 
 using Type = CPU::MOS6502Esque::Type;
 
-template <Type type> class ConcreteAllRAMProcessor: public AllRAMProcessor, public BusHandler {
+template <Type type, bool uses_direct_fetch> class ConcreteAllRAMProcessor:
+	public AllRAMProcessor, public BusHandler, public InstructionSet::MOS6502::BusHandler {
 	public:
+		/// The caching executor implements only the NMOS instruction set, with or without decimal mode.
+		static constexpr bool SupportsCachingExecutor = type == Type::T6502 || type == Type::TNES6502;
+
 		ConcreteAllRAMProcessor(size_t memory_size) :
 			AllRAMProcessor(memory_size),
-			mos6502_(*this) {
+			mos6502_(*this),
+			executor_(memory_.data(), *this, type != Type::TNES6502) {
 			mos6502_.set_power_on(false);
+			if constexpr (uses_direct_fetch) {
+				mos6502_.set_fetch_pages(0, memory_.size(), memory_.data());
+			}
 		}
 
 		inline Cycles perform_bus_operation(BusOperation operation, uint32_t address, uint8_t *value) {
 			timestamp_ += Cycles(1);
+			processor_has_run_ = true;
 
 			if(isAccessOperation(operation)) {
 				if(operation == BusOperation::ReadOpcode) {
@@ -42,6 +53,7 @@ template <Type type> class ConcreteAllRAMProcessor: public AllRAMProcessor, publ
 #endif
 					check_address_for_trap(address);
 					--instructions_;
+					++instruction_count_;
 				}
 
 				if(isReadOperation(operation)) {
@@ -64,46 +76,153 @@ template <Type type> class ConcreteAllRAMProcessor: public AllRAMProcessor, publ
 			return Cycles(1);
 		}
 
-		void run_for(const Cycles cycles) {
-			mos6502_.run_for(cycles);
+		void perform_direct_fetches(Cycles cycles) {
+			timestamp_ += cycles;
+		}
+
+		void run_for(const Cycles cycles) final {
+			if(!uses_caching_executor_) {
+				use_processor();
+				mos6502_.run_for(cycles);
+				return;
+			}
+
+			Cycles remaining = cycles;
+			if(!executor_is_active_) {
+				// The executor can pick up only immediately after an opcode fetch, or from a jam.
+				while(!processor_is_at_handover_point() && remaining > Cycles(0)) {
+					mos6502_.run_for(Cycles(1));
+					--remaining;
+				}
+				if(!processor_is_at_handover_point()) return;
+
+				// Memory may have been modified by the processor since the executor last ran.
+				executor_.memory_did_change(0x0000, 0xffff);
+				if constexpr (SupportsCachingExecutor) {
+					executor_.set_state(CPU::MOS6502::State(mos6502_));
+				}
+				executor_is_active_ = true;
+			}
+
+			executor_.run_for(remaining);
+			timestamp_ += remaining;
 		}
 
-		void run_for_instructions(int count) {
+		void run_for_instructions(int count) final {
+			use_processor();
 			instructions_ = count;
+
+			// Every instruction takes at least one cycle — the 65C02 has some single-cycle NOPs —
+			// so a run of one fewer cycle than there are instructions outstanding can't overshoot;
+			// use that to get close in bulk before proceeding a cycle at a time.
+			while(instructions_ > 1) {
+				mos6502_.run_for(Cycles(instructions_ - 1));
+			}
 			while(instructions_) {
 				mos6502_.run_for(Cycles(1));
 			}
 		}
 
-		bool is_jammed() {
-			return mos6502_.is_jammed();
+		bool is_jammed() final {
+			return executor_is_active_ ? executor_.is_jammed() : mos6502_.is_jammed();
 		}
 
-		void set_irq_line(bool value) {
-			mos6502_.set_irq_line(value);
+		void set_irq_line(bool value) final {
+			if(executor_is_active_) {
+				executor_.set_irq_line(value);
+			} else {
+				mos6502_.set_irq_line(value);
+			}
 		}
 
-		void set_nmi_line(bool value) {
-			mos6502_.set_nmi_line(value);
+		void set_nmi_line(bool value) final {
+			if(executor_is_active_) {
+				executor_.set_nmi_line(value);
+			} else {
+				mos6502_.set_nmi_line(value);
+			}
+		}
+
+		uint16_t get_value_of_register(Register r) final {
+			return executor_is_active_ ? executor_.get_value_of_register(r) : mos6502_.get_value_of_register(r);
 		}
 
-		uint16_t get_value_of_register(Register r) {
-			return mos6502_.get_value_of_register(r);
+		void set_value_of_register(Register r, uint16_t value) final {
+			if(executor_is_active_) {
+				executor_.set_value_of_register(r, value);
+			} else {
+				mos6502_.set_value_of_register(r, value);
+			}
 		}
 
-		void set_value_of_register(Register r, uint16_t value) {
-			mos6502_.set_value_of_register(r, value);
+		void set_uses_caching_executor(bool uses_caching_executor) final {
+			uses_caching_executor_ = SupportsCachingExecutor && uses_caching_executor;
+			if(!uses_caching_executor_) use_processor();
+		}
+
+		// InstructionSet::MOS6502::BusHandler.
+		void did_reach_trap(uint16_t address) final {
+			check_address_for_trap(address);
+		}
+
+	protected:
+		void did_set_data(size_t start_address, size_t end_address) final {
+			if(SupportsCachingExecutor && end_address > start_address) {
+				executor_.memory_did_change(uint16_t(start_address), uint16_t(end_address - 1));
+			}
+		}
+
+		void did_add_trap_address(uint16_t address) final {
+			if(SupportsCachingExecutor) {
+				executor_.add_trap_address(address);
+			}
 		}
 
 	private:
-		CPU::MOS6502Esque::Processor<type, ConcreteAllRAMProcessor, false> mos6502_;
+		CPU::MOS6502Esque::Processor<type, ConcreteAllRAMProcessor, false, uses_direct_fetch> mos6502_;
 		int instructions_ = 0;
+
+		InstructionSet::MOS6502::Executor executor_;
+		bool uses_caching_executor_ = false;
+		bool executor_is_active_ = false;
+		bool processor_has_run_ = false;
+
+		/// @returns @c true if the processor is jammed or has just fetched an opcode, so that the executor can take over.
+		bool processor_is_at_handover_point() {
+			// State can't be captured from a processor that has yet to start.
+			if constexpr (SupportsCachingExecutor) {
+				if(!processor_has_run_) return false;
+				if(mos6502_.is_jammed()) return true;
+
+				// Micro-program 256 is FetchDecodeExecute; offset 1 follows its opcode fetch.
+				const CPU::MOS6502::State state(mos6502_);
+				return state.execution_state.micro_program == 256 && state.execution_state.micro_program_offset == 1;
+			} else {
+				return false;
+			}
+		}
+
+		/// Hands execution back to the cycle-exact 6502 if the executor currently has it.
+		void use_processor() {
+			if constexpr (SupportsCachingExecutor) {
+				if(!executor_is_active_) return;
+
+				CPU::MOS6502::State state;
+				executor_.get_state(state);
+				state.apply(mos6502_);
+				executor_is_active_ = false;
+			}
+		}
 };
 
 }
 
-AllRAMProcessor *AllRAMProcessor::Processor(Type type) {
-#define Bind(p) case p: return new ConcreteAllRAMProcessor<p>(type == Type::TWDC65816 ? 16*1024*1024 : 64*1024);
+AllRAMProcessor *AllRAMProcessor::Processor(Type type, bool uses_direct_fetch) {
+#define Bind(p)	\
+	case p:	\
+		if(uses_direct_fetch) return new ConcreteAllRAMProcessor<p, true>(64*1024);	\
+		return new ConcreteAllRAMProcessor<p, false>(64*1024);
+
 	switch(type) {
 		default:
 		Bind(Type::T6502)
@@ -111,7 +230,9 @@ AllRAMProcessor *AllRAMProcessor::Processor(Type type) {
 		Bind(Type::TSynertek65C02)
 		Bind(Type::TWDC65C02)
 		Bind(Type::TRockwell65C02)
-		Bind(Type::TWDC65816)
+
+		// The 65816 doesn't offer direct fetch.
+		case Type::TWDC65816: return new ConcreteAllRAMProcessor<Type::TWDC65816, false>(16*1024*1024);
 	}
 #undef Bind
 }
@@ -18,7 +18,12 @@ namespace MOS6502 {
 class AllRAMProcessor:
 	public ::CPU::AllRAMProcessor {
 	public:
-		static AllRAMProcessor *Processor(CPU::MOS6502Esque::Type type);
+		/*!
+			@returns A new all-RAM processor of type @c type. If @c uses_direct_fetch is @c true then, other than on the 65816,
+			the processor reads operands straight from memory; opcode fetches, and therefore traps and instruction counts,
+			are unaffected. See CPU::MOS6502::Processor::set_fetch_pages.
+		*/
+		static AllRAMProcessor *Processor(CPU::MOS6502Esque::Type type, bool uses_direct_fetch = false);
 		virtual ~AllRAMProcessor() {}
 
 		virtual void run_for(const Cycles cycles) = 0;
@@ -29,8 +34,21 @@ class AllRAMProcessor:
 		virtual uint16_t get_value_of_register(Register r) = 0;
 		virtual void set_value_of_register(Register r, uint16_t value) = 0;
 
+		/*!
+			Enables or disables use of InstructionSet::MOS6502::Executor, which runs translated code with only
+			whole-instruction timing and accepts interrupts only at branches; it is available for the NMOS 6502
+			types only, and is ignored otherwise. Execution moves between it and the cycle-exact 6502 after opcode fetches.
+		*/
+		virtual void set_uses_caching_executor(bool uses_caching_executor) = 0;
+
+		/// @returns The number of instructions begun since construction, e.g. for measuring throughput.
+		uint64_t get_instruction_count() const {
+			return instruction_count_;
+		}
+
 	protected:
 		AllRAMProcessor(size_t memory_size) : ::CPU::AllRAMProcessor(memory_size) {}
+		uint64_t instruction_count_ = 0;
 };
 
 }
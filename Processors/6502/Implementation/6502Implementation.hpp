@@ -12,7 +12,18 @@
 	6502.hpp, but it's implementation stuff.
 */
 
-template <Personality personality, typename T, bool uses_ready_line> void Processor<personality, T, uses_ready_line>::run_for(const Cycles cycles) {
+// Where supported, micro-ops are dispatched by computed goto rather than by switch, which avoids the
+// switch's range check and gives the branch predictor a separate indirect jump at the end of each
+// micro-op. The switch is retained, both for other compilers and so that break and continue keep
+// their meanings within each micro-op.
+#if defined(__GNUC__) || defined(__clang__)
+#define MOS6502_USES_THREADED_DISPATCH
+#define MicroOpCase(x)	case x: threaded_##x
+#else
+#define MicroOpCase(x)	case x
+#endif
+
+template <Personality personality, typename T, bool uses_ready_line, bool uses_direct_fetch> void Processor<personality, T, uses_ready_line, uses_direct_fetch>::run_for(const Cycles cycles) {
 #define checkSchedule() \
 	if(!scheduled_program_counter_) {\
 		if(interrupt_requests_) {\
@@ -33,22 +44,113 @@ template <Personality personality, typename T, bool uses_ready_line> void Proces
 #define bus_access() \
 	interrupt_requests_ = (interrupt_requests_ & ~InterruptRequestFlags::IRQ) | irq_request_history_;	\
 	irq_request_history_ = irq_line_ & flags_.inverse_interrupt;	\
+	if(uses_direct_fetch && unannounced_fetch_cycles_ > Cycles(0)) announce_direct_fetches();	\
 	number_of_cycles -= bus_handler_.perform_bus_operation(next_bus_operation_, bus_address_, bus_value_);	\
 	next_bus_operation_ = BusOperation::None;	\
 	if(number_of_cycles <= Cycles(0)) break;
 
+#ifdef MOS6502_USES_THREADED_DISPATCH
+	// This is indexed by MicroOp so must list micro-ops in exactly the order in which they are declared
+	// there; only its length can be checked at compile time.
+	static const void *const micro_op_labels[] = {
+#define Label(x)	&&threaded_##x
+		Label(CycleFetchOperation), Label(CycleFetchOperand), Label(OperationDecodeOperation), Label(OperationMoveToNextProgram),
+
+		Label(CycleIncPCPushPCH), Label(CyclePushPCL), Label(CyclePushPCH), Label(CyclePushA),
+		Label(CyclePushX), Label(CyclePushY), Label(CyclePushOperand),
+
+		Label(OperationSetIRQFlags), Label(OperationSetNMIRSTFlags),
+
+		Label(OperationBRKPickVector), Label(OperationNMIPickVector), Label(OperationRSTPickVector), Label(CycleReadVectorLow),
+		Label(CycleReadVectorHigh),
+
+		Label(CycleReadFromS), Label(CycleReadFromPC),
+
+		Label(CyclePullPCL), Label(CyclePullPCH), Label(CyclePullA), Label(CyclePullX),
+		Label(CyclePullY), Label(CyclePullOperand),
+
+		Label(CycleNoWritePush), Label(CycleReadAndIncrementPC), Label(CycleIncrementPCAndReadStack), Label(CycleIncrementPCReadPCHLoadPCL),
+		Label(CycleReadPCHLoadPCL), Label(CycleReadAddressHLoadAddressL),
+
+		Label(CycleReadPCLFromAddress), Label(CycleReadPCHFromAddressLowInc), Label(CycleReadPCHFromAddressFixed), Label(CycleReadPCHFromAddressInc),
+
+		Label(CycleLoadAddressAbsolute), Label(OperationLoadAddressZeroPage), Label(CycleLoadAddessZeroX), Label(CycleLoadAddessZeroY),
+
+		Label(CycleAddXToAddressLow), Label(CycleAddYToAddressLow), Label(CycleAddXToAddressLowRead), Label(CycleAddYToAddressLowRead),
+		Label(OperationCorrectAddressHigh),
+
+		Label(OperationIncrementPC), Label(CycleFetchOperandFromAddress), Label(CycleWriteOperandToAddress),
+
+		Label(CycleIncrementPCFetchAddressLowFromOperand), Label(CycleAddXToOperandFetchAddressLow), Label(CycleIncrementOperandFetchAddressHigh), Label(OperationDecrementOperand),
+		Label(OperationIncrementOperand), Label(CycleFetchAddressLowFromOperand),
+
+		Label(OperationORA), Label(OperationAND), Label(OperationEOR),
+
+		Label(OperationINS), Label(OperationADC), Label(OperationSBC),
+
+		Label(OperationCMP), Label(OperationCPX), Label(OperationCPY), Label(OperationBIT),
+		Label(OperationBITNoNV),
+
+		Label(OperationLDA), Label(OperationLDX), Label(OperationLDY), Label(OperationLAX),
+		Label(OperationCopyOperandToA),
+
+		Label(OperationSTA), Label(OperationSTX), Label(OperationSTY), Label(OperationSTZ),
+		Label(OperationSAX), Label(OperationSHA), Label(OperationSHX), Label(OperationSHY),
+		Label(OperationSHS),
+
+		Label(OperationASL), Label(OperationASO), Label(OperationROL), Label(OperationRLA),
+		Label(OperationLSR), Label(OperationLSE), Label(OperationASR), Label(OperationROR),
+		Label(OperationRRA),
+
+		Label(OperationCLC), Label(OperationCLI), Label(OperationCLV), Label(OperationCLD),
+		Label(OperationSEC), Label(OperationSEI), Label(OperationSED),
+
+		Label(OperationRMB), Label(OperationSMB), Label(OperationTRB), Label(OperationTSB),
+
+		Label(OperationINC), Label(OperationDEC), Label(OperationINX), Label(OperationDEX),
+		Label(OperationINY), Label(OperationDEY), Label(OperationINA), Label(OperationDEA),
+
+		Label(OperationBPL), Label(OperationBMI), Label(OperationBVC), Label(OperationBVS),
+		Label(OperationBCC), Label(OperationBCS), Label(OperationBNE), Label(OperationBEQ),
+		Label(OperationBRA),
+
+		Label(OperationBBRBBS),
+
+		Label(OperationTXA), Label(OperationTYA), Label(OperationTXS), Label(OperationTAY),
+		Label(OperationTAX), Label(OperationTSX),
+
+		Label(OperationARR), Label(OperationSBX), Label(OperationLXA), Label(OperationANE),
+		Label(OperationANC), Label(OperationLAS),
+
+		Label(CycleFetchFromHalfUpdatedPC), Label(CycleAddSignedOperandToPC), Label(OperationAddSignedOperandToPC16),
+
+		Label(OperationSetFlagsFromOperand), Label(OperationSetOperandFromFlagsWithBRKSet), Label(OperationSetOperandFromFlags),
+
+		Label(OperationSetFlagsFromA), Label(OperationSetFlagsFromX), Label(OperationSetFlagsFromY),
+
+		Label(OperationScheduleJam), Label(OperationScheduleWait), Label(OperationScheduleStop),
+#undef Label
+	};
+	static_assert(sizeof(micro_op_labels) / sizeof(*micro_op_labels) == OperationScheduleStop + 1);
+#endif
+
 	checkSchedule();
 	Cycles number_of_cycles = cycles + cycles_left_to_run_;
+	if constexpr (CPU::PCProfiler::IsEnabled) {
+		if(profiler_) profiler_->grant(cycles.as_integral());
+	}
 
 	while(number_of_cycles > Cycles(0)) {
 
 		// Deal with a potential RDY state, if this 6502 has anything connected to ready.
 		while(uses_ready_line && ready_is_active_ && number_of_cycles > Cycles(0)) {
+			if(uses_direct_fetch && unannounced_fetch_cycles_ > Cycles(0)) announce_direct_fetches();
 			number_of_cycles -= bus_handler_.perform_bus_operation(BusOperation::Ready, bus_address_, bus_value_);
 		}
 
 		// Deal with a potential STP state, if this 6502 implements STP.
 		while(has_stpwai(personality) && stop_is_active_ && number_of_cycles > Cycles(0)) {
+			if(uses_direct_fetch && unannounced_fetch_cycles_ > Cycles(0)) announce_direct_fetches();
 			number_of_cycles -= bus_handler_.perform_bus_operation(BusOperation::Ready, bus_address_, bus_value_);
 			if(interrupt_requests_ & InterruptRequestFlags::Reset) {
 				stop_is_active_ = false;
@@ -59,6 +161,7 @@ template <Personality personality, typename T, bool uses_ready_line> void Proces
 
 		// Deal with a potential WAI state, if this 6502 implements WAI.
 		while(has_stpwai(personality) && wait_is_active_ && number_of_cycles > Cycles(0)) {
+			if(uses_direct_fetch && unannounced_fetch_cycles_ > Cycles(0)) announce_direct_fetches();
 			number_of_cycles -= bus_handler_.perform_bus_operation(BusOperation::Ready, bus_address_, bus_value_);
 			interrupt_requests_ |= (irq_line_ & flags_.inverse_interrupt);
 			if(interrupt_requests_ & InterruptRequestFlags::NMI || irq_line_) {
@@ -83,17 +186,31 @@ template <Personality personality, typename T, bool uses_ready_line> void Proces
 #define throwaway_read(addr)	next_bus_operation_ = BusOperation::Read;		bus_address_ = addr;		bus_value_ = &bus_throwaway_;	bus_throwaway_ = 0xff
 #define write_mem(val, addr)	next_bus_operation_ = BusOperation::Write;		bus_address_ = addr;		bus_value_ = &val
 
+// Reads an operand directly if direct fetch is in use, its page has been published and the ready line can't intervene;
+// otherwise acts as read_mem.
+#define read_operand(val, addr)	\
+	if(uses_direct_fetch) {	\
+		if(const uint8_t *const page = fetch_pages_[(addr) >> 8]; page && !(uses_ready_line && ready_line_is_enabled_)) {	\
+			val = page[(addr) & 0xff];	\
+			goto direct_fetch;	\
+		}	\
+	}	\
+	read_mem(val, addr)
+
+#ifdef MOS6502_USES_THREADED_DISPATCH
+				goto *micro_op_labels[cycle];
+#endif
 				switch(cycle) {
 
 // MARK: - Fetch/Decode
 
-					case CycleFetchOperation: {
+					MicroOpCase(CycleFetchOperation): {
 						last_operation_pc_ = pc_;
 						pc_.full++;
 						read_op(operation_, last_operation_pc_.full);
 					} break;
 
-					case CycleFetchOperand:
+					MicroOpCase(CycleFetchOperand):
 						// This is supposed to produce the 65C02's 1-cycle NOPs; they're
 						// treated as a special case because they break the rule that
 						// governs everything else on the 6502: that two bytes will always
@@ -104,18 +221,21 @@ template <Personality personality, typename T, bool uses_ready_line> void Proces
 							operation_ == 0xcb ||
 							operation_ == 0xdb
 						) {
-							read_mem(operand_, pc_.full);
+							read_operand(operand_, pc_.full);
 							break;
 						} else {
 							continue;
 						}
 					break;
 
-					case OperationDecodeOperation:
+					MicroOpCase(OperationDecodeOperation):
 						scheduled_program_counter_ = operations_[operation_];
 					continue;
 
-					case OperationMoveToNextProgram:
+					MicroOpCase(OperationMoveToNextProgram):
+						if constexpr (CPU::PCProfiler::IsEnabled) {
+							if(profiler_) profiler_->sample(pc_.full, number_of_cycles.as_integral());
+						}
 						scheduled_program_counter_ = nullptr;
 						checkSchedule();
 					continue;
@@ -125,14 +245,14 @@ template <Personality personality, typename T, bool uses_ready_line> void Proces
 	write_mem(v, targetAddress);\
 }
 
-					case CycleIncPCPushPCH:				pc_.full++;														[[fallthrough]];
-					case CyclePushPCH:					push(pc_.halves.high);											break;
-					case CyclePushPCL:					push(pc_.halves.low);											break;
-					case CyclePushOperand:				push(operand_);													break;
-					case CyclePushA:					push(a_);														break;
-					case CyclePushX:					push(x_);														break;
-					case CyclePushY:					push(y_);														break;
-					case CycleNoWritePush: {
+					MicroOpCase(CycleIncPCPushPCH):				pc_.full++;														[[fallthrough]];
+					MicroOpCase(CyclePushPCH):					push(pc_.halves.high);											break;
+					MicroOpCase(CyclePushPCL):					push(pc_.halves.low);											break;
+					MicroOpCase(CyclePushOperand):				push(operand_);													break;
+					MicroOpCase(CyclePushA):					push(a_);														break;
+					MicroOpCase(CyclePushX):					push(x_);														break;
+					MicroOpCase(CyclePushY):					push(y_);														break;
+					MicroOpCase(CycleNoWritePush): {
 						uint16_t targetAddress = s_ | 0x100; s_--;
 						read_mem(operand_, targetAddress);
 					}
@@ -140,10 +260,10 @@ template <Personality personality, typename T, bool uses_ready_line> void Proces
 
 #undef push
 
-					case CycleReadFromS:				throwaway_read(s_ | 0x100);										break;
-					case CycleReadFromPC:				throwaway_read(pc_.full);										break;
+					MicroOpCase(CycleReadFromS):				throwaway_read(s_ | 0x100);										break;
+					MicroOpCase(CycleReadFromPC):				throwaway_read(pc_.full);										break;
 
-					case OperationBRKPickVector:
+					MicroOpCase(OperationBRKPickVector):
 						if(is_65c02(personality)) {
 							next_address_.full = 0xfffe;
 						} else {
@@ -152,38 +272,38 @@ template <Personality personality, typename T, bool uses_ready_line> void Proces
 							interrupt_requests_ &= ~InterruptRequestFlags::NMI;
 						}
 					continue;
-					case OperationNMIPickVector:		next_address_.full = 0xfffa;										continue;
-					case OperationRSTPickVector:		next_address_.full = 0xfffc;										continue;
-					case CycleReadVectorLow:			read_mem(pc_.halves.low, next_address_.full);						break;
-					case CycleReadVectorHigh:			read_mem(pc_.halves.high, next_address_.full+1);					break;
-					case OperationSetIRQFlags:
+					MicroOpCase(OperationNMIPickVector):		next_address_.full = 0xfffa;										continue;
+					MicroOpCase(OperationRSTPickVector):		next_address_.full = 0xfffc;										continue;
+					MicroOpCase(CycleReadVectorLow):			read_mem(pc_.halves.low, next_address_.full);						break;
+					MicroOpCase(CycleReadVectorHigh):			read_mem(pc_.halves.high, next_address_.full+1);					break;
+					MicroOpCase(OperationSetIRQFlags):
 						flags_.inverse_interrupt = 0;
 						if(is_65c02(personality)) flags_.decimal = 0;
 					continue;
-					case OperationSetNMIRSTFlags:
+					MicroOpCase(OperationSetNMIRSTFlags):
 						if(is_65c02(personality)) flags_.decimal = 0;
 					continue;
 
-					case CyclePullPCL:					s_++; read_mem(pc_.halves.low, s_ | 0x100);			break;
-					case CyclePullPCH:					s_++; read_mem(pc_.halves.high, s_ | 0x100);		break;
-					case CyclePullA:					s_++; read_mem(a_, s_ | 0x100);						break;
-					case CyclePullX:					s_++; read_mem(x_, s_ | 0x100);						break;
-					case CyclePullY:					s_++; read_mem(y_, s_ | 0x100);						break;
-					case CyclePullOperand:				s_++; read_mem(operand_, s_ | 0x100);				break;
-					case OperationSetFlagsFromOperand:	set_flags(operand_);								continue;
-					case OperationSetOperandFromFlagsWithBRKSet: operand_ = flags_.get() | Flag::Break;		continue;
-					case OperationSetOperandFromFlags:  operand_ = flags_.get();							continue;
-					case OperationSetFlagsFromA:		flags_.set_nz(a_);									continue;
-					case OperationSetFlagsFromX:		flags_.set_nz(x_);									continue;
-					case OperationSetFlagsFromY:		flags_.set_nz(y_);									continue;
-
-					case CycleIncrementPCAndReadStack:	pc_.full++; throwaway_read(s_ | 0x100);														break;
-					case CycleReadPCLFromAddress:		read_mem(pc_.halves.low, address_.full);													break;
-					case CycleReadPCHFromAddressLowInc:	address_.halves.low++; read_mem(pc_.halves.high, address_.full);							break;
-					case CycleReadPCHFromAddressFixed:	if(!address_.halves.low) address_.halves.high++; read_mem(pc_.halves.high, address_.full);	break;
-					case CycleReadPCHFromAddressInc:	address_.full++; read_mem(pc_.halves.high, address_.full);									break;
-
-					case CycleReadAndIncrementPC: {
+					MicroOpCase(CyclePullPCL):					s_++; read_mem(pc_.halves.low, s_ | 0x100);			break;
+					MicroOpCase(CyclePullPCH):					s_++; read_mem(pc_.halves.high, s_ | 0x100);		break;
+					MicroOpCase(CyclePullA):					s_++; read_mem(a_, s_ | 0x100);						break;
+					MicroOpCase(CyclePullX):					s_++; read_mem(x_, s_ | 0x100);						break;
+					MicroOpCase(CyclePullY):					s_++; read_mem(y_, s_ | 0x100);						break;
+					MicroOpCase(CyclePullOperand):				s_++; read_mem(operand_, s_ | 0x100);				break;
+					MicroOpCase(OperationSetFlagsFromOperand):	set_flags(operand_);								continue;
+					MicroOpCase(OperationSetOperandFromFlagsWithBRKSet): operand_ = flags_.get() | Flag::Break;		continue;
+					MicroOpCase(OperationSetOperandFromFlags):  operand_ = flags_.get();							continue;
+					MicroOpCase(OperationSetFlagsFromA):		flags_.set_nz(a_);									continue;
+					MicroOpCase(OperationSetFlagsFromX):		flags_.set_nz(x_);									continue;
+					MicroOpCase(OperationSetFlagsFromY):		flags_.set_nz(y_);									continue;
+
+					MicroOpCase(CycleIncrementPCAndReadStack):	pc_.full++; throwaway_read(s_ | 0x100);														break;
+					MicroOpCase(CycleReadPCLFromAddress):		read_mem(pc_.halves.low, address_.full);													break;
+					MicroOpCase(CycleReadPCHFromAddressLowInc):	address_.halves.low++; read_mem(pc_.halves.high, address_.full);							break;
+					MicroOpCase(CycleReadPCHFromAddressFixed):	if(!address_.halves.low) address_.halves.high++; read_mem(pc_.halves.high, address_.full);	break;
+					MicroOpCase(CycleReadPCHFromAddressInc):	address_.full++; read_mem(pc_.halves.high, address_.full);									break;
+
+					MicroOpCase(CycleReadAndIncrementPC): {
 						uint16_t oldPC = pc_.full;
 						pc_.full++;
 						throwaway_read(oldPC);
@@ -191,61 +311,61 @@ template <Personality personality, typename T, bool uses_ready_line> void Proces
 
 // MARK: - JAM, WAI, STP
 
-					case OperationScheduleJam: {
+					MicroOpCase(OperationScheduleJam): {
 						is_jammed_ = true;
 						scheduled_program_counter_ = operations_[CPU::MOS6502::JamOpcode];
 					} continue;
 
-					case OperationScheduleStop:
+					MicroOpCase(OperationScheduleStop):
 						stop_is_active_ = true;
 					break;
 
-					case OperationScheduleWait:
+					MicroOpCase(OperationScheduleWait):
 						wait_is_active_ = true;
 					break;
 
 // MARK: - Bitwise
 
-					case OperationORA:	a_ |= operand_;	flags_.set_nz(a_);		continue;
-					case OperationAND:	a_ &= operand_;	flags_.set_nz(a_);		continue;
-					case OperationEOR:	a_ ^= operand_;	flags_.set_nz(a_);		continue;
+					MicroOpCase(OperationORA):	a_ |= operand_;	flags_.set_nz(a_);		continue;
+					MicroOpCase(OperationAND):	a_ &= operand_;	flags_.set_nz(a_);		continue;
+					MicroOpCase(OperationEOR):	a_ ^= operand_;	flags_.set_nz(a_);		continue;
 
 // MARK: - Load and Store
 
-					case OperationLDA:	flags_.set_nz(a_ = operand_);			continue;
-					case OperationLDX:	flags_.set_nz(x_ = operand_);			continue;
-					case OperationLDY:	flags_.set_nz(y_ = operand_);			continue;
-					case OperationLAX:	flags_.set_nz(a_ = x_ = operand_);		continue;
-					case OperationCopyOperandToA:		a_ = operand_;			continue;
-
-					case OperationSTA:	operand_ = a_;											continue;
-					case OperationSTX:	operand_ = x_;											continue;
-					case OperationSTY:	operand_ = y_;											continue;
-					case OperationSTZ:	operand_ = 0;											continue;
-					case OperationSAX:	operand_ = a_ & x_;										continue;
-					case OperationSHA:	operand_ = a_ & x_ & (address_.halves.high+1);			continue;
-					case OperationSHX:	operand_ = x_ & (address_.halves.high+1);				continue;
-					case OperationSHY:	operand_ = y_ & (address_.halves.high+1);				continue;
-					case OperationSHS:	s_ = a_ & x_; operand_ = s_ & (address_.halves.high+1);	continue;
-
-					case OperationLXA:
+					MicroOpCase(OperationLDA):	flags_.set_nz(a_ = operand_);			continue;
+					MicroOpCase(OperationLDX):	flags_.set_nz(x_ = operand_);			continue;
+					MicroOpCase(OperationLDY):	flags_.set_nz(y_ = operand_);			continue;
+					MicroOpCase(OperationLAX):	flags_.set_nz(a_ = x_ = operand_);		continue;
+					MicroOpCase(OperationCopyOperandToA):		a_ = operand_;			continue;
+
+					MicroOpCase(OperationSTA):	operand_ = a_;											continue;
+					MicroOpCase(OperationSTX):	operand_ = x_;											continue;
+					MicroOpCase(OperationSTY):	operand_ = y_;											continue;
+					MicroOpCase(OperationSTZ):	operand_ = 0;											continue;
+					MicroOpCase(OperationSAX):	operand_ = a_ & x_;										continue;
+					MicroOpCase(OperationSHA):	operand_ = a_ & x_ & (address_.halves.high+1);			continue;
+					MicroOpCase(OperationSHX):	operand_ = x_ & (address_.halves.high+1);				continue;
+					MicroOpCase(OperationSHY):	operand_ = y_ & (address_.halves.high+1);				continue;
+					MicroOpCase(OperationSHS):	s_ = a_ & x_; operand_ = s_ & (address_.halves.high+1);	continue;
+
+					MicroOpCase(OperationLXA):
 						a_ = x_ = (a_ | 0xee) & operand_;
 						flags_.set_nz(a_);
 					continue;
 
 // MARK: - Compare
 
-					case OperationCMP: {
+					MicroOpCase(OperationCMP): {
 						const uint16_t temp16 = a_ - operand_;
 						flags_.set_nz(uint8_t(temp16));
 						flags_.carry = ((~temp16) >> 8)&1;
 					} continue;
-					case OperationCPX: {
+					MicroOpCase(OperationCPX): {
 						const uint16_t temp16 = x_ - operand_;
 						flags_.set_nz(uint8_t(temp16));
 						flags_.carry = ((~temp16) >> 8)&1;
 					} continue;
-					case OperationCPY: {
+					MicroOpCase(OperationCPY): {
 						const uint16_t temp16 = y_ - operand_;
 						flags_.set_nz(uint8_t(temp16));
 						flags_.carry = ((~temp16) >> 8)&1;
@@ -253,38 +373,38 @@ template <Personality personality, typename T, bool uses_ready_line> void Proces
 
 // MARK: - BIT, TSB, TRB
 
-					case OperationBIT:
+					MicroOpCase(OperationBIT):
 						flags_.zero_result = operand_ & a_;
 						flags_.negative_result = operand_;
 						flags_.overflow = operand_ & Flag::Overflow;
 					continue;
-					case OperationBITNoNV:
+					MicroOpCase(OperationBITNoNV):
 						flags_.zero_result = operand_ & a_;
 					continue;
-					case OperationTRB:
+					MicroOpCase(OperationTRB):
 						flags_.zero_result = operand_ & a_;
 						operand_ &= ~a_;
 					continue;
-					case OperationTSB:
+					MicroOpCase(OperationTSB):
 						flags_.zero_result = operand_ & a_;
 						operand_ |= a_;
 					continue;
 
 // MARK: - RMB and SMB
 
-					case OperationRMB:
+					MicroOpCase(OperationRMB):
 						operand_ &= ~(1 << (operation_ >> 4));
 					continue;
-					case OperationSMB:
+					MicroOpCase(OperationSMB):
 						operand_ |= 1 << ((operation_ >> 4)&7);
 					continue;
 
 // MARK: - ADC/SBC (and INS)
 
-					case OperationINS:
+					MicroOpCase(OperationINS):
 						operand_++;
 						[[fallthrough]];
-					case OperationSBC:
+					MicroOpCase(OperationSBC):
 						if(flags_.decimal && has_decimal_mode(personality)) {
 							const uint16_t notCarry = flags_.carry ^ 0x1;
 							const uint16_t decimalResult = uint16_t(a_) - uint16_t(operand_) - notCarry;
@@ -315,7 +435,7 @@ template <Personality personality, typename T, bool uses_ready_line> void Proces
 						}
 						[[fallthrough]];
 
-					case OperationADC:
+					MicroOpCase(OperationADC):
 						if(flags_.decimal && has_decimal_mode(personality)) {
 							const uint16_t decimalResult = uint16_t(a_) + uint16_t(operand_) + uint16_t(flags_.carry);
 
@@ -348,26 +468,26 @@ template <Personality personality, typename T, bool uses_ready_line> void Proces
 
 // MARK: - Shifts and Rolls
 
-					case OperationASL:
+					MicroOpCase(OperationASL):
 						flags_.carry = operand_ >> 7;
 						operand_ <<= 1;
 						flags_.set_nz(operand_);
 					continue;
 
-					case OperationASO:
+					MicroOpCase(OperationASO):
 						flags_.carry = operand_ >> 7;
 						operand_ <<= 1;
 						a_ |= operand_;
 						flags_.set_nz(a_);
 					continue;
 
-					case OperationROL: {
+					MicroOpCase(OperationROL): {
 						const uint8_t temp8 = uint8_t((operand_ << 1) | flags_.carry);
 						flags_.carry = operand_ >> 7;
 						flags_.set_nz(operand_ = temp8);
 					} continue;
 
-					case OperationRLA: {
+					MicroOpCase(OperationRLA): {
 						const uint8_t temp8 = uint8_t((operand_ << 1) | flags_.carry);
 						flags_.carry = operand_ >> 7;
 						operand_ = temp8;
@@ -375,71 +495,71 @@ template <Personality personality, typename T, bool uses_ready_line> void Proces
 						flags_.set_nz(a_);
 					} continue;
 
-					case OperationLSR:
+					MicroOpCase(OperationLSR):
 						flags_.carry = operand_ & 1;
 						operand_ >>= 1;
 						flags_.set_nz(operand_);
 					continue;
 
-					case OperationLSE:
+					MicroOpCase(OperationLSE):
 						flags_.carry = operand_ & 1;
 						operand_ >>= 1;
 						a_ ^= operand_;
 						flags_.set_nz(a_);
 					continue;
 
-					case OperationASR:
+					MicroOpCase(OperationASR):
 						a_ &= operand_;
 						flags_.carry = a_ & 1;
 						a_ >>= 1;
 						flags_.set_nz(a_);
 					continue;
 
-					case OperationROR: {
+					MicroOpCase(OperationROR): {
 						const uint8_t temp8 = uint8_t((operand_ >> 1) | (flags_.carry << 7));
 						flags_.carry = operand_ & 1;
 						flags_.set_nz(operand_ = temp8);
 					} continue;
 
-					case OperationRRA: {
+					MicroOpCase(OperationRRA): {
 						const uint8_t temp8 = uint8_t((operand_ >> 1) | (flags_.carry << 7));
 						flags_.carry = operand_ & 1;
 						operand_ = temp8;
 					} continue;
 
-					case OperationDecrementOperand: operand_--; continue;
-					case OperationIncrementOperand: operand_++; continue;
+					MicroOpCase(OperationDecrementOperand): operand_--; continue;
+					MicroOpCase(OperationIncrementOperand): operand_++; continue;
 
-					case OperationCLC: flags_.carry = 0;							continue;
-					case OperationCLI: flags_.inverse_interrupt = Flag::Interrupt;	continue;
-					case OperationCLV: flags_.overflow = 0;							continue;
-					case OperationCLD: flags_.decimal = 0;							continue;
+					MicroOpCase(OperationCLC): flags_.carry = 0;							continue;
+					MicroOpCase(OperationCLI): flags_.inverse_interrupt = Flag::Interrupt;	continue;
+					MicroOpCase(OperationCLV): flags_.overflow = 0;							continue;
+					MicroOpCase(OperationCLD): flags_.decimal = 0;							continue;
 
-					case OperationSEC: flags_.carry = Flag::Carry;		continue;
-					case OperationSEI: flags_.inverse_interrupt = 0;	continue;
-					case OperationSED: flags_.decimal = Flag::Decimal;	continue;
+					MicroOpCase(OperationSEC): flags_.carry = Flag::Carry;		continue;
+					MicroOpCase(OperationSEI): flags_.inverse_interrupt = 0;	continue;
+					MicroOpCase(OperationSED): flags_.decimal = Flag::Decimal;	continue;
 
-					case OperationINC: operand_++; flags_.set_nz(operand_);		continue;
-					case OperationDEC: operand_--; flags_.set_nz(operand_);		continue;
-					case OperationINA: a_++; flags_.set_nz(a_); 				continue;
-					case OperationDEA: a_--; flags_.set_nz(a_); 				continue;
-					case OperationINX: x_++; flags_.set_nz(x_); 				continue;
-					case OperationDEX: x_--; flags_.set_nz(x_); 				continue;
-					case OperationINY: y_++; flags_.set_nz(y_); 				continue;
-					case OperationDEY: y_--; flags_.set_nz(y_); 				continue;
+					MicroOpCase(OperationINC): operand_++; flags_.set_nz(operand_);		continue;
+					MicroOpCase(OperationDEC): operand_--; flags_.set_nz(operand_);		continue;
+					MicroOpCase(OperationINA): a_++; flags_.set_nz(a_); 				continue;
+					MicroOpCase(OperationDEA): a_--; flags_.set_nz(a_); 				continue;
+					MicroOpCase(OperationINX): x_++; flags_.set_nz(x_); 				continue;
+					MicroOpCase(OperationDEX): x_--; flags_.set_nz(x_); 				continue;
+					MicroOpCase(OperationINY): y_++; flags_.set_nz(y_); 				continue;
+					MicroOpCase(OperationDEY): y_--; flags_.set_nz(y_); 				continue;
 
-					case OperationANE:
+					MicroOpCase(OperationANE):
 						a_ = (a_ | 0xee) & operand_ & x_;
 						flags_.set_nz(a_);
 					continue;
 
-					case OperationANC:
+					MicroOpCase(OperationANC):
 						a_ &= operand_;
 						flags_.set_nz(a_);
 						flags_.carry = a_ >> 7;
 					continue;
 
-					case OperationLAS:
+					MicroOpCase(OperationLAS):
 						a_ = x_ = s_ = s_ & operand_;
 						flags_.set_nz(a_);
 					continue;
@@ -453,7 +573,7 @@ template <Personality personality, typename T, bool uses_ready_line> void Proces
 		throwaway_read(address_.full);	\
 	}
 
-					case CycleAddXToAddressLow:
+					MicroOpCase(CycleAddXToAddressLow):
 						next_address_.full = address_.full + x_;
 						address_.halves.low = next_address_.halves.low;
 						if(address_.halves.high != next_address_.halves.high) {
@@ -461,12 +581,12 @@ template <Personality personality, typename T, bool uses_ready_line> void Proces
 							break;
 						}
 					continue;
-					case CycleAddXToAddressLowRead:
+					MicroOpCase(CycleAddXToAddressLowRead):
 						next_address_.full = address_.full + x_;
 						address_.halves.low = next_address_.halves.low;
 						page_crossing_stall_read();
 					break;
-					case CycleAddYToAddressLow:
+					MicroOpCase(CycleAddYToAddressLow):
 						next_address_.full = address_.full + y_;
 						address_.halves.low = next_address_.halves.low;
 						if(address_.halves.high != next_address_.halves.high) {
@@ -474,7 +594,7 @@ template <Personality personality, typename T, bool uses_ready_line> void Proces
 							break;
 						}
 					continue;
-					case CycleAddYToAddressLowRead:
+					MicroOpCase(CycleAddYToAddressLowRead):
 						next_address_.full = address_.full + y_;
 						address_.halves.low = next_address_.halves.low;
 						page_crossing_stall_read();
@@ -482,65 +602,65 @@ template <Personality personality, typename T, bool uses_ready_line> void Proces
 
 #undef page_crossing_stall_read
 
-					case OperationCorrectAddressHigh:
+					MicroOpCase(OperationCorrectAddressHigh):
 						address_.full = next_address_.full;
 					continue;
-					case CycleIncrementPCFetchAddressLowFromOperand:
+					MicroOpCase(CycleIncrementPCFetchAddressLowFromOperand):
 						pc_.full++;
 						read_mem(address_.halves.low, operand_);
 					break;
-					case CycleAddXToOperandFetchAddressLow:
+					MicroOpCase(CycleAddXToOperandFetchAddressLow):
 						operand_ += x_;
 						read_mem(address_.halves.low, operand_);
 					break;
-					case CycleFetchAddressLowFromOperand:
+					MicroOpCase(CycleFetchAddressLowFromOperand):
 						read_mem(address_.halves.low, operand_);
 					break;
-					case CycleIncrementOperandFetchAddressHigh:
+					MicroOpCase(CycleIncrementOperandFetchAddressHigh):
 						operand_++;
 						read_mem(address_.halves.high, operand_);
 					break;
-					case CycleIncrementPCReadPCHLoadPCL:
+					MicroOpCase(CycleIncrementPCReadPCHLoadPCL):
 						pc_.full++;
 						[[fallthrough]];
-					case CycleReadPCHLoadPCL: {
+					MicroOpCase(CycleReadPCHLoadPCL): {
 						uint16_t oldPC = pc_.full;
 						pc_.halves.low = operand_;
 						read_mem(pc_.halves.high, oldPC);
 					} break;
 
-					case CycleReadAddressHLoadAddressL:
+					MicroOpCase(CycleReadAddressHLoadAddressL):
 						address_.halves.low = operand_; pc_.full++;
 						read_mem(address_.halves.high, pc_.full);
 					break;
 
-					case CycleLoadAddressAbsolute: {
+					MicroOpCase(CycleLoadAddressAbsolute): {
 						uint16_t nextPC = pc_.full+1;
 						pc_.full += 2;
 						address_.halves.low = operand_;
-						read_mem(address_.halves.high, nextPC);
+						read_operand(address_.halves.high, nextPC);
 					} break;
 
-					case OperationLoadAddressZeroPage:
+					MicroOpCase(OperationLoadAddressZeroPage):
 						pc_.full++;
 						address_.full = operand_;
 					continue;
 
-					case CycleLoadAddessZeroX:
+					MicroOpCase(CycleLoadAddessZeroX):
 						pc_.full++;
 						address_.full = (operand_ + x_)&0xff;
 						throwaway_read(operand_);
 					break;
 
-					case CycleLoadAddessZeroY:
+					MicroOpCase(CycleLoadAddessZeroY):
 						pc_.full++;
 						address_.full = (operand_ + y_)&0xff;
 						throwaway_read(operand_);
 					break;
 
-					case OperationIncrementPC:			pc_.full++;							continue;
-					case CycleFetchOperandFromAddress:	read_mem(operand_, address_.full);	break;
-					case CycleWriteOperandToAddress:	write_mem(operand_, address_.full);	break;
+					MicroOpCase(OperationIncrementPC):			pc_.full++;							continue;
+					MicroOpCase(CycleFetchOperandFromAddress):	read_mem(operand_, address_.full);	break;
+					MicroOpCase(CycleWriteOperandToAddress):	write_mem(operand_, address_.full);	break;
 
 // MARK: - Branching
 
@@ -550,19 +670,19 @@ template <Personality personality, typename T, bool uses_ready_line> void Proces
 		scheduled_program_counter_ = operations_[size_t(OperationsSlot::DoBRA)];	\
 	}
 
-					case OperationBPL: BRA(!(flags_.negative_result&0x80));			continue;
-					case OperationBMI: BRA(flags_.negative_result&0x80);			continue;
-					case OperationBVC: BRA(!flags_.overflow);						continue;
-					case OperationBVS: BRA(flags_.overflow);						continue;
-					case OperationBCC: BRA(!flags_.carry);							continue;
-					case OperationBCS: BRA(flags_.carry);							continue;
-					case OperationBNE: BRA(flags_.zero_result);						continue;
-					case OperationBEQ: BRA(!flags_.zero_result);					continue;
-					case OperationBRA: BRA(true);									continue;
+					MicroOpCase(OperationBPL): BRA(!(flags_.negative_result&0x80));			continue;
+					MicroOpCase(OperationBMI): BRA(flags_.negative_result&0x80);			continue;
+					MicroOpCase(OperationBVC): BRA(!flags_.overflow);						continue;
+					MicroOpCase(OperationBVS): BRA(flags_.overflow);						continue;
+					MicroOpCase(OperationBCC): BRA(!flags_.carry);							continue;
+					MicroOpCase(OperationBCS): BRA(flags_.carry);							continue;
+					MicroOpCase(OperationBNE): BRA(flags_.zero_result);						continue;
+					MicroOpCase(OperationBEQ): BRA(!flags_.zero_result);					continue;
+					MicroOpCase(OperationBRA): BRA(true);									continue;
 
 #undef BRA
 
-					case CycleAddSignedOperandToPC:
+					MicroOpCase(CycleAddSignedOperandToPC):
 						next_address_.full = uint16_t(pc_.full + int8_t(operand_));
 						pc_.halves.low = next_address_.halves.low;
 						if(next_address_.halves.high != pc_.halves.high) {
@@ -578,16 +698,16 @@ template <Personality personality, typename T, bool uses_ready_line> void Proces
 						}
 					continue;
 
-					case CycleFetchFromHalfUpdatedPC: {
+					MicroOpCase(CycleFetchFromHalfUpdatedPC): {
 						uint16_t halfUpdatedPc = uint16_t(((pc_.halves.low + int8_t(operand_)) & 0xff) | (pc_.halves.high << 8));
 						throwaway_read(halfUpdatedPc);
 					} break;
 
-					case OperationAddSignedOperandToPC16:
+					MicroOpCase(OperationAddSignedOperandToPC16):
 						pc_.full = uint16_t(pc_.full + int8_t(operand_));
 					continue;
 
-					case OperationBBRBBS: {
+					MicroOpCase(OperationBBRBBS): {
 						// To reach here, the 6502 has (i) read the operation; (ii) read the first operand;
 						// and (iii) read from the corresponding zero page.
 						const uint8_t mask = uint8_t(1 << ((operation_ >> 4)&7));
@@ -600,14 +720,14 @@ template <Personality personality, typename T, bool uses_ready_line> void Proces
 
 // MARK: - Transfers
 
-					case OperationTXA: flags_.set_nz(a_ = x_);	continue;
-					case OperationTYA: flags_.set_nz(a_ = y_);	continue;
-					case OperationTXS: s_ = x_;					continue;
-					case OperationTAY: flags_.set_nz(y_ = a_);	continue;
-					case OperationTAX: flags_.set_nz(x_ = a_);	continue;
-					case OperationTSX: flags_.set_nz(x_ = s_);	continue;
+					MicroOpCase(OperationTXA): flags_.set_nz(a_ = x_);	continue;
+					MicroOpCase(OperationTYA): flags_.set_nz(a_ = y_);	continue;
+					MicroOpCase(OperationTXS): s_ = x_;					continue;
+					MicroOpCase(OperationTAY): flags_.set_nz(y_ = a_);	continue;
+					MicroOpCase(OperationTAX): flags_.set_nz(x_ = a_);	continue;
+					MicroOpCase(OperationTSX): flags_.set_nz(x_ = s_);	continue;
 
-					case OperationARR:
+					MicroOpCase(OperationARR):
 						if(flags_.decimal) {
 							a_ &= operand_;
 							uint8_t unshiftedA = a_;
@@ -628,7 +748,7 @@ template <Personality personality, typename T, bool uses_ready_line> void Proces
 						}
 					continue;
 
-					case OperationSBX:
+					MicroOpCase(OperationSBX):
 						x_ &= a_;
 						uint16_t difference = x_ - operand_;
 						x_ = uint8_t(difference);
@@ -645,15 +765,34 @@ template <Personality personality, typename T, bool uses_ready_line> void Proces
 					break;
 				}
 				bus_access();
+				continue;
+
+				// Operands read directly arrive here, having skipped the bus handler; the time taken
+				// is announced ahead of the next bus operation.
+			direct_fetch:
+				interrupt_requests_ = (interrupt_requests_ & ~InterruptRequestFlags::IRQ) | irq_request_history_;
+				irq_request_history_ = irq_line_ & flags_.inverse_interrupt;
+				--number_of_cycles;
+				++unannounced_fetch_cycles_;
+				if(number_of_cycles <= Cycles(0)) break;
 			}
 		}
 	}
 
+	if(uses_direct_fetch && unannounced_fetch_cycles_ > Cycles(0)) announce_direct_fetches();
 	cycles_left_to_run_ = number_of_cycles;
 	bus_handler_.flush();
 }
 
-template <Personality personality, typename T, bool uses_ready_line> void Processor<personality, T, uses_ready_line>::set_ready_line(bool active) {
+template <Personality personality, typename T, bool uses_ready_line, bool uses_direct_fetch> void Processor<personality, T, uses_ready_line, uses_direct_fetch>::announce_direct_fetches() {
+	bus_handler_.perform_direct_fetches(unannounced_fetch_cycles_);
+	unannounced_fetch_cycles_ = Cycles(0);
+}
+
+#undef MicroOpCase
+#undef MOS6502_USES_THREADED_DISPATCH
+
+template <Personality personality, typename T, bool uses_ready_line, bool uses_direct_fetch> void Processor<personality, T, uses_ready_line, uses_direct_fetch>::set_ready_line(bool active) {
 	assert(uses_ready_line);
 	if(active) {
 		ready_line_is_enabled_ = true;
@@ -265,6 +265,7 @@ class ProcessorStorage {
 
 		bool is_jammed_ = false;
 		Cycles cycles_left_to_run_;
+		CPU::PCProfiler *profiler_ = nullptr;
 
 		enum InterruptRequestFlags: uint8_t {
 			Reset		= 0x80,
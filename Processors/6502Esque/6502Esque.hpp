@@ -142,6 +142,23 @@ template <typename addr_t> class BusHandler {
 			return Cycles(1);
 		}
 
+		/*!
+			65816 only: announces that the processor has itself performed the cycle defined by @c operation and @c address,
+			using memory published via @c set_mapped_pages.
+
+			@returns The number of cycles that passed in objective time while this bus cycle was ongoing, as per @c perform_bus_operation.
+		*/
+		Cycles perform_direct_bus_operation([[maybe_unused]] BusOperation operation, [[maybe_unused]] addr_t address) {
+			return Cycles(1);
+		}
+
+		/*!
+			6502 only: announces that @c cycles have passed during which the processor read operands itself, from memory
+			published via @c set_fetch_pages, rather than announcing those reads. This is called immediately before the next
+			call to @c perform_bus_operation, or to @c flush if @c run_for ends first.
+		*/
+		void perform_direct_fetches([[maybe_unused]] Cycles cycles) {}
+
 		/*!
 			Announces completion of all the cycles supplied to a .run_for request on the 6502. Intended to allow
 			bus handlers to perform any deferred output work.
@@ -30,12 +30,13 @@ enum class Type {
 	of the type enums as above as the appropriate template parameter.
 */
 
-template <Type processor_type, typename BusHandler, bool uses_ready_line> class Processor:
-	public CPU::MOS6502::Processor<CPU::MOS6502::Personality(processor_type), BusHandler, uses_ready_line> {
-		using CPU::MOS6502::Processor<CPU::MOS6502::Personality(processor_type), BusHandler, uses_ready_line>::Processor;
+template <Type processor_type, typename BusHandler, bool uses_ready_line, bool uses_direct_fetch = false> class Processor:
+	public CPU::MOS6502::Processor<CPU::MOS6502::Personality(processor_type), BusHandler, uses_ready_line, uses_direct_fetch> {
+		using CPU::MOS6502::Processor<CPU::MOS6502::Personality(processor_type), BusHandler, uses_ready_line, uses_direct_fetch>::Processor;
 };
 
-template <typename BusHandler, bool uses_ready_line> class Processor<Type::TWDC65816, BusHandler, uses_ready_line>:
+// The 65816 doesn't offer direct fetch; see instead CPU::WDC65816::ProcessorBase::set_mapped_pages.
+template <typename BusHandler, bool uses_ready_line, bool uses_direct_fetch> class Processor<Type::TWDC65816, BusHandler, uses_ready_line, uses_direct_fetch>:
 	public CPU::WDC65816::Processor<BusHandler, uses_ready_line> {
 		using CPU::WDC65816::Processor<BusHandler, uses_ready_line>::Processor;
 };
@@ -14,6 +14,7 @@
 #include <cstdint>
 #include <vector>
 
+#include "../PCProfiler.hpp"
 #include "../RegisterSizes.hpp"
 #include "../../ClockReceiver/ClockReceiver.hpp"
 #include "../6502Esque/6502Esque.hpp"
@@ -33,6 +34,16 @@ enum ExtendedBusOutput {
 	MemoryLock = (1 << 3),
 };
 
+/*!
+	Describes, for a single 256-byte page of the address space, memory that the 65816 may access by itself rather
+	than via its bus handler. Each pointer is indexed by full address, i.e. @c read[address] is the byte at @c address.
+	A @c nullptr indicates that accesses of that sort should be announced to the bus handler as usual.
+*/
+struct MappedPage {
+	const uint8_t *read = nullptr;
+	uint8_t *write = nullptr;
+};
+
 #include "Implementation/65816Storage.hpp"
 
 class ProcessorBase: protected ProcessorStorage {
@@ -56,6 +67,30 @@ class ProcessorBase: protected ProcessorStorage {
 
 		void set_value_of_register(Register r, uint16_t value);
 		uint16_t get_value_of_register(Register r) const;
+
+		/// Attaches @c profiler, which will be supplied with program counter samples if CPU_PROFILING is enabled.
+		void set_profiler(CPU::PCProfiler *profiler) {
+			profiler_ = profiler;
+		}
+
+		/*!
+			Publishes @c pages, an array of 65536 MappedPages, one for each 256-byte page of the address space, or
+			@c nullptr to announce all accesses to the bus handler. The array remains owned by the caller, which should
+			update it whenever paging changes.
+
+			Reads other than vector pulls, and writes, in pages that have a suitable pointer are then performed by the
+			processor itself; rather than @c perform_bus_operation it calls the bus handler's @c perform_direct_bus_operation,
+			which should do nothing but report the length of the cycle. So only memory that can be accessed without side
+			effects should be published.
+		*/
+		void set_mapped_pages(const MappedPage *pages) {
+			mapped_pages_ = pages;
+		}
+
+		/// @returns The number of bytes occupied by this processor's instruction table and micro-op programs.
+		size_t get_table_footprint() const {
+			return sizeof(instructions) + sizeof(program_offsets_) + micro_ops_.capacity() * sizeof(MicroOp);
+		}
 };
 
 template <typename BusHandler, bool uses_ready_line> class Processor: public ProcessorBase {
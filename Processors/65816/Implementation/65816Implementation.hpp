@@ -22,6 +22,9 @@ template <typename BusHandler, bool uses_ready_line> void Processor<BusHandler,
 #define stack_address()	((registers_.s.full & registers_.e_masks[1]) | (0x0100 & registers_.e_masks[0]))
 
 	Cycles number_of_cycles = cycles + cycles_left_to_run_;
+	if constexpr (CPU::PCProfiler::IsEnabled) {
+		if(profiler_) profiler_->grant(cycles.as_integral());
+	}
 	while(number_of_cycles > Cycles(0)) {
 		// Wait for ready to be inactive before proceeding.
 		while(uses_ready_line && ready_line_ && number_of_cycles > Cycles(0)) {
@@ -67,13 +70,15 @@ template <typename BusHandler, bool uses_ready_line> void Processor<BusHandler,
 					last_operation_pc_ = registers_.pc;
 					last_operation_program_bank_ = uint8_t(registers_.program_bank >> 16);
 					memory_lock_ = false;
+
+					if constexpr (CPU::PCProfiler::IsEnabled) {
+						if(profiler_) profiler_->sample(registers_.program_bank | registers_.pc, number_of_cycles.as_integral());
+					}
 				} continue;
 
 				case OperationDecode: {
 					active_instruction_ = &instructions[instruction_buffer_.value];
-
-					const auto size_flag = registers_.mx_flags[active_instruction_->size_field];
-					next_op_ = &micro_ops_[active_instruction_->program_offsets[size_flag]];
+					next_op_ = &micro_ops_[active_program_offsets_[instruction_buffer_.value]];
 					instruction_buffer_.clear();
 				} continue;
 
@@ -439,6 +444,7 @@ template <typename BusHandler, bool uses_ready_line> void Processor<BusHandler,
 					if(pending_exceptions_ & Abort) {
 						// Special case: restore registers from start of instruction.
 						registers_ = abort_registers_copy_;
+						active_program_offsets_ = program_offsets_[(registers_.mx_flags[1] << 1) | registers_.mx_flags[0]];
 
 						pending_exceptions_ &= ~Abort;
 						data_address_ = registers_.emulation_flag ? 0xfff8 : 0xffe8;
@@ -983,6 +989,22 @@ template <typename BusHandler, bool uses_ready_line> void Processor<BusHandler,
 			// Store a selection as to the exceptions, if any, that would be honoured after this cycle if the
 			// next thing is a MoveToNextProgram.
 			selected_exceptions_ = pending_exceptions_ & (registers_.flags.inverse_interrupt | PowerOn | Reset | NMI);
+
+			// Perform the access here if the bus handler has published memory for it, leaving the bus handler only to time it.
+			if(mapped_pages_) {
+				const MappedPage &page = mapped_pages_[(bus_address_ >> 8) & 0xffff];
+				if(isReadOperation(bus_operation_) && bus_operation_ != BusOperation::ReadVector && page.read) {
+					*bus_value_ = page.read[bus_address_];
+					number_of_cycles -= bus_handler_.perform_direct_bus_operation(bus_operation_, static_cast<typename BusHandler::AddressType>(bus_address_));
+					continue;
+				}
+				if(isWriteOperation(bus_operation_) && page.write) {
+					page.write[bus_address_] = *bus_value_;
+					number_of_cycles -= bus_handler_.perform_direct_bus_operation(bus_operation_, static_cast<typename BusHandler::AddressType>(bus_address_));
+					continue;
+				}
+			}
+
 			number_of_cycles -= bus_handler_.perform_bus_operation(bus_operation_, static_cast<typename BusHandler::AddressType>(bus_address_), bus_value_);
 		}
 	}
@@ -1079,6 +1079,14 @@ ProcessorStorage::ProcessorStorage() {
 	constructor.set_exception_generator(&ProcessorStorageConstructor::stack_exception, &ProcessorStorageConstructor::reset);
 	constructor.install_fetch_decode_execute();
 
+	// Resolve the program for every opcode under each combination of M and X.
+	for(int mx = 0; mx < 4; mx++) {
+		const uint8_t mx_flags[2] = {uint8_t(mx & 1), uint8_t(mx >> 1)};
+		for(int c = 0; c < 256; c++) {
+			program_offsets_[mx][c] = instructions[c].program_offsets[mx_flags[instructions[c].size_field]];
+		}
+	}
+
 	// Find any OperationMoveToNextProgram.
 	next_op_ = micro_ops_.data();
 	while(*next_op_ != OperationMoveToNextProgram) ++next_op_;
@@ -1127,6 +1135,7 @@ void ProcessorStorage::set_m_x_flags(bool m, bool x) {
 	// true/1 => 8bit for both flags.
 	registers_.mx_flags[0] = m;
 	registers_.mx_flags[1] = x;
+	active_program_offsets_ = program_offsets_[(x << 1) | m];
 }
 
 uint8_t ProcessorStorage::get_flags() const {
@@ -254,6 +254,13 @@ struct ProcessorStorage {
 										//	a duplicate entry for the final part of exceptions if the selected exception is a reset; and
 										//	the entry for fetch-decode-execute.
 
+	/// The program to perform for each opcode, as an offset into micro_ops_, resolved in advance for each
+	/// combination of the M and X flags and indexed as [(x << 1) | m][opcode]; emulation mode implies that
+	/// both are set. The active table is swapped whenever either flag changes so that decoding needn't
+	/// inspect them.
+	uint16_t program_offsets_[4][256];
+	const uint16_t *active_program_offsets_ = program_offsets_[3];
+
 	enum class OperationSlot {
 		Exception = 256,
 		Reset,
@@ -265,6 +272,7 @@ struct ProcessorStorage {
 	uint8_t last_operation_program_bank_;
 	Instruction *active_instruction_;
 	Cycles cycles_left_to_run_;
+	CPU::PCProfiler *profiler_ = nullptr;
 
 	// All registers are boxed up into a struct so that they can be stored and restored in support of abort.
 	struct Registers {
@@ -299,6 +307,9 @@ struct ProcessorStorage {
 	static inline uint8_t bus_throwaway_ = 0;
 	BusOperation bus_operation_ = BusOperation::None;
 
+	// Memory that the bus handler has published for direct access, if any.
+	const MappedPage *mapped_pages_ = nullptr;
+
 	// A bitfield for various exceptions.
 	static constexpr int PowerOn = 1 << 0;
 	static constexpr int Reset = 1 << 1;
@@ -20,6 +20,7 @@
 
 #include "../../ClockReceiver/ForceInline.hpp"
 #include "../../ClockReceiver/ClockReceiver.hpp"
+#include "../PCProfiler.hpp"
 #include "../RegisterSizes.hpp"
 
 namespace CPU {
@@ -359,6 +360,20 @@ class BusHandler {
 
 		void flush() {}
 
+		/*!
+			Offered whenever the 68000 is stopped with no interrupt of sufficient priority requested, before
+			it performs another of the null cycles that it repeats until one is.
+
+			Bus handlers that know when their interrupt inputs might next change may account for up to
+			@c maximum of that time at once, in multiples of two half cycles, by advancing time accordingly —
+			provided that doing so doesn't take them beyond that point.
+
+			@returns The amount of time accounted for, in the range [0, @c maximum].
+		*/
+		HalfCycles perform_stopped_time([[maybe_unused]] HalfCycles maximum) {
+			return HalfCycles(0);
+		}
+
 		/*!
 			Provides information about the path of execution if enabled via the template.
 		*/
@@ -368,6 +383,17 @@ class BusHandler {
 #include "Implementation/68000Storage.hpp"
 
 class ProcessorBase: public ProcessorStorage {
+	public:
+		/// Attaches @c profiler, which will be supplied with program counter samples if CPU_PROFILING is enabled.
+		void set_profiler(CPU::PCProfiler *profiler) {
+			profiler_ = profiler;
+		}
+
+		/// @returns The number of bytes occupied by this processor's own bus programs; the instruction
+		/// table and micro-ops are shared by all instances, so aren't included.
+		size_t get_table_footprint() const {
+			return all_bus_steps_.capacity() * sizeof(BusStep);
+		}
 };
 
 enum Flag: uint16_t {
@@ -462,8 +488,44 @@ template <class T, bool dtack_is_implicit, bool signal_will_perform = false> cla
 			return e_clock_phase_;
 		}
 
+		/*!
+			Nominates the 64kb page of the address space that begins at @c page << 16 as fast memory,
+			meaning memory that the processor may access directly without calling the bus handler.
+			Reads from the page will be served from @c read, if non-null, and writes will go to @c write,
+			if non-null; each is a 64kb buffer arranged in the same host-endian 16-bit words as
+			expected by Microcycle::apply.
+
+			This is intended for RAM and ROM that has no wait states, no contention and no side effects.
+			It is available only if DTack is implicit.
+
+			Once any fast memory has been set, the bus handler will no longer necessarily see
+			every microcycle. Each time it is called, it will first receive a single idle microcycle
+			containing all time spent since it was last called on idle microcycles and fast memory
+			accesses — so its view of time remains exact — and the processor always posts any such
+			time before sampling the interrupt inputs and before returning from run_for. Nothing
+			is skipped while VPA or bus error is asserted.
+
+			The bus handler should therefore ensure that anything it does in response to the
+			passage of time alone is something it can do in the middle of a bus operation.
+			It should also update fast memory whenever its memory map changes.
+		*/
+		void set_fast_memory(int page, uint8_t *read, uint8_t *write) {
+			static_assert(dtack_is_implicit, "Fast memory is available only if DTack is implicit");
+			fast_read_pages_[page & 0xff] = read;
+			fast_write_pages_[page & 0xff] = write;
+			uses_fast_memory_ |= read || write;
+		}
+
 	private:
 		T &bus_handler_;
+
+		/// Performs @c cycle directly if it is an idle cycle or an access to fast memory, and fast memory is in use.
+		/// @returns @c true if the cycle was performed; @c false if it should be posted to the bus handler.
+		bool perform_fast_microcycle(const Microcycle &cycle);
+
+		/// Posts any time accumulated by @c perform_fast_microcycle to the bus handler.
+		/// @returns Any additional delay requested by the bus handler.
+		HalfCycles report_unreported_time();
 };
 
 #include "Implementation/68000Implementation.hpp"
@@ -69,6 +69,9 @@
 
 template <class T, bool dtack_is_implicit, bool signal_will_perform> void Processor<T, dtack_is_implicit, signal_will_perform>::run_for(HalfCycles duration) {
 	const HalfCycles remaining_duration = duration + half_cycles_left_to_run_;
+	if constexpr (CPU::PCProfiler::IsEnabled) {
+		if(profiler_) profiler_->grant(duration.as_integral());
+	}
 
 	// This loop counts upwards rather than downwards because it simplifies calculation of
 	// E as and when required.
@@ -130,25 +133,33 @@ template <class T, bool dtack_is_implicit, bool signal_will_perform> void Proces
 
 					// Perform the microcycle if it is of non-zero length. If this is an operation that
 					// would normally strobe one of the data selects and VPA is active, it will also need
-					// stretching.
+					// stretching. Idle microcycles and accesses to fast memory are performed here and
+					// their time posted to the bus handler later, if fast memory is in use.
 					if(active_step_->microcycle.length != HalfCycles(0)) {
-						if(is_peripheral_address_ && active_step_->microcycle.data_select_active()) {
-							auto cycle_copy = active_step_->microcycle;
-							cycle_copy.operation |= Microcycle::IsPeripheral;
-
-							// Length will be: (i) distance to next E cycle, plus (ii) difference between
-							// current length and a whole E cycle.
-							const auto phase_now = (e_clock_phase_ + cycles_run_for) % 20;
-							const auto time_to_boundary = (HalfCycles(20) - phase_now) % HalfCycles(20);
-							cycle_copy.length = HalfCycles(20) + time_to_boundary;
-
-							cycles_run_for +=
-								cycle_copy.length +
-								bus_handler_.perform_bus_operation(cycle_copy, is_supervisor_);
+						if(dtack_is_implicit && perform_fast_microcycle(active_step_->microcycle)) {
+							cycles_run_for += active_step_->microcycle.length;
+							unreported_time_ += active_step_->microcycle.length;
 						} else {
-							cycles_run_for +=
-								active_step_->microcycle.length +
-								bus_handler_.perform_bus_operation(active_step_->microcycle, is_supervisor_);
+							cycles_run_for += report_unreported_time();
+
+							if(is_peripheral_address_ && active_step_->microcycle.data_select_active()) {
+								auto cycle_copy = active_step_->microcycle;
+								cycle_copy.operation |= Microcycle::IsPeripheral;
+
+								// Length will be: (i) distance to next E cycle, plus (ii) difference between
+								// current length and a whole E cycle.
+								const auto phase_now = (e_clock_phase_ + cycles_run_for) % 20;
+								const auto time_to_boundary = (HalfCycles(20) - phase_now) % HalfCycles(20);
+								cycle_copy.length = HalfCycles(20) + time_to_boundary;
+
+								cycles_run_for +=
+									cycle_copy.length +
+									bus_handler_.perform_bus_operation(cycle_copy, is_supervisor_);
+							} else {
+								cycles_run_for +=
+									active_step_->microcycle.length +
+									bus_handler_.perform_bus_operation(active_step_->microcycle, is_supervisor_);
+							}
 						}
 					}
 
@@ -200,6 +211,7 @@ template <class T, bool dtack_is_implicit, bool signal_will_perform> void Proces
 
 								// During prefetch advance seems to be the only time the interrupt inputs are sampled;
 								// TODO: determine whether this really happens on *every* advance.
+								cycles_run_for += report_unreported_time();
 								if(bus_interrupt_level_ > interrupt_level_) {
 									pending_interrupt_level_ = bus_interrupt_level_;
 								}
@@ -211,6 +223,8 @@ template <class T, bool dtack_is_implicit, bool signal_will_perform> void Proces
 				break;
 
 				case ExecutionState::Stopped:
+					cycles_run_for += report_unreported_time();
+
 					// If an interrupt (TODO: or reset) has finally arrived that will be serviced,
 					// exit the STOP.
 					if(bus_interrupt_level_ > interrupt_level_) {
@@ -220,13 +234,19 @@ template <class T, bool dtack_is_implicit, bool signal_will_perform> void Proces
 						continue;
 					}
 
-					// Otherwise continue being stopped.
+					// Otherwise continue being stopped, skipping ahead if the bus handler can.
+					if(const auto stopped_time = bus_handler_.perform_stopped_time(remaining_duration - cycles_run_for); stopped_time > HalfCycles(0)) {
+						cycles_run_for += stopped_time;
+						continue;
+					}
 					cycles_run_for +=
 						stop_cycle_.length +
 						bus_handler_.perform_bus_operation(stop_cycle_, is_supervisor_);
 				continue;
 
 				case ExecutionState::WaitingForDTack:
+					cycles_run_for += report_unreported_time();
+
 					// If DTack or bus error has been signalled, stop waiting.
 					if(dtack_ || bus_error_) {
 						execution_state_ = ExecutionState::Executing;
@@ -240,6 +260,8 @@ template <class T, bool dtack_is_implicit, bool signal_will_perform> void Proces
 				continue;
 
 				case ExecutionState::Halted:
+					cycles_run_for += report_unreported_time();
+
 					if(!halt_) {
 						execution_state_ = ExecutionState::Executing;
 						continue;
@@ -321,6 +343,10 @@ template <class T, bool dtack_is_implicit, bool signal_will_perform> void Proces
 								bus_handler_.will_perform(program_counter_.full - 4, decoded_instruction_.full);
 							}
 
+							if constexpr (CPU::PCProfiler::IsEnabled) {
+								if(profiler_) profiler_->sample(program_counter_.full - 4, (remaining_duration - cycles_run_for).as_integral());
+							}
+
 #ifdef LOG_TRACE
 //							const uint32_t fetched_pc = (program_counter_.full - 4)&0xffffff;
 
@@ -2196,11 +2222,37 @@ template <class T, bool dtack_is_implicit, bool signal_will_perform> void Proces
 #undef destination
 #undef destination_address
 
+	cycles_run_for += report_unreported_time();
 	bus_handler_.flush();
 	e_clock_phase_ = (e_clock_phase_ + cycles_run_for) % 20;
 	half_cycles_left_to_run_ = remaining_duration - cycles_run_for;
 }
 
+template <class T, bool dtack_is_implicit, bool signal_will_perform> forceinline bool Processor<T, dtack_is_implicit, signal_will_perform>::perform_fast_microcycle(const Microcycle &cycle) {
+	if(!uses_fast_memory_ || is_peripheral_address_ || bus_error_) return false;
+	if(cycle.operation & (Microcycle::Reset | Microcycle::InterruptAcknowledge | Microcycle::BusGrant)) return false;
+
+	// Idle microcycles convey only the passage of time.
+	if(!(cycle.operation & (Microcycle::NewAddress | Microcycle::SameAddress))) return true;
+
+	const uint32_t address = cycle.host_endian_byte_address();
+	uint8_t *const page = (cycle.operation & Microcycle::Read) ? fast_read_pages_[address >> 16] : fast_write_pages_[address >> 16];
+	if(!page) return false;
+
+	if(cycle.data_select_active()) {
+		cycle.apply(&page[address & 0xffff]);
+	}
+	return true;
+}
+
+template <class T, bool dtack_is_implicit, bool signal_will_perform> forceinline HalfCycles Processor<T, dtack_is_implicit, signal_will_perform>::report_unreported_time() {
+	if(unreported_time_ == HalfCycles(0)) return HalfCycles(0);
+
+	idle_cycle_.length = unreported_time_;
+	unreported_time_ = HalfCycles(0);
+	return bus_handler_.perform_bus_operation(idle_cycle_, is_supervisor_);
+}
+
 template <class T, bool dtack_is_implicit, bool signal_will_perform> ProcessorState Processor<T, dtack_is_implicit, signal_will_perform>::get_state() {
 	write_back_stack_pointer();
 
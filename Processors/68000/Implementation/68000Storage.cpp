@@ -32,7 +32,8 @@ namespace MC68000 {
 #define Imm		0x14
 
 struct ProcessorStorageConstructor {
-	ProcessorStorageConstructor(ProcessorStorage &storage) : storage_(storage) {}
+	ProcessorStorageConstructor(ProcessorStorage &storage, ProcessorStorage::InstructionSet &instruction_set) :
+		storage_(storage), instruction_set_(instruction_set) {}
 
 	using BusStep = ProcessorStorage::BusStep;
 
@@ -168,11 +169,14 @@ struct ProcessorStorageConstructor {
 		then the corresponding effective address will be incremented or decremented
 		by two after the cycle has completed.
 	*/
-	size_t assemble_program(const char *access_pattern, const std::vector<uint32_t *> &addresses = {}, bool read_full_words = true) {
+	template <typename AddressList = std::initializer_list<uint32_t *>>
+	size_t assemble_program(const char *access_pattern, const AddressList &addresses = {}, bool read_full_words = true) {
 		auto address_iterator = addresses.begin();
 		using Action = BusStep::Action;
 
-		std::vector<BusStep> steps;
+		// Reuse the same working storage for every program, as there are tens of thousands of them.
+		auto &steps = assembly_steps_;
+		steps.clear();
 
 		// Tokenise the access pattern by splitting on spaces.
 		const char *next_access_pattern = access_pattern;
@@ -432,7 +436,7 @@ struct ProcessorStorageConstructor {
 		// If the new steps already exist, just return the existing index to them;
 		// otherwise insert them. A lookup table of steps to start positions within
 		// all_bus_steps_ is maintained to shorten setup time here
-		auto potential_locations = locations_by_bus_step_[steps.front()];
+		const auto &potential_locations = locations_by_bus_step_[steps.front()];
 		for(auto index: potential_locations) {
 			if(index + steps.size() > storage_.all_bus_steps_.size()) continue;
 
@@ -470,7 +474,7 @@ struct ProcessorStorageConstructor {
 		Walks through the sequence of micro-ops beginning at @c start, replacing the value supplied for each write
 		encountered in each micro-op's bus steps with the respective value from @c values.
 	*/
-	void replace_write_values(ProcessorBase::MicroOp *start, const std::initializer_list<RegisterPair16 *> &values) {
+	void replace_write_values(const ProcessorBase::MicroOp *start, const std::initializer_list<RegisterPair16 *> &values) {
 		auto value = values.begin();
 		while(!start->is_terminal()) {
 			value = replace_write_values(&storage_.all_bus_steps_[start->bus_program], value);
@@ -829,7 +833,7 @@ struct ProcessorStorageConstructor {
 		// storage_.all_bus_steps_ at the end.
 //		BusStep arbitrary_base;
 
-#define op(...) 	storage_.all_micro_ops_.emplace_back(__VA_ARGS__)
+#define op(...) 	instruction_set_.micro_ops.emplace_back(__VA_ARGS__)
 #define seq(...)	assemble_program(__VA_ARGS__)
 #define ea(n)		&storage_.effective_address_[n].full
 #define a(n)		&storage_.address_[n].full
@@ -845,7 +849,7 @@ struct ProcessorStorageConstructor {
 			for(const auto &mapping: mappings) {
 				if((instruction & mapping.mask) == mapping.value) {
 					auto operation = mapping.operation;
-					const auto micro_op_start = storage_.all_micro_ops_.size();
+					const auto micro_op_start = instruction_set_.micro_ops.size();
 
 					// The following fields are used commonly enough to be worth pulling out here.
 					const int ea_register = instruction & 7;
@@ -3045,17 +3049,17 @@ struct ProcessorStorageConstructor {
 					}
 
 					// Add a terminating micro operation if necessary.
-					if(!storage_.all_micro_ops_.back().is_terminal()) {
-						storage_.all_micro_ops_.emplace_back();
+					if(!instruction_set_.micro_ops.back().is_terminal()) {
+						instruction_set_.micro_ops.emplace_back();
 					}
 
 					// Ensure that steps that weren't meant to look terminal aren't terminal; also check
 					// for improperly encoded address calculation-type actions.
-					for(auto index = micro_op_start; index < storage_.all_micro_ops_.size() - 1; ++index) {
+					for(auto index = micro_op_start; index < instruction_set_.micro_ops.size() - 1; ++index) {
 
 #ifdef DEBUG
 						// All of the actions below must also nominate a source and/or destination.
-						switch(storage_.all_micro_ops_[index].action) {
+						switch(instruction_set_.micro_ops[index].action) {
 							default: break;
 							case int(Action::CalcD16PC):
 							case int(Action::CalcD8PCXn):
@@ -3074,14 +3078,14 @@ struct ProcessorStorageConstructor {
 						}
 #endif
 
-						if(storage_.all_micro_ops_[index].is_terminal()) {
-							storage_.all_micro_ops_[index].bus_program = uint16_t(seq(""));
+						if(instruction_set_.micro_ops[index].is_terminal()) {
+							instruction_set_.micro_ops[index].bus_program = uint16_t(seq(""));
 						}
 					}
 
 					// Install the operation and make a note of where micro-ops begin.
 					program.operation = operation;
-					storage_.instructions[instruction] = program;
+					instruction_set_.instructions[instruction] = program;
 					micro_op_pointers[size_t(instruction)] = size_t(micro_op_start);
 
 					// Don't search further through the list of possibilities, unless this is a debugging build,
@@ -3100,7 +3104,7 @@ struct ProcessorStorageConstructor {
 		}
 
 		// Throw in the interrupt program.
-		const auto interrupt_pointer = storage_.all_micro_ops_.size();
+		const auto interrupt_pointer = instruction_set_.micro_ops.size();
 
 		// WORKAROUND FOR THE 68000 MAIN LOOP. Hopefully temporary.
 		op(Action::None, seq(""));
@@ -3153,21 +3157,25 @@ struct ProcessorStorageConstructor {
 		// Finalise micro-op and program pointers.
 		for(size_t instruction = 0; instruction < 65536; ++instruction) {
 			if(micro_op_pointers[instruction] != std::numeric_limits<size_t>::max()) {
-				storage_.instructions[instruction].micro_operations = uint32_t(micro_op_pointers[instruction]);
-//				link_operations(&storage_.all_micro_ops_[micro_op_pointers[instruction]], &arbitrary_base);
+				instruction_set_.instructions[instruction].micro_operations = uint32_t(micro_op_pointers[instruction]);
+//				link_operations(&instruction_set_.micro_ops[micro_op_pointers[instruction]], &arbitrary_base);
 			}
 		}
 
-		// Link up the interrupt micro ops.
-		storage_.interrupt_micro_ops_ = &storage_.all_micro_ops_[interrupt_pointer];
+		// Note where the interrupt micro ops begin; more micro-ops may yet be added, so
+		// pointers to them can't be taken until construction is complete.
+		interrupt_micro_op_offset = interrupt_pointer;
 //		link_operations(storage_.interrupt_micro_ops_, &arbitrary_base);
 
 		std::cout << storage_.all_bus_steps_.size() << " total bus steps" << std::endl;
-		std::cout << storage_.all_micro_ops_.size() << " total micro ops" << std::endl;
+		std::cout << instruction_set_.micro_ops.size() << " total micro ops" << std::endl;
 	}
 
+	size_t interrupt_micro_op_offset = 0;
+
 	private:
 		ProcessorStorage &storage_;
+		ProcessorStorage::InstructionSet &instruction_set_;
 
 		std::initializer_list<RegisterPair16 *>::const_iterator replace_write_values(BusStep *start, std::initializer_list<RegisterPair16 *>::const_iterator value) {
 			while(!start->is_terminal()) {
@@ -3199,13 +3207,72 @@ struct ProcessorStorageConstructor {
 			}
 		};
 		std::map<BusStep, std::vector<size_t>, BusStepOrderer> locations_by_bus_step_;
+		std::vector<BusStep> assembly_steps_;
 };
 
 }
 }
 
+const CPU::MC68000::ProcessorStorage &CPU::MC68000::ProcessorStorage::prototype() {
+	static InstructionSet instruction_set;
+	static const ProcessorStorage prototype(instruction_set);
+	return prototype;
+}
+
 CPU::MC68000::ProcessorStorage::ProcessorStorage() {
-	ProcessorStorageConstructor constructor(*this);
+	const ProcessorStorage &source = prototype();
+
+	// Share the instruction set.
+	all_micro_ops_ = source.all_micro_ops_;
+	instructions = source.instructions;
+	long_exception_micro_ops_ = source.long_exception_micro_ops_;
+	short_exception_micro_ops_ = source.short_exception_micro_ops_;
+	interrupt_micro_ops_ = source.interrupt_micro_ops_;
+
+	// Copy the bus steps, redirecting anything that pointed into the prototype to
+	// the equivalent place in this instance.
+	all_bus_steps_ = source.all_bus_steps_;
+	const auto source_base = reinterpret_cast<uintptr_t>(&source);
+	const auto relocate = [&](auto *&pointer) {
+		const auto offset = reinterpret_cast<uintptr_t>(pointer) - source_base;
+		if(offset < sizeof(ProcessorStorage)) {
+			pointer = reinterpret_cast<std::remove_reference_t<decltype(pointer)>>(reinterpret_cast<uintptr_t>(this) + offset);
+		}
+	};
+	for(auto &step: all_bus_steps_) {
+		relocate(step.microcycle.address);
+		relocate(step.microcycle.value);
+	}
+
+	const auto steps = [&](const BusStep *source_steps) {
+		return &all_bus_steps_[size_t(source_steps - source.all_bus_steps_.data())];
+	};
+	reset_bus_steps_ = steps(source.reset_bus_steps_);
+	branch_taken_bus_steps_ = steps(source.branch_taken_bus_steps_);
+	branch_byte_not_taken_bus_steps_ = steps(source.branch_byte_not_taken_bus_steps_);
+	branch_word_not_taken_bus_steps_ = steps(source.branch_word_not_taken_bus_steps_);
+	bsr_bus_steps_ = steps(source.bsr_bus_steps_);
+	dbcc_condition_true_steps_ = steps(source.dbcc_condition_true_steps_);
+	dbcc_condition_false_no_branch_steps_ = steps(source.dbcc_condition_false_no_branch_steps_);
+	dbcc_condition_false_branch_steps_ = steps(source.dbcc_condition_false_branch_steps_);
+	movem_read_steps_ = steps(source.movem_read_steps_);
+	movem_write_steps_ = steps(source.movem_write_steps_);
+	trap_steps_ = steps(source.trap_steps_);
+	bus_error_steps_ = steps(source.bus_error_steps_);
+
+	// Setup the stop cycle.
+	stop_cycle_.length = HalfCycles(2);
+
+	// Set initial state.
+	active_step_ = reset_bus_steps_;
+	effective_address_[0] = 0;
+	is_supervisor_ = 1;
+	interrupt_level_ = 7;
+	address_[7] = 0x00030000;
+}
+
+CPU::MC68000::ProcessorStorage::ProcessorStorage(InstructionSet &instruction_set) {
+	ProcessorStorageConstructor constructor(*this, instruction_set);
 
 	// Create the special programs.
 	const size_t reset_offset = constructor.assemble_program("n n n n n nn nF nf nV nv np np");
@@ -3251,13 +3318,14 @@ CPU::MC68000::ProcessorStorage::ProcessorStorage() {
 	);
 
 	// Chuck in the proper micro-ops for handling an exception.
-	const auto short_exception_offset = all_micro_ops_.size();
-	all_micro_ops_.emplace_back(ProcessorBase::MicroOp::Action::None);
-	all_micro_ops_.emplace_back();
+	auto &micro_ops = instruction_set.micro_ops;
+	const auto short_exception_offset = micro_ops.size();
+	micro_ops.emplace_back(ProcessorBase::MicroOp::Action::None);
+	micro_ops.emplace_back();
 
-	const auto long_exception_offset = all_micro_ops_.size();
-	all_micro_ops_.emplace_back(ProcessorBase::MicroOp::Action::None);
-	all_micro_ops_.emplace_back();
+	const auto long_exception_offset = micro_ops.size();
+	micro_ops.emplace_back(ProcessorBase::MicroOp::Action::None);
+	micro_ops.emplace_back();
 
 	// Install operations.
 //#ifndef NDEBUG
@@ -3268,6 +3336,16 @@ CPU::MC68000::ProcessorStorage::ProcessorStorage() {
 	std::cout << "Construction took " << double(std::clock() - start) / double(CLOCKS_PER_SEC / 1000) << "ms" << std::endl;
 //#endif
 
+	// Complete linkage of the exception micro programs, now that all micro-ops are in place.
+	micro_ops[short_exception_offset].bus_program = uint16_t(trap_offset);
+	micro_ops[long_exception_offset].bus_program = uint16_t(bus_error_offset);
+
+	all_micro_ops_ = micro_ops.data();
+	instructions = instruction_set.instructions;
+	short_exception_micro_ops_ = &all_micro_ops_[short_exception_offset];
+	long_exception_micro_ops_ = &all_micro_ops_[long_exception_offset];
+	interrupt_micro_ops_ = &all_micro_ops_[constructor.interrupt_micro_op_offset];
+
 	// Realise the special programs as direct pointers.
 	reset_bus_steps_ = &all_bus_steps_[reset_offset];
 
@@ -3315,23 +3393,6 @@ CPU::MC68000::ProcessorStorage::ProcessorStorage() {
 		steps[0].microcycle.value = steps[1].microcycle.value = &program_counter_.halves.high;
 		steps[4].microcycle.value = steps[5].microcycle.value = &program_counter_.halves.low;
 	}
-
-	// Setup the stop cycle.
-	stop_cycle_.length = HalfCycles(2);
-
-	// Complete linkage of the exception micro program.
-	short_exception_micro_ops_ = &all_micro_ops_[short_exception_offset];
-	short_exception_micro_ops_->bus_program = uint16_t(trap_offset);
-
-	long_exception_micro_ops_ = &all_micro_ops_[long_exception_offset];
-	long_exception_micro_ops_->bus_program = uint16_t(bus_error_offset);
-
-	// Set initial state.
-	active_step_ = reset_bus_steps_;
-	effective_address_[0] = 0;
-	is_supervisor_ = 1;
-	interrupt_level_ = 7;
-	address_[7] = 0x00030000;
 }
 
 void CPU::MC68000::ProcessorStorage::write_back_stack_pointer() {
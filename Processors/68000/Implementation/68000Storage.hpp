@@ -13,6 +13,15 @@ class ProcessorStorage {
 	public:
 		ProcessorStorage();
 
+		/*!
+			Builds the instruction set shared by all instances, if it hasn't been built already. This is otherwise
+			done upon construction of the first instance, but may be done in advance on any thread, e.g. so that
+			it overlaps other work.
+		*/
+		static void prepare() {
+			prototype();
+		}
+
 	protected:
 		RegisterPair32 data_[8];
 		RegisterPair32 address_[8];
@@ -83,8 +92,20 @@ class ProcessorStorage {
 		bool is_starting_interrupt_ = false;
 
 		HalfCycles half_cycles_left_to_run_;
+		CPU::PCProfiler *profiler_ = nullptr;
 		HalfCycles e_clock_phase_;
 
+		// Fast memory: each 64kb page of the 24-bit address space may be nominated as
+		// directly readable and/or writeable, in which case accesses to it won't be
+		// passed to the bus handler. Time spent on those accesses, and on any idle
+		// microcycles in between, is held in unreported_time_ until the bus handler
+		// is next called, being posted to it then as a single idle microcycle.
+		uint8_t *fast_read_pages_[256]{};
+		uint8_t *fast_write_pages_[256]{};
+		bool uses_fast_memory_ = false;
+		HalfCycles unreported_time_;
+		Microcycle idle_cycle_;
+
 		enum class Operation: uint8_t {
 			None,
 			ABCD,	SBCD,	NBCD,
@@ -419,19 +440,27 @@ class ProcessorStorage {
 			}
 		};
 
-		// Storage for all the sequences of bus steps and micro-ops used throughout
-		// the 68000.
+		// Storage for all the sequences of bus steps used throughout the 68000. Bus steps
+		// point into this instance, and some are modified as it runs, so each instance
+		// has its own copy.
 		std::vector<BusStep> all_bus_steps_;
-		std::vector<MicroOp> all_micro_ops_;
 
-		// A lookup table from instructions to implementations.
-		Program instructions[65536];
+		/*!
+			All micro-ops and the lookup table from instructions to implementations. Neither
+			refers to any particular instance, so both are built once, lazily, and then shared.
+		*/
+		struct InstructionSet {
+			std::vector<MicroOp> micro_ops;
+			Program instructions[65536];
+		};
+		const MicroOp *all_micro_ops_ = nullptr;
+		const Program *instructions = nullptr;
 
 		// Special steps and programs for exception handlers.
 		BusStep *reset_bus_steps_;
-		MicroOp *long_exception_micro_ops_;		// i.e. those that leave 14 bytes on the stack — bus error and address error.
-		MicroOp *short_exception_micro_ops_;	// i.e. those that leave 6 bytes on the stack — everything else (other than interrupts).
-		MicroOp *interrupt_micro_ops_;
+		const MicroOp *long_exception_micro_ops_;		// i.e. those that leave 14 bytes on the stack — bus error and address error.
+		const MicroOp *short_exception_micro_ops_;		// i.e. those that leave 6 bytes on the stack — everything else (other than interrupts).
+		const MicroOp *interrupt_micro_ops_;
 
 		// Special micro-op sequences and storage for conditionals.
 		BusStep *branch_taken_bus_steps_;
@@ -554,6 +583,12 @@ class ProcessorStorage {
 		inline void set_status(uint16_t);
 
 	private:
+		/// Builds the instruction set into @c instruction_set, and this instance's bus steps alongside.
+		ProcessorStorage(InstructionSet &instruction_set);
+
+		/// @returns The instance from which all others take their bus steps, and which owns the shared instruction set.
+		static const ProcessorStorage &prototype();
+
 		friend struct ProcessorStorageConstructor;
 		friend class ProcessorStorageTests;
 		friend struct State;
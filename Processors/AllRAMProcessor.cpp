@@ -8,6 +8,8 @@
 
 #include "AllRAMProcessor.hpp"
 
+#include <cstring>
+
 using namespace CPU;
 
 AllRAMProcessor::AllRAMProcessor(std::size_t memory_size) :
@@ -18,6 +20,7 @@ AllRAMProcessor::AllRAMProcessor(std::size_t memory_size) :
 void AllRAMProcessor::set_data_at_address(size_t start_address, std::size_t length, const uint8_t *data) {
 	const size_t end_address = std::min(start_address + length, memory_.size());
 	memcpy(&memory_[start_address], data, end_address - start_address);
+	did_set_data(start_address, end_address);
 }
 
 void AllRAMProcessor::get_data_at_address(size_t start_address, std::size_t length, uint8_t *data) {
@@ -35,4 +38,5 @@ void AllRAMProcessor::set_trap_handler(TrapHandler *trap_handler) {
 
 void AllRAMProcessor::add_trap_address(uint16_t address) {
 	traps_[address] = true;
+	did_add_trap_address(address);
 }
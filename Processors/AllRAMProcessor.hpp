@@ -9,6 +9,7 @@
 #ifndef AllRAMProcessor_hpp
 #define AllRAMProcessor_hpp
 
+#include <cstddef>
 #include <cstdint>
 #include <set>
 #include <vector>
@@ -35,6 +36,12 @@ class AllRAMProcessor {
 		std::vector<uint8_t> memory_;
 		HalfCycles timestamp_;
 
+		/// Announces that [@c start_address, @c end_address) has been modified via @c set_data_at_address.
+		virtual void did_set_data([[maybe_unused]] size_t start_address, [[maybe_unused]] size_t end_address) {}
+
+		/// Announces that @c address has been added as a trap address.
+		virtual void did_add_trap_address([[maybe_unused]] uint16_t address) {}
+
 		inline void check_address_for_trap(uint16_t address) {
 			if(traps_[address]) {
 				trap_handler_->processor_did_trap(*this, address);
@@ -0,0 +1,144 @@
+//
+//  PCProfiler.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 14/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#ifndef PCProfiler_hpp
+#define PCProfiler_hpp
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/*!
+	Set CPU_PROFILING to a non-zero value to compile program-counter sampling into the
+	processors that support it — the Z80, 6502, 65816 and 68000. When it is zero, as by
+	default, those processors contain no profiling code whatsoever.
+*/
+#ifndef CPU_PROFILING
+#define CPU_PROFILING 0
+#endif
+
+namespace CPU {
+
+/*!
+	A sampling profiler for guest code: once every @c period cycles it records the address of
+	the instruction then underway into a fixed-size histogram.
+
+	Periods are in whatever unit the processor is clocked in — half cycles for the Z80 and
+	68000, whole cycles for the 6502 and 65816. Expiry is noticed only as the next
+	instruction begins, but the sample is attributed to the instruction that was running,
+	so samples are weighted by the time spent in each instruction.
+
+	Attach a profiler to a processor with its @c set_profiler; the processor is then
+	responsible for calling @c grant and @c sample.
+*/
+class PCProfiler {
+	public:
+		/// @c true if processors have been compiled with profiling support.
+		static constexpr bool IsEnabled = CPU_PROFILING;
+
+		/// The number of distinct addresses that can be recorded; samples of further addresses are counted only as @c overflow.
+		static constexpr size_t Capacity = 8192;
+		static constexpr int CapacityBits = 13;
+
+		PCProfiler(int period = 1000) : period_(period), entries_(Capacity) {}
+
+		/// Called by the processor as it is asked to run for @c cycles.
+		void grant(int64_t cycles) {
+			granted_ += cycles;
+		}
+
+		/*!
+			Called by the processor as it begins the instruction at @c address, with @c remaining cycles of
+			what it has been granted so far left to run.
+		*/
+		inline void sample(uint32_t address, int64_t remaining) {
+			const int64_t elapsed = granted_ - remaining;
+			if(elapsed >= next_sample_) {
+				// Attribute every period that has expired to the instruction that was then underway.
+				const int64_t periods = 1 + (elapsed - next_sample_) / period_;
+				next_sample_ += periods * period_;
+				record(previous_address_, uint64_t(periods));
+			}
+			previous_address_ = address;
+		}
+
+		/// @returns Every address sampled and the number of samples of it, most-sampled first.
+		std::vector<std::pair<uint32_t, uint64_t>> histogram() const {
+			std::vector<std::pair<uint32_t, uint64_t>> result;
+			for(const auto &entry: entries_) {
+				if(entry.count) result.emplace_back(entry.address, entry.count);
+			}
+			std::sort(result.begin(), result.end(), [](const auto &lhs, const auto &rhs) {
+				return lhs.second > rhs.second || (lhs.second == rhs.second && lhs.first < rhs.first);
+			});
+			return result;
+		}
+
+		/// @returns The total number of samples taken.
+		uint64_t samples() const {
+			return samples_;
+		}
+
+		/// @returns The number of samples that couldn't be attributed to an address because the histogram was full.
+		uint64_t overflow() const {
+			return overflow_;
+		}
+
+		/// Discards all samples.
+		void reset() {
+			std::fill(entries_.begin(), entries_.end(), Entry());
+			samples_ = overflow_ = 0;
+			occupancy_ = 0;
+		}
+
+	private:
+		static_assert(Capacity == 1 << CapacityBits, "The profiler's capacity must be a power of two");
+
+		struct Entry {
+			uint32_t address = 0;
+			uint64_t count = 0;
+		};
+
+		int64_t period_;
+		int64_t granted_ = 0;
+		int64_t next_sample_ = period_;
+		uint32_t previous_address_ = 0;
+
+		// An open-addressed hash table, keyed by address.
+		std::vector<Entry> entries_;
+		size_t occupancy_ = 0;
+		uint64_t samples_ = 0, overflow_ = 0;
+
+		void record(uint32_t address, uint64_t count) {
+			samples_ += count;
+
+			// Use Fibonacci hashing, so that neighbouring addresses are spread out.
+			size_t index = uint32_t(address * 0x9e3779b1u) >> (32 - CapacityBits);
+			while(entries_[index].count) {
+				if(entries_[index].address == address) {
+					entries_[index].count += count;
+					return;
+				}
+				index = (index + 1) & (Capacity - 1);
+			}
+
+			// Keep some slack so that probes remain short.
+			if(occupancy_ >= Capacity - Capacity / 4) {
+				overflow_ += count;
+				return;
+			}
+			++occupancy_;
+			entries_[index].address = address;
+			entries_[index].count = count;
+		}
+};
+
+}
+
+#endif /* PCProfiler_hpp */
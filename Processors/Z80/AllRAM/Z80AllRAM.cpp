@@ -7,14 +7,18 @@
 //
 
 #include "Z80AllRAM.hpp"
+#include "../State/State.hpp"
+#include "../../../InstructionSets/Z80/Executor.hpp"
+
 #include <algorithm>
 
 using namespace CPU::Z80;
 namespace {
 
-class ConcreteAllRAMProcessor: public AllRAMProcessor, public BusHandler {
+template <bool uses_coarse_timing> class ConcreteAllRAMProcessor:
+	public AllRAMProcessor, public BusHandler, public InstructionSet::Z80::BusHandler {
 	public:
-		ConcreteAllRAMProcessor() : AllRAMProcessor(), z80_(*this) {}
+		ConcreteAllRAMProcessor() : AllRAMProcessor(), z80_(*this), executor_(memory_.data(), *this) {}
 
 		inline HalfCycles perform_machine_cycle(const PartialMachineCycle &cycle) {
 			timestamp_ += cycle.length;
@@ -61,10 +65,33 @@ class ConcreteAllRAMProcessor: public AllRAMProcessor, public BusHandler {
 		}
 
 		void run_for(const Cycles cycles) final {
-			z80_.run_for(cycles);
+			if(!uses_caching_executor_ || memory_delegate_) {
+				use_processor();
+				z80_.run_for(cycles);
+				return;
+			}
+
+			Cycles remaining = cycles;
+			if(!executor_is_active_) {
+				// The executor can pick up only from an instruction boundary.
+				while(!z80_.is_starting_new_instruction() && remaining > Cycles(0)) {
+					z80_.run_for(Cycles(1));
+					--remaining;
+				}
+				if(!z80_.is_starting_new_instruction()) return;
+
+				// Memory may have been modified by the processor since the executor last ran.
+				executor_.memory_did_change(0x0000, 0xffff);
+				executor_.set_state(CPU::Z80::State(z80_));
+				executor_is_active_ = true;
+			}
+
+			executor_.run_for(remaining);
+			timestamp_ += remaining;
 		}
 
 		void run_for_instruction() final {
+			use_processor();
 			int toggles = 0;
 			int cycles = 0;
 
@@ -83,40 +110,104 @@ class ConcreteAllRAMProcessor: public AllRAMProcessor, public BusHandler {
 		}
 
 		uint16_t get_value_of_register(Register r) final {
-			return z80_.get_value_of_register(r);
+			return executor_is_active_ ? executor_.get_value_of_register(r) : z80_.get_value_of_register(r);
 		}
 
 		void set_value_of_register(Register r, uint16_t value) final {
-			z80_.set_value_of_register(r, value);
+			if(executor_is_active_) {
+				executor_.set_value_of_register(r, value);
+			} else {
+				z80_.set_value_of_register(r, value);
+			}
 		}
 
 		bool get_halt_line() final {
-			return z80_.get_halt_line();
+			return executor_is_active_ ? executor_.get_halt_line() : z80_.get_halt_line();
 		}
 
 		void reset_power_on() final {
+			use_processor();
 			return z80_.reset_power_on();
 		}
 
 		void set_interrupt_line(bool value) final {
-			z80_.set_interrupt_line(value);
+			if(executor_is_active_) {
+				executor_.set_interrupt_line(value);
+			} else {
+				z80_.set_interrupt_line(value);
+			}
 		}
 
 		void set_non_maskable_interrupt_line(bool value) final {
-			z80_.set_non_maskable_interrupt_line(value);
+			if(executor_is_active_) {
+				executor_.set_non_maskable_interrupt_line(value);
+			} else {
+				z80_.set_non_maskable_interrupt_line(value);
+			}
 		}
 
 		void set_wait_line(bool value) final {
 			z80_.set_wait_line(value);
 		}
 
+		void set_uses_direct_fetch(bool uses_direct_fetch) final {
+			z80_.set_fetch_pages(0, memory_.size(), uses_direct_fetch ? memory_.data() : nullptr);
+		}
+
+		void set_uses_caching_executor(bool uses_caching_executor) final {
+			uses_caching_executor_ = uses_caching_executor;
+			if(!uses_caching_executor) use_processor();
+		}
+
+		// InstructionSet::Z80::BusHandler.
+		uint8_t input(uint16_t port) final {
+			return port_delegate_ ? port_delegate_->z80_all_ram_processor_input(port) : 0xff;
+		}
+
+		uint8_t interrupt_acknowledge() final {
+			// As per perform_machine_cycle.
+			return 0x21;
+		}
+
+		void did_reach_trap(uint16_t address) final {
+			check_address_for_trap(address);
+		}
+
+	protected:
+		void did_set_data(size_t start_address, size_t end_address) final {
+			if(end_address > start_address) {
+				executor_.memory_did_change(uint16_t(start_address), uint16_t(end_address - 1));
+			}
+		}
+
+		void did_add_trap_address(uint16_t address) final {
+			executor_.add_trap_address(address);
+		}
+
 	private:
-		CPU::Z80::Processor<ConcreteAllRAMProcessor, false, true> z80_;
+		CPU::Z80::Processor<ConcreteAllRAMProcessor, false, true, uses_coarse_timing> z80_;
 		bool was_m1_ = false;
+
+		InstructionSet::Z80::Executor executor_;
+		bool uses_caching_executor_ = false;
+		bool executor_is_active_ = false;
+
+		/// Hands execution back to the cycle-exact Z80 if the executor currently has it.
+		void use_processor() {
+			if(!executor_is_active_) return;
+
+			CPU::Z80::State state;
+			executor_.get_state(state);
+			state.apply(z80_);
+			executor_is_active_ = false;
+		}
 };
 
 }
 
-AllRAMProcessor *AllRAMProcessor::Processor() {
-	return new ConcreteAllRAMProcessor;
+AllRAMProcessor *AllRAMProcessor::Processor(bool uses_coarse_timing) {
+	if(uses_coarse_timing) {
+		return new ConcreteAllRAMProcessor<true>;
+	}
+	return new ConcreteAllRAMProcessor<false>;
 }
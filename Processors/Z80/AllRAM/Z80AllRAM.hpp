@@ -19,7 +19,12 @@ class AllRAMProcessor:
 	public ::CPU::AllRAMProcessor {
 
 	public:
-		static AllRAMProcessor *Processor();
+		/*!
+			@returns A new all-RAM Z80. If @c uses_coarse_timing is @c true then its Z80 will announce only
+				those bus operations that transfer data or refresh memory, plus Internal operations where
+				time can't be attributed to either; see CPU::Z80::Processor.
+		*/
+		static AllRAMProcessor *Processor(bool uses_coarse_timing = false);
 
 		struct MemoryAccessDelegate {
 			virtual void z80_all_ram_processor_did_perform_bus_operation(CPU::Z80::AllRAMProcessor &processor, CPU::Z80::PartialMachineCycle::Operation operation, uint16_t address, uint8_t value, HalfCycles time_stamp) = 0;
@@ -46,6 +51,20 @@ class AllRAMProcessor:
 		virtual void set_non_maskable_interrupt_line(bool value) = 0;
 		virtual void set_wait_line(bool value) = 0;
 
+		/*!
+			Enables or disables direct fetching, by which the Z80 reads opcodes and operands straight from memory.
+			While it is enabled neither traps nor the memory access delegate will observe those fetches, and
+			the time they take is folded into the following bus operation; see CPU::Z80::Processor::set_fetch_pages.
+		*/
+		virtual void set_uses_direct_fetch(bool uses_direct_fetch) = 0;
+
+		/*!
+			Enables or disables use of InstructionSet::Z80::Executor, which runs translated code with only
+			whole-instruction timing and accepts interrupts only at branches; it is used only while there is no
+			memory access delegate. Execution moves between it and the cycle-exact Z80 at instruction boundaries.
+		*/
+		virtual void set_uses_caching_executor(bool uses_caching_executor) = 0;
+
 	protected:
 		MemoryAccessDelegate *memory_delegate_ = nullptr;
 		PortAccessDelegate *port_delegate_ = nullptr;
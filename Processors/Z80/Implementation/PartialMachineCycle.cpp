@@ -12,13 +12,13 @@ using namespace CPU::Z80;
 
 PartialMachineCycle::PartialMachineCycle(const PartialMachineCycle &rhs) noexcept :
 	operation(rhs.operation),
+	was_requested(rhs.was_requested),
 	length(rhs.length),
 	address(rhs.address),
-	value(rhs.value),
-	was_requested(rhs.was_requested) {}
+	value(rhs.value) {}
 
 PartialMachineCycle::PartialMachineCycle(Operation operation, HalfCycles length, uint16_t *address, uint8_t *value, bool was_requested) noexcept :
-	operation(operation), length(length), address(address), value(value), was_requested(was_requested)  {}
+	operation(operation), was_requested(was_requested), length(length), address(address), value(value)  {}
 
 PartialMachineCycle::PartialMachineCycle() noexcept :
-	operation(Internal), length(0), address(nullptr), value(nullptr), was_requested(false) {}
+	operation(Internal), was_requested(false), length(0), address(nullptr), value(nullptr) {}
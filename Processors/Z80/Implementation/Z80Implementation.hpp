@@ -8,7 +8,8 @@
 
 template <	class T,
 			bool uses_bus_request,
-			bool uses_wait_line> Processor <T, uses_bus_request, uses_wait_line>
+			bool uses_wait_line,
+			bool uses_coarse_timing> Processor <T, uses_bus_request, uses_wait_line, uses_coarse_timing>
 				::Processor(T &bus_handler) :
 					bus_handler_(bus_handler) {
 	install_default_instruction_set();
@@ -16,7 +17,8 @@ template <	class T,
 
 template <	class T,
 			bool uses_bus_request,
-			bool uses_wait_line> void Processor <T, uses_bus_request, uses_wait_line>
+			bool uses_wait_line,
+			bool uses_coarse_timing> void Processor <T, uses_bus_request, uses_wait_line, uses_coarse_timing>
 				::run_for(const HalfCycles cycles) {
 #define advance_operation() \
 	pc_increment_ = 1;	\
@@ -32,11 +34,22 @@ template <	class T,
 			scheduled_program_counter_ = irq_program_[interrupt_mode_].data();	\
 		}	\
 	} else {	\
+		if constexpr (CPU::PCProfiler::IsEnabled) {	\
+			if(profiler_) profiler_->sample(pc_.full, number_of_cycles_.as_integral());	\
+		}	\
+		if(!halt_mask_ && !request_status_ && number_of_cycles_ >= HalfCycles(8)) {	\
+			const int halt_fetches = bus_handler_.perform_halt_cycles(pc_.full, number_of_cycles_.as<int>() >> 3);	\
+			number_of_cycles_ -= HalfCycles(halt_fetches * 8);	\
+			ir_.halves.low = uint8_t((ir_.halves.low & 0x80) | ((ir_.halves.low + halt_fetches) & 0x7f));	\
+		}	\
 		current_instruction_page_ = &base_page_;	\
 		scheduled_program_counter_ = base_page_.fetch_decode_execute_data;	\
 	}
 
 	number_of_cycles_ += cycles;
+	if constexpr (CPU::PCProfiler::IsEnabled) {
+		if(profiler_) profiler_->grant(cycles.as_integral());
+	}
 	if(!scheduled_program_counter_) {
 		advance_operation();
 	}
@@ -61,15 +74,36 @@ template <	class T,
 	flag_adjustment_history_ |= 1;
 
 #define set_parity(v)	\
-	parity_overflow_result_ = uint8_t(v^1);\
-	parity_overflow_result_ ^= parity_overflow_result_ >> 4;\
-	parity_overflow_result_ ^= parity_overflow_result_ << 2;\
-	parity_overflow_result_ ^= parity_overflow_result_ >> 1;
+	parity_overflow_result_ = FlagTables::parity[uint8_t(v)];
 
 			switch(operation->type) {
+				case MicroOp::FetchOperation: {
+					const uint8_t *const page = fetch_pages_[pc_.full >> 12];
+					if(page) {
+						if(number_of_cycles_ < operation->machine_cycle.length) {
+							scheduled_program_counter_--;
+							if(unannounced_fetch_length_ > HalfCycles(0)) announce_fetch_length();
+							bus_handler_.flush();
+							return;
+						}
+
+						// Direct fetches never wait.
+						if(operation->machine_cycle.was_requested) continue;
+
+						number_of_cycles_ -= operation->machine_cycle.length;
+						unannounced_fetch_length_ += operation->machine_cycle.length;
+						last_request_status_ = request_status_;
+						last_address_bus_ = pc_.full;
+						*operation->machine_cycle.value = page[pc_.full & 0xfff];
+						break;
+					}
+				}
+				[[fallthrough]];
+
 				case MicroOp::BusOperation:
 					if(number_of_cycles_ < operation->machine_cycle.length) {
 						scheduled_program_counter_--;
+						if(unannounced_fetch_length_ > HalfCycles(0)) announce_fetch_length();
 						bus_handler_.flush();
 						return;
 					}
@@ -86,7 +120,11 @@ template <	class T,
 					// TODO: eliminate this conditional if all bus cycles have an address filled in.
 					last_address_bus_ = operation->machine_cycle.address ? *operation->machine_cycle.address : 0xdead;
 
-					number_of_cycles_ -= bus_handler_.perform_machine_cycle(operation->machine_cycle);
+					if(unannounced_fetch_length_ > HalfCycles(0)) {
+						announce_fetch_length(operation->machine_cycle);
+					} else {
+						number_of_cycles_ -= bus_handler_.perform_machine_cycle(operation->machine_cycle);
+					}
 					if(uses_bus_request && bus_request_line_) goto do_bus_acknowledge;
 				break;
 				case MicroOp::MoveToNextProgram:
@@ -98,7 +136,7 @@ template <	class T,
 				break;
 				case MicroOp::DecodeOperation:
 					pc_.full += pc_increment_ & uint16_t(halt_mask_);
-					scheduled_program_counter_ = current_instruction_page_->instructions[operation_ & halt_mask_];
+					scheduled_program_counter_ = &micro_ops_[current_instruction_page_->instructions[operation_ & halt_mask_]];
 					flag_adjustment_history_ <<= 1;
 				break;
 
@@ -321,45 +359,14 @@ template <	class T,
 				} break;
 
 				case MicroOp::DAA: {
-					const int lowNibble = a_ & 0xf;
-					const int highNibble = a_ >> 4;
-					int amountToAdd = 0;
-
-					if(carry_result_ & Flag::Carry) {
-						amountToAdd = (lowNibble > 0x9 || (half_carry_result_ & Flag::HalfCarry)) ? 0x66 : 0x60;
-					} else {
-						if(half_carry_result_ & Flag::HalfCarry) {
-							if(lowNibble > 0x9)
-								amountToAdd = (highNibble > 0x8) ? 0x66 : 0x06;
-							else
-								amountToAdd = (highNibble > 0x9) ? 0x66 : 0x06;
-						} else {
-							if(lowNibble > 0x9)
-								amountToAdd = (highNibble > 0x8) ? 0x66 : 0x06;
-							else
-								amountToAdd = (highNibble > 0x9) ? 0x60 : 0x00;
-						}
-					}
-
-					if(!(carry_result_ & Flag::Carry)) {
-						if(lowNibble > 0x9) {
-							if(highNibble > 0x8) carry_result_ = Flag::Carry;
-						} else {
-							if(highNibble > 0x9) carry_result_ = Flag::Carry;
-						}
-					}
-
-					if(subtract_flag_) {
-						a_ -= amountToAdd;
-						half_carry_result_ = ((half_carry_result_ & Flag::HalfCarry) && lowNibble < 0x6) ? Flag::HalfCarry : 0;
-					} else {
-						a_ += amountToAdd;
-						half_carry_result_ = (lowNibble > 0x9) ? Flag::HalfCarry : 0;
-					}
-
+					const uint16_t result = FlagTables::daa[FlagTables::daa_index(a_, carry_result_ & Flag::Carry, half_carry_result_ & Flag::HalfCarry, subtract_flag_)];
+					a_ = uint8_t(result);
 					sign_result_ = zero_result_ = bit53_result_ = a_;
 
-					set_parity(a_);
+					const uint8_t flags = uint8_t(result >> 8);
+					carry_result_ = flags & Flag::Carry;
+					half_carry_result_ = flags & Flag::HalfCarry;
+					parity_overflow_result_ = flags & Flag::Parity;
 					set_did_compute_flags();
 				} break;
 
@@ -900,7 +907,8 @@ template <	class T,
 
 template <	class T,
 			bool uses_bus_request,
-			bool uses_wait_line> void Processor <T, uses_bus_request, uses_wait_line>
+			bool uses_wait_line,
+			bool uses_coarse_timing> void Processor <T, uses_bus_request, uses_wait_line, uses_coarse_timing>
 				::set_bus_request_line(bool value) {
 	assert(uses_bus_request);
 	bus_request_line_ = value;
@@ -908,14 +916,16 @@ template <	class T,
 
 template <	class T,
 			bool uses_bus_request,
-			bool uses_wait_line> bool Processor <T, uses_bus_request, uses_wait_line>
+			bool uses_wait_line,
+			bool uses_coarse_timing> bool Processor <T, uses_bus_request, uses_wait_line, uses_coarse_timing>
 				::get_bus_request_line() const {
 	return bus_request_line_;
 }
 
 template <	class T,
 			bool uses_bus_request,
-			bool uses_wait_line> void Processor <T, uses_bus_request, uses_wait_line>
+			bool uses_wait_line,
+			bool uses_coarse_timing> void Processor <T, uses_bus_request, uses_wait_line, uses_coarse_timing>
 				::set_wait_line(bool value) {
 	assert(uses_wait_line);
 	wait_line_ = value;
@@ -923,16 +933,36 @@ template <	class T,
 
 template <	class T,
 			bool uses_bus_request,
-			bool uses_wait_line> bool Processor <T, uses_bus_request, uses_wait_line>
+			bool uses_wait_line,
+			bool uses_coarse_timing> bool Processor <T, uses_bus_request, uses_wait_line, uses_coarse_timing>
 				::get_wait_line() const {
 	return wait_line_;
 }
 
+template <	class T,
+			bool uses_bus_request,
+			bool uses_wait_line,
+			bool uses_coarse_timing> void Processor <T, uses_bus_request, uses_wait_line, uses_coarse_timing>
+				::announce_fetch_length(const PartialMachineCycle &cycle) {
+	const PartialMachineCycle announced(cycle.operation, cycle.length + unannounced_fetch_length_, const_cast<uint16_t *>(cycle.address), cycle.value, cycle.was_requested);
+	unannounced_fetch_length_ = HalfCycles(0);
+	number_of_cycles_ -= bus_handler_.perform_machine_cycle(announced);
+}
+
+template <	class T,
+			bool uses_bus_request,
+			bool uses_wait_line,
+			bool uses_coarse_timing> void Processor <T, uses_bus_request, uses_wait_line, uses_coarse_timing>
+				::announce_fetch_length() {
+	announce_fetch_length(PartialMachineCycle(PartialMachineCycle::Internal, HalfCycles(0), &last_address_bus_, nullptr, false));
+}
+
 #define isTerminal(n)	(n == MicroOp::MoveToNextProgram || n == MicroOp::DecodeOperation)
 
 template <	class T,
 			bool uses_bus_request,
-			bool uses_wait_line> void Processor <T, uses_bus_request, uses_wait_line>
+			bool uses_wait_line,
+			bool uses_coarse_timing> void Processor <T, uses_bus_request, uses_wait_line, uses_coarse_timing>
 				::assemble_page(InstructionPage &target, InstructionTable &table, bool add_offsets) {
 	std::size_t number_of_micro_ops = 0;
 	std::size_t lengths[256];
@@ -947,14 +977,12 @@ template <	class T,
 	}
 
 	// Allocate a landing area.
-	std::vector<std::size_t> operation_indices;
-	target.all_operations.reserve(number_of_micro_ops);
-	target.instructions.resize(256, nullptr);
+	micro_ops_.reserve(micro_ops_.size() + number_of_micro_ops);
 
 	// Copy in all programs, recording where they go.
-	std::size_t destination = 0;
 	for(std::size_t c = 0; c < 256; c++) {
-		operation_indices.push_back(target.all_operations.size());
+		target.instructions[c] = micro_op_offset();
+		HalfCycles unreported_length;
 		for(std::size_t t = 0; t < lengths[c];) {
 			// Skip zero-length bus cycles.
 			if(table[c][t].type == MicroOp::BusOperation && table[c][t].machine_cycle.length.as_integral() == 0) {
@@ -978,27 +1006,21 @@ template <	class T,
 					t++;
 				}
 			}
-			target.all_operations.emplace_back(table[c][t]);
-			destination++;
+			append_operation(micro_ops_, table[c][t], unreported_length);
 			t++;
 		}
 	}
-
-	// Since the vector won't change again, it's now safe to set pointers.
-	std::size_t c = 0;
-	for(std::size_t index : operation_indices) {
-		target.instructions[c] = &target.all_operations[index];
-		c++;
-	}
 }
 
 template <	class T,
 			bool uses_bus_request,
-			bool uses_wait_line> void Processor <T, uses_bus_request, uses_wait_line>
+			bool uses_wait_line,
+			bool uses_coarse_timing> void Processor <T, uses_bus_request, uses_wait_line, uses_coarse_timing>
 		::copy_program(const MicroOp *source, std::vector<MicroOp> &destination) {
 	std::size_t length = 0;
 	while(!isTerminal(source[length].type)) length++;
 	std::size_t pointer = 0;
+	HalfCycles unreported_length;
 	while(true) {
 		// TODO: This test is duplicated from assemble_page; can a better factoring be found?
 		// Skip optional waits if this instance doesn't use the wait line.
@@ -1007,12 +1029,54 @@ template <	class T,
 			continue;
 		}
 
-		destination.emplace_back(source[pointer]);
+		append_operation(destination, source[pointer], unreported_length);
 		if(isTerminal(source[pointer].type)) break;
 		pointer++;
 	}
 }
 
+template <	class T,
+			bool uses_bus_request,
+			bool uses_wait_line,
+			bool uses_coarse_timing> void Processor <T, uses_bus_request, uses_wait_line, uses_coarse_timing>
+		::append_operation(std::vector<MicroOp> &destination, const MicroOp &operation, HalfCycles &unreported_length) {
+	if constexpr (uses_coarse_timing) {
+		if(operation.type == MicroOp::BusOperation) {
+			const PartialMachineCycle &cycle = operation.machine_cycle;
+
+			// Wait-line samples are kept as they are, so that wait states are still honoured.
+			if(cycle.was_requested) {
+				destination.emplace_back(operation);
+				return;
+			}
+
+			// Cycles that do nothing but pass time are withheld, to be added to the next that does something.
+			if(!cycle.is_terminal() || cycle.operation == PartialMachineCycle::Internal) {
+				unreported_length += cycle.length;
+				return;
+			}
+
+			if(unreported_length > HalfCycles(0)) {
+				destination.push_back({
+					MicroOp::BusOperation, operation.source, operation.destination,
+					{cycle.operation, cycle.length + unreported_length, const_cast<uint16_t *>(cycle.address), cycle.value, false}
+				});
+				unreported_length = HalfCycles(0);
+				return;
+			}
+		} else if(unreported_length > HalfCycles(0)) {
+			// Any other sort of micro-op might end or redirect the program, so time can't be withheld
+			// beyond it; report whatever has accumulated as a single Internal cycle.
+			destination.push_back(
+				{MicroOp::BusOperation, nullptr, nullptr, {PartialMachineCycle::Internal, unreported_length, &last_address_bus_, nullptr, false}}
+			);
+			unreported_length = HalfCycles(0);
+		}
+	}
+
+	destination.emplace_back(operation);
+}
+
 #undef isTerminal
 
 bool ProcessorBase::get_halt_line() const {
@@ -167,6 +167,11 @@ void ProcessorStorage::install_default_instruction_set() {
 	assemble_fetch_decode_execute(fdcb_page_, 3);
 	assemble_fetch_decode_execute(ddcb_page_, 3);
 
+	// All pages are now complete, so micro_ops_ won't move again.
+	for(auto page: {&base_page_, &ed_page_, &fd_page_, &dd_page_, &cb_page_, &fdcb_page_, &ddcb_page_}) {
+		page->fetch_decode_execute_data = &micro_ops_[page->fetch_decode_execute];
+	}
+
 	MicroOp reset_program[] = Sequence(InternalOperation(6), {MicroOp::Reset});
 
 	// Justification for NMI timing: per Wilf Rigter on the ZX81 (http://www.user.dccnet.com/wrigter/index_files/ZX81WAIT.htm),
@@ -217,6 +222,29 @@ void ProcessorStorage::install_default_instruction_set() {
 	copy_program(irq_mode0_program, irq_program_[0]);
 	copy_program(irq_mode1_program, irq_program_[1]);
 	copy_program(irq_mode2_program, irq_program_[2]);
+
+	for(auto program: {&micro_ops_, &conditional_call_untaken_program_, &reset_program_, &irq_program_[0], &irq_program_[1], &irq_program_[2], &nmi_program_}) {
+		tag_fetch_operations(*program);
+	}
+}
+
+void ProcessorStorage::tag_fetch_operations(std::vector<MicroOp> &program) {
+	for(auto &operation: program) {
+		if(operation.type != MicroOp::BusOperation || operation.machine_cycle.address != &pc_.full) continue;
+
+		switch(operation.machine_cycle.operation) {
+			case PartialMachineCycle::ReadOpcodeStart:
+			case PartialMachineCycle::ReadOpcodeWait:
+			case PartialMachineCycle::ReadOpcode:
+			case PartialMachineCycle::ReadStart:
+			case PartialMachineCycle::ReadWait:
+			case PartialMachineCycle::Read:
+				operation.type = MicroOp::FetchOperation;
+			break;
+
+			default: break;
+		}
+	}
 }
 
 void ProcessorStorage::assemble_ed_page(InstructionPage &target) {
@@ -525,14 +553,15 @@ void ProcessorStorage::assemble_fetch_decode_execute(InstructionPage &target, in
 		{ MicroOp::DecodeOperation },
 	};
 
-	copy_program((length == 4) ? normal_fetch_decode_execute : short_fetch_decode_execute, target.fetch_decode_execute);
-	target.fetch_decode_execute_data = target.fetch_decode_execute.data();
+	target.fetch_decode_execute = micro_op_offset();
+	copy_program((length == 4) ? normal_fetch_decode_execute : short_fetch_decode_execute, micro_ops_);
+	target.fetch_decode_execute_length = uint16_t(micro_op_offset() - target.fetch_decode_execute);
 }
 
 bool ProcessorBase::is_starting_new_instruction() const {
 	return
 		current_instruction_page_ == &base_page_ &&
-		scheduled_program_counter_ == &base_page_.fetch_decode_execute[0];
+		scheduled_program_counter_ == base_page_.fetch_decode_execute_data;
 }
 
 bool ProcessorBase::get_is_resetting() const {
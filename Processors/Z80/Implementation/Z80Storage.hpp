@@ -11,11 +11,75 @@
 	class in order to remove it from visibility within the main Z80.hpp.
 */
 
+/*!
+	Lookup tables for those flags that can't be captured simply by storing a result.
+*/
+struct FlagTables {
+	/// Maps each 8-bit value to @c Flag::Parity if it has even parity, or to 0 otherwise.
+	static constexpr std::array<uint8_t, 256> parity = [] {
+		std::array<uint8_t, 256> table{};
+		for(int c = 0; c < 256; c++) {
+			int bits = c;
+			bits ^= bits >> 4;
+			bits ^= bits >> 2;
+			bits ^= bits >> 1;
+			table[std::size_t(c)] = (bits & 1) ? 0 : Flag::Parity;
+		}
+		return table;
+	}();
+
+	/// @returns The index into @c daa for accumulator @c a and flags @c carry, @c half_carry and @c subtract,
+	/// each of which is tested only for being non-zero.
+	static constexpr std::size_t daa_index(uint8_t a, bool carry, bool half_carry, bool subtract) {
+		return std::size_t(a) | (carry ? 0x100 : 0) | (half_carry ? 0x200 : 0) | (subtract ? 0x400 : 0);
+	}
+
+	/// Maps each possible input to DAA, per @c daa_index, to the resulting accumulator in its low byte and
+	/// the resulting half-carry, parity and carry flags in its high byte.
+	static constexpr std::array<uint16_t, 2048> daa = [] {
+		std::array<uint16_t, 2048> table{};
+		for(std::size_t c = 0; c < table.size(); c++) {
+			const uint8_t a = uint8_t(c);
+			const bool carry = c & 0x100, half_carry = c & 0x200, subtract = c & 0x400;
+			const int low_nibble = a & 0xf;
+			const int high_nibble = a >> 4;
+
+			// Decisions about the high nibble compare it with 8 if the low nibble exceeds 9, or with 9 otherwise.
+			const int high_nibble_limit = (low_nibble > 0x9) ? 0x8 : 0x9;
+
+			int amount_to_add;
+			if(carry) {
+				amount_to_add = (low_nibble > 0x9 || half_carry) ? 0x66 : 0x60;
+			} else if(half_carry) {
+				amount_to_add = (high_nibble > high_nibble_limit) ? 0x66 : 0x06;
+			} else if(low_nibble > 0x9) {
+				amount_to_add = (high_nibble > 0x8) ? 0x66 : 0x06;
+			} else {
+				amount_to_add = (high_nibble > 0x9) ? 0x60 : 0x00;
+			}
+
+			const bool result_carry = carry || high_nibble > high_nibble_limit;
+			const bool result_half_carry = subtract ? (half_carry && low_nibble < 0x6) : (low_nibble > 0x9);
+			const uint8_t result = uint8_t(subtract ? a - amount_to_add : a + amount_to_add);
+
+			const uint8_t flags = uint8_t(
+				(result_carry ? Flag::Carry : 0) |
+				(result_half_carry ? Flag::HalfCarry : 0) |
+				parity[result]);
+			table[c] = uint16_t(result | (flags << 8));
+		}
+		return table;
+	}();
+};
+
 class ProcessorStorage {
 	protected:
 		struct MicroOp {
 			enum Type {
 				BusOperation,
+				/// A bus operation that reads from the address in @c pc_, i.e. part of an opcode or operand fetch;
+				/// it is satisfied from @c fetch_pages_ where possible, and is otherwise a @c BusOperation.
+				FetchOperation,
 				IncrementR,
 				DecodeOperation,
 				MoveToNextProgram,
@@ -116,14 +180,24 @@ class ProcessorStorage {
 			PartialMachineCycle machine_cycle{};
 		};
 
+		/*!
+			An instruction page maps each opcode to its program, by offset within @c micro_ops_;
+			offsets rather than pointers keep each page's table to a few cache lines.
+		*/
 		struct InstructionPage {
-			std::vector<MicroOp *> instructions;
-			std::vector<MicroOp> all_operations;
-			std::vector<MicroOp> fetch_decode_execute;
-			MicroOp *fetch_decode_execute_data = nullptr;
+			uint16_t instructions[256]{};
+			uint16_t fetch_decode_execute = 0, fetch_decode_execute_length = 0;
+			const MicroOp *fetch_decode_execute_data = nullptr;
 			bool is_indexed = false;
 		};
 
+		/// The programs of all instruction pages, stored contiguously.
+		std::vector<MicroOp> micro_ops_;
+		uint16_t micro_op_offset() const {
+			assert(micro_ops_.size() <= 0xffff);
+			return uint16_t(micro_ops_.size());
+		}
+
 		ProcessorStorage();
 		void install_default_instruction_set();
 
@@ -151,6 +225,13 @@ class ProcessorStorage {
 		uint16_t last_address_bus_ = 0;				// The value most recently put out on the address bus.
 
 		HalfCycles number_of_cycles_;
+		CPU::PCProfiler *profiler_ = nullptr;
+
+		/// Memory from which opcodes and operands can be fetched directly, per 4kb page; @c nullptr for any page
+		/// that the bus handler should be asked about.
+		const uint8_t *fetch_pages_[16]{};
+		/// Time spent on direct fetches that has not yet been announced to the bus handler.
+		HalfCycles unannounced_fetch_length_;
 
 		enum Interrupt: uint8_t {
 			IRQ			= 0x01,
@@ -225,6 +306,7 @@ class ProcessorStorage {
 		virtual void copy_program(const MicroOp *source, std::vector<MicroOp> &destination) = 0;
 
 		void assemble_fetch_decode_execute(InstructionPage &target, int length);
+		void tag_fetch_operations(std::vector<MicroOp> &program);
 		void assemble_ed_page(InstructionPage &target);
 		void assemble_cb_page(InstructionPage &target, RegisterPair16 &index, bool add_offsets);
 		void assemble_base_page(InstructionPage &target, RegisterPair16 &index, bool add_offsets, InstructionPage &cb_page);
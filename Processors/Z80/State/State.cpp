@@ -57,7 +57,14 @@ State::State(const ProcessorBase &src): State() {
 	execution_state.phase = ExecutionState::Phase::x;	\
 	execution_state.steps_into_phase = int(src.scheduled_program_counter_ - &src.y[0]);
 
-	if(ContainedBy(conditional_call_untaken_program_)) {
+	if(!src.scheduled_program_counter_) {
+		// The processor hasn't yet run, so will begin with the reset program; record it as
+		// having done so, since that's what will happen upon the next run_for.
+		execution_state.phase = ExecutionState::Phase::Reset;
+		execution_state.steps_into_phase = 0;
+		execution_state.requests &= ~ProcessorBase::Interrupt::PowerOn;
+		execution_state.last_requests &= ~ProcessorBase::Interrupt::PowerOn;
+	} else if(ContainedBy(conditional_call_untaken_program_)) {
 		Populate(UntakenConditionalCall, conditional_call_untaken_program_);
 	} else if(ContainedBy(reset_program_)) {
 		Populate(Reset, reset_program_);
@@ -86,12 +93,20 @@ State::State(const ProcessorBase &src): State() {
 			execution_state.instruction_page = 0xddcb;
 		}
 
-		if(ContainedBy(current_instruction_page_->fetch_decode_execute)) {
-			Populate(FetchDecode, current_instruction_page_->fetch_decode_execute);
+		const ProcessorStorage::InstructionPage &page = *src.current_instruction_page_;
+		const auto fetch_decode_execute = page.fetch_decode_execute_data;
+		if(
+			src.scheduled_program_counter_ >= fetch_decode_execute &&
+			src.scheduled_program_counter_ < fetch_decode_execute + page.fetch_decode_execute_length
+		) {
+			execution_state.phase = ExecutionState::Phase::FetchDecode;
+			execution_state.steps_into_phase = int(src.scheduled_program_counter_ - fetch_decode_execute);
 		} else {
 			// There's no need to determine which opcode because that knowledge is already
 			// contained in the dedicated opcode field.
-			Populate(Operation, current_instruction_page_->instructions[src.operation_ & src.halt_mask_]);
+			execution_state.phase = ExecutionState::Phase::Operation;
+			execution_state.steps_into_phase =
+				int(src.scheduled_program_counter_ - &src.micro_ops_[page.instructions[src.operation_ & src.halt_mask_]]);
 		}
 	}
 
@@ -101,7 +116,7 @@ State::State(const ProcessorBase &src): State() {
 #undef ContainedBy
 }
 
-void State::apply(ProcessorBase &target) {
+void State::apply(ProcessorBase &target) const {
 	// Registers.
 	target.a_ = registers.a;
 	target.set_flags(registers.flags);
@@ -157,8 +172,8 @@ void State::apply(ProcessorBase &target) {
 		case ExecutionState::Phase::IRQMode1:					target.scheduled_program_counter_ = &target.irq_program_[1][0];											break;
 		case ExecutionState::Phase::IRQMode2:					target.scheduled_program_counter_ = &target.irq_program_[2][0];											break;
 		case ExecutionState::Phase::NMI:						target.scheduled_program_counter_ = &target.nmi_program_[0];											break;
-		case ExecutionState::Phase::FetchDecode:				target.scheduled_program_counter_ = &target.current_instruction_page_->fetch_decode_execute[0];			break;
-		case ExecutionState::Phase::Operation:					target.scheduled_program_counter_ = target.current_instruction_page_->instructions[target.operation_];	break;
+		case ExecutionState::Phase::FetchDecode:				target.scheduled_program_counter_ = target.current_instruction_page_->fetch_decode_execute_data;				break;
+		case ExecutionState::Phase::Operation:					target.scheduled_program_counter_ = &target.micro_ops_[target.current_instruction_page_->instructions[target.operation_]];	break;
 	}
 	target.scheduled_program_counter_ += execution_state.steps_into_phase;
 }
@@ -9,10 +9,12 @@
 #ifndef Z80_hpp
 #define Z80_hpp
 
+#include <array>
 #include <cassert>
 #include <vector>
 #include <cstdint>
 
+#include "../PCProfiler.hpp"
 #include "../RegisterSizes.hpp"
 #include "../../ClockReceiver/ClockReceiver.hpp"
 #include "../../ClockReceiver/ForceInline.hpp"
@@ -116,14 +118,15 @@ struct PartialMachineCycle {
 	};
 	/// The operation being carried out by the Z80. See the various getters below for better classification.
 	const Operation operation = Operation::Internal;
+	/// @c true if this operation is occurring only because of an external request; @c false otherwise.
+	/// Declared here rather than last so that it occupies what would otherwise be padding.
+	const bool was_requested = false;
 	/// The length of this operation.
 	const HalfCycles length;
 	/// The current value of the address bus.
 	const uint16_t *const address = nullptr;
 	/// If the Z80 is outputting to the data bus, a pointer to that value. Otherwise, a pointer to the location where the current data bus value should be placed.
 	uint8_t *const value = nullptr;
-	/// @c true if this operation is occurring only because of an external request; @c false otherwise.
-	const bool was_requested = false;
 
 	/*!
 		@returns @c true if the processor believes that the bus handler should actually do something with
@@ -400,6 +403,21 @@ class BusHandler {
 			return HalfCycles(0);
 		}
 
+		/*!
+			Offered whenever the Z80 is halted with no interrupt requested, before it repeats the four-cycle
+			NOP fetch from @c address that it performs until one is.
+
+			Bus handlers that know when their interrupt inputs might next change may account for up to
+			@c maximum of those fetches at once, without their being announced, by advancing time by four
+			cycles for each — provided that doing so doesn't take them beyond that point, and that none of
+			those fetches would have been subject to wait states or contention.
+
+			@returns The number of fetches accounted for, in the range [0, @c maximum].
+		*/
+		int perform_halt_cycles([[maybe_unused]] uint16_t address, [[maybe_unused]] int maximum) {
+			return 0;
+		}
+
 		/*!
 			Announces completion of all the cycles supplied to a .run_for request on the Z80. Intended to allow
 			bus handlers to perform any deferred output work.
@@ -414,6 +432,40 @@ class BusHandler {
 */
 class ProcessorBase: public ProcessorStorage {
 	public:
+		/// Attaches @c profiler, which will be supplied with program counter samples if CPU_PROFILING is enabled.
+		void set_profiler(CPU::PCProfiler *profiler) {
+			profiler_ = profiler;
+		}
+
+		/*!
+			Publishes @c data as the memory that opcodes and operands should be read from in the range [@c start, @c start + @c length),
+			which must be aligned to 4kb boundaries; supply @c nullptr to return the range to the bus handler.
+
+			Within published ranges the Z80 will fetch code directly rather than announcing the corresponding
+			ReadOpcodeStart, ReadOpcode, ReadStart, Read and wait cycles. The time they take is added instead to the
+			next cycle that is announced, or is announced as an Internal cycle if @c run_for ends first. Refresh cycles
+			and all other reads and writes are announced as usual.
+
+			So only ranges in which reading code has no side effects and never incurs a wait or other delay should be published.
+			Publications remain in effect until replaced, so should be updated whenever paging changes.
+		*/
+		void set_fetch_pages(uint16_t start, std::size_t length, const uint8_t *data) {
+			assert(!(start & 0xfff) && !(length & 0xfff) && start + length <= 0x10000);
+			for(std::size_t page = start >> 12; page < (start + length) >> 12; page++) {
+				fetch_pages_[page] = data;
+				if(data) data += 0x1000;
+			}
+		}
+
+		/// @returns The number of bytes occupied by this processor's instruction pages and micro-op programs.
+		size_t get_table_footprint() const {
+			size_t footprint = sizeof(InstructionPage) * 7;
+			for(const auto program: {&micro_ops_, &conditional_call_untaken_program_, &reset_program_, &irq_program_[0], &irq_program_[1], &irq_program_[2], &nmi_program_}) {
+				footprint += program->capacity() * sizeof(MicroOp);
+			}
+			return footprint;
+		}
+
 		/*!
 			Gets the value of a register.
 
@@ -498,8 +550,18 @@ class ProcessorBase: public ProcessorStorage {
 	will announce its activity via the bus handler, which is responsible for marrying it to a bus. Users
 	can also nominate whether the processor includes support for the bus request and/or wait lines. Declining to
 	support either can produce a minor runtime performance improvement.
+
+	Users that don't need to observe the bus cycle by cycle can also nominate coarse timing. The Z80 will then
+	omit from its announcements those partial machine cycles that exist only to mark the passage of time —
+	the opening portions of each machine cycle and all Internal cycles — adding their lengths instead to
+	the next cycle that transfers data or refreshes memory, so that far fewer are announced and each is
+	longer. Time that can't be so attributed, e.g. because the program it's part of might end before
+	the next transfer, is announced as a single Internal cycle. Requested wait cycles are announced as
+	normal, immediately before the cycle that they extend, and the bus request line is sampled as usual
+	after each announced cycle. The processor's state as captured by @c State is meaningful only to
+	processors that use the same timing.
 */
-template <class T, bool uses_bus_request, bool uses_wait_line> class Processor: public ProcessorBase {
+template <class T, bool uses_bus_request, bool uses_wait_line, bool uses_coarse_timing = false> class Processor: public ProcessorBase {
 	public:
 		Processor(T &bus_handler);
 
@@ -539,6 +601,12 @@ template <class T, bool uses_bus_request, bool uses_wait_line> class Processor:
 
 		void assemble_page(InstructionPage &target, InstructionTable &table, bool add_offsets);
 		void copy_program(const MicroOp *source, std::vector<MicroOp> &destination);
+		void append_operation(std::vector<MicroOp> &destination, const MicroOp &operation, HalfCycles &unreported_length);
+
+		// Announces @c cycle, lengthened by any time spent on direct fetches since the last announcement,
+		// or announces that time as an Internal cycle. Kept out of line as direct fetch is optional.
+		neverinline void announce_fetch_length(const PartialMachineCycle &cycle);
+		neverinline void announce_fetch_length();
 };
 
 #include "Implementation/Z80Implementation.hpp"
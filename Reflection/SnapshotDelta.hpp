@@ -0,0 +1,209 @@
+//
+//  SnapshotDelta.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 14/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#ifndef SnapshotDelta_hpp
+#define SnapshotDelta_hpp
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace Reflection {
+
+/// The granularity, in bytes, at which snapshot deltas record changes.
+constexpr size_t SnapshotDeltaPageSize = 256;
+
+/*!
+	Compares two binary snapshots, as produced by @c Struct::snapshot, and records only those pages
+	of @c current that differ from @c previous. Most of a machine's snapshot is usually its RAM, of
+	which little changes from one frame to the next, so a delta is typically far smaller than a snapshot.
+
+	Applying the result to a copy of @c previous via @c apply_snapshot_delta reproduces @c current;
+	a delta from @c current to @c previous can be kept instead in order to step backwards.
+
+	Format: the 64-bit size of @c current, then any number of runs, each being a 32-bit index of its
+	first page, a 32-bit count of pages and then those pages' contents, the final page of the
+	snapshot being truncated to its actual size.
+*/
+inline std::vector<uint8_t> snapshot_delta(const std::vector<uint8_t> &previous, const std::vector<uint8_t> &current) {
+	std::vector<uint8_t> delta;
+	const auto append = [&delta](const void *data, size_t size) {
+		const auto bytes = reinterpret_cast<const uint8_t *>(data);
+		delta.insert(delta.end(), bytes, bytes + size);
+	};
+
+	const uint64_t size = current.size();
+	append(&size, sizeof(size));
+
+	const size_t pages = (current.size() + SnapshotDeltaPageSize - 1) / SnapshotDeltaPageSize;
+	const auto page_differs = [&](size_t page) {
+		const size_t start = page * SnapshotDeltaPageSize;
+		const size_t length = std::min(SnapshotDeltaPageSize, current.size() - start);
+		return
+			start + length > previous.size() ||
+			memcmp(&previous[start], &current[start], length);
+	};
+
+	size_t page = 0;
+	while(page < pages) {
+		if(!page_differs(page)) {
+			++page;
+			continue;
+		}
+
+		size_t end = page + 1;
+		while(end < pages && page_differs(end)) ++end;
+
+		const uint32_t index = uint32_t(page), count = uint32_t(end - page);
+		append(&index, sizeof(index));
+		append(&count, sizeof(count));
+
+		const size_t start = page * SnapshotDeltaPageSize;
+		append(&current[start], std::min(end * SnapshotDeltaPageSize, current.size()) - start);
+		page = end;
+	}
+
+	return delta;
+}
+
+/*!
+	Updates @c snapshot, which should be the @c previous supplied to @c snapshot_delta, to the @c current
+	that was supplied alongside it.
+
+	@returns @c true if @c delta was well-formed and has been applied; @c false otherwise, in which case
+		@c snapshot may have been partially updated.
+*/
+inline bool apply_snapshot_delta(std::vector<uint8_t> &snapshot, const std::vector<uint8_t> &delta) {
+	const uint8_t *cursor = delta.data();
+	const uint8_t *const end = cursor + delta.size();
+	const auto read = [&](void *value, size_t size) {
+		if(size_t(end - cursor) < size) return false;
+		memcpy(value, cursor, size);
+		cursor += size;
+		return true;
+	};
+
+	uint64_t size;
+	if(!read(&size, sizeof(size))) return false;
+	snapshot.resize(size_t(size));
+
+	while(cursor != end) {
+		uint32_t index, count;
+		if(!read(&index, sizeof(index)) || !read(&count, sizeof(count))) return false;
+
+		const size_t start = size_t(index) * SnapshotDeltaPageSize;
+		const size_t stop = std::min((size_t(index) + size_t(count)) * SnapshotDeltaPageSize, snapshot.size());
+		if(!count || start >= stop) return false;
+		if(!read(&snapshot[start], stop - start)) return false;
+	}
+	return true;
+}
+
+/*!
+	Appends to @c target a record of the bytewise exclusive OR of snapshots @c lhs and @c rhs, treating
+	whichever is the shorter as if padded with zeroes. Applying that record to either snapshot via
+	@c apply_xor_delta produces the other, so a history can be held as a single snapshot plus a chain
+	of such records, and walked in either direction.
+
+	Unchanged stretches XOR to zero, and only the non-zero stretches are stored.
+
+	Format: the 64-bit sizes of @c lhs and of @c rhs, then any number of runs, each being a 32-bit
+	count of zero bytes to skip, a 32-bit count of bytes that follow and then those bytes.
+*/
+inline void append_xor_delta(std::vector<uint8_t> &target, const std::vector<uint8_t> &lhs, const std::vector<uint8_t> &rhs) {
+	const auto append = [&target](const void *data, size_t size) {
+		const auto bytes = reinterpret_cast<const uint8_t *>(data);
+		target.insert(target.end(), bytes, bytes + size);
+	};
+
+	const uint64_t sizes[] = {lhs.size(), rhs.size()};
+	append(sizes, sizeof(sizes));
+
+	const size_t length = std::max(lhs.size(), rhs.size());
+	const size_t common_length = std::min(lhs.size(), rhs.size());
+	const auto difference = [&](size_t index) -> uint8_t {
+		return
+			(index < lhs.size() ? lhs[index] : 0) ^
+			(index < rhs.size() ? rhs[index] : 0);
+	};
+
+	// Stretches of fewer zeroes than a run header are cheaper to store than to skip.
+	constexpr size_t MinimumSkip = 2 * sizeof(uint32_t);
+
+	size_t position = 0;
+	while(position < length) {
+		// Skip zeroes, a word at a time where possible.
+		const size_t skip_start = position;
+		while(position + sizeof(uint64_t) <= common_length && !memcmp(&lhs[position], &rhs[position], sizeof(uint64_t))) {
+			position += sizeof(uint64_t);
+		}
+		while(position < length && !difference(position)) ++position;
+		if(position == length) break;
+
+		// Then find the end of the non-zero stretch.
+		const size_t run_start = position;
+		size_t zeroes = 0;
+		while(position < length && zeroes < MinimumSkip) {
+			zeroes = difference(position) ? 0 : zeroes + 1;
+			++position;
+		}
+		position -= zeroes;
+
+		const uint32_t header[] = {uint32_t(run_start - skip_start), uint32_t(position - run_start)};
+		append(header, sizeof(header));
+		for(size_t index = run_start; index < position; index++) {
+			target.push_back(difference(index));
+		}
+	}
+}
+
+/*!
+	Applies the @c size bytes at @c delta, produced by @c append_xor_delta from a pair of snapshots,
+	of which @c snapshot is one, turning it into the other.
+
+	@returns @c true if @c delta was well-formed and has been applied; @c false otherwise, in which case
+		@c snapshot may have been partially updated.
+*/
+inline bool apply_xor_delta(std::vector<uint8_t> &snapshot, const uint8_t *delta, size_t size) {
+	const uint8_t *cursor = delta;
+	const uint8_t *const end = delta + size;
+	const auto read = [&](void *value, size_t length) {
+		if(size_t(end - cursor) < length) return false;
+		memcpy(value, cursor, length);
+		cursor += length;
+		return true;
+	};
+
+	uint64_t sizes[2];
+	if(!read(sizes, sizeof(sizes))) return false;
+	if(snapshot.size() != sizes[0] && snapshot.size() != sizes[1]) return false;
+	const size_t result_size = size_t(snapshot.size() == sizes[0] ? sizes[1] : sizes[0]);
+	snapshot.resize(std::max(snapshot.size(), result_size));
+
+	size_t position = 0;
+	while(cursor != end) {
+		uint32_t header[2];
+		if(!read(header, sizeof(header))) return false;
+
+		position += header[0];
+		if(position > snapshot.size() || snapshot.size() - position < header[1] || size_t(end - cursor) < header[1]) return false;
+		for(size_t index = 0; index < header[1]; index++) {
+			snapshot[position + index] ^= cursor[index];
+		}
+		cursor += header[1];
+		position += header[1];
+	}
+
+	snapshot.resize(result_size);
+	return true;
+}
+
+}
+
+#endif /* SnapshotDelta_hpp */
@@ -278,7 +278,7 @@ std::vector<uint8_t> Reflection::Struct::serialise() const {
 		if(!Reflection::Enum::name(*type).empty()) {
 			int value;
 			Reflection::get(*this, key, value, offset);
-			const auto text = Reflection::Enum::to_string(*type, 0);
+			const auto text = Reflection::Enum::to_string(*type, value);
 			push_string(text);
 			return;
 		}
@@ -448,13 +448,14 @@ bool Reflection::Struct::deserialise(const uint8_t *bson, size_t size) {
 	// Validate the object's declared size.
 	const auto end = bson + size;
 	auto read_int = [&bson] (auto &target) {
-		constexpr auto shift = 8 * (sizeof(target) - 1);
-		target = 0;
+		// Assemble in an unsigned type, lest shifts propagate a sign.
+		using IntT = std::remove_reference_t<decltype(target)>;
+		std::make_unsigned_t<IntT> value = 0;
 		for(size_t c = 0; c < sizeof(target); ++c) {
-			target >>= 8;
-			target |= decltype(target)(*bson) << shift;
+			value |= decltype(value)(*bson) << (c * 8);
 			++bson;
 		}
+		target = IntT(value);
 	};
 
 	uint32_t object_size;
@@ -487,15 +488,21 @@ bool Reflection::Struct::deserialise(const uint8_t *bson, size_t size) {
 				uint32_t subobject_size;
 				read_int(subobject_size);
 
-				if(next_type == 0x03 && *type == typeid(Reflection::Struct)) {
-					auto child = reinterpret_cast<Reflection::Struct *>(get(key));
-					child->deserialise(bson - 4, size_t(end - bson + 4));
+				if(next_type == 0x03) {
+					if(type && *type == typeid(Reflection::Struct)) {
+						auto child = reinterpret_cast<Reflection::Struct *>(get(key));
+						child->deserialise(bson - 4, size_t(end - bson + 4));
+					}
 					bson += subobject_size - 4;
-				}
-
-				if(next_type == 0x05 && *type == typeid(std::vector<uint8_t>)) {
-					auto child = reinterpret_cast<std::vector<uint8_t> *>(get(key));
-					*child = std::vector<uint8_t>(bson, bson + subobject_size);
+				} else {
+					// Binary data is followed by a subtype byte; skip that.
+					++bson;
+					if(subobject_size > size_t(end - bson)) return false;
+
+					if(type && *type == typeid(std::vector<uint8_t>)) {
+						auto child = reinterpret_cast<std::vector<uint8_t> *>(get(key));
+						*child = std::vector<uint8_t>(bson, bson + subobject_size);
+					}
 					bson += subobject_size;
 				}
 			} break;
@@ -564,3 +571,43 @@ bool Reflection::Struct::deserialise(const uint8_t *bson, size_t size) {
 
 	return true;
 }
+
+// MARK: - Binary snapshots
+
+void Reflection::Struct::snapshot(std::vector<uint8_t> &target) const {
+	target.clear();
+	append_snapshot(target);
+}
+
+std::vector<uint8_t> Reflection::Struct::snapshot() const {
+	std::vector<uint8_t> result;
+	append_snapshot(result);
+	return result;
+}
+
+bool Reflection::Struct::restore(const std::vector<uint8_t> &snapshot) {
+	const uint8_t *cursor = snapshot.data();
+	const uint8_t *const end = cursor + snapshot.size();
+	return restore_snapshot(cursor, end) && cursor == end;
+}
+
+void Reflection::Struct::append_snapshot(std::vector<uint8_t> &target) const {
+	// Without a known layout, fall back on BSON, preceded by its length.
+	const auto bson = serialise();
+	const uint64_t size = bson.size();
+	const auto size_bytes = reinterpret_cast<const uint8_t *>(&size);
+	target.insert(target.end(), size_bytes, size_bytes + sizeof(size));
+	target.insert(target.end(), bson.begin(), bson.end());
+}
+
+bool Reflection::Struct::restore_snapshot(const uint8_t *&cursor, const uint8_t *end) {
+	uint64_t size;
+	if(size_t(end - cursor) < sizeof(size)) return false;
+	memcpy(&size, cursor, sizeof(size));
+	cursor += sizeof(size);
+
+	if(uint64_t(end - cursor) < size) return false;
+	const uint8_t *const bson = cursor;
+	cursor += size;
+	return deserialise(bson, size_t(size));
+}
@@ -9,10 +9,12 @@
 #ifndef Struct_hpp
 #define Struct_hpp
 
+#include <algorithm>
 #include <cassert>
 #include <cstdarg>
 #include <cstring>
 #include <cstddef>
+#include <cstdint>
 #include <string>
 #include <typeindex>
 #include <typeinfo>
@@ -75,6 +77,42 @@ struct Struct {
 	*/
 	virtual bool should_serialise([[maybe_unused]] const std::string &key) const { return true; }
 
+	/*!
+		Replaces the contents of @c target with a binary snapshot of this struct.
+
+		Snapshots are intended for fast, in-memory use such as rewinding: fields are copied directly
+		in order of address, without keys or conversion, so a snapshot can be restored only to a struct
+		of the same type in the same build. Use @c serialise for anything that is to be stored.
+
+		The same field types are supported as by @c serialise, except that arrays of reflective
+		structs are omitted. Reusing @c target from one snapshot to the next avoids reallocation.
+	*/
+	void snapshot(std::vector<uint8_t> &target) const;
+
+	/// @returns A binary snapshot of this struct, as per @c snapshot(target).
+	std::vector<uint8_t> snapshot() const;
+
+	/*!
+		Applies a binary snapshot obtained from @c snapshot on a struct of the same type.
+
+		@returns @c true if the snapshot was applied in full; @c false if it was malformed, in
+			which case this struct may have been partially updated.
+	*/
+	bool restore(const std::vector<uint8_t> &snapshot);
+
+	/*!
+		Appends this struct's portion of a snapshot to @c target. Structs without a fixed
+		layout append their BSON serialisation.
+	*/
+	virtual void append_snapshot(std::vector<uint8_t> &target) const;
+
+	/*!
+		Consumes this struct's portion of a snapshot from @c cursor, which may not advance beyond @c end.
+
+		@returns @c true on success; @c false otherwise.
+	*/
+	virtual bool restore_snapshot(const uint8_t *&cursor, const uint8_t *end);
+
 	private:
 		void append(std::ostringstream &stream, const std::string &key, const std::type_info *type, size_t offset) const;
 		bool deserialise(const uint8_t *bson, size_t size);
@@ -234,6 +272,61 @@ template <typename Owner> class StructImpl: public Struct {
 			return keys;
 		}
 
+		// MARK: - Binary snapshots.
+
+		void append_snapshot(std::vector<uint8_t> &target) const final {
+			for(const auto &span: layout()) {
+				const uint8_t *const source = reinterpret_cast<const uint8_t *>(this) + span.offset;
+				switch(span.kind) {
+					default: break;
+
+					case Field::Kind::Plain:
+						target.insert(target.end(), source, source + span.size);
+					break;
+
+					case Field::Kind::Struct:
+						reinterpret_cast<const Struct *>(source)->append_snapshot(target);
+					break;
+
+					case Field::Kind::Bytes:
+						append_sized(target, *reinterpret_cast<const std::vector<uint8_t> *>(source));
+					break;
+
+					case Field::Kind::String:
+						append_sized(target, *reinterpret_cast<const std::string *>(source));
+					break;
+				}
+			}
+		}
+
+		bool restore_snapshot(const uint8_t *&cursor, const uint8_t *end) final {
+			for(const auto &span: layout()) {
+				uint8_t *const destination = reinterpret_cast<uint8_t *>(this) + span.offset;
+				switch(span.kind) {
+					default: break;
+
+					case Field::Kind::Plain:
+						if(size_t(end - cursor) < span.size) return false;
+						memcpy(destination, cursor, span.size);
+						cursor += span.size;
+					break;
+
+					case Field::Kind::Struct:
+						if(!reinterpret_cast<Struct *>(destination)->restore_snapshot(cursor, end)) return false;
+					break;
+
+					case Field::Kind::Bytes:
+						if(!restore_sized(cursor, end, *reinterpret_cast<std::vector<uint8_t> *>(destination))) return false;
+					break;
+
+					case Field::Kind::String:
+						if(!restore_sized(cursor, end, *reinterpret_cast<std::string *>(destination))) return false;
+					break;
+				}
+			}
+			return true;
+		}
+
 	protected:
 		/*
 			This interface requires reflective structs to declare all fields;
@@ -338,20 +431,109 @@ template <typename Owner> class StructImpl: public Struct {
 			contents_.emplace(
 				std::make_pair(
 					name,
-					Field(typeid(Type), reinterpret_cast<uint8_t *>(t) - reinterpret_cast<uint8_t *>(this), sizeof(Type), count)
+					Field(typeid(Type), reinterpret_cast<uint8_t *>(t) - reinterpret_cast<uint8_t *>(this), sizeof(Type), count, kind_of<Type>())
 				));
 		}
 
 		struct Field {
+			/// Describes how a field is captured in a snapshot.
+			enum class Kind {
+				Plain, Struct, Bytes, String, Unsupported
+			};
+
 			const std::type_info *type;
 			ssize_t offset;
 			size_t size;
 			size_t count;
-			Field(const std::type_info &type, ssize_t offset, size_t size, size_t count) :
-				type(&type), offset(offset), size(size), count(count) {}
+			Kind kind;
+			Field(const std::type_info &type, ssize_t offset, size_t size, size_t count, Kind kind) :
+				type(&type), offset(offset), size(size), count(count), kind(kind) {}
 		};
 		static inline std::unordered_map<std::string, Field> contents_;
 		static inline std::unordered_map<std::string, std::vector<bool>> permitted_enum_values_;
+
+		template <typename Type> static constexpr typename Field::Kind kind_of() {
+			if constexpr (std::is_same<Type, Reflection::Struct>::value) return Field::Kind::Struct;
+			else if constexpr (std::is_same<Type, std::vector<uint8_t>>::value) return Field::Kind::Bytes;
+			else if constexpr (std::is_same<Type, std::string>::value) return Field::Kind::String;
+			else if constexpr (std::is_trivially_copyable<Type>::value) return Field::Kind::Plain;
+			else return Field::Kind::Unsupported;
+		}
+
+		// A snapshot layout is the list of declared fields in address order, with runs of
+		// adjacent plain fields combined so that each can be copied in one go.
+		struct Span {
+			typename Field::Kind kind;
+			ssize_t offset;
+			size_t size;
+		};
+
+		static const std::vector<Span> &layout() {
+			// This is first called only once an instance exists, so all fields have been declared.
+			static const std::vector<Span> layout = [] {
+				std::vector<const Field *> fields;
+				for(const auto &pair: contents_) {
+					fields.push_back(&pair.second);
+				}
+				std::sort(fields.begin(), fields.end(), [](const Field *lhs, const Field *rhs) {
+					return lhs->offset < rhs->offset;
+				});
+
+				std::vector<Span> spans;
+				for(const auto field: fields) {
+					switch(field->kind) {
+						case Field::Kind::Unsupported: break;
+
+						case Field::Kind::Plain: {
+							const size_t size = field->size * field->count;
+							if(
+								!spans.empty() && spans.back().kind == Field::Kind::Plain &&
+								spans.back().offset + ssize_t(spans.back().size) == field->offset
+							) {
+								spans.back().size += size;
+							} else {
+								spans.push_back(Span{field->kind, field->offset, size});
+							}
+						} break;
+
+						case Field::Kind::Struct:
+							// Nested structs are declared singly, arrays of them being unsupported.
+							spans.push_back(Span{field->kind, field->offset, field->size});
+						break;
+
+						default:
+							for(size_t c = 0; c < field->count; c++) {
+								spans.push_back(Span{field->kind, field->offset + ssize_t(c * field->size), field->size});
+							}
+						break;
+					}
+				}
+				return spans;
+			}();
+			return layout;
+		}
+
+		template <typename Container> static void append_sized(std::vector<uint8_t> &target, const Container &source) {
+			const uint64_t size = source.size();
+			const auto size_bytes = reinterpret_cast<const uint8_t *>(&size);
+			target.insert(target.end(), size_bytes, size_bytes + sizeof(size));
+
+			const auto data = reinterpret_cast<const uint8_t *>(source.data());
+			target.insert(target.end(), data, data + size);
+		}
+
+		template <typename Container> static bool restore_sized(const uint8_t *&cursor, const uint8_t *end, Container &destination) {
+			uint64_t size;
+			if(size_t(end - cursor) < sizeof(size)) return false;
+			memcpy(&size, cursor, sizeof(size));
+			cursor += sizeof(size);
+
+			if(uint64_t(end - cursor) < size) return false;
+			destination.resize(size_t(size));
+			if(size) memcpy(&destination[0], cursor, size_t(size));
+			cursor += size;
+			return true;
+		}
 };
 
 
@@ -17,6 +17,19 @@
 #define USE_ACCELERATE
 #endif
 
+// Otherwise use SSE2 or NEON if available; each is guaranteed to be present on
+// 64-bit x86 and ARM respectively.
+#ifndef USE_ACCELERATE
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define USE_SSE2
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define USE_NEON
+#endif
+#endif
+
+#include <cmath>
 #include <cstddef>
 #include <vector>
 
@@ -60,14 +73,57 @@ class FIRFilter {
 				vDSP_dotpr_s1_15(filter_coefficients_.data(), 1, src, vDSP_Stride(stride), &result, filter_coefficients_.size());
 				return result;
 			#else
+				std::size_t c = 0;
 				int outputValue = 0;
-				for(std::size_t c = 0; c < filter_coefficients_.size(); ++c) {
+
+				#if defined(USE_SSE2) || defined(USE_NEON)
+					// Vectorise the common mono and stereo cases, eight taps at a time; any remainder
+					// is handled by the scalar loop below.
+					switch(stride) {
+						case 1:		c = apply_simd<1>(src, outputValue);	break;
+						case 2:		c = apply_simd<2>(src, outputValue);	break;
+						default:	break;
+					}
+				#endif
+
+				for(; c < filter_coefficients_.size(); ++c) {
 					outputValue += filter_coefficients_[c] * src[c * stride];
 				}
 				return short(outputValue >> FixedShift);
 			#endif
 		}
 
+		/*!
+			Applies the filter to a block of input, producing as many output samples as possible.
+
+			The input is @c frames frames of @c channels interleaved samples each; output is similarly interleaved.
+			The filter window for each output begins at frame @c offset, after which @c offset advances by the
+			integral part of @c step plus @c error, and @c error retains the fractional part. Input frames that
+			fall between windows are therefore never multiplied.
+
+			Filtering stops when either @c max_outputs frames have been written or the next window would extend
+			beyond the end of the input. The caller can then discard all input prior to @c offset, which may
+			exceed @c frames if frames are to be skipped.
+
+			@returns The number of output frames written.
+		*/
+		template <int channels> std::size_t apply(const short *src, std::size_t frames, short *dst, std::size_t max_outputs, float step, std::size_t &offset, float &error) const {
+			const std::size_t taps = filter_coefficients_.size();
+			std::size_t outputs = 0;
+
+			while(outputs < max_outputs && offset + taps <= frames) {
+				for(int channel = 0; channel < channels; ++channel) {
+					dst[outputs * channels + size_t(channel)] = apply(&src[offset * channels + size_t(channel)], channels);
+				}
+				++outputs;
+
+				offset += std::size_t(step + error);
+				error = std::fmod(step + error, 1.0f);
+			}
+
+			return outputs;
+		}
+
 		/*! @returns The number of taps used by this filter. */
 		inline std::size_t get_number_of_taps() const {
 			return filter_coefficients_.size();
@@ -96,6 +152,59 @@ class FIRFilter {
 	private:
 		std::vector<short> filter_coefficients_;
 
+		#if defined(USE_SSE2) || defined(USE_NEON)
+		/// Accumulates the products of as many whole blocks of eight taps as can safely be read into
+		/// @c total, returning the number of taps consumed.
+		template <int stride> inline std::size_t apply_simd(const short *src, int &total) const {
+			// A stereo block also reads the sample that follows its final tap, so mustn't
+			// extend to the final tap.
+			const std::size_t limit = filter_coefficients_.size() + 1 - stride;
+			const short *const coefficients = filter_coefficients_.data();
+			std::size_t c = 0;
+
+			#ifdef USE_SSE2
+				__m128i sum = _mm_setzero_si128();
+				for(; c + 8 <= limit; c += 8) {
+					__m128i samples;
+					if constexpr (stride == 1) {
+						samples = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&src[c]));
+					} else {
+						// Keep only the even-numbered samples: shift each into the top half of its 32-bit lane
+						// and back again to sign extend, then pack the results back into 16-bit lanes.
+						const __m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&src[c * 2]));
+						const __m128i high = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&src[c * 2 + 8]));
+						samples = _mm_packs_epi32(
+							_mm_srai_epi32(_mm_slli_epi32(low, 16), 16),
+							_mm_srai_epi32(_mm_slli_epi32(high, 16), 16)
+						);
+					}
+					sum = _mm_add_epi32(sum, _mm_madd_epi16(samples, _mm_loadu_si128(reinterpret_cast<const __m128i *>(&coefficients[c]))));
+				}
+
+				sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(1, 0, 3, 2)));
+				sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+				total += _mm_cvtsi128_si32(sum);
+			#else
+				int32x4_t sum = vdupq_n_s32(0);
+				for(; c + 8 <= limit; c += 8) {
+					int16x8_t samples;
+					if constexpr (stride == 1) {
+						samples = vld1q_s16(&src[c]);
+					} else {
+						samples = vld2q_s16(&src[c * 2]).val[0];
+					}
+					const int16x8_t weights = vld1q_s16(&coefficients[c]);
+					sum = vmlal_s16(sum, vget_low_s16(samples), vget_low_s16(weights));
+					sum = vmlal_s16(sum, vget_high_s16(samples), vget_high_s16(weights));
+				}
+
+				total += vgetq_lane_s32(sum, 0) + vgetq_lane_s32(sum, 1) + vgetq_lane_s32(sum, 2) + vgetq_lane_s32(sum, 3);
+			#endif
+
+			return c;
+		}
+		#endif
+
 		static void coefficients_for_idealised_filter_response(short *filterCoefficients, float *A, float attenuation, std::size_t numberOfTaps);
 		static float ino(float a);
 };
@@ -134,3 +134,11 @@ void Controller::end_writing() {
 bool Controller::is_reading() {
 	return is_reading_;
 }
+
+size_t Controller::get_disk_memory_footprint() const {
+	size_t footprint = 0;
+	for(const auto &drive: drives_) {
+		footprint += drive.get_disk_memory_footprint();
+	}
+	return footprint;
+}
@@ -32,6 +32,12 @@ class Controller:
 	public Drive::EventDelegate,
 	public ClockingHint::Source,
 	public ClockingHint::Observer {
+	public:
+		/*!
+			@returns The number of bytes of host memory occupied by tracks of the disks in all drives.
+		*/
+		size_t get_disk_memory_footprint() const;
+
 	protected:
 		/*!
 			Constructs a @c Controller that will be run at @c clock_rate.
@@ -74,6 +74,41 @@ template <typename BitHandler, size_t length_of_history = 3> class DigitalPhaseL
 			}
 		}
 
+		/*!
+			Equivalent to calling @c run_for(Cycles(interval)) and then @c add_pulse() for each of the
+			@c count intervals at @c intervals, except that the bits produced are appended to @c output
+			rather than being posted to the bit handler. If @c output is @c nullptr then they are discarded.
+
+			This is intended for decoding whole sources, such as tracks, at once.
+		*/
+		void add_pulses(const Cycles::IntType *intervals, std::size_t count, std::vector<bool> *output) {
+			for(std::size_t index = 0; index < count; index++) {
+				offset_ += intervals[index];
+				phase_ += intervals[index];
+
+				// As per run_for; the 0s are counted here and output only alongside the
+				// 1 below. Since the window can have been filled only if no windows were
+				// crossed, there's no need to output them otherwise.
+				Cycles::IntType zeroes = 0;
+				if(phase_ >= window_length_) {
+					zeroes = phase_ / window_length_ - window_was_filled_;
+					window_was_filled_ = false;
+					phase_ %= window_length_;
+				}
+
+				// As per add_pulse.
+				if(!window_was_filled_) {
+					if(output) {
+						output->resize(output->size() + std::size_t(zeroes), false);
+						output->push_back(true);
+					}
+					window_was_filled_ = true;
+					post_phase_offset(phase_, offset_);
+					offset_ = 0;
+				}
+			}
+		}
+
 	private:
 		BitHandler &bit_handler_;
 
@@ -57,6 +57,12 @@ class Disk {
 		*/
 		virtual void flush_tracks() = 0;
 
+		/*!
+			Provides a hint that the track at @c address is likely to be requested soon, so may be decoded
+			in advance. Ignored if not overridden.
+		*/
+		virtual void prefetch([[maybe_unused]] Track::Address address) {}
+
 		/*!
 			@returns whether the disk image is read only. Defaults to @c true if not overridden.
 		*/
@@ -67,6 +73,11 @@ class Disk {
 				This can avoid some degree of work when disk images offer sub-head-position precision.
 		*/
 		virtual bool tracks_differ(Track::Address, Track::Address) = 0;
+
+		/*!
+			@returns the number of bytes of host memory occupied by tracks currently held in memory.
+		*/
+		virtual size_t get_memory_footprint() { return 0; }
 };
 
 }
@@ -9,11 +9,16 @@
 #ifndef DiskImage_hpp
 #define DiskImage_hpp
 
+#include <cstdlib>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <set>
+#include <vector>
 
 #include "../Disk.hpp"
 #include "../Track/Track.hpp"
+#include "TrackCache.hpp"
 
 namespace Storage {
 namespace Disk {
@@ -73,13 +78,55 @@ class DiskImage {
 				This can avoid some degree of work when disk images offer sub-head-position precision.
 		*/
 		virtual bool tracks_differ(Track::Address lhs, Track::Address rhs) { return lhs != rhs; }
+
+		/*!
+			@returns the file from which this image's tracks are decoded if doing so is costly enough that
+				they should be kept in the TrackCache, if enabled; @c nullptr otherwise. Defaults to @c nullptr
+				if not overridden.
+		*/
+		virtual FileHolder *get_track_cache_source() { return nullptr; }
 };
 
 class DiskImageHolderBase: public Disk {
+	public:
+		size_t get_memory_footprint() final {
+			size_t footprint = 0;
+			for(const auto &track: cached_tracks_) {
+				if(track.second) footprint += track.second->get_memory_footprint();
+			}
+
+			std::lock_guard lock_guard(prefetch_mutex_);
+			for(const auto &track: prefetched_tracks_) {
+				if(track.second) footprint += track.second->get_memory_footprint();
+			}
+			return footprint;
+		}
+
 	protected:
 		std::set<Track::Address> unwritten_tracks_;
 		std::map<Track::Address, std::shared_ptr<Track>> cached_tracks_;
 		std::unique_ptr<Concurrency::AsyncTaskQueue> update_queue_;
+
+		/// The number of tracks beyond which cached_tracks_ will be trimmed; tracks with unwritten
+		/// changes are never discarded.
+		static constexpr size_t MaxCachedTracks = 16;
+
+		// Tracks decoded on update_queue_, ahead of or in response to a request, are posted to
+		// prefetched_tracks_; pending_prefetches_ notes those that are enqueued but not yet posted.
+		// Both are guarded by prefetch_mutex_, as is prefetch_generation_, which is incremented
+		// whenever posting a result that predates a write could otherwise leave a stale track.
+		std::mutex prefetch_mutex_;
+		std::map<Track::Address, std::shared_ptr<Track>> prefetched_tracks_;
+		std::set<Track::Address> pending_prefetches_;
+		int prefetch_generation_ = 0;
+
+		// The position around which prefetching was last requested.
+		HeadPosition prefetch_centre_ = HeadPosition(-1);
+
+		// Tracks decoded from the image may also be kept between launches. track_cache_ is
+		// created upon first decoding, and is used only on update_queue_.
+		std::unique_ptr<TrackCache> track_cache_;
+		bool track_cache_is_prepared_ = false;
 };
 
 /*!
@@ -98,11 +145,18 @@ template <typename T> class DiskImageHolder: public DiskImageHolderBase {
 		std::shared_ptr<Track> get_track_at_position(Track::Address address);
 		void set_track_at_position(Track::Address address, const std::shared_ptr<Track> &track);
 		void flush_tracks();
+		void prefetch(Track::Address address);
 		bool get_is_read_only();
 		bool tracks_differ(Track::Address lhs, Track::Address rhs);
 
 	private:
 		T disk_image_;
+
+		Concurrency::AsyncTaskQueue &update_queue();
+		void decode_track(Track::Address address);
+		std::shared_ptr<Track> read_track(Track::Address address);
+		void prefetch_around(Track::Address address);
+		void trim_cache(Track::Address address);
 };
 
 #include "DiskImageImplementation.hpp"
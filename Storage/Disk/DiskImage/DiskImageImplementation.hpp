@@ -18,10 +18,16 @@ template <typename T> bool DiskImageHolder<T>::get_is_read_only() {
 	return disk_image_.get_is_read_only();
 }
 
+template <typename T> Concurrency::AsyncTaskQueue &DiskImageHolder<T>::update_queue() {
+	if(!update_queue_) update_queue_ = std::make_unique<Concurrency::AsyncTaskQueue>();
+	return *update_queue_;
+}
+
 template <typename T> void DiskImageHolder<T>::flush_tracks() {
 	if(!unwritten_tracks_.empty()) {
-		if(!update_queue_) update_queue_ = std::make_unique<Concurrency::AsyncTaskQueue>();
-
+		// Snapshot only the tracks that have changed since the last flush. Tracks are copy-on-write,
+		// so this is cheap, and any further modifications made while the disk image is being
+		// updated won't affect what it receives.
 		using TrackMap = std::map<Track::Address, std::shared_ptr<Track>>;
 		std::shared_ptr<TrackMap> track_copies(new TrackMap);
 		for(const auto &address : unwritten_tracks_) {
@@ -29,7 +35,21 @@ template <typename T> void DiskImageHolder<T>::flush_tracks() {
 		}
 		unwritten_tracks_.clear();
 
-		update_queue_->enqueue([this, track_copies]() {
+		// Any decoding that is already enqueued will occur before the disk image is updated, so
+		// must not be allowed to post its results.
+		{
+			std::lock_guard lock_guard(prefetch_mutex_);
+			++prefetch_generation_;
+			for(const auto &track: *track_copies) {
+				prefetched_tracks_.erase(track.first);
+			}
+		}
+
+		update_queue().enqueue([this, track_copies]() {
+			// Once written to, the image no longer matches anything that was cached from it.
+			track_cache_.reset();
+			track_cache_is_prepared_ = true;
+
 			disk_image_.set_tracks(*track_copies);
 		});
 	}
@@ -47,14 +67,149 @@ template <typename T> std::shared_ptr<Track> DiskImageHolder<T>::get_track_at_po
 	if(address.position >= get_maximum_head_position()) return nullptr;
 
 	auto cached_track = cached_tracks_.find(address);
-	if(cached_track != cached_tracks_.end()) return cached_track->second;
+	if(cached_track != cached_tracks_.end()) {
+		prefetch_around(address);
+		return cached_track->second;
+	}
+
+	// Use a prefetched track if there is one, waiting for it if it is in progress; otherwise
+	// decode now. Decoding is always performed on update_queue_ so that it is serialised with
+	// both prefetching and the writing of modified tracks.
+	std::shared_ptr<Track> track;
+	while(true) {
+		{
+			std::lock_guard lock_guard(prefetch_mutex_);
+			const auto prefetched_track = prefetched_tracks_.find(address);
+			if(prefetched_track != prefetched_tracks_.end()) {
+				track = std::move(prefetched_track->second);
+				prefetched_tracks_.erase(prefetched_track);
+				break;
+			}
+
+			if(pending_prefetches_.find(address) == pending_prefetches_.end()) {
+				decode_track(address);
+			}
+		}
+		update_queue().flush();
+	}
 
-	std::shared_ptr<Track> track = disk_image_.get_track_at_position(address);
-	if(!track) return nullptr;
 	cached_tracks_[address] = track;
+	trim_cache(address);
+	prefetch_around(address);
 	return track;
 }
 
+template <typename T> void DiskImageHolder<T>::prefetch(Track::Address address) {
+	if(address.head >= get_head_count()) return;
+	if(address.position >= get_maximum_head_position()) return;
+	if(cached_tracks_.find(address) != cached_tracks_.end()) return;
+
+	std::lock_guard lock_guard(prefetch_mutex_);
+	if(
+		prefetched_tracks_.find(address) != prefetched_tracks_.end() ||
+		pending_prefetches_.find(address) != pending_prefetches_.end()
+	) return;
+
+	decode_track(address);
+}
+
+template <typename T> void DiskImageHolder<T>::decode_track(Track::Address address) {
+	// Precondition: prefetch_mutex_ is held.
+	pending_prefetches_.insert(address);
+	update_queue().enqueue([this, address, generation = prefetch_generation_] {
+		auto track = read_track(address);
+
+		std::lock_guard lock_guard(prefetch_mutex_);
+		pending_prefetches_.erase(address);
+		if(generation == prefetch_generation_) {
+			prefetched_tracks_[address] = std::move(track);
+		}
+	});
+}
+
+template <typename T> std::shared_ptr<Track> DiskImageHolder<T>::read_track(Track::Address address) {
+	// Precondition: this is running on update_queue_.
+	if(!track_cache_is_prepared_) {
+		track_cache_is_prepared_ = true;
+		FileHolder *const source = disk_image_.get_track_cache_source();
+		if(source) track_cache_ = TrackCache::cache_for(*source);
+	}
+
+	if(track_cache_) {
+		auto track = track_cache_->get(address);
+		if(track) return track;
+	}
+
+	auto track = disk_image_.get_track_at_position(address);
+	if(track_cache_ && track) track_cache_->store(address, *track);
+	return track;
+}
+
+template <typename T> void DiskImageHolder<T>::prefetch_around(Track::Address address) {
+	if(address.position == prefetch_centre_) return;
+	prefetch_centre_ = address.position;
+
+	const int head_count = get_head_count();
+	const HeadPosition maximum = get_maximum_head_position();
+	const auto is_nearby = [&](Track::Address candidate) {
+		const int distance = candidate.position.as_largest() - address.position.as_largest();
+		return distance >= -HeadPosition(1).as_largest() && distance <= HeadPosition(1).as_largest();
+	};
+
+	std::vector<Track::Address> candidates;
+	for(const int offset: {0, -1, 1}) {
+		const HeadPosition position(address.position.as_quarter() + offset * HeadPosition(1).as_quarter(), 4);
+		if(position < HeadPosition(0) || position >= maximum) continue;
+
+		for(int head = 0; head < head_count; head++) {
+			const Track::Address candidate(head, position);
+			if(candidate == address || cached_tracks_.find(candidate) != cached_tracks_.end()) continue;
+			candidates.push_back(candidate);
+		}
+	}
+
+	std::lock_guard lock_guard(prefetch_mutex_);
+
+	// Discard anything prefetched that the head has since moved away from.
+	for(auto iterator = prefetched_tracks_.begin(); iterator != prefetched_tracks_.end();) {
+		if(is_nearby(iterator->first)) ++iterator;
+		else iterator = prefetched_tracks_.erase(iterator);
+	}
+
+	for(const auto &candidate: candidates) {
+		if(
+			prefetched_tracks_.find(candidate) != prefetched_tracks_.end() ||
+			pending_prefetches_.find(candidate) != pending_prefetches_.end()
+		) continue;
+
+		decode_track(candidate);
+	}
+}
+
+template <typename T> void DiskImageHolder<T>::trim_cache(Track::Address address) {
+	// Discard whichever tracks are furthest from the one most recently requested, other than
+	// those with changes still to be written.
+	while(cached_tracks_.size() > MaxCachedTracks) {
+		auto furthest = cached_tracks_.end();
+		int furthest_distance = -1;
+		for(auto iterator = cached_tracks_.begin(); iterator != cached_tracks_.end(); ++iterator) {
+			if(
+				iterator->first == address ||
+				unwritten_tracks_.find(iterator->first) != unwritten_tracks_.end()
+			) continue;
+
+			const int distance = std::abs(iterator->first.position.as_largest() - address.position.as_largest());
+			if(distance > furthest_distance) {
+				furthest_distance = distance;
+				furthest = iterator;
+			}
+		}
+
+		if(furthest == cached_tracks_.end()) break;
+		cached_tracks_.erase(furthest);
+	}
+}
+
 template <typename T> DiskImageHolder<T>::~DiskImageHolder() {
 	if(update_queue_) update_queue_->flush();
 }
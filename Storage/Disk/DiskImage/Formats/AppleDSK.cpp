@@ -69,24 +69,25 @@ std::shared_ptr<Track> AppleDSK::get_track_at_position(Track::Address address) {
 		track_data = file_.read(size_t(bytes_per_sector * sectors_per_track_));
 	}
 
-	Storage::Disk::PCMSegment segment;
+	Encodings::AppleGCR::SegmentBuilder builder;
 	const uint8_t track = uint8_t(address.position.as_int());
 
 	// In either case below, the code aims for exactly 50,000 bits per track.
 	if(sectors_per_track_ == 16) {
 		// Write gap 1.
-		segment += Encodings::AppleGCR::six_and_two_sync(24);
+		builder.add_six_and_two_sync(24);
 
 		// Write the sectors.
 		for(uint8_t c = 0; c < 16; ++c) {
-			segment += Encodings::AppleGCR::AppleII::header(is_prodos_ ? 0x01 : 0xfe, track, c);	// Volume number is 0xfe for DOS 3.3, 0x01 for Pro-DOS.
-			segment += Encodings::AppleGCR::six_and_two_sync(7);	// Gap 2: 7 sync words.
-			segment += Encodings::AppleGCR::AppleII::six_and_two_data(&track_data[logical_sector_for_physical_sector(c) * 256]);
-			segment += Encodings::AppleGCR::six_and_two_sync(20);	// Gap 3: 20 sync words.
+			Encodings::AppleGCR::AppleII::add_header(builder, is_prodos_ ? 0x01 : 0xfe, track, c);	// Volume number is 0xfe for DOS 3.3, 0x01 for Pro-DOS.
+			builder.add_six_and_two_sync(7);	// Gap 2: 7 sync words.
+			Encodings::AppleGCR::AppleII::add_six_and_two_data(builder, &track_data[logical_sector_for_physical_sector(c) * 256]);
+			builder.add_six_and_two_sync(20);	// Gap 3: 20 sync words.
 		}
 	} else {
 		// TODO: 5 and 3, 13-sector format. If DSK actually supports it?
 	}
+	Storage::Disk::PCMSegment segment = builder.segment();
 
 	// Apply inter-track skew; skew is about 40ms between each track; assuming 300RPM that's
 	// 1/5th of a revolution.
@@ -89,51 +89,33 @@ std::shared_ptr<Track> D64::get_track_at_position(Track::Address address) {
 		uint8_t sector_number = uint8_t(sector);						// sectors count from 0
 		uint8_t track_number = uint8_t(address.position.as_int() + 1);	// tracks count from 1
 		uint8_t checksum = uint8_t(sector_number ^ track_number ^ disk_id_ ^ (disk_id_ >> 8));
-		uint8_t header_start[4] = {
-			0x08, checksum, sector_number, track_number
-		};
-		Encodings::CommodoreGCR::encode_block(&sector_data[3], header_start);
+		const uint8_t header[12] = {
+			0x08, checksum, sector_number, track_number,
+			uint8_t(disk_id_ & 0xff), uint8_t(disk_id_ >> 8), 0, 0,
 
-		uint8_t header_end[4] = {
-			uint8_t(disk_id_ & 0xff), uint8_t(disk_id_ >> 8), 0, 0
+			// pad out post-header parts
+			0, 0, 0, 0
 		};
-		Encodings::CommodoreGCR::encode_block(&sector_data[8], header_end);
-
-		// pad out post-header parts
-		uint8_t zeros[4] = {0, 0, 0, 0};
-		Encodings::CommodoreGCR::encode_block(&sector_data[13], zeros);
+		Encodings::CommodoreGCR::encode_bytes(&sector_data[3], header, sizeof(header));
 		sector_data[18] = 0x52;
 		sector_data[19] = 0x94;
 		sector_data[20] = 0xaf;
 
-		// get the actual contents
-		uint8_t source_data[256];
-		file_.read(source_data, sizeof(source_data));
-
-		// compute the latest checksum
-		checksum = 0;
-		for(int c = 0; c < 256; c++)
-			checksum ^= source_data[c];
-
 		// put in another sync
 		sector_data[21] = sector_data[22] = sector_data[23] = 0xff;
 
-		// now start writing in the actual data
-		uint8_t start_of_data[4] = {
-			0x07, source_data[0], source_data[1], source_data[2]
-		};
-		Encodings::CommodoreGCR::encode_block(&sector_data[24], start_of_data);
-		int source_data_offset = 3;
-		int target_data_offset = 29;
-		while((source_data_offset+4) < 256) {
-			Encodings::CommodoreGCR::encode_block(&sector_data[target_data_offset], &source_data[source_data_offset]);
-			target_data_offset += 5;
-			source_data_offset += 4;
-		}
-		uint8_t end_of_data[4] = {
-			source_data[255], checksum, 0, 0
-		};
-		Encodings::CommodoreGCR::encode_block(&sector_data[target_data_offset], end_of_data);
+		// get the actual contents, preceded by the data marker and followed by a checksum
+		// and padding, and encode all at once
+		uint8_t data_block[260]{};
+		data_block[0] = 0x07;
+		file_.read(&data_block[1], 256);
+
+		checksum = 0;
+		for(int c = 1; c <= 256; c++)
+			checksum ^= data_block[c];
+		data_block[257] = checksum;
+
+		Encodings::CommodoreGCR::encode_bytes(&sector_data[24], data_block, sizeof(data_block));
 	}
 
 	return std::make_shared<PCMTrack>(PCMSegment(data));
@@ -181,3 +181,7 @@ std::shared_ptr<::Storage::Disk::Track> DMK::get_track_at_position(::Storage::Di
 
 	return std::make_shared<PCMTrack>(segments);
 }
+
+Storage::FileHolder *DMK::get_track_cache_source() {
+	return &file_;
+}
@@ -36,6 +36,7 @@ class DMK: public DiskImage {
 		bool get_is_read_only() final;
 
 		std::shared_ptr<::Storage::Disk::Track> get_track_at_position(::Storage::Disk::Track::Address address) final;
+		FileHolder *get_track_cache_source() final;
 
 	private:
 		FileHolder file_;
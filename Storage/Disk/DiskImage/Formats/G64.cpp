@@ -109,3 +109,7 @@ std::shared_ptr<Track> G64::get_track_at_position(Track::Address address) {
 
 	return resulting_track;
 }
+
+Storage::FileHolder *G64::get_track_cache_source() {
+	return &file_;
+}
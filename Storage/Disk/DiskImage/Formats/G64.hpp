@@ -35,6 +35,7 @@ class G64: public DiskImage {
 		HeadPosition get_maximum_head_position() final;
 		std::shared_ptr<Track> get_track_at_position(Track::Address address) final;
 		using DiskImage::get_is_read_only;
+		FileHolder *get_track_cache_source() final;
 
 	private:
 		Storage::FileHolder file_;
@@ -129,3 +129,7 @@ void HFE::set_tracks(const std::map<Track::Address, std::shared_ptr<Track>> &tra
 bool HFE::get_is_read_only() {
 	return file_.get_is_known_read_only();
 }
+
+Storage::FileHolder *HFE::get_track_cache_source() {
+	return &file_;
+}
@@ -37,6 +37,7 @@ class HFE: public DiskImage {
 		bool get_is_read_only() final;
 		void set_tracks(const std::map<Track::Address, std::shared_ptr<Track>> &tracks) final;
 		std::shared_ptr<Track> get_track_at_position(Track::Address address) final;
+		FileHolder *get_track_cache_source() final;
 
 	private:
 		Storage::FileHolder file_;
@@ -12,7 +12,9 @@
 
 using namespace Storage::Disk;
 
-MFMSectorDump::MFMSectorDump(const std::string &file_name) : file_(file_name) {}
+MFMSectorDump::MFMSectorDump(const std::string &file_name) : file_(file_name) {
+	file_.map();
+}
 
 void MFMSectorDump::set_geometry(int sectors_per_track, uint8_t sector_size, uint8_t first_sector, bool is_double_density) {
 	sectors_per_track_ = sectors_per_track;
@@ -25,9 +27,16 @@ std::shared_ptr<Track> MFMSectorDump::get_track_at_position(Track::Address addre
 	if(address.head >= get_head_count()) return nullptr;
 	if(address.position.as_largest() >= get_maximum_head_position().as_largest()) return nullptr;
 
-	uint8_t sectors[(128 << sector_size_)*sectors_per_track_];
+	const size_t track_size = size_t((128 << sector_size_)*sectors_per_track_);
 	const long file_offset = get_file_offset_for_position(address);
 
+	// If this track lies within the mapped portion of the file, encode directly from there.
+	// Any writes to it will already have been flushed by set_tracks.
+	if(file_.map() && size_t(file_offset) + track_size <= file_.mapped_size()) {
+		return track_for_sectors(file_.map() + file_offset, sectors_per_track_, uint8_t(address.position.as_int()), uint8_t(address.head), first_sector_, sector_size_, is_double_density_);
+	}
+
+	uint8_t sectors[track_size];
 	{
 		std::lock_guard lock_guard(file_.get_file_access_mutex());
 		file_.seek(file_offset, SEEK_SET);
@@ -200,8 +200,8 @@ std::shared_ptr<::Storage::Disk::Track> MacintoshIMG::get_track_at_position(::St
 		uint8_t *const sector = &data_[512 * start_sector];
 		uint8_t *const tags = tags_.size() ? &tags_[12 * start_sector] : nullptr;
 
-		Storage::Disk::PCMSegment segment;
-		segment += Encodings::AppleGCR::six_and_two_sync(24);
+		Encodings::AppleGCR::SegmentBuilder builder;
+		builder.add_six_and_two_sync(24);
 
 		// Determine the sector ordering.
 		uint8_t source_sectors[12] = {0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff};
@@ -232,21 +232,22 @@ std::shared_ptr<::Storage::Disk::Track> MacintoshIMG::get_track_at_position(::St
 			// the Apple II, as I have no idea whatsoever what they
 			// should be.
 
-			segment += Encodings::AppleGCR::Macintosh::header(
+			Encodings::AppleGCR::Macintosh::add_header(
+				builder,
 				format_,
 				uint8_t(address.position.as_int()),
 				sector_id,
 				!!address.head
 			);
-			segment += Encodings::AppleGCR::six_and_two_sync(7);
-			segment += Encodings::AppleGCR::Macintosh::data(sector_id, sector_plus_tags);
-			segment += Encodings::AppleGCR::six_and_two_sync(20);
+			builder.add_six_and_two_sync(7);
+			Encodings::AppleGCR::Macintosh::add_data(builder, sector_id, sector_plus_tags);
+			builder.add_six_and_two_sync(20);
 		}
 
 		// TODO: it seems some tracks are skewed respective to others; investigate further.
 
 //		segment.rotate_right(3000);	// Just a test, yo.
-		return std::make_shared<PCMTrack>(segment);
+		return std::make_shared<PCMTrack>(builder.segment());
 	}
 
 	return nullptr;
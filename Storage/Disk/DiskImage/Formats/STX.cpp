@@ -593,3 +593,7 @@ std::shared_ptr<::Storage::Disk::Track> STX::get_track_at_position(::Storage::Di
 	TrackConstructor constructor(track_data, sectors, track_length, first_sync);
 	return constructor.get_track();
 }
+
+Storage::FileHolder *STX::get_track_cache_source() {
+	return &file_;
+}
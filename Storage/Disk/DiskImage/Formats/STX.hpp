@@ -33,6 +33,7 @@ class STX: public DiskImage {
 		int get_head_count() final;
 
 		std::shared_ptr<::Storage::Disk::Track> get_track_at_position(::Storage::Disk::Track::Address address) final;
+		FileHolder *get_track_cache_source() final;
 
 	private:
 		FileHolder file_;
@@ -34,22 +34,11 @@ WOZ::WOZ(const std::string &file_name) :
 	if(!isWoz1 && !isWoz2) throw Error::InvalidFormat;
 	type_ = isWoz2 ? Type::WOZ2 : Type::WOZ1;
 
-	// Get the file's CRC32.
-	const uint32_t crc = file_.get32le();
+	// Get the file's CRC32; testing it requires the entire file to be read, so is deferred
+	// until the contents are first needed.
+	crc_ = file_.get32le();
 
-	// Get the collection of all data that contributes to the CRC.
-	post_crc_contents_ = file_.read(size_t(file_.stats().st_size - 12));
-
-	// Test the CRC.
-	const uint32_t computed_crc = crc_generator.compute_crc(post_crc_contents_);
-	if(crc != computed_crc) {
-		 throw Error::InvalidFormat;
-	}
-
-	// Retreat to the first byte after the CRC.
-	file_.seek(12, SEEK_SET);
-
-	// Parse all chunks up front.
+	// Parse all chunks up front; this requires only a walk of the chunk headers.
 	bool has_tmap = false;
 	while(true) {
 		const uint32_t chunk_id = file_.get32le();
@@ -143,9 +132,20 @@ bool WOZ::tracks_differ(Track::Address lhs, Track::Address rhs) {
 	return offset1 != offset2;
 }
 
+bool WOZ::contents_are_valid() {
+	std::lock_guard lock_guard(file_.get_file_access_mutex());
+	if(validity_ == Validity::Unknown) {
+		// Get the collection of all data that contributes to the CRC, and test it.
+		file_.seek(12, SEEK_SET);
+		post_crc_contents_ = file_.read(size_t(file_.stats().st_size - 12));
+		validity_ = crc_generator.compute_crc(post_crc_contents_) == crc_ ? Validity::Valid : Validity::Invalid;
+	}
+	return validity_ == Validity::Valid;
+}
+
 std::shared_ptr<Track> WOZ::get_track_at_position(Track::Address address) {
 	const long offset = file_offset(address);
-	if(offset == NoSuchTrack) {
+	if(offset == NoSuchTrack || !contents_are_valid()) {
 		return nullptr;
 	}
 
@@ -183,7 +183,7 @@ std::shared_ptr<Track> WOZ::get_track_at_position(Track::Address address) {
 }
 
 void WOZ::set_tracks(const std::map<Track::Address, std::shared_ptr<Track>> &tracks) {
-	if(type_ == Type::WOZ2) return;
+	if(type_ == Type::WOZ2 || !contents_are_valid()) return;
 
 	for(const auto &pair: tracks) {
 		// Decode the track and store, patching into the post_crc_contents_.
@@ -224,3 +224,7 @@ bool WOZ::get_is_read_only() {
 	return true;
 //	return file_.get_is_known_read_only() || is_read_only_ || type_ == Type::WOZ2;	// WOZ 2 disks are currently read only.
 }
+
+Storage::FileHolder *WOZ::get_track_cache_source() {
+	return &file_;
+}
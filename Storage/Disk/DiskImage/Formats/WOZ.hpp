@@ -32,6 +32,7 @@ class WOZ: public DiskImage {
 		void set_tracks(const std::map<Track::Address, std::shared_ptr<Track>> &tracks) final;
 		bool get_is_read_only() final;
 		bool tracks_differ(Track::Address, Track::Address) final;
+		FileHolder *get_track_cache_source() final;
 
 	private:
 		Storage::FileHolder file_;
@@ -43,8 +44,16 @@ class WOZ: public DiskImage {
 		uint8_t track_map_[160];
 		long tracks_offset_ = -1;
 
+		// The file's stated CRC, and everything that follows it; the latter is read, and the CRC
+		// tested, only once track contents are first needed. A disk with a CRC mismatch appears
+		// to contain no tracks.
+		uint32_t crc_ = 0;
 		std::vector<uint8_t> post_crc_contents_;
 		CRC::CRC32 crc_generator;
+		enum class Validity {
+			Unknown, Valid, Invalid
+		} validity_ = Validity::Unknown;
+		bool contents_are_valid();
 
 		/*!
 			Gets the in-file offset of a track.
@@ -0,0 +1,275 @@
+//
+//  TrackCache.cpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 14/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#include "TrackCache.hpp"
+
+#include "../Track/PCMTrack.hpp"
+
+#include <cinttypes>
+#include <cstdio>
+#include <vector>
+
+using namespace Storage::Disk;
+
+namespace {
+
+/// Incremented whenever the file format changes, invalidating everything stored earlier.
+constexpr uint32_t FormatVersion = 1;
+
+/*
+	Each file is little endian, and consists of:
+
+		a 40-byte header:
+			"CLKT", the format version, the image hash and size, the track's head and position,
+			the number of segments and four bytes of padding;
+
+		then, per segment, a 24-byte description:
+			the bit length and clock rate, the number of bits, flags — bit 0 of which indicates
+			the presence of a fuzzy mask — and four bytes of padding;
+
+			followed by the segment's bits, packed MSB first and padded to a multiple of eight bytes,
+			then its fuzzy mask, if any, in the same form.
+
+	All data is therefore 8-byte aligned within the file.
+*/
+constexpr uint32_t HasFuzzyMask = 1;
+
+std::string &cache_directory() {
+	static std::string directory;
+	return directory;
+}
+
+size_t padded_size(uint64_t bits) {
+	return size_t(((bits + 63) >> 6) << 3);
+}
+
+template <typename IntT> void put(std::vector<uint8_t> &target, IntT value) {
+	for(size_t c = 0; c < sizeof(IntT); c++) {
+		target.push_back(uint8_t(uint64_t(value) >> (c * 8)));
+	}
+}
+
+void put(std::vector<uint8_t> &target, const std::vector<bool> &bits) {
+	const size_t start = target.size();
+	target.resize(start + padded_size(bits.size()), 0);
+
+	size_t pointer = 0;
+	for(const auto bit: bits) {
+		if(bit) target[start + (pointer >> 3)] |= 0x80 >> (pointer & 7);
+		++pointer;
+	}
+}
+
+/// Reads little-endian values from a range of bytes; any read beyond the end is recorded as an error and yields zero.
+class Reader {
+	public:
+		Reader(const uint8_t *data, size_t size) : data_(data), size_(size) {}
+
+		template <typename IntT> IntT get() {
+			if(!has(sizeof(IntT))) return 0;
+
+			uint64_t result = 0;
+			for(size_t c = 0; c < sizeof(IntT); c++) {
+				result |= uint64_t(data_[offset_ + c]) << (c * 8);
+			}
+			offset_ += sizeof(IntT);
+			return IntT(result);
+		}
+
+		/// @returns A pointer to the next @c bits of packed data, or @c nullptr if they aren't all present.
+		const uint8_t *bits(uint64_t bits) {
+			const size_t size = padded_size(bits);
+			if(!has(size)) return nullptr;
+
+			const uint8_t *const result = &data_[offset_];
+			offset_ += size;
+			return result;
+		}
+
+		bool is_valid() const {
+			return is_valid_;
+		}
+
+		bool is_at_end() const {
+			return offset_ == size_;
+		}
+
+	private:
+		const uint8_t *data_;
+		size_t size_;
+		size_t offset_ = 0;
+		bool is_valid_ = true;
+
+		bool has(size_t size) {
+			// Compared this way around so that a corrupt size can't overflow.
+			is_valid_ &= size <= size_ - offset_;
+			return is_valid_;
+		}
+};
+
+}
+
+void TrackCache::set_directory(const std::string &directory) {
+	cache_directory() = directory;
+}
+
+std::unique_ptr<TrackCache> TrackCache::cache_for(FileHolder &file) {
+	if(cache_directory().empty()) return nullptr;
+	return std::make_unique<TrackCache>(cache_directory(), file);
+}
+
+TrackCache::TrackCache(const std::string &directory, FileHolder &file) : directory_(directory), file_(file) {}
+
+bool TrackCache::establish_identity() {
+	if(has_identity_) return size_ != 0;
+	has_identity_ = true;
+
+	// Take a 64-bit FNV-1a hash of the whole file, mapping it if possible.
+	std::lock_guard lock_guard(file_.get_file_access_mutex());
+	uint64_t hash = 0xcbf29ce484222325;
+	const auto fold = [&hash](const uint8_t *data, size_t size) {
+		for(size_t c = 0; c < size; c++) {
+			hash = (hash ^ data[c]) * 0x100000001b3;
+		}
+	};
+
+	const uint8_t *const mapping = file_.map();
+	if(mapping) {
+		fold(mapping, file_.mapped_size());
+		size_ = file_.mapped_size();
+	} else {
+		const long original_position = file_.tell();
+		file_.seek(0, SEEK_SET);
+
+		uint8_t chunk[16384];
+		size_t read;
+		while((read = file_.read(chunk, sizeof(chunk))) > 0) {
+			fold(chunk, read);
+			size_ += read;
+		}
+		file_.seek(original_position, SEEK_SET);
+	}
+	hash_ = hash;
+
+	// An empty file has no tracks worth caching.
+	return size_ != 0;
+}
+
+std::string TrackCache::path(Track::Address address) const {
+	char name[96];
+	snprintf(name, sizeof(name), "clksignal-track-%016" PRIx64 "-%d-%d.pcm", hash_, address.head, address.position.as_largest());
+
+	std::string result = directory_;
+	if(result.back() != '/') result += '/';
+	return result + name;
+}
+
+std::shared_ptr<Track> TrackCache::get(Track::Address address) {
+	if(!establish_identity()) return nullptr;
+
+	// Map the file where possible, reading it in full otherwise.
+	std::unique_ptr<FileHolder> file;
+	try {
+		file = std::make_unique<FileHolder>(path(address), FileHolder::FileMode::Read);
+	} catch(...) {
+		return nullptr;
+	}
+
+	std::vector<uint8_t> contents;
+	const uint8_t *data = file->map();
+	size_t size = file->mapped_size();
+	if(!data) {
+		contents = file->read(size_t(file->stats().st_size));
+		data = contents.data();
+		size = contents.size();
+	}
+
+	Reader reader(data, size);
+	const auto magic = reader.get<uint32_t>();
+	const auto version = reader.get<uint32_t>();
+	const auto hash = reader.get<uint64_t>();
+	const auto image_size = reader.get<uint64_t>();
+	const auto head = reader.get<int32_t>();
+	const auto position = reader.get<int32_t>();
+	const auto segment_count = reader.get<uint32_t>();
+	reader.get<uint32_t>();
+
+	if(
+		!reader.is_valid() ||
+		magic != 0x544b4c43 ||	// i.e. "CLKT".
+		version != FormatVersion ||
+		hash != hash_ ||
+		image_size != size_ ||
+		head != address.head ||
+		position != address.position.as_largest() ||
+		!segment_count
+	) return nullptr;
+
+	std::vector<PCMSegment> segments;
+	for(uint32_t c = 0; c < segment_count; c++) {
+		const auto length = reader.get<uint32_t>();
+		const auto clock_rate = reader.get<uint32_t>();
+		const auto bits = reader.get<uint64_t>();
+		const auto flags = reader.get<uint32_t>();
+		reader.get<uint32_t>();
+
+		const uint8_t *const data_bits = reader.bits(bits);
+		const uint8_t *const mask_bits = (flags & HasFuzzyMask) ? reader.bits(bits) : nullptr;
+		if(!data_bits || !bits || !clock_rate) return nullptr;
+
+		segments.emplace_back(Time(length, clock_rate), size_t(bits), data_bits);
+		if(mask_bits) {
+			segments.back().fuzzy_mask = PCMSegment(size_t(bits), mask_bits).data;
+		}
+	}
+	if(!reader.is_valid() || !reader.is_at_end()) return nullptr;
+
+	return std::make_shared<PCMTrack>(segments);
+}
+
+void TrackCache::store(Track::Address address, Track &track) {
+	const auto pcm_track = dynamic_cast<PCMTrack *>(&track);
+	if(!pcm_track || !pcm_track->segment_count() || !establish_identity()) return;
+
+	std::vector<uint8_t> contents;
+	put(contents, uint32_t(0x544b4c43));
+	put(contents, FormatVersion);
+	put(contents, hash_);
+	put(contents, size_);
+	put(contents, int32_t(address.head));
+	put(contents, int32_t(address.position.as_largest()));
+	put(contents, uint32_t(pcm_track->segment_count()));
+	put(contents, uint32_t(0));
+
+	for(size_t c = 0; c < pcm_track->segment_count(); c++) {
+		const auto &segment = pcm_track->segment(c);
+		const bool has_fuzzy_mask = !segment.fuzzy_mask.empty();
+		if(has_fuzzy_mask && segment.fuzzy_mask.size() != segment.data.size()) return;
+
+		put(contents, uint32_t(segment.length_of_a_bit.length));
+		put(contents, uint32_t(segment.length_of_a_bit.clock_rate));
+		put(contents, uint64_t(segment.data.size()));
+		put(contents, has_fuzzy_mask ? HasFuzzyMask : 0);
+		put(contents, uint32_t(0));
+
+		put(contents, segment.data);
+		if(has_fuzzy_mask) put(contents, segment.fuzzy_mask);
+	}
+
+	// Write to a temporary file and then move that into place, so that an interrupted
+	// write can't leave a truncated track to be found later.
+	const std::string final_path = path(address);
+	const std::string temporary_path = final_path + ".tmp";
+	FILE *const file = fopen(temporary_path.c_str(), "wb");
+	if(!file) return;
+
+	const bool did_write = fwrite(contents.data(), 1, contents.size(), file) == contents.size();
+	if(fclose(file) || !did_write || rename(temporary_path.c_str(), final_path.c_str())) {
+		remove(temporary_path.c_str());
+	}
+}
@@ -0,0 +1,63 @@
+//
+//  TrackCache.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 14/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#ifndef TrackCache_hpp
+#define TrackCache_hpp
+
+#include "../Track/Track.hpp"
+#include "../../FileHolder.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace Storage {
+namespace Disk {
+
+/*!
+	Stores tracks decoded from a disk image between launches, so that formats which are costly to
+	decode — those that must reconstruct flux from an involved encoding — need do so only once.
+
+	Each track is stored bit-packed in a file of its own, named for a hash of the image's contents and
+	the track's address, and is memory mapped when restored. Only PCMTracks are stored.
+
+	Caching is disabled until a directory is supplied via @c set_directory.
+*/
+class TrackCache {
+	public:
+		/// Sets the directory in which tracks are cached; an empty string disables caching.
+		static void set_directory(const std::string &directory);
+
+		/// @returns A cache for tracks decoded from @c file, or @c nullptr if caching is disabled.
+		static std::unique_ptr<TrackCache> cache_for(FileHolder &file);
+
+		/// @returns The track with address @c address if it has been cached; @c nullptr otherwise.
+		std::shared_ptr<Track> get(Track::Address address);
+
+		/// Stores @c track as that with address @c address; failure is silent as this is only a cache.
+		void store(Track::Address address, Track &track);
+
+		TrackCache(const std::string &directory, FileHolder &file);
+
+	private:
+		const std::string directory_;
+		FileHolder &file_;
+
+		// The image is identified by a hash of its contents plus its size, established upon first use;
+		// both are also stored with each track so that hash collisions are detected.
+		bool has_identity_ = false;
+		uint64_t hash_ = 0, size_ = 0;
+		bool establish_identity();
+
+		std::string path(Track::Address address) const;
+};
+
+}
+}
+
+#endif /* TrackCache_hpp */
@@ -10,10 +10,13 @@
 
 #include "Track/UnformattedTrack.hpp"
 
+#include "../../Outputs/HostProfiler.hpp"
+
 #include <algorithm>
 #include <cassert>
 #include <cmath>
 #include <chrono>
+#include <limits>
 #include <random>
 
 using namespace Storage::Disk;
@@ -63,6 +66,9 @@ void Drive::set_disk(const std::shared_ptr<Disk> &disk) {
 	disk_ = disk;
 	has_disk_ = !!disk_;
 
+	// Start decoding whatever is under the head now, so that it's likely to be ready when first needed.
+	if(disk_) disk_->prefetch(Track::Address(head_, head_position_));
+
 	invalidate_track();
 	did_set_disk(had_disk);
 	update_clocking_observer();
@@ -119,6 +125,12 @@ std::shared_ptr<Track> Drive::step_to(HeadPosition offset) {
 	return track_;
 }
 
+std::shared_ptr<Track> Drive::get_current_track() {
+	if(!disk_) return nullptr;
+	if(!track_) setup_track();
+	return track_;
+}
+
 void Drive::set_head(int head) {
 	head = std::min(head, available_heads_ - 1);
 	if(head != head_) {
@@ -202,7 +214,30 @@ void Drive::advance(const Cycles cycles) {
 	if(event_delegate_) event_delegate_->advance(cycles);
 }
 
+Cycles::IntType Drive::get_cycles_until_event() const {
+	// Motor transitions are applied only at the start of run_for, so must be run up to precisely.
+	auto result = std::numeric_limits<Cycles::IntType>::max();
+	if(time_until_motor_transition > Cycles(0)) {
+		result = time_until_motor_transition.as_integral() - 1;
+	}
+	if(!disk_is_rotating_ || !has_disk_) return result;
+
+	// A drive that is skipping events will post index holes to any delegate; one that will
+	// stop skipping will resynchronise its event stream; one that is writing will announce
+	// write completion. Decline to predict any of those.
+	const bool will_skip = is_reading_ && (!event_delegate_ || !event_delegate_->is_listening());
+	if(will_skip) {
+		return event_delegate_ ? 0 : result;
+	}
+	if(is_skipping_events_ || !is_reading_) return 0;
+
+	// Otherwise the next event is posted on the call to run_for that exhausts its countdown.
+	return std::min(result, get_cycles_until_next_event() - 1);
+}
+
 void Drive::run_for(const Cycles cycles) {
+	HOST_PROFILER_ZONE("Disk events");
+
 	// Assumed: the index pulse pulses even if the drive has stopped spinning.
 	index_pulse_remaining_ = std::max(index_pulse_remaining_ - cycles, Cycles(0));
 
@@ -217,6 +252,13 @@ void Drive::run_for(const Cycles cycles) {
 
 	if(disk_is_rotating_) {
 		if(has_disk_) {
+			// If nothing is listening for flux transitions then spin until the next index hole.
+			if(is_reading_ && (!event_delegate_ || !event_delegate_->is_listening())) {
+				skip_events(cycles.as_integral());
+				return;
+			}
+			stop_skipping_events();
+
 			Time zero(0);
 
 			auto number_of_cycles = cycles.as_integral();
@@ -254,7 +296,7 @@ void Drive::run_for(const Cycles cycles) {
 
 // MARK: - Track timed event loop
 
-void Drive::get_next_event(float duration_already_passed) {
+void Drive::get_next_event(Time duration_already_passed) {
 	/*
 		Quick word on random-bit generation logic below; it seeks to obey the following logic:
 		if there is a gap of 15µs between recorded bits, start generating flux transitions
@@ -262,36 +304,39 @@ void Drive::get_next_event(float duration_already_passed) {
 
 		This behaviour is based on John Morris' observations of an MC3470, as described in his WOZ
 		file format documentation — https://applesaucefdc.com/woz/reference2/
+
+		All intervals are calculated as fixed-point input cycles.
 	*/
 
 	if(!disk_) {
 		current_event_.type = Track::Event::IndexHole;
-		current_event_.length = 1.0f;
-		set_next_event_time_interval((current_event_.length - duration_already_passed) * rotational_multiplier_);
+		current_event_.length = Time(1);
+		set_next_event_interval(rotation_cycles(current_event_.length, duration_already_passed));
 		return;
 	}
 
 	// Grab a new track if not already in possession of one. This will recursively call get_next_event,
 	// supplying a proper duration_already_passed.
 	if(!track_) {
-		random_interval_ = 0.0f;
+		random_interval_ = 0;
 		setup_track();
 		return;
 	}
 
 	// If gain has now been turned up so as to generate noise, generate some noise.
-	if(random_interval_ > 0.0f) {
+	if(random_interval_) {
 		current_event_.type = Track::Event::FluxTransition;
-		current_event_.length = float(2 + (random_source_&1)) / 1'000'000.0f;
+		current_event_.length = Time(2 + int(random_source_&1), 1'000'000);
 		random_source_ = (random_source_ >> 1) | (random_source_ << 63);
 
 		// If this random transition is closer than 5µs to the next real bit,
 		// discard it.
-		if(random_interval_ - 5.0f / 1'000'000.f < current_event_.length) {
-			random_interval_ = 0.0f;
+		const auto length = fixed_cycles(current_event_.length);
+		if(random_interval_ < length + fixed_cycles(Time(5, 1'000'000))) {
+			random_interval_ = 0;
 		} else {
-			random_interval_ -= current_event_.length;
-			set_next_event_time_interval(current_event_.length);
+			random_interval_ -= length;
+			set_next_event_interval(length);
 			return;
 		}
 	}
@@ -299,37 +344,76 @@ void Drive::get_next_event(float duration_already_passed) {
 	if(track_) {
 		const auto track_event = track_->get_next_event();
 		current_event_.type = track_event.type;
-		current_event_.length = track_event.length.get<float>();
+		current_event_.length = track_event.length;
 	} else {
-		current_event_.length = 1.0f;
+		current_event_.length = Time(1);
 		current_event_.type = Track::Event::IndexHole;
 	}
 
-	// divide interval, which is in terms of a single rotation of the disk, by rotation speed to
-	// convert it into revolutions per second; this is achieved by multiplying by rotational_multiplier_
-	float interval = std::max((current_event_.length - duration_already_passed) * rotational_multiplier_, 0.0f);
+	// The event's length is in terms of a single rotation of the disk; scale by the number
+	// of cycles per rotation.
+	auto interval = rotation_cycles(current_event_.length, duration_already_passed);
 
 	// An interval greater than 15µs => adjust gain up the point where noise starts happening.
 	// Seed that up and leave a 15µs gap until it starts.
-	constexpr float safe_gain_period = 15.0f / 1'000'000.0f;
+	const auto safe_gain_period = fixed_cycles(Time(15, 1'000'000));
 	if(interval >= safe_gain_period) {
 		random_interval_ = interval - safe_gain_period;
 		interval = safe_gain_period;
 	}
 
-	set_next_event_time_interval(interval);
+	set_next_event_interval(interval);
 }
 
-void Drive::process_next_event() {
-	if(current_event_.type == Track::Event::IndexHole) {
-		++ready_index_count_;
-		if(ready_index_count_ == 2 && (ready_type_ == ReadyType::ShugartRDY || ready_type_ == ReadyType::ShugartModifiedRDY)) {
-			is_ready_ = true;
+Drive::FixedCycles Drive::rotation_cycles(Time length, Time duration_already_passed) const {
+	if(!duration_already_passed.length) return fixed_cycles(length, cycles_per_revolution_);
+	if(length <= duration_already_passed) return 0;
+	return fixed_cycles(length - duration_already_passed, cycles_per_revolution_);
+}
+
+void Drive::process_index_hole() {
+	++ready_index_count_;
+	if(ready_index_count_ == 2 && (ready_type_ == ReadyType::ShugartRDY || ready_type_ == ReadyType::ShugartModifiedRDY)) {
+		is_ready_ = true;
+	}
+	cycles_since_index_hole_ = 0;
+
+	// Begin a 2ms period of holding the index line pulse active.
+	index_pulse_remaining_ = Cycles((get_input_clock_rate() * 2) / 1000);
+}
+
+void Drive::skip_events(Cycles::IntType cycles) {
+	is_skipping_events_ = true;
+
+	while(true) {
+		if(cycles_since_index_hole_ >= cycles_per_revolution_) {
+			process_index_hole();
+
+			current_event_.type = Track::Event::IndexHole;
+			current_event_.length = Time(1);
+			if(event_delegate_) event_delegate_->process_event(current_event_);
 		}
-		cycles_since_index_hole_ = 0;
+		if(!cycles) break;
+
+		const auto cycles_to_run_for = std::min(cycles, cycles_per_revolution_ - cycles_since_index_hole_);
+		advance(Cycles(cycles_to_run_for));
+		cycles -= cycles_to_run_for;
+	}
+}
+
+void Drive::stop_skipping_events() {
+	if(!is_skipping_events_) return;
+	is_skipping_events_ = false;
 
-		// Begin a 2ms period of holding the index line pulse active.
-		index_pulse_remaining_ = Cycles((get_input_clock_rate() * 2) / 1000);
+	// Discard whatever event was pending and pick up again from the current rotation.
+	reset_timer();
+	invalidate_track();
+	setup_track();
+}
+
+void Drive::process_next_event() {
+	if(current_event_.type == Track::Event::IndexHole) {
+		process_index_hole();
 	}
 	if(
 		event_delegate_ &&
@@ -337,7 +421,7 @@ void Drive::process_next_event() {
 	){
 		event_delegate_->process_event(current_event_);
 	}
-	get_next_event(0.0f);
+	get_next_event(Time(0));
 }
 
 // MARK: - Track management
@@ -370,11 +454,11 @@ void Drive::setup_track() {
 	// but if the track has rounded one way or the other it may now be very slightly adrift.
 	cycles_since_index_hole_ = (int((time_found + offset) * cycles_per_revolution_)) % cycles_per_revolution_;
 
-	get_next_event(offset);
+	get_next_event(Time(offset));
 }
 
 void Drive::invalidate_track() {
-	random_interval_ = 0.0f;
+	random_interval_ = 0;
 	track_ = nullptr;
 	if(patched_track_) {
 		set_track(patched_track_);
@@ -389,6 +473,9 @@ void Drive::begin_writing(Time bit_length, bool clamp_to_index_hole) {
 	// TODO: cope properly if there's no disk to write to.
 	if(!is_reading_ || !disk_) return;
 
+	// Make sure the track is properly positioned.
+	stop_skipping_events();
+
 	// Get a copy of the track if that hasn't happened yet.
 	if(!track_) {
 		setup_track();
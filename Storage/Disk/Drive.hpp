@@ -47,6 +47,13 @@ class Drive: public ClockingHint::Source, public TimedEventLoop {
 		*/
 		bool has_disk() const;
 
+		/*!
+			@returns The number of bytes of host memory occupied by tracks of the current disk, if any.
+		*/
+		size_t get_disk_memory_footprint() const {
+			return disk_ ? disk_->get_memory_footprint() : 0;
+		}
+
 		/*!
 			@returns @c true if the drive head is currently at track zero; @c false otherwise.
 		*/
@@ -125,9 +132,15 @@ class Drive: public ClockingHint::Source, public TimedEventLoop {
 		*/
 		void run_for(const Cycles cycles);
 
+		/*!
+			@returns a number of cycles for which this drive can be run without posting any event to its
+			delegate or starting or stopping the disk; this may be zero.
+		*/
+		Cycles::IntType get_cycles_until_event() const;
+
 		struct Event {
 			Track::Event::Type type;
-			float length = 0.0f;
+			Time length;
 		} current_event_;
 
 		/*!
@@ -146,6 +159,16 @@ class Drive: public ClockingHint::Source, public TimedEventLoop {
 
 			/// Informs the delegate of the passing of @c cycles.
 			virtual void advance([[maybe_unused]] Cycles cycles) {}
+
+			/*!
+				@returns @c true if the delegate is currently interested in flux transitions. If it
+				returns @c false then the drive will announce only index holes until the next call
+				to @c run_for after which it returns @c true.
+
+				This is checked only as each call to @c run_for begins, so should change from @c false
+				to @c true only as a result of something external, such as a new command.
+			*/
+			virtual bool is_listening() const { return true; }
 		};
 
 		/// Sets the current event delegate.
@@ -169,6 +192,15 @@ class Drive: public ClockingHint::Source, public TimedEventLoop {
 		*/
 		std::shared_ptr<Track> step_to(HeadPosition offset);
 
+		/*!
+			@returns the track currently under the active head, including any modifications made to it
+				by writing, or @c nullptr if there is no disk.
+
+			This is also **NOT FOR HARDWARE EMULATION USAGE**. It's for the benefit of user-optional
+			fast-loading mechanisms **ONLY**.
+		*/
+		std::shared_ptr<Track> get_current_track();
+
 		/*!
 			Alters the rotational velocity of this drive.
 		*/
@@ -179,6 +211,19 @@ class Drive: public ClockingHint::Source, public TimedEventLoop {
 		*/
 		bool get_tachometer() const;
 
+		/*!
+			@returns the current rotation of the disk, a float in the half-open range
+				0.0 (the index hole) to 1.0 (back to the index hole, a whole rotation later).
+		*/
+		float get_rotation() const;
+
+		/*!
+			@returns the number of input cycles that a single revolution currently takes.
+		*/
+		int get_cycles_per_revolution() const {
+			return cycles_per_revolution_;
+		}
+
 	protected:
 		/*!
 			Announces the result of a step.
@@ -192,12 +237,6 @@ class Drive: public ClockingHint::Source, public TimedEventLoop {
 		*/
 		virtual void did_set_disk(bool did_replace [[maybe_unused]]) {}
 
-		/*!
-			@returns the current rotation of the disk, a float in the half-open range
-				0.0 (the index hole) to 1.0 (back to the index hole, a whole rotation later).
-		*/
-		float get_rotation() const;
-
 	private:
 		// Drives contain an entire disk; from that a certain track
 		// will be currently under the head.
@@ -253,9 +292,18 @@ class Drive: public ClockingHint::Source, public TimedEventLoop {
 		Time cycles_until_bits_written_;
 		Time cycles_per_bit_;
 
+		// If nobody is listening to a drive that is reading, the drive merely counts down to the
+		// next index hole rather than processing individual flux transitions; position within the
+		// track is reestablished from cycles_since_index_hole_ when listening resumes.
+		bool is_skipping_events_ = false;
+		void skip_events(Cycles::IntType cycles);
+		void stop_skipping_events();
+		void process_index_hole();
+
 		// TimedEventLoop call-ins and state.
 		void process_next_event() override;
-		void get_next_event(float duration_already_passed);
+		void get_next_event(Time duration_already_passed);
+		FixedCycles rotation_cycles(Time length, Time duration_already_passed) const;
 		void advance(const Cycles cycles) override;
 
 		// Helper for track changes.
@@ -284,7 +332,7 @@ class Drive: public ClockingHint::Source, public TimedEventLoop {
 
 		// A rotating random data source.
 		uint64_t random_source_;
-		float random_interval_;
+		FixedCycles random_interval_ = 0;
 };
 
 
@@ -8,6 +8,8 @@
 
 #include "Encoder.hpp"
 
+#include <array>
+
 namespace {
 
 const uint8_t five_and_three_mapping[] = {
@@ -28,72 +30,81 @@ const uint8_t six_and_two_mapping[] = {
 	0xf7, 0xf9, 0xfa, 0xfb, 0xfc, 0xfd, 0xfe, 0xff
 };
 
-/*!
-	Produces a PCM segment containing @c length sync bytes, each aligned to the beginning of
-	a @c bit_size -sized window.
-*/
-Storage::Disk::PCMSegment sync(int length, int bit_size) {
-	Storage::Disk::PCMSegment segment;
+}
 
-	// Reserve sufficient storage.
-	segment.data.reserve(size_t(length * bit_size));
+using namespace Storage::Encodings;
 
-	// Write patters of 0xff padded with 0s to the selected bit size.
-	while(length--) {
-		int c = 8;
-		while(c--)
-			segment.data.push_back(true);
+// MARK: - SegmentBuilder.
 
-		c = bit_size - 8;
-		while(c--)
-			segment.data.push_back(false);
-	}
+void AppleGCR::SegmentBuilder::add_bits(uint32_t value, int count) {
+	accumulator_ = (accumulator_ << count) | value;
+	accumulated_bits_ += count;
 
-	return segment;
+	// Empty the accumulator only once it holds several bytes.
+	if(accumulated_bits_ >= 32) {
+		while(accumulated_bits_ >= 8) {
+			accumulated_bits_ -= 8;
+			bytes_.push_back(uint8_t(accumulator_ >> accumulated_bits_));
+		}
+	}
 }
 
+void AppleGCR::SegmentBuilder::add_sync(int length, int bit_size) {
+	// Each sync is 0xff padded with 0s to the selected bit size.
+	while(length--) {
+		add_bits(0xffu << (bit_size - 8), bit_size);
+	}
 }
 
-using namespace Storage::Encodings;
-
-Storage::Disk::PCMSegment AppleGCR::six_and_two_sync(int length) {
-	return sync(length, 10);
+void AppleGCR::SegmentBuilder::add_six_and_two_sync(int length) {
+	add_sync(length, 10);
 }
 
-Storage::Disk::PCMSegment AppleGCR::five_and_three_sync(int length) {
-	return sync(length, 9);
+void AppleGCR::SegmentBuilder::add_five_and_three_sync(int length) {
+	add_sync(length, 9);
 }
 
-Storage::Disk::PCMSegment AppleGCR::AppleII::header(uint8_t volume, uint8_t track, uint8_t sector) {
-	const uint8_t checksum = volume ^ track ^ sector;
-
-	// Apple headers are encoded using an FM-esque scheme rather than 6 and 2, or 5 and 3.
-	std::vector<uint8_t> data(14);
+void AppleGCR::SegmentBuilder::add_nibbles(const uint8_t *nibbles, size_t count) {
+	// If the output is currently byte aligned then nibbles can be copied directly.
+	if(!accumulated_bits_) {
+		bytes_.insert(bytes_.end(), nibbles, nibbles + count);
+		return;
+	}
 
-	data[0] = header_prologue[0];
-	data[1] = header_prologue[1];
-	data[2] = header_prologue[2];
+	while(count--) {
+		add_bits(*nibbles, 8);
+		++nibbles;
+	}
+}
 
-#define WriteFM(index, value)	\
-	data[index+0] = uint8_t(((value) >> 1) | 0xaa);	\
-	data[index+1] = uint8_t((value) | 0xaa);	\
+Storage::Disk::PCMSegment AppleGCR::SegmentBuilder::segment() const {
+	std::vector<uint8_t> bytes = bytes_;
+	uint64_t remainder = accumulator_;
+	int remaining_bits = accumulated_bits_;
+	while(remaining_bits > 0) {
+		remaining_bits -= 8;
+		bytes.push_back(uint8_t(remaining_bits >= 0 ? remainder >> remaining_bits : remainder << -remaining_bits));
+	}
 
-	WriteFM(3, volume);
-	WriteFM(5, track);
-	WriteFM(7, sector);
-	WriteFM(9, checksum);
+	return Storage::Disk::PCMSegment(bytes_.size() * 8 + size_t(accumulated_bits_), bytes);
+}
 
-#undef WriteFM
+// MARK: - Common encoding.
 
-	data[11] = epilogue[0];
-	data[12] = epilogue[1];
-	data[13] = epilogue[2];
+Storage::Disk::PCMSegment AppleGCR::six_and_two_sync(int length) {
+	SegmentBuilder builder;
+	builder.add_six_and_two_sync(length);
+	return builder.segment();
+}
 
-	return Storage::Disk::PCMSegment(data);
+Storage::Disk::PCMSegment AppleGCR::five_and_three_sync(int length) {
+	SegmentBuilder builder;
+	builder.add_five_and_three_sync(length);
+	return builder.segment();
 }
 
-Storage::Disk::PCMSegment AppleGCR::five_and_three_data(const uint8_t *source) {
-	std::vector<uint8_t> data(410 + 7);
+void AppleGCR::add_five_and_three_data(SegmentBuilder &builder, const uint8_t *source) {
+	std::array<uint8_t, 410 + 7> data{};
 
 	data[0] = data_prologue[0];
 	data[1] = data_prologue[1];
@@ -120,13 +131,53 @@ Storage::Disk::PCMSegment AppleGCR::five_and_three_data(const uint8_t *source) {
 		data[3 + c] = five_and_three_mapping[data[3 + c]];
 	}
 
-	return Storage::Disk::PCMSegment(data);
+	builder.add_nibbles(data);
+}
+
+Storage::Disk::PCMSegment AppleGCR::five_and_three_data(const uint8_t *source) {
+	SegmentBuilder builder;
+	add_five_and_three_data(builder, source);
+	return builder.segment();
 }
 
 // MARK: - Apple II-specific encoding.
 
-Storage::Disk::PCMSegment AppleGCR::AppleII::six_and_two_data(const uint8_t *source) {
-	std::vector<uint8_t> data(349);
+void AppleGCR::AppleII::add_header(SegmentBuilder &builder, uint8_t volume, uint8_t track, uint8_t sector) {
+	const uint8_t checksum = volume ^ track ^ sector;
+
+	// Apple headers are encoded using an FM-esque scheme rather than 6 and 2, or 5 and 3.
+	std::array<uint8_t, 14> data;
+
+	data[0] = header_prologue[0];
+	data[1] = header_prologue[1];
+	data[2] = header_prologue[2];
+
+#define WriteFM(index, value)	\
+	data[index+0] = uint8_t(((value) >> 1) | 0xaa);	\
+	data[index+1] = uint8_t((value) | 0xaa);	\
+
+	WriteFM(3, volume);
+	WriteFM(5, track);
+	WriteFM(7, sector);
+	WriteFM(9, checksum);
+
+#undef WriteFM
+
+	data[11] = epilogue[0];
+	data[12] = epilogue[1];
+	data[13] = epilogue[2];
+
+	builder.add_nibbles(data);
+}
+
+Storage::Disk::PCMSegment AppleGCR::AppleII::header(uint8_t volume, uint8_t track, uint8_t sector) {
+	SegmentBuilder builder;
+	add_header(builder, volume, track, sector);
+	return builder.segment();
+}
+
+void AppleGCR::AppleII::add_six_and_two_data(SegmentBuilder &builder, const uint8_t *source) {
+	std::array<uint8_t, 349> data{};
 
 	// Add the prologue and epilogue.
 	data[0] = data_prologue[0];
@@ -165,20 +216,23 @@ Storage::Disk::PCMSegment AppleGCR::AppleII::six_and_two_data(const uint8_t *sou
 		data[3 + 86 + c] = source[c] >> 2;
 	}
 
-	// Exclusive OR each byte with the one before it.
-	data[345] = data[344];
-	std::size_t location = 344;
-	while(location > 3) {
-		data[location] ^= data[location-1];
-		--location;
+	// Exclusive OR each byte with the one before it, and map six-bit values up to full
+	// bytes. The final byte is a checksum: the last value prior to exclusive ORing.
+	uint8_t previous = 0;
+	for(std::size_t c = 3; c < 345; ++c) {
+		const uint8_t value = data[c];
+		data[c] = six_and_two_mapping[value ^ previous];
+		previous = value;
 	}
+	data[345] = six_and_two_mapping[previous];
 
-	// Map six-bit values up to full bytes.
-	for(std::size_t c = 0; c < 343; ++c) {
-		data[3 + c] = six_and_two_mapping[data[3 + c]];
-	}
+	builder.add_nibbles(data);
+}
 
-	return Storage::Disk::PCMSegment(data);
+Storage::Disk::PCMSegment AppleGCR::AppleII::six_and_two_data(const uint8_t *source) {
+	SegmentBuilder builder;
+	add_six_and_two_data(builder, source);
+	return builder.segment();
 }
 
 // MARK: - Macintosh-specific encoding.
@@ -200,8 +254,8 @@ AppleGCR::Macintosh::SectorSpan AppleGCR::Macintosh::sectors_in_track(int track)
 	return result;
 }
 
-Storage::Disk::PCMSegment AppleGCR::Macintosh::header(uint8_t type, uint8_t track, uint8_t sector, bool side_two) {
-	std::vector<uint8_t> data(11);
+void AppleGCR::Macintosh::add_header(SegmentBuilder &builder, uint8_t type, uint8_t track, uint8_t sector, bool side_two) {
+	std::array<uint8_t, 11> data;
 
 	// The standard prologue.
 	data[0] = header_prologue[0];
@@ -232,11 +286,17 @@ Storage::Disk::PCMSegment AppleGCR::Macintosh::header(uint8_t type, uint8_t trac
 	data[9] = epilogue[1];
 	data[10] = epilogue[2];
 
-	return Storage::Disk::PCMSegment(data);
+	builder.add_nibbles(data);
 }
 
-Storage::Disk::PCMSegment AppleGCR::Macintosh::data(uint8_t sector, const uint8_t *source) {
-	std::vector<uint8_t> output(710);
+Storage::Disk::PCMSegment AppleGCR::Macintosh::header(uint8_t type, uint8_t track, uint8_t sector, bool side_two) {
+	SegmentBuilder builder;
+	add_header(builder, type, track, sector, side_two);
+	return builder.segment();
+}
+
+void AppleGCR::Macintosh::add_data(SegmentBuilder &builder, uint8_t sector, const uint8_t *source) {
+	std::array<uint8_t, 710> output{};
 	int checksum[3] = {0, 0, 0};
 
 	// Write prologue.
@@ -320,5 +380,11 @@ Storage::Disk::PCMSegment AppleGCR::Macintosh::data(uint8_t sector, const uint8_
 	output[708] = epilogue[1];
 	output[709] = epilogue[2];
 
-	return Storage::Disk::PCMSegment(output);
+	builder.add_nibbles(output);
+}
+
+Storage::Disk::PCMSegment AppleGCR::Macintosh::data(uint8_t sector, const uint8_t *source) {
+	SegmentBuilder builder;
+	add_data(builder, sector, source);
+	return builder.segment();
 }
@@ -9,7 +9,9 @@
 #ifndef AppleGCR_hpp
 #define AppleGCR_hpp
 
+#include <array>
 #include <cstdint>
+#include <vector>
 #include "../../../Disk/Track/PCMSegment.hpp"
 
 namespace Storage {
@@ -25,6 +27,39 @@ constexpr uint8_t epilogue[3] = {0xde, 0xaa, 0xeb};
 /// Describes the standard three-byte prologue used by DOS 3.2 and earlier.
 constexpr uint8_t five_and_three_header_prologue[3] = {0xd5, 0xaa, 0xb5};
 
+/*!
+	Assembles nibbles and syncs into a single PCMSegment, packing them into bytes as they
+	are added. Building a whole track this way avoids producing and then bitwise
+	concatenating a separate segment for every field.
+*/
+class SegmentBuilder {
+	public:
+		/// Adds @c length six-and-two sync bytes, each 10 bits long.
+		void add_six_and_two_sync(int length);
+
+		/// Adds @c length five-and-three sync bytes, each 9 bits long.
+		void add_five_and_three_sync(int length);
+
+		/// Adds the @c count nibbles at @c nibbles, each 8 bits long.
+		void add_nibbles(const uint8_t *nibbles, size_t count);
+
+		template <size_t size> void add_nibbles(const std::array<uint8_t, size> &nibbles) {
+			add_nibbles(nibbles.data(), size);
+		}
+
+		/// @returns A segment containing everything added so far.
+		Storage::Disk::PCMSegment segment() const;
+
+	private:
+		std::vector<uint8_t> bytes_;
+		uint64_t accumulator_ = 0;
+		int accumulated_bits_ = 0;
+
+		/// Adds the low @c count bits of @c value, MSB first; @c count may be at most 24.
+		void add_bits(uint32_t value, int count);
+		void add_sync(int length, int bit_size);
+};
+
 namespace AppleII {
 
 /*!
@@ -34,12 +69,18 @@ namespace AppleII {
 */
 Storage::Disk::PCMSegment six_and_two_data(const uint8_t *source);
 
+/// Adds the data section produced by @c six_and_two_data to @c builder.
+void add_six_and_two_data(SegmentBuilder &builder, const uint8_t *source);
+
 /*!
 	Produces the Apple II-standard four-and-four per-sector header. This is the same
 	for both the 13- and 16-sector formats, and is 112 bits long.
 */
 Storage::Disk::PCMSegment header(uint8_t volume, uint8_t track, uint8_t sector);
 
+/// Adds the header produced by @c header to @c builder.
+void add_header(SegmentBuilder &builder, uint8_t volume, uint8_t track, uint8_t sector);
+
 }
 
 namespace Macintosh {
@@ -61,11 +102,17 @@ SectorSpan sectors_in_track(int track);
 */
 Storage::Disk::PCMSegment data(uint8_t sector, const uint8_t *source);
 
+/// Adds the data section produced by @c data to @c builder.
+void add_data(SegmentBuilder &builder, uint8_t sector, const uint8_t *source);
+
 /*!
 	Produces the Mac-standard header. This is 88 bits long.
 */
 Storage::Disk::PCMSegment header(uint8_t type, uint8_t track, uint8_t sector, bool side_two);
 
+/// Adds the header produced by @c header to @c builder.
+void add_header(SegmentBuilder &builder, uint8_t type, uint8_t track, uint8_t sector, bool side_two);
+
 /// The on-disk type used for a 400kb floppy.
 const uint8_t TypeMac400kb = 0x02;
 /// The on-disk type used for a 800kb floppy.
@@ -87,6 +134,9 @@ Storage::Disk::PCMSegment six_and_two_sync(int length);
 */
 Storage::Disk::PCMSegment five_and_three_data(const uint8_t *source);
 
+/// Adds the data section produced by @c five_and_three_data to @c builder.
+void add_five_and_three_data(SegmentBuilder &builder, const uint8_t *source);
+
 /*!
 	Produces @c length sync five-and-three format sync bytes. The segment returned
 	is @c 9*length bits long.
@@ -11,12 +11,13 @@
 #include "Encoder.hpp"
 
 #include <array>
+#include <vector>
 
 using namespace Storage::Encodings::AppleGCR;
 
 namespace {
 
-const uint8_t six_and_two_unmapping[] = {
+constexpr uint8_t six_and_two_unmapping[] = {
 	/* 0x96 */	0x00, 0x01,
 	/* 0x98 */	0xff, 0xff, 0x02, 0x03, 0xff, 0x04, 0x05, 0x06,
 	/* 0xa0 */	0xff, 0xff,	0xff, 0xff, 0xff, 0xff, 0x07, 0x08,
@@ -33,12 +34,7 @@ const uint8_t six_and_two_unmapping[] = {
 	/* 0xf8 */	0xff, 0x39, 0x3a, 0x3b, 0x3c, 0x3d, 0x3e, 0x3f,
 };
 
-uint8_t unmap_six_and_two(uint8_t source) {
-	if(source < 0x96) return 0xff;
-	return six_and_two_unmapping[source - 0x96];
-}
-
-const uint8_t five_and_three_unmapping[] = {
+constexpr uint8_t five_and_three_unmapping[] = {
 	/* 0xab */	0x00, 0xff,	0x01, 0x02, 0x03,
 	/* 0xb0 */	0xff, 0xff, 0xff, 0xff, 0xff, 0x04, 0x05, 0x06,
 	/* 0xb8 */	0xff, 0xff, 0x07, 0x08, 0xff, 0x09, 0x0a, 0x0b,
@@ -52,9 +48,38 @@ const uint8_t five_and_three_unmapping[] = {
 	/* 0xf8 */	0xff, 0xff, 0x1b, 0x1c, 0xff, 0x1d, 0x1e, 0x1f,
 };
 
+/// Expands one of the partial tables above, which begin at @c first, to cover all 256 byte values.
+template <size_t size> constexpr std::array<uint8_t, 256> full_unmapping(const uint8_t (&unmapping)[size], size_t first) {
+	std::array<uint8_t, 256> result{};
+	for(size_t c = 0; c < 256; ++c) {
+		result[c] = c < first ? 0xff : unmapping[c - first];
+	}
+	return result;
+}
+
+constexpr auto six_and_two_table = full_unmapping(six_and_two_unmapping, 0x96);
+constexpr auto five_and_three_table = full_unmapping(five_and_three_unmapping, 0xab);
+static_assert(sizeof(six_and_two_unmapping) == 256 - 0x96);
+static_assert(sizeof(five_and_three_unmapping) == 256 - 0xab);
+
+uint8_t unmap_six_and_two(uint8_t source) {
+	return six_and_two_table[source];
+}
+
 uint8_t unmap_five_and_three(uint8_t source) {
-	if(source < 0xab) return 0xff;
-	return five_and_three_unmapping[source - 0xab];
+	return five_and_three_table[source];
+}
+
+/// Unmaps @c count bytes from @c source to @c destination via @c table.
+/// @returns @c true if all were valid; @c false if any was not.
+bool unmap(const std::array<uint8_t, 256> &table, uint8_t *destination, const uint8_t *source, size_t count) {
+	// All valid values are less than 0x80, so test for invalidity only once all bytes are done.
+	uint8_t invalid = 0;
+	for(size_t c = 0; c < count; ++c) {
+		destination[c] = table[source[c]];
+		invalid |= destination[c];
+	}
+	return !(invalid & 0x80);
 }
 
 std::unique_ptr<Sector> decode_macintosh_sector(const std::array<uint_fast8_t, 8> *header, const std::unique_ptr<Sector> &original) {
@@ -85,11 +110,8 @@ std::unique_ptr<Sector> decode_macintosh_sector(const std::array<uint_fast8_t, 8
 	sector->address.is_side_two = decoded_header[2] & 0x20;
 
 	// Reverse the GCR encoding of the sector contents to get back to 6-bit data.
-	for(size_t index = 0; index < sector->data.size(); ++index) {
-		sector->data[index] = unmap_six_and_two(original->data[index]);
-		if(sector->data[index] == 0xff) {
-			return nullptr;
-		}
+	if(!unmap(six_and_two_table, sector->data.data(), original->data.data(), sector->data.size())) {
+		return nullptr;
 	}
 
 	// The first byte in the sector is a repeat of the sector number; test it
@@ -168,11 +190,8 @@ std::unique_ptr<Sector> decode_appleii_sector(const std::array<uint_fast8_t, 8>
 	}
 
 	// Unmap the sector contents.
-	for(size_t index = 0; index < data_size; ++index) {
-		sector->data[index] = is_five_and_three ? unmap_five_and_three(original->data[index]) : unmap_six_and_two(original->data[index]);
-		if(sector->data[index] == 0xff) {
-			return nullptr;
-		}
+	if(!unmap(is_five_and_three ? five_and_three_table : six_and_two_table, sector->data.data(), original->data.data(), data_size)) {
+		return nullptr;
 	}
 
 	// Undo the XOR step on sector contents and check that checksum.
@@ -246,14 +265,18 @@ std::map<std::size_t, Sector> Storage::Encodings::AppleGCR::sectors_from_segment
 	std::array<uint_fast8_t, 3> scanner{{0, 0, 0}};
 
 	// Scan the track while either all bits haven't been seen yet, or a potential
-	// sector is still being parsed.
-	size_t bit = 0;
+	// sector is still being parsed. Bits are read from a packed copy of the segment,
+	// which is much cheaper to index than the segment itself.
+	const std::vector<uint8_t> bytes = segment.byte_data();
+	const size_t bit_count = segment.data.size();
+	size_t bit = 0, index = 0;
 	int header_delay = 0;
 	bool is_five_and_three = false;
 	bool has_header = false;
-	while(bit < segment.data.size() || pointer != scanning_sentinel || header_delay) {
-		shift_register = uint_fast8_t((shift_register << 1) | (segment.data[bit % segment.data.size()] ? 1 : 0));
+	while(bit < bit_count || pointer != scanning_sentinel || header_delay) {
+		shift_register = uint_fast8_t((shift_register << 1) | ((bytes[index >> 3] >> (7 - (index & 7))) & 1));
 		++bit;
+		if(++index == bit_count) index = 0;
 
 		// Apple GCR parsing: bytes always have the top bit set.
 		if(!(shift_register&0x80)) continue;
@@ -288,7 +311,7 @@ std::map<std::size_t, Sector> Storage::Encodings::AppleGCR::sectors_from_segment
 					new_sector = std::make_unique<Sector>();
 					new_sector->data.reserve(710);
 				} else {	// i.e. the third symbol is from either of the header prologues.
-					sector_location = size_t(bit % segment.data.size());
+					sector_location = index;
 					header_delay = 200;	// Allow up to 200 bytes to find the body, if the
 										// track split comes in between.
 					has_header = true;
@@ -7,6 +7,8 @@
 //
 
 #include "CommodoreGCR.hpp"
+
+#include <algorithm>
 #include <limits>
 
 using namespace Storage;
@@ -16,56 +18,111 @@ Time Storage::Encodings::CommodoreGCR::length_of_a_bit_in_time_zone(unsigned int
 	return Time(16 - time_zone, 4000000u);
 }
 
-unsigned int Storage::Encodings::CommodoreGCR::encoding_for_nibble(uint8_t nibble) {
-	switch(nibble & 0xf) {
-		case 0x0:	return 0x0a;		case 0x1:	return 0x0b;
-		case 0x2:	return 0x12;		case 0x3:	return 0x13;
-		case 0x4:	return 0x0e;		case 0x5:	return 0x0f;
-		case 0x6:	return 0x16;		case 0x7:	return 0x17;
-		case 0x8:	return 0x09;		case 0x9:	return 0x19;
-		case 0xa:	return 0x1a;		case 0xb:	return 0x1b;
-		case 0xc:	return 0x0d;		case 0xd:	return 0x1d;
-		case 0xe:	return 0x1e;		case 0xf:	return 0x15;
-
-		// for the benefit of the compiler; clearly unreachable
-		default:	return 0xff;
+namespace {
+
+constexpr uint8_t nibble_encodings[16] = {
+	0x0a, 0x0b, 0x12, 0x13, 0x0e, 0x0f, 0x16, 0x17,
+	0x09, 0x19, 0x1a, 0x1b, 0x0d, 0x1d, 0x1e, 0x15,
+};
+
+/// Indicates an invalid quintet in the decoding tables below, or is set alongside the low
+/// eight bits of the result for an invalid dectet.
+constexpr uint16_t Invalid = 0xffff;
+constexpr uint16_t InvalidDectet = 0x100;
+
+struct Tables {
+	/// Maps from byte to dectet.
+	uint16_t byte_encodings[256]{};
+
+	/// Maps from quintet to nibble and from dectet to byte, marking values that aren't valid GCR.
+	uint16_t quintet_decodings[32]{};
+	uint16_t dectet_decodings[1024]{};
+
+	constexpr Tables() {
+		for(int c = 0; c < 32; c++) quintet_decodings[c] = Invalid;
+		for(int c = 0; c < 16; c++) quintet_decodings[nibble_encodings[c]] = uint16_t(c);
+
+		for(int c = 0; c < 256; c++) {
+			byte_encodings[c] = uint16_t(nibble_encodings[c & 0xf] | (nibble_encodings[c >> 4] << 5));
+		}
+
+		for(int c = 0; c < 1024; c++) {
+			// An invalid quintet contributes all 1s; so e.g. an invalid top half alone leaves the bottom
+			// nibble of the result intact, as composing the two decodings would.
+			const unsigned int low = quintet_decodings[c & 0x1f], high = quintet_decodings[c >> 5];
+			const bool is_invalid = low == Invalid || high == Invalid;
+			dectet_decodings[c] = uint16_t(((is_invalid ? 0xf0 : 0) | low | (high << 4)) & 0xff) | (is_invalid ? InvalidDectet : 0);
+		}
 	}
+};
+constexpr Tables tables;
+
+}
+
+unsigned int Storage::Encodings::CommodoreGCR::encoding_for_nibble(uint8_t nibble) {
+	return nibble_encodings[nibble & 0xf];
 }
 
 unsigned int Storage::Encodings::CommodoreGCR::decoding_from_quintet(unsigned int quintet) {
-	switch(quintet & 0x1f) {
-		case 0x0a:	return 0x0;			case 0x0b:	return 0x1;
-		case 0x12:	return 0x2;			case 0x13:	return 0x3;
-		case 0x0e:	return 0x4;			case 0x0f:	return 0x5;
-		case 0x16:	return 0x6;			case 0x17:	return 0x7;
-		case 0x09:	return 0x8;			case 0x19:	return 0x9;
-		case 0x1a:	return 0xa;			case 0x1b:	return 0xb;
-		case 0x0d:	return 0xc;			case 0x1d:	return 0xd;
-		case 0x1e:	return 0xe;			case 0x15:	return 0xf;
-
-		default:	return std::numeric_limits<unsigned int>::max();
-	}
+	const uint16_t nibble = tables.quintet_decodings[quintet & 0x1f];
+	return nibble == Invalid ? std::numeric_limits<unsigned int>::max() : nibble;
 }
 
 unsigned int Storage::Encodings::CommodoreGCR::encoding_for_byte(uint8_t byte) {
-	return encoding_for_nibble(byte) | (encoding_for_nibble(byte >> 4) << 5);
+	return tables.byte_encodings[byte];
 }
 
 unsigned int Storage::Encodings::CommodoreGCR::decoding_from_dectet(unsigned int dectet) {
-	return decoding_from_quintet(dectet) | (decoding_from_quintet(dectet >> 5) << 4);
+	const uint16_t byte = tables.dectet_decodings[dectet & 0x3ff];
+	return (byte & InvalidDectet) ? (std::numeric_limits<unsigned int>::max() & ~0xffu) | (byte & 0xff) : byte;
 }
 
 void Storage::Encodings::CommodoreGCR::encode_block(uint8_t *destination, uint8_t *source) {
-	unsigned int encoded_bytes[4] = {
-		encoding_for_byte(source[0]),
-		encoding_for_byte(source[1]),
-		encoding_for_byte(source[2]),
-		encoding_for_byte(source[3]),
-	};
-
-	destination[0] = uint8_t(encoded_bytes[0] >> 2);
-	destination[1] = uint8_t((encoded_bytes[0] << 6) | (encoded_bytes[1] >> 4));
-	destination[2] = uint8_t((encoded_bytes[1] << 4) | (encoded_bytes[2] >> 6));
-	destination[3] = uint8_t((encoded_bytes[2] << 2) | (encoded_bytes[3] >> 8));
-	destination[4] = uint8_t(encoded_bytes[3]);
+	encode_bytes(destination, source, 4);
+}
+
+void Storage::Encodings::CommodoreGCR::encode_bytes(uint8_t *destination, const uint8_t *source, size_t count) {
+	// Each four bytes form exactly five of GCR, so are assembled as a single 40-bit word.
+	while(count) {
+		const size_t bytes = std::min(count, size_t(4));
+		uint64_t word = 0;
+		for(size_t c = 0; c < 4; c++) {
+			word = (word << 10) | (c < bytes ? tables.byte_encodings[source[c]] : 0);
+		}
+
+		const size_t output_bytes = (bytes * 10 + 7) >> 3;
+		for(size_t c = 0; c < output_bytes; c++) {
+			destination[c] = uint8_t(word >> (32 - c * 8));
+		}
+
+		source += bytes;
+		destination += output_bytes;
+		count -= bytes;
+	}
+}
+
+bool Storage::Encodings::CommodoreGCR::decode_bytes(uint8_t *destination, const uint8_t *source, size_t count) {
+	uint16_t invalid = 0;
+
+	// As per encode_bytes, each five bytes of GCR are read as a single 40-bit word.
+	while(count) {
+		const size_t bytes = std::min(count, size_t(4));
+		const size_t input_bytes = (bytes * 10 + 7) >> 3;
+		uint64_t word = 0;
+		for(size_t c = 0; c < 5; c++) {
+			word = (word << 8) | (c < input_bytes ? source[c] : 0);
+		}
+
+		for(size_t c = 0; c < bytes; c++) {
+			const uint16_t byte = tables.dectet_decodings[(word >> (30 - c * 10)) & 0x3ff];
+			invalid |= byte & InvalidDectet;
+			destination[c] = uint8_t(byte);
+		}
+
+		source += input_bytes;
+		destination += bytes;
+		count -= bytes;
+	}
+
+	return !invalid;
 }
@@ -10,6 +10,7 @@
 #define Storage_Disk_Encodings_CommodoreGCR_hpp
 
 #include "../../Storage.hpp"
+#include <cstddef>
 #include <cstdint>
 
 namespace Storage {
@@ -37,6 +38,21 @@ namespace CommodoreGCR {
 	*/
 	void encode_block(uint8_t *destination, uint8_t *source);
 
+	/*!
+		Encodes @c count bytes from @c source, writing the resulting 10 * @c count bits of GCR to @c destination,
+		most significant bit first. If that isn't a whole number of bytes then the final byte is padded with 0s.
+	*/
+	void encode_bytes(uint8_t *destination, const uint8_t *source, size_t count);
+
+	/*!
+		Decodes @c count bytes from the 10 * @c count bits of GCR at @c source, which are expected to be
+		most significant bit first.
+
+		@returns @c true if all of the GCR was valid; @c false otherwise. Any byte that couldn't be decoded
+			is written as the low eight bits of what @c decoding_from_dectet would return.
+	*/
+	bool decode_bytes(uint8_t *destination, const uint8_t *source, size_t count);
+
 	/*!
 		@returns the four bit nibble for the five-bit GCR @c quintet if a valid GCR value; INT_MAX otherwise.
 	*/
@@ -12,6 +12,7 @@
 #include "../../Track/PCMTrack.hpp"
 #include "../../../../Numeric/CRC.hpp"
 
+#include <algorithm>
 #include <cassert>
 #include <set>
 
@@ -22,6 +23,44 @@ enum class SurfaceItem {
 	Data
 };
 
+namespace {
+
+/// Maps from each byte to the same bits spread out to the odd positions of a 16-bit word,
+/// i.e. the data bits of an FM or MFM encoding.
+struct SpreadTable {
+	uint16_t values[256]{};
+
+	constexpr SpreadTable() {
+		for(int c = 0; c < 256; c++) {
+			for(int bit = 0; bit < 8; bit++) {
+				values[c] |= ((c >> bit) & 1) << (bit * 2);
+			}
+		}
+	}
+};
+constexpr SpreadTable spread_table;
+
+constexpr uint16_t spread(uint8_t value) {
+	return spread_table.values[value];
+}
+
+/// Maps from each byte to its MFM encoding, assuming that the previous data bit was a 0; if it was a 1
+/// then the clock bit at the top of the encoding should be cleared.
+struct MFMTable {
+	uint16_t values[256]{};
+
+	constexpr MFMTable() {
+		for(int c = 0; c < 256; c++) {
+			const uint16_t spread_value = spread_table.values[c];
+			const uint16_t or_bits = uint16_t((spread_value << 1) | (spread_value >> 1));
+			values[c] = spread_value | ((~or_bits) & 0xaaaa);
+		}
+	}
+};
+constexpr MFMTable mfm_table;
+
+}
+
 class MFMEncoder: public Encoder {
 	public:
 		MFMEncoder(std::vector<bool> &target, std::vector<bool> *fuzzy_target = nullptr) : Encoder(target, fuzzy_target) {}
@@ -29,33 +68,28 @@ class MFMEncoder: public Encoder {
 
 		void add_byte(uint8_t input, uint8_t fuzzy_mask = 0) final {
 			crc_generator_.add(input);
-			const uint16_t spread_value =
-				uint16_t(
-					((input & 0x01) << 0) |
-					((input & 0x02) << 1) |
-					((input & 0x04) << 2) |
-					((input & 0x08) << 3) |
-					((input & 0x10) << 4) |
-					((input & 0x20) << 5) |
-					((input & 0x40) << 6) |
-					((input & 0x80) << 7)
-				);
-			const uint16_t or_bits = uint16_t((spread_value << 1) | (spread_value >> 1) | (last_output_ << 15));
-			const uint16_t output = spread_value | ((~or_bits) & 0xaaaa);
-
-			const uint16_t spread_mask =
-				uint16_t(
-					((fuzzy_mask & 0x01) << 0) |
-					((fuzzy_mask & 0x02) << 1) |
-					((fuzzy_mask & 0x04) << 2) |
-					((fuzzy_mask & 0x08) << 3) |
-					((fuzzy_mask & 0x10) << 4) |
-					((fuzzy_mask & 0x20) << 5) |
-					((fuzzy_mask & 0x40) << 6) |
-					((fuzzy_mask & 0x80) << 7)
-				);
-
-			output_short(output, spread_mask);
+			output_short(encoding(input), spread(fuzzy_mask));
+		}
+
+		void add_bytes(const uint8_t *input, size_t count) final {
+			crc_generator_.add(input, count);
+
+			std::vector<uint16_t> &words = prepare_words(count);
+			for(size_t c = 0; c < count; c++) {
+				last_output_ = words[c] = encoding(input[c]);
+			}
+			output_words();
+		}
+
+		void add_repeated_byte(uint8_t input, size_t count) final {
+			if(!count) return;
+			add_byte(input);
+
+			// After the first, every copy has the same encoding.
+			for(size_t c = 1; c < count; c++) crc_generator_.add(input);
+			std::vector<uint16_t> &words = prepare_words(count - 1);
+			std::fill(words.begin(), words.end(), encoding(input));
+			output_words();
 		}
 
 		void add_index_address_mark() final {
@@ -88,7 +122,13 @@ class MFMEncoder: public Encoder {
 		}
 
 	private:
-		uint16_t last_output_;
+		uint16_t last_output_ = 0;
+
+		/// @returns The MFM encoding of @c input, given the current value of @c last_output_.
+		uint16_t encoding(uint8_t input) const {
+			return mfm_table.values[input] & ~((last_output_ & 1) << 15);
+		}
+
 		void output_short(uint16_t value, uint16_t fuzzy_mask = 0) final {
 			last_output_ = value;
 			Encoder::output_short(value, fuzzy_mask);
@@ -107,29 +147,25 @@ class FMEncoder: public Encoder {
 
 		void add_byte(uint8_t input, uint8_t fuzzy_mask = 0) final {
 			crc_generator_.add(input);
-			output_short(
-				uint16_t(
-					((input & 0x01) << 0) |
-					((input & 0x02) << 1) |
-					((input & 0x04) << 2) |
-					((input & 0x08) << 3) |
-					((input & 0x10) << 4) |
-					((input & 0x20) << 5) |
-					((input & 0x40) << 6) |
-					((input & 0x80) << 7) |
-					0xaaaa
-				),
-				uint16_t(
-					((fuzzy_mask & 0x01) << 0) |
-					((fuzzy_mask & 0x02) << 1) |
-					((fuzzy_mask & 0x04) << 2) |
-					((fuzzy_mask & 0x08) << 3) |
-					((fuzzy_mask & 0x10) << 4) |
-					((fuzzy_mask & 0x20) << 5) |
-					((fuzzy_mask & 0x40) << 6) |
-					((fuzzy_mask & 0x80) << 7)
-				)
-			);
+			output_short(encoding(input), spread(fuzzy_mask));
+		}
+
+		void add_bytes(const uint8_t *input, size_t count) final {
+			crc_generator_.add(input, count);
+
+			std::vector<uint16_t> &words = prepare_words(count);
+			for(size_t c = 0; c < count; c++) {
+				words[c] = encoding(input[c]);
+			}
+			output_words();
+		}
+
+		void add_repeated_byte(uint8_t input, size_t count) final {
+			for(size_t c = 0; c < count; c++) crc_generator_.add(input);
+
+			std::vector<uint16_t> &words = prepare_words(count);
+			std::fill(words.begin(), words.end(), encoding(input));
+			output_words();
 		}
 
 		void add_index_address_mark() final {
@@ -160,6 +196,11 @@ class FMEncoder: public Encoder {
 			// Marks are just slightly-invalid bytes, so everything is the same length.
 			return 2;
 		}
+
+	private:
+		static uint16_t encoding(uint8_t input) {
+			return spread(input) | 0xaaaa;
+		}
 };
 
 template<class T> std::shared_ptr<Storage::Disk::Track>
@@ -215,12 +256,12 @@ template<class T> std::shared_ptr<Storage::Disk::Track>
 	shifter.add_index_address_mark();
 
 	// Add the post-index mark.
-	for(std::size_t c = 0; c < post_index_address_mark_bytes; c++) shifter.add_byte(post_index_address_mark_value);
+	shifter.add_repeated_byte(post_index_address_mark_value, post_index_address_mark_bytes);
 
 	// Add sectors.
 	for(const Sector *sector : sectors) {
 		// Gap.
-		for(std::size_t c = 0; c < pre_address_mark_bytes; c++) shifter.add_byte(0x00);
+		shifter.add_repeated_byte(0x00, pre_address_mark_bytes);
 
 		// Sector header.
 		shifter.add_ID_address_mark();
@@ -231,8 +272,8 @@ template<class T> std::shared_ptr<Storage::Disk::Track>
 		shifter.add_crc(sector->has_header_crc_error);
 
 		// Gap.
-		for(std::size_t c = 0; c < post_address_mark_bytes; c++) shifter.add_byte(post_address_mark_value);
-		for(std::size_t c = 0; c < pre_data_mark_bytes; c++) shifter.add_byte(0x00);
+		shifter.add_repeated_byte(post_address_mark_value, post_address_mark_bytes);
+		shifter.add_repeated_byte(0x00, pre_data_mark_bytes);
 
 		// Data, if attached.
 		if(!sector->samples.empty()) {
@@ -264,21 +305,20 @@ template<class T> std::shared_ptr<Storage::Disk::Track>
 					shifter.add_byte(sector->samples[0][c], fuzzy_mask);
 				}
 			} else {
-				for(c = 0; c < sector->samples[0].size() && c < declared_length; c++) {
-					shifter.add_byte(sector->samples[0][c]);
-				}
-			}
-			for(; c < declared_length; c++) {
-				shifter.add_byte(0x00);
+				c = std::min(sector->samples[0].size(), declared_length);
+				shifter.add_bytes(sector->samples[0].data(), c);
 			}
+			shifter.add_repeated_byte(0x00, declared_length - c);
 			shifter.add_crc(sector->has_data_crc_error);
 		}
 
 		// Gap.
-		for(std::size_t c = 0; c < post_data_bytes; c++) shifter.add_byte(post_data_value);
+		shifter.add_repeated_byte(post_data_value, post_data_bytes);
 	}
 
-	while(segment.data.size() < expected_track_bytes*8) shifter.add_byte(0x00);
+	if(segment.data.size() < expected_track_bytes*8) {
+		shifter.add_repeated_byte(0x00, (expected_track_bytes*8 - segment.data.size() + 15) >> 4);
+	}
 
 	// Allow the amount of data written to be up to 10% more than the expected size. Which is generous.
 	if(segment.data.size() > max_size) segment.data.resize(max_size);
@@ -314,6 +354,31 @@ void Encoder::output_short(uint16_t value, uint16_t fuzzy_mask) {
 	}
 }
 
+void Encoder::add_bytes(const uint8_t *input, size_t count) {
+	for(size_t c = 0; c < count; c++) add_byte(input[c]);
+}
+
+void Encoder::add_repeated_byte(uint8_t input, size_t count) {
+	for(size_t c = 0; c < count; c++) add_byte(input);
+}
+
+std::vector<uint16_t> &Encoder::prepare_words(size_t count) {
+	words_.resize(count);
+	return words_;
+}
+
+void Encoder::output_words() {
+	// Append all words at once, setting only those bits that are 1.
+	size_t bit = target_->size();
+	target_->resize(bit + words_.size() * 16);
+	for(const auto word: words_) {
+		for(int c = 15; c >= 0; c--) {
+			if((word >> c) & 1) (*target_)[bit] = true;
+			++bit;
+		}
+	}
+}
+
 void Encoder::add_crc(bool incorrectly) {
 	const uint16_t crc_value = crc_generator_.get_value();
 	add_byte(crc_value >> 8);
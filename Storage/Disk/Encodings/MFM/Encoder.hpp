@@ -49,6 +49,13 @@ class Encoder {
 		virtual void reset_target(std::vector<bool> &target, std::vector<bool> *fuzzy_target = nullptr);
 
 		virtual void add_byte(uint8_t input, uint8_t fuzzy_mask = 0) = 0;
+
+		/// Adds the @c count bytes at @c input; equivalent to but faster than calling @c add_byte for each.
+		virtual void add_bytes(const uint8_t *input, size_t count);
+
+		/// Adds @c count copies of @c input; equivalent to but faster than calling @c add_byte for each.
+		virtual void add_repeated_byte(uint8_t input, size_t count);
+
 		virtual void add_index_address_mark() = 0;
 		virtual void add_ID_address_mark() = 0;
 		virtual void add_data_address_mark() = 0;
@@ -61,9 +68,16 @@ class Encoder {
 	protected:
 		CRC::CCITT crc_generator_;
 
+		/// @returns A buffer for @c count encoded words, which @c output_words will then append to the target.
+		std::vector<uint16_t> &prepare_words(size_t count);
+
+		/// Appends the words most recently supplied via @c prepare_words to the target, with no fuzzy bits.
+		void output_words();
+
 	private:
 		std::vector<bool> *target_ = nullptr;
 		std::vector<bool> *fuzzy_target_ = nullptr;
+		std::vector<uint16_t> words_;
 };
 
 std::unique_ptr<Encoder> GetMFMEncoder(std::vector<bool> &target, std::vector<bool> *fuzzy_target = nullptr);
@@ -12,8 +12,43 @@
 #include "../../Track/TrackSerialiser.hpp"
 #include "SegmentParser.hpp"
 
+#include <mutex>
+#include <utility>
+
 using namespace Storage::Encodings::MFM;
 
+namespace {
+
+/// Records the sectors decoded from a track, and the track they were decoded from.
+struct DecodedTrack {
+	std::weak_ptr<Storage::Disk::Track> track;
+	std::shared_ptr<std::map<int, Sector>> sectors;
+};
+
+/// All tracks decoded from a particular disk, indexed by address and whether they were decoded as MFM.
+struct DecodedDisk {
+	std::weak_ptr<Storage::Disk::Disk> disk;
+	std::map<std::pair<Storage::Disk::Track::Address, bool>, DecodedTrack> tracks;
+};
+
+std::mutex decoded_disks_mutex;
+std::map<const Storage::Disk::Disk *, DecodedDisk> decoded_disks;
+
+/// @returns the record of decoded tracks for @c disk, discarding those of any disks that no longer exist.
+/// Should be called only with decoded_disks_mutex held.
+DecodedDisk &decoded_disk(const std::shared_ptr<Storage::Disk::Disk> &disk) {
+	for(auto iterator = decoded_disks.begin(); iterator != decoded_disks.end();) {
+		if(iterator->second.disk.expired()) iterator = decoded_disks.erase(iterator);
+		else ++iterator;
+	}
+
+	auto &decoded = decoded_disks[disk.get()];
+	decoded.disk = disk;
+	return decoded;
+}
+
+}
+
 Parser::Parser(bool is_mfm, const std::shared_ptr<Storage::Disk::Disk> &disk) :
 		disk_(disk), is_mfm_(is_mfm) {}
 
@@ -27,15 +62,30 @@ void Parser::install_sectors_from_track(const Storage::Disk::Track::Address &add
 		return;
 	}
 
+	// Reuse an existing decoding if this exact track has been decoded before.
+	const auto key = std::make_pair(address, is_mfm_);
+	{
+		std::lock_guard lock_guard(decoded_disks_mutex);
+		const auto &tracks = decoded_disk(disk_).tracks;
+		const auto decoded = tracks.find(key);
+		if(decoded != tracks.end() && decoded->second.track.lock() == track) {
+			sectors_by_address_by_track_.insert(std::make_pair(address, decoded->second.sectors));
+			return;
+		}
+	}
+
 	std::map<std::size_t, Sector> sectors = sectors_from_segment(
 		Storage::Disk::track_serialisation(*track, is_mfm_ ? MFMBitLength : FMBitLength),
 		is_mfm_);
 
-	std::map<int, Storage::Encodings::MFM::Sector> sectors_by_id;
+	auto sectors_by_id = std::make_shared<SectorMap>();
 	for(const auto &sector : sectors) {
-		sectors_by_id.insert(std::make_pair(sector.second.address.sector, std::move(sector.second)));
+		sectors_by_id->insert(std::make_pair(sector.second.address.sector, std::move(sector.second)));
 	}
-	sectors_by_address_by_track_.insert(std::make_pair(address, std::move(sectors_by_id)));
+	sectors_by_address_by_track_.insert(std::make_pair(address, sectors_by_id));
+
+	std::lock_guard lock_guard(decoded_disks_mutex);
+	decoded_disk(disk_).tracks[key] = DecodedTrack{track, sectors_by_id};
 }
 
 Sector *Parser::get_sector(int head, int track, uint8_t sector) {
@@ -47,8 +97,8 @@ Sector *Parser::get_sector(int head, int track, uint8_t sector) {
 		return nullptr;
 	}
 
-	auto stored_sector = sectors->second.find(sector);
-	if(stored_sector == sectors->second.end()) {
+	auto stored_sector = sectors->second->find(sector);
+	if(stored_sector == sectors->second->end()) {
 		return nullptr;
 	}
 
@@ -13,12 +13,19 @@
 #include "../../Track/Track.hpp"
 #include "../../Drive.hpp"
 
+#include <map>
+#include <memory>
+
 namespace Storage {
 namespace Encodings {
 namespace MFM {
 
 /*!
 	Provides a mechanism for collecting sectors from a disk.
+
+	Decoded tracks are shared between all parsers of the same disk, for as long as the disk continues
+	to supply the same track, so that analysing a disk repeatedly doesn't repeatedly decode it.
+	Sectors returned should therefore be treated as read-only.
 */
 class Parser {
 	public:
@@ -36,8 +43,9 @@ class Parser {
 		std::shared_ptr<Storage::Disk::Disk> disk_;
 		bool is_mfm_ = true;
 
+		using SectorMap = std::map<int, Storage::Encodings::MFM::Sector>;
 		void install_sectors_from_track(const Storage::Disk::Track::Address &address);
-		std::map<Storage::Disk::Track::Address, std::map<int, Storage::Encodings::MFM::Sector>> sectors_by_address_by_track_;
+		std::map<Storage::Disk::Track::Address, std::shared_ptr<SectorMap>> sectors_by_address_by_track_;
 };
 
 }
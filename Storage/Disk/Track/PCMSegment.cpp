@@ -8,23 +8,45 @@
 
 #include "PCMSegment.hpp"
 
+#include <algorithm>
 #include <cassert>
 #include <cstdlib>
 
 using namespace Storage::Disk;
 
+namespace {
+
+/// @returns the number of leading zeros in @c value, which must be non-zero.
+inline int count_leading_zeros(uint64_t value) {
+#if defined(__GNUC__) || defined(__clang__)
+	return __builtin_clzll(value);
+#else
+	int count = 0;
+	while(!(value & 0x8000'0000'0000'0000)) {
+		value <<= 1;
+		++count;
+	}
+	return count;
+#endif
+}
+
+}
+
 PCMSegmentEventSource::PCMSegmentEventSource(const PCMSegment &segment) :
-		segment_(new PCMSegment(segment)) {
+		segment_(std::make_shared<PackedSegment>(segment)) {
 	// add an extra bit of storage at the bottom if one is going to be needed;
 	// events returned are going to be in integral multiples of the length of a bit
 	// other than the very first and very last which will include a half bit length
-	if(segment_->length_of_a_bit.length&1) {
-		segment_->length_of_a_bit.length <<= 1;
-		segment_->length_of_a_bit.clock_rate <<= 1;
+	if(segment_->segment.length_of_a_bit.length&1) {
+		segment_->segment.length_of_a_bit.length <<= 1;
+		segment_->segment.length_of_a_bit.clock_rate <<= 1;
 	}
 
 	// load up the clock rate once only
-	next_event_.length.clock_rate = segment_->length_of_a_bit.clock_rate;
+	next_event_.length.clock_rate = segment_->segment.length_of_a_bit.clock_rate;
+
+	// pack now, while this is the only user of the segment
+	segment_->pack();
 
 	// set initial conditions
 	reset();
@@ -35,7 +57,7 @@ PCMSegmentEventSource::PCMSegmentEventSource(const PCMSegmentEventSource &origin
 	segment_ = original.segment_;
 
 	// load up the clock rate and set initial conditions
-	next_event_.length.clock_rate = segment_->length_of_a_bit.clock_rate;
+	next_event_.length.clock_rate = segment_->segment.length_of_a_bit.clock_rate;
 	reset();
 }
 
@@ -70,25 +92,59 @@ void PCMSegment::rotate_right(size_t length) {
 	}
 }
 
+void PCMSegmentEventSource::PackedSegment::pack() {
+	words.clear();
+	words.resize((segment.data.size() + 63) >> 6);
+
+	size_t pointer = 0;
+	for(const auto bit: segment.data) {
+		if(bit) words[pointer >> 6] |= uint64_t(1) << (63 ^ (pointer & 63));
+		++pointer;
+	}
+	words_are_current = true;
+}
+
 Storage::Disk::Track::Event PCMSegmentEventSource::get_next_event() {
+	const PCMSegment &segment = segment_->segment;
+	const std::size_t size = segment.data.size();
+	const auto bit_length = segment.length_of_a_bit.length;
+
 	// Track the initial bit pointer for potentially considering whether this was an
 	// initial index hole or a subsequent one later on.
 	const std::size_t initial_bit_pointer = bit_pointer_;
 
 	// If starting from the beginning, pull half a bit backward, as if the initial bit
 	// is set, it should be in the centre of its window.
-	next_event_.length.length = bit_pointer_ ? 0 : -(segment_->length_of_a_bit.length >> 1);
-
-	// search for the next bit that is set, if any
-	while(bit_pointer_ < segment_->data.size()) {
-		bool bit = segment_->data[bit_pointer_];
-		++bit_pointer_;	// so this always points one beyond the most recent bit returned
-		next_event_.length.length += segment_->length_of_a_bit.length;
-
-		// if this bit is set, or is fuzzy and a random bit of 1 is selected, return the event.
-		if(bit ||
-			(!segment_->fuzzy_mask.empty() && segment_->fuzzy_mask[bit_pointer_] && lfsr_.next())
-		)	return next_event_;
+	next_event_.length.length = bit_pointer_ ? 0 : -(bit_length >> 1);
+
+	if(segment.fuzzy_mask.empty()) {
+		// Without fuzzy bits, search a word at a time for the next bit that is set, if any.
+		if(!segment_->words_are_current) segment_->pack();
+
+		while(bit_pointer_ < size) {
+			const uint64_t word = segment_->words[bit_pointer_ >> 6] << (bit_pointer_ & 63);
+			if(word) {
+				// Words are zero-padded beyond the end of the segment, so this is definitely in bounds.
+				const int distance = count_leading_zeros(word) + 1;
+				bit_pointer_ += size_t(distance);	// so this always points one beyond the most recent bit returned
+				next_event_.length.length += bit_length * unsigned(distance);
+				return next_event_;
+			}
+
+			const size_t distance = std::min(64 - (bit_pointer_ & 63), size - bit_pointer_);
+			bit_pointer_ += distance;
+			next_event_.length.length += bit_length * unsigned(distance);
+		}
+	} else {
+		// search for the next bit that is set, if any
+		while(bit_pointer_ < size) {
+			bool bit = segment.data[bit_pointer_];
+			++bit_pointer_;	// so this always points one beyond the most recent bit returned
+			next_event_.length.length += bit_length;
+
+			// if this bit is set, or is fuzzy and a random bit of 1 is selected, return the event.
+			if(bit || (segment.fuzzy_mask[bit_pointer_] && lfsr_.next())) return next_event_;
+		}
 	}
 
 	// If the end is reached without a bit being set, it'll be index holes from now on.
@@ -98,15 +154,15 @@ Storage::Disk::Track::Event PCMSegmentEventSource::get_next_event() {
 	// allow an extra half bit's length to run from the position of the potential final transition
 	// event to the end of the segment. Otherwise don't allow any extra time, as it's already
 	// been consumed.
-	if(initial_bit_pointer <= segment_->data.size()) {
-		next_event_.length.length += (segment_->length_of_a_bit.length >> 1);
+	if(initial_bit_pointer <= size) {
+		next_event_.length.length += (bit_length >> 1);
 		bit_pointer_++;
 	}
 	return next_event_;
 }
 
 Storage::Time PCMSegmentEventSource::get_length() {
-	return segment_->length_of_a_bit * unsigned(segment_->data.size());
+	return segment_->segment.length_of_a_bit * unsigned(segment_->segment.data.size());
 }
 
 float PCMSegmentEventSource::seek_to(float time_from_start) {
@@ -114,7 +170,7 @@ float PCMSegmentEventSource::seek_to(float time_from_start) {
 	const float length = get_length().get<float>();
 	if(time_from_start >= length) {
 		next_event_.type = Track::Event::IndexHole;
-		bit_pointer_ = segment_->data.size()+1;
+		bit_pointer_ = segment_->segment.data.size()+1;
 		return length;
 	}
 
@@ -122,7 +178,7 @@ float PCMSegmentEventSource::seek_to(float time_from_start) {
 	next_event_.type = Track::Event::FluxTransition;
 
 	// test for requested time being before the first bit
-	const float bit_length = segment_->length_of_a_bit.get<float>();
+	const float bit_length = segment_->segment.length_of_a_bit.get<float>();
 	const float half_bit_length = bit_length / 2.0f;
 	if(time_from_start < half_bit_length) {
 		bit_pointer_ = 0;
@@ -140,9 +196,17 @@ float PCMSegmentEventSource::seek_to(float time_from_start) {
 }
 
 const PCMSegment &PCMSegmentEventSource::segment() const {
-	return *segment_;
+	return segment_->segment;
 }
 
 PCMSegment &PCMSegmentEventSource::segment() {
-	return *segment_;
+	// The caller may modify the segment; if it is currently shared with any copies of this
+	// event source then take a private copy first so that they're unaffected.
+	if(segment_.use_count() > 1) {
+		segment_ = std::make_shared<PackedSegment>(*segment_);
+	}
+
+	// The packed copy of its data can no longer be trusted.
+	segment_->words_are_current = false;
+	return segment_->segment;
 }
@@ -162,7 +162,8 @@ class PCMSegmentEventSource {
 
 		/*!
 			Copy constructor; produces a segment event source with the same underlying segment
-			but a unique pointer into it.
+			but a unique pointer into it. The segment is copied only if and when either source
+			is asked for a mutable reference to it.
 		*/
 		PCMSegmentEventSource(const PCMSegmentEventSource &);
 
@@ -192,12 +193,26 @@ class PCMSegmentEventSource {
 
 		/*!
 			@returns a reference to the underlying segment.
+
+			Any modifications made via the non-const version must be complete before the next call
+			to @c get_next_event. The non-const version will first give this source a private copy
+			of the segment if it is currently shared by any copies.
 		*/
 		const PCMSegment &segment() const;
 		PCMSegment &segment();
 
 	private:
-		std::shared_ptr<PCMSegment> segment_;
+		/// Holds a segment plus a copy of its data packed into 64-bit words, MSB first, for
+		/// quick scanning. The packed copy is regenerated whenever the segment may have changed.
+		struct PackedSegment {
+			PCMSegment segment;
+			std::vector<uint64_t> words;
+			bool words_are_current = false;
+
+			PackedSegment(const PCMSegment &segment) : segment(segment) {}
+			void pack();
+		};
+		std::shared_ptr<PackedSegment> segment_;
 		std::size_t bit_pointer_;
 		Track::Event next_event_;
 		Numeric::LFSR<uint64_t> lfsr_;
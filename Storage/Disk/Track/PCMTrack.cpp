@@ -72,6 +72,15 @@ Track *PCMTrack::clone() const {
 	return new PCMTrack(*this);
 }
 
+size_t PCMTrack::get_memory_footprint() const {
+	// Segment data is bit packed by std::vector<bool>.
+	size_t footprint = sizeof(*this) + segment_event_sources_.size() * sizeof(PCMSegmentEventSource);
+	for(const auto &source: segment_event_sources_) {
+		footprint += (source.segment().data.capacity() + source.segment().fuzzy_mask.capacity() + 7) >> 3;
+	}
+	return footprint;
+}
+
 PCMTrack *PCMTrack::resampled_clone(size_t bits_per_track) {
 	// Create an empty track.
 	PCMTrack *const new_track = new PCMTrack(unsigned(bits_per_track));
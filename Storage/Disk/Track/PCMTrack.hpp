@@ -40,6 +40,7 @@ class PCMTrack: public Track {
 
 		/*!
 			Copy constructor; required for Tracks in order to support modifiable disks.
+			Segment data is shared with the original until either is modified, so copying is cheap.
 		*/
 		PCMTrack(const PCMTrack &);
 
@@ -52,12 +53,23 @@ class PCMTrack: public Track {
 		Event get_next_event() final;
 		float seek_to(float time_since_index_hole) final;
 		Track *clone() const final;
+		size_t get_memory_footprint() const final;
 
 		// Obtains a copy of this track, flattened to a single PCMSegment, which
 		// consists of @c bits_per_track potential flux transition points.
 		PCMTrack *resampled_clone(size_t bits_per_track);
 		bool is_resampled_clone();
 
+		/// @returns The number of segments that make up this track.
+		size_t segment_count() const {
+			return segment_event_sources_.size();
+		}
+
+		/// @returns The segment at @c index; its @c length_of_a_bit is such that all segments together fill exactly one rotation.
+		const PCMSegment &segment(size_t index) const {
+			return segment_event_sources_[index].segment();
+		}
+
 		/*!
 			Replaces whatever is currently on the track from @c start_position to @c start_position + segment length
 			with the contents of @c segment.
@@ -10,6 +10,7 @@
 #define Track_h
 
 #include "../../Storage.hpp"
+#include <cstddef>
 #include <tuple>
 
 namespace Storage {
@@ -124,6 +125,11 @@ class Track {
 			The virtual copy constructor pattern; returns a copy of the Track.
 		*/
 		virtual Track *clone() const = 0;
+
+		/*!
+			@returns the number of bytes of host memory occupied by this track's content, if known; zero otherwise.
+		*/
+		virtual size_t get_memory_footprint() const { return 0; }
 };
 
 }
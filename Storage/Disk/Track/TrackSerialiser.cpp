@@ -8,21 +8,50 @@
 
 #include "TrackSerialiser.hpp"
 
+#include "PCMTrack.hpp"
+
 #include <memory>
+#include <vector>
+
+namespace {
+
+/*!
+	@returns @c true if @c track consists only of segments without fuzzy bits in which every bit is
+	exactly @c length_of_a_bit long, i.e. if a PLL at that rate would reproduce its bits exactly.
+*/
+bool is_uniform(const Storage::Disk::PCMTrack &track, Storage::Time length_of_a_bit) {
+	if(!track.segment_count()) return false;
+
+	for(size_t c = 0; c < track.segment_count(); c++) {
+		const auto &segment = track.segment(c);
+		if(!(segment.length_of_a_bit == length_of_a_bit) || !segment.fuzzy_mask.empty()) return false;
+	}
+	return true;
+}
+
+}
 
-// TODO: if this is a PCMTrack with only one segment and that segment's bit rate is within tolerance,
-// just return a copy of that segment.
 Storage::Disk::PCMSegment Storage::Disk::track_serialisation(const Track &track, Time length_of_a_bit) {
-	unsigned int history_size = 16;
+	// A PCMTrack that is already sampled at the requested rate can simply be copied, splicing together
+	// its segments, rather than be simulated through a PLL.
+	const auto pcm_track = dynamic_cast<const PCMTrack *>(&track);
+	if(pcm_track && is_uniform(*pcm_track, length_of_a_bit)) {
+		PCMSegment result(length_of_a_bit, pcm_track->segment(0).data);
+		for(size_t c = 1; c < pcm_track->segment_count(); c++) {
+			result += pcm_track->segment(c);
+		}
+		return result;
+	}
+
+	constexpr std::size_t history_size = 16;
 	std::unique_ptr<Track> track_copy(track.clone());
 
 	// ResultAccumulator exists to append whatever comes out of the PLL to
 	// its PCMSegment.
 	struct ResultAccumulator {
 		PCMSegment result;
-		bool is_recording = false;
 		void digital_phase_locked_loop_output_bit(int value) {
-			if(is_recording) result.data.push_back(!!value);
+			result.data.push_back(!!value);
 		}
 	} result_accumulator;
 	result_accumulator.result.length_of_a_bit = length_of_a_bit;
@@ -34,10 +63,10 @@ Storage::Disk::PCMSegment Storage::Disk::track_serialisation(const Track &track,
 	Time length_multiplier = Time(100*length_of_a_bit.clock_rate, length_of_a_bit.length);
 	length_multiplier.simplify();
 
-	// start at the index hole
+	// Start at the index hole and grab the intervals between events until the next;
+	// all but the final one are followed by a flux transition.
 	track_copy->seek_to(0.0f);
-
-	// grab events until the next index hole
+	std::vector<Cycles::IntType> intervals;
 	Time time_error = Time(0);
 	while(true) {
 		Track::Event next_event = track_copy->get_next_event();
@@ -45,21 +74,21 @@ Storage::Disk::PCMSegment Storage::Disk::track_serialisation(const Track &track,
 		Time extended_length = next_event.length * length_multiplier + time_error;
 		time_error.clock_rate = extended_length.clock_rate;
 		time_error.length = extended_length.length % extended_length.clock_rate;
-		pll.run_for(Cycles(int(extended_length.get<int64_t>())));
+		intervals.push_back(Cycles::IntType(int(extended_length.get<int64_t>())));
 
 		if(next_event.type == Track::Event::IndexHole) break;
-		pll.add_pulse();
-
-		// If the PLL is now sufficiently primed, restart, and start recording bits this time.
-		if(history_size) {
-			history_size--;
-			if(!history_size) {
-				track_copy->seek_to(0.0f);
-				time_error.set_zero();
-				result_accumulator.is_recording = true;
-			}
-		}
 	}
 
+	// Prime the PLL with the first few transitions, then restart from the index hole
+	// and record everything. If there aren't enough transitions for priming then
+	// nothing is recorded.
+	const std::size_t transitions = intervals.size() - 1;
+	if(transitions < history_size) {
+		return result_accumulator.result;
+	}
+	pll.add_pulses(intervals.data(), history_size, nullptr);
+	pll.add_pulses(intervals.data(), transitions, &result_accumulator.result.data);
+	pll.run_for(Cycles(intervals.back()));
+
 	return result_accumulator.result;
 }
@@ -26,6 +26,9 @@ namespace Disk {
 	desireable, e.g. file formats that apply that constraint, or static analysis prior to
 	emulation launch, which works with broad strokes.
 
+	A @c PCMTrack without fuzzy bits that is already sampled at exactly @c length_of_a_bit
+	is returned directly as its bits, without use of a PLL.
+
 	@param track The track to serialise.
 	@param length_of_a_bit The expected length of a single bit, as a proportion of the
 	track length.
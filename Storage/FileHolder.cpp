@@ -11,9 +11,17 @@
 #include <algorithm>
 #include <cstring>
 
+#if defined(__APPLE__) || defined(__unix__)
+#include <sys/mman.h>
+#define HAS_MMAP
+#endif
+
 using namespace Storage;
 
 FileHolder::~FileHolder() {
+#ifdef HAS_MMAP
+	if(mapping_) munmap(const_cast<uint8_t *>(mapping_), mapped_size_);
+#endif
 	if(file_) std::fclose(file_);
 }
 
@@ -189,3 +197,23 @@ struct stat &FileHolder::stats() {
 std::mutex &FileHolder::get_file_access_mutex() {
 	return file_access_mutex_;
 }
+
+const uint8_t *FileHolder::map() {
+#ifdef HAS_MMAP
+	if(mapping_ || file_stats_.st_size <= 0) return mapping_;
+
+	// Writes won't be made through the mapping, so it can be read-only regardless of
+	// the mode in which the file was opened; MAP_SHARED ensures that those made via
+	// file_ subsequently become visible through it.
+	void *const mapping = mmap(nullptr, size_t(file_stats_.st_size), PROT_READ, MAP_SHARED, fileno(file_), 0);
+	if(mapping == MAP_FAILED) return nullptr;
+
+	mapping_ = static_cast<const uint8_t *>(mapping);
+	mapped_size_ = size_t(file_stats_.st_size);
+#endif
+	return mapping_;
+}
+
+std::size_t FileHolder::mapped_size() const {
+	return mapped_size_;
+}
@@ -238,6 +238,25 @@ class FileHolder final {
 		*/
 		std::mutex &get_file_access_mutex();
 
+		/*!
+			Maps the file into memory for reading, if it isn't already and if the host allows. The file
+			is mapped at its current length; content appended later is not covered.
+
+			Anything written via this FileHolder becomes visible through the mapping once flushed.
+
+			This is not thread safe; it is intended to be called once, soon after construction.
+
+			@returns a pointer to the first @c mapped_size() bytes of the file, or @c nullptr if the
+				file could not be mapped, in which case it should be accessed through @c read.
+		*/
+		const uint8_t *map();
+
+		/*!
+			@returns the number of bytes available via the pointer returned by @c map, or 0 if the file
+				is not mapped.
+		*/
+		std::size_t mapped_size() const;
+
 	private:
 		FILE *file_ = nullptr;
 		const std::string name_;
@@ -246,6 +265,9 @@ class FileHolder final {
 		bool is_read_only_ = false;
 
 		std::mutex file_access_mutex_;
+
+		const uint8_t *mapping_ = nullptr;
+		std::size_t mapped_size_ = 0;
 };
 
 }
@@ -21,7 +21,7 @@ namespace MassStorage {
 */
 class DSK: public RawSectorDump<512> {
 	public:
-		DSK(const std::string &file_name);
+		DSK(const std::string &file_name, FileHolder::FileMode mode = FileHolder::FileMode::ReadWrite);
 };
 
 }
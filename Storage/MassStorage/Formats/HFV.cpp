@@ -10,7 +10,7 @@
 
 using namespace Storage::MassStorage;
 
-HFV::HFV(const std::string &file_name) : file_(file_name) {
+HFV::HFV(const std::string &file_name, FileHolder::FileMode mode) : file_(file_name, mode) {
 	// Is the file a multiple of 512 bytes in size and larger than a floppy disk?
 	const auto file_size = file_.stats().st_size;
 	if(file_size & 511 || file_size <= 800*1024) throw std::exception();
@@ -19,6 +19,8 @@ HFV::HFV(const std::string &file_name) : file_(file_name) {
 	// TODO: check filing system for MFS or HFS+.
 	const auto prefix = file_.read(2);
 	if(prefix[0] != 'L' || prefix[1] != 'K')  throw std::exception();
+
+	file_.map();
 }
 
 size_t HFV::get_block_size() {
@@ -36,6 +38,11 @@ std::vector<uint8_t> HFV::get_block(size_t address) {
 	const auto source_address = mapper_.to_source_address(address);
 	if(source_address >= 0 && size_t(source_address)*get_block_size() < size_t(file_.stats().st_size)) {
 		const long file_offset = long(get_block_size()) * long(source_address);
+		if(size_t(file_offset) + get_block_size() <= file_.mapped_size()) {
+			const uint8_t *const block = file_.map() + file_offset;
+			return mapper_.convert_source_block(source_address, std::vector<uint8_t>(block, block + get_block_size()));
+		}
+
 		file_.seek(file_offset, SEEK_SET);
 		return mapper_.convert_source_block(source_address, file_.read(get_block_size()));
 	} else {
@@ -49,6 +56,7 @@ void HFV::set_block(size_t address, const std::vector<uint8_t> &contents) {
 		const long file_offset = long(get_block_size()) * long(source_address);
 		file_.seek(file_offset, SEEK_SET);
 		file_.write(contents);
+		if(file_.mapped_size()) file_.flush();
 	} else {
 		writes_[address] = contents;
  	}
@@ -29,8 +29,11 @@ class HFV: public MassStorageDevice, public Encodings::Macintosh::Volume {
 			Constructs an HFV with the contents of the file named @c file_name.
 			Raises an exception if the file name doesn't appear to identify a valid
 			Macintosh mass storage image.
+
+			@c mode nominates how the file should ideally be opened; supply @c FileMode::Read if
+			the underlying file should never be modified.
 		*/
-		HFV(const std::string &file_name);
+		HFV(const std::string &file_name, FileHolder::FileMode mode = FileHolder::FileMode::ReadWrite);
 
 	private:
 		FileHolder file_;
@@ -0,0 +1,112 @@
+//
+//  Overlay.cpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 14/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#include "Overlay.hpp"
+
+#include "DSK.hpp"
+#include "HFV.hpp"
+
+#include <cassert>
+#include <cstring>
+
+using namespace Storage::MassStorage;
+
+namespace {
+
+constexpr char Signature[] = "CLKOVL01";
+constexpr size_t SignatureLength = sizeof(Signature) - 1;
+
+}
+
+Overlay::Overlay(const std::string &file_name) : file_(file_name) {
+	if(!file_.check_signature(Signature, SignatureLength)) throw std::exception();
+	block_size_ = file_.get32le();
+	if(!block_size_) throw std::exception();
+
+	// Locate the base image, relative to this file if necessary.
+	const auto name_length = file_.get16le();
+	const auto name = file_.read(name_length);
+	if(name.size() != name_length) throw std::exception();
+	std::string base_name(name.begin(), name.end());
+	if(base_name.empty()) throw std::exception();
+	if(base_name[0] != '/') {
+		const auto separator = file_name.find_last_of('/');
+		if(separator != std::string::npos) {
+			base_name = file_name.substr(0, separator + 1) + base_name;
+		}
+	}
+
+	try {
+		base_ = std::make_unique<HFV>(base_name, FileHolder::FileMode::Read);
+	} catch(...) {
+		base_ = std::make_unique<DSK>(base_name, FileHolder::FileMode::Read);
+	}
+	if(base_->get_block_size() != block_size_) throw std::exception();
+
+	// Index all written blocks; a truncated final record is ignored, and will be overwritten by
+	// the next new block.
+	const long file_size = long(file_.stats().st_size);
+	long offset = file_.tell();
+	const long record_size = long(block_size_) + 4;
+	while(offset + record_size <= file_size) {
+		file_.seek(offset, SEEK_SET);
+		blocks_[file_.get32le()] = offset + 4;
+		offset += record_size;
+	}
+	end_of_records_ = offset;
+}
+
+void Overlay::create(const std::string &file_name, const std::string &base_name, size_t block_size) {
+	FileHolder file(file_name, FileHolder::FileMode::Rewrite);
+	file.write(reinterpret_cast<const uint8_t *>(Signature), SignatureLength);
+	file.put_le(uint32_t(block_size));
+	file.put16le(uint16_t(base_name.size()));
+	file.write(reinterpret_cast<const uint8_t *>(base_name.data()), base_name.size());
+}
+
+size_t Overlay::get_block_size() {
+	return block_size_;
+}
+
+size_t Overlay::get_number_of_blocks() {
+	return base_->get_number_of_blocks();
+}
+
+std::vector<uint8_t> Overlay::get_block(size_t address) {
+	const auto block = blocks_.find(address);
+	if(block == blocks_.end()) {
+		return base_->get_block(address);
+	}
+
+	file_.seek(block->second, SEEK_SET);
+	return file_.read(block_size_);
+}
+
+void Overlay::set_block(size_t address, const std::vector<uint8_t> &contents) {
+	assert(contents.size() == block_size_);
+
+	// Rewrite in place if this block has been written before; otherwise append a new record.
+	auto block = blocks_.find(address);
+	if(block == blocks_.end()) {
+		file_.seek(end_of_records_, SEEK_SET);
+		file_.put_le(uint32_t(address));
+		block = blocks_.emplace(address, end_of_records_ + 4).first;
+		end_of_records_ += long(block_size_) + 4;
+	}
+
+	file_.seek(block->second, SEEK_SET);
+	file_.write(contents);
+	file_.flush();
+}
+
+void Overlay::set_drive_type(Encodings::Macintosh::DriveType drive_type) {
+	const auto volume = dynamic_cast<Encodings::Macintosh::Volume *>(base_.get());
+	if(volume) {
+		volume->set_drive_type(drive_type);
+	}
+}
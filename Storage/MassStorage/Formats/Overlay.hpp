@@ -0,0 +1,77 @@
+//
+//  Overlay.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 14/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#ifndef MassStorage_Overlay_hpp
+#define MassStorage_Overlay_hpp
+
+#include "../MassStorageDevice.hpp"
+#include "../../FileHolder.hpp"
+#include "../Encodings/MacintoshVolume.hpp"
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Storage {
+namespace MassStorage {
+
+/*!
+	Provides a @c MassStorageDevice that combines a base image, which is opened read-only
+	and never modified, with a sparse delta file that holds every block written since
+	the overlay was created. Any number of overlays can therefore share a single base.
+
+	The delta file is composed of:
+
+		* the eight-byte signature "CLKOVL01";
+		* the block size, as a 32-bit little-endian value;
+		* the name of the base image, as a 16-bit little-endian length followed by that
+			many bytes, relative to the directory containing the delta if not absolute; and
+		* any number of records, each a 32-bit little-endian block address followed by the
+			block's contents.
+
+	The base image may currently be either an HFV or a full-device Macintosh DSK.
+*/
+class Overlay: public MassStorageDevice, public Encodings::Macintosh::Volume {
+	public:
+		/*!
+			Constructs an overlay from the delta file named @c file_name.
+			Raises an exception if that file doesn't appear to be a valid delta
+			or its base image can't be opened.
+		*/
+		Overlay(const std::string &file_name);
+
+		/*!
+			Creates a new, empty delta named @c file_name for the base image @c base_name,
+			replacing anything already at @c file_name.
+		*/
+		static void create(const std::string &file_name, const std::string &base_name, size_t block_size = 512);
+
+	private:
+		FileHolder file_;
+		std::unique_ptr<MassStorageDevice> base_;
+		size_t block_size_ = 0;
+
+		/// Maps from block address to the file offset of that block's contents.
+		std::map<size_t, long> blocks_;
+		long end_of_records_ = 0;
+
+		/* MassStorageDevices overrides. */
+		size_t get_block_size() final;
+		size_t get_number_of_blocks() final;
+		std::vector<uint8_t> get_block(size_t address) final;
+		void set_block(size_t address, const std::vector<uint8_t> &) final;
+
+		/* Encodings::Macintosh::Volume overrides. */
+		void set_drive_type(Encodings::Macintosh::DriveType) final;
+};
+
+}
+}
+
+#endif /* MassStorage_Overlay_hpp */
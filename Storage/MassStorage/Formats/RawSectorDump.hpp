@@ -19,10 +19,13 @@ namespace MassStorage {
 
 template <size_t sector_size> class RawSectorDump: public MassStorageDevice {
 	public:
-		RawSectorDump(const std::string &file_name) : file_(file_name) {
+		RawSectorDump(const std::string &file_name, FileHolder::FileMode mode = FileHolder::FileMode::ReadWrite) :
+			file_(file_name, mode) {
 			// Is the file a multiple of sector_size bytes in size?
 			const auto file_size = size_t(file_.stats().st_size);
 			if(file_size % sector_size) throw std::exception();
+
+			file_.map();
 		}
 
 		/* MassStorageDevices overrides. */
@@ -35,7 +38,13 @@ template <size_t sector_size> class RawSectorDump: public MassStorageDevice {
 		}
 
 		std::vector<uint8_t> get_block(size_t address) final {
-			file_.seek(long(address * sector_size), SEEK_SET);
+			const size_t offset = address * sector_size;
+			if(offset + sector_size <= file_.mapped_size()) {
+				const uint8_t *const block = file_.map() + offset;
+				return std::vector<uint8_t>(block, block + sector_size);
+			}
+
+			file_.seek(long(offset), SEEK_SET);
 			return file_.read(sector_size);
 		}
 
@@ -43,6 +52,9 @@ template <size_t sector_size> class RawSectorDump: public MassStorageDevice {
 			assert(contents.size() == sector_size);
 			file_.seek(long(address * sector_size), SEEK_SET);
 			file_.write(contents);
+
+			// Ensure that the write is visible via the mapping.
+			if(file_.mapped_size()) file_.flush();
 		}
 
 	private:
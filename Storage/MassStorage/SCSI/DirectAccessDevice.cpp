@@ -9,26 +9,57 @@
 #include "DirectAccessDevice.hpp"
 #include "../../../Outputs/Log.hpp"
 
+#include <atomic>
+
 using namespace SCSI;
 
+namespace {
+
+/// Holds the result of a read performed on the I/O queue.
+struct Transfer {
+	std::vector<uint8_t> data;
+	std::atomic<bool> is_complete = false;
+};
+
+}
+
+DirectAccessDevice::~DirectAccessDevice() {
+	// Ensure all writes have reached storage.
+	io_queue_.flush();
+}
+
 void DirectAccessDevice::set_storage(const std::shared_ptr<Storage::MassStorage::MassStorageDevice> &device) {
+	io_queue_.flush();
 	device_ = device;
 }
 
+void DirectAccessDevice::set_access_latency(double seconds) {
+	access_latency_ = seconds;
+}
+
 bool DirectAccessDevice::read(const Target::CommandState &state, Target::Responder &responder) {
 	if(!device_) return false;
 
 	const auto specs = state.read_write_specs();
 	LOG("Read: " << std::dec << specs.number_of_blocks << " from " << specs.address);
 
-	std::vector<uint8_t> output = device_->get_block(specs.address);
-	for(uint32_t offset = 1; offset < specs.number_of_blocks; ++offset) {
-		const auto next_block = device_->get_block(specs.address + offset);
-		std::copy(next_block.begin(), next_block.end(), std::back_inserter(output));
-	}
+	// Fetch on the I/O queue, which will also ensure that any preceding writes are observed.
+	auto transfer = std::make_shared<Transfer>();
+	io_queue_.enqueue([device = device_, specs, transfer] {
+		transfer->data = device->get_block(specs.address);
+		for(uint32_t offset = 1; offset < specs.number_of_blocks; ++offset) {
+			const auto next_block = device->get_block(specs.address + offset);
+			std::copy(next_block.begin(), next_block.end(), std::back_inserter(transfer->data));
+		}
+		transfer->is_complete = true;
+	});
 
-	responder.send_data(std::move(output), [] (const Target::CommandState &, Target::Responder &responder) {
-		responder.terminate_command(Target::Responder::Status::Good);
+	responder.wait(access_latency_, [transfer] {
+		return transfer->is_complete.load();
+	}, [transfer] (const Target::CommandState &, Target::Responder &responder) {
+		responder.send_data(std::move(transfer->data), [] (const Target::CommandState &, Target::Responder &responder) {
+			responder.terminate_command(Target::Responder::Status::Good);
+		});
 	});
 
 	return true;
@@ -41,14 +72,19 @@ bool DirectAccessDevice::write(const Target::CommandState &state, Target::Respon
 	LOG("Write: " << specs.number_of_blocks << " to " << specs.address);
 
 	responder.receive_data(device_->get_block_size() * specs.number_of_blocks, [this, specs] (const Target::CommandState &state, Target::Responder &responder) {
-		const auto received_data = state.received_data();
-		const auto block_size = ssize_t(device_->get_block_size());
-		for(uint32_t offset = 0; offset < specs.number_of_blocks; ++offset) {
-			// TODO: clean up this gross inefficiency when std::span is standard.
-			std::vector<uint8_t> sub_vector(received_data.begin() + ssize_t(offset)*block_size, received_data.begin() + ssize_t(offset+1)*block_size);
-			this->device_->set_block(specs.address + offset, sub_vector);
-		}
-		responder.terminate_command(Target::Responder::Status::Good);
+		// Store on the I/O queue; subsequent reads are queued behind this so will observe it.
+		io_queue_.enqueue([device = device_, specs, received_data = state.received_data()] {
+			const auto block_size = ssize_t(device->get_block_size());
+			for(uint32_t offset = 0; offset < specs.number_of_blocks; ++offset) {
+				// TODO: clean up this gross inefficiency when std::span is standard.
+				std::vector<uint8_t> sub_vector(received_data.begin() + ssize_t(offset)*block_size, received_data.begin() + ssize_t(offset+1)*block_size);
+				device->set_block(specs.address + offset, sub_vector);
+			}
+		});
+
+		responder.wait(access_latency_, nullptr, [] (const Target::CommandState &, Target::Responder &responder) {
+			responder.terminate_command(Target::Responder::Status::Good);
+		});
 	});
 
 	return true;
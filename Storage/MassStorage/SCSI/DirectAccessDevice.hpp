@@ -11,19 +11,36 @@
 
 #include "Target.hpp"
 #include "../MassStorageDevice.hpp"
+#include "../../../Concurrency/AsyncTaskQueue.hpp"
 
 #include <memory>
 
 namespace SCSI {
 
+/*!
+	Exposes a @c MassStorageDevice as a SCSI direct-access device.
+
+	All access to the backing storage occurs serially on a dedicated queue: reads are
+	fetched there while the target holds the bus, then transferred from memory; writes
+	are received into memory and then stored there. The emulation thread therefore never
+	blocks on the host file system. An access latency can also be specified, which is
+	imposed as a minimum delay between receipt of each read or write command and its completion.
+*/
 class DirectAccessDevice: public Target::Executor {
 	public:
+		~DirectAccessDevice();
 
 		/*!
 			Sets the backing storage exposed by this direct-access device.
 		*/
 		void set_storage(const std::shared_ptr<Storage::MassStorage::MassStorageDevice> &device);
 
+		/*!
+			Sets the minimum time, in seconds, that reads and writes will take beyond
+			their data transfer. The default is zero.
+		*/
+		void set_access_latency(double seconds);
+
 		/* SCSI commands. */
 		bool read(const Target::CommandState &, Target::Responder &);
 		bool write(const Target::CommandState &, Target::Responder &);
@@ -33,6 +50,9 @@ class DirectAccessDevice: public Target::Executor {
 
 	private:
 		std::shared_ptr<Storage::MassStorage::MassStorageDevice> device_;
+		double access_latency_ = 0.0;
+
+		Concurrency::AsyncTaskQueue io_queue_;
 };
 
 }
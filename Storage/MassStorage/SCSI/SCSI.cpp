@@ -31,6 +31,7 @@ Bus::Bus(HalfCycles clock_rate) {
 size_t Bus::add_device() {
 	const auto slot = device_states_.size();
 	device_states_.push_back(DefaultBusState);
+	devices_waiting_.push_back(false);
 	return slot;
 }
 
@@ -83,7 +84,17 @@ void Bus::add_observer(Observer *observer) {
 }
 
 ClockingHint::Preference Bus::preferred_clocking() const {
-	return (dispatch_index_ < dispatch_times_.size()) ? ClockingHint::Preference::RealTime : ClockingHint::Preference::None;
+	return (dispatch_index_ < dispatch_times_.size() || waiting_device_count_) ? ClockingHint::Preference::RealTime : ClockingHint::Preference::None;
+}
+
+void Bus::set_device_is_waiting(size_t device, bool is_waiting) {
+	if(devices_waiting_[device] == is_waiting) return;
+
+	const bool was_asleep = preferred_clocking() == ClockingHint::Preference::None;
+	devices_waiting_[device] = is_waiting;
+	waiting_device_count_ += is_waiting ? 1 : size_t(-1);
+	time_since_poll_ = HalfCycles(0);
+	if(was_asleep != (preferred_clocking() == ClockingHint::Preference::None)) update_clocking_observer();
 }
 
 void Bus::update_observers() {
@@ -110,5 +121,14 @@ void Bus::run_for(HalfCycles time) {
 		if(preferred_clocking() == ClockingHint::Preference::None) {
 			update_clocking_observer();
 		}
+	} else if(waiting_device_count_) {
+		// All thresholds have passed but someone is waiting for something else;
+		// poll at the longest of the threshold intervals.
+		time_in_state_ += time;
+		time_since_poll_ += time;
+		if(time_since_poll_.as_integral() >= dispatch_times_.back()) {
+			time_since_poll_ = HalfCycles(0);
+			update_observers();
+		}
 	}
 }
@@ -145,6 +145,44 @@ class Bus: public ClockingHint::Source, public Activity::Source {
 		*/
 		void update_observers();
 
+		/*!
+			Implemented by targets that can exchange data-phase bytes directly with an initiator,
+			each exchange standing in for a complete REQ/ACK handshake. This allows an initiator
+			that is performing DMA to transfer a block without the bus having to propagate each
+			intermediate state.
+		*/
+		struct BulkTransfer {
+			/// @returns @c true if the target is currently requesting a byte, being in
+			/// a data-in phase if @c to_initiator is @c true or a data-out phase otherwise.
+			virtual bool is_requesting_transfer(bool to_initiator) = 0;
+
+			/// Completes the handshake for the byte currently requested in a data-in phase, returning it.
+			virtual uint8_t transfer_to_initiator() = 0;
+
+			/// Completes the handshake for the byte currently requested in a data-out phase, supplying it.
+			virtual void transfer_from_initiator(uint8_t) = 0;
+		};
+
+		/*!
+			Nominates @c transfer as the target currently able to perform bulk transfers, or
+			indicates that none is if @c transfer is @c nullptr.
+		*/
+		void set_bulk_transfer(BulkTransfer *transfer) {
+			bulk_transfer_ = transfer;
+		}
+
+		/// @returns the nominated bulk transfer target, if any.
+		BulkTransfer *bulk_transfer() const {
+			return bulk_transfer_;
+		}
+
+		/*!
+			Sets whether @c device is waiting upon something other than the bus, such as
+			completion of some asynchronous work. While any device is, observers will
+			continue to be notified periodically even if the bus state is unchanged.
+		*/
+		void set_device_is_waiting(size_t device, bool is_waiting);
+
 		// As per ClockingHint::Source.
 		ClockingHint::Preference preferred_clocking() const final;
 
@@ -159,6 +197,12 @@ class Bus: public ClockingHint::Source, public Activity::Source {
 
 		std::vector<BusState> device_states_;
 		BusState state_ = DefaultBusState;
+
+		BulkTransfer *bulk_transfer_ = nullptr;
+
+		std::vector<bool> devices_waiting_;
+		size_t waiting_device_count_ = 0;
+		HalfCycles time_since_poll_;
 		std::vector<Observer *> observers_;
 
 		Activity::Observer *activity_observer_ = nullptr;
@@ -127,6 +127,13 @@ struct Responder {
 		Communicates the supplied message to the initiator.
 	*/
 	virtual void send_message(Message, continuation next) = 0;
+	/*!
+		Holds the bus in its current phase until at least @c delay seconds have passed and
+		@c is_ready, if supplied, returns @c true, then calls @c next. This allows an executor
+		to model the latency of its device and to perform slow work asynchronously; @c is_ready
+		is polled periodically from the thread that is driving the bus.
+	*/
+	virtual void wait(double delay, std::function<bool(void)> is_ready, continuation next) = 0;
 	/*!
 		Ends the SCSI command.
 	*/
@@ -333,7 +340,7 @@ struct Executor {
 	receive and respond to commands. Specific targets should be implemented
 	as Executors.
 */
-template <typename Executor> class Target: public Bus::Observer, public Responder {
+template <typename Executor> class Target: public Bus::Observer, public Bus::BulkTransfer, public Responder {
 	public:
 		/*!
 			Instantiates a target attached to @c bus,
@@ -353,11 +360,17 @@ template <typename Executor> class Target: public Bus::Observer, public Responde
 		// Bus::Observer.
 		void scsi_bus_did_change(Bus *, BusState new_state, double time_since_change) final;
 
+		// Bus::BulkTransfer.
+		bool is_requesting_transfer(bool to_initiator) final;
+		uint8_t transfer_to_initiator() final;
+		void transfer_from_initiator(uint8_t) final;
+
 		// Responder
 		void send_data(std::vector<uint8_t> &&data, continuation next) final;
 		void receive_data(size_t length, continuation next) final;
 		void send_status(Status, continuation next) final;
 		void send_message(Message, continuation next) final;
+		void wait(double delay, std::function<bool(void)> is_ready, continuation next) final;
 		void end_command() final;
 
 		// Instance storage.
@@ -371,8 +384,10 @@ template <typename Executor> class Target: public Bus::Observer, public Responde
 			ReceivingData,
 			SendingData,
 			SendingStatus,
-			SendingMessage
+			SendingMessage,
+			Waiting
 		} phase_ = Phase::AwaitingSelection;
+		void set_phase(Phase);
 		BusState bus_state_ = DefaultBusState;
 
 		void set_device_output(BusState state) {
@@ -392,6 +407,11 @@ template <typename Executor> class Target: public Bus::Observer, public Responde
 		size_t data_pointer_ = 0;
 
 		continuation next_function_;
+		void call_next_function();
+
+		std::function<bool(void)> is_ready_;
+		double wait_remaining_ = 0.0;
+		double time_since_change_ = 0.0;
 };
 
 #include "TargetImplementation.hpp"
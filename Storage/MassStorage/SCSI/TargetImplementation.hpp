@@ -21,12 +21,22 @@ template <typename Executor> void Target<Executor>::scsi_bus_did_change(Bus *, B
 		abort time."
 	*/
 
+	// Note the time elapsed since the previous call, for the benefit of any wait; the time
+	// since change restarts whenever the bus state changes.
+	const double time_elapsed =
+		(time_since_change >= time_since_change_) ? time_since_change - time_since_change_ : time_since_change;
+	time_since_change_ = time_since_change;
+
 	// Wait for deskew, at the very least.
 	if(time_since_change < SCSI::DeskewDelay) return;
 
 	// A reset always takes precedence over anything else ongoing.
 	if(new_state & Line::Reset) {
-		phase_ = Phase::AwaitingSelection;
+		if(phase_ == Phase::Waiting) {
+			is_ready_ = nullptr;
+			bus_.set_device_is_waiting(scsi_bus_device_id_, false);
+		}
+		set_phase(Phase::AwaitingSelection);
 		bus_state_ = DefaultBusState;
 		set_device_output(bus_state_);
 		return;
@@ -43,7 +53,7 @@ template <typename Executor> void Target<Executor>::scsi_bus_did_change(Bus *, B
 				(new_state & scsi_id_mask_) &&
 				((new_state & (Line::SelectTarget | Line::Busy | Line::Input)) == Line::SelectTarget)
 			) {
-				phase_ = Phase::Command;
+				set_phase(Phase::Command);
 				command_.resize(0);
 				command_pointer_ = 0;
 				bus_state_ |= Line::Busy;	// Initiate the command phase: request a command byte.
@@ -108,7 +118,7 @@ template <typename Executor> void Target<Executor>::scsi_bus_did_change(Bus *, B
 
 				case 0:
 					if(data_pointer_ == data_.size()) {
-						next_function_(CommandState(command_, data_), *this);
+						call_next_function();
 					} else {
 						bus_state_ |= Line::Request;
 					}
@@ -133,7 +143,7 @@ template <typename Executor> void Target<Executor>::scsi_bus_did_change(Bus *, B
 						(phase_ == Phase::SendingStatus && data_pointer_ == 1) ||
 						(phase_ == Phase::SendingData && data_pointer_ == data_.size())
 					) {
-						next_function_(CommandState(command_, data_), *this);
+						call_next_function();
 					} else {
 						bus_state_ |= Line::Request;
 						bus_state_ &= ~0xff;
@@ -149,9 +159,79 @@ template <typename Executor> void Target<Executor>::scsi_bus_did_change(Bus *, B
 			}
 			set_device_output(bus_state_);
 		break;
+
+		/*
+			While waiting, the bus is held as it was until the executor's conditions are met.
+		*/
+		case Phase::Waiting:
+			wait_remaining_ -= time_elapsed;
+			if(wait_remaining_ <= 0.0 && (!is_ready_ || is_ready_())) {
+				is_ready_ = nullptr;
+				bus_.set_device_is_waiting(scsi_bus_device_id_, false);
+				call_next_function();
+			}
+		break;
+	}
+}
+
+template <typename Executor> void Target<Executor>::call_next_function() {
+	// The continuation will usually install a successor; take ownership of it first so that
+	// it isn't destroyed while running.
+	const continuation next = std::move(next_function_);
+	next(CommandState(command_, data_), *this);
+}
+
+template <typename Executor> void Target<Executor>::set_phase(Phase phase) {
+	phase_ = phase;
+
+	// Offer bulk transfers only during the data phases.
+	if(phase == Phase::SendingData || phase == Phase::ReceivingData) {
+		bus_.set_bulk_transfer(this);
+	} else if(bus_.bulk_transfer() == this) {
+		bus_.set_bulk_transfer(nullptr);
 	}
 }
 
+// MARK: - Bulk transfers.
+
+template <typename Executor> bool Target<Executor>::is_requesting_transfer(bool to_initiator) {
+	return
+		(bus_state_ & Line::Request) &&
+		phase_ == (to_initiator ? Phase::SendingData : Phase::ReceivingData) &&
+		data_pointer_ < data_.size();
+}
+
+template <typename Executor> uint8_t Target<Executor>::transfer_to_initiator() {
+	const uint8_t value = data_[data_pointer_];
+	++data_pointer_;
+
+	// Either present the next byte, keeping request asserted, or end the phase exactly
+	// as if the final acknowledge had been seen and released.
+	bus_state_ &= ~0xff;
+	if(data_pointer_ == data_.size()) {
+		bus_state_ &= ~Line::Request;
+		set_device_output(bus_state_);
+		call_next_function();
+	} else {
+		bus_state_ |= data_[data_pointer_];
+		set_device_output(bus_state_);
+	}
+	return value;
+}
+
+template <typename Executor> void Target<Executor>::transfer_from_initiator(uint8_t value) {
+	data_[data_pointer_] = value;
+	++data_pointer_;
+
+	if(data_pointer_ == data_.size()) {
+		bus_state_ &= ~Line::Request;
+		set_device_output(bus_state_);
+		call_next_function();
+	}
+}
+
+// MARK: - Command dispatch.
+
 template <typename Executor> void Target<Executor>::begin_command(uint8_t first_byte) {
 	// The logic below is valid for SCSI-1. TODO: other SCSIs.
 	switch(first_byte >> 5) {
@@ -223,7 +303,7 @@ template <typename Executor> void Target<Executor>::send_data(std::vector<uint8_
 	bus_state_ &= ~(Line::Control | Line::Input | Line::Message);
 	bus_state_ |= Line::Input;
 
-	phase_ = Phase::SendingData;
+	set_phase(Phase::SendingData);
 	next_function_ = next;
 	data_ = std::move(data);
 
@@ -235,7 +315,7 @@ template <typename Executor> void Target<Executor>::receive_data(size_t length,
 	// Data out phase: control, input and message all reset.
 	bus_state_ &= ~(Line::Control | Line::Input | Line::Message);
 
-	phase_ = Phase::ReceivingData;
+	set_phase(Phase::ReceivingData);
 	next_function_ = next;
 	data_.resize(length);
 
@@ -249,7 +329,7 @@ template <typename Executor> void Target<Executor>::send_status(Status status, c
 	bus_state_ |= Line::Input | Line::Control;
 
 	status_ = status;
-	phase_ = Phase::SendingStatus;
+	set_phase(Phase::SendingStatus);
 	next_function_ = next;
 
 	data_pointer_ = 0;
@@ -261,18 +341,27 @@ template <typename Executor> void Target<Executor>::send_message(Message message
 	bus_state_ |= Line::Message | Line::Control | Line::Input;
 
 	message_ = message;
-	phase_ = Phase::SendingMessage;
+	set_phase(Phase::SendingMessage);
 	next_function_ = next;
 
 	data_pointer_ = 0;
 	set_device_output(bus_state_);
 }
 
+template <typename Executor> void Target<Executor>::wait(double delay, std::function<bool(void)> is_ready, continuation next) {
+	set_phase(Phase::Waiting);
+	next_function_ = next;
+	is_ready_ = std::move(is_ready);
+	wait_remaining_ = delay;
+
+	bus_.set_device_is_waiting(scsi_bus_device_id_, true);
+}
+
 template <typename Executor> void Target<Executor>::end_command() {
 	// TODO: was this a linked command?
 
 	// Release all bus lines and return to awaiting selection.
-	phase_ = Phase::AwaitingSelection;
+	set_phase(Phase::AwaitingSelection);
 	bus_state_ = DefaultBusState;
 	set_device_output(bus_state_);
 
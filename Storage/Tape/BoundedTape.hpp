@@ -0,0 +1,88 @@
+//
+//  BoundedTape.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 14/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#ifndef BoundedTape_hpp
+#define BoundedTape_hpp
+
+#include "Tape.hpp"
+
+#include <memory>
+
+namespace Storage {
+namespace Tape {
+
+/*!
+	Presents another tape as if it ended once a budget of playing time has been consumed, so that
+	static analysis can stop after the first few blocks of a very long tape.
+
+	Reading this tape advances the underlying tape. Lifting the budget resumes from exactly where it
+	ran out, so a parser that was interrupted can continue seamlessly.
+*/
+class BoundedTape: public Tape {
+	public:
+		/// The default budget, in seconds: enough to reach beyond the first file of almost any tape.
+		static constexpr double AnalysisBudget = 180.0;
+
+		BoundedTape(const std::shared_ptr<Tape> &tape, double budget = AnalysisBudget) : tape_(tape), budget_(budget) {}
+
+		bool is_at_end() final {
+			return tape_->is_at_end() || budget_is_exhausted();
+		}
+
+		/// @returns @c true if this tape appears to have ended only because its budget has been used up.
+		bool budget_is_exhausted() const {
+			return has_budget_ && elapsed_ >= budget_;
+		}
+
+		/// Removes the budget, allowing the remainder of the underlying tape to be read.
+		void remove_budget() {
+			has_budget_ = false;
+		}
+
+	private:
+		std::shared_ptr<Tape> tape_;
+		const double budget_;
+		double elapsed_ = 0.0;
+		bool has_budget_ = true;
+
+		PulseRun virtual_get_next_pulse_run() final {
+			// Take the whole of the underlying tape's current run at once.
+			PulseRun run(tape_->get_next_pulse());
+			const auto remaining = tape_->get_pulses_remaining_in_run();
+			tape_->skip_pulses(remaining);
+			run.count += remaining;
+
+			elapsed_ += run.pulse.length.get<double>() * double(run.count);
+			return run;
+		}
+
+		void virtual_reset() final {
+			tape_->reset();
+			elapsed_ = 0.0;
+		}
+};
+
+/*!
+	Applies @c analyse — any function that accepts a tape and returns a vector of whatever it found — to @c tape
+	under the default budget. If that finds nothing only because the budget ran out then the classification is
+	ambiguous, so @c tape is rewound and @c analyse is applied to the whole of it.
+*/
+template <typename Function> auto AnalyseWithBudget(const std::shared_ptr<Tape> &tape, Function analyse) {
+	const auto bounded = std::make_shared<BoundedTape>(tape);
+	auto result = analyse(std::static_pointer_cast<Tape>(bounded));
+	if(result.empty() && bounded->budget_is_exhausted()) {
+		tape->reset();
+		result = analyse(tape);
+	}
+	return result;
+}
+
+}
+}
+
+#endif /* BoundedTape_hpp */
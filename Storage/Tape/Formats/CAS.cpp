@@ -179,6 +179,24 @@ void CAS::virtual_reset() {
 	distance_into_bit_ = 0;
 }
 
+Tape::PulseRun CAS::virtual_get_next_pulse_run() {
+	if(phase_ != Phase::Header) {
+		return PulseRun(virtual_get_next_pulse());
+	}
+
+	// The remainder of a header is a single run of alternating short pulses, of which there are
+	// two per bit; supply all of it at once.
+	const std::size_t header_length = chunks_[chunk_pointer_].long_header ? 31744 : 7936;
+	const auto count = unsigned((header_length - distance_into_phase_) * 2 - distance_into_bit_);
+	const auto type = distance_into_bit_ ? Pulse::Type::Low : Pulse::Type::High;
+
+	phase_ = Phase::Bytes;
+	distance_into_phase_ = 0;
+	distance_into_bit_ = 0;
+
+	return PulseRun(Pulse(type, Time(1, 9600)), count);
+}
+
 Tape::Pulse CAS::virtual_get_next_pulse() {
 	Pulse pulse;
 	pulse.length.clock_rate = 9600;
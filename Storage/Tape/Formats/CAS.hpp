@@ -40,6 +40,7 @@ class CAS: public Tape {
 
 	private:
 		void virtual_reset();
+		PulseRun virtual_get_next_pulse_run();
 		Pulse virtual_get_next_pulse();
 
 		// Storage for the array of data blobs to transcribe into audio;
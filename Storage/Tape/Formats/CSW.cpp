@@ -84,11 +84,14 @@ CSW::CSW(const std::string &file_name) :
 	}
 
 	invert_pulse();
+	initial_type_ = pulse_.type;
 }
 
-CSW::CSW(const std::vector<uint8_t> &&data, CompressionType compression_type, bool initial_level, uint32_t sampling_rate) : compression_type_(compression_type) {
+CSW::CSW(const std::vector<uint8_t> &&data, CompressionType compression_type, bool initial_level, uint32_t sampling_rate) :
+	compression_type_(compression_type), source_data_pointer_(0) {
 	pulse_.length.clock_rate = sampling_rate;
 	pulse_.type = initial_level ? Pulse::High : Pulse::Low;
+	initial_type_ = pulse_.type;
 	source_data_ = std::move(data);
 }
 
@@ -120,11 +123,42 @@ bool CSW::is_at_end() {
 
 void CSW::virtual_reset() {
 	source_data_pointer_ = 0;
+
+	// Pulse levels are implied by alternation, so the level that preceded the first
+	// pulse needs to be restored too.
+	pulse_.type = initial_type_;
+}
+
+bool CSW::is_indexable() const {
+	return true;
+}
+
+bool CSW::get_checkpoint(Checkpoint &checkpoint) {
+	checkpoint.position = source_data_pointer_;
+	checkpoint.state = pulse_.type;
+	return true;
 }
 
-Tape::Pulse CSW::virtual_get_next_pulse() {
+void CSW::set_checkpoint(const Checkpoint &checkpoint) {
+	source_data_pointer_ = std::size_t(checkpoint.position);
+	pulse_.type = Pulse::Type(checkpoint.state);
+}
+
+Tape::PulseRun CSW::virtual_get_next_pulse_run() {
 	invert_pulse();
 	pulse_.length.length = get_next_byte();
 	if(!pulse_.length.length) pulse_.length.length = get_next_int32le();
-	return pulse_;
+
+	// Gather any immediately-following pulses of the same length into the same run;
+	// levels alternate implicitly.
+	PulseRun run(pulse_);
+	while(
+		source_data_pointer_ < source_data_.size() &&
+		source_data_[source_data_pointer_] == pulse_.length.length
+	) {
+		++source_data_pointer_;
+		++run.count;
+		invert_pulse();
+	}
+	return run;
 }
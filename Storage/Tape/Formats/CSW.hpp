@@ -49,9 +49,14 @@ class CSW: public Tape {
 
 	private:
 		void virtual_reset();
-		Pulse virtual_get_next_pulse();
+		PulseRun virtual_get_next_pulse_run();
+
+		bool is_indexable() const final;
+		bool get_checkpoint(Checkpoint &) final;
+		void set_checkpoint(const Checkpoint &) final;
 
 		Pulse pulse_;
+		Pulse::Type initial_type_;
 		CompressionType compression_type_;
 
 		uint8_t get_next_byte();
@@ -49,6 +49,23 @@ bool CommodoreTAP::is_at_end() {
 	return is_at_end_;
 }
 
+bool CommodoreTAP::is_indexable() const {
+	return true;
+}
+
+bool CommodoreTAP::get_checkpoint(Checkpoint &checkpoint) {
+	// Each wave is a low pulse then a high; it's resumable only before the low.
+	if(current_pulse_.type != Pulse::High || is_at_end_) return false;
+	checkpoint.position = uint64_t(file_.tell());
+	return true;
+}
+
+void CommodoreTAP::set_checkpoint(const Checkpoint &checkpoint) {
+	file_.seek(long(checkpoint.position), SEEK_SET);
+	current_pulse_.type = Pulse::High;
+	is_at_end_ = false;
+}
+
 Storage::Tape::Tape::Pulse CommodoreTAP::virtual_get_next_pulse() {
 	if(is_at_end_) {
 		return current_pulse_;
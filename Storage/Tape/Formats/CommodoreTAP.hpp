@@ -42,6 +42,10 @@ class CommodoreTAP: public Tape {
 		void virtual_reset();
 		Pulse virtual_get_next_pulse();
 
+		bool is_indexable() const final;
+		bool get_checkpoint(Checkpoint &) final;
+		void set_checkpoint(const Checkpoint &) final;
+
 		bool updated_layout_;
 		uint32_t file_size_;
 
@@ -48,6 +48,26 @@ void TZX::virtual_reset() {
 	post_gap(500);
 }
 
+bool TZX::is_indexable() const {
+	return true;
+}
+
+bool TZX::get_checkpoint(Checkpoint &checkpoint) {
+	// Only block boundaries are resumable, i.e. points at which all pulses from
+	// the previous block have been supplied.
+	if(!is_queue_exhausted() || is_at_end()) return false;
+	checkpoint.position = uint64_t(file_.tell());
+	checkpoint.state = current_level_;
+	return true;
+}
+
+void TZX::set_checkpoint(const Checkpoint &checkpoint) {
+	clear();
+	set_is_at_end(false);
+	file_.seek(long(checkpoint.position), SEEK_SET);
+	current_level_ = checkpoint.state;
+}
+
 void TZX::get_next_pulses() {
 	while(empty()) {
 		uint8_t chunk_id = file_.get8();
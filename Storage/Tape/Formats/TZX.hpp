@@ -39,6 +39,10 @@ class TZX: public PulseQueuedTape {
 		void virtual_reset();
 		void get_next_pulses();
 
+		bool is_indexable() const final;
+		bool get_checkpoint(Checkpoint &) final;
+		void set_checkpoint(const Checkpoint &) final;
+
 		bool current_level_;
 
 		void get_standard_speed_data_block();
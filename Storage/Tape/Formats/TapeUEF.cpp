@@ -87,7 +87,7 @@ UEF::UEF(const std::string &file_name) {
 		throw ErrorNotUEF;
 	}
 
-	set_platform_type();
+	inspect_chunks();
 }
 
 UEF::~UEF() {
@@ -100,6 +100,26 @@ void UEF::virtual_reset() {
 	gzseek(file_, 12, SEEK_SET);
 	set_is_at_end(false);
 	clear();
+
+	is_supplying_bits_ = false;
+	queued_bits_.clear();
+	bit_pointer_ = 0;
+}
+
+bool UEF::get_next_bits(Bits &bits) {
+	is_supplying_bits_ = true;
+	while(bit_pointer_ == queued_bits_.size()) {
+		queued_bits_.clear();
+		bit_pointer_ = 0;
+		if(!parse_next_chunk()) {
+			set_is_at_end(true);
+			return false;
+		}
+	}
+
+	bits = queued_bits_[bit_pointer_];
+	++bit_pointer_;
+	return true;
 }
 
 // MARK: - Chunk navigator
@@ -120,48 +140,76 @@ bool UEF::get_next_chunk(UEF::Chunk &result) {
 	return true;
 }
 
+bool UEF::is_indexable() const {
+	return true;
+}
+
+bool UEF::get_checkpoint(Checkpoint &checkpoint) {
+	// Only chunk boundaries are resumable. Note that gzseek is itself linear when seeking
+	// backwards, but decompression is substantially cheaper than regenerating pulses.
+	if(!is_queue_exhausted() || is_at_end()) return false;
+	checkpoint.position = uint64_t(gztell(file_));
+	checkpoint.state = uint64_t(time_base_) | (is_300_baud_ ? uint64_t(1) << 32 : 0);
+	return true;
+}
+
+void UEF::set_checkpoint(const Checkpoint &checkpoint) {
+	gzseek(file_, z_off_t(checkpoint.position), SEEK_SET);
+	time_base_ = unsigned(checkpoint.state);
+	is_300_baud_ = checkpoint.state >> 32;
+	set_is_at_end(false);
+	clear();
+}
+
 void UEF::get_next_pulses() {
 	while(empty()) {
-		// read chunk details
-		Chunk next_chunk;
-		if(!get_next_chunk(next_chunk)) {
+		if(!parse_next_chunk()) {
 			set_is_at_end(true);
 			return;
 		}
+	}
+}
 
-		switch(next_chunk.id) {
-			case 0x0100:	queue_implicit_bit_pattern(next_chunk.length);	break;
-			case 0x0102:	queue_explicit_bit_pattern(next_chunk.length);	break;
-			case 0x0112:	queue_integer_gap();							break;
-			case 0x0116:	queue_floating_point_gap();						break;
+bool UEF::parse_next_chunk() {
+	// read chunk details
+	Chunk next_chunk;
+	if(!get_next_chunk(next_chunk)) {
+		return false;
+	}
 
-			case 0x0110:	queue_carrier_tone();							break;
-			case 0x0111:	queue_carrier_tone_with_dummy();				break;
+	switch(next_chunk.id) {
+		case 0x0100:	queue_implicit_bit_pattern(next_chunk.length);	break;
+		case 0x0102:	queue_explicit_bit_pattern(next_chunk.length);	break;
+		case 0x0112:	queue_integer_gap();							break;
+		case 0x0116:	queue_floating_point_gap();						break;
 
-			case 0x0114:	queue_security_cycles();						break;
-			case 0x0104:	queue_defined_data(next_chunk.length);			break;
+		case 0x0110:	queue_carrier_tone();							break;
+		case 0x0111:	queue_carrier_tone_with_dummy();				break;
 
-			// change of base rate
-			case 0x0113: {
-				// TODO: something smarter than just converting this to an int
-				const float new_time_base = gzgetfloat(file_);
-				time_base_ = unsigned(roundf(new_time_base));
-			}
-			break;
+		case 0x0114:	queue_security_cycles();						break;
+		case 0x0104:	queue_defined_data(next_chunk.length);			break;
 
-			case 0x0117: {
-				const int baud_rate = gzget16(file_);
-				is_300_baud_ = (baud_rate == 300);
-			}
-			break;
+		// change of base rate
+		case 0x0113: {
+			// TODO: something smarter than just converting this to an int
+			const float new_time_base = gzgetfloat(file_);
+			time_base_ = unsigned(roundf(new_time_base));
+		}
+		break;
 
-			default:
-				LOG("Skipping chunk of type " << PADHEX(4) << next_chunk.id);
-			break;
+		case 0x0117: {
+			const int baud_rate = gzget16(file_);
+			is_300_baud_ = (baud_rate == 300);
 		}
+		break;
 
-		gzseek(file_, next_chunk.start_of_next_chunk, SEEK_SET);
+		default:
+			LOG("Skipping chunk of type " << PADHEX(4) << next_chunk.id);
+		break;
 	}
+
+	gzseek(file_, next_chunk.start_of_next_chunk, SEEK_SET);
+	return true;
 }
 
 // MARK: - Chunk parsers
@@ -186,7 +234,7 @@ void UEF::queue_integer_gap() {
 	Time duration;
 	duration.length = unsigned(gzget16(file_));
 	duration.clock_rate = time_base_;
-	emplace_back(Pulse::Zero, duration);
+	queue_gap(duration);
 }
 
 void UEF::queue_floating_point_gap() {
@@ -194,7 +242,7 @@ void UEF::queue_floating_point_gap() {
 	Time duration;
 	duration.length = unsigned(length * 4000000);
 	duration.clock_rate = 4000000;
-	emplace_back(Pulse::Zero, duration);
+	queue_gap(duration);
 }
 
 void UEF::queue_carrier_tone() {
@@ -225,7 +273,9 @@ void UEF::queue_security_cycles() {
 		duration.length = bit ? 1 : 2;
 		duration.clock_rate = time_base_ * 4;
 
-		if(!cycle && first_is_pulse) {
+		if(is_supplying_bits_) {
+			queue_gap(duration * ((first_is_pulse && !cycle) || (last_is_pulse && cycle == number_of_cycles-1) ? 1u : 2u));
+		} else if(!cycle && first_is_pulse) {
 			emplace_back(Pulse::High, duration);
 		} else if(cycle == number_of_cycles-1 && last_is_pulse) {
 			emplace_back(Pulse::Low, duration);
@@ -274,8 +324,12 @@ void UEF::queue_defined_data(uint32_t length) {
 			Time duration;
 			duration.length = 1;
 			duration.clock_rate = time_base_ * 4;
-			emplace_back(Pulse::Low, duration);
-			emplace_back(Pulse::High, duration);
+			if(is_supplying_bits_) {
+				queue_gap(duration * 2u);
+			} else {
+				emplace_back(Pulse::Low, duration);
+				emplace_back(Pulse::High, duration);
+			}
 		}
 	}
 }
@@ -292,7 +346,37 @@ void UEF::queue_implicit_byte(uint8_t byte) {
 	queue_bit(1);
 }
 
+void UEF::queue_gap(Time length) {
+	if(is_supplying_bits_) {
+		Bits gap;
+		gap.length = length;
+		queued_bits_.push_back(gap);
+		return;
+	}
+	emplace_back(Pulse::Zero, length);
+}
+
 void UEF::queue_bit(int bit) {
+	if(is_supplying_bits_) {
+		// Append to the current run if it has space and bits of this length, otherwise begin a new one.
+		const Time length(is_300_baud_ ? 4u : 1u, time_base_);
+		if(
+			queued_bits_.size() == bit_pointer_ ||
+			!queued_bits_.back().count ||
+			queued_bits_.back().count == 16 ||
+			!(queued_bits_.back().length == length)
+		) {
+			Bits bits;
+			bits.length = length;
+			queued_bits_.push_back(bits);
+		}
+
+		Bits &bits = queued_bits_.back();
+		bits.value |= uint16_t(bit << bits.count);
+		++bits.count;
+		return;
+	}
+
 	int number_of_cycles;
 	Time duration;
 	duration.clock_rate = time_base_ * 4;
@@ -321,11 +405,16 @@ TargetPlatform::Type UEF::target_platform_type() {
 	return platform_type_;
 }
 
-void UEF::set_platform_type() {
+void UEF::inspect_chunks() {
 	// If a chunk of type 0005 exists anywhere in the UEF then the UEF specifies its target machine.
 	// So check and, if so, update the list of machines for which this file thinks it is suitable.
+	//
+	// Also note whether there are security cycles, which can't be supplied as bits.
 	Chunk next_chunk;
 	while(get_next_chunk(next_chunk)) {
+		if(next_chunk.id == 0x0114) {
+			can_supply_bits_ = false;
+		}
 		if(next_chunk.id == 0x0005) {
 			uint8_t target = gzget8(file_);
 			switch(target >> 4) {
@@ -15,6 +15,7 @@
 
 #include <cstdint>
 #include <string>
+#include <vector>
 #include <zlib.h>
 
 namespace Storage {
@@ -37,10 +38,37 @@ class UEF : public PulseQueuedTape, public TargetPlatform::TypeDistinguisher {
 			ErrorNotUEF
 		};
 
+		/*!
+			A run of serially-encoded bits as recorded on tape, each of duration @c length; or,
+			if @c count is zero, a gap of duration @c length.
+		*/
+		struct Bits {
+			/// The bits in the order recorded, from the least significant.
+			uint16_t value = 0;
+			int count = 0;
+			Time length;
+		};
+
+		/// @returns @c true if this tape's content can be supplied in full via @c get_next_bits.
+		bool can_supply_bits() const {
+			return can_supply_bits_;
+		}
+
+		/*!
+			Supplies the next portion of this tape as bits rather than as pulses, for machines that
+			receive data at that level. Once this has been called the tape should be consumed only
+			via this function until it is next reset.
+
+			Content that can't be expressed as bits, such as security cycles, is supplied as gaps.
+
+			@returns @c true if @c bits was filled in; @c false if the tape has ended.
+		*/
+		bool get_next_bits(Bits &bits);
+
 	private:
 		void virtual_reset();
 
-		void set_platform_type();
+		void inspect_chunks();
 		TargetPlatform::Type target_platform_type();
 		TargetPlatform::Type platform_type_ = TargetPlatform::Acorn;
 
@@ -55,8 +83,18 @@ class UEF : public PulseQueuedTape, public TargetPlatform::TypeDistinguisher {
 		};
 
 		bool get_next_chunk(Chunk &);
+		bool parse_next_chunk();
 		void get_next_pulses();
 
+		bool can_supply_bits_ = true;
+		bool is_supplying_bits_ = false;
+		std::vector<Bits> queued_bits_;
+		std::size_t bit_pointer_ = 0;
+
+		bool is_indexable() const final;
+		bool get_checkpoint(Checkpoint &) final;
+		void set_checkpoint(const Checkpoint &) final;
+
 		void queue_implicit_bit_pattern(uint32_t length);
 		void queue_explicit_bit_pattern(uint32_t length);
 
@@ -71,6 +109,7 @@ class UEF : public PulseQueuedTape, public TargetPlatform::TypeDistinguisher {
 
 		void queue_bit(int bit);
 		void queue_implicit_byte(uint8_t byte);
+		void queue_gap(Time length);
 };
 
 }
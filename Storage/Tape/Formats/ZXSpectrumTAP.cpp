@@ -46,6 +46,19 @@ void ZXSpectrumTAP::virtual_reset() {
 	read_next_block();
 }
 
+Tape::PulseRun ZXSpectrumTAP::virtual_get_next_pulse_run() {
+	// Supply whatever remains of a pilot tone, prior to its sync pulses, as a single run.
+	const int pilot_length = (block_type_ ? 8063 : 3223) - 1;
+	if(phase_ == Phase::PilotTone && distance_into_phase_ < pilot_length) {
+		const auto type = (distance_into_phase_ & 1) ? Pulse::Type::High : Pulse::Type::Low;
+		const auto count = unsigned(pilot_length - distance_into_phase_);
+		distance_into_phase_ = pilot_length;
+		return PulseRun(Pulse(type, Time(271, 437'500)), count);
+	}
+
+	return PulseRun(virtual_get_next_pulse());
+}
+
 Tape::Pulse ZXSpectrumTAP::virtual_get_next_pulse() {
 	// Adopt a general pattern of high then low.
 	Pulse pulse;
@@ -52,6 +52,7 @@ class ZXSpectrumTAP: public Tape {
 		// Implemented to satisfy @c Tape.
 		bool is_at_end() override;
 		void virtual_reset() override;
+		PulseRun virtual_get_next_pulse_run() override;
 		Pulse virtual_get_next_pulse() override;
 };
 
@@ -29,11 +29,35 @@ bool PulseQueuedTape::empty() {
 	return queued_pulses_.empty();
 }
 
+bool PulseQueuedTape::is_queue_exhausted() const {
+	return pulse_pointer_ == queued_pulses_.size();
+}
+
 void PulseQueuedTape::emplace_back(Tape::Pulse::Type type, Time length) {
-	queued_pulses_.emplace_back(type, length);
+	emplace_back(Pulse(type, length));
 }
 
 void PulseQueuedTape::emplace_back(const Tape::Pulse &&pulse) {
+	// Extend the final run if this pulse continues it.
+	if(queued_pulses_.size() > pulse_pointer_) {
+		PulseRun &run = queued_pulses_.back();
+		if(
+			run.pulse.length.length == pulse.length.length &&
+			run.pulse.length.clock_rate == pulse.length.clock_rate
+		) {
+			const bool ends_high = (run.pulse.type == Pulse::High) == bool(run.count & 1);
+			const bool continues_run =
+				(run.pulse.type == Pulse::Zero) ?
+					pulse.type == Pulse::Zero :
+					pulse.type == (ends_high ? Pulse::Low : Pulse::High);
+
+			if(continues_run) {
+				++run.count;
+				return;
+			}
+		}
+	}
+
 	queued_pulses_.emplace_back(pulse);
 }
 
@@ -45,7 +69,7 @@ Tape::Pulse PulseQueuedTape::silence() {
 	return silence;
 }
 
-Tape::Pulse PulseQueuedTape::virtual_get_next_pulse() {
+Tape::PulseRun PulseQueuedTape::virtual_get_next_pulse_run() {
 	if(is_at_end_) {
 		return silence();
 	}
@@ -24,6 +24,8 @@ namespace Tape {
 	Otherwise get_next_pulse() returns something from the pulse queue if there is
 	anything there, and otherwise calls get_next_pulses(). get_next_pulses() is
 	virtual, giving subclasses a chance to provide the next batch of pulses.
+
+	Consecutive pulses of equal length and alternating level are queued as a single run.
 */
 class PulseQueuedTape: public Tape {
 	public:
@@ -36,14 +38,17 @@ class PulseQueuedTape: public Tape {
 		void clear();
 		bool empty();
 
+		/// @returns @c true if all queued pulses have been supplied, i.e. the next will come from @c get_next_pulses.
+		bool is_queue_exhausted() const;
+
 		void set_is_at_end(bool);
 		virtual void get_next_pulses() = 0;
 
 	private:
-		Pulse virtual_get_next_pulse();
+		PulseRun virtual_get_next_pulse_run();
 		Pulse silence();
 
-		std::vector<Pulse> queued_pulses_;
+		std::vector<PulseRun> queued_pulses_;
 		std::size_t pulse_pointer_;
 		bool is_at_end_;
 };
@@ -8,6 +8,10 @@
 
 #include "Tape.hpp"
 
+#include <algorithm>
+#include <cassert>
+#include <limits>
+
 using namespace Storage::Tape;
 
 // MARK: - Lifecycle
@@ -19,8 +23,20 @@ TapePlayer::TapePlayer(int input_clock_rate) :
 // MARK: - Seeking
 
 void Storage::Tape::Tape::seek(Time &seek_time) {
+	build_index();
+
+	// Start from the final indexed position that is no later than seek_time, if any.
 	Time next_time(0);
-	reset();
+	const auto entry = std::upper_bound(index_.begin(), index_.end(), seek_time, [] (const Time &time, const IndexEntry &entry) {
+		return time < entry.time;
+	});
+	if(entry == index_.begin()) {
+		reset();
+	} else {
+		restore(*(entry - 1));
+		next_time = (entry - 1)->time;
+	}
+
 	while(next_time <= seek_time) {
 		get_next_pulse();
 		next_time += pulse_.length;
@@ -30,7 +46,19 @@ void Storage::Tape::Tape::seek(Time &seek_time) {
 Storage::Time Tape::get_current_time() {
 	Time time(0);
 	uint64_t steps = get_offset();
-	reset();
+	build_index();
+
+	const auto entry = std::upper_bound(index_.begin(), index_.end(), steps, [] (uint64_t offset, const IndexEntry &entry) {
+		return offset < entry.offset;
+	});
+	if(entry == index_.begin()) {
+		reset();
+	} else {
+		restore(*(entry - 1));
+		time = (entry - 1)->time;
+		steps -= (entry - 1)->offset;
+	}
+
 	while(steps--) {
 		get_next_pulse();
 		time += pulse_.length;
@@ -38,28 +66,99 @@ Storage::Time Tape::get_current_time() {
 	return time;
 }
 
+void Tape::build_index() {
+	if(index_is_built_) return;
+	index_is_built_ = true;
+	if(!is_indexable()) return;
+
+	// Walk the entire tape, noting a checkpoint whenever possible at
+	// intervals of no fewer than IndexSpacing pulses.
+	reset();
+	Time time(0);
+	uint64_t next_entry = 0;
+	while(!is_at_end()) {
+		Checkpoint checkpoint;
+		if(!pulses_remaining_in_run_ && offset_ >= next_entry && get_checkpoint(checkpoint)) {
+			index_.push_back(IndexEntry{time, offset_, checkpoint});
+			next_entry = offset_ + IndexSpacing;
+		}
+
+		get_next_pulse();
+		time += pulse_.length;
+	}
+	reset();
+}
+
+void Tape::restore(const IndexEntry &entry) {
+	set_checkpoint(entry.checkpoint);
+	offset_ = entry.offset;
+	pulses_remaining_in_run_ = 0;
+}
+
 void Storage::Tape::Tape::reset() {
 	offset_ = 0;
+	pulses_remaining_in_run_ = 0;
 	virtual_reset();
 }
 
 Tape::Pulse Tape::get_next_pulse() {
-	pulse_ = virtual_get_next_pulse();
+	if(pulses_remaining_in_run_) {
+		--pulses_remaining_in_run_;
+		if(pulse_.type != Pulse::Zero) {
+			pulse_.type = (pulse_.type == Pulse::High) ? Pulse::Low : Pulse::High;
+		}
+	} else {
+		const PulseRun run = virtual_get_next_pulse_run();
+		pulse_ = run.pulse;
+		pulses_remaining_in_run_ = run.count ? run.count - 1 : 0;
+	}
 	offset_++;
 	return pulse_;
 }
 
+void Tape::skip_pulses(unsigned int count) {
+	assert(count <= pulses_remaining_in_run_);
+	pulses_remaining_in_run_ -= count;
+	offset_ += count;
+	if((count & 1) && pulse_.type != Pulse::Zero) {
+		pulse_.type = (pulse_.type == Pulse::High) ? Pulse::Low : Pulse::High;
+	}
+}
+
 uint64_t Tape::get_offset() {
 	return offset_;
 }
 
 void Tape::set_offset(uint64_t offset) {
 	if(offset == offset_) return;
+
+	// Rewinding is a trigger to build the index if it doesn't yet exist; if it does exist then
+	// also use it to skip forwards.
 	if(offset < offset_) {
+		build_index();
+	}
+
+	// Move to the final indexed position that isn't beyond offset, if any and if it's
+	// either behind the current position or an improvement upon it.
+	const auto entry = std::upper_bound(index_.begin(), index_.end(), offset, [] (uint64_t offset, const IndexEntry &entry) {
+		return offset < entry.offset;
+	});
+	if(entry != index_.begin() && ((entry - 1)->offset > offset_ || offset < offset_)) {
+		restore(*(entry - 1));
+	} else if(offset < offset_) {
 		reset();
 	}
 	offset -= offset_;
-	while(offset--) get_next_pulse();
+	while(offset) {
+		const auto skip = unsigned(std::min(offset, uint64_t(pulses_remaining_in_run_)));
+		if(skip) {
+			skip_pulses(skip);
+			offset -= skip;
+		} else {
+			get_next_pulse();
+			--offset;
+		}
+	}
 }
 
 // MARK: - Player
@@ -84,17 +183,21 @@ bool TapePlayer::has_tape() {
 }
 
 void TapePlayer::get_next_pulse() {
+	fetch_next_pulse();
+	set_next_event_time_interval(current_pulse_.length);
+}
+
+void TapePlayer::fetch_next_pulse() {
 	// get the new pulse
 	if(tape_) {
 		current_pulse_ = tape_->get_next_pulse();
+		current_pulse_offset_ = tape_->get_offset();
 		if(tape_->is_at_end()) update_clocking_observer();
 	} else {
 		current_pulse_.length.length = 1;
 		current_pulse_.length.clock_rate = 1;
 		current_pulse_.type = Tape::Pulse::Zero;
 	}
-
-	set_next_event_time_interval(current_pulse_.length);
 }
 
 Tape::Pulse TapePlayer::get_current_pulse() {
@@ -107,10 +210,40 @@ void TapePlayer::complete_pulse() {
 
 void TapePlayer::run_for(const Cycles cycles) {
 	if(has_tape()) {
-		TimedEventLoop::run_for(cycles);
+		auto remaining = cycles.as_integral();
+		if(get_cycles_until_next_event() < remaining && can_skip_pulses()) {
+			skip_pulses(remaining);
+		}
+		TimedEventLoop::run_for(Cycles(remaining));
 	}
 }
 
+void TapePlayer::skip_pulses(Cycles::IntType &cycles) {
+	// Only the tape's own record of the run is meaningful, and only if the current pulse is the one
+	// it most recently returned; someone else may have read ahead directly from the tape.
+	if(current_pulse_offset_ != tape_->get_offset()) return;
+	const auto remaining_in_run = tape_->get_pulses_remaining_in_run();
+	if(!remaining_in_run) return;
+
+	// Skip every pulse in the run that will complete within this period other than the last,
+	// which is still processed so that its effect is retained.
+	const int elapsed = skip_events(
+		cycles,
+		current_pulse_.length,
+		int(std::min(remaining_in_run, unsigned(std::numeric_limits<int>::max()))));
+	if(!elapsed) return;
+
+	Tape::Pulse last_pulse = current_pulse_;
+	if(!(elapsed & 1) && last_pulse.type != Tape::Pulse::Zero) {
+		last_pulse.type = (last_pulse.type == Tape::Pulse::High) ? Tape::Pulse::Low : Tape::Pulse::High;
+	}
+	process_input_pulse(last_pulse);
+
+	// The next pulse has been scheduled already, so is obtained without affecting timing.
+	tape_->skip_pulses(unsigned(elapsed - 1));
+	fetch_next_pulse();
+}
+
 void TapePlayer::run_for_input_pulse() {
 	jump_to_next_event();
 }
@@ -170,6 +303,11 @@ void BinaryTapePlayer::set_delegate(Delegate *delegate) {
 	delegate_ = delegate;
 }
 
+bool BinaryTapePlayer::can_skip_pulses() const {
+	// Without a delegate, the input level is observable only between calls to run_for.
+	return !delegate_;
+}
+
 void BinaryTapePlayer::process_input_pulse(const Storage::Tape::Tape::Pulse &pulse) {
 	bool new_input_level = pulse.type == Tape::Pulse::High;
 	if(input_level_ != new_input_level) {
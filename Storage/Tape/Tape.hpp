@@ -10,6 +10,7 @@
 #define Tape_hpp
 
 #include <memory>
+#include <vector>
 
 #include "../../ClockReceiver/ClockReceiver.hpp"
 #include "../../ClockReceiver/ClockingHintSource.hpp"
@@ -31,6 +32,15 @@ namespace Tape {
 	Subclasses should implement at least @c get_next_pulse and @c reset to provide a serial feeding
 	of pulses and the ability to return to the start of the feed. They may also implement @c seek if
 	a better implementation than a linear search from the @c reset time can be implemented.
+
+	Subclasses that can describe runs of pulses of identical length, such as pilot tones, may instead
+	implement @c virtual_get_next_pulse_run; runs are then expanded here so that each is a single
+	virtual call regardless of its length, and users of the tape can skip through them in bulk.
+
+	Subclasses that can capture and later restore their position may implement @c is_indexable,
+	@c get_checkpoint and @c set_checkpoint. Upon first need an index of such positions is built,
+	after which @c seek, @c get_current_time and rewinding via @c set_offset use a binary search
+	of that index and then proceed linearly only from the nearest preceding checkpoint.
 */
 class Tape {
 	public:
@@ -44,6 +54,19 @@ class Tape {
 			Pulse() {}
 		};
 
+		/*!
+			Describes @c count consecutive pulses, all of the same length as @c pulse. If @c pulse is
+			of type Zero then all are Zero; otherwise types alternate between High and Low, starting
+			with the type of @c pulse.
+		*/
+		struct PulseRun {
+			Pulse pulse;
+			unsigned int count = 1;
+
+			PulseRun(const Pulse &pulse, unsigned int count = 1) : pulse(pulse), count(count) {}
+			PulseRun() {}
+		};
+
 		/*!
 			If at the start of the tape returns the first stored pulse. Otherwise advances past
 			the last-returned pulse and returns the next.
@@ -52,6 +75,20 @@ class Tape {
 		*/
 		Pulse get_next_pulse();
 
+		/*!
+			@returns the number of pulses that will follow the last-returned one as part of the same run,
+			i.e. with the same length and with types alternating if High or Low, or remaining Zero.
+		*/
+		unsigned int get_pulses_remaining_in_run() const {
+			return pulses_remaining_in_run_;
+		}
+
+		/*!
+			Advances past @c count pulses from the current run, without returning them. @c count
+			should not exceed the value returned by @c get_pulses_remaining_in_run.
+		*/
+		void skip_pulses(unsigned int count);
+
 		/// Returns the tape to the beginning.
 		void reset();
 
@@ -82,11 +119,67 @@ class Tape {
 
 		virtual ~Tape() {};
 
+	protected:
+		/// Describes a format-specific position from which playback can resume.
+		struct Checkpoint {
+			uint64_t position = 0;
+			uint64_t state = 0;
+		};
+
 	private:
 		uint64_t offset_;
 		Tape::Pulse pulse_;
+		unsigned int pulses_remaining_in_run_ = 0;
+
+		/// @returns @c true if this tape implements @c get_checkpoint and @c set_checkpoint.
+		virtual bool is_indexable() const {
+			return false;
+		}
+
+		/*!
+			If the tape is currently at a position from which playback could be resumed, fills in @c checkpoint
+			and returns @c true; otherwise returns @c false. This is called only between pulse runs, i.e. with
+			the tape's state being that immediately prior to the next call to @c virtual_get_next_pulse_run.
+		*/
+		virtual bool get_checkpoint([[maybe_unused]] Checkpoint &checkpoint) {
+			return false;
+		}
+
+		/// Restores a position previously described by @c get_checkpoint.
+		virtual void set_checkpoint([[maybe_unused]] const Checkpoint &checkpoint) {}
+
+		/// The maximum number of pulses between entries in the index, subject to availability of checkpoints.
+		static constexpr uint64_t IndexSpacing = 4096;
+
+		struct IndexEntry {
+			/// The total length of all pulses prior to this entry.
+			Time time;
+			/// The number of pulses prior to this entry.
+			uint64_t offset;
+			Checkpoint checkpoint;
+		};
+		std::vector<IndexEntry> index_;
+		bool index_is_built_ = false;
+
+		void build_index();
+		void restore(const IndexEntry &);
+
+		/*!
+			Supplies the next pulse. Subclasses that override @c virtual_get_next_pulse_run need not
+			implement this.
+		*/
+		virtual Pulse virtual_get_next_pulse() {
+			return Pulse(Pulse::Zero, Time(1));
+		}
+
+		/*!
+			Supplies the next run of pulses; the default implementation is a run of one, from
+			@c virtual_get_next_pulse.
+		*/
+		virtual PulseRun virtual_get_next_pulse_run() {
+			return PulseRun(virtual_get_next_pulse());
+		}
 
-		virtual Pulse virtual_get_next_pulse() = 0;
 		virtual void virtual_reset() = 0;
 };
 
@@ -119,11 +212,23 @@ class TapePlayer: public TimedEventLoop, public ClockingHint::Source {
 		virtual void process_next_event() override;
 		virtual void process_input_pulse(const Tape::Pulse &pulse) = 0;
 
+		/*!
+			Indicates whether only the final pulse of a series need be supplied to @c process_input_pulse
+			if several complete within a single call to @c run_for. If so then runs of identical pulses
+			are advanced through arithmetically rather than pulse by pulse.
+		*/
+		virtual bool can_skip_pulses() const {
+			return false;
+		}
+
 	private:
 		inline void get_next_pulse();
+		inline void fetch_next_pulse();
+		void skip_pulses(Cycles::IntType &cycles);
 
 		std::shared_ptr<Storage::Tape::Tape> tape_;
 		Tape::Pulse current_pulse_;
+		uint64_t current_pulse_offset_ = 0;
 };
 
 /*!
@@ -158,6 +263,7 @@ class BinaryTapePlayer : public TapePlayer {
 	protected:
 		Delegate *delegate_ = nullptr;
 		void process_input_pulse(const Storage::Tape::Tape::Pulse &pulse) final;
+		bool can_skip_pulses() const final;
 		bool input_level_ = false;
 		bool motor_is_running_ = false;
 
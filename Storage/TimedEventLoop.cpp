@@ -10,7 +10,6 @@
 
 #include <algorithm>
 #include <cassert>
-#include <cmath>
 
 using namespace Storage;
 
@@ -54,7 +53,7 @@ Cycles::IntType TimedEventLoop::get_input_clock_rate() const {
 }
 
 void TimedEventLoop::reset_timer() {
-	subcycles_until_event_ = 0.0;
+	subcycles_until_event_ = 0;
 	cycles_until_event_ = 0;
 }
 
@@ -63,22 +62,63 @@ void TimedEventLoop::jump_to_next_event() {
 	process_next_event();
 }
 
-void TimedEventLoop::set_next_event_time_interval(Time interval) {
-	set_next_event_time_interval(interval.get<float>());
+TimedEventLoop::FixedCycles TimedEventLoop::fixed_cycles(Time interval, Cycles::IntType period) {
+	constexpr uint64_t max_whole = uint64_t(1) << (63 - FixedCyclesFractionBits);
+	if(!interval.clock_rate) return max_whole << FixedCyclesFractionBits;
+
+	// Divide in two parts, so that nothing overflows: the length is less than 2^32 and so is
+	// the clock rate, hence so is any remainder.
+	const uint64_t total = uint64_t(interval.length) * uint64_t(period);
+	const uint64_t whole = total / interval.clock_rate;
+	const uint64_t remainder = total % interval.clock_rate;
+
+	if(whole >= max_whole) return max_whole << FixedCyclesFractionBits;
+
+	// Round the fraction up, so that a run of intervals that should sum to a whole number of
+	// cycles does so rather than falling just short.
+	return
+		(whole << FixedCyclesFractionBits) +
+		((remainder << FixedCyclesFractionBits) + interval.clock_rate - 1) / interval.clock_rate;
 }
 
-void TimedEventLoop::set_next_event_time_interval(float interval) {
-	// Calculate [interval]*[input clock rate] + [subcycles until this event]
-	const float float_interval = interval * float(input_clock_rate_) + subcycles_until_event_;
+void TimedEventLoop::set_next_event_time_interval(Time interval) {
+	set_next_event_interval(fixed_cycles(interval));
+}
 
+void TimedEventLoop::set_next_event_interval(FixedCycles interval) {
 	// This event will fire in the integral number of cycles from now, putting us at the remainder
 	// number of subcycles.
-	const Cycles::IntType addition = Cycles::IntType(float_interval);
-	cycles_until_event_ += addition;
-	subcycles_until_event_ = fmodf(float_interval, 1.0f);
+	const FixedCycles total = interval + subcycles_until_event_;
+	cycles_until_event_ += Cycles::IntType(total >> FixedCyclesFractionBits);
+	subcycles_until_event_ = uint32_t(total);
 
 	assert(cycles_until_event_ >= 0);
-	assert(subcycles_until_event_ >= 0.0f);
+}
+
+int TimedEventLoop::skip_events(Cycles::IntType &cycles, Time interval, int count) {
+	if(cycles_until_event_ > cycles || count <= 0) return 0;
+
+	// Event n, counting the one currently scheduled as event 0, will occur
+	// cycles_until_event_ + ((subcycles_until_event_ + n*step) >> FixedCyclesFractionBits) cycles from now,
+	// so is within the period if n*step is no more than available.
+	//
+	// Limit the arithmetic to 62 bits so that nothing below can overflow.
+	const FixedCycles step = fixed_cycles(interval);
+	constexpr FixedCycles limit = FixedCycles(1) << 62;
+	if(!step || step >= limit) return 0;
+
+	const auto spare = std::min(uint64_t(cycles - cycles_until_event_), (limit >> FixedCyclesFractionBits) - 1);
+	const FixedCycles available = ((spare << FixedCyclesFractionBits) | ((FixedCycles(1) << FixedCyclesFractionBits) - 1)) - subcycles_until_event_;
+	const int elapsed = 1 + int(std::min(available / step, FixedCycles(count - 1)));
+
+	const auto advanced = cycles_until_event_ + Cycles::IntType((subcycles_until_event_ + FixedCycles(elapsed - 1) * step) >> FixedCyclesFractionBits);
+	const FixedCycles next_event = subcycles_until_event_ + FixedCycles(elapsed) * step;
+	cycles_until_event_ = cycles_until_event_ + Cycles::IntType(next_event >> FixedCyclesFractionBits) - advanced;
+	subcycles_until_event_ = uint32_t(next_event);
+
+	advance(advanced);
+	cycles -= advanced;
+	return elapsed;
 }
 
 Time TimedEventLoop::get_time_into_next_event() {
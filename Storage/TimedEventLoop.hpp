@@ -13,6 +13,7 @@
 #include "../ClockReceiver/ClockReceiver.hpp"
 #include "../SignalProcessing/Stepper.hpp"
 
+#include <cstdint>
 #include <memory>
 
 namespace Storage {
@@ -60,11 +61,37 @@ namespace Storage {
 			Cycles::IntType get_input_clock_rate() const;
 
 		protected:
+			/*!
+				A number of input clock cycles, in fixed point with @c FixedCyclesFractionBits bits of fraction.
+				This is the form in which the event loop keeps time, so scheduling in it involves no conversion.
+			*/
+			using FixedCycles = uint64_t;
+			static constexpr int FixedCyclesFractionBits = 32;
+
+			/*!
+				@returns @c interval multiples of @c period input clock cycles, as FixedCycles; e.g. supply
+				the input clock rate as @c period to convert an interval measured in seconds.
+
+				Results too large to represent are clamped, to an interval of more than 2^31 cycles.
+			*/
+			static FixedCycles fixed_cycles(Time interval, Cycles::IntType period);
+
+			/*!
+				@returns @c interval, a proportion of a second, as FixedCycles.
+			*/
+			FixedCycles fixed_cycles(Time interval) const {
+				return fixed_cycles(interval, input_clock_rate_);
+			}
+
 			/*!
 				Sets the time interval, as a proportion of a second, until the next event should be triggered.
 			*/
 			void set_next_event_time_interval(Time interval);
-			void set_next_event_time_interval(float interval);
+
+			/*!
+				Sets the time interval, in input clock cycles, until the next event should be triggered.
+			*/
+			void set_next_event_interval(FixedCycles interval);
 
 			/*!
 				Communicates that the next event is triggered. A subclass will idiomatically process that event
@@ -81,6 +108,20 @@ namespace Storage {
 			*/
 			virtual void advance([[maybe_unused]] const Cycles cycles) {};
 
+			/*!
+				Fast-forwards through a regular series of events without calling @c process_next_event,
+				given that the currently-scheduled event will be followed by at least @c count further events
+				each of duration @c interval.
+
+				As many events are elapsed as will occur within @c cycles, up to @c count; @c cycles is reduced
+				by the amount of time advanced and @c advance is called with that amount. The subsequent event,
+				of duration @c interval, is then scheduled just as if the subclass had called
+				@c set_next_event_time_interval upon each elapsed event.
+
+				@returns the number of events elapsed.
+			*/
+			int skip_events(Cycles::IntType &cycles, Time interval, int count);
+
 			/*!
 				Resets timing, throwing away any current internal state. So clears any fractional ticks
 				that the event loop is currently tracking.
@@ -103,7 +144,7 @@ namespace Storage {
 		private:
 			Cycles::IntType input_clock_rate_ = 0;
 			Cycles::IntType cycles_until_event_ = 0;
-			float subcycles_until_event_ = 0.0f;
+			uint32_t subcycles_until_event_ = 0;
 	};
 
 }